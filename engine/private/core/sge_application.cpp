@@ -3,6 +3,7 @@
 #include "core/sge_config.h"
 #include "core/sge_frame_timer.h"
 #include "core/sge_input.h"
+#include "core/sge_job_system.h"
 #include "core/sge_logger.h"
 #include "rendering/sge_editor.h"
 
@@ -32,6 +33,9 @@ namespace SGE
     {
         FrameTimer timer{};
         
+        JobSystem::Get().Initialize();
+        LOG_INFO("Job system workers: {}", JobSystem::Get().GetWorkerCount());
+
         m_window->Create();
         m_renderContext->Initialize(m_window.get(), m_appData.get());
         m_scene->Initialize(m_renderContext.get());
@@ -64,10 +68,19 @@ namespace SGE
             m_isRunning &= !m_appData->windowData.isPressedQuit;
 
             HandleInput();
-            while (accumulatedTime >= fixedDeltaTime)
+            JobSystem::Get().ProcessMainThreadJobs();
+
+            uint32 fixedUpdates = 0;
+            while (accumulatedTime >= fixedDeltaTime && fixedUpdates < MAX_FIXED_UPDATES_PER_FRAME)
             {
                 Update(fixedDeltaTime);
                 accumulatedTime -= fixedDeltaTime;
+                ++fixedUpdates;
+            }
+
+            if (accumulatedTime >= fixedDeltaTime)
+            {
+                accumulatedTime = std::fmod(accumulatedTime, fixedDeltaTime);
             }
 
             Render();
@@ -132,5 +145,7 @@ namespace SGE
         {
             m_renderContext->Shutdown();
         }
+
+        JobSystem::Get().Shutdown();
     }
 }
\ No newline at end of file
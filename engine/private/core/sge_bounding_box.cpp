@@ -0,0 +1,77 @@
+#include "core/sge_bounding_box.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SGE
+{
+    BoundingBox BoundingBox::Union(const BoundingBox& a, const BoundingBox& b)
+    {
+        return { float3(std::min(a.boundsMin.x, b.boundsMin.x), std::min(a.boundsMin.y, b.boundsMin.y), std::min(a.boundsMin.z, b.boundsMin.z)),
+                 float3(std::max(a.boundsMax.x, b.boundsMax.x), std::max(a.boundsMax.y, b.boundsMax.y), std::max(a.boundsMax.z, b.boundsMax.z)) };
+    }
+
+    BoundingBox BoundingBox::Transformed(const float4x4& matrix) const
+    {
+        const float4x4& m = matrix;
+        const float3 center = (boundsMin + boundsMax) * 0.5f;
+        const float3 extent = (boundsMax - boundsMin) * 0.5f;
+
+        // Each world axis takes the extents projected through the absolute matrix (Arvo).
+        const float3 worldCenter(m.m00 * center.x + m.m01 * center.y + m.m02 * center.z + m.m03,
+                                 m.m10 * center.x + m.m11 * center.y + m.m12 * center.z + m.m13,
+                                 m.m20 * center.x + m.m21 * center.y + m.m22 * center.z + m.m23);
+        const float3 worldExtent(std::fabs(m.m00) * extent.x + std::fabs(m.m01) * extent.y + std::fabs(m.m02) * extent.z,
+                                 std::fabs(m.m10) * extent.x + std::fabs(m.m11) * extent.y + std::fabs(m.m12) * extent.z,
+                                 std::fabs(m.m20) * extent.x + std::fabs(m.m21) * extent.y + std::fabs(m.m22) * extent.z);
+        return { worldCenter - worldExtent, worldCenter + worldExtent };
+    }
+
+    float BoundingBox::GetSurfaceArea() const
+    {
+        const float3 size = boundsMax - boundsMin;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    bool BoundingBox::Contains(const BoundingBox& other) const
+    {
+        return boundsMin.x <= other.boundsMin.x && boundsMin.y <= other.boundsMin.y && boundsMin.z <= other.boundsMin.z &&
+               boundsMax.x >= other.boundsMax.x && boundsMax.y >= other.boundsMax.y && boundsMax.z >= other.boundsMax.z;
+    }
+
+    bool BoundingBox::Intersects(const BoundingBox& other) const
+    {
+        return boundsMin.x <= other.boundsMax.x && boundsMin.y <= other.boundsMax.y && boundsMin.z <= other.boundsMax.z &&
+               boundsMax.x >= other.boundsMin.x && boundsMax.y >= other.boundsMin.y && boundsMax.z >= other.boundsMin.z;
+    }
+
+    bool BoundingBox::IntersectsSphere(const float3& center, float radius) const
+    {
+        const float3 closest(std::clamp(center.x, boundsMin.x, boundsMax.x),
+                             std::clamp(center.y, boundsMin.y, boundsMax.y),
+                             std::clamp(center.z, boundsMin.z, boundsMax.z));
+        const float3 offset = center - closest;
+        return dot(offset, offset) <= radius * radius;
+    }
+
+    bool BoundingBox::IntersectsRay(const float3& origin, const float3& inverseDirection, float maxDistance, float& distance) const
+    {
+        float enter = 0.0f;
+        float exit = maxDistance;
+        for (size_t axis = 0; axis < 3; ++axis)
+        {
+            const float t0 = (boundsMin[axis] - origin[axis]) * inverseDirection[axis];
+            const float t1 = (boundsMax[axis] - origin[axis]) * inverseDirection[axis];
+            enter = std::max(enter, std::min(t0, t1));
+            exit = std::min(exit, std::max(t0, t1));
+        }
+
+        distance = enter;
+        return enter <= exit;
+    }
+
+    bool BoundingBox::operator==(const BoundingBox& other) const
+    {
+        return boundsMin == other.boundsMin && boundsMax == other.boundsMax;
+    }
+}
@@ -0,0 +1,677 @@
+#include "core/sge_bounding_volume_hierarchy.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace SGE
+{
+    namespace
+    {
+        constexpr uint32 SAH_BIN_COUNT = 16;
+        constexpr uint32 FREE_NODE = INVALID_BVH_NODE - 1; // parent of nodes on the free list
+
+        enum class Containment { Outside, Intersects, Inside };
+
+        Containment ClassifyBox(const Frustum& frustum, const BoundingBox& box)
+        {
+            Containment result = Containment::Inside;
+            for (int p = 0; p < Frustum::PlaneCount; ++p)
+            {
+                const Plane& plane = frustum.GetPlane(static_cast<Frustum::PlaneIndex>(p));
+                const float3 farCorner(plane.normal.x >= 0.0f ? box.boundsMax.x : box.boundsMin.x,
+                                       plane.normal.y >= 0.0f ? box.boundsMax.y : box.boundsMin.y,
+                                       plane.normal.z >= 0.0f ? box.boundsMax.z : box.boundsMin.z);
+                if (plane.GetDistance(farCorner) < 0.0f)
+                {
+                    return Containment::Outside;
+                }
+
+                const float3 nearCorner(plane.normal.x >= 0.0f ? box.boundsMin.x : box.boundsMax.x,
+                                        plane.normal.y >= 0.0f ? box.boundsMin.y : box.boundsMax.y,
+                                        plane.normal.z >= 0.0f ? box.boundsMin.z : box.boundsMax.z);
+                if (plane.GetDistance(nearCorner) < 0.0f)
+                {
+                    result = Containment::Intersects;
+                }
+            }
+            return result;
+        }
+
+        BoundingBox EmptyBox()
+        {
+            return { float3(FLT_MAX, FLT_MAX, FLT_MAX), float3(-FLT_MAX, -FLT_MAX, -FLT_MAX) };
+        }
+
+        float3 GetCentroid(const BoundingBox& box)
+        {
+            return (box.boundsMin + box.boundsMax) * 0.5f;
+        }
+    }
+
+    void BoundingVolumeHierarchy::Build(Span<const BoundingBox> boxes)
+    {
+        Clear();
+
+        const uint32 count = static_cast<uint32>(boxes.size());
+        if (count == 0)
+        {
+            return;
+        }
+
+        m_nodes.reserve(count * 2 - 1);
+        m_nodes.resize(count);
+        std::vector<BuildItem> items(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            m_nodes[i].box = boxes[i];
+            items[i] = { boxes[i], GetCentroid(boxes[i]), i };
+        }
+
+        m_leafCount = count;
+        m_root = BuildRange(items.data(), count, INVALID_BVH_NODE);
+    }
+
+    void BoundingVolumeHierarchy::Clear()
+    {
+        m_nodes.clear();
+        m_freeNodes.clear();
+        m_root = INVALID_BVH_NODE;
+        m_leafCount = 0;
+    }
+
+    uint32 BoundingVolumeHierarchy::Insert(const BoundingBox& box)
+    {
+        const uint32 leaf = AllocateNode();
+        m_nodes[leaf].box = box;
+        InsertLeaf(leaf);
+        ++m_leafCount;
+        return leaf;
+    }
+
+    bool BoundingVolumeHierarchy::Remove(uint32 proxy)
+    {
+        if (!IsProxy(proxy))
+        {
+            return false;
+        }
+
+        RemoveLeaf(proxy);
+        FreeNode(proxy);
+        --m_leafCount;
+        return true;
+    }
+
+    bool BoundingVolumeHierarchy::Update(uint32 proxy, const BoundingBox& box)
+    {
+        if (!IsProxy(proxy) || m_nodes[proxy].box == box)
+        {
+            return false;
+        }
+
+        m_nodes[proxy].box = box;
+        const uint32 parent = m_nodes[proxy].parent;
+        if (parent == INVALID_BVH_NODE)
+        {
+            return true;
+        }
+
+        // Moving within the parent only shrinks the path to the root. Leaving it would stretch
+        // every box on the way, so the object goes where it now belongs instead.
+        if (m_nodes[parent].box.Contains(box))
+        {
+            Refit(parent);
+        }
+        else
+        {
+            RemoveLeaf(proxy);
+            InsertLeaf(proxy);
+        }
+        return true;
+    }
+
+    void BoundingVolumeHierarchy::QueryBox(const BoundingBox& box, std::vector<uint32>& proxies) const
+    {
+        proxies.clear();
+        if (m_root == INVALID_BVH_NODE)
+        {
+            return;
+        }
+
+        std::vector<uint32>& stack = m_queryStack;
+        stack.clear();
+        stack.push_back(m_root);
+        while (!stack.empty())
+        {
+            const uint32 index = stack.back();
+            stack.pop_back();
+            const Node& node = m_nodes[index];
+            if (!node.box.Intersects(box))
+            {
+                continue;
+            }
+
+            if (node.IsLeaf())
+            {
+                proxies.push_back(index);
+            }
+            else
+            {
+                stack.push_back(node.left);
+                stack.push_back(node.right);
+            }
+        }
+    }
+
+    void BoundingVolumeHierarchy::QuerySphere(const float3& center, float radius, std::vector<uint32>& proxies) const
+    {
+        proxies.clear();
+        if (m_root == INVALID_BVH_NODE)
+        {
+            return;
+        }
+
+        std::vector<uint32>& stack = m_queryStack;
+        stack.clear();
+        stack.push_back(m_root);
+        while (!stack.empty())
+        {
+            const uint32 index = stack.back();
+            stack.pop_back();
+            const Node& node = m_nodes[index];
+            if (!node.box.IntersectsSphere(center, radius))
+            {
+                continue;
+            }
+
+            if (node.IsLeaf())
+            {
+                proxies.push_back(index);
+            }
+            else
+            {
+                stack.push_back(node.left);
+                stack.push_back(node.right);
+            }
+        }
+    }
+
+    void BoundingVolumeHierarchy::QueryFrustum(const Frustum& frustum, std::vector<uint32>& proxies) const
+    {
+        proxies.clear();
+        if (m_root == INVALID_BVH_NODE)
+        {
+            return;
+        }
+
+        std::vector<uint32>& candidates = m_queryCandidates;
+        candidates.clear();
+        std::vector<uint32>& stack = m_queryStack;
+        stack.clear();
+        stack.push_back(m_root);
+        while (!stack.empty())
+        {
+            const uint32 index = stack.back();
+            stack.pop_back();
+            const Node& node = m_nodes[index];
+            if (node.IsLeaf())
+            {
+                candidates.push_back(index);
+                continue;
+            }
+
+            const Containment containment = ClassifyBox(frustum, node.box);
+            if (containment == Containment::Outside)
+            {
+                continue;
+            }
+
+            // Whatever is under a node inside every plane is visible without further tests.
+            if (containment == Containment::Inside)
+            {
+                AppendLeaves(index, proxies);
+            }
+            else
+            {
+                stack.push_back(node.left);
+                stack.push_back(node.right);
+            }
+        }
+
+        m_queryCuller.Resize(candidates.size());
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+            m_queryCuller.SetBounds(i, m_nodes[candidates[i]].box);
+        }
+
+        m_queryCuller.Cull(frustum, m_queryVisible);
+        for (uint32 candidate : m_queryVisible)
+        {
+            proxies.push_back(candidates[candidate]);
+        }
+    }
+
+    bool BoundingVolumeHierarchy::Raycast(const float3& origin, const float3& direction, float maxDistance, RayHit& hit) const
+    {
+        hit = {};
+        if (m_root == INVALID_BVH_NODE)
+        {
+            return false;
+        }
+
+        const float3 inverseDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+        float closest = maxDistance;
+
+        std::vector<uint32>& stack = m_queryStack;
+        stack.clear();
+        stack.push_back(m_root);
+        while (!stack.empty())
+        {
+            const uint32 index = stack.back();
+            stack.pop_back();
+            const Node& node = m_nodes[index];
+
+            float distance = 0.0f;
+            if (!node.box.IntersectsRay(origin, inverseDirection, closest, distance))
+            {
+                continue;
+            }
+
+            if (node.IsLeaf())
+            {
+                closest = distance;
+                hit.proxy = index;
+                hit.distance = distance;
+                continue;
+            }
+
+            // The nearer child goes on top so its hits shorten the ray for the other one.
+            float leftDistance = 0.0f;
+            float rightDistance = 0.0f;
+            const bool hitsLeft = m_nodes[node.left].box.IntersectsRay(origin, inverseDirection, closest, leftDistance);
+            const bool hitsRight = m_nodes[node.right].box.IntersectsRay(origin, inverseDirection, closest, rightDistance);
+            if (hitsLeft && hitsRight)
+            {
+                const bool isLeftNearer = leftDistance <= rightDistance;
+                stack.push_back(isLeftNearer ? node.right : node.left);
+                stack.push_back(isLeftNearer ? node.left : node.right);
+            }
+            else if (hitsLeft || hitsRight)
+            {
+                stack.push_back(hitsLeft ? node.left : node.right);
+            }
+        }
+
+        return hit.proxy != INVALID_BVH_NODE;
+    }
+
+    uint32 BoundingVolumeHierarchy::GetHeight() const
+    {
+        return m_root == INVALID_BVH_NODE ? 0 : GetHeight(m_root);
+    }
+
+    float BoundingVolumeHierarchy::GetCost() const
+    {
+        if (m_root == INVALID_BVH_NODE || m_nodes[m_root].IsLeaf())
+        {
+            return 0.0f;
+        }
+
+        float area = 0.0f;
+        for (const Node& node : m_nodes)
+        {
+            if (node.parent != FREE_NODE && !node.IsLeaf())
+            {
+                area += node.box.GetSurfaceArea();
+            }
+        }
+
+        const float rootArea = m_nodes[m_root].box.GetSurfaceArea();
+        return rootArea > 0.0f ? area / rootArea : 0.0f;
+    }
+
+    bool BoundingVolumeHierarchy::IsProxy(uint32 index) const
+    {
+        return index < m_nodes.size() && m_nodes[index].parent != FREE_NODE && m_nodes[index].IsLeaf();
+    }
+
+    uint32 BoundingVolumeHierarchy::AllocateNode()
+    {
+        if (m_freeNodes.empty())
+        {
+            m_nodes.emplace_back();
+            return static_cast<uint32>(m_nodes.size() - 1);
+        }
+
+        const uint32 index = m_freeNodes.back();
+        m_freeNodes.pop_back();
+        m_nodes[index] = Node();
+        return index;
+    }
+
+    void BoundingVolumeHierarchy::FreeNode(uint32 index)
+    {
+        m_nodes[index] = Node();
+        m_nodes[index].parent = FREE_NODE;
+        m_freeNodes.push_back(index);
+    }
+
+    uint32 BoundingVolumeHierarchy::BuildRange(BuildItem* items, uint32 count, uint32 parent)
+    {
+        if (count == 1)
+        {
+            m_nodes[items[0].leaf].parent = parent;
+            return items[0].leaf;
+        }
+
+        uint32 leftCount = count / 2;
+        if (count > 2)
+        {
+            leftCount = FindSplit(items, count);
+        }
+
+        const uint32 index = AllocateNode();
+        const uint32 left = BuildRange(items, leftCount, index);
+        const uint32 right = BuildRange(items + leftCount, count - leftCount, index);
+
+        Node& node = m_nodes[index];
+        node.parent = parent;
+        node.left = left;
+        node.right = right;
+        node.box = BoundingBox::Union(m_nodes[left].box, m_nodes[right].box);
+        return index;
+    }
+
+    uint32 BoundingVolumeHierarchy::FindSplit(BuildItem* items, uint32 count) const
+    {
+        BoundingBox centroidBounds = EmptyBox();
+        for (uint32 i = 0; i < count; ++i)
+        {
+            centroidBounds = BoundingBox::Union(centroidBounds, { items[i].centroid, items[i].centroid });
+        }
+
+        float3 scale;
+        for (uint32 axis = 0; axis < 3; ++axis)
+        {
+            const float extent = centroidBounds.boundsMax[axis] - centroidBounds.boundsMin[axis];
+            scale[axis] = extent > 0.0f ? SAH_BIN_COUNT / extent : 0.0f;
+        }
+
+        auto getBin = [&](const BuildItem& item, uint32 axis)
+        {
+            const float offset = item.centroid[axis] - centroidBounds.boundsMin[axis];
+            return std::min(SAH_BIN_COUNT - 1, static_cast<uint32>(offset * scale[axis]));
+        };
+
+        BoundingBox binBoxes[3][SAH_BIN_COUNT];
+        uint32 binCounts[3][SAH_BIN_COUNT] = {};
+        for (uint32 axis = 0; axis < 3; ++axis)
+        {
+            std::fill(std::begin(binBoxes[axis]), std::end(binBoxes[axis]), EmptyBox());
+        }
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            for (uint32 axis = 0; axis < 3; ++axis)
+            {
+                const uint32 bin = getBin(items[i], axis);
+                binBoxes[axis][bin] = BoundingBox::Union(binBoxes[axis][bin], items[i].box);
+                ++binCounts[axis][bin];
+            }
+        }
+
+        // Binned surface area heuristic: the split between bins with the least area times count
+        // on both sides, over all three axes.
+        float bestCost = FLT_MAX;
+        uint32 bestAxis = 0;
+        uint32 bestSplit = 0;
+        for (uint32 axis = 0; axis < 3; ++axis)
+        {
+            if (scale[axis] == 0.0f)
+            {
+                continue;
+            }
+
+            float rightAreas[SAH_BIN_COUNT];
+            uint32 rightCounts[SAH_BIN_COUNT];
+            BoundingBox right = EmptyBox();
+            uint32 rightCount = 0;
+            for (uint32 bin = SAH_BIN_COUNT - 1; bin > 0; --bin)
+            {
+                right = BoundingBox::Union(right, binBoxes[axis][bin]);
+                rightCount += binCounts[axis][bin];
+                rightAreas[bin] = rightCount > 0 ? right.GetSurfaceArea() : 0.0f;
+                rightCounts[bin] = rightCount;
+            }
+
+            BoundingBox left = EmptyBox();
+            uint32 leftCount = 0;
+            for (uint32 split = 1; split < SAH_BIN_COUNT; ++split)
+            {
+                left = BoundingBox::Union(left, binBoxes[axis][split - 1]);
+                leftCount += binCounts[axis][split - 1];
+                if (leftCount == 0 || rightCounts[split] == 0)
+                {
+                    continue;
+                }
+
+                const float cost = left.GetSurfaceArea() * leftCount + rightAreas[split] * rightCounts[split];
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = split;
+                }
+            }
+        }
+
+        uint32 leftCount = 0;
+        if (bestCost < FLT_MAX)
+        {
+            BuildItem* middle = std::partition(items, items + count, [&](const BuildItem& item) { return getBin(item, bestAxis) < bestSplit; });
+            leftCount = static_cast<uint32>(middle - items);
+        }
+
+        // All centroids in one place, any halving is as good as another.
+        return (leftCount == 0 || leftCount == count) ? count / 2 : leftCount;
+    }
+
+    uint32 BoundingVolumeHierarchy::FindBestSibling(const BoundingBox& box) const
+    {
+        // Walks down while pairing with a child is cheaper than pairing here, counting the growth
+        // of the boxes above as the cost every candidate below inherits.
+        uint32 index = m_root;
+        while (!m_nodes[index].IsLeaf())
+        {
+            const Node& node = m_nodes[index];
+            const float area = node.box.GetSurfaceArea();
+            const float combinedArea = BoundingBox::Union(node.box, box).GetSurfaceArea();
+            const float cost = 2.0f * combinedArea;
+            const float inheritedCost = 2.0f * (combinedArea - area);
+
+            auto descendCost = [&](uint32 child)
+            {
+                const Node& childNode = m_nodes[child];
+                const float childCost = BoundingBox::Union(childNode.box, box).GetSurfaceArea() + inheritedCost;
+                return childNode.IsLeaf() ? childCost : childCost - childNode.box.GetSurfaceArea();
+            };
+
+            const float leftCost = descendCost(node.left);
+            const float rightCost = descendCost(node.right);
+            if (cost < leftCost && cost < rightCost)
+            {
+                break;
+            }
+
+            index = leftCost < rightCost ? node.left : node.right;
+        }
+        return index;
+    }
+
+    void BoundingVolumeHierarchy::InsertLeaf(uint32 leaf)
+    {
+        if (m_root == INVALID_BVH_NODE)
+        {
+            m_root = leaf;
+            m_nodes[leaf].parent = INVALID_BVH_NODE;
+            return;
+        }
+
+        const uint32 sibling = FindBestSibling(m_nodes[leaf].box);
+        const uint32 oldParent = m_nodes[sibling].parent;
+        const uint32 newParent = AllocateNode();
+
+        Node& node = m_nodes[newParent];
+        node.parent = oldParent;
+        node.left = sibling;
+        node.right = leaf;
+        m_nodes[sibling].parent = newParent;
+        m_nodes[leaf].parent = newParent;
+
+        if (oldParent == INVALID_BVH_NODE)
+        {
+            m_root = newParent;
+        }
+        else
+        {
+            ReplaceChild(oldParent, sibling, newParent);
+        }
+
+        Refit(newParent);
+    }
+
+    void BoundingVolumeHierarchy::RemoveLeaf(uint32 leaf)
+    {
+        if (leaf == m_root)
+        {
+            m_root = INVALID_BVH_NODE;
+            return;
+        }
+
+        const uint32 parent = m_nodes[leaf].parent;
+        const uint32 grandParent = m_nodes[parent].parent;
+        const uint32 sibling = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+
+        m_nodes[sibling].parent = grandParent;
+        if (grandParent == INVALID_BVH_NODE)
+        {
+            m_root = sibling;
+        }
+        else
+        {
+            ReplaceChild(grandParent, parent, sibling);
+        }
+
+        FreeNode(parent);
+        m_nodes[leaf].parent = INVALID_BVH_NODE;
+        if (grandParent != INVALID_BVH_NODE)
+        {
+            Refit(grandParent);
+        }
+    }
+
+    void BoundingVolumeHierarchy::ReplaceChild(uint32 parent, uint32 oldChild, uint32 newChild)
+    {
+        Node& node = m_nodes[parent];
+        if (node.left == oldChild)
+        {
+            node.left = newChild;
+        }
+        else
+        {
+            node.right = newChild;
+        }
+    }
+
+    void BoundingVolumeHierarchy::Refit(uint32 index)
+    {
+        while (index != INVALID_BVH_NODE)
+        {
+            Node& node = m_nodes[index];
+            node.box = BoundingBox::Union(m_nodes[node.left].box, m_nodes[node.right].box);
+            Rotate(index);
+            index = node.parent;
+        }
+    }
+
+    void BoundingVolumeHierarchy::Rotate(uint32 index)
+    {
+        // Swaps a child with a grandchild under the other child when that shrinks the other
+        // child's box (Kopta et al.). The node's own box covers the same leaves either way.
+        const Node& node = m_nodes[index];
+        float bestGain = 0.0f;
+        uint32 bestChild = INVALID_BVH_NODE;
+        uint32 bestGrandChild = INVALID_BVH_NODE;
+
+        auto tryRotation = [&](uint32 child, uint32 other)
+        {
+            const Node& otherNode = m_nodes[other];
+            if (otherNode.IsLeaf())
+            {
+                return;
+            }
+
+            const float area = otherNode.box.GetSurfaceArea();
+            const BoundingBox& childBox = m_nodes[child].box;
+            const float keepRightArea = BoundingBox::Union(childBox, m_nodes[otherNode.right].box).GetSurfaceArea();
+            const float keepLeftArea = BoundingBox::Union(childBox, m_nodes[otherNode.left].box).GetSurfaceArea();
+            if (area - keepRightArea > bestGain)
+            {
+                bestGain = area - keepRightArea;
+                bestChild = child;
+                bestGrandChild = otherNode.left;
+            }
+            if (area - keepLeftArea > bestGain)
+            {
+                bestGain = area - keepLeftArea;
+                bestChild = child;
+                bestGrandChild = otherNode.right;
+            }
+        };
+
+        tryRotation(node.left, node.right);
+        tryRotation(node.right, node.left);
+        if (bestChild == INVALID_BVH_NODE)
+        {
+            return;
+        }
+
+        const uint32 other = m_nodes[bestGrandChild].parent;
+        ReplaceChild(index, bestChild, bestGrandChild);
+        ReplaceChild(other, bestGrandChild, bestChild);
+        m_nodes[bestGrandChild].parent = index;
+        m_nodes[bestChild].parent = other;
+
+        Node& otherNode = m_nodes[other];
+        otherNode.box = BoundingBox::Union(m_nodes[otherNode.left].box, m_nodes[otherNode.right].box);
+    }
+
+    void BoundingVolumeHierarchy::AppendLeaves(uint32 index, std::vector<uint32>& proxies) const
+    {
+        // Runs on top of the stack of the query that calls it.
+        std::vector<uint32>& stack = m_queryStack;
+        const size_t base = stack.size();
+        stack.push_back(index);
+        while (stack.size() > base)
+        {
+            const uint32 current = stack.back();
+            stack.pop_back();
+            const Node& node = m_nodes[current];
+            if (node.IsLeaf())
+            {
+                proxies.push_back(current);
+            }
+            else
+            {
+                stack.push_back(node.left);
+                stack.push_back(node.right);
+            }
+        }
+    }
+
+    uint32 BoundingVolumeHierarchy::GetHeight(uint32 index) const
+    {
+        const Node& node = m_nodes[index];
+        return node.IsLeaf() ? 1 : 1 + std::max(GetHeight(node.left), GetHeight(node.right));
+    }
+}
@@ -0,0 +1,59 @@
+#include "core/sge_descriptor_allocator.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace SGE
+{
+    void DescriptorAllocator::Initialize(uint32 firstIndex, uint32 capacity)
+    {
+        m_firstIndex = firstIndex;
+        m_allocatedCount = 0;
+        m_usedRange = 0;
+        m_freeIndices.clear();
+        m_isAllocated.assign(capacity, false);
+    }
+
+    uint32 DescriptorAllocator::Allocate()
+    {
+        uint32 slot = 0;
+        if (!m_freeIndices.empty())
+        {
+            std::pop_heap(m_freeIndices.begin(), m_freeIndices.end(), std::greater<uint32>());
+            slot = m_freeIndices.back();
+            m_freeIndices.pop_back();
+        }
+        else if (m_usedRange < GetCapacity())
+        {
+            slot = m_usedRange++;
+        }
+        else
+        {
+            return INVALID_DESCRIPTOR_INDEX;
+        }
+
+        m_isAllocated[slot] = true;
+        ++m_allocatedCount;
+        return m_firstIndex + slot;
+    }
+
+    bool DescriptorAllocator::Free(uint32 index)
+    {
+        if (!IsAllocated(index))
+        {
+            return false;
+        }
+
+        const uint32 slot = index - m_firstIndex;
+        m_isAllocated[slot] = false;
+        --m_allocatedCount;
+        m_freeIndices.push_back(slot);
+        std::push_heap(m_freeIndices.begin(), m_freeIndices.end(), std::greater<uint32>());
+        return true;
+    }
+
+    bool DescriptorAllocator::IsAllocated(uint32 index) const
+    {
+        return index >= m_firstIndex && index - m_firstIndex < GetCapacity() && m_isAllocated[index - m_firstIndex];
+    }
+}
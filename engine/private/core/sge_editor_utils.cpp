@@ -19,8 +19,8 @@ namespace SGE
         float cursorX = ImGui::GetCursorPosX();
 
         char buffer[INPUT_BUFFER_SIZE];
-        std::copy(str.begin(), str.begin() + min(str.size(), INPUT_BUFFER_SIZE - 1), buffer);
-        buffer[min(str.size(), INPUT_BUFFER_SIZE - 1)] = '\0';
+        std::copy(str.begin(), str.begin() + std::min(str.size(), INPUT_BUFFER_SIZE - 1), buffer);
+        buffer[std::min(str.size(), INPUT_BUFFER_SIZE - 1)] = '\0';
 
         ImGui::Text(label.c_str());
 
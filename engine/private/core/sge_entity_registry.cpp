@@ -0,0 +1,128 @@
+#include "core/sge_entity_registry.h"
+
+namespace SGE
+{
+    bool ComponentPoolBase::Contains(Entity entity) const
+    {
+        return Find(entity) != INVALID_ENTITY_INDEX;
+    }
+
+    uint32 ComponentPoolBase::Find(Entity entity) const
+    {
+        if (entity.index >= m_sparse.size())
+        {
+            return INVALID_ENTITY_INDEX;
+        }
+
+        // The dense side holds the full handle, a stale generation finds no component.
+        const uint32 dense = m_sparse[entity.index];
+        return dense != INVALID_ENTITY_INDEX && m_entities[dense] == entity ? dense : INVALID_ENTITY_INDEX;
+    }
+
+    uint32 ComponentPoolBase::AddEntity(Entity entity)
+    {
+        if (entity.index >= m_sparse.size())
+        {
+            m_sparse.resize(entity.index + 1, INVALID_ENTITY_INDEX);
+        }
+
+        const uint32 dense = static_cast<uint32>(m_entities.size());
+        m_sparse[entity.index] = dense;
+        m_entities.push_back(entity);
+        return dense;
+    }
+
+    uint32 ComponentPoolBase::RemoveEntity(Entity entity)
+    {
+        const uint32 dense = m_sparse[entity.index];
+        const Entity last = m_entities.back();
+        m_entities[dense] = last;
+        m_sparse[last.index] = dense;
+        m_sparse[entity.index] = INVALID_ENTITY_INDEX;
+        m_entities.pop_back();
+        return dense;
+    }
+
+    void ComponentPoolBase::ClearEntities()
+    {
+        m_sparse.clear();
+        m_entities.clear();
+    }
+
+    Entity EntityRegistry::Create()
+    {
+        Entity entity;
+        if (m_freeIndices.empty())
+        {
+            entity.index = static_cast<uint32>(m_generations.size());
+            m_generations.push_back(0);
+            m_isAlive.push_back(1);
+        }
+        else
+        {
+            entity.index = m_freeIndices.back();
+            m_freeIndices.pop_back();
+            m_isAlive[entity.index] = 1;
+        }
+
+        entity.generation = m_generations[entity.index];
+        return entity;
+    }
+
+    bool EntityRegistry::Destroy(Entity entity)
+    {
+        if (!IsAlive(entity))
+        {
+            return false;
+        }
+
+        for (const std::unique_ptr<ComponentPoolBase>& pool : m_pools)
+        {
+            if (pool)
+            {
+                pool->Remove(entity);
+            }
+        }
+
+        ++m_generations[entity.index];
+        m_isAlive[entity.index] = 0;
+        m_freeIndices.push_back(entity.index);
+        return true;
+    }
+
+    bool EntityRegistry::IsAlive(Entity entity) const
+    {
+        return entity.index < m_generations.size() && m_isAlive[entity.index] && m_generations[entity.index] == entity.generation;
+    }
+
+    void EntityRegistry::Clear()
+    {
+        // Pools stay allocated, their component ids are global.
+        for (const std::unique_ptr<ComponentPoolBase>& pool : m_pools)
+        {
+            if (pool)
+            {
+                pool->Clear();
+            }
+        }
+
+        // Generations are kept and bumped like in Destroy, so handles from before stay invalid.
+        // Pushed back to front, Create hands out the lowest indices first.
+        m_freeIndices.clear();
+        for (uint32 index = static_cast<uint32>(m_generations.size()); index-- > 0;)
+        {
+            if (m_isAlive[index])
+            {
+                ++m_generations[index];
+                m_isAlive[index] = 0;
+            }
+            m_freeIndices.push_back(index);
+        }
+    }
+
+    uint32 EntityRegistry::NextComponentId()
+    {
+        static uint32 nextId = 0;
+        return nextId++;
+    }
+}
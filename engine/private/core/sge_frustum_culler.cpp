@@ -0,0 +1,126 @@
+#include "core/sge_frustum_culler.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace SGE
+{
+    namespace
+    {
+        // A plane as lanes: its normal, the absolute normal that projects box extents onto it and its distance.
+        template<typename L>
+        struct PlaneLanes
+        {
+            typename L::type normal[3];
+            typename L::type absNormal[3];
+            typename L::type distance;
+        };
+
+        // Signed distance of box and sphere to every plane, pushed in by the box extent and the
+        // radius. The object is outside as soon as one of them is negative.
+        template<typename L>
+        size_t CullLanes(const Frustum& frustum, const float3_soa& boxCenters, const float3_soa& boxExtents, const float3_soa& sphereCenters,
+                         const std::vector<float>& radii, size_t begin, std::vector<uint32>& visible)
+        {
+            using V = typename L::type;
+
+            PlaneLanes<L> planes[Frustum::PlaneCount];
+            for (int p = 0; p < Frustum::PlaneCount; ++p)
+            {
+                const Plane& plane = frustum.GetPlane(static_cast<Frustum::PlaneIndex>(p));
+                planes[p].normal[0] = L::Set(plane.normal.x);
+                planes[p].normal[1] = L::Set(plane.normal.y);
+                planes[p].normal[2] = L::Set(plane.normal.z);
+                planes[p].absNormal[0] = L::Set(std::fabs(plane.normal.x));
+                planes[p].absNormal[1] = L::Set(std::fabs(plane.normal.y));
+                planes[p].absNormal[2] = L::Set(std::fabs(plane.normal.z));
+                planes[p].distance = L::Set(plane.distance);
+            }
+
+            const size_t count = radii.size();
+            size_t i = begin;
+            for (; i + L::Width <= count; i += L::Width)
+            {
+                const V cx = L::Load(&boxCenters.x[i]);
+                const V cy = L::Load(&boxCenters.y[i]);
+                const V cz = L::Load(&boxCenters.z[i]);
+                const V ex = L::Load(&boxExtents.x[i]);
+                const V ey = L::Load(&boxExtents.y[i]);
+                const V ez = L::Load(&boxExtents.z[i]);
+                const V sx = L::Load(&sphereCenters.x[i]);
+                const V sy = L::Load(&sphereCenters.y[i]);
+                const V sz = L::Load(&sphereCenters.z[i]);
+                const V radius = L::Load(&radii[i]);
+
+                V margin = L::Set(FLT_MAX);
+                for (const PlaneLanes<L>& plane : planes)
+                {
+                    const V center = L::MulAdd(plane.normal[0], cx, L::MulAdd(plane.normal[1], cy, L::MulAdd(plane.normal[2], cz, plane.distance)));
+                    const V box = L::MulAdd(plane.absNormal[0], ex, L::MulAdd(plane.absNormal[1], ey, L::MulAdd(plane.absNormal[2], ez, center)));
+                    const V sphere = L::MulAdd(plane.normal[0], sx, L::MulAdd(plane.normal[1], sy, L::MulAdd(plane.normal[2], sz, L::Add(plane.distance, radius))));
+                    margin = L::Min(margin, L::Min(box, sphere));
+                }
+
+                const int outside = L::NegativeMask(margin);
+                for (size_t lane = 0; lane < L::Width; ++lane)
+                {
+                    if ((outside & (1 << lane)) == 0)
+                    {
+                        visible.push_back(static_cast<uint32>(i + lane));
+                    }
+                }
+            }
+            return i;
+        }
+    }
+
+    void FrustumCuller::Resize(size_t count)
+    {
+        m_boxCenters.resize(count);
+        m_boxExtents.resize(count);
+        m_sphereCenters.resize(count);
+        m_radii.resize(count);
+    }
+
+    void FrustumCuller::SetBounds(size_t index, const float3& boxMin, const float3& boxMax, const float3& sphereCenter, float sphereRadius)
+    {
+        m_boxCenters.set(index, (boxMin + boxMax) * 0.5f);
+        m_boxExtents.set(index, (boxMax - boxMin) * 0.5f);
+        m_sphereCenters.set(index, sphereCenter);
+        m_radii[index] = sphereRadius;
+    }
+
+    void FrustumCuller::SetBounds(size_t index, const float4x4& worldMatrix, const float3& boxMin, const float3& boxMax, const float3& sphereCenter, float sphereRadius)
+    {
+        const float4x4& m = worldMatrix;
+        const BoundingBox box = BoundingBox{ boxMin, boxMax }.Transformed(worldMatrix);
+        m_boxCenters.set(index, (box.boundsMin + box.boundsMax) * 0.5f);
+        m_boxExtents.set(index, (box.boundsMax - box.boundsMin) * 0.5f);
+
+        const float scaleX = float3(m.m00, m.m10, m.m20).length();
+        const float scaleY = float3(m.m01, m.m11, m.m21).length();
+        const float scaleZ = float3(m.m02, m.m12, m.m22).length();
+        m_sphereCenters.set(index, float3(m.m00 * sphereCenter.x + m.m01 * sphereCenter.y + m.m02 * sphereCenter.z + m.m03,
+                                          m.m10 * sphereCenter.x + m.m11 * sphereCenter.y + m.m12 * sphereCenter.z + m.m13,
+                                          m.m20 * sphereCenter.x + m.m21 * sphereCenter.y + m.m22 * sphereCenter.z + m.m23));
+        m_radii[index] = sphereRadius * std::max(scaleX, std::max(scaleY, scaleZ));
+    }
+
+    void FrustumCuller::SetBounds(size_t index, const BoundingBox& box)
+    {
+        const float3 center = (box.boundsMin + box.boundsMax) * 0.5f;
+        const float3 extent = (box.boundsMax - box.boundsMin) * 0.5f;
+        m_boxCenters.set(index, center);
+        m_boxExtents.set(index, extent);
+        m_sphereCenters.set(index, center);
+        m_radii[index] = extent.length();
+    }
+
+    void FrustumCuller::Cull(const Frustum& frustum, std::vector<uint32>& visible) const
+    {
+        visible.clear();
+        size_t i = CullLanes<BatchDetail::SimdLanes>(frustum, m_boxCenters, m_boxExtents, m_sphereCenters, m_radii, 0, visible);
+        CullLanes<BatchDetail::ScalarLanes>(frustum, m_boxCenters, m_boxExtents, m_sphereCenters, m_radii, i, visible);
+    }
+}
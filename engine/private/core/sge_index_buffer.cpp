@@ -5,7 +5,7 @@
 
 namespace SGE
 {
-    void IndexBuffer::Initialize(Device* device, const std::vector<uint32>& indices)
+    void IndexBuffer::Initialize(Device* device, Span<const uint32> indices)
     {
         m_indexCount = static_cast<uint32>(indices.size());
         const uint32 indexBufferSize = static_cast<uint32>(indices.size() * sizeof(uint32));
@@ -32,6 +32,21 @@ namespace SGE
         m_view.Format = DXGI_FORMAT_R32_UINT;
     }
 
+    void IndexBuffer::Update(Span<const uint32> indices)
+    {
+        if (indices.size() > m_indexCount)
+        {
+            throw std::runtime_error("Index count exceeds buffer size.");
+        }
+
+        UINT8* pIndexDataBegin;
+        CD3DX12_RANGE readRange(0, 0);
+        Verify(m_resource->Map(0, &readRange, reinterpret_cast<void**>(&pIndexDataBegin)), "Failed to map index buffer.");
+
+        memcpy(pIndexDataBegin, indices.data(), indices.size_bytes());
+        m_resource->Unmap(0, nullptr);
+    }
+
     void IndexBuffer::Shutdown()
     {
         m_resource.Reset();
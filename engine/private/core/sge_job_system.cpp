@@ -0,0 +1,386 @@
+#include "core/sge_job_system.h"
+
+#include <algorithm>
+#include "core/sge_logger.h"
+
+namespace SGE
+{
+    namespace
+    {
+        constexpr uint32 WORKER_SPIN_COUNT = 64;
+
+        // Index into m_threads of the current thread, -1 for threads the job system does not own.
+        thread_local int32 t_threadIndex = -1;
+
+        uint32 NextRandom(uint32& state)
+        {
+            // xorshift32, only used to spread victim selection.
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        Shutdown();
+    }
+
+    void JobSystem::Initialize(uint32 workerCount)
+    {
+        Shutdown();
+
+        if (workerCount == 0)
+        {
+            uint32 hardwareThreads = std::thread::hardware_concurrency();
+            workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+        }
+
+        m_mainThreadId = std::this_thread::get_id();
+        for (uint32 i = 0; i <= workerCount; ++i)
+        {
+            m_threads.push_back(std::make_unique<ThreadState>());
+            m_threads.back()->randomState = 0x9E3779B9u * (i + 1);
+        }
+
+        t_threadIndex = 0;
+        m_isRunning = true;
+
+        m_workerThreads.reserve(workerCount);
+        for (uint32 i = 1; i <= workerCount; ++i)
+        {
+            m_workerThreads.emplace_back(&JobSystem::WorkerLoop, this, i);
+        }
+    }
+
+    void JobSystem::Shutdown()
+    {
+        if (!IsInitialized())
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_isRunning = false;
+        }
+        m_sleepCondition.notify_all();
+
+        for (std::thread& worker : m_workerThreads)
+        {
+            worker.join();
+        }
+        m_workerThreads.clear();
+
+        // Finish whatever is still queued so no counter is left waiting.
+        while (Job* job = FindJob(0))
+        {
+            Execute(job);
+        }
+        while (RunMainThreadJob())
+        {
+        }
+
+        m_threads.clear();
+        t_threadIndex = -1;
+    }
+
+    bool JobSystem::IsMainThread() const
+    {
+        return !IsInitialized() || std::this_thread::get_id() == m_mainThreadId;
+    }
+
+    void JobSystem::Run(JobFunction job, JobCounter* counter)
+    {
+        if (counter)
+        {
+            counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Job* newJob = new Job{ std::move(job), counter };
+        if (!IsInitialized())
+        {
+            Execute(newJob);
+            return;
+        }
+
+        Submit(newJob);
+    }
+
+    void JobSystem::Wait(JobCounter& counter)
+    {
+        const int32 threadIndex = t_threadIndex;
+
+        while (!counter.IsDone())
+        {
+            if (threadIndex == 0 && RunMainThreadJob())
+            {
+                continue;
+            }
+
+            if (Job* job = FindJob(threadIndex))
+            {
+                Execute(job);
+                continue;
+            }
+
+            std::this_thread::yield();
+        }
+
+        std::exception_ptr exception;
+        {
+            std::lock_guard<std::mutex> lock(counter.m_exceptionMutex);
+            std::swap(exception, counter.m_exception);
+        }
+
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    void JobSystem::RunOnMainThread(JobFunction job, JobCounter* counter)
+    {
+        if (counter)
+        {
+            counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Job* newJob = new Job{ std::move(job), counter };
+        if (!IsInitialized())
+        {
+            Execute(newJob);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+        m_mainThreadJobs.push_back(newJob);
+    }
+
+    void JobSystem::ProcessMainThreadJobs()
+    {
+        // Only the jobs queued so far, jobs queued meanwhile wait for the next call.
+        size_t count = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+            count = m_mainThreadJobs.size();
+        }
+
+        for (size_t i = 0; i < count && RunMainThreadJob(); ++i)
+        {
+        }
+    }
+
+    void JobSystem::ParallelFor(size_t count, const RangeJobFunction& work, size_t minGrainSize)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        JobCounter counter;
+        std::shared_ptr<const RangeJobFunction> workRef(std::shared_ptr<void>(), &work);
+        try
+        {
+            SplitRange(0, count, GetGrainSize(count, minGrainSize), workRef, counter);
+        }
+        catch (...)
+        {
+            // The queued halves still point at work and counter, they have to finish first.
+            KeepException(counter, std::current_exception());
+        }
+        Wait(counter);
+    }
+
+    void JobSystem::ParallelForAsync(size_t count, RangeJobFunction work, JobCounter& counter, size_t minGrainSize)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        auto sharedWork = std::make_shared<const RangeJobFunction>(std::move(work));
+        const size_t grainSize = GetGrainSize(count, minGrainSize);
+        Run([this, count, grainSize, sharedWork, &counter]() { SplitRange(0, count, grainSize, sharedWork, counter); }, &counter);
+    }
+
+    void JobSystem::Submit(Job* job)
+    {
+        // Counted before the job becomes visible, so a thief never sees the count go below zero.
+        m_queuedJobs.fetch_add(1, std::memory_order_seq_cst);
+
+        const int32 threadIndex = t_threadIndex;
+        if (threadIndex >= 0)
+        {
+            if (!m_threads[threadIndex]->queue.Push(job))
+            {
+                // Own queue is full, running the job right away still makes progress.
+                m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+                Execute(job);
+                return;
+            }
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(m_sharedMutex);
+            m_sharedQueue.push_back(job);
+        }
+
+        if (m_sleepingWorkers.load(std::memory_order_seq_cst) > 0)
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_sleepCondition.notify_one();
+        }
+    }
+
+    void JobSystem::Execute(Job* job)
+    {
+        JobCounter* counter = job->counter;
+        try
+        {
+            job->function();
+        }
+        catch (...)
+        {
+            // Kept before the counter drops, so Wait sees it as soon as the counter reaches zero.
+            if (counter)
+            {
+                KeepException(*counter, std::current_exception());
+            }
+            else
+            {
+                LOG_ERROR("JobSystem: a job without a counter threw, the exception is dropped.");
+            }
+        }
+
+        delete job;
+
+        if (counter)
+        {
+            counter->m_pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    void JobSystem::KeepException(JobCounter& counter, std::exception_ptr exception)
+    {
+        std::lock_guard<std::mutex> lock(counter.m_exceptionMutex);
+        if (!counter.m_exception)
+        {
+            counter.m_exception = exception;
+        }
+    }
+
+    JobSystem::Job* JobSystem::FindJob(int32 threadIndex)
+    {
+        if (!IsInitialized())
+        {
+            return nullptr;
+        }
+
+        Job* job = nullptr;
+        if (threadIndex >= 0)
+        {
+            job = m_threads[threadIndex]->queue.Pop();
+        }
+
+        if (!job)
+        {
+            const uint32 threadCount = GetThreadCount();
+            uint32 start = threadIndex >= 0 ? NextRandom(m_threads[threadIndex]->randomState) % threadCount : 0;
+            for (uint32 i = 0; i < threadCount && !job; ++i)
+            {
+                uint32 victim = (start + i) % threadCount;
+                if (static_cast<int32>(victim) != threadIndex)
+                {
+                    job = m_threads[victim]->queue.Steal();
+                }
+            }
+        }
+
+        if (!job)
+        {
+            std::lock_guard<std::mutex> lock(m_sharedMutex);
+            if (!m_sharedQueue.empty())
+            {
+                job = m_sharedQueue.front();
+                m_sharedQueue.pop_front();
+            }
+        }
+
+        if (job)
+        {
+            m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    bool JobSystem::RunMainThreadJob()
+    {
+        Job* job = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+            if (m_mainThreadJobs.empty())
+            {
+                return false;
+            }
+            job = m_mainThreadJobs.front();
+            m_mainThreadJobs.pop_front();
+        }
+
+        Execute(job);
+        return true;
+    }
+
+    void JobSystem::WorkerLoop(uint32 threadIndex)
+    {
+        t_threadIndex = static_cast<int32>(threadIndex);
+        uint32 idleSpins = 0;
+
+        while (m_isRunning.load(std::memory_order_relaxed))
+        {
+            if (Job* job = FindJob(t_threadIndex))
+            {
+                Execute(job);
+                idleSpins = 0;
+                continue;
+            }
+
+            if (++idleSpins < WORKER_SPIN_COUNT)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+            m_sleepCondition.wait(lock, [this]() { return m_queuedJobs.load(std::memory_order_seq_cst) > 0 || !m_isRunning; });
+            m_sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+            idleSpins = 0;
+        }
+
+        t_threadIndex = -1;
+    }
+
+    size_t JobSystem::GetGrainSize(size_t count, size_t minGrainSize) const
+    {
+        // Roughly four chunks per thread before stealing kicks in, smaller ones only if idle
+        // threads keep splitting.
+        const size_t threadCount = std::max<size_t>(GetThreadCount(), 1);
+        return std::max<size_t>({ minGrainSize, count / (threadCount * 4), 1 });
+    }
+
+    void JobSystem::SplitRange(size_t begin, size_t end, size_t grainSize, const std::shared_ptr<const RangeJobFunction>& work, JobCounter& counter)
+    {
+        // Hand the upper half to the queue and keep the lower half, an idle thread steals the
+        // oldest and therefore largest half and splits it further.
+        while (end - begin > grainSize)
+        {
+            size_t middle = begin + (end - begin) / 2;
+            Run([this, middle, end, grainSize, work, &counter]() { SplitRange(middle, end, grainSize, work, counter); }, &counter);
+            end = middle;
+        }
+
+        (*work)(begin, end);
+    }
+}
@@ -1,5 +1,11 @@
 #include "core/sge_logger.h"
 
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
 namespace SGE
 {
     const std::string InfoPrefix = "[INFO]";
@@ -0,0 +1,291 @@
+#include "core/sge_transform_hierarchy.h"
+
+namespace SGE
+{
+    namespace
+    {
+        constexpr uint8 TRANSFORM_ALIVE = 1 << 0;
+        constexpr uint8 TRANSFORM_LOCAL_DIRTY = 1 << 1; // the local matrix needs composing
+        constexpr uint8 TRANSFORM_WORLD_DIRTY = 1 << 2; // queued in m_dirtyTransforms
+
+        // Past this share of dirty transforms composing every local in place beats gathering the dirty ones.
+        constexpr size_t COMPOSE_ALL_DIVISOR = 4;
+    }
+
+    uint32 TransformHierarchy::Create(uint32 parent)
+    {
+        uint32 transform = 0;
+        if (m_freeTransforms.empty())
+        {
+            transform = static_cast<uint32>(m_parents.size());
+            m_positions.push_back(float3::Zero);
+            m_rotations.push_back(float4::Identity);
+            m_scales.push_back(float3::One);
+            m_localMatrices.push_back(float4x4::Identity);
+            m_worldMatrices.push_back(float4x4::Identity);
+            m_parents.push_back(INVALID_TRANSFORM);
+            m_firstChildren.push_back(INVALID_TRANSFORM);
+            m_nextSiblings.push_back(INVALID_TRANSFORM);
+            m_flags.push_back(0);
+        }
+        else
+        {
+            transform = m_freeTransforms.back();
+            m_freeTransforms.pop_back();
+            m_positions.set(transform, float3::Zero);
+            m_rotations.set(transform, float4::Identity);
+            m_scales.set(transform, float3::One);
+            m_localMatrices[transform] = float4x4::Identity;
+            m_worldMatrices[transform] = float4x4::Identity;
+        }
+
+        m_flags[transform] = TRANSFORM_ALIVE;
+        MarkDirty(transform, false);
+        if (parent != INVALID_TRANSFORM)
+        {
+            SetParent(transform, parent);
+        }
+        return transform;
+    }
+
+    bool TransformHierarchy::Destroy(uint32 transform)
+    {
+        if (!IsAlive(transform))
+        {
+            return false;
+        }
+
+        Detach(transform);
+        uint32 child = m_firstChildren[transform];
+        while (child != INVALID_TRANSFORM)
+        {
+            const uint32 next = m_nextSiblings[child];
+            m_parents[child] = INVALID_TRANSFORM;
+            m_nextSiblings[child] = INVALID_TRANSFORM;
+            MarkDirty(child, false);
+            child = next;
+        }
+
+        m_firstChildren[transform] = INVALID_TRANSFORM;
+        m_flags[transform] = 0; // also drops it from the pending update
+        m_freeTransforms.push_back(transform);
+        return true;
+    }
+
+    void TransformHierarchy::Clear()
+    {
+        m_positions.clear();
+        m_rotations.clear();
+        m_scales.clear();
+        m_localMatrices.clear();
+        m_worldMatrices.clear();
+        m_parents.clear();
+        m_firstChildren.clear();
+        m_nextSiblings.clear();
+        m_flags.clear();
+        m_dirtyTransforms.clear();
+        m_changedTransforms.clear();
+        m_freeTransforms.clear();
+    }
+
+    bool TransformHierarchy::SetParent(uint32 transform, uint32 parent)
+    {
+        if (!IsAlive(transform) || (parent != INVALID_TRANSFORM && !IsAlive(parent)))
+        {
+            return false;
+        }
+
+        if (m_parents[transform] == parent)
+        {
+            return true;
+        }
+
+        for (uint32 ancestor = parent; ancestor != INVALID_TRANSFORM; ancestor = m_parents[ancestor])
+        {
+            if (ancestor == transform)
+            {
+                return false;
+            }
+        }
+
+        Detach(transform);
+        m_parents[transform] = parent;
+        if (parent != INVALID_TRANSFORM)
+        {
+            m_nextSiblings[transform] = m_firstChildren[parent];
+            m_firstChildren[parent] = transform;
+        }
+
+        MarkDirty(transform, false);
+        return true;
+    }
+
+    void TransformHierarchy::SetLocal(uint32 transform, const float3& position, const float4& rotation, const float3& scale)
+    {
+        SetPosition(transform, position);
+        SetRotation(transform, rotation);
+        SetScale(transform, scale);
+    }
+
+    void TransformHierarchy::SetPosition(uint32 transform, const float3& position)
+    {
+        if (m_positions.get(transform) != position)
+        {
+            m_positions.set(transform, position);
+            MarkDirty(transform, true);
+        }
+    }
+
+    void TransformHierarchy::SetRotation(uint32 transform, const float4& rotation)
+    {
+        if (m_rotations.get(transform) != rotation)
+        {
+            m_rotations.set(transform, rotation);
+            MarkDirty(transform, true);
+        }
+    }
+
+    void TransformHierarchy::SetScale(uint32 transform, const float3& scale)
+    {
+        if (m_scales.get(transform) != scale)
+        {
+            m_scales.set(transform, scale);
+            MarkDirty(transform, true);
+        }
+    }
+
+    void TransformHierarchy::Update()
+    {
+        m_changedTransforms.clear();
+        if (m_dirtyTransforms.empty())
+        {
+            return;
+        }
+
+        ComposeDirtyLocals();
+
+        for (uint32 transform : m_dirtyTransforms)
+        {
+            if ((m_flags[transform] & TRANSFORM_WORLD_DIRTY) == 0)
+            {
+                continue; // destroyed, or reached from a dirty ancestor already
+            }
+
+            // A dirty ancestor recomputes this subtree on its own walk.
+            bool hasDirtyAncestor = false;
+            for (uint32 ancestor = m_parents[transform]; ancestor != INVALID_TRANSFORM; ancestor = m_parents[ancestor])
+            {
+                if (m_flags[ancestor] & TRANSFORM_WORLD_DIRTY)
+                {
+                    hasDirtyAncestor = true;
+                    break;
+                }
+            }
+
+            if (!hasDirtyAncestor)
+            {
+                UpdateSubtree(transform);
+            }
+        }
+
+        m_dirtyTransforms.clear();
+    }
+
+    bool TransformHierarchy::IsAlive(uint32 transform) const
+    {
+        return transform < m_flags.size() && (m_flags[transform] & TRANSFORM_ALIVE) != 0;
+    }
+
+    void TransformHierarchy::MarkDirty(uint32 transform, bool isLocalChanged)
+    {
+        if ((m_flags[transform] & TRANSFORM_WORLD_DIRTY) == 0)
+        {
+            m_flags[transform] |= TRANSFORM_WORLD_DIRTY;
+            m_dirtyTransforms.push_back(transform);
+        }
+
+        if (isLocalChanged)
+        {
+            m_flags[transform] |= TRANSFORM_LOCAL_DIRTY;
+        }
+    }
+
+    void TransformHierarchy::Detach(uint32 transform)
+    {
+        const uint32 parent = m_parents[transform];
+        if (parent == INVALID_TRANSFORM)
+        {
+            return;
+        }
+
+        uint32* link = &m_firstChildren[parent];
+        while (*link != transform)
+        {
+            link = &m_nextSiblings[*link];
+        }
+
+        *link = m_nextSiblings[transform];
+        m_nextSiblings[transform] = INVALID_TRANSFORM;
+        m_parents[transform] = INVALID_TRANSFORM;
+    }
+
+    void TransformHierarchy::ComposeDirtyLocals()
+    {
+        if (m_dirtyTransforms.size() > m_parents.size() / COMPOSE_ALL_DIVISOR)
+        {
+            ComposeTRS(m_positions, m_rotations, m_scales, m_localMatrices);
+            for (uint32 transform : m_dirtyTransforms)
+            {
+                m_flags[transform] &= ~TRANSFORM_LOCAL_DIRTY;
+            }
+            return;
+        }
+
+        m_composePositions.clear();
+        m_composeRotations.clear();
+        m_composeScales.clear();
+        for (uint32 transform : m_dirtyTransforms)
+        {
+            if (m_flags[transform] & TRANSFORM_LOCAL_DIRTY)
+            {
+                m_composePositions.push_back(m_positions.get(transform));
+                m_composeRotations.push_back(m_rotations.get(transform));
+                m_composeScales.push_back(m_scales.get(transform));
+            }
+        }
+
+        m_composed.resize(m_composePositions.size());
+        ComposeTRS(m_composePositions, m_composeRotations, m_composeScales, m_composed);
+
+        size_t composedIndex = 0;
+        for (uint32 transform : m_dirtyTransforms)
+        {
+            if (m_flags[transform] & TRANSFORM_LOCAL_DIRTY)
+            {
+                m_localMatrices[transform] = m_composed[composedIndex++];
+                m_flags[transform] &= ~TRANSFORM_LOCAL_DIRTY;
+            }
+        }
+    }
+
+    void TransformHierarchy::UpdateSubtree(uint32 root)
+    {
+        m_stack.clear();
+        m_stack.push_back(root);
+        while (!m_stack.empty())
+        {
+            const uint32 transform = m_stack.back();
+            m_stack.pop_back();
+
+            const uint32 parent = m_parents[transform];
+            m_worldMatrices[transform] = parent == INVALID_TRANSFORM ? m_localMatrices[transform] : m_worldMatrices[parent] * m_localMatrices[transform];
+            m_flags[transform] &= ~TRANSFORM_WORLD_DIRTY;
+            m_changedTransforms.push_back(transform);
+
+            for (uint32 child = m_firstChildren[transform]; child != INVALID_TRANSFORM; child = m_nextSiblings[child])
+            {
+                m_stack.push_back(child);
+            }
+        }
+    }
+}
@@ -2,13 +2,12 @@
 
 #include "core/sge_helpers.h"
 #include "core/sge_device.h"
-#include "data/sge_data_structures.h"
 
 namespace SGE
 {
-    void VertexBuffer::Initialize(Device* device, const std::vector<Vertex>& vertices)
+    void VertexBuffer::Initialize(Device* device, const void* data, uint32 vertexCount, uint32 stride)
     {
-        const UINT vertexBufferSize = static_cast<UINT>(vertices.size() * sizeof(Vertex));
+        const UINT vertexBufferSize = static_cast<UINT>(vertexCount * stride);
 
         HRESULT hr = device->GetDevice()->CreateCommittedResource(
             &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
@@ -23,12 +22,12 @@ namespace SGE
         UINT8* pVertexDataBegin;
         CD3DX12_RANGE readRange(0, 0);
         Verify(m_resource->Map(0, &readRange, reinterpret_cast<void**>(&pVertexDataBegin)), "Failed to map vertex buffer.");
-        memcpy(pVertexDataBegin, vertices.data(), vertexBufferSize);
+        memcpy(pVertexDataBegin, data, vertexBufferSize);
         m_resource->Unmap(0, nullptr);
         
         m_view = {};
         m_view.BufferLocation = m_resource->GetGPUVirtualAddress();
-        m_view.StrideInBytes = sizeof(Vertex);
+        m_view.StrideInBytes = stride;
         m_view.SizeInBytes = vertexBufferSize;
     }
 
@@ -23,57 +23,6 @@ namespace SGE
         return float4(quat.x, quat.y, -quat.z, quat.w);
     }
 
-    float3 InterpolatePosition(const std::vector<PositionKeyframe>& keys, float time)
-    {
-        if (keys.empty()) return float3::Zero;
-        if (keys.size() == 1) return keys[0].position;
-
-        for (size_t i = 0; i < keys.size() - 1; ++i)
-        {
-            if (time >= keys[i].time && time <= keys[i + 1].time)
-            {
-                float t = (time - keys[i].time) / (keys[i + 1].time - keys[i].time);
-                return lerp(keys[i].position, keys[i + 1].position, t);
-            }
-        }
-
-        return keys.back().position;
-    }
-
-    float4 InterpolateRotation(const std::vector<RotationKeyframe>& keys, float time)
-    {
-        if (keys.empty()) return float4::Identity;
-        if (keys.size() == 1) return keys[0].rotation;
-
-        for (size_t i = 0; i < keys.size() - 1; ++i)
-        {
-            if (time >= keys[i].time && time <= keys[i + 1].time)
-            {
-                float t = (time - keys[i].time) / (keys[i + 1].time - keys[i].time);
-                return slerp(keys[i].rotation, keys[i + 1].rotation, t);
-            }
-        }
-
-        return keys.back().rotation;
-    }
-
-    float3 InterpolateScale(const std::vector<ScaleKeyframe>& keys, float time)
-    {
-        if (keys.empty()) return float3::One;
-        if (keys.size() == 1) return keys[0].scale;
-
-        for (size_t i = 0; i < keys.size() - 1; ++i)
-        {
-            if (time >= keys[i].time && time <= keys[i + 1].time)
-            {
-                float t = (time - keys[i].time) / (keys[i + 1].time - keys[i].time);
-                return lerp(keys[i].scale, keys[i + 1].scale, t);
-            }
-        }
-
-        return keys.back().scale;
-    }
-
     void AnimatedModelInstance::Initialize(AnimatedModelAsset* asset, Device* device, DescriptorHeap* descriptorHeap, uint32 instanceIndex)
     {
         m_animatedAsset = asset;
@@ -82,21 +31,28 @@ namespace SGE
         const Skeleton& skeleton = m_animatedAsset->GetSkeleton();
         size_t boneCount = skeleton.GetBoneCount();
 
-        m_finalBoneTransforms.resize(boneCount, float4x4::Identity);
-        for (int32 i = 0; i < 3; ++i)
-        {
-            m_layerBoneTransforms[i].resize(boneCount, float4x4::Identity);
-        }
+        m_pose.Initialize(static_cast<int32>(boneCount));
     }
 
     void AnimatedModelInstance::SelectAnimationForLayer(const std::string& animationName, int layer)
     {
-        const auto& animations = m_animatedAsset->GetAnimations();
-        auto it = std::find_if(animations.begin(), animations.end(), [&animationName](const Animation& anim) { return anim.name == animationName; });
+        if (layer < 0)
+        {
+            throw std::out_of_range("Invalid animation layer");
+        }
 
-        if (it != animations.end())
+        AnimationClipHandle clip = m_animatedAsset->FindAnimationClip(animationName);
+
+        if (clip != INVALID_ANIMATION_CLIP)
         {
-            m_layerAnimations[layer] = { animationName, 0.0f, false, it->ticksPerSecond };
+            // Weight and blend mode belong to the layer and survive switching its clip.
+            LayerAnimation& layerAnimation = m_layerAnimations[layer];
+            layerAnimation.animationName = animationName;
+            layerAnimation.currentTime = 0.0f;
+            layerAnimation.isPlaying = false;
+            layerAnimation.ticksPerSecond = m_animatedAsset->GetAnimationClip(clip).GetTicksPerSecond();
+            layerAnimation.clip = clip;
+            layerAnimation.cursors.assign(m_animatedAsset->GetSkeleton().GetBoneCount(), KeyframeCursor{});
         }
         else
         {
@@ -109,6 +65,7 @@ namespace SGE
         if (m_layerAnimations.find(layer) != m_layerAnimations.end())
         {
             m_layerAnimations[layer].isPlaying = true;
+            m_isInBindPose = false;
         }
     }
 
@@ -147,18 +104,10 @@ namespace SGE
 
     float AnimatedModelInstance::GetCurrentAnimationDurationForLayer(int layer) const
     {
-        const auto& animations = m_animatedAsset->GetAnimations();
-        if (m_layerAnimations.find(layer) != m_layerAnimations.end())
+        auto it = m_layerAnimations.find(layer);
+        if (it != m_layerAnimations.end() && it->second.clip != INVALID_ANIMATION_CLIP)
         {
-            const std::string& animationName = m_layerAnimations.at(layer).animationName;
-            auto it = std::find_if(animations.begin(), animations.end(), [&animationName](const Animation& anim) {
-                return anim.name == animationName;
-            });
-
-            if (it != animations.end())
-            {
-                return it->duration;
-            }
+            return m_animatedAsset->GetAnimationClip(it->second.clip).GetDuration();
         }
         return 0.0f;
     }
@@ -181,92 +130,80 @@ namespace SGE
         return "";
     }
 
-    void AnimatedModelInstance::UpdateBoneTransformsForLayer(int32 boneIndex, const float4x4& parentTransform, const Animation& currentAnimation, float animationTime, int layer)
+    void AnimatedModelInstance::SetWeightForLayer(int layer, float weight)
     {
-        const Skeleton& skeleton = m_animatedAsset->GetSkeleton();
-        const Bone& bone = skeleton.GetBone(boneIndex);
-
-        auto it = currentAnimation.boneKeyframes.find(bone.name);
-        if (it == currentAnimation.boneKeyframes.end())
+        if (m_layerAnimations.find(layer) != m_layerAnimations.end())
         {
-            m_layerBoneTransforms[layer][boneIndex] = parentTransform * bone.offsetMatrix;
-            return;
+            m_layerAnimations[layer].weight = std::clamp(weight, 0.0f, 1.0f);
         }
+    }
 
-        const BoneKeyframes& boneKeyframes = it->second;
-
-        float3 position = InterpolatePosition(boneKeyframes.positionKeys, animationTime);
-        float4 rotation = InterpolateRotation(boneKeyframes.rotationKeys, animationTime);
-        float3 scale = InterpolateScale(boneKeyframes.scaleKeys, animationTime);
-
-        float4x4 translationMatrix = CreateTranslationMatrix(position);
-        float4x4 rotationMatrix = CreateRotationMatrixFromQuaternion(rotation);
-        float4x4 scaleMatrix = CreateScaleMatrix(scale);
-
-        float4x4 localTransform = translationMatrix * rotationMatrix * scaleMatrix;
-        float4x4 globalTransform = parentTransform * localTransform;
-        m_layerBoneTransforms[layer][boneIndex] = globalTransform * bone.offsetMatrix;
-
-        for (int32 childIndex : bone.children)
+    void AnimatedModelInstance::SetBlendModeForLayer(int layer, AnimationBlendMode blendMode)
+    {
+        if (m_layerAnimations.find(layer) != m_layerAnimations.end())
         {
-            UpdateBoneTransformsForLayer(childIndex, globalTransform, currentAnimation, animationTime, layer);
+            m_layerAnimations[layer].blendMode = blendMode;
         }
     }
 
-    void AnimatedModelInstance::BlendBoneTransforms()
+    void AnimatedModelInstance::EvaluatePose()
     {
-        std::fill(m_finalBoneTransforms.begin(), m_finalBoneTransforms.end(), float4x4::Identity);
-
         const Skeleton& skeleton = m_animatedAsset->GetSkeleton();
+        const BoneHierarchy& hierarchy = skeleton.GetHierarchy();
 
-        for (auto& layerAnim : m_layerAnimations)
+        m_blendLayers.clear();
+        for (auto& [layer, layerAnimation] : m_layerAnimations)
         {
-            int layer = layerAnim.first;
-            const auto& boneTransforms = m_layerBoneTransforms[layer];
-            for (size_t i = 0; i < boneTransforms.size(); ++i)
-            {
-                const Bone& bone = skeleton.GetBone(static_cast<uint32>(i));
-                float boneWeight = bone.weights[layer];
-                m_finalBoneTransforms[i] = m_finalBoneTransforms[i] * (1.0f - boneWeight) + boneTransforms[i] * boneWeight;
-            }
+            if (layerAnimation.clip == INVALID_ANIMATION_CLIP) continue;
+
+            AnimationBlendLayer blendLayer;
+            blendLayer.clip = &m_animatedAsset->GetAnimationClip(layerAnimation.clip);
+            blendLayer.cursors = &layerAnimation.cursors;
+            blendLayer.time = layerAnimation.currentTime;
+            blendLayer.weight = layerAnimation.weight;
+            blendLayer.mode = layerAnimation.blendMode;
+            blendLayer.mask = skeleton.GetLayerMask(layer);
+            m_blendLayers.push_back(blendLayer);
         }
+
+        m_blender.Evaluate(hierarchy, m_blendLayers, m_pose);
+        m_pose.ComputeModelPose(hierarchy);
+        m_pose.ComputeSkinningPalette(hierarchy);
     }
 
     void AnimatedModelInstance::FixedUpdate(float deltaTime, bool forceUpdate)
     {
-        for (auto& layerAnim : m_layerAnimations)
+        if (forceUpdate)
         {
-            if (!layerAnim.second.isPlaying && !forceUpdate) continue;
+            m_isInBindPose = false;
+        }
 
-            const auto& animations = m_animatedAsset->GetAnimations();
-            auto it = std::find_if(animations.begin(), animations.end(), [&layerAnim](const Animation& anim) { return anim.name == layerAnim.second.animationName; });
+        if (m_isInBindPose)
+        {
+            return;
+        }
 
-            if (it == animations.end()) continue;
+        for (auto& layerAnim : m_layerAnimations)
+        {
+            if (!layerAnim.second.isPlaying && !forceUpdate) continue;
 
-            const Animation& currentAnimation = *it;
-            layerAnim.second.currentTime += deltaTime * currentAnimation.ticksPerSecond;
+            if (layerAnim.second.clip == INVALID_ANIMATION_CLIP) continue;
 
-            if (layerAnim.second.currentTime > currentAnimation.duration)
-            {
-                layerAnim.second.currentTime = fmod(layerAnim.second.currentTime, currentAnimation.duration);
-            }
+            const AnimationClip& clip = m_animatedAsset->GetAnimationClip(layerAnim.second.clip);
+            layerAnim.second.currentTime += deltaTime * clip.GetTicksPerSecond();
 
-            const Skeleton& skeleton = m_animatedAsset->GetSkeleton();
-            for (int32 i = 0; i < skeleton.GetBoneCount(); ++i)
+            if (layerAnim.second.currentTime > clip.GetDuration())
             {
-                if (skeleton.GetBone(i).parentIndex == -1)
-                {
-                    UpdateBoneTransformsForLayer(i, float4x4::Identity, currentAnimation, layerAnim.second.currentTime, layerAnim.first);
-                }
+                layerAnim.second.currentTime = fmod(layerAnim.second.currentTime, clip.GetDuration());
             }
         }
 
-        BlendBoneTransforms();
+        EvaluatePose();
     }
 
-    const std::vector<Animation>& AnimatedModelInstance::GetAnimations() const
+    const std::vector<AnimationClip>& AnimatedModelInstance::GetAnimationClips() const
     {
-        return m_animatedAsset->GetAnimations();
+        return m_animatedAsset->GetAnimationClips();
     }
 
     Skeleton& AnimatedModelInstance::GetSkeleton() const
@@ -279,18 +216,19 @@ namespace SGE
         return m_animatedAsset->GetSkeleton();
     }
 
-    void AnimatedModelInstance::OnUpdateTransform(const float4x4& viewMatrix, const float4x4& projectionMatrix)
+    void AnimatedModelInstance::OnUpdateTransform(const float4x4& worldMatrix, const float4x4& viewMatrix, const float4x4& projectionMatrix)
     {
-        m_transformData.model = GetWorldMatrix();
+        m_transformData.model = worldMatrix;
         m_transformData.view = viewMatrix;
         m_transformData.projection = projectionMatrix;
         m_transformData.isAnimated = true;
         m_transformData.tilingUV = { 1.0f, 1.0f };
         
-        size_t boneCount = min(100, m_finalBoneTransforms.size());
+        const float4x4_array& skinningPalette = m_pose.GetSkinningPalette();
+        size_t boneCount = std::min<size_t>(100, skinningPalette.size());
         for (size_t i = 0; i < boneCount; ++i)
         {
-            m_transformData.boneTransforms[i] = m_finalBoneTransforms[i];
+            m_transformData.boneTransforms[i] = skinningPalette[i];
         }
 
         for (size_t i = boneCount; i < 100; ++i)
@@ -301,9 +239,20 @@ namespace SGE
         m_transformBuffer.Update(&m_transformData, sizeof(TransformBuffer));
     }
 
-    const std::vector<Mesh>& AnimatedModelInstance::GetMeshes() const
+    ModelBounds AnimatedModelInstance::GetLocalBounds() const
+    {
+        ModelBounds bounds = ModelInstance::GetLocalBounds();
+        const float3 size = bounds.boxMax - bounds.boxMin;
+        const float padding = std::max(size.x, std::max(size.y, size.z)) * ANIMATED_BOUNDS_PADDING;
+        bounds.boxMin = bounds.boxMin - float3(padding, padding, padding);
+        bounds.boxMax = bounds.boxMax + float3(padding, padding, padding);
+        bounds.sphereRadius += padding;
+        return bounds;
+    }
+
+    Span<const MeshResourceInfo> AnimatedModelInstance::GetMeshInfos() const
     {
-        return m_animatedAsset->GetMeshes();
+        return m_animatedAsset->GetMeshInfos();
     }
 
     void AnimatedModelInstance::ResetToTPose()
@@ -314,18 +263,11 @@ namespace SGE
             layerAnim.second.currentTime = 0.0f;
         }
 
-        const Skeleton& skeleton = m_animatedAsset->GetSkeleton();
-        for (int32 i = 0; i < skeleton.GetBoneCount(); ++i)
-        {
-            const Bone& bone = skeleton.GetBone(i);
-            m_finalBoneTransforms[i] = float4x4::Identity;
-
-            for (int layer = 0; layer < 3; ++layer)
-            {
-                m_layerBoneTransforms[layer][i] = m_finalBoneTransforms[i];
-            }
-        }
-
-        BlendBoneTransforms();
+        // Stays in the bind pose until a layer plays or the pose is forced to update.
+        const BoneHierarchy& hierarchy = m_animatedAsset->GetSkeleton().GetHierarchy();
+        m_pose.SetBindPose(hierarchy);
+        m_pose.ComputeModelPose(hierarchy);
+        m_pose.ComputeSkinningPalette(hierarchy);
+        m_isInBindPose = true;
     }
 }
\ No newline at end of file
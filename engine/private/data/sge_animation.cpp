@@ -0,0 +1,144 @@
+#include "data/sge_animation.h"
+#include "data/sge_keyframe_sampler.h"
+
+namespace SGE
+{
+    void AnimationClip::Initialize(const Animation& animation, const std::unordered_map<std::string, int32>& boneNameToIndex, int32 boneCount)
+    {
+        m_name = animation.name;
+        m_duration = animation.duration;
+        m_ticksPerSecond = animation.ticksPerSecond;
+        m_channels.assign(boneCount, AnimationChannel{});
+
+        size_t positionKeyCount = 0;
+        size_t rotationKeyCount = 0;
+        size_t scaleKeyCount = 0;
+        for (const auto& [boneName, keyframes] : animation.boneKeyframes)
+        {
+            positionKeyCount += keyframes.positionKeys.size();
+            rotationKeyCount += keyframes.rotationKeys.size();
+            scaleKeyCount += keyframes.scaleKeys.size();
+        }
+
+        m_positionTimes.clear();
+        m_positions.clear();
+        m_rotationTimes.clear();
+        m_rotations.clear();
+        m_scaleTimes.clear();
+        m_scales.clear();
+
+        m_positionTimes.reserve(positionKeyCount);
+        m_positions.reserve(positionKeyCount);
+        m_rotationTimes.reserve(rotationKeyCount);
+        m_rotations.reserve(rotationKeyCount);
+        m_scaleTimes.reserve(scaleKeyCount);
+        m_scales.reserve(scaleKeyCount);
+
+        // Keys are appended in bone index order so a pose walks the arrays front to back.
+        std::vector<const BoneKeyframes*> keyframesByBone(boneCount, nullptr);
+        for (const auto& [boneName, keyframes] : animation.boneKeyframes)
+        {
+            auto it = boneNameToIndex.find(boneName);
+            if (it != boneNameToIndex.end() && it->second >= 0 && it->second < boneCount)
+            {
+                keyframesByBone[it->second] = &keyframes;
+            }
+        }
+
+        for (int32 boneIndex = 0; boneIndex < boneCount; ++boneIndex)
+        {
+            const BoneKeyframes* keyframes = keyframesByBone[boneIndex];
+            if (!keyframes)
+            {
+                continue;
+            }
+
+            AnimationChannel& channel = m_channels[boneIndex];
+
+            channel.positionOffset = static_cast<uint32>(m_positionTimes.size());
+            channel.positionCount = static_cast<uint32>(keyframes->positionKeys.size());
+            for (const PositionKeyframe& key : keyframes->positionKeys)
+            {
+                m_positionTimes.push_back(key.time);
+                m_positions.push_back(key.position);
+            }
+
+            channel.rotationOffset = static_cast<uint32>(m_rotationTimes.size());
+            channel.rotationCount = static_cast<uint32>(keyframes->rotationKeys.size());
+            for (const RotationKeyframe& key : keyframes->rotationKeys)
+            {
+                m_rotationTimes.push_back(key.time);
+                m_rotations.push_back(key.rotation);
+            }
+
+            channel.scaleOffset = static_cast<uint32>(m_scaleTimes.size());
+            channel.scaleCount = static_cast<uint32>(keyframes->scaleKeys.size());
+            for (const ScaleKeyframe& key : keyframes->scaleKeys)
+            {
+                m_scaleTimes.push_back(key.time);
+                m_scales.push_back(key.scale);
+            }
+        }
+    }
+
+    size_t AnimationClip::GetMemorySize() const
+    {
+        return m_channels.size() * sizeof(AnimationChannel) +
+               (m_positionTimes.size() + m_rotationTimes.size() + m_scaleTimes.size()) * sizeof(float) +
+               m_positions.size() * sizeof(float3) +
+               m_rotations.size() * sizeof(float4) +
+               m_scales.size() * sizeof(float3);
+    }
+
+    BonePose AnimationClip::SampleBone(int32 boneIndex, float time, KeyframeCursor& cursor) const
+    {
+        const AnimationChannel& channel = m_channels[boneIndex];
+        BonePose pose;
+
+        if (channel.positionCount == 1)
+        {
+            pose.position = m_positions[channel.positionOffset];
+        }
+        else if (channel.positionCount > 1)
+        {
+            const float* times = m_positionTimes.data() + channel.positionOffset;
+            const float3* values = m_positions.data() + channel.positionOffset;
+            uint32 index = FindKeyframeSegment(times, channel.positionCount, time, cursor.position);
+            pose.position = lerp(values[index], values[index + 1], GetSegmentFactor(times, index, time));
+        }
+
+        if (channel.rotationCount == 1)
+        {
+            pose.rotation = m_rotations[channel.rotationOffset];
+        }
+        else if (channel.rotationCount > 1)
+        {
+            const float* times = m_rotationTimes.data() + channel.rotationOffset;
+            const float4* values = m_rotations.data() + channel.rotationOffset;
+            uint32 index = FindKeyframeSegment(times, channel.rotationCount, time, cursor.rotation);
+            pose.rotation = slerp(values[index], values[index + 1], GetSegmentFactor(times, index, time));
+        }
+
+        if (channel.scaleCount == 1)
+        {
+            pose.scale = m_scales[channel.scaleOffset];
+        }
+        else if (channel.scaleCount > 1)
+        {
+            const float* times = m_scaleTimes.data() + channel.scaleOffset;
+            const float3* values = m_scales.data() + channel.scaleOffset;
+            uint32 index = FindKeyframeSegment(times, channel.scaleCount, time, cursor.scale);
+            pose.scale = lerp(values[index], values[index + 1], GetSegmentFactor(times, index, time));
+        }
+
+        return pose;
+    }
+
+    BonePose AnimationClip::SampleBone(int32 boneIndex, float time) const
+    {
+        // Starting at the last segment sends every earlier time through the binary search.
+        KeyframeCursor cursor;
+        cursor.position = cursor.rotation = cursor.scale = std::numeric_limits<uint32>::max();
+        return SampleBone(boneIndex, time, cursor);
+    }
+}
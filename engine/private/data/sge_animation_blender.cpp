@@ -0,0 +1,101 @@
+#include "data/sge_animation_blender.h"
+
+namespace SGE
+{
+    void BoneMask::Initialize(const std::vector<float>& boneWeights)
+    {
+        boneIndices.clear();
+        weights.clear();
+
+        for (size_t i = 0; i < boneWeights.size(); ++i)
+        {
+            float weight = std::clamp(boneWeights[i], 0.0f, 1.0f);
+            if (weight > 0.0f)
+            {
+                boneIndices.push_back(static_cast<int32>(i));
+                weights.push_back(weight);
+            }
+        }
+    }
+
+    void AnimationBlender::Evaluate(const BoneHierarchy& hierarchy, Span<const AnimationBlendLayer> layers, AnimationPose& pose) const
+    {
+        pose.SetBindPose(hierarchy);
+
+        for (const AnimationBlendLayer& layer : layers)
+        {
+            if (!layer.clip || layer.weight <= 0.0f)
+            {
+                continue;
+            }
+
+            const int32 boneCount = std::min(pose.GetBoneCount(), layer.clip->GetChannelCount());
+            if (layer.cursors && static_cast<int32>(layer.cursors->size()) < boneCount)
+            {
+                layer.cursors->resize(boneCount);
+            }
+
+            if (layer.mask)
+            {
+                for (size_t i = 0; i < layer.mask->GetSize(); ++i)
+                {
+                    int32 boneIndex = layer.mask->boneIndices[i];
+                    if (boneIndex < boneCount)
+                    {
+                        BlendBone(pose, layer, boneIndex, layer.weight * layer.mask->weights[i]);
+                    }
+                }
+            }
+            else
+            {
+                for (int32 boneIndex = 0; boneIndex < boneCount; ++boneIndex)
+                {
+                    BlendBone(pose, layer, boneIndex, layer.weight);
+                }
+            }
+        }
+    }
+
+    void AnimationBlender::BlendBone(AnimationPose& pose, const AnimationBlendLayer& layer, int32 boneIndex, float weight) const
+    {
+        if (!layer.clip->GetChannel(boneIndex).IsAnimated())
+        {
+            return;
+        }
+
+        const BonePose sample = layer.cursors
+            ? layer.clip->SampleBone(boneIndex, layer.time, (*layer.cursors)[boneIndex])
+            : layer.clip->SampleBone(boneIndex, layer.time);
+
+        weight = std::min(weight, 1.0f);
+
+        if (layer.mode == AnimationBlendMode::Additive)
+        {
+            const BonePose current = pose.GetBonePose(boneIndex);
+            const float4 deltaRotation = nlerp(float4::Identity, sample.rotation, weight);
+            const float3 deltaScale = lerp(float3::One, sample.scale, weight);
+
+            BonePose result;
+            result.position = current.position + sample.position * weight;
+            result.rotation = MultiplyQuaternions(current.rotation, deltaRotation).normalized();
+            result.scale = float3(current.scale.x * deltaScale.x, current.scale.y * deltaScale.y, current.scale.z * deltaScale.z);
+            pose.SetBonePose(boneIndex, result);
+        }
+        else if (weight >= 1.0f)
+        {
+            pose.SetBonePose(boneIndex, sample);
+        }
+        else
+        {
+            const BonePose current = pose.GetBonePose(boneIndex);
+
+            BonePose result;
+            result.position = lerp(current.position, sample.position, weight);
+            result.rotation = m_rotationBlend == RotationBlend::Slerp
+                ? slerp(current.rotation, sample.rotation, weight)
+                : nlerp(current.rotation, sample.rotation, weight);
+            result.scale = lerp(current.scale, sample.scale, weight);
+            pose.SetBonePose(boneIndex, result);
+        }
+    }
+}
@@ -0,0 +1,176 @@
+#include "data/sge_animation_pose.h"
+
+namespace SGE
+{
+    void BoneHierarchy::Initialize(const std::vector<int32>& parents, const float4x4_array& offsets)
+    {
+        const int32 boneCount = static_cast<int32>(parents.size());
+
+        parentIndices = parents;
+        offsetMatrices = offsets;
+        offsetMatrices.resize(boneCount, float4x4::Identity);
+
+        for (int32& parent : parentIndices)
+        {
+            if (parent < -1 || parent >= boneCount)
+            {
+                parent = -1;
+            }
+        }
+
+        // Children grouped per parent (counting sort), then a pre-order walk from every root so
+        // that each subtree is contiguous in the evaluation order.
+        std::vector<int32> childStart(boneCount + 1, 0);
+        for (int32 parent : parentIndices)
+        {
+            if (parent != -1)
+            {
+                ++childStart[parent + 1];
+            }
+        }
+
+        for (int32 i = 0; i < boneCount; ++i)
+        {
+            childStart[i + 1] += childStart[i];
+        }
+
+        std::vector<int32> children(childStart[boneCount]);
+        std::vector<int32> fill(childStart.begin(), childStart.end() - 1);
+        for (int32 bone = 0; bone < boneCount; ++bone)
+        {
+            int32 parent = parentIndices[bone];
+            if (parent != -1)
+            {
+                children[fill[parent]++] = bone;
+            }
+        }
+
+        evaluationOrder.clear();
+        evaluationOrder.reserve(boneCount);
+        std::vector<bool> visited(boneCount, false);
+        std::vector<int32> stack;
+
+        auto visit = [&](int32 root)
+        {
+            stack.push_back(root);
+            while (!stack.empty())
+            {
+                int32 bone = stack.back();
+                stack.pop_back();
+                if (visited[bone])
+                {
+                    continue;
+                }
+
+                visited[bone] = true;
+                evaluationOrder.push_back(bone);
+
+                for (int32 i = childStart[bone + 1] - 1; i >= childStart[bone]; --i)
+                {
+                    stack.push_back(children[i]);
+                }
+            }
+        };
+
+        for (int32 bone = 0; bone < boneCount; ++bone)
+        {
+            if (parentIndices[bone] == -1)
+            {
+                visit(bone);
+            }
+        }
+
+        // Bones caught in a parent cycle are never reached from a root, evaluate them as roots.
+        for (int32 bone = 0; bone < boneCount; ++bone)
+        {
+            if (!visited[bone])
+            {
+                parentIndices[bone] = -1;
+                visit(bone);
+            }
+        }
+
+        bindPose.resize(boneCount);
+        for (int32 bone = 0; bone < boneCount; ++bone)
+        {
+            int32 parent = parentIndices[bone];
+            float4x4 bindModel = offsetMatrices[bone].inverse();
+            float4x4 bindLocal = parent == -1 ? bindModel : offsetMatrices[parent] * bindModel;
+
+            BonePose& pose = bindPose[bone];
+            DecomposeMatrix(bindLocal, pose.position, pose.rotation, pose.scale);
+        }
+    }
+
+    void AnimationPose::Initialize(int32 boneCount)
+    {
+        m_localPositions.resize(boneCount);
+        m_localRotations.resize(boneCount);
+        m_localScales.resize(boneCount);
+        m_localMatrices.resize(boneCount);
+        m_modelPose.resize(boneCount);
+        m_skinningPalette.resize(boneCount);
+        SetIdentity();
+    }
+
+    void AnimationPose::SetIdentity()
+    {
+        const BonePose identity;
+        for (int32 i = 0; i < GetBoneCount(); ++i)
+        {
+            SetBonePose(i, identity);
+        }
+
+        std::fill(m_localMatrices.begin(), m_localMatrices.end(), float4x4::Identity);
+        std::fill(m_modelPose.begin(), m_modelPose.end(), float4x4::Identity);
+        std::fill(m_skinningPalette.begin(), m_skinningPalette.end(), float4x4::Identity);
+    }
+
+    void AnimationPose::SetBindPose(const BoneHierarchy& hierarchy)
+    {
+        const int32 boneCount = std::min(GetBoneCount(), hierarchy.GetBoneCount());
+        for (int32 i = 0; i < boneCount; ++i)
+        {
+            SetBonePose(i, hierarchy.bindPose[i]);
+        }
+    }
+
+    void AnimationPose::SetBonePose(int32 boneIndex, const BonePose& pose)
+    {
+        m_localPositions.set(boneIndex, pose.position);
+        m_localRotations.set(boneIndex, pose.rotation);
+        m_localScales.set(boneIndex, pose.scale);
+    }
+
+    BonePose AnimationPose::GetBonePose(int32 boneIndex) const
+    {
+        return { m_localPositions.get(boneIndex), m_localRotations.get(boneIndex), m_localScales.get(boneIndex) };
+    }
+
+    void AnimationPose::SampleClip(const AnimationClip& clip, float time, std::vector<KeyframeCursor>& cursors)
+    {
+        const int32 boneCount = std::min(GetBoneCount(), clip.GetChannelCount());
+        cursors.resize(GetBoneCount());
+
+        for (int32 i = 0; i < boneCount; ++i)
+        {
+            SetBonePose(i, clip.GetChannel(i).IsAnimated() ? clip.SampleBone(i, time, cursors[i]) : BonePose{});
+        }
+    }
+
+    void AnimationPose::ComputeModelPose(const BoneHierarchy& hierarchy)
+    {
+        ComposeTRS(m_localPositions, m_localRotations, m_localScales, m_localMatrices);
+
+        for (int32 bone : hierarchy.evaluationOrder)
+        {
+            int32 parent = hierarchy.parentIndices[bone];
+            m_modelPose[bone] = parent == -1 ? m_localMatrices[bone] : m_modelPose[parent] * m_localMatrices[bone];
+        }
+    }
+
+    void AnimationPose::ComputeSkinningPalette(const BoneHierarchy& hierarchy)
+    {
+        MultiplyMatrices(m_modelPose, hierarchy.offsetMatrices, m_skinningPalette);
+    }
+}
@@ -0,0 +1,420 @@
+#include "data/sge_asset_cooker.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include "json.hpp"
+#include "core/sge_hash.h"
+#include "core/sge_job_system.h"
+#include "core/sge_mapped_file.h"
+#include "data/sge_mesh_cache.h"
+#include "data/sge_model_importer.h"
+#include "data/sge_texture_cooker.h"
+
+namespace SGE
+{
+    namespace
+    {
+        // Values of AssetType in sge_data_structures.h, which can't be included without the renderer.
+        constexpr int32 SETTINGS_MODEL = 0;
+        constexpr int32 SETTINGS_ANIMATED_MODEL = 1;
+        constexpr int32 SETTINGS_MATERIAL = 2;
+        constexpr int32 SETTINGS_CUBEMAP = 4;
+
+        constexpr std::pair<const char*, TextureUsage> MATERIAL_TEXTURE_KEYS[] = {
+            { "albedo_texture_path", TextureUsage::Color },
+            { "metallic_texture_path", TextureUsage::Mask },
+            { "normal_texture_path", TextureUsage::Normal },
+            { "roughness_texture_path", TextureUsage::Mask }
+        };
+        constexpr const char* CUBEMAP_FACE_KEYS[] = { "right", "left", "top", "bottom", "front", "back" };
+        constexpr const char* MODEL_EXTENSIONS[] = { ".gltf", ".glb", ".fbx", ".obj", ".dae" };
+
+        const char* GetKindName(AssetKind kind)
+        {
+            switch (kind)
+            {
+            case AssetKind::Model: return "model";
+            case AssetKind::AnimatedModel: return "animated_model";
+            case AssetKind::Texture: return "texture";
+            default: return "unknown";
+            }
+        }
+
+        bool ParseKindName(const std::string& name, AssetKind& kind)
+        {
+            for (uint32 i = 0; i < static_cast<uint32>(AssetKind::Count); ++i)
+            {
+                if (name == GetKindName(static_cast<AssetKind>(i)))
+                {
+                    kind = static_cast<AssetKind>(i);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::string GetLowerExtension(const std::filesystem::path& path)
+        {
+            std::string extension = path.extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return extension;
+        }
+
+        bool HashFile(const std::string& path, uint64& hash)
+        {
+            MappedFile file;
+            if (!file.Open(path))
+            {
+                return false;
+            }
+
+            hash = HashBytes(hash, file.GetData(), file.GetSize());
+            return true;
+        }
+
+        // A .gltf keeps its geometry in separate buffer files, a change there must recook the model too.
+        bool HashGltfBuffers(const std::string& path, uint64& hash)
+        {
+            std::ifstream file(path);
+            const nlohmann::json gltf = nlohmann::json::parse(file, nullptr, false);
+            if (gltf.is_discarded())
+            {
+                return false;
+            }
+
+            auto buffers = gltf.find("buffers");
+            if (buffers == gltf.end() || !buffers->is_array())
+            {
+                return true;
+            }
+
+            const std::filesystem::path directory = std::filesystem::path(path).parent_path();
+            for (const nlohmann::json& buffer : *buffers)
+            {
+                const std::string uri = buffer.value("uri", "");
+                if (uri.empty() || uri.rfind("data:", 0) == 0)
+                {
+                    continue;
+                }
+
+                if (!HashFile((directory / uri).string(), hash))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        std::string ToHex(uint64 value)
+        {
+            std::ostringstream stream;
+            stream << std::hex << std::setw(16) << std::setfill('0') << value;
+            return stream.str();
+        }
+    }
+
+    void AssetCooker::Initialize(const std::string& manifestPath)
+    {
+        m_manifestPath = manifestPath;
+        m_entries.clear();
+        m_lookup.clear();
+        m_manifest.clear();
+
+        std::ifstream file(manifestPath);
+        if (!file)
+        {
+            return;
+        }
+
+        const nlohmann::json manifest = nlohmann::json::parse(file, nullptr, false);
+        if (manifest.is_discarded() || manifest.value("version", 0u) != ASSET_COOKER_VERSION)
+        {
+            return;
+        }
+
+        auto assets = manifest.find("assets");
+        if (assets == manifest.end() || !assets->is_array())
+        {
+            return;
+        }
+
+        for (const nlohmann::json& asset : *assets)
+        {
+            ManifestRecord record;
+            record.sourcePath = asset.value("source", "");
+            if (record.sourcePath.empty() || !ParseKindName(asset.value("kind", ""), record.kind))
+            {
+                continue;
+            }
+
+            record.contentHash = std::strtoull(asset.value("hash", "0").c_str(), nullptr, 16);
+            m_manifest[GetEntryKey(record.kind, record.sourcePath)] = record;
+        }
+    }
+
+    bool AssetCooker::Add(AssetKind kind, const std::string& sourcePath, TextureUsage usage)
+    {
+        if (sourcePath.empty() || kind == AssetKind::Count)
+        {
+            return false;
+        }
+
+        if (kind == AssetKind::Texture && !TextureCooker::IsCookable(sourcePath))
+        {
+            return false;
+        }
+
+        const std::string key = GetEntryKey(kind, sourcePath);
+        if (m_lookup.find(key) != m_lookup.end())
+        {
+            return false;
+        }
+
+        CookEntry& entry = m_entries.emplace_back();
+        entry.kind = kind;
+        entry.sourcePath = sourcePath;
+        entry.cookedPath = kind == AssetKind::Texture ? TextureCooker::GetCookedPath(sourcePath) : MeshCache::GetCachePath(sourcePath);
+        entry.textureUsage = m_isCompactColor && usage == TextureUsage::Color ? TextureUsage::CompactColor : usage;
+        m_lookup.emplace(key, m_entries.size() - 1);
+        return true;
+    }
+
+    bool AssetCooker::AddSettings(const std::string& settingsPath)
+    {
+        std::ifstream file(settingsPath);
+        if (!file)
+        {
+            return false;
+        }
+
+        const nlohmann::json settings = nlohmann::json::parse(file, nullptr, false);
+        if (settings.is_discarded() || !settings.contains("assets_data"))
+        {
+            return false;
+        }
+
+        const nlohmann::json assets = settings["assets_data"].value("assets", nlohmann::json::array());
+        for (const nlohmann::json& asset : assets)
+        {
+            switch (asset.value("type", -1))
+            {
+            case SETTINGS_MODEL:
+                Add(AssetKind::Model, asset.value("path", ""));
+                break;
+            case SETTINGS_ANIMATED_MODEL:
+                Add(AssetKind::AnimatedModel, asset.value("path", ""));
+                break;
+            case SETTINGS_MATERIAL:
+                for (const auto& [key, usage] : MATERIAL_TEXTURE_KEYS)
+                {
+                    Add(AssetKind::Texture, asset.value(key, ""), usage);
+                }
+                break;
+            case SETTINGS_CUBEMAP:
+                for (const char* key : CUBEMAP_FACE_KEYS)
+                {
+                    Add(AssetKind::Texture, asset.value(key, ""));
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    void AssetCooker::AddDirectory(const std::string& directory)
+    {
+        std::error_code error;
+        for (const auto& item : std::filesystem::recursive_directory_iterator(directory, error))
+        {
+            if (!item.is_regular_file())
+            {
+                continue;
+            }
+
+            const std::string path = item.path().generic_string();
+            const std::string extension = GetLowerExtension(item.path());
+            if (std::find(std::begin(MODEL_EXTENSIONS), std::end(MODEL_EXTENSIONS), extension) != std::end(MODEL_EXTENSIONS))
+            {
+                Add(ModelImporter::IsAnimated(path) ? AssetKind::AnimatedModel : AssetKind::Model, path);
+            }
+            else if (TextureCooker::IsCookable(path))
+            {
+                Add(AssetKind::Texture, path, TextureCooker::GetUsageFromName(path));
+            }
+        }
+    }
+
+    CookReport AssetCooker::Cook(bool force)
+    {
+        JobSystem::Get().ParallelFor(m_entries.size(), [this, force](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                Process(m_entries[i], force);
+            }
+        });
+
+        CookReport report;
+        for (const CookEntry& entry : m_entries)
+        {
+            const std::string key = GetEntryKey(entry.kind, entry.sourcePath);
+            switch (entry.status)
+            {
+            case CookStatus::Cooked:
+                ++report.cooked;
+                report.optimization += entry.optimization;
+                m_manifest[key] = { entry.kind, entry.sourcePath, entry.contentHash };
+                break;
+            case CookStatus::UpToDate:
+                ++report.upToDate;
+                break;
+            case CookStatus::Missing:
+                ++report.missing;
+                break;
+            case CookStatus::Failed:
+                ++report.failed;
+                m_manifest.erase(key);
+                break;
+            default:
+                break;
+            }
+        }
+
+        return report;
+    }
+
+    bool AssetCooker::SaveManifest() const
+    {
+        nlohmann::json assets = nlohmann::json::array();
+        for (const auto& [key, record] : m_manifest)
+        {
+            assets.push_back({
+                { "kind", GetKindName(record.kind) },
+                { "source", record.sourcePath },
+                { "hash", ToHex(record.contentHash) }
+            });
+        }
+
+        nlohmann::json manifest;
+        manifest["version"] = ASSET_COOKER_VERSION;
+        manifest["assets"] = std::move(assets);
+
+        std::ofstream file(m_manifestPath, std::ios::trunc);
+        return static_cast<bool>(file << manifest.dump(4) << '\n');
+    }
+
+    uint64 AssetCooker::ComputeContentHash(AssetKind kind, const std::string& sourcePath, TextureUsage usage)
+    {
+        uint64 hash = HashBytes(FNV_OFFSET_BASIS, &ASSET_COOKER_VERSION, sizeof(ASSET_COOKER_VERSION));
+        hash = HashBytes(hash, &kind, sizeof(kind));
+
+        if (kind == AssetKind::Texture)
+        {
+            hash = HashBytes(hash, &usage, sizeof(usage));
+        }
+
+        if (kind != AssetKind::Texture)
+        {
+            const uint32 importFlags = ModelImporter::IMPORT_FLAGS;
+            const uint32 vertexSize = sizeof(PackedVertex);
+            hash = HashBytes(hash, &importFlags, sizeof(importFlags));
+            hash = HashBytes(hash, &MESH_CACHE_VERSION, sizeof(MESH_CACHE_VERSION));
+            hash = HashBytes(hash, &vertexSize, sizeof(vertexSize));
+        }
+
+        if (!HashFile(sourcePath, hash))
+        {
+            return 0;
+        }
+
+        if (kind != AssetKind::Texture && GetLowerExtension(sourcePath) == ".gltf" && !HashGltfBuffers(sourcePath, hash))
+        {
+            return 0;
+        }
+
+        return hash == 0 ? 1 : hash;
+    }
+
+    std::string AssetCooker::GetEntryKey(AssetKind kind, const std::string& sourcePath)
+    {
+        return std::string(GetKindName(kind)) + ":" + sourcePath;
+    }
+
+    void AssetCooker::Process(CookEntry& entry, bool force) const
+    {
+        try
+        {
+            if (!std::filesystem::exists(entry.sourcePath))
+            {
+                entry.status = CookStatus::Missing;
+                return;
+            }
+
+            entry.contentHash = ComputeContentHash(entry.kind, entry.sourcePath, entry.textureUsage);
+            if (entry.contentHash == 0)
+            {
+                entry.status = CookStatus::Failed;
+                return;
+            }
+
+            const bool isTexture = entry.kind == AssetKind::Texture;
+            const uint64 sourceKey = isTexture ? 0 : MeshCache::ComputeSourceKey(entry.sourcePath, ModelImporter::IMPORT_FLAGS);
+
+            auto record = m_manifest.find(GetEntryKey(entry.kind, entry.sourcePath));
+            if (!force && record != m_manifest.end() && record->second.contentHash == entry.contentHash && std::filesystem::exists(entry.cookedPath))
+            {
+                // Same content with a new time, e.g. after a checkout. The runtime compares times, so
+                // the cooked file is restamped instead of cooked again.
+                bool isRestamped = true;
+                if (isTexture)
+                {
+                    std::error_code error;
+                    std::filesystem::last_write_time(entry.cookedPath, std::filesystem::file_time_type::clock::now(), error);
+                }
+                else
+                {
+                    isRestamped = MeshCache::UpdateSourceKey(entry.cookedPath, sourceKey);
+                }
+
+                if (isRestamped)
+                {
+                    entry.status = CookStatus::UpToDate;
+                    return;
+                }
+            }
+
+            bool isCooked = false;
+            if (isTexture)
+            {
+                isCooked = TextureCooker::Cook(entry.sourcePath, entry.cookedPath, entry.textureUsage);
+            }
+            else if (entry.kind == AssetKind::AnimatedModel)
+            {
+                std::unique_ptr<AnimatedModelAsset> asset = ModelImporter::ImportAnimatedModel(entry.sourcePath, &entry.optimization);
+                isCooked = asset && MeshCache::Write(entry.cookedPath, sourceKey, *asset);
+            }
+            else
+            {
+                std::unique_ptr<ModelAsset> asset = ModelImporter::ImportModel(entry.sourcePath, &entry.optimization);
+                isCooked = asset && MeshCache::Write(entry.cookedPath, sourceKey, *asset);
+            }
+
+            entry.status = isCooked ? CookStatus::Cooked : CookStatus::Failed;
+        }
+        catch (const std::exception&)
+        {
+            entry.status = CookStatus::Failed;
+        }
+    }
+}
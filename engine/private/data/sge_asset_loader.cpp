@@ -0,0 +1,145 @@
+#include "data/sge_asset_loader.h"
+
+#include <exception>
+#include <stdexcept>
+
+namespace SGE
+{
+    AssetLoader::~AssetLoader()
+    {
+        // Queued jobs point into m_requests.
+        JobSystem::Get().Wait(m_jobs);
+    }
+
+    void AssetLoader::Initialize(AssetDecoder* decoder, AssetUploadSink* sink)
+    {
+        if (!decoder || !sink)
+        {
+            throw std::runtime_error("AssetLoader: decoder and upload sink are required");
+        }
+
+        m_decoder = decoder;
+        m_sink = sink;
+    }
+
+    bool AssetLoader::Request(AssetKind kind, const std::string& path)
+    {
+        if (!m_decoder)
+        {
+            throw std::runtime_error("AssetLoader: Request before Initialize");
+        }
+
+        auto& lookup = m_lookup[static_cast<size_t>(kind)];
+        if (lookup.find(path) != lookup.end())
+        {
+            return false;
+        }
+
+        LoadRequest& request = m_requests.emplace_back();
+        request.kind = kind;
+        request.path = path;
+        lookup.emplace(path, &request);
+        m_requestedCount.fetch_add(1, std::memory_order_relaxed);
+
+        LoadRequest* requestPtr = &request;
+        JobSystem::Get().Run([this, requestPtr]() { Decode(requestPtr); }, &m_jobs);
+        return true;
+    }
+
+    void AssetLoader::Wait()
+    {
+        JobSystem::Get().Wait(m_jobs);
+    }
+
+    void AssetLoader::Reset()
+    {
+        Wait();
+        m_requests.clear();
+        for (auto& lookup : m_lookup)
+        {
+            lookup.clear();
+        }
+
+        m_requestedCount = 0;
+        m_decodedCount = 0;
+        m_completedCount = 0;
+        m_failedCount = 0;
+    }
+
+    AssetLoadProgress AssetLoader::GetProgress() const
+    {
+        // Each stage bumps its counter before the next one, so reading back to front keeps
+        // failed <= completed <= decoded <= requested even while jobs are running.
+        AssetLoadProgress progress;
+        progress.failed = m_failedCount.load(std::memory_order_acquire);
+        progress.completed = m_completedCount.load(std::memory_order_acquire);
+        progress.decoded = m_decodedCount.load(std::memory_order_acquire);
+        progress.requested = m_requestedCount.load(std::memory_order_acquire);
+        return progress;
+    }
+
+    bool AssetLoader::IsComplete() const
+    {
+        return GetProgress().IsComplete();
+    }
+
+    AssetLoadState AssetLoader::GetState(AssetKind kind, const std::string& path) const
+    {
+        const auto& lookup = m_lookup[static_cast<size_t>(kind)];
+        auto it = lookup.find(path);
+        if (it == lookup.end())
+        {
+            return AssetLoadState::Unknown;
+        }
+
+        return it->second->state.load(std::memory_order_acquire);
+    }
+
+    void AssetLoader::Decode(LoadRequest* request)
+    {
+        try
+        {
+            request->decoded = m_decoder->Decode(request->kind, request->path);
+        }
+        catch (const std::exception&)
+        {
+            request->decoded.reset();
+        }
+
+        request->state.store(AssetLoadState::Uploading, std::memory_order_release);
+        m_decodedCount.fetch_add(1, std::memory_order_release);
+
+        // Joins the counter before this job returns, so Wait also covers the upload.
+        JobSystem::Get().RunOnMainThread([this, request]() { Upload(request); }, &m_jobs);
+    }
+
+    void AssetLoader::Upload(LoadRequest* request)
+    {
+        bool isUploaded = false;
+        if (request->decoded)
+        {
+            // Sinks throw when the device runs out of room, that fails this asset and not the load.
+            try
+            {
+                m_sink->Upload(request->kind, request->path, *request->decoded);
+                isUploaded = true;
+            }
+            catch (const std::exception&)
+            {
+            }
+            request->decoded.reset();
+        }
+
+        if (isUploaded)
+        {
+            request->state.store(AssetLoadState::Loaded, std::memory_order_release);
+        }
+        else
+        {
+            request->state.store(AssetLoadState::Failed, std::memory_order_release);
+            m_failedCount.fetch_add(1, std::memory_order_release);
+        }
+
+        m_completedCount.fetch_add(1, std::memory_order_release);
+    }
+}
@@ -70,6 +70,10 @@ namespace SGE
             float deltaY = mouseY - m_lastMousePosition.y;
 
             m_lastMousePosition = float2(mouseX, mouseY);
+            if (deltaX == 0.0f && deltaY == 0.0f)
+            {
+                return;
+            }
 
             m_cameraData->transform.rotation.y += deltaX * m_sensitivity; // Yaw
             m_cameraData->transform.rotation.x -= deltaY * m_sensitivity; // Pitch
@@ -80,6 +84,7 @@ namespace SGE
                 m_cameraData->transform.rotation.y -= 360.0f;
             else if (m_cameraData->transform.rotation.y < -180.0f)
                 m_cameraData->transform.rotation.y += 360.0f;
+            m_cameraData->MarkChanged();
         }
         else
         {
@@ -92,8 +97,14 @@ namespace SGE
     void CameraController::HandleFovAdjustment()
     {
         const int32 delta = Input::Get().GetMouseWheelDelta();
+        if (delta == 0)
+        {
+            return;
+        }
+
         m_cameraData->fov -= delta * m_sensitivity;
         m_cameraData->fov = std::clamp(m_cameraData->fov, MIN_FOV, MAX_FOV);
+        m_cameraData->MarkChanged();
     }
 
     float3 CameraController::CalculateForwardVector(float pitch, float yaw) const
@@ -114,6 +125,7 @@ namespace SGE
         {
             direction.normalize();
             m_cameraData->transform.position += direction * velocity;
+            m_cameraData->MarkChanged();
         }
     }
 }
\ No newline at end of file
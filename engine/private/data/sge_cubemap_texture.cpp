@@ -1,4 +1,5 @@
 #include "data/sge_cubemap_texture.h"
+#include "data/sge_texture_cooker.h"
 
 #include <filesystem>
 using namespace DirectX;
@@ -8,7 +9,17 @@ namespace SGE
     void CubemapTexture::Initialize(const CubemapAssetData& assetData, const Device* device, const DescriptorHeap* descriptorHeap, uint32 descriptorIndex)
     {
         std::array<std::string, 6> texturePaths = assetData.GetPaths();
-        CreateCubeMapTexture(texturePaths, device, descriptorHeap, descriptorIndex);
+
+        // Cooked faces carry mips the sources don't have, so they are only used when all six are cooked.
+        std::array<std::string, 6> cookedPaths;
+        bool isCooked = true;
+        for (uint32 i = 0; i < 6; ++i)
+        {
+            cookedPaths[i] = TextureCooker::ResolveRuntimePath(texturePaths[i]);
+            isCooked = isCooked && cookedPaths[i] != texturePaths[i];
+        }
+
+        CreateCubeMapTexture(isCooked ? cookedPaths : texturePaths, device, descriptorHeap, descriptorIndex);
     }
 
     void CubemapTexture::CreateCubeMapTexture(const std::array<std::string, 6>& texturePaths, const Device* device, const DescriptorHeap* descriptorHeap, uint32 descriptorIndex)
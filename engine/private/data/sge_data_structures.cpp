@@ -5,9 +5,9 @@
 
 namespace SGE
 {
-    void ObjectDataBase::DrawEditor()
+    bool ObjectDataBase::DrawEditor()
     {
-        InputText("Name:", name);
+        return InputText("Name:", name);
     }
 
     void ObjectDataBase::ToJson(njson& data)
@@ -27,12 +27,14 @@ namespace SGE
         type = static_cast<ObjectType>(typeInt);
     }
 
-    void TransformData::DrawEditor()
+    bool TransformData::DrawEditor()
     {
-        ObjectDataBase::DrawEditor();
-        DragFloat3("Position:", transform.position);
-        DragAngle3("Rotation:", transform.rotation);
-        DragFloat3("Scale:", transform.scale);
+        bool isChanged = false;
+        isChanged |= ObjectDataBase::DrawEditor();
+        isChanged |= DragFloat3("Position:", transform.position);
+        isChanged |= DragAngle3("Rotation:", transform.rotation);
+        isChanged |= DragFloat3("Scale:", transform.scale);
+        return isChanged;
     }
 
     void TransformData::ToJson(njson& data)
@@ -51,14 +53,16 @@ namespace SGE
         data.at("scale").get_to(transform.scale);
     }
 
-    void CameraData::DrawEditor()
+    bool CameraData::DrawEditor()
     {
-        TransformData::DrawEditor();
-        DragFloat("FOV:", fov);
-        DragFloat("Near Plane:", nearPlane, 0.1f, 10.0f);
-        DragFloat("Far Plane:", farPlane, 10.1f, 1000.0f);
-        DragFloat("Move speed:", moveSpeed, 0.0f, 1000.0f);
-        DragFloat("Sensitivity:", sensitivity, 0.0f, 100.0f);
+        bool isChanged = false;
+        isChanged |= TransformData::DrawEditor();
+        isChanged |= DragFloat("FOV:", fov);
+        isChanged |= DragFloat("Near Plane:", nearPlane, 0.1f, 10.0f);
+        isChanged |= DragFloat("Far Plane:", farPlane, 10.1f, 1000.0f);
+        isChanged |= DragFloat("Move speed:", moveSpeed, 0.0f, 1000.0f);
+        isChanged |= DragFloat("Sensitivity:", sensitivity, 0.0f, 100.0f);
+        return isChanged;
     }
 
     void CameraData::ToJson(njson& data)
@@ -81,17 +85,20 @@ namespace SGE
         sensitivity = data.at("sensitivity").get<float1>().value;
     }
 
-    void ModelData::DrawEditor()
+    bool ModelData::DrawEditor()
     {
-        Checkbox("Enabled:", enabled);
-        TransformData::DrawEditor();
-        InputText("Asset ID:", assetId);
-        InputText("Material ID:", materialId);
+        bool isChanged = false;
+        isChanged |= Checkbox("Enabled:", enabled);
+        isChanged |= TransformData::DrawEditor();
+        isChanged |= InputText("Asset ID:", assetId);
+        isChanged |= InputText("Material ID:", materialId);
+        isChanged |= InputText("Parent:", parent);
 
         if (ImGui::CollapsingHeader("Tiling UV"))
         {
-            ImGui::DragFloat2("Tiling UV", tilingUV.data(), 0.1f, 0.0f, 10.0f);
+            isChanged |= ImGui::DragFloat2("Tiling UV", tilingUV.data(), 0.1f, 0.0f, 10.0f);
         }
+        return isChanged;
     }
 
     void ModelData::ToJson(njson& data)
@@ -100,6 +107,10 @@ namespace SGE
         data["asset_id"] = assetId;
         data["material_id"] = materialId;
         data["enabled"] = enabled;
+        if (!parent.empty())
+        {
+            data["parent"] = parent;
+        }
 
         njson tilingUVJson;
         tilingUVJson["x"] = float1(tilingUV.x);
@@ -113,6 +124,7 @@ namespace SGE
         data.at("asset_id").get_to(assetId);
         data.at("material_id").get_to(materialId);
         data.at("enabled").get_to(enabled);
+        parent = data.value("parent", std::string());
 
         if (data.contains("tiling_uv"))
         {
@@ -160,21 +172,26 @@ namespace SGE
         }
     }
 
-    void AnimatedModelData::DrawEditor()
+    bool AnimatedModelData::DrawEditor()
     {
-        Checkbox("Enabled:", enabled);
-        TransformData::DrawEditor();
-        InputText("Asset ID:", assetId);
-        InputText("Material ID:", materialId);
+        bool isChanged = false;
+        isChanged |= Checkbox("Enabled:", enabled);
+        isChanged |= TransformData::DrawEditor();
+        isChanged |= InputText("Asset ID:", assetId);
+        isChanged |= InputText("Material ID:", materialId);
+        isChanged |= InputText("Parent:", parent);
+        return isChanged;
     }
 
-    void PointLightData::DrawEditor()
+    bool PointLightData::DrawEditor()
     {
-        ObjectDataBase::DrawEditor();
-        DragFloat3("Position:", position);
-        ColorEdit3("Color:", color);
-        DragFloat("Intensity:", intensity, 0.0f);
-        DragFloat("Radius:", radius, 0.1f);
+        bool isChanged = false;
+        isChanged |= ObjectDataBase::DrawEditor();
+        isChanged |= DragFloat3("Position:", position);
+        isChanged |= ColorEdit3("Color:", color);
+        isChanged |= DragFloat("Intensity:", intensity, 0.0f);
+        isChanged |= DragFloat("Radius:", radius, 0.1f);
+        return isChanged;
     }
 
     void PointLightData::ToJson(njson& data)
@@ -195,12 +212,14 @@ namespace SGE
         radius = data.at("radius").get<float1>().value;
     }
 
-    void DirectionalLightData::DrawEditor()
+    bool DirectionalLightData::DrawEditor()
     {
-        ObjectDataBase::DrawEditor();
-        DragFloat3("Direction:", direction);
-        ColorEdit3("Color:", color);
-        DragFloat("Intensity:", intensity, 0.0f);
+        bool isChanged = false;
+        isChanged |= ObjectDataBase::DrawEditor();
+        isChanged |= DragFloat3("Direction:", direction);
+        isChanged |= ColorEdit3("Color:", color);
+        isChanged |= DragFloat("Intensity:", intensity, 0.0f);
+        return isChanged;
     }
 
     void DirectionalLightData::ToJson(njson& data)
@@ -219,10 +238,12 @@ namespace SGE
         intensity = data.at("intensity").get<float1>().value;
     }
 
-    void SkyboxData::DrawEditor()
+    bool SkyboxData::DrawEditor()
     {
-        ObjectDataBase::DrawEditor();
-        InputText("Cubemap ID:", cubemapId);
+        bool isChanged = false;
+        isChanged |= ObjectDataBase::DrawEditor();
+        isChanged |= InputText("Cubemap ID:", cubemapId);
+        return isChanged;
     }
 
     void SkyboxData::ToJson(njson& data)
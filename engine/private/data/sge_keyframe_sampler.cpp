@@ -0,0 +1,70 @@
+#include "data/sge_keyframe_sampler.h"
+
+namespace SGE
+{
+    namespace
+    {
+        float3 InterpolateSegment(const std::vector<PositionKeyframe>& keys, uint32 index, float time) noexcept
+        {
+            return lerp(keys[index].position, keys[index + 1].position, GetSegmentFactor(keys.data(), index, time));
+        }
+
+        float4 InterpolateSegment(const std::vector<RotationKeyframe>& keys, uint32 index, float time) noexcept
+        {
+            return slerp(keys[index].rotation, keys[index + 1].rotation, GetSegmentFactor(keys.data(), index, time));
+        }
+
+        float3 InterpolateSegment(const std::vector<ScaleKeyframe>& keys, uint32 index, float time) noexcept
+        {
+            return lerp(keys[index].scale, keys[index + 1].scale, GetSegmentFactor(keys.data(), index, time));
+        }
+    }
+
+    float3 SamplePosition(const std::vector<PositionKeyframe>& keys, float time) noexcept
+    {
+        if (keys.empty()) return float3::Zero;
+        if (keys.size() == 1) return keys[0].position;
+
+        return InterpolateSegment(keys, FindKeyframeSegment(keys, time), time);
+    }
+
+    float4 SampleRotation(const std::vector<RotationKeyframe>& keys, float time) noexcept
+    {
+        if (keys.empty()) return float4::Identity;
+        if (keys.size() == 1) return keys[0].rotation;
+
+        return InterpolateSegment(keys, FindKeyframeSegment(keys, time), time);
+    }
+
+    float3 SampleScale(const std::vector<ScaleKeyframe>& keys, float time) noexcept
+    {
+        if (keys.empty()) return float3::One;
+        if (keys.size() == 1) return keys[0].scale;
+
+        return InterpolateSegment(keys, FindKeyframeSegment(keys, time), time);
+    }
+
+    float3 SamplePosition(const std::vector<PositionKeyframe>& keys, float time, uint32& cursor) noexcept
+    {
+        if (keys.empty()) return float3::Zero;
+        if (keys.size() == 1) return keys[0].position;
+
+        return InterpolateSegment(keys, FindKeyframeSegment(keys, time, cursor), time);
+    }
+
+    float4 SampleRotation(const std::vector<RotationKeyframe>& keys, float time, uint32& cursor) noexcept
+    {
+        if (keys.empty()) return float4::Identity;
+        if (keys.size() == 1) return keys[0].rotation;
+
+        return InterpolateSegment(keys, FindKeyframeSegment(keys, time, cursor), time);
+    }
+
+    float3 SampleScale(const std::vector<ScaleKeyframe>& keys, float time, uint32& cursor) noexcept
+    {
+        if (keys.empty()) return float3::One;
+        if (keys.size() == 1) return keys[0].scale;
+
+        return InterpolateSegment(keys, FindKeyframeSegment(keys, time, cursor), time);
+    }
+}
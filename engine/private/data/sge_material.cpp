@@ -12,11 +12,26 @@ namespace SGE
         m_roughnessTextureIndex = TextureManager::GetTextureIndex(materialAsset.roughnessTexturePath, TextureType::Roughness, context->GetDevice(), context->GetCbvSrvUavHeap());
     }
     
-    void Material::Bind(ID3D12GraphicsCommandList* commandList, DescriptorHeap* heap)
+    void Material::Bind(ID3D12GraphicsCommandList* commandList) const
     {
-        commandList->SetGraphicsRootDescriptorTable(2, heap->GetGPUHandle(m_albedoTextureIndex));
-        commandList->SetGraphicsRootDescriptorTable(3, heap->GetGPUHandle(m_normalTextureIndex));
-        commandList->SetGraphicsRootDescriptorTable(4, heap->GetGPUHandle(m_metallicTextureIndex));
-        commandList->SetGraphicsRootDescriptorTable(5, heap->GetGPUHandle(m_roughnessTextureIndex));
+        commandList->SetGraphicsRoot32BitConstant(MATERIAL_INDEX_ROOT_PARAMETER, m_tableIndex, 0);
+    }
+
+    void Material::RequestScreenSize(float pixels) const
+    {
+        TextureManager::RequestScreenSize(m_albedoTextureIndex, pixels);
+        TextureManager::RequestScreenSize(m_normalTextureIndex, pixels);
+        TextureManager::RequestScreenSize(m_metallicTextureIndex, pixels);
+        TextureManager::RequestScreenSize(m_roughnessTextureIndex, pixels);
+    }
+
+    MaterialTextures Material::GetTextures() const
+    {
+        MaterialTextures textures;
+        textures.albedo = m_albedoTextureIndex;
+        textures.normal = m_normalTextureIndex;
+        textures.metallic = m_metallicTextureIndex;
+        textures.roughness = m_roughnessTextureIndex;
+        return textures;
     }
 }
\ No newline at end of file
@@ -1,8 +1,20 @@
 #include "data/sge_material_manager.h"
 
+#include "core/sge_device.h"
+#include "core/sge_descriptor_heap.h"
+#include "core/sge_helpers.h"
+
 namespace SGE
 {
+    namespace
+    {
+        constexpr uint32 MIN_MATERIAL_TABLE_CAPACITY = 64;
+    }
+
     std::unordered_map<std::string, std::unique_ptr<Material>> MaterialManager::m_materials;
+    MaterialTable MaterialManager::m_table;
+    ComPtr<ID3D12Resource> MaterialManager::m_tableBuffer;
+    uint32 MaterialManager::m_tableBufferCapacity = 0;
 
     Material* MaterialManager::LoadMaterial(const MaterialAssetData& materialAssetData, RenderContext* context)
     {
@@ -11,11 +23,81 @@ namespace SGE
             std::unique_ptr<Material> material = std::make_unique<Material>();
             material->Initialize(materialAssetData, context);
 
+            if (m_materials.empty())
+            {
+                m_table.Initialize(TEXTURES_START_HEAP_INDEX, BINDLESS_TEXTURE_CAPACITY);
+            }
+
+            const uint32 tableIndex = m_table.Add(material->GetTextures());
+            Verify(tableIndex != INVALID_MATERIAL_INDEX, "MaterialManager::LoadMaterial: texture outside the bindless range.");
+            material->SetTableIndex(tableIndex);
+
             m_materials[materialAssetData.name] = std::move(material);
         }
 
         return m_materials[materialAssetData.name].get();
     }
+
+    void MaterialManager::UpdateTable(const Device* device)
+    {
+        if (!m_table.HasChanges())
+        {
+            return;
+        }
+
+        uint32 uploadBegin = m_table.GetDirtyBegin();
+        if (m_table.GetCount() > m_tableBufferCapacity)
+        {
+            // Nothing reads the old buffer anymore, the renderer waited for the last frame.
+            uint32 capacity = std::max(MIN_MATERIAL_TABLE_CAPACITY, m_tableBufferCapacity);
+            while (capacity < m_table.GetCount())
+            {
+                capacity *= 2;
+            }
+
+            m_tableBuffer.Reset();
+            HRESULT hr = device->GetDevice()->CreateCommittedResource(
+                &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
+                D3D12_HEAP_FLAG_NONE,
+                &CD3DX12_RESOURCE_DESC::Buffer(static_cast<uint64>(capacity) * sizeof(MaterialGpuData)),
+                D3D12_RESOURCE_STATE_GENERIC_READ,
+                nullptr,
+                IID_PPV_ARGS(&m_tableBuffer));
+            Verify(hr, "Failed to create material table buffer.");
+
+            m_tableBufferCapacity = capacity;
+            uploadBegin = 0;
+        }
+
+        uint8* mappedData = nullptr;
+        CD3DX12_RANGE readRange(0, 0);
+        HRESULT hr = m_tableBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mappedData));
+        Verify(hr, "Failed to map material table buffer.");
+
+        const uint32 uploadEnd = m_table.GetDirtyEnd();
+        memcpy(mappedData + uploadBegin * sizeof(MaterialGpuData), m_table.GetEntries().data() + uploadBegin,
+               (uploadEnd - uploadBegin) * sizeof(MaterialGpuData));
+
+        m_tableBuffer->Unmap(0, nullptr);
+        m_table.ClearChanges();
+    }
+
+    void MaterialManager::BindTable(ID3D12GraphicsCommandList* commandList, const DescriptorHeap* descriptorHeap)
+    {
+        if (!m_tableBuffer)
+        {
+            return;
+        }
+
+        commandList->SetGraphicsRootShaderResourceView(MATERIAL_TABLE_ROOT_PARAMETER, m_tableBuffer->GetGPUVirtualAddress());
+        commandList->SetGraphicsRootDescriptorTable(BINDLESS_TEXTURES_ROOT_PARAMETER, descriptorHeap->GetGPUHandle(TEXTURES_START_HEAP_INDEX));
+    }
+
+    void MaterialManager::Shutdown()
+    {
+        m_tableBuffer.Reset();
+        m_tableBufferCapacity = 0;
+    }
     
     bool MaterialManager::HasMaterial(const std::string& materialName)
     {
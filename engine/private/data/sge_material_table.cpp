@@ -0,0 +1,82 @@
+#include "data/sge_material_table.h"
+
+#include <algorithm>
+
+namespace SGE
+{
+    namespace
+    {
+        bool ToTextureSlot(uint32 descriptorIndex, uint32 rangeStart, uint32 rangeSize, uint32& slot)
+        {
+            if (descriptorIndex < rangeStart || descriptorIndex - rangeStart >= rangeSize)
+            {
+                return false;
+            }
+
+            slot = descriptorIndex - rangeStart;
+            return true;
+        }
+    }
+
+    void MaterialTable::Initialize(uint32 textureRangeStart, uint32 textureRangeSize)
+    {
+        m_textureRangeStart = textureRangeStart;
+        m_textureRangeSize = textureRangeSize;
+        m_entries.clear();
+        ClearChanges();
+    }
+
+    uint32 MaterialTable::Add(const MaterialTextures& textures)
+    {
+        MaterialGpuData data;
+        if (!Pack(textures, data))
+        {
+            return INVALID_MATERIAL_INDEX;
+        }
+
+        const uint32 materialIndex = GetCount();
+        m_entries.push_back(data);
+        MarkDirty(materialIndex);
+        return materialIndex;
+    }
+
+    bool MaterialTable::Set(uint32 materialIndex, const MaterialTextures& textures)
+    {
+        MaterialGpuData data;
+        if (materialIndex >= GetCount() || !Pack(textures, data))
+        {
+            return false;
+        }
+
+        m_entries[materialIndex] = data;
+        MarkDirty(materialIndex);
+        return true;
+    }
+
+    bool MaterialTable::Pack(const MaterialTextures& textures, MaterialGpuData& data) const
+    {
+        return ToTextureSlot(textures.albedo, m_textureRangeStart, m_textureRangeSize, data.albedoTexture)
+            && ToTextureSlot(textures.normal, m_textureRangeStart, m_textureRangeSize, data.normalTexture)
+            && ToTextureSlot(textures.metallic, m_textureRangeStart, m_textureRangeSize, data.metallicTexture)
+            && ToTextureSlot(textures.roughness, m_textureRangeStart, m_textureRangeSize, data.roughnessTexture);
+    }
+
+    void MaterialTable::ClearChanges()
+    {
+        m_dirtyBegin = 0;
+        m_dirtyEnd = 0;
+    }
+
+    void MaterialTable::MarkDirty(uint32 materialIndex)
+    {
+        if (!HasChanges())
+        {
+            m_dirtyBegin = materialIndex;
+            m_dirtyEnd = materialIndex + 1;
+            return;
+        }
+
+        m_dirtyBegin = std::min(m_dirtyBegin, materialIndex);
+        m_dirtyEnd = std::max(m_dirtyEnd, materialIndex + 1);
+    }
+}
@@ -0,0 +1,526 @@
+#include "data/sge_mesh_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+#include "core/sge_hash.h"
+#include "core/sge_mapped_file.h"
+
+namespace SGE
+{
+    static_assert(std::is_trivially_copyable_v<PackedVertex> && std::is_trivially_copyable_v<SkinVertex> && std::is_trivially_copyable_v<MeshResourceInfo> &&
+                  std::is_trivially_copyable_v<Meshlet> && std::is_trivially_copyable_v<MeshletTriangle>, "mesh data is used in place from the mapped file");
+
+    // Bounds checked cursor over one section of a mapped cooked file.
+    class MeshCacheReader
+    {
+    public:
+        MeshCacheReader(const uint8* data, size_t size) : m_data(data), m_size(size) {}
+
+        template<typename T>
+        bool Read(T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "MeshCacheReader reads raw bytes");
+            if (m_size - m_offset < sizeof(T))
+            {
+                return false;
+            }
+
+            std::memcpy(&value, m_data + m_offset, sizeof(T));
+            m_offset += sizeof(T);
+            return true;
+        }
+
+        template<typename T>
+        bool ReadArray(std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "MeshCacheReader reads raw bytes");
+            uint32 count = 0;
+            if (!Read(count) || (m_size - m_offset) / sizeof(T) < count)
+            {
+                return false;
+            }
+
+            values.resize(count);
+            if (count > 0)
+            {
+                std::memcpy(values.data(), m_data + m_offset, count * sizeof(T));
+                m_offset += count * sizeof(T);
+            }
+            return true;
+        }
+
+        bool ReadString(std::string& value)
+        {
+            uint32 length = 0;
+            if (!Read(length) || m_size - m_offset < length)
+            {
+                return false;
+            }
+
+            value.assign(reinterpret_cast<const char*>(m_data + m_offset), length);
+            m_offset += length;
+            return true;
+        }
+
+    private:
+        const uint8* m_data = nullptr;
+        size_t m_size = 0;
+        size_t m_offset = 0;
+    };
+
+    namespace
+    {
+        constexpr size_t SECTION_ALIGNMENT = 16;
+        void WriteBytes(std::vector<uint8>& out, const void* data, size_t size)
+        {
+            const uint8* bytes = static_cast<const uint8*>(data);
+            out.insert(out.end(), bytes, bytes + size);
+        }
+
+        template<typename T>
+        void WriteValue(std::vector<uint8>& out, const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "cooked data is written as raw bytes");
+            WriteBytes(out, &value, sizeof(T));
+        }
+
+        template<typename T>
+        void WriteArray(std::vector<uint8>& out, const std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "cooked data is written as raw bytes");
+            WriteValue(out, static_cast<uint32>(values.size()));
+            WriteBytes(out, values.data(), values.size() * sizeof(T));
+        }
+
+        void WriteString(std::vector<uint8>& out, const std::string& value)
+        {
+            WriteValue(out, static_cast<uint32>(value.size()));
+            WriteBytes(out, value.data(), value.size());
+        }
+
+        void WriteSection(std::vector<uint8>& out, MeshCacheHeader& header, MeshCacheSection section, const void* data, size_t size)
+        {
+            out.resize((out.size() + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT, 0);
+
+            MeshCacheSectionRange& range = header.sections[static_cast<size_t>(section)];
+            range.offset = out.size();
+            range.size = size;
+            WriteBytes(out, data, size);
+        }
+
+        std::vector<uint8> WriteSkeleton(const Skeleton& skeleton)
+        {
+            std::vector<uint8> out;
+            WriteValue(out, static_cast<uint32>(skeleton.GetBoneCount()));
+            for (const Bone& bone : skeleton.GetBones())
+            {
+                WriteString(out, bone.name);
+                WriteValue(out, bone.index);
+                WriteValue(out, bone.parentIndex);
+                WriteValue(out, bone.offsetMatrix);
+                WriteValue(out, bone.transform);
+                WriteValue(out, bone.weights);
+                WriteArray(out, bone.children);
+            }
+            return out;
+        }
+
+        bool ReadSkeleton(MeshCacheReader& reader, Skeleton& skeleton)
+        {
+            uint32 boneCount = 0;
+            if (!reader.Read(boneCount))
+            {
+                return false;
+            }
+
+            for (uint32 i = 0; i < boneCount; ++i)
+            {
+                std::string name;
+                int32 index = 0;
+                int32 parentIndex = 0;
+                float4x4 offsetMatrix;
+                if (!reader.ReadString(name) || !reader.Read(index) || !reader.Read(parentIndex) || !reader.Read(offsetMatrix))
+                {
+                    return false;
+                }
+
+                // Pose evaluation indexes bones by position, parents by index.
+                if (index != static_cast<int32>(i) || parentIndex < -1 || parentIndex >= static_cast<int32>(boneCount))
+                {
+                    return false;
+                }
+
+                skeleton.AddBone(name, index, offsetMatrix);
+                Bone& bone = skeleton.GetBone(index);
+                bone.parentIndex = parentIndex;
+                if (!reader.Read(bone.transform) || !reader.Read(bone.weights) || !reader.ReadArray(bone.children))
+                {
+                    return false;
+                }
+
+                for (int32 child : bone.children)
+                {
+                    if (child < 0 || child >= static_cast<int32>(boneCount))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        bool IsRangeInside(uint32 offset, uint32 count, size_t size)
+        {
+            return static_cast<size_t>(offset) + count <= size;
+        }
+
+        // Maps the file and checks everything the loaders rely on before any pointer into it is used.
+        std::shared_ptr<MappedFile> OpenCacheFile(const std::string& cachePath, uint64 sourceKey, MeshCacheHeader& header)
+        {
+            auto file = std::make_shared<MappedFile>();
+            if (!file->Open(cachePath) || file->GetSize() < sizeof(MeshCacheHeader))
+            {
+                return nullptr;
+            }
+
+            std::memcpy(&header, file->GetData(), sizeof(MeshCacheHeader));
+            if (header.magic != MESH_CACHE_MAGIC || header.version != MESH_CACHE_VERSION || header.vertexSize != sizeof(PackedVertex))
+            {
+                return nullptr;
+            }
+
+            if (sourceKey != MESH_CACHE_ANY_SOURCE && header.sourceKey != sourceKey)
+            {
+                return nullptr;
+            }
+
+            for (const MeshCacheSectionRange& range : header.sections)
+            {
+                if (range.offset % SECTION_ALIGNMENT != 0 || range.offset > file->GetSize() || range.size > file->GetSize() - range.offset)
+                {
+                    return nullptr;
+                }
+            }
+
+            return file;
+        }
+
+        template<typename T>
+        bool GetSection(const MappedFile& file, const MeshCacheHeader& header, MeshCacheSection section, Span<const T>& values)
+        {
+            const MeshCacheSectionRange& range = header.sections[static_cast<size_t>(section)];
+            if (range.size % sizeof(T) != 0)
+            {
+                return false;
+            }
+
+            values = Span<const T>(reinterpret_cast<const T*>(file.GetData() + range.offset), static_cast<size_t>(range.size / sizeof(T)));
+            return true;
+        }
+
+        MeshCacheReader GetSectionReader(const MappedFile& file, const MeshCacheHeader& header, MeshCacheSection section)
+        {
+            const MeshCacheSectionRange& range = header.sections[static_cast<size_t>(section)];
+            return MeshCacheReader(file.GetData() + range.offset, static_cast<size_t>(range.size));
+        }
+
+        bool LoadMeshData(const std::shared_ptr<MappedFile>& file, const MeshCacheHeader& header, ModelAsset& asset)
+        {
+            Span<const MeshResourceInfo> meshInfos;
+            Span<const PackedVertex> vertices;
+            Span<const SkinVertex> skinVertices;
+            Span<const uint32> indices;
+            Span<const Meshlet> meshlets;
+            Span<const uint32> meshletVertices;
+            Span<const MeshletTriangle> meshletTriangles;
+            if (!GetSection(*file, header, MeshCacheSection::Meshlets, meshlets) ||
+                !GetSection(*file, header, MeshCacheSection::MeshletVertices, meshletVertices) ||
+                !GetSection(*file, header, MeshCacheSection::MeshletTriangles, meshletTriangles) ||
+                !GetSection(*file, header, MeshCacheSection::MeshInfos, meshInfos) ||
+                !GetSection(*file, header, MeshCacheSection::Vertices, vertices) ||
+                !GetSection(*file, header, MeshCacheSection::SkinVertices, skinVertices) ||
+                !GetSection(*file, header, MeshCacheSection::Indices, indices))
+            {
+                return false;
+            }
+
+            if (!skinVertices.empty() && skinVertices.size() != vertices.size())
+            {
+                return false;
+            }
+
+            for (const MeshResourceInfo& info : meshInfos)
+            {
+                if (!IsRangeInside(info.indexCountOffset, info.meshIndexCount, indices.size()) || info.vertexCountOffset > vertices.size())
+                {
+                    return false;
+                }
+
+                if (info.lodCount > MAX_MESH_LODS)
+                {
+                    return false;
+                }
+
+                for (uint32 i = 0; i < info.lodCount; ++i)
+                {
+                    if (!IsRangeInside(info.lods[i].indexOffset, info.lods[i].indexCount, indices.size()))
+                    {
+                        return false;
+                    }
+                }
+
+                if (!IsRangeInside(info.meshletOffset, info.meshletCount, meshlets.size()))
+                {
+                    return false;
+                }
+            }
+
+            // Meshlets are read on the CPU by the culling, every index is checked once here.
+            for (const Meshlet& meshlet : meshlets)
+            {
+                if (!IsRangeInside(meshlet.vertexOffset, meshlet.vertexCount, meshletVertices.size()) ||
+                    !IsRangeInside(meshlet.triangleOffset, meshlet.triangleCount, meshletTriangles.size()) ||
+                    meshlet.vertexCount > MAX_MESHLET_VERTICES || meshlet.triangleCount > MAX_MESHLET_TRIANGLES)
+                {
+                    return false;
+                }
+
+                for (uint32 i = 0; i < meshlet.triangleCount; ++i)
+                {
+                    const MeshletTriangle& triangle = meshletTriangles[meshlet.triangleOffset + i];
+                    if (std::max({ triangle.indices[0], triangle.indices[1], triangle.indices[2] }) >= meshlet.vertexCount)
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            for (uint32 vertex : meshletVertices)
+            {
+                if (vertex >= vertices.size())
+                {
+                    return false;
+                }
+            }
+
+            asset.Initialize(meshInfos, vertices, skinVertices, indices, file);
+            asset.InitializeMeshlets(meshlets, meshletVertices, meshletTriangles);
+            return true;
+        }
+    }
+
+    std::string MeshCache::GetCachePath(const std::string& sourcePath)
+    {
+        return sourcePath + MESH_CACHE_EXTENSION;
+    }
+
+    uint64 MeshCache::ComputeSourceKey(const std::string& sourcePath, uint32 importFlags)
+    {
+        std::error_code error;
+        const auto writeTime = std::filesystem::last_write_time(sourcePath, error);
+        if (error)
+        {
+            return MESH_CACHE_ANY_SOURCE;
+        }
+
+        const int64 ticks = static_cast<int64>(writeTime.time_since_epoch().count());
+
+        uint64 hash = HashBytes(FNV_OFFSET_BASIS, sourcePath.data(), sourcePath.size());
+        hash = HashBytes(hash, &ticks, sizeof(ticks));
+        hash = HashBytes(hash, &importFlags, sizeof(importFlags));
+        return hash == MESH_CACHE_ANY_SOURCE ? 1 : hash;
+    }
+
+    bool MeshCache::Write(const std::string& cachePath, uint64 sourceKey, const ModelAsset& asset)
+    {
+        return Write(cachePath, sourceKey, asset, nullptr);
+    }
+
+    bool MeshCache::Write(const std::string& cachePath, uint64 sourceKey, const AnimatedModelAsset& asset)
+    {
+        return Write(cachePath, sourceKey, asset, &asset);
+    }
+
+    bool MeshCache::Write(const std::string& cachePath, uint64 sourceKey, const ModelAsset& asset, const AnimatedModelAsset* animatedAsset)
+    {
+        MeshCacheHeader header;
+        header.sourceKey = sourceKey;
+        header.isAnimated = animatedAsset ? 1 : 0;
+
+        std::vector<uint8> out(sizeof(MeshCacheHeader), 0);
+        WriteSection(out, header, MeshCacheSection::MeshInfos, asset.GetMeshInfos().data(), asset.GetMeshInfos().size_bytes());
+        WriteSection(out, header, MeshCacheSection::Vertices, asset.GetVertices().data(), asset.GetVertices().size_bytes());
+        WriteSection(out, header, MeshCacheSection::SkinVertices, asset.GetSkinVertices().data(), asset.GetSkinVertices().size_bytes());
+        WriteSection(out, header, MeshCacheSection::Indices, asset.GetIndices().data(), asset.GetIndices().size_bytes());
+        WriteSection(out, header, MeshCacheSection::Meshlets, asset.GetMeshlets().data(), asset.GetMeshlets().size_bytes());
+        WriteSection(out, header, MeshCacheSection::MeshletVertices, asset.GetMeshletVertices().data(), asset.GetMeshletVertices().size_bytes());
+        WriteSection(out, header, MeshCacheSection::MeshletTriangles, asset.GetMeshletTriangles().data(), asset.GetMeshletTriangles().size_bytes());
+
+        if (animatedAsset)
+        {
+            std::vector<uint8> skeleton = WriteSkeleton(animatedAsset->GetSkeleton());
+            WriteSection(out, header, MeshCacheSection::Skeleton, skeleton.data(), skeleton.size());
+
+            std::vector<uint8> clips;
+            WriteValue(clips, static_cast<uint32>(animatedAsset->GetAnimationClips().size()));
+            for (const AnimationClip& clip : animatedAsset->GetAnimationClips())
+            {
+                WriteAnimationClip(clips, clip);
+            }
+            WriteSection(out, header, MeshCacheSection::AnimationClips, clips.data(), clips.size());
+        }
+
+        std::memcpy(out.data(), &header, sizeof(MeshCacheHeader));
+
+        // Written next to the target and renamed, so a reader never maps a half written file.
+        const std::string tempPath = cachePath + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size())))
+            {
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, cachePath, error);
+        if (error)
+        {
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool MeshCache::UpdateSourceKey(const std::string& cachePath, uint64 sourceKey)
+    {
+        std::fstream file(cachePath, std::ios::binary | std::ios::in | std::ios::out);
+        MeshCacheHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(MeshCacheHeader)))
+        {
+            return false;
+        }
+
+        if (header.magic != MESH_CACHE_MAGIC || header.version != MESH_CACHE_VERSION || header.vertexSize != sizeof(PackedVertex))
+        {
+            return false;
+        }
+
+        header.sourceKey = sourceKey;
+        file.seekp(0);
+        return static_cast<bool>(file.write(reinterpret_cast<const char*>(&header), sizeof(MeshCacheHeader)));
+    }
+
+    std::unique_ptr<ModelAsset> MeshCache::LoadModel(const std::string& cachePath, uint64 sourceKey)
+    {
+        MeshCacheHeader header;
+        std::shared_ptr<MappedFile> file = OpenCacheFile(cachePath, sourceKey, header);
+        if (!file)
+        {
+            return nullptr;
+        }
+
+        auto asset = std::make_unique<ModelAsset>();
+        if (!LoadMeshData(file, header, *asset))
+        {
+            return nullptr;
+        }
+
+        return asset;
+    }
+
+    std::unique_ptr<AnimatedModelAsset> MeshCache::LoadAnimatedModel(const std::string& cachePath, uint64 sourceKey)
+    {
+        MeshCacheHeader header;
+        std::shared_ptr<MappedFile> file = OpenCacheFile(cachePath, sourceKey, header);
+        if (!file || !header.isAnimated)
+        {
+            return nullptr;
+        }
+
+        auto asset = std::make_unique<AnimatedModelAsset>();
+        if (!LoadMeshData(file, header, *asset))
+        {
+            return nullptr;
+        }
+
+        Skeleton skeleton;
+        MeshCacheReader skeletonReader = GetSectionReader(*file, header, MeshCacheSection::Skeleton);
+        if (!ReadSkeleton(skeletonReader, skeleton))
+        {
+            return nullptr;
+        }
+
+        MeshCacheReader clipReader = GetSectionReader(*file, header, MeshCacheSection::AnimationClips);
+        uint32 clipCount = 0;
+        if (!clipReader.Read(clipCount))
+        {
+            return nullptr;
+        }
+
+        std::vector<AnimationClip> clips;
+        clips.reserve(clipCount);
+        for (uint32 i = 0; i < clipCount; ++i)
+        {
+            AnimationClip& clip = clips.emplace_back();
+            if (!ReadAnimationClip(clipReader, clip, skeleton.GetBoneCount()))
+            {
+                return nullptr;
+            }
+        }
+
+        asset->InitializeAnimation(skeleton, std::move(clips));
+        return asset;
+    }
+
+    void MeshCache::WriteAnimationClip(std::vector<uint8>& out, const AnimationClip& clip)
+    {
+        WriteString(out, clip.m_name);
+        WriteValue(out, clip.m_duration);
+        WriteValue(out, clip.m_ticksPerSecond);
+        WriteArray(out, clip.m_channels);
+        WriteArray(out, clip.m_positionTimes);
+        WriteArray(out, clip.m_positions);
+        WriteArray(out, clip.m_rotationTimes);
+        WriteArray(out, clip.m_rotations);
+        WriteArray(out, clip.m_scaleTimes);
+        WriteArray(out, clip.m_scales);
+    }
+
+    bool MeshCache::ReadAnimationClip(MeshCacheReader& reader, AnimationClip& clip, int32 boneCount)
+    {
+        if (!reader.ReadString(clip.m_name) || !reader.Read(clip.m_duration) || !reader.Read(clip.m_ticksPerSecond) ||
+            !reader.ReadArray(clip.m_channels) ||
+            !reader.ReadArray(clip.m_positionTimes) || !reader.ReadArray(clip.m_positions) ||
+            !reader.ReadArray(clip.m_rotationTimes) || !reader.ReadArray(clip.m_rotations) ||
+            !reader.ReadArray(clip.m_scaleTimes) || !reader.ReadArray(clip.m_scales))
+        {
+            return false;
+        }
+
+        if (clip.m_channels.size() != static_cast<size_t>(boneCount) ||
+            clip.m_positionTimes.size() != clip.m_positions.size() ||
+            clip.m_rotationTimes.size() != clip.m_rotations.size() ||
+            clip.m_scaleTimes.size() != clip.m_scales.size())
+        {
+            return false;
+        }
+
+        for (const AnimationChannel& channel : clip.m_channels)
+        {
+            if (!IsRangeInside(channel.positionOffset, channel.positionCount, clip.m_positions.size()) ||
+                !IsRangeInside(channel.rotationOffset, channel.rotationCount, clip.m_rotations.size()) ||
+                !IsRangeInside(channel.scaleOffset, channel.scaleCount, clip.m_scales.size()))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,54 @@
+#include "data/sge_mesh_lod_selector.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace SGE
+{
+    float MeshLodSelector::ComputeProjectionScale(const float4x4& projectionMatrix, float viewportHeight)
+    {
+        return 0.5f * viewportHeight * std::abs(projectionMatrix.m11);
+    }
+
+    float MeshLodSelector::ComputeLodScale(const float4x4& worldMatrix, const float3& boundsCenter, float boundsRadius,
+                                           const float3& cameraPosition, float projectionScale, float nearPlane)
+    {
+        const float scale = std::max({ float3(worldMatrix.m00, worldMatrix.m10, worldMatrix.m20).length(),
+                                       float3(worldMatrix.m01, worldMatrix.m11, worldMatrix.m21).length(),
+                                       float3(worldMatrix.m02, worldMatrix.m12, worldMatrix.m22).length() });
+
+        const float4 center = worldMatrix * float4(boundsCenter.x, boundsCenter.y, boundsCenter.z, 1.0f);
+        const float distance = (float3(center.x, center.y, center.z) - cameraPosition).length() - boundsRadius * scale;
+        if (distance <= nearPlane)
+        {
+            return FLT_MAX;
+        }
+
+        return projectionScale * scale / distance;
+    }
+
+    uint32 MeshLodSelector::Select(const MeshResourceInfo& info, float lodScale, float maxPixelError)
+    {
+        // Errors grow with the level, the first one that is too coarse ends the search.
+        uint32 lod = 0;
+        while (lod < info.lodCount && info.lods[lod].error * lodScale <= maxPixelError)
+        {
+            ++lod;
+        }
+        return lod;
+    }
+
+    void MeshLodSelector::GetIndexRange(const MeshResourceInfo& info, uint32 lod, uint32& indexCount, uint32& indexOffset)
+    {
+        if (lod == 0 || lod > info.lodCount)
+        {
+            indexCount = info.meshIndexCount;
+            indexOffset = info.indexCountOffset;
+            return;
+        }
+
+        indexCount = info.lods[lod - 1].indexCount;
+        indexOffset = info.lods[lod - 1].indexOffset;
+    }
+}
@@ -0,0 +1,328 @@
+#include "data/sge_mesh_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <unordered_map>
+#include "core/sge_hash.h"
+
+namespace SGE
+{
+    namespace
+    {
+        constexpr uint32 INVALID_INDEX = ~0u;
+
+        // Vertex ends in 8 bytes of alignment padding that copies don't preserve, welding only
+        // looks at the attributes.
+        constexpr size_t VERTEX_ATTRIBUTES_SIZE = offsetof(Vertex, boneIndices) + sizeof(Vertex::boneIndices);
+
+        struct VertexAttributesHash
+        {
+            const std::vector<Vertex>* vertices;
+            size_t operator()(uint32 index) const { return static_cast<size_t>(HashBytes(FNV_OFFSET_BASIS, &(*vertices)[index], VERTEX_ATTRIBUTES_SIZE)); }
+        };
+
+        struct VertexAttributesEqual
+        {
+            const std::vector<Vertex>* vertices;
+            bool operator()(uint32 a, uint32 b) const { return std::memcmp(&(*vertices)[a], &(*vertices)[b], VERTEX_ATTRIBUTES_SIZE) == 0; }
+        };
+
+        // Forsyth's constants. The cache is modelled as LRU, which also orders well for FIFO caches.
+        constexpr uint32 OPTIMIZER_CACHE_SIZE = 32;
+        constexpr float CACHE_DECAY_POWER = 1.5f;
+        constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+        constexpr float VALENCE_BOOST_SCALE = 2.0f;
+        constexpr float VALENCE_BOOST_POWER = 0.5f;
+        constexpr uint32 VALENCE_TABLE_SIZE = 32;
+
+        class VertexScoreTable
+        {
+        public:
+            VertexScoreTable()
+            {
+                for (uint32 i = 0; i < OPTIMIZER_CACHE_SIZE; ++i)
+                {
+                    // The three vertices of the last triangle get a fixed score, so the next pick
+                    // doesn't simply reuse the same edge.
+                    m_cacheScores[i] = i < 3
+                        ? LAST_TRIANGLE_SCORE
+                        : std::pow(1.0f - static_cast<float>(i - 3) / (OPTIMIZER_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+                }
+
+                m_valenceScores[0] = 0.0f;
+                for (uint32 i = 1; i < VALENCE_TABLE_SIZE; ++i)
+                {
+                    m_valenceScores[i] = GetValenceScore(i);
+                }
+            }
+
+            float Get(int32 cachePosition, uint32 liveTriangles) const
+            {
+                if (liveTriangles == 0)
+                {
+                    return -1.0f;
+                }
+
+                const float cacheScore = cachePosition >= 0 ? m_cacheScores[cachePosition] : 0.0f;
+                const float valenceScore = liveTriangles < VALENCE_TABLE_SIZE ? m_valenceScores[liveTriangles] : GetValenceScore(liveTriangles);
+                return cacheScore + valenceScore;
+            }
+
+        private:
+            // Favors vertices with few triangles left, so lone triangles are not left behind.
+            static float GetValenceScore(uint32 liveTriangles)
+            {
+                return VALENCE_BOOST_SCALE * std::pow(static_cast<float>(liveTriangles), -VALENCE_BOOST_POWER);
+            }
+
+            float m_cacheScores[OPTIMIZER_CACHE_SIZE];
+            float m_valenceScores[VALENCE_TABLE_SIZE];
+        };
+    }
+
+    VertexCacheStats& VertexCacheStats::operator+=(const VertexCacheStats& other)
+    {
+        triangleCount += other.triangleCount;
+        vertexCount += other.vertexCount;
+        cacheMisses += other.cacheMisses;
+        return *this;
+    }
+
+    MeshOptimizationReport& MeshOptimizationReport::operator+=(const MeshOptimizationReport& other)
+    {
+        vertexCountBefore += other.vertexCountBefore;
+        vertexCountAfter += other.vertexCountAfter;
+        before += other.before;
+        after += other.after;
+        return *this;
+    }
+
+    MeshOptimizationReport MeshOptimizer::Optimize(std::vector<Vertex>& vertices, std::vector<uint32>& indices)
+    {
+        MeshOptimizationReport report;
+        report.vertexCountBefore = static_cast<uint32>(vertices.size());
+        report.before = AnalyzeVertexCache(indices, vertices.size());
+
+        WeldVertices(vertices, indices);
+        OptimizeVertexCache(indices, vertices.size());
+        OptimizeVertexFetch(vertices, indices);
+
+        report.vertexCountAfter = static_cast<uint32>(vertices.size());
+        report.after = AnalyzeVertexCache(indices, vertices.size());
+        return report;
+    }
+
+    void MeshOptimizer::WeldVertices(std::vector<Vertex>& vertices, std::vector<uint32>& indices)
+    {
+        std::unordered_map<uint32, uint32, VertexAttributesHash, VertexAttributesEqual> unique(
+            vertices.size(), VertexAttributesHash{ &vertices }, VertexAttributesEqual{ &vertices });
+
+        std::vector<uint32> remap(vertices.size());
+        std::vector<Vertex> welded;
+        welded.reserve(vertices.size());
+
+        for (uint32 i = 0; i < static_cast<uint32>(vertices.size()); ++i)
+        {
+            const auto [it, isNew] = unique.emplace(i, static_cast<uint32>(welded.size()));
+            if (isNew)
+            {
+                welded.push_back(vertices[i]);
+            }
+            remap[i] = it->second;
+        }
+
+        if (welded.size() == vertices.size())
+        {
+            return;
+        }
+
+        for (uint32& index : indices)
+        {
+            index = remap[index];
+        }
+        vertices.swap(welded);
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(std::vector<uint32>& indices, size_t vertexCount)
+    {
+        static const VertexScoreTable scoreTable;
+
+        const size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0)
+        {
+            return;
+        }
+
+        // Triangles of every vertex, the first liveCounts[v] entries of each list are not emitted yet.
+        std::vector<uint32> liveCounts(vertexCount, 0);
+        for (size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            ++liveCounts[indices[i]];
+        }
+
+        std::vector<uint32> offsets(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            offsets[v + 1] = offsets[v] + liveCounts[v];
+        }
+
+        std::vector<uint32> adjacency(triangleCount * 3);
+        std::vector<uint32> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            adjacency[fill[indices[i]]++] = static_cast<uint32>(i / 3);
+        }
+
+        std::vector<int32> cachePositions(vertexCount, -1);
+        std::vector<float> vertexScores(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            vertexScores[v] = scoreTable.Get(-1, liveCounts[v]);
+        }
+
+        size_t best = 0;
+        float bestScore = -1.0f;
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            const float score = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+            if (score > bestScore)
+            {
+                bestScore = score;
+                best = t;
+            }
+        }
+
+        std::vector<uint8> isEmitted(triangleCount, 0);
+        std::vector<uint32> output;
+        output.reserve(triangleCount * 3);
+
+        uint32 cache[OPTIMIZER_CACHE_SIZE + 3];
+        uint32 cacheCount = 0;
+
+        size_t nextUnemitted = 0;
+
+        for (size_t emitted = 0; emitted < triangleCount; ++emitted)
+        {
+            // Nothing in the cache has triangles left, continue in input order.
+            if (best == INVALID_INDEX)
+            {
+                while (isEmitted[nextUnemitted])
+                {
+                    ++nextUnemitted;
+                }
+                best = nextUnemitted;
+            }
+
+            isEmitted[best] = 1;
+            const uint32* triangle = &indices[best * 3];
+            output.insert(output.end(), triangle, triangle + 3);
+
+            for (size_t k = 0; k < 3; ++k)
+            {
+                const uint32 v = triangle[k];
+                uint32* triangles = &adjacency[offsets[v]];
+                uint32* last = triangles + liveCounts[v] - 1;
+                std::iter_swap(std::find(triangles, last, static_cast<uint32>(best)), last);
+                --liveCounts[v];
+            }
+
+            // The emitted vertices move to the front, everything else shifts back by up to three.
+            uint32 newCache[OPTIMIZER_CACHE_SIZE + 3];
+            uint32 newCount = 0;
+            for (size_t k = 0; k < 3; ++k)
+            {
+                if (std::find(newCache, newCache + newCount, triangle[k]) == newCache + newCount)
+                {
+                    newCache[newCount++] = triangle[k];
+                }
+            }
+            for (uint32 i = 0; i < cacheCount; ++i)
+            {
+                if (cache[i] != triangle[0] && cache[i] != triangle[1] && cache[i] != triangle[2])
+                {
+                    newCache[newCount++] = cache[i];
+                }
+            }
+
+            for (uint32 i = 0; i < newCount; ++i)
+            {
+                const uint32 v = newCache[i];
+                cachePositions[v] = i < OPTIMIZER_CACHE_SIZE ? static_cast<int32>(i) : -1;
+                vertexScores[v] = scoreTable.Get(cachePositions[v], liveCounts[v]);
+            }
+
+            cacheCount = std::min(newCount, OPTIMIZER_CACHE_SIZE);
+            std::copy(newCache, newCache + cacheCount, cache);
+
+            // Only triangles around vertices whose score changed need a new score, the best of
+            // them is the next pick.
+            best = INVALID_INDEX;
+            bestScore = -1.0f;
+            for (uint32 i = 0; i < newCount; ++i)
+            {
+                const uint32 v = newCache[i];
+                const uint32* triangles = &adjacency[offsets[v]];
+                for (uint32 j = 0; j < liveCounts[v]; ++j)
+                {
+                    const uint32 t = triangles[j];
+                    const float score = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        best = t;
+                    }
+                }
+            }
+        }
+
+        indices.swap(output);
+    }
+
+    void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32>& indices)
+    {
+        std::vector<uint32> remap(vertices.size(), INVALID_INDEX);
+        std::vector<Vertex> ordered;
+        ordered.reserve(vertices.size());
+
+        for (uint32& index : indices)
+        {
+            if (remap[index] == INVALID_INDEX)
+            {
+                remap[index] = static_cast<uint32>(ordered.size());
+                ordered.push_back(vertices[index]);
+            }
+            index = remap[index];
+        }
+
+        vertices.swap(ordered);
+    }
+
+    VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32>& indices, size_t vertexCount, uint32 cacheSize)
+    {
+        VertexCacheStats stats;
+        stats.triangleCount = static_cast<uint32>(indices.size() / 3);
+
+        // A vertex is in the FIFO if it went in during the last cacheSize misses.
+        std::vector<uint32> insertedAt(vertexCount, 0);
+        uint32 time = cacheSize + 1;
+
+        for (size_t i = 0; i < stats.triangleCount * 3; ++i)
+        {
+            const uint32 index = indices[i];
+            if (insertedAt[index] == 0)
+            {
+                ++stats.vertexCount;
+            }
+
+            if (time - insertedAt[index] > cacheSize)
+            {
+                insertedAt[index] = time++;
+                ++stats.cacheMisses;
+            }
+        }
+
+        return stats;
+    }
+}
@@ -0,0 +1,547 @@
+#include "data/sge_mesh_simplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "data/sge_mesh_optimizer.h"
+
+namespace SGE
+{
+    namespace
+    {
+        constexpr uint32 INVALID_INDEX = ~0u;
+
+        // Weight of the planes that hold borders and seams in place, relative to the surface planes.
+        constexpr double BOUNDARY_WEIGHT = 10.0;
+
+        // A level that keeps more than this part of the triangles of the one before isn't worth it.
+        constexpr float MIN_LOD_GAIN = 0.8f;
+
+        // Symmetric 4x4 matrix of the summed plane equations, weight is the summed triangle area
+        // so the error comes out as an area weighted mean squared distance.
+        struct Quadric
+        {
+            double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+            double b2 = 0.0, bc = 0.0, bd = 0.0;
+            double c2 = 0.0, cd = 0.0;
+            double d2 = 0.0;
+            double weight = 0.0;
+
+            void AddPlane(const float3& normal, float distance, double planeWeight)
+            {
+                const double a = normal.x;
+                const double b = normal.y;
+                const double c = normal.z;
+                const double d = distance;
+                a2 += planeWeight * a * a; ab += planeWeight * a * b; ac += planeWeight * a * c; ad += planeWeight * a * d;
+                b2 += planeWeight * b * b; bc += planeWeight * b * c; bd += planeWeight * b * d;
+                c2 += planeWeight * c * c; cd += planeWeight * c * d;
+                d2 += planeWeight * d * d;
+            }
+
+            Quadric& operator+=(const Quadric& other)
+            {
+                a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+                b2 += other.b2; bc += other.bc; bd += other.bd;
+                c2 += other.c2; cd += other.cd;
+                d2 += other.d2;
+                weight += other.weight;
+                return *this;
+            }
+
+            double Evaluate(const float3& point) const
+            {
+                const double x = point.x;
+                const double y = point.y;
+                const double z = point.z;
+                return a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x +
+                       b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y +
+                       c2 * z * z + 2.0 * cd * z +
+                       d2;
+            }
+        };
+
+        struct Collapse
+        {
+            uint32 from;
+            uint32 to;
+            double cost;
+        };
+
+        uint64 GetEdgeKey(uint32 a, uint32 b)
+        {
+            return a < b ? (static_cast<uint64>(a) << 32) | b : (static_cast<uint64>(b) << 32) | a;
+        }
+
+        // Works on positions, a vertex that exists with several attribute sets ("wedges") is one
+        // position. The mesh shrinks by collapsing a position onto a neighbour and rewriting each of
+        // its wedges to the wedge of the neighbour it shares a triangle with.
+        class Simplifier
+        {
+        public:
+            Simplifier(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices)
+                : m_indices(indices)
+            {
+                // Vertices with bit identical positions are one position.
+                std::vector<uint32> order(vertices.size());
+                for (uint32 i = 0; i < static_cast<uint32>(order.size()); ++i)
+                {
+                    order[i] = i;
+                }
+                std::sort(order.begin(), order.end(), [&vertices](uint32 a, uint32 b)
+                {
+                    return std::memcmp(vertices[a].position.data(), vertices[b].position.data(), sizeof(float3)) < 0;
+                });
+
+                m_positionOf.resize(vertices.size());
+                for (size_t i = 0; i < order.size(); ++i)
+                {
+                    if (i == 0 || std::memcmp(vertices[order[i - 1]].position.data(), vertices[order[i]].position.data(), sizeof(float3)) != 0)
+                    {
+                        m_positions.push_back(vertices[order[i]].position);
+                    }
+                    m_positionOf[order[i]] = static_cast<uint32>(m_positions.size() - 1);
+                }
+
+                m_wedgeTargets.resize(vertices.size());
+                m_isLocked.resize(m_positions.size());
+                m_isBorder.resize(m_positions.size());
+                BuildQuadrics();
+            }
+
+            const std::vector<uint32>& GetIndices() const { return m_indices; }
+            double GetMaxCost() const { return m_maxCost; }
+
+            void Run(size_t targetTriangleCount, double maxCost)
+            {
+                size_t triangleCount = m_indices.size() / 3;
+                while (triangleCount > targetTriangleCount)
+                {
+                    BuildAdjacency();
+
+                    std::vector<Collapse> candidates;
+                    candidates.reserve(m_positionEdges.size());
+                    for (uint64 key : m_positionEdges)
+                    {
+                        const uint32 a = static_cast<uint32>(key >> 32);
+                        const uint32 b = static_cast<uint32>(key & 0xFFFFFFFF);
+
+                        // The cheaper direction wins if it's allowed, the check is the expensive part.
+                        const double costAB = GetCost(a, b);
+                        const double costBA = GetCost(b, a);
+                        const Collapse first = costAB <= costBA ? Collapse{ a, b, costAB } : Collapse{ b, a, costBA };
+                        const Collapse second = costAB <= costBA ? Collapse{ b, a, costBA } : Collapse{ a, b, costAB };
+                        if (first.cost > maxCost)
+                        {
+                            continue;
+                        }
+
+                        if (CanCollapse(first.from, first.to))
+                        {
+                            candidates.push_back(first);
+                        }
+                        else if (second.cost <= maxCost && CanCollapse(second.from, second.to))
+                        {
+                            candidates.push_back(second);
+                        }
+                    }
+
+                    std::sort(candidates.begin(), candidates.end(), [](const Collapse& a, const Collapse& b)
+                    {
+                        return a.cost < b.cost || (a.cost == b.cost && a.from < b.from);
+                    });
+
+                    // Collapses of one pass don't share triangles, so each one is checked against
+                    // the mesh as it was at the start of the pass.
+                    std::fill(m_isLocked.begin(), m_isLocked.end(), 0);
+                    for (uint32 i = 0; i < static_cast<uint32>(m_wedgeTargets.size()); ++i)
+                    {
+                        m_wedgeTargets[i] = i;
+                    }
+
+                    size_t collapseCount = 0;
+                    for (const Collapse& collapse : candidates)
+                    {
+                        if (triangleCount <= targetTriangleCount)
+                        {
+                            break;
+                        }
+
+                        if (m_isLocked[collapse.from] || m_isLocked[collapse.to] || HasFlip(collapse.from, collapse.to))
+                        {
+                            continue;
+                        }
+
+                        triangleCount -= Apply(collapse.from, collapse.to);
+                        m_maxCost = std::max(m_maxCost, collapse.cost);
+                        ++collapseCount;
+                    }
+
+                    if (collapseCount == 0)
+                    {
+                        break;
+                    }
+
+                    RewriteIndices();
+                }
+            }
+
+        private:
+            void BuildQuadrics()
+            {
+                BuildAdjacency();
+
+                std::vector<uint64> wedgeEdges;
+                wedgeEdges.reserve(m_indices.size());
+                for (size_t i = 0; i < m_indices.size(); i += 3)
+                {
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        wedgeEdges.push_back(GetEdgeKey(m_indices[i + k], m_indices[i + (k + 1) % 3]));
+                    }
+                }
+                std::sort(wedgeEdges.begin(), wedgeEdges.end());
+
+                m_quadrics.assign(m_positions.size(), Quadric{});
+                for (size_t i = 0; i < m_indices.size(); i += 3)
+                {
+                    const uint32 corners[3] = { m_positionOf[m_indices[i]], m_positionOf[m_indices[i + 1]], m_positionOf[m_indices[i + 2]] };
+                    const float3& p0 = m_positions[corners[0]];
+                    float3 normal = cross(m_positions[corners[1]] - p0, m_positions[corners[2]] - p0);
+                    const float length = normal.length();
+                    if (length <= 0.0f)
+                    {
+                        continue;
+                    }
+
+                    normal = normal / length;
+                    const double area = length * 0.5;
+                    for (uint32 corner : corners)
+                    {
+                        m_quadrics[corner].AddPlane(normal, -dot(normal, p0), area);
+                        m_quadrics[corner].weight += area;
+                    }
+
+                    // An edge only one triangle uses is an open border. An edge two triangles share
+                    // by position but not by wedge is a seam. Both get a plane through the edge,
+                    // perpendicular to the triangle, that pulls collapses back onto the edge.
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        const uint32 w0 = m_indices[i + k];
+                        const uint32 w1 = m_indices[i + (k + 1) % 3];
+                        const auto wedgeEdge = std::equal_range(wedgeEdges.begin(), wedgeEdges.end(), GetEdgeKey(w0, w1));
+                        const bool isBorder = GetSharedTriangleCount(m_positionOf[w0], m_positionOf[w1]) == 1;
+                        const bool isSeam = !isBorder && wedgeEdge.second - wedgeEdge.first == 1;
+                        if (!isBorder && !isSeam)
+                        {
+                            continue;
+                        }
+
+                        const float3& a = m_positions[m_positionOf[w0]];
+                        const float3 edge = m_positions[m_positionOf[w1]] - a;
+                        const float3 planeNormal = cross(edge, normal).normalized();
+                        const double planeWeight = BOUNDARY_WEIGHT * dot(edge, edge);
+                        m_quadrics[m_positionOf[w0]].AddPlane(planeNormal, -dot(planeNormal, a), planeWeight);
+                        m_quadrics[m_positionOf[w1]].AddPlane(planeNormal, -dot(planeNormal, a), planeWeight);
+                    }
+                }
+            }
+
+            void BuildAdjacency()
+            {
+                const size_t triangleCount = m_indices.size() / 3;
+                m_triangleOffsets.assign(m_positions.size() + 1, 0);
+                for (uint32 index : m_indices)
+                {
+                    ++m_triangleOffsets[m_positionOf[index] + 1];
+                }
+                for (size_t p = 0; p < m_positions.size(); ++p)
+                {
+                    m_triangleOffsets[p + 1] += m_triangleOffsets[p];
+                }
+
+                m_triangles.resize(m_indices.size());
+                std::vector<uint32> fill(m_triangleOffsets.begin(), m_triangleOffsets.end() - 1);
+                for (size_t i = 0; i < m_indices.size(); ++i)
+                {
+                    m_triangles[fill[m_positionOf[m_indices[i]]]++] = static_cast<uint32>(i / 3);
+                }
+
+                // Positions around p, each as often as it shares a triangle with p. A neighbour
+                // that shows up once is across a border edge.
+                m_positionEdges.clear();
+                m_positionEdges.reserve(triangleCount * 2);
+                std::fill(m_isBorder.begin(), m_isBorder.end(), 0);
+                for (uint32 p = 0; p < static_cast<uint32>(m_positions.size()); ++p)
+                {
+                    m_neighbours.clear();
+                    for (uint32 i = m_triangleOffsets[p]; i < m_triangleOffsets[p + 1]; ++i)
+                    {
+                        const uint32* triangle = &m_indices[m_triangles[i] * 3];
+                        for (size_t k = 0; k < 3; ++k)
+                        {
+                            if (m_positionOf[triangle[k]] != p)
+                            {
+                                m_neighbours.push_back(m_positionOf[triangle[k]]);
+                            }
+                        }
+                    }
+                    std::sort(m_neighbours.begin(), m_neighbours.end());
+
+                    for (size_t i = 0; i < m_neighbours.size();)
+                    {
+                        const uint32 q = m_neighbours[i];
+                        size_t end = i + 1;
+                        while (end < m_neighbours.size() && m_neighbours[end] == q)
+                        {
+                            ++end;
+                        }
+
+                        if (end - i == 1)
+                        {
+                            m_isBorder[p] = 1;
+                        }
+                        if (q > p)
+                        {
+                            m_positionEdges.push_back(GetEdgeKey(p, q));
+                        }
+                        i = end;
+                    }
+                }
+            }
+
+            double GetCost(uint32 from, uint32 to) const
+            {
+                Quadric quadric = m_quadrics[from];
+                quadric += m_quadrics[to];
+                const double cost = quadric.Evaluate(m_positions[to]);
+                return std::max(0.0, quadric.weight > 0.0 ? cost / quadric.weight : cost);
+            }
+
+            // A border position may only move along the border. Every wedge of the position needs
+            // exactly one wedge of the target it shares a triangle with, which keeps seams intact.
+            bool CanCollapse(uint32 from, uint32 to)
+            {
+                if (m_isBorder[from] && GetSharedTriangleCount(from, to) != 1)
+                {
+                    return false;
+                }
+
+                return MapWedges(from, to);
+            }
+
+            uint32 GetSharedTriangleCount(uint32 from, uint32 to) const
+            {
+                uint32 count = 0;
+                for (uint32 i = m_triangleOffsets[from]; i < m_triangleOffsets[from + 1]; ++i)
+                {
+                    const uint32* triangle = &m_indices[m_triangles[i] * 3];
+                    count += m_positionOf[triangle[0]] == to || m_positionOf[triangle[1]] == to || m_positionOf[triangle[2]] == to;
+                }
+                return count;
+            }
+
+            bool MapWedges(uint32 from, uint32 to)
+            {
+                m_wedgePairs.clear();
+                for (uint32 i = m_triangleOffsets[from]; i < m_triangleOffsets[from + 1]; ++i)
+                {
+                    const uint32* triangle = &m_indices[m_triangles[i] * 3];
+                    uint32 fromWedge = INVALID_INDEX;
+                    uint32 toWedge = INVALID_INDEX;
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        const uint32 position = m_positionOf[triangle[k]];
+                        if (position == from)
+                        {
+                            fromWedge = triangle[k];
+                        }
+                        else if (position == to)
+                        {
+                            toWedge = triangle[k];
+                        }
+                    }
+                    m_wedgePairs.emplace_back(fromWedge, toWedge);
+                }
+
+                for (const auto& [fromWedge, toWedge] : m_wedgePairs)
+                {
+                    bool hasTarget = false;
+                    for (const auto& [otherFromWedge, otherToWedge] : m_wedgePairs)
+                    {
+                        if (otherFromWedge == fromWedge && otherToWedge != INVALID_INDEX)
+                        {
+                            if (toWedge != INVALID_INDEX && otherToWedge != toWedge)
+                            {
+                                return false;
+                            }
+                            hasTarget = true;
+                        }
+                    }
+
+                    if (!hasTarget)
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            bool HasFlip(uint32 from, uint32 to) const
+            {
+                for (uint32 i = m_triangleOffsets[from]; i < m_triangleOffsets[from + 1]; ++i)
+                {
+                    const uint32* triangle = &m_indices[m_triangles[i] * 3];
+                    float3 before[3];
+                    float3 after[3];
+                    bool isRemoved = false;
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        const uint32 position = m_positionOf[triangle[k]];
+                        isRemoved |= position == to;
+                        before[k] = m_positions[position];
+                        after[k] = m_positions[position == from ? to : position];
+                    }
+
+                    if (isRemoved)
+                    {
+                        continue;
+                    }
+
+                    const float3 normalBefore = cross(before[1] - before[0], before[2] - before[0]);
+                    const float3 normalAfter = cross(after[1] - after[0], after[2] - after[0]);
+                    if (dot(normalBefore, normalAfter) <= 0.0f)
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            // Returns the number of triangles the collapse removes.
+            size_t Apply(uint32 from, uint32 to)
+            {
+                MapWedges(from, to);
+                size_t removed = 0;
+                for (const auto& [fromWedge, toWedge] : m_wedgePairs)
+                {
+                    if (toWedge != INVALID_INDEX)
+                    {
+                        m_wedgeTargets[fromWedge] = toWedge;
+                        ++removed;
+                    }
+                }
+
+                m_quadrics[to] += m_quadrics[from];
+                for (uint32 i = m_triangleOffsets[from]; i < m_triangleOffsets[from + 1]; ++i)
+                {
+                    const uint32* triangle = &m_indices[m_triangles[i] * 3];
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        m_isLocked[m_positionOf[triangle[k]]] = 1;
+                    }
+                }
+
+                return removed;
+            }
+
+            void RewriteIndices()
+            {
+                size_t count = 0;
+                for (size_t i = 0; i < m_indices.size(); i += 3)
+                {
+                    const uint32 a = m_wedgeTargets[m_indices[i]];
+                    const uint32 b = m_wedgeTargets[m_indices[i + 1]];
+                    const uint32 c = m_wedgeTargets[m_indices[i + 2]];
+                    if (a == b || b == c || a == c)
+                    {
+                        continue;
+                    }
+
+                    m_indices[count++] = a;
+                    m_indices[count++] = b;
+                    m_indices[count++] = c;
+                }
+                m_indices.resize(count);
+            }
+
+            std::vector<uint32> m_indices;
+            std::vector<uint32> m_positionOf;
+            std::vector<float3> m_positions;
+            std::vector<Quadric> m_quadrics;
+            double m_maxCost = 0.0;
+
+            // Rebuilt every pass.
+            std::vector<uint32> m_triangleOffsets;
+            std::vector<uint32> m_triangles;
+            std::vector<uint64> m_positionEdges;
+            std::vector<uint32> m_neighbours;
+            std::vector<uint8> m_isBorder;
+            std::vector<uint8> m_isLocked;
+            std::vector<uint32> m_wedgeTargets;
+            std::vector<std::pair<uint32, uint32>> m_wedgePairs;
+        };
+    }
+
+    std::vector<uint32> MeshSimplifier::Simplify(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices,
+                                                 size_t targetIndexCount, float maxError, float* error)
+    {
+        Simplifier simplifier(vertices, indices);
+        simplifier.Run(targetIndexCount / 3, static_cast<double>(maxError) * maxError);
+
+        if (error)
+        {
+            *error = static_cast<float>(std::sqrt(simplifier.GetMaxCost()));
+        }
+        return simplifier.GetIndices();
+    }
+
+    std::vector<MeshLod> MeshSimplifier::BuildLods(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices, const MeshLodSettings& settings)
+    {
+        std::vector<MeshLod> lods;
+        if (indices.empty())
+        {
+            return lods;
+        }
+
+        float3 boundsMin = vertices[indices[0]].position;
+        float3 boundsMax = boundsMin;
+        for (uint32 index : indices)
+        {
+            const float3& position = vertices[index].position;
+            boundsMin = float3(std::min(boundsMin.x, position.x), std::min(boundsMin.y, position.y), std::min(boundsMin.z, position.z));
+            boundsMax = float3(std::max(boundsMax.x, position.x), std::max(boundsMax.y, position.y), std::max(boundsMax.z, position.z));
+        }
+        const float maxError = (boundsMax - boundsMin).length() * 0.5f * settings.maxRelativeError;
+
+        // One run continues from level to level, the quadrics keep summing up the original surface
+        // so the error of every level is measured against the full mesh.
+        Simplifier simplifier(vertices, indices);
+        const double maxCost = static_cast<double>(maxError) * maxError;
+        size_t previousIndexCount = indices.size();
+        for (uint32 level = 0; level < std::min(settings.maxLodCount, MAX_MESH_LODS); ++level)
+        {
+            if (previousIndexCount / 3 <= settings.minTriangleCount)
+            {
+                break;
+            }
+
+            simplifier.Run(static_cast<size_t>(previousIndexCount / 3 * settings.reduction), maxCost);
+            const std::vector<uint32>& levelIndices = simplifier.GetIndices();
+            if (levelIndices.empty() || levelIndices.size() > previousIndexCount * MIN_LOD_GAIN)
+            {
+                break;
+            }
+
+            MeshLod& lod = lods.emplace_back();
+            lod.indices = levelIndices;
+            lod.error = static_cast<float>(std::sqrt(simplifier.GetMaxCost()));
+            MeshOptimizer::OptimizeVertexCache(lod.indices, vertices.size());
+            previousIndexCount = levelIndices.size();
+        }
+
+        return lods;
+    }
+}
@@ -0,0 +1,253 @@
+#include "data/sge_meshlet.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SGE
+{
+    namespace
+    {
+        constexpr uint32 INVALID_INDEX = ~0u;
+        constexpr uint8 NOT_IN_MESHLET = 0xFF;
+
+        // Below this the triangles of a cluster face too many ways for the cone to ever cull.
+        constexpr float MIN_CONE_DOT = 0.1f;
+
+        void ComputeBounds(const std::vector<Vertex>& vertices, const MeshletData& data, Meshlet& meshlet)
+        {
+            const uint32* meshletVertices = &data.vertices[meshlet.vertexOffset];
+            meshlet.boundsMin = vertices[meshletVertices[0]].position;
+            meshlet.boundsMax = meshlet.boundsMin;
+            for (uint32 i = 1; i < meshlet.vertexCount; ++i)
+            {
+                const float3& position = vertices[meshletVertices[i]].position;
+                meshlet.boundsMin = float3(std::min(meshlet.boundsMin.x, position.x), std::min(meshlet.boundsMin.y, position.y), std::min(meshlet.boundsMin.z, position.z));
+                meshlet.boundsMax = float3(std::max(meshlet.boundsMax.x, position.x), std::max(meshlet.boundsMax.y, position.y), std::max(meshlet.boundsMax.z, position.z));
+            }
+
+            meshlet.center = (meshlet.boundsMin + meshlet.boundsMax) * 0.5f;
+            meshlet.radius = 0.0f;
+            for (uint32 i = 0; i < meshlet.vertexCount; ++i)
+            {
+                meshlet.radius = std::max(meshlet.radius, (vertices[meshletVertices[i]].position - meshlet.center).length());
+            }
+
+            // Face normals, turned to agree with the vertex normals so the winding convention of
+            // the source doesn't matter.
+            float3 normals[MAX_MESHLET_TRIANGLES];
+            float3 corners[MAX_MESHLET_TRIANGLES];
+            uint32 normalCount = 0;
+            float3 axis;
+            for (uint32 t = 0; t < meshlet.triangleCount; ++t)
+            {
+                const MeshletTriangle& triangle = data.triangles[meshlet.triangleOffset + t];
+                const Vertex& a = vertices[meshletVertices[triangle.indices[0]]];
+                const Vertex& b = vertices[meshletVertices[triangle.indices[1]]];
+                const Vertex& c = vertices[meshletVertices[triangle.indices[2]]];
+
+                float3 normal = cross(b.position - a.position, c.position - a.position).normalized();
+                if (dot(normal, a.normal + b.normal + c.normal) < 0.0f)
+                {
+                    normal = normal * -1.0f;
+                }
+
+                if (dot(normal, normal) > 0.0f)
+                {
+                    normals[normalCount] = normal;
+                    corners[normalCount] = a.position;
+                    axis += normal;
+                    ++normalCount;
+                }
+            }
+
+            meshlet.coneAxis = axis.normalized();
+            meshlet.coneApex = meshlet.center;
+            meshlet.coneCutoff = 2.0f;
+
+            float minDot = 1.0f;
+            for (uint32 i = 0; i < normalCount; ++i)
+            {
+                minDot = std::min(minDot, dot(meshlet.coneAxis, normals[i]));
+            }
+
+            if (normalCount == 0 || minDot <= MIN_CONE_DOT)
+            {
+                return;
+            }
+
+            // Moves the apex back along the axis until it is behind every triangle plane, so a
+            // camera inside the cone sees only back faces.
+            float maxT = 0.0f;
+            for (uint32 i = 0; i < normalCount; ++i)
+            {
+                const float t = dot(meshlet.center - corners[i], normals[i]) / dot(meshlet.coneAxis, normals[i]);
+                maxT = std::max(maxT, t);
+            }
+
+            meshlet.coneApex = meshlet.center - meshlet.coneAxis * maxT;
+            meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+        }
+    }
+
+    MeshletData MeshletBuilder::Build(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices)
+    {
+        MeshletData data;
+        const size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0)
+        {
+            return data;
+        }
+
+        std::vector<uint32> offsets(vertices.size() + 1, 0);
+        for (size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            ++offsets[indices[i] + 1];
+        }
+        for (size_t v = 0; v < vertices.size(); ++v)
+        {
+            offsets[v + 1] += offsets[v];
+        }
+
+        std::vector<uint32> adjacency(triangleCount * 3);
+        std::vector<uint32> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            adjacency[fill[indices[i]]++] = static_cast<uint32>(i / 3);
+        }
+
+        std::vector<uint8> localIndices(vertices.size(), NOT_IN_MESHLET);
+        std::vector<uint8> isUsed(triangleCount, 0);
+        size_t nextUnused = 0;
+
+        Meshlet meshlet;
+        auto flush = [&]()
+        {
+            for (uint32 i = 0; i < meshlet.vertexCount; ++i)
+            {
+                localIndices[data.vertices[meshlet.vertexOffset + i]] = NOT_IN_MESHLET;
+            }
+
+            ComputeBounds(vertices, data, meshlet);
+            data.meshlets.push_back(meshlet);
+
+            meshlet = Meshlet{};
+            meshlet.vertexOffset = static_cast<uint32>(data.vertices.size());
+            meshlet.triangleOffset = static_cast<uint32>(data.triangles.size());
+        };
+
+        auto getNewVertexCount = [&](uint32 triangle)
+        {
+            uint32 count = 0;
+            for (size_t k = 0; k < 3; ++k)
+            {
+                count += localIndices[indices[triangle * 3 + k]] == NOT_IN_MESHLET;
+            }
+            return count;
+        };
+
+        for (size_t added = 0; added < triangleCount; ++added)
+        {
+            // The unused neighbour that brings the fewest new vertices, ties go to the earlier
+            // triangle. Without neighbours the meshlet continues with the next unused triangle.
+            uint32 best = INVALID_INDEX;
+            uint32 bestNewVertices = 4;
+            for (uint32 i = 0; i < meshlet.vertexCount && bestNewVertices > 0; ++i)
+            {
+                const uint32 vertex = data.vertices[meshlet.vertexOffset + i];
+                for (uint32 j = offsets[vertex]; j < offsets[vertex + 1]; ++j)
+                {
+                    const uint32 triangle = adjacency[j];
+                    if (isUsed[triangle])
+                    {
+                        continue;
+                    }
+
+                    const uint32 newVertices = getNewVertexCount(triangle);
+                    if (newVertices < bestNewVertices || (newVertices == bestNewVertices && triangle < best))
+                    {
+                        best = triangle;
+                        bestNewVertices = newVertices;
+                    }
+                }
+            }
+
+            if (best == INVALID_INDEX)
+            {
+                while (isUsed[nextUnused])
+                {
+                    ++nextUnused;
+                }
+                best = static_cast<uint32>(nextUnused);
+                bestNewVertices = getNewVertexCount(best);
+            }
+
+            if (meshlet.vertexCount + bestNewVertices > MAX_MESHLET_VERTICES || meshlet.triangleCount == MAX_MESHLET_TRIANGLES)
+            {
+                flush();
+            }
+
+            MeshletTriangle triangle;
+            for (size_t k = 0; k < 3; ++k)
+            {
+                const uint32 vertex = indices[best * 3 + k];
+                if (localIndices[vertex] == NOT_IN_MESHLET)
+                {
+                    localIndices[vertex] = static_cast<uint8>(meshlet.vertexCount++);
+                    data.vertices.push_back(vertex);
+                }
+                triangle.indices[k] = localIndices[vertex];
+            }
+
+            data.triangles.push_back(triangle);
+            ++meshlet.triangleCount;
+            isUsed[best] = 1;
+        }
+
+        flush();
+        return data;
+    }
+
+    bool MeshletCuller::IsVisible(const Meshlet& meshlet, const Frustum& frustum, const float3& cameraPosition, bool isBackfaceCulled)
+    {
+        if (!frustum.IntersectsSphere(meshlet.center, meshlet.radius) || !frustum.IntersectsBox(meshlet.boundsMin, meshlet.boundsMax))
+        {
+            return false;
+        }
+
+        if (isBackfaceCulled && meshlet.coneCutoff <= 1.0f)
+        {
+            const float3 direction = (meshlet.coneApex - cameraPosition).normalized();
+            if (dot(direction, meshlet.coneAxis) >= meshlet.coneCutoff)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    uint32 MeshletCuller::Cull(Span<const Meshlet> meshlets, Span<const uint32> meshletVertices, Span<const MeshletTriangle> meshletTriangles,
+                               const Frustum& frustum, const float3& cameraPosition, bool isBackfaceCulled, std::vector<uint32>& indices)
+    {
+        uint32 visibleCount = 0;
+        for (const Meshlet& meshlet : meshlets)
+        {
+            if (!IsVisible(meshlet, frustum, cameraPosition, isBackfaceCulled))
+            {
+                continue;
+            }
+
+            const uint32* vertices = &meshletVertices[meshlet.vertexOffset];
+            for (uint32 t = 0; t < meshlet.triangleCount; ++t)
+            {
+                const MeshletTriangle& triangle = meshletTriangles[meshlet.triangleOffset + t];
+                indices.push_back(vertices[triangle.indices[0]]);
+                indices.push_back(vertices[triangle.indices[1]]);
+                indices.push_back(vertices[triangle.indices[2]]);
+            }
+            ++visibleCount;
+        }
+
+        return visibleCount;
+    }
+}
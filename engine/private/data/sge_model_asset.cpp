@@ -1,50 +1,176 @@
 #include "data/sge_model_asset.h"
 
+#include <algorithm>
 #include "data/sge_mesh.h"
 #include "core/sge_logger.h"
 
 namespace SGE
 {
+    namespace
+    {
+        void ComputeBoxBounds(Span<const PackedVertex> vertices, float3& boundsMin, float3& boundsMax)
+        {
+            boundsMin = float3(0.0f, 0.0f, 0.0f);
+            boundsMax = boundsMin;
+            if (vertices.empty())
+            {
+                return;
+            }
+
+            boundsMin = vertices[0].position;
+            boundsMax = boundsMin;
+            for (const PackedVertex& vertex : vertices)
+            {
+                boundsMin = float3(std::min(boundsMin.x, vertex.position.x), std::min(boundsMin.y, vertex.position.y), std::min(boundsMin.z, vertex.position.z));
+                boundsMax = float3(std::max(boundsMax.x, vertex.position.x), std::max(boundsMax.y, vertex.position.y), std::max(boundsMax.z, vertex.position.z));
+            }
+        }
+    }
+
     void ModelAsset::Initialize(std::vector<Mesh>& meshes)
     {
-        uint32 totalVertexCount = 0;
-        uint32 totalIndexCount = 0;
+        size_t totalVertexCount = 0;
+        size_t totalIndexCount = 0;
+        bool hasSkin = false;
 
         for (const Mesh& mesh : meshes)
         {
-            totalVertexCount += static_cast<uint32>(mesh.GetVertices().size());
-            totalIndexCount += static_cast<uint32>(mesh.GetIndices().size());
-        }
+            totalVertexCount += mesh.GetVertices().size();
+            totalIndexCount += mesh.GetIndices().size();
+            for (const MeshLod& lod : mesh.GetLods())
+            {
+                totalIndexCount += lod.indices.size();
+            }
 
-        m_meshes.reserve(meshes.size());
-        m_vertices.reserve(totalVertexCount);
-        m_indices.reserve(totalIndexCount);
+            for (size_t i = 0; i < mesh.GetVertices().size() && !hasSkin; ++i)
+            {
+                hasSkin = SGE::HasSkin(mesh.GetVertices()[i]);
+            }
+        }
 
-        uint32 currentIndexOffset = 0;
+        m_ownedMeshInfos.clear();
+        m_ownedVertices.clear();
+        m_ownedSkinVertices.clear();
+        m_ownedIndices.clear();
+        m_ownedMeshlets.clear();
+        m_ownedMeshletVertices.clear();
+        m_ownedMeshletTriangles.clear();
+        m_ownedMeshInfos.reserve(meshes.size());
+        m_ownedVertices.reserve(totalVertexCount);
+        m_ownedSkinVertices.reserve(hasSkin ? totalVertexCount : 0);
+        m_ownedIndices.reserve(totalIndexCount);
 
         for (Mesh& mesh : meshes)
         {
             const std::vector<Vertex>& meshVertices = mesh.GetVertices();
             const std::vector<uint32>& meshIndices = mesh.GetIndices();
 
-            m_vertices.insert(m_vertices.end(), meshVertices.begin(), meshVertices.end());
+            const uint32 vertexOffset = static_cast<uint32>(m_ownedVertices.size());
+            const uint32 indexOffset = static_cast<uint32>(m_ownedIndices.size());
+
+            for (const Vertex& vertex : meshVertices)
+            {
+                m_ownedVertices.push_back(PackVertex(vertex));
+                if (hasSkin)
+                {
+                    m_ownedSkinVertices.push_back(PackSkin(vertex));
+                }
+            }
 
             for (const uint32& index : meshIndices)
             {
-                m_indices.push_back(index + currentIndexOffset);
+                m_ownedIndices.push_back(index + vertexOffset);
             }
 
             MeshResourceInfo resourceInfo{};
-            resourceInfo.vertexCountOffset = currentIndexOffset;
-            resourceInfo.indexCountOffset = currentIndexOffset;
+            resourceInfo.vertexCountOffset = vertexOffset;
+            resourceInfo.indexCountOffset = indexOffset;
             resourceInfo.meshIndexCount = static_cast<uint32>(meshIndices.size());
-            mesh.UpdateInfo(resourceInfo);
-            m_meshes.push_back(mesh);
+            ComputeBoxBounds(Span<const PackedVertex>(m_ownedVertices).subspan(vertexOffset, meshVertices.size()), resourceInfo.boundsMin, resourceInfo.boundsMax);
+
+            // Simplified levels follow the full one in the same index array.
+            const std::vector<MeshLod>& lods = mesh.GetLods();
+            resourceInfo.lodCount = static_cast<uint32>(std::min<size_t>(lods.size(), MAX_MESH_LODS));
+            for (uint32 i = 0; i < resourceInfo.lodCount; ++i)
+            {
+                MeshLodRange& range = resourceInfo.lods[i];
+                range.indexOffset = static_cast<uint32>(m_ownedIndices.size());
+                range.indexCount = static_cast<uint32>(lods[i].indices.size());
+                range.error = lods[i].error;
+                for (uint32 index : lods[i].indices)
+                {
+                    m_ownedIndices.push_back(index + vertexOffset);
+                }
+            }
+            // Meshlet ranges become model wide, their vertices index the shared vertex array.
+            const MeshletData& meshlets = mesh.GetMeshlets();
+            resourceInfo.meshletOffset = static_cast<uint32>(m_ownedMeshlets.size());
+            resourceInfo.meshletCount = static_cast<uint32>(meshlets.meshlets.size());
+            for (Meshlet meshlet : meshlets.meshlets)
+            {
+                meshlet.vertexOffset += static_cast<uint32>(m_ownedMeshletVertices.size());
+                meshlet.triangleOffset += static_cast<uint32>(m_ownedMeshletTriangles.size());
+                m_ownedMeshlets.push_back(meshlet);
+            }
+            for (uint32 vertex : meshlets.vertices)
+            {
+                m_ownedMeshletVertices.push_back(vertex + vertexOffset);
+            }
+            m_ownedMeshletTriangles.insert(m_ownedMeshletTriangles.end(), meshlets.triangles.begin(), meshlets.triangles.end());
 
-            currentIndexOffset += static_cast<uint32>(meshVertices.size());
+            mesh.UpdateInfo(resourceInfo);
+            m_ownedMeshInfos.push_back(resourceInfo);
         }
 
-        //std::reverse(m_indices.begin(), m_indices.end());
+        m_meshInfos = m_ownedMeshInfos;
+        m_vertices = m_ownedVertices;
+        m_skinVertices = m_ownedSkinVertices;
+        m_indices = m_ownedIndices;
+        m_meshlets = m_ownedMeshlets;
+        m_meshletVertices = m_ownedMeshletVertices;
+        m_meshletTriangles = m_ownedMeshletTriangles;
+        m_file.reset();
+        ComputeBounds();
+    }
+
+    void ModelAsset::Initialize(Span<const MeshResourceInfo> meshInfos, Span<const PackedVertex> vertices, Span<const SkinVertex> skinVertices,
+                                Span<const uint32> indices, std::shared_ptr<const MappedFile> file)
+    {
+        m_ownedMeshInfos.clear();
+        m_ownedVertices.clear();
+        m_ownedSkinVertices.clear();
+        m_ownedIndices.clear();
+        m_ownedMeshlets.clear();
+        m_ownedMeshletVertices.clear();
+        m_ownedMeshletTriangles.clear();
+
+        m_meshInfos = meshInfos;
+        m_vertices = vertices;
+        m_skinVertices = skinVertices;
+        m_indices = indices;
+        m_file = std::move(file);
+        m_meshlets = {};
+        m_meshletVertices = {};
+        m_meshletTriangles = {};
+        ComputeBounds();
+    }
+
+    void ModelAsset::InitializeMeshlets(Span<const Meshlet> meshlets, Span<const uint32> meshletVertices, Span<const MeshletTriangle> meshletTriangles)
+    {
+        m_meshlets = meshlets;
+        m_meshletVertices = meshletVertices;
+        m_meshletTriangles = meshletTriangles;
+    }
+
+    void ModelAsset::ComputeBounds()
+    {
+        ComputeBoxBounds(m_vertices, m_boundsMin, m_boundsMax);
+        m_boundsCenter = (m_boundsMin + m_boundsMax) * 0.5f;
+        m_boundsRadius = 0.0f;
+        for (const PackedVertex& vertex : m_vertices)
+        {
+            m_boundsRadius = std::max(m_boundsRadius, (vertex.position - m_boundsCenter).length());
+        }
     }
 
     void Skeleton::AddBone(const std::string& name, int32 index, const float4x4& offsetMatrix)
@@ -110,6 +236,45 @@ namespace SGE
         }
     }
     
+    void Skeleton::BuildHierarchy()
+    {
+        std::vector<int32> parents(m_bones.size(), -1);
+        float4x4_array offsets(m_bones.size(), float4x4::Identity);
+
+        for (size_t i = 0; i < m_bones.size(); ++i)
+        {
+            parents[i] = m_bones[i].parentIndex;
+            offsets[i] = m_bones[i].offsetMatrix;
+        }
+
+        m_hierarchy.Initialize(parents, offsets);
+    }
+
+    void Skeleton::BuildLayerMasks()
+    {
+        const size_t layerCount = std::tuple_size<decltype(Bone::weights)>::value;
+        std::vector<float> boneWeights(m_bones.size());
+
+        m_layerMasks.resize(layerCount);
+        for (size_t layer = 0; layer < layerCount; ++layer)
+        {
+            for (size_t i = 0; i < m_bones.size(); ++i)
+            {
+                boneWeights[i] = m_bones[i].weights[layer];
+            }
+            m_layerMasks[layer].Initialize(boneWeights);
+        }
+    }
+
+    const BoneMask* Skeleton::GetLayerMask(int layer) const
+    {
+        if (layer >= 0 && layer < static_cast<int>(m_layerMasks.size()))
+        {
+            return &m_layerMasks[layer];
+        }
+        return nullptr;
+    }
+
     void Skeleton::PrintBoneHierarchyRecursive(const Bone& bone, int32 level) const
     {
         std::string out;
@@ -131,7 +296,34 @@ namespace SGE
     void AnimatedModelAsset::Initialize(std::vector<Mesh>& meshes, const Skeleton& skeleton, const std::vector<Animation>& animations)
     {
         ModelAsset::Initialize(meshes);
+
+        std::vector<AnimationClip> clips(animations.size());
+        for (size_t i = 0; i < animations.size(); ++i)
+        {
+            clips[i].Initialize(animations[i], skeleton.GetBoneNameToIndexMap(), skeleton.GetBoneCount());
+        }
+
+        InitializeAnimation(skeleton, std::move(clips));
+    }
+
+    void AnimatedModelAsset::InitializeAnimation(const Skeleton& skeleton, std::vector<AnimationClip> clips)
+    {
         m_skeleton = skeleton;
-        m_animations = animations;
+        m_skeleton.BuildHierarchy();
+        m_skeleton.BuildLayerMasks();
+        m_animationClips = std::move(clips);
+    }
+
+    AnimationClipHandle AnimatedModelAsset::FindAnimationClip(const std::string& name) const
+    {
+        for (size_t i = 0; i < m_animationClips.size(); ++i)
+        {
+            if (m_animationClips[i].GetName() == name)
+            {
+                return static_cast<AnimationClipHandle>(i);
+            }
+        }
+
+        return INVALID_ANIMATION_CLIP;
     }
 }
\ No newline at end of file
@@ -0,0 +1,328 @@
+#include "data/sge_model_importer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <unordered_map>
+#include <assimp/Importer.hpp>
+#include "data/sge_mesh_simplifier.h"
+#include "data/sge_skin_weights.h"
+
+namespace SGE
+{
+    std::unique_ptr<ModelAsset> ModelImporter::ImportModel(const std::string& path, MeshOptimizationReport* report)
+    {
+        Assimp::Importer importer{};
+        const aiScene* scene = importer.ReadFile(path, IMPORT_FLAGS);
+        if (!scene || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) || !scene->mRootNode)
+        {
+            return nullptr;
+        }
+
+        std::vector<Mesh> meshes;
+        MeshOptimizationReport optimization;
+        ProcessNode(scene->mRootNode, scene, meshes, path, optimization);
+        if (report)
+        {
+            *report = optimization;
+        }
+
+        std::unique_ptr<ModelAsset> asset = std::make_unique<ModelAsset>();
+        asset->Initialize(meshes);
+
+        return asset;
+    }
+
+    std::unique_ptr<AnimatedModelAsset> ModelImporter::ImportAnimatedModel(const std::string& path, MeshOptimizationReport* report)
+    {
+        Assimp::Importer importer{};
+        const aiScene* scene = importer.ReadFile(path, IMPORT_FLAGS);
+        if (!scene || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) || !scene->mRootNode)
+        {
+            return nullptr;
+        }
+
+        std::vector<Mesh> meshes;
+        MeshOptimizationReport optimization;
+        ProcessNode(scene->mRootNode, scene, meshes, path, optimization);
+        if (report)
+        {
+            *report = optimization;
+        }
+
+        Skeleton skeleton = ProcessSkeleton(scene);
+        std::vector<Animation> animations = ProcessAnimations(scene, skeleton);
+
+        std::unique_ptr<AnimatedModelAsset> asset = std::make_unique<AnimatedModelAsset>();
+        asset->Initialize(meshes, skeleton, animations);
+
+        return asset;
+    }
+
+    bool ModelImporter::IsAnimated(const std::string& path)
+    {
+        // Only the scene graph is needed, the post-processing steps are skipped.
+        Assimp::Importer importer{};
+        const aiScene* scene = importer.ReadFile(path, 0);
+        if (!scene || !scene->mRootNode)
+        {
+            return false;
+        }
+
+        if (scene->HasAnimations())
+        {
+            return true;
+        }
+
+        for (uint32 i = 0; i < scene->mNumMeshes; ++i)
+        {
+            if (scene->mMeshes[i]->HasBones())
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ModelImporter::ProcessNode(aiNode* node, const aiScene* scene, std::vector<Mesh>& meshes, const std::string& modelPath, MeshOptimizationReport& report)
+    {
+        for (uint32 i = 0; i < node->mNumMeshes; i++)
+        {
+            aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
+            meshes.push_back(ProcessMesh(mesh, scene, modelPath, report));
+        }
+
+        for (uint32 i = 0; i < node->mNumChildren; i++)
+        {
+            ProcessNode(node->mChildren[i], scene, meshes, modelPath, report);
+        }
+    }
+
+    Mesh ModelImporter::ProcessMesh(aiMesh* mesh, const aiScene* scene, const std::string& modelPath, MeshOptimizationReport& report)
+    {
+        std::vector<Vertex> vertices;
+        std::vector<uint32> indices;
+
+        vertices.reserve(mesh->mNumVertices);
+        indices.reserve(mesh->mNumFaces * 3);
+
+        const SkinInfluences skin = SkinWeightGatherer::Gather(mesh->mBones, mesh->mNumBones, mesh->mNumVertices);
+
+        for (uint32 i = 0; i < mesh->mNumVertices; i++)
+        {
+            Vertex vertex;
+            vertex.position = { mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z };
+
+            if (mesh->HasNormals())
+            {
+                vertex.normal = { mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z };
+            }
+
+            if (mesh->mTextureCoords[0])
+            {
+                vertex.texCoords = { mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y };
+            }
+            else
+            {
+                vertex.texCoords = { 0.0f, 0.0f };
+            }
+
+            if (mesh->HasTangentsAndBitangents())
+            {
+                vertex.tangent = { mesh->mTangents[i].x, mesh->mTangents[i].y, mesh->mTangents[i].z };
+                vertex.bitangent = { mesh->mBitangents[i].x, mesh->mBitangents[i].y, mesh->mBitangents[i].z };
+            }
+
+            std::copy_n(&skin.boneIndices[i * DEFAULT_SKIN_INFLUENCES], DEFAULT_SKIN_INFLUENCES, vertex.boneIndices);
+            std::copy_n(&skin.boneWeights[i * DEFAULT_SKIN_INFLUENCES], DEFAULT_SKIN_INFLUENCES, vertex.boneWeights);
+
+            vertices.push_back(vertex);
+        }
+
+        for (uint32 i = 0; i < mesh->mNumFaces; i++)
+        {
+            aiFace face = mesh->mFaces[i];
+            for (uint32 j = 0; j < face.mNumIndices; j++)
+            {
+                indices.push_back(face.mIndices[j]);
+            }
+        }
+
+        report += MeshOptimizer::Optimize(vertices, indices);
+        std::vector<MeshLod> lods = MeshSimplifier::BuildLods(vertices, indices);
+
+        Mesh result(std::move(vertices), std::move(indices));
+        result.SetLods(std::move(lods));
+        result.SetMeshlets(MeshletBuilder::Build(result.GetVertices(), result.GetIndices()));
+        return result;
+    }
+
+    std::string NormalizeBoneName(const std::string& name)
+    {
+        std::string result = name;
+        size_t pos = result.find("_$Assimp");
+        if (pos != std::string::npos)
+        {
+            result = result.substr(0, pos);
+        }
+
+        pos = result.find(':');
+        if (pos != std::string::npos)
+        {
+            result = result.substr(pos + 1);
+        }
+
+        std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+
+        return result;
+    }
+
+    void ProcessBoneHierarchy(aiNode* node, const std::unordered_map<std::string, int32>& boneNameToIndex, Skeleton& skeleton, int32 parentIndex)
+    {
+        std::string rawBoneName = node->mName.C_Str();
+        std::string boneName = NormalizeBoneName(rawBoneName);
+        auto it = boneNameToIndex.find(boneName);
+
+        int32 boneIndex = -1;
+        if (it != boneNameToIndex.end())
+        {
+            boneIndex = it->second;
+            if (skeleton.GetBone(boneIndex).parentIndex != -1)
+            {
+                return;
+            }
+
+            skeleton.GetBone(boneIndex).parentIndex = parentIndex;
+
+            if (parentIndex != -1)
+            {
+                skeleton.GetBone(parentIndex).children.push_back(boneIndex);
+            }
+        }
+
+        for (uint32 i = 0; i < node->mNumChildren; ++i)
+        {
+            int32 nextParentIndex = (boneIndex != -1) ? boneIndex : parentIndex;
+            ProcessBoneHierarchy(node->mChildren[i], boneNameToIndex, skeleton, nextParentIndex);
+        }
+    }
+
+    Skeleton ModelImporter::ProcessSkeleton(const aiScene* scene)
+    {
+        Skeleton skeleton;
+
+        for (uint32 i = 0; i < scene->mNumMeshes; ++i)
+        {
+            aiMesh* mesh = scene->mMeshes[i];
+            for (uint32 j = 0; j < mesh->mNumBones; ++j)
+            {
+                aiBone* bone = mesh->mBones[j];
+                std::string rawBoneName = bone->mName.C_Str();
+                std::string boneName = NormalizeBoneName(rawBoneName);
+                float4x4 offsetMatrix = AssimpToFloat4x4(bone->mOffsetMatrix);
+                //LOG_INFO("Add bone: {}", boneName);
+                skeleton.AddBone(boneName, j, offsetMatrix);
+            }
+        }
+
+        const std::unordered_map<std::string, int32>& boneNameToIndex = skeleton.GetBoneNameToIndexMap();
+
+        aiNode* actualRootNode = scene->mRootNode;
+        while (actualRootNode->mNumChildren > 0)
+        {
+            bool hasBoneChildren = false;
+            for (uint32 i = 0; i < actualRootNode->mNumChildren; ++i)
+            {
+                std::string childName = actualRootNode->mChildren[i]->mName.C_Str();
+                if (boneNameToIndex.find(NormalizeBoneName(childName)) != boneNameToIndex.end())
+                {
+                    hasBoneChildren = true;
+                    break;
+                }
+            }
+            if (hasBoneChildren)
+            {
+                break;
+            }
+            actualRootNode = actualRootNode->mChildren[0];
+        }
+
+        ProcessBoneHierarchy(actualRootNode, boneNameToIndex, skeleton, -1);
+
+        return skeleton;
+    }
+
+    std::vector<Animation> ModelImporter::ProcessAnimations(const aiScene* scene, const Skeleton& skeleton)
+    {
+        std::vector<Animation> animations;
+
+        if (!scene->HasAnimations())
+        {
+            return animations;
+        }
+
+        aiNode* rootNode = scene->mRootNode;
+
+        for (unsigned int i = 0; i < scene->mNumAnimations; ++i)
+        {
+            aiAnimation* aiAnim = scene->mAnimations[i];
+            Animation animation;
+
+            animation.name = aiAnim->mName.C_Str();
+            animation.duration = static_cast<float>(aiAnim->mDuration);
+            animation.ticksPerSecond = static_cast<float>(aiAnim->mTicksPerSecond != 0 ? aiAnim->mTicksPerSecond : 25.0f);
+            
+            for (unsigned int j = 0; j < aiAnim->mNumChannels; ++j)
+            {
+                aiNodeAnim* nodeAnim = aiAnim->mChannels[j];
+                std::string rawChannelName = nodeAnim->mNodeName.C_Str();
+                std::string boneName = NormalizeBoneName(rawChannelName);
+
+                //LOG_INFO("Read Bone: {}", boneName);
+
+                BoneKeyframes& boneKeyframes = animation.boneKeyframes[boneName];
+
+                for (unsigned int k = 0; k < nodeAnim->mNumPositionKeys; ++k)
+                {
+                    const aiVectorKey& key = nodeAnim->mPositionKeys[k];
+                    PositionKeyframe positionKeyframe;
+                    positionKeyframe.time = static_cast<float>(key.mTime);
+                    positionKeyframe.position = float3(key.mValue.x, key.mValue.y, key.mValue.z);
+                    boneKeyframes.positionKeys.push_back(positionKeyframe);
+                }
+
+                for (unsigned int k = 0; k < nodeAnim->mNumRotationKeys; ++k)
+                {
+                    const aiQuatKey& key = nodeAnim->mRotationKeys[k];
+                    RotationKeyframe rotationKeyframe;
+                    rotationKeyframe.time = static_cast<float>(key.mTime);
+                    rotationKeyframe.rotation = float4(key.mValue.x, key.mValue.y, key.mValue.z, key.mValue.w);
+                    boneKeyframes.rotationKeys.push_back(rotationKeyframe);
+                }
+
+                for (unsigned int k = 0; k < nodeAnim->mNumScalingKeys; ++k)
+                {
+                    const aiVectorKey& key = nodeAnim->mScalingKeys[k];
+                    ScaleKeyframe scaleKeyframe;
+                    scaleKeyframe.time = static_cast<float>(key.mTime);
+                    scaleKeyframe.scale = float3(key.mValue.x, key.mValue.y, key.mValue.z);
+                    boneKeyframes.scaleKeys.push_back(scaleKeyframe);
+                }
+            }
+
+            animations.push_back(animation);
+        }
+
+        return animations;
+    }
+
+    float4x4 AssimpToFloat4x4(const aiMatrix4x4& assimpMatrix)
+    {
+        return float4x4(
+            assimpMatrix.a1, assimpMatrix.a2, assimpMatrix.a3, assimpMatrix.a4,
+            assimpMatrix.b1, assimpMatrix.b2, assimpMatrix.b3, assimpMatrix.b4,
+            assimpMatrix.c1, assimpMatrix.c2, assimpMatrix.c3, assimpMatrix.c4,
+            assimpMatrix.d1, assimpMatrix.d2, assimpMatrix.d3, assimpMatrix.d4
+        );
+    }
+}
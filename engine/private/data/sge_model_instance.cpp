@@ -17,7 +17,16 @@ namespace SGE
         m_descriptorHeap = descriptorHeap;
         m_instanceIndex = instanceIndex;
         m_vertexBuffer.Initialize(device, asset->GetVertices());
+        if (asset->HasSkin())
+        {
+            m_skinBuffer.Initialize(device, asset->GetSkinVertices());
+        }
         m_indexBuffer.Initialize(device, asset->GetIndices());
+        if (!asset->GetMeshlets().empty() && !asset->HasSkin())
+        {
+            // Visible meshlets never add up to more indices than the meshes themselves.
+            m_clusterIndexBuffer.Initialize(device, asset->GetIndices());
+        }
         m_transformData = {};
         m_transformBuffer.Initialize(device->GetDevice().Get(), descriptorHeap, sizeof(TransformBuffer), m_instanceIndex);
     }
@@ -27,7 +36,7 @@ namespace SGE
         m_material = material;
     }
 
-    void ModelInstance::Render(ID3D12GraphicsCommandList* commandList) const
+    void ModelInstance::Render(ID3D12GraphicsCommandList* commandList, bool useClusterCulling) const
     {
         if(!m_enabled)
         {
@@ -39,21 +48,45 @@ namespace SGE
             return;
         }
 
-        commandList->IASetVertexBuffers(0, 1, &m_vertexBuffer.GetView());
-        commandList->IASetIndexBuffer(&m_indexBuffer.GetView());
+        // An empty view binds nothing to the skin slot, static models read zero bone data from it.
+        const D3D12_VERTEX_BUFFER_VIEW vertexBufferViews[] = { m_vertexBuffer.GetView(), m_skinBuffer.GetView() };
+        commandList->IASetVertexBuffers(0, _countof(vertexBufferViews), vertexBufferViews);
+        const D3D12_INDEX_BUFFER_VIEW indexBufferView = m_indexBuffer.GetView();
+        const D3D12_INDEX_BUFFER_VIEW clusterIndexBufferView = m_clusterIndexBuffer.GetView();
+        const D3D12_INDEX_BUFFER_VIEW* boundIndexBufferView = &indexBufferView;
+        commandList->IASetIndexBuffer(boundIndexBufferView);
         commandList->SetGraphicsRootDescriptorTable(1, m_descriptorHeap->GetGPUHandle(m_instanceIndex));
-        m_material->Bind(commandList, m_descriptorHeap);
+        m_material->Bind(commandList);
 
         std::string eventName = "Draw " + m_name;
         SCOPED_EVENT_GPU(commandList, eventName.c_str());
 
-        const std::vector<Mesh>& meshes = GetMeshes();
-        for (size_t i = 0; i < meshes.size(); ++i)
+        Span<const MeshResourceInfo> meshInfos = GetMeshInfos();
+        for (size_t i = 0; i < meshInfos.size(); ++i)
         {
-            const auto& resourceInfo = meshes[i].GetInfo();
-            uint32 meshIndexCount = resourceInfo.meshIndexCount;
-            uint32 vertexOffset = resourceInfo.vertexCountOffset;
-            uint32 indexOffset = resourceInfo.indexCountOffset;
+            const auto& resourceInfo = meshInfos[i];
+            uint32 meshIndexCount = 0;
+            uint32 indexOffset = 0;
+            const uint32 lod = MeshLodSelector::Select(resourceInfo, m_lodScale, m_lodPixelError);
+            MeshLodSelector::GetIndexRange(resourceInfo, lod, meshIndexCount, indexOffset);
+
+            const bool isClustered = useClusterCulling && i < m_clusterDraws.size() && m_clusterDraws[i].isCulled;
+            if (isClustered)
+            {
+                meshIndexCount = m_clusterDraws[i].indexCount;
+                indexOffset = m_clusterDraws[i].indexOffset;
+                if (meshIndexCount == 0)
+                {
+                    continue;
+                }
+            }
+
+            const D3D12_INDEX_BUFFER_VIEW* indexBuffer = isClustered ? &clusterIndexBufferView : &indexBufferView;
+            if (indexBuffer != boundIndexBufferView)
+            {
+                commandList->IASetIndexBuffer(indexBuffer);
+                boundIndexBufferView = indexBuffer;
+            }
 
             commandList->DrawIndexedInstanced(meshIndexCount, 1, indexOffset, 0, 0);
         }
@@ -71,32 +104,133 @@ namespace SGE
         m_enabled = isEnabled;
     }
 
-    float4x4 ModelInstance::GetWorldMatrix() const
+    void ModelInstance::SetPosition(const float3& position)
+    {
+        if (m_position != position)
+        {
+            m_position = position;
+            m_isTransformChanged = true;
+        }
+    }
+
+    void ModelInstance::SetRotation(const float3& rotation)
     {
-        float4x4 scaleMatrix = CreateScaleMatrix(m_scale);
-        float4x4 rotationMatrix = CreateRotationMatrixYawPitchRoll(
-            ConvertToRadians(m_rotation.x),
-            ConvertToRadians(m_rotation.y),
-            ConvertToRadians(m_rotation.z)
-        );
-        float4x4 translationMatrix = CreateTranslationMatrix(m_position);
-
-        return translationMatrix * rotationMatrix * scaleMatrix;
+        if (m_rotation != rotation)
+        {
+            m_rotation = rotation;
+            m_isTransformChanged = true;
+        }
     }
 
-    void ModelInstance::UpdateTransform(const float4x4& viewMatrix, const float4x4& projectionMatrix)
+    void ModelInstance::SetScale(const float3& scale)
+    {
+        if (m_scale != scale)
+        {
+            m_scale = scale;
+            m_isTransformChanged = true;
+        }
+    }
+
+    void ModelInstance::UpdateTransform(const float4x4& worldMatrix, const float4x4& viewMatrix, const float4x4& projectionMatrix)
     {
         if(!m_enabled)
         {
             return;
         }
 
-        OnUpdateTransform(viewMatrix, projectionMatrix);
+        OnUpdateTransform(worldMatrix, viewMatrix, projectionMatrix);
+    }
+
+    void ModelInstance::UpdateLod(const float4x4& worldMatrix, const float3& cameraPosition, float projectionScale, float nearPlane)
+    {
+        m_lodScale = MeshLodSelector::ComputeLodScale(worldMatrix, m_asset->GetBoundsCenter(), m_asset->GetBoundsRadius(),
+                                                      cameraPosition, projectionScale, nearPlane);
+    }
+
+    void ModelInstance::UpdateTextureDemand() const
+    {
+        if (!m_enabled || !m_material)
+        {
+            return;
+        }
+
+        // The bounding sphere stands in for the surface, tiling repeats the texture across it.
+        const float tiling = std::max(m_tilingUV.x, m_tilingUV.y);
+        m_material->RequestScreenSize(m_lodScale * 2.0f * m_asset->GetBoundsRadius() * tiling);
+    }
+
+    ModelBounds ModelInstance::GetLocalBounds() const
+    {
+        ModelBounds bounds;
+        bounds.boxMin = m_asset->GetBoundsMin();
+        bounds.boxMax = m_asset->GetBoundsMax();
+        bounds.sphereCenter = m_asset->GetBoundsCenter();
+        bounds.sphereRadius = m_asset->GetBoundsRadius();
+        return bounds;
+    }
+
+    void ModelInstance::UpdateClusters(const float4x4& worldMatrix, const float4x4& viewProjectionMatrix, const float3& cameraPosition)
+    {
+        if (!m_enabled || !m_isClusterCullingEnabled || m_asset->HasSkin())
+        {
+            m_clusterDraws.clear();
+            m_clusterIndices.clear();
+            m_areClustersDirty = true;
+            return;
+        }
+
+        // The camera position comes with the view, the LOD picks which meshes use meshlets.
+        if (!m_areClustersDirty && m_lodScale == m_clusterLodScale && worldMatrix == m_clusterWorldMatrix &&
+            viewProjectionMatrix == m_clusterViewProjectionMatrix)
+        {
+            return;
+        }
+
+        m_areClustersDirty = false;
+        m_clusterLodScale = m_lodScale;
+        m_clusterWorldMatrix = worldMatrix;
+        m_clusterViewProjectionMatrix = viewProjectionMatrix;
+        m_clusterDraws.clear();
+        m_clusterIndices.clear();
+
+        // Planes and camera in model space, the mesh and meshlet bounds stay as cooked.
+        const Frustum frustum = Frustum::FromMatrix(viewProjectionMatrix * worldMatrix);
+        const float4 camera = worldMatrix.inverse() * float4(cameraPosition.x, cameraPosition.y, cameraPosition.z, 1.0f);
+        const float3 localCamera(camera.x, camera.y, camera.z);
+
+        Span<const MeshResourceInfo> meshInfos = GetMeshInfos();
+        m_clusterDraws.resize(meshInfos.size());
+        for (size_t i = 0; i < meshInfos.size(); ++i)
+        {
+            const MeshResourceInfo& info = meshInfos[i];
+            ClusterDraw& draw = m_clusterDraws[i];
+            if (!frustum.IntersectsBox(info.boundsMin, info.boundsMax))
+            {
+                draw.isCulled = true;
+                continue;
+            }
+
+            if (info.meshletCount == 0 || MeshLodSelector::Select(info, m_lodScale, m_lodPixelError) != 0)
+            {
+                continue;
+            }
+
+            draw.isCulled = true;
+            draw.indexOffset = static_cast<uint32>(m_clusterIndices.size());
+            MeshletCuller::Cull(m_asset->GetMeshlets().subspan(info.meshletOffset, info.meshletCount), m_asset->GetMeshletVertices(),
+                                m_asset->GetMeshletTriangles(), frustum, localCamera, m_isClusterBackfaceCulled, m_clusterIndices);
+            draw.indexCount = static_cast<uint32>(m_clusterIndices.size()) - draw.indexOffset;
+        }
+
+        if (!m_clusterIndices.empty())
+        {
+            m_clusterIndexBuffer.Update(m_clusterIndices);
+        }
     }
 
-    void ModelInstance::OnUpdateTransform(const float4x4& viewMatrix, const float4x4& projectionMatrix)
+    void ModelInstance::OnUpdateTransform(const float4x4& worldMatrix, const float4x4& viewMatrix, const float4x4& projectionMatrix)
     {
-        m_transformData.model = GetWorldMatrix();
+        m_transformData.model = worldMatrix;
         m_transformData.view = viewMatrix;
         m_transformData.projection = projectionMatrix;
         m_transformData.isAnimated = false;
@@ -110,8 +244,8 @@ namespace SGE
         m_transformBuffer.Update(&m_transformData, sizeof(TransformBuffer));
     }
 
-    const std::vector<Mesh>& ModelInstance::GetMeshes() const
+    Span<const MeshResourceInfo> ModelInstance::GetMeshInfos() const
     {
-        return m_asset->GetMeshes();
+        return m_asset->GetMeshInfos();
     }
 }
\ No newline at end of file
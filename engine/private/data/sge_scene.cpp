@@ -7,6 +7,8 @@
 #include "core/sge_input.h"
 #include "data/sge_data_adapters.h"
 #include "data/sge_material_manager.h"
+#include "data/sge_scene_asset_loader.h"
+#include "core/sge_logger.h"
 
 namespace SGE
 {
@@ -16,8 +18,10 @@ namespace SGE
 
         InitializeCamera();
         InitializeFrameData();
+        LoadAssets();
         InstantiateModels();
         InstantiateAnimatedModels();
+        InstantiatePointLights();
 
         SceneData& sceneData = m_context->GetSceneData();
         SkyboxData* data = sceneData.GetSkyboxData();
@@ -33,13 +37,25 @@ namespace SGE
         UpdateCamera(deltaTime);
         UpdateModels(deltaTime);
         SyncFrameData();
+        CullModels();
     }
     
     void Scene::Shutdown()
     {
+        JobSystem::Get().Wait(m_animationJobs);
         m_frameData = {};
-        m_modelInstances.clear();
-        m_animatedModelInstances.clear();
+        m_cameraVersion = INVALID_DATA_VERSION;
+        m_directionalLightVersion = INVALID_DATA_VERSION;
+        m_registry.Clear();
+        m_cullInstances.clear();
+        m_cullObjects.clear();
+        m_transforms.Clear();
+        m_parentNames.clear();
+        m_bvh.Clear();
+        for (std::vector<ModelInstance*>& models : m_visibleModels)
+        {
+            models.clear();
+        }
     }
 
     void Scene::SyncFrameData()
@@ -54,7 +70,7 @@ namespace SGE
         m_frameData.viewProj = m_mainCamera.GetProjMatrix(m_context->GetScreenWidth(), m_context->GetScreenHeight()) * m_mainCamera.GetViewMatrix();
         m_frameData.viewProjSky =  m_mainCamera.GetProjMatrix(m_context->GetScreenWidth(), m_context->GetScreenHeight()) * m_mainCamera.GetViewSky();
         DirectionalLightData* directionalLightData = sceneData.GetDirectionalLight();
-        SyncData(directionalLightData, &m_frameData.directionalLight);
+        SyncChangedData(directionalLightData, &m_frameData.directionalLight, m_directionalLightVersion);
         
         float3 lightDirection = directionalLightData->direction.normalized();
         float3 lightPosition = -lightDirection * 7.0f;
@@ -71,23 +87,13 @@ namespace SGE
         m_frameData.lightView = lightView;
         m_frameData.lightProj = lightProj;
 
-        auto it = sceneData.objects.find(ObjectType::PointLight);
-        if (it != sceneData.objects.end())
+        // Lights keep their slot in the frame data, only edited ones are copied again.
+        Span<PointLightComponent> pointLights = m_registry.GetPool<PointLightComponent>().GetComponents();
+        const uint32 pointLightCount = std::min(static_cast<uint32>(pointLights.size()), MAX_POINT_LIGHTS);
+        m_frameData.activePointLightsCount = pointLightCount;
+        for (uint32 i = 0; i < pointLightCount; ++i)
         {
-            const uint32 count = static_cast<uint32>(it->second.size());
-            m_frameData.activePointLightsCount = count;
-
-            for (uint32 i = 0; i < count; ++i)
-            {
-                if (const auto* pointLightData = dynamic_cast<const PointLightData*>(it->second[i].get()))
-                {
-                    SyncData(pointLightData, &m_frameData.pointLights[i]);
-                }
-            }
-        }
-        else
-        {
-            m_frameData.activePointLightsCount = 0;
+            SyncChangedData(pointLights[i].data, &m_frameData.pointLights[i], pointLights[i].syncedVersion);
         }
 
         m_frameData.fogStart = 3.0f;
@@ -98,12 +104,63 @@ namespace SGE
 
         m_frameDataBuffer->Update(&m_frameData, sizeof(FrameData));
     }
-    
+
+    void Scene::CullModels()
+    {
+        const Frustum frustums[] =
+        {
+            Frustum::FromMatrix(m_frameData.viewProj),
+            Frustum::FromMatrix(m_frameData.lightProj * m_frameData.lightView)
+        };
+
+        for (size_t view = 0; view < m_visibleModels.size(); ++view)
+        {
+            m_bvh.QueryFrustum(frustums[view], m_queryProxies);
+            std::sort(m_queryProxies.begin(), m_queryProxies.end());
+
+            std::vector<ModelInstance*>& models = m_visibleModels[view];
+            models.clear();
+            for (uint32 proxy : m_queryProxies)
+            {
+                models.push_back(m_cullInstances[proxy]);
+            }
+
+            // Meshlets are only culled for models the camera sees, the other passes draw whole meshes.
+            if (view == static_cast<size_t>(SceneView::Camera))
+            {
+                for (uint32 proxy : m_queryProxies)
+                {
+                    m_cullInstances[proxy]->UpdateClusters(m_transforms.GetWorldMatrix(proxy), m_frameData.viewProj, m_frameData.cameraPosition);
+                }
+            }
+        }
+    }
+
+    const ObjectDataBase* Scene::PickObject(const float2& screenPosition) const
+    {
+        const float4x4 inverseViewProj = m_frameData.viewProj.inverse();
+        const float x = screenPosition.x * 2.0f - 1.0f;
+        const float y = 1.0f - screenPosition.y * 2.0f;
+        const float4 nearPoint = inverseViewProj * float4(x, y, 0.0f, 1.0f);
+        const float4 farPoint = inverseViewProj * float4(x, y, 1.0f, 1.0f);
+
+        const float3 origin = float3(nearPoint.x, nearPoint.y, nearPoint.z) / nearPoint.w;
+        const float3 end = float3(farPoint.x, farPoint.y, farPoint.z) / farPoint.w;
+        const float3 ray = end - origin;
+
+        RayHit hit;
+        if (!m_bvh.Raycast(origin, ray.normalized(), ray.length(), hit))
+        {
+            return nullptr;
+        }
+        return m_cullObjects[hit.proxy];
+    }
+
     void Scene::InitializeCamera()
     {
         CameraData* cameraData = m_context->GetSceneData().GetCameraData();
         m_cameraController.Initialize(cameraData);
-        SyncData(cameraData, &m_mainCamera);
+        SyncChangedData(cameraData, &m_mainCamera, m_cameraVersion);
     }
 
     void Scene::InitializeFrameData()
@@ -114,9 +171,19 @@ namespace SGE
         SyncFrameData();
     }
 
+    void Scene::LoadAssets()
+    {
+        SceneAssetLoader loader;
+        loader.Initialize(m_context);
+        loader.RequestSceneAssets(m_context->GetSceneData(), m_context->GetAssetsData());
+        loader.Wait();
+
+        AssetLoadProgress progress = loader.GetProgress();
+        LOG_INFO("Scene assets loaded: {}, failed: {}", progress.completed - progress.failed, progress.failed);
+    }
+
     void Scene::InstantiateModels()
     {
-        m_modelInstances.clear();
         const AssetsData& assetsData = m_context->GetAssetsData();
         const auto& sceneObjects = m_context->GetSceneData().objects;
 
@@ -142,14 +209,13 @@ namespace SGE
                 instance->SetMaterial(material);
                 SyncData(modelData, instance);
 
-                m_modelInstances[modelData] = instance;
+                CreateRenderable(modelData, instance, false);
             }
         }
     }
 
     void Scene::InstantiateAnimatedModels()
     {
-        m_animatedModelInstances.clear();
         const AssetsData& assetsData = m_context->GetAssetsData();
         const auto& sceneObjects = m_context->GetSceneData().objects;
 
@@ -175,48 +241,220 @@ namespace SGE
                 instance->SetMaterial(material);
                 SyncData(animData, instance); // todo: change to sync anim
 
-                m_animatedModelInstances[animData] = instance;
+                const Entity entity = CreateRenderable(animData, instance, true);
+                m_registry.Add<AnimatorComponent>(entity, { animData, instance });
+            }
+        }
+    }
+
+    void Scene::InstantiatePointLights()
+    {
+        const auto& sceneObjects = m_context->GetSceneData().objects;
+        auto it = sceneObjects.find(ObjectType::PointLight);
+        if (it == sceneObjects.end())
+        {
+            return;
+        }
+
+        for (const auto& obj : it->second)
+        {
+            if (const auto* pointLightData = dynamic_cast<const PointLightData*>(obj.get()))
+            {
+                m_registry.Add<PointLightComponent>(m_registry.Create(), { pointLightData });
             }
         }
     }
 
+    Entity Scene::CreateRenderable(const ModelData* data, ModelInstance* instance, bool isAnimated)
+    {
+        const Entity entity = m_registry.Create();
+        const uint32 transform = m_transforms.Create();
+        m_registry.Add<RenderableComponent>(entity, { data, instance, isAnimated });
+        m_registry.Add<TransformComponent>(entity, { transform });
+
+        if (transform >= m_cullInstances.size())
+        {
+            m_cullInstances.resize(transform + 1, nullptr);
+            m_cullObjects.resize(transform + 1, nullptr);
+            m_parentNames.resize(transform + 1);
+        }
+        m_cullInstances[transform] = instance;
+        m_cullObjects[transform] = data;
+        m_parentNames[transform].clear();
+        return entity;
+    }
+
     void Scene::UpdateCamera(double deltaTime)
     {
         m_cameraController.Update(deltaTime);
 
         CameraData* cameraData = m_context->GetSceneData().GetCameraData();
-        SyncData(cameraData, &m_mainCamera);
+        SyncChangedData(cameraData, &m_mainCamera, m_cameraVersion);
     }
     
     void Scene::UpdateModels(double deltaTime)
     {
         const float4x4& view = m_mainCamera.GetViewMatrix();
         const float4x4& proj = m_mainCamera.GetProjMatrix(m_context->GetScreenWidth(), m_context->GetScreenHeight());
+        const float3 cameraPosition = m_mainCamera.GetPosition();
+        const float projectionScale = MeshLodSelector::ComputeProjectionScale(proj, static_cast<float>(m_context->GetScreenHeight()));
 
-        for (const auto& pair : m_modelInstances)
+        // Models nobody edited keep what they copied last time.
+        m_registry.Each<RenderableComponent>([](Entity, RenderableComponent& renderable)
         {
-            SyncData(pair.first, pair.second);
-            pair.second->UpdateTransform(view, proj); 
+            SyncChangedData(renderable.data, renderable.instance, renderable.syncedVersion);
+        });
+
+        // Animation runs on the workers while the static instances are composed and uploaded.
+        DispatchAnimationUpdate(static_cast<float>(deltaTime));
+        UpdateTransforms();
+        UpdateBoundingVolumes();
+        AssignPointLights();
+
+        m_registry.Each<RenderableComponent, TransformComponent>([&](Entity, RenderableComponent& renderable, TransformComponent& transform)
+        {
+            if (renderable.isAnimated)
+            {
+                return;
+            }
+
+            ModelInstance* instance = renderable.instance;
+            const float4x4& worldMatrix = m_transforms.GetWorldMatrix(transform.transform);
+            instance->UpdateLod(worldMatrix, cameraPosition, projectionScale, m_mainCamera.GetNear());
+            instance->UpdateTextureDemand();
+            instance->SetPointLightMask(m_pointLightMasks[transform.transform]);
+            instance->UpdateTransform(worldMatrix, view, proj);
+        });
+
+        JobSystem::Get().Wait(m_animationJobs);
+
+        m_registry.Each<AnimatorComponent, TransformComponent>([&](Entity, AnimatorComponent& animator, TransformComponent& transform)
+        {
+            AnimatedModelInstance* instance = animator.instance;
+            const float4x4& worldMatrix = m_transforms.GetWorldMatrix(transform.transform);
+            instance->UpdateLod(worldMatrix, cameraPosition, projectionScale, m_mainCamera.GetNear());
+            instance->UpdateTextureDemand();
+            instance->SetPointLightMask(m_pointLightMasks[transform.transform]);
+            instance->UpdateTransform(worldMatrix, view, proj);
+        });
+    }
+
+    void Scene::DispatchAnimationUpdate(float deltaTime)
+    {
+        Span<AnimatorComponent> animators = m_registry.GetPool<AnimatorComponent>().GetComponents();
+
+        // Every instance only touches its own layers and pose and reads its shared asset, so the
+        // result does not depend on which worker evaluates it.
+        JobSystem::Get().ParallelForAsync(animators.size(), [animators, deltaTime](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                animators[i].instance->FixedUpdate(deltaTime);
+            }
+        }, m_animationJobs);
+    }
+
+    void Scene::UpdateTransforms()
+    {
+        // Only instances whose values changed since the last frame reach the hierarchy, and only
+        // their subtrees get new world matrices.
+        m_registry.Each<RenderableComponent, TransformComponent>([this](Entity, RenderableComponent& renderable, TransformComponent& transform)
+        {
+            ModelInstance* instance = renderable.instance;
+            if (instance->IsTransformChanged())
+            {
+                const float3& rotation = instance->GetRotation();
+                const float4 quaternion = CreateQuaternionYawPitchRoll(ConvertToRadians(rotation.x), ConvertToRadians(rotation.y), ConvertToRadians(rotation.z));
+                m_transforms.SetLocal(transform.transform, instance->GetPosition(), quaternion, instance->GetScale());
+                instance->ClearTransformChanged();
+            }
+
+            const std::string& parentName = renderable.data->parent;
+            if (parentName != m_parentNames[transform.transform])
+            {
+                m_parentNames[transform.transform] = parentName;
+                if (!m_transforms.SetParent(transform.transform, FindTransform(parentName)))
+                {
+                    LOG_WARN("Model {} can't be attached to {}, it is one of its parents.", renderable.data->name, parentName);
+                }
+            }
+        });
+
+        m_transforms.Update();
+    }
+
+    uint32 Scene::FindTransform(const std::string& name) const
+    {
+        if (!name.empty())
+        {
+            for (size_t i = 0; i < m_cullObjects.size(); ++i)
+            {
+                if (m_cullObjects[i] && m_cullObjects[i]->name == name)
+                {
+                    return static_cast<uint32>(i);
+                }
+            }
+        }
+        return INVALID_TRANSFORM;
+    }
+
+    void Scene::UpdateBoundingVolumes()
+    {
+        auto computeBox = [this](uint32 index)
+        {
+            const ModelBounds bounds = m_cullInstances[index]->GetLocalBounds();
+            return BoundingBox{ bounds.boxMin, bounds.boxMax }.Transformed(m_transforms.GetWorldMatrix(index));
+        };
+
+        // Built once for the scene's instances, after that only the boxes that moved touch the tree.
+        if (m_bvh.GetCount() != m_cullInstances.size())
+        {
+            m_worldBoxes.resize(m_cullInstances.size());
+            for (size_t i = 0; i < m_cullInstances.size(); ++i)
+            {
+                m_worldBoxes[i] = computeBox(static_cast<uint32>(i));
+            }
+            m_bvh.Build(m_worldBoxes);
+            return;
         }
 
-        for (const auto& pair : m_animatedModelInstances)
+        for (uint32 transform : m_transforms.GetChangedTransforms())
+        {
+            m_bvh.Update(transform, computeBox(transform));
+        }
+    }
+
+    void Scene::AssignPointLights()
+    {
+        m_pointLightMasks.assign(m_cullInstances.size(), 0);
+
+        // Past its radius a point light adds nothing, the forward pass skips it for models outside.
+        Span<const PointLightComponent> pointLights = m_registry.GetPool<PointLightComponent>().GetComponents();
+        const uint32 count = std::min(static_cast<uint32>(pointLights.size()), MAX_POINT_LIGHTS);
+        for (uint32 i = 0; i < count; ++i)
         {
-            SyncData(pair.first, pair.second);
-            pair.second->FixedUpdate(static_cast<float>(deltaTime));
-            pair.second->UpdateTransform(view, proj); 
+            const PointLightData* pointLightData = pointLights[i].data;
+            m_bvh.QuerySphere(pointLightData->position, pointLightData->radius, m_queryProxies);
+            for (uint32 proxy : m_queryProxies)
+            {
+                m_pointLightMasks[proxy] |= 1u << i;
+            }
         }
     }
 
     AnimatedModelInstance* Scene::GetAnimModel(const AnimatedModelData* data) const
     {
-        if(data)
+        const ComponentPool<AnimatorComponent>* animators = m_registry.FindPool<AnimatorComponent>();
+        if (data && animators)
         {
-            auto it = m_animatedModelInstances.find(data);
-            if(it != m_animatedModelInstances.end())
+            for (const AnimatorComponent& animator : animators->GetComponents())
             {
-                return it->second;
+                if (animator.data == data)
+                {
+                    return animator.instance;
+                }
             }
         }
         return nullptr;
     }
-}
+}
\ No newline at end of file
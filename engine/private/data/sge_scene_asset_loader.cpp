@@ -0,0 +1,143 @@
+#include "data/sge_scene_asset_loader.h"
+
+#include <filesystem>
+#include <DirectXTex.h>
+#include "rendering/sge_render_context.h"
+#include "data/sge_model_loader.h"
+#include "data/sge_texture_manager.h"
+#include "data/sge_texture_cooker.h"
+#include "core/sge_logger.h"
+
+namespace SGE
+{
+    namespace
+    {
+        template<typename T>
+        class DecodedValue : public DecodedAsset
+        {
+        public:
+            explicit DecodedValue(std::unique_ptr<T> value) : value(std::move(value)) {}
+
+            std::unique_ptr<T> value;
+        };
+
+        template<typename T>
+        std::unique_ptr<DecodedAsset> Wrap(std::unique_ptr<T> value)
+        {
+            if (!value)
+            {
+                return nullptr;
+            }
+
+            return std::make_unique<DecodedValue<T>>(std::move(value));
+        }
+
+        template<typename T>
+        std::unique_ptr<T> Unwrap(DecodedAsset& asset)
+        {
+            return std::move(static_cast<DecodedValue<T>&>(asset).value);
+        }
+    }
+
+    void SceneAssetLoader::Initialize(RenderContext* context)
+    {
+        m_context = context;
+        m_loader.Initialize(this, this);
+    }
+
+    void SceneAssetLoader::RequestSceneAssets(const SceneData& sceneData, const AssetsData& assetsData)
+    {
+        auto models = sceneData.objects.find(ObjectType::Model);
+        if (models != sceneData.objects.end())
+        {
+            for (const auto& obj : models->second)
+            {
+                if (const auto* modelData = dynamic_cast<const ModelData*>(obj.get()))
+                {
+                    const ModelAssetData& modelAsset = assetsData.GetModel(modelData->assetId);
+                    if (!ModelLoader::HasAsset(modelAsset.path))
+                    {
+                        m_loader.Request(AssetKind::Model, modelAsset.path);
+                    }
+                    RequestMaterialTextures(assetsData.GetMaterial(modelData->materialId));
+                }
+            }
+        }
+
+        auto animatedModels = sceneData.objects.find(ObjectType::AnimatedModel);
+        if (animatedModels != sceneData.objects.end())
+        {
+            for (const auto& obj : animatedModels->second)
+            {
+                if (const auto* animData = dynamic_cast<const AnimatedModelData*>(obj.get()))
+                {
+                    const AnimatedModelAssetData& modelAsset = assetsData.GetAnimModel(animData->assetId);
+                    if (!ModelLoader::HasAnimatedAsset(modelAsset.path))
+                    {
+                        m_loader.Request(AssetKind::AnimatedModel, modelAsset.path);
+                    }
+                    RequestMaterialTextures(assetsData.GetMaterial(animData->materialId));
+                }
+            }
+        }
+    }
+
+    void SceneAssetLoader::RequestMaterialTextures(const MaterialAssetData& materialAsset)
+    {
+        RequestTexture(materialAsset.albedoTexturePath);
+        RequestTexture(materialAsset.normalTexturePath);
+        RequestTexture(materialAsset.metallicTexturePath);
+        RequestTexture(materialAsset.roughnessTexturePath);
+    }
+
+    void SceneAssetLoader::RequestTexture(const std::string& path)
+    {
+        // Missing files resolve to the default textures in TextureManager, nothing to decode.
+        if (path.empty() || TextureManager::HasTexture(path) || !std::filesystem::exists(TextureCooker::ResolveRuntimePath(path)))
+        {
+            return;
+        }
+
+        // Cooked textures stream in, TextureManager reads their mip tail on first use.
+        CookedTextureInfo info;
+        if (TextureCooker::ReadDDSInfo(TextureCooker::ResolveRuntimePath(path), info))
+        {
+            return;
+        }
+
+        m_loader.Request(AssetKind::Texture, path);
+    }
+
+    std::unique_ptr<DecodedAsset> SceneAssetLoader::Decode(AssetKind kind, const std::string& path)
+    {
+        switch (kind)
+        {
+        case AssetKind::Model:
+            return Wrap(ModelLoader::DecodeModel(path));
+        case AssetKind::AnimatedModel:
+            return Wrap(ModelLoader::DecodeAnimatedModel(path));
+        case AssetKind::Texture:
+            return Wrap(Texture::Decode(path));
+        default:
+            return nullptr;
+        }
+    }
+
+    void SceneAssetLoader::Upload(AssetKind kind, const std::string& path, DecodedAsset& asset)
+    {
+        switch (kind)
+        {
+        case AssetKind::Model:
+            ModelLoader::AddModel(path, Unwrap<ModelAsset>(asset));
+            break;
+        case AssetKind::AnimatedModel:
+            ModelLoader::AddAnimatedModel(path, Unwrap<AnimatedModelAsset>(asset));
+            break;
+        case AssetKind::Texture:
+            TextureManager::AddTexture(path, *Unwrap<DirectX::ScratchImage>(asset), m_context->GetDevice(), m_context->GetCbvSrvUavHeap());
+            break;
+        default:
+            break;
+        }
+    }
+}
@@ -62,10 +62,10 @@ namespace SGE
     {
         switch (type)
         {
-            case ShaderType::Vertex: return "vs_5_0";
-            case ShaderType::Pixel: return "ps_5_0";
-            case ShaderType::Compute: return "cs_5_0";
-            case ShaderType::Geometry: return "gs_5_0";
+            case ShaderType::Vertex: return "vs_5_1";
+            case ShaderType::Pixel: return "ps_5_1";
+            case ShaderType::Compute: return "cs_5_1";
+            case ShaderType::Geometry: return "gs_5_1";
             default: throw std::invalid_argument("Unsupported shader type.");
         }
     }
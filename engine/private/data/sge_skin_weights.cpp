@@ -0,0 +1,114 @@
+#include "data/sge_skin_weights.h"
+
+#include <algorithm>
+#include "core/sge_job_system.h"
+
+namespace SGE
+{
+    namespace
+    {
+        // Vertices per job, the work per vertex is only a handful of compares.
+        constexpr size_t VERTEX_GRAIN_SIZE = 4096;
+
+        struct Influence
+        {
+            int32 bone;
+            float weight;
+        };
+
+        void SelectInfluences(const Influence* influences, uint32 count, uint32 influenceCount, int32* boneIndices, float* boneWeights)
+        {
+            uint32 kept = 0;
+            for (uint32 i = 0; i < count; ++i)
+            {
+                const Influence& influence = influences[i];
+                if (!(influence.weight > 0.0f) || (kept == influenceCount && influence.weight <= boneWeights[kept - 1]))
+                {
+                    continue;
+                }
+
+                // The weakest entry drops out once the slots are full.
+                uint32 slot = kept < influenceCount ? kept++ : kept - 1;
+                while (slot > 0 && boneWeights[slot - 1] < influence.weight)
+                {
+                    boneIndices[slot] = boneIndices[slot - 1];
+                    boneWeights[slot] = boneWeights[slot - 1];
+                    --slot;
+                }
+                boneIndices[slot] = influence.bone;
+                boneWeights[slot] = influence.weight;
+            }
+
+            float weightSum = 0.0f;
+            for (uint32 i = 0; i < kept; ++i)
+            {
+                weightSum += boneWeights[i];
+            }
+
+            if (weightSum > 0.0f)
+            {
+                for (uint32 i = 0; i < kept; ++i)
+                {
+                    boneWeights[i] /= weightSum;
+                }
+            }
+        }
+    }
+
+    SkinInfluences SkinWeightGatherer::Gather(const aiBone* const* bones, uint32 boneCount, uint32 vertexCount, uint32 influenceCount)
+    {
+        SkinInfluences result;
+        result.influenceCount = std::clamp(influenceCount, 1u, MAX_SKIN_INFLUENCES);
+        result.boneIndices.assign(static_cast<size_t>(vertexCount) * result.influenceCount, -1);
+        result.boneWeights.assign(static_cast<size_t>(vertexCount) * result.influenceCount, 0.0f);
+
+        std::vector<uint32> offsets(static_cast<size_t>(vertexCount) + 1, 0);
+        for (uint32 b = 0; b < boneCount; ++b)
+        {
+            for (uint32 i = 0; i < bones[b]->mNumWeights; ++i)
+            {
+                const uint32 vertex = bones[b]->mWeights[i].mVertexId;
+                if (vertex < vertexCount)
+                {
+                    ++offsets[vertex + 1];
+                }
+            }
+        }
+
+        for (uint32 v = 0; v < vertexCount; ++v)
+        {
+            offsets[v + 1] += offsets[v];
+        }
+
+        if (offsets[vertexCount] == 0)
+        {
+            return result;
+        }
+
+        // Bones are visited in order, so every vertex sees its weights sorted by bone index.
+        std::vector<Influence> influences(offsets[vertexCount]);
+        std::vector<uint32> fill(offsets.begin(), offsets.end() - 1);
+        for (uint32 b = 0; b < boneCount; ++b)
+        {
+            for (uint32 i = 0; i < bones[b]->mNumWeights; ++i)
+            {
+                const aiVertexWeight& weight = bones[b]->mWeights[i];
+                if (weight.mVertexId < vertexCount)
+                {
+                    influences[fill[weight.mVertexId]++] = { static_cast<int32>(b), static_cast<float>(weight.mWeight) };
+                }
+            }
+        }
+
+        const uint32 stride = result.influenceCount;
+        JobSystem::Get().ParallelFor(vertexCount, [&](size_t begin, size_t end)
+        {
+            for (size_t v = begin; v < end; ++v)
+            {
+                SelectInfluences(influences.data() + offsets[v], offsets[v + 1] - offsets[v], stride, &result.boneIndices[v * stride], &result.boneWeights[v * stride]);
+            }
+        }, VERTEX_GRAIN_SIZE);
+
+        return result;
+    }
+}
@@ -3,6 +3,7 @@
 #include "core/sge_device.h"
 #include "core/sge_descriptor_heap.h"
 #include "core/sge_helpers.h"
+#include "data/sge_texture_cooker.h"
 #include <filesystem>
 #include <DirectXTex.h>
 
@@ -12,34 +13,60 @@ namespace SGE
 {
     void Texture::Initialize(const std::string& texturePath, const Device* device, const DescriptorHeap* descriptorHeap, uint32 descriptorIndex)
     {
-        if (!std::filesystem::exists(texturePath))
+        std::unique_ptr<ScratchImage> image = Decode(texturePath);
+        Initialize(*image, device, descriptorHeap, descriptorIndex);
+    }
+
+    std::unique_ptr<ScratchImage> Texture::Decode(const std::string& texturePath)
+    {
+        // The .dds written by sge_cook already has its mips, prefer it while it's up to date.
+        const std::string runtimePath = TextureCooker::ResolveRuntimePath(texturePath);
+        if (!std::filesystem::exists(runtimePath))
         {
             throw std::runtime_error("Texture file does not exist: " + texturePath);
         }
 
-        TexMetadata metadata;
-        ScratchImage scratchImage;
+        std::unique_ptr<ScratchImage> scratchImage = std::make_unique<ScratchImage>();
 
-        std::filesystem::path filePath = texturePath;
+        std::filesystem::path filePath = runtimePath;
         std::wstring fileName = filePath.wstring();
 
         if (filePath.extension() == L".dds")
         {
-            Verify(LoadFromDDSFile(fileName.c_str(), DDS_FLAGS_NONE, &metadata, scratchImage)); 
+            Verify(LoadFromDDSFile(fileName.c_str(), DDS_FLAGS_NONE, nullptr, *scratchImage));
         }
         else if (filePath.extension() == L".hdr")
         {
-            Verify(LoadFromHDRFile(fileName.c_str(), &metadata, scratchImage));
+            Verify(LoadFromHDRFile(fileName.c_str(), nullptr, *scratchImage));
         }
         else if (filePath.extension() == L".tga")
         {
-            Verify(LoadFromTGAFile(fileName.c_str(), &metadata, scratchImage));
+            Verify(LoadFromTGAFile(fileName.c_str(), nullptr, *scratchImage));
         }
         else
         {
-            Verify(LoadFromWICFile(fileName.c_str(), WIC_FLAGS_FORCE_RGB, &metadata, scratchImage));
+            // WIC needs COM on the calling thread, worker threads don't have it yet.
+            HRESULT comResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+            HRESULT loadResult = LoadFromWICFile(fileName.c_str(), WIC_FLAGS_FORCE_RGB, nullptr, *scratchImage);
+            if (SUCCEEDED(comResult))
+            {
+                CoUninitialize();
+            }
+            Verify(loadResult);
         }
 
+        if (scratchImage->GetImageCount() == 0)
+        {
+            throw std::runtime_error("Texture could not be decoded: " + texturePath);
+        }
+
+        return scratchImage;
+    }
+
+    void Texture::Initialize(const ScratchImage& scratchImage, const Device* device, const DescriptorHeap* descriptorHeap, uint32 descriptorIndex)
+    {
+        const TexMetadata& metadata = scratchImage.GetMetadata();
+
         D3D12_RESOURCE_DESC textureDesc = {};
         textureDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
         textureDesc.Alignment = 0;
@@ -99,6 +126,108 @@ namespace SGE
         device->GetDevice()->CreateShaderResourceView(m_resource.Get(), &srvDesc, srvHandle);
 
         m_descriptorIndex = descriptorIndex;
+        m_mipCount = static_cast<uint32>(metadata.mipLevels);
+    }
+
+    void Texture::Initialize(Span<const TextureImage> mips, CookedTextureFormat format, const Device* device, const DescriptorHeap* descriptorHeap, uint32 descriptorIndex)
+    {
+        D3D12_RESOURCE_DESC textureDesc = CD3DX12_RESOURCE_DESC::Tex2D(static_cast<DXGI_FORMAT>(format), mips[0].width, mips[0].height, 1, static_cast<uint16>(mips.size()));
+
+        ComPtr<ID3D12Resource> resource;
+        Verify(device->GetDevice()->CreateCommittedResource(
+            &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
+            D3D12_HEAP_FLAG_NONE,
+            &textureDesc,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            nullptr, IID_PPV_ARGS(&resource)));
+
+        const uint32 subresourceCount = static_cast<uint32>(mips.size());
+        if (m_resourceUpload)
+        {
+            m_retiredResources.push_back(m_resourceUpload);
+        }
+        Verify(device->GetDevice()->CreateCommittedResource(
+            &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
+            D3D12_HEAP_FLAG_NONE,
+            &CD3DX12_RESOURCE_DESC::Buffer(GetRequiredIntermediateSize(resource.Get(), 0, subresourceCount)),
+            D3D12_RESOURCE_STATE_GENERIC_READ,
+            nullptr, IID_PPV_ARGS(&m_resourceUpload)));
+
+        std::vector<D3D12_SUBRESOURCE_DATA> subresourceData(subresourceCount);
+        for (uint32 i = 0; i < subresourceCount; ++i)
+        {
+            subresourceData[i].pData = mips[i].pixels.data();
+            subresourceData[i].RowPitch = GetTextureRowPitch(format, mips[i].width);
+            subresourceData[i].SlicePitch = static_cast<LONG_PTR>(mips[i].pixels.size());
+        }
+
+        ID3D12GraphicsCommandList* commandList = device->GetCommandList().Get();
+        UpdateSubresources(commandList, resource.Get(), m_resourceUpload.Get(), 0, 0, subresourceCount, subresourceData.data());
+
+        CD3DX12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(resource.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        commandList->ResourceBarrier(1, &barrier);
+
+        if (m_resource)
+        {
+            m_retiredResources.push_back(m_resource);
+        }
+        m_resource = resource;
+        m_mipCount = subresourceCount;
+        CreateShaderResourceView(textureDesc.Format, device, descriptorHeap, descriptorIndex);
+    }
+
+    void Texture::DropMips(uint32 count, const Device* device, const DescriptorHeap* descriptorHeap)
+    {
+        if (!m_resource || count == 0 || count >= m_mipCount)
+        {
+            return;
+        }
+
+        D3D12_RESOURCE_DESC textureDesc = m_resource->GetDesc();
+        textureDesc.Width = std::max<uint64>(1, textureDesc.Width >> count);
+        textureDesc.Height = std::max(1u, textureDesc.Height >> count);
+        textureDesc.MipLevels = static_cast<uint16>(m_mipCount - count);
+
+        ComPtr<ID3D12Resource> resource;
+        Verify(device->GetDevice()->CreateCommittedResource(
+            &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
+            D3D12_HEAP_FLAG_NONE,
+            &textureDesc,
+            D3D12_RESOURCE_STATE_COPY_DEST,
+            nullptr, IID_PPV_ARGS(&resource)));
+
+        ID3D12GraphicsCommandList* commandList = device->GetCommandList().Get();
+        CD3DX12_RESOURCE_BARRIER toSource = CD3DX12_RESOURCE_BARRIER::Transition(m_resource.Get(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_COPY_SOURCE);
+        commandList->ResourceBarrier(1, &toSource);
+
+        for (uint32 mip = 0; mip < textureDesc.MipLevels; ++mip)
+        {
+            CD3DX12_TEXTURE_COPY_LOCATION destination(resource.Get(), mip);
+            CD3DX12_TEXTURE_COPY_LOCATION source(m_resource.Get(), mip + count);
+            commandList->CopyTextureRegion(&destination, 0, 0, 0, &source, nullptr);
+        }
+
+        CD3DX12_RESOURCE_BARRIER toShader = CD3DX12_RESOURCE_BARRIER::Transition(resource.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        commandList->ResourceBarrier(1, &toShader);
+
+        // The copy still reads the old resource.
+        m_retiredResources.push_back(m_resource);
+        m_resource = resource;
+        m_mipCount = textureDesc.MipLevels;
+        CreateShaderResourceView(textureDesc.Format, device, descriptorHeap, m_descriptorIndex);
+    }
+
+    void Texture::CreateShaderResourceView(DXGI_FORMAT format, const Device* device, const DescriptorHeap* descriptorHeap, uint32 descriptorIndex)
+    {
+        D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = format;
+        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srvDesc.Texture2D.MipLevels = m_mipCount;
+        srvDesc.Texture2D.MostDetailedMip = 0;
+
+        device->GetDevice()->CreateShaderResourceView(m_resource.Get(), &srvDesc, descriptorHeap->GetCPUHandle(descriptorIndex));
+        m_descriptorIndex = descriptorIndex;
     }
 
     void Texture::CreateSinglePixelTexture(uint32 color, const Device* device, const DescriptorHeap* descriptorHeap, uint32 descriptorIndex)
@@ -0,0 +1,385 @@
+#include "data/sge_texture_cooker.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include "data/sge_texture_encoder.h"
+
+// Private copy of the decoder Assimp ships, static so it can't clash with the one Assimp exports.
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#define STBI_ONLY_JPEG
+#define STBI_ONLY_TGA
+#define STBI_ONLY_BMP
+#include <stb_image.h>
+
+namespace SGE
+{
+    namespace
+    {
+        constexpr uint32 DDS_MAGIC = 0x20534444; // "DDS "
+        constexpr uint32 DDS_FOURCC_DX10 = 0x30315844; // "DX10"
+
+        constexpr uint32 DDSD_CAPS = 0x1;
+        constexpr uint32 DDSD_HEIGHT = 0x2;
+        constexpr uint32 DDSD_WIDTH = 0x4;
+        constexpr uint32 DDSD_PITCH = 0x8;
+        constexpr uint32 DDSD_PIXELFORMAT = 0x1000;
+        constexpr uint32 DDSD_MIPMAPCOUNT = 0x20000;
+        constexpr uint32 DDSD_LINEARSIZE = 0x80000;
+        constexpr uint32 DDPF_FOURCC = 0x4;
+        constexpr uint32 DDSCAPS_COMPLEX = 0x8;
+        constexpr uint32 DDSCAPS_TEXTURE = 0x1000;
+        constexpr uint32 DDSCAPS_MIPMAP = 0x400000;
+        constexpr uint32 DDS_DIMENSION_TEXTURE2D = 3;
+
+        struct DDSPixelFormat
+        {
+            uint32 size = sizeof(DDSPixelFormat);
+            uint32 flags = 0;
+            uint32 fourCC = 0;
+            uint32 rgbBitCount = 0;
+            uint32 rBitMask = 0;
+            uint32 gBitMask = 0;
+            uint32 bBitMask = 0;
+            uint32 aBitMask = 0;
+        };
+
+        struct DDSHeader
+        {
+            uint32 size = sizeof(DDSHeader);
+            uint32 flags = 0;
+            uint32 height = 0;
+            uint32 width = 0;
+            uint32 pitchOrLinearSize = 0;
+            uint32 depth = 0;
+            uint32 mipMapCount = 0;
+            uint32 reserved1[11] = {};
+            DDSPixelFormat pixelFormat;
+            uint32 caps = 0;
+            uint32 caps2 = 0;
+            uint32 caps3 = 0;
+            uint32 caps4 = 0;
+            uint32 reserved2 = 0;
+        };
+
+        struct DDSHeaderDX10
+        {
+            uint32 dxgiFormat = 0;
+            uint32 resourceDimension = DDS_DIMENSION_TEXTURE2D;
+            uint32 miscFlag = 0;
+            uint32 arraySize = 1;
+            uint32 miscFlags2 = 0;
+        };
+
+        static_assert(sizeof(DDSHeader) == 124 && sizeof(DDSHeaderDX10) == 20, "DDS header layout");
+
+        constexpr size_t DDS_DATA_OFFSET = sizeof(uint32) + sizeof(DDSHeader) + sizeof(DDSHeaderDX10);
+
+        template<typename T>
+        void WriteValue(std::vector<uint8>& out, const T& value)
+        {
+            const uint8* bytes = reinterpret_cast<const uint8*>(&value);
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        bool IsCookedFormat(uint32 dxgiFormat)
+        {
+            const CookedTextureFormat format = static_cast<CookedTextureFormat>(dxgiFormat);
+            return format == CookedTextureFormat::RGBA8 || TextureEncoder::GetBlockSize(format) > 0;
+        }
+
+        std::string GetLowerFileName(const std::string& path)
+        {
+            std::string name = std::filesystem::path(path).filename().string();
+            std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return name;
+        }
+
+        bool ReadHeaders(std::ifstream& file, CookedTextureInfo& info)
+        {
+            uint32 magic = 0;
+            DDSHeader header;
+            DDSHeaderDX10 headerDX10;
+            if (!file.read(reinterpret_cast<char*>(&magic), sizeof(magic)) ||
+                !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+                !file.read(reinterpret_cast<char*>(&headerDX10), sizeof(headerDX10)))
+            {
+                return false;
+            }
+
+            if (magic != DDS_MAGIC || header.size != sizeof(DDSHeader) || header.pixelFormat.fourCC != DDS_FOURCC_DX10 ||
+                headerDX10.resourceDimension != DDS_DIMENSION_TEXTURE2D || headerDX10.arraySize != 1 || headerDX10.miscFlag != 0 ||
+                !IsCookedFormat(headerDX10.dxgiFormat) || header.width == 0 || header.height == 0)
+            {
+                return false;
+            }
+
+            info.width = header.width;
+            info.height = header.height;
+            info.mipCount = std::max(1u, header.mipMapCount);
+            info.format = static_cast<CookedTextureFormat>(headerDX10.dxgiFormat);
+            return info.mipCount <= 32 && (std::max(info.width, info.height) >> (info.mipCount - 1)) >= 1;
+        }
+    }
+
+    bool IsBlockCompressed(CookedTextureFormat format)
+    {
+        return TextureEncoder::GetBlockSize(format) > 0;
+    }
+
+    uint32 GetTextureRowPitch(CookedTextureFormat format, uint32 width)
+    {
+        if (IsBlockCompressed(format))
+        {
+            return std::max(1u, (width + 3) / 4) * TextureEncoder::GetBlockSize(format);
+        }
+        return width * 4;
+    }
+
+    uint64 GetTextureMipSize(CookedTextureFormat format, uint32 width, uint32 height)
+    {
+        const uint32 rowCount = IsBlockCompressed(format) ? std::max(1u, (height + 3) / 4) : height;
+        return static_cast<uint64>(GetTextureRowPitch(format, width)) * rowCount;
+    }
+
+    std::string TextureCooker::GetCookedPath(const std::string& sourcePath)
+    {
+        return sourcePath + COOKED_TEXTURE_EXTENSION;
+    }
+
+    bool TextureCooker::IsCookable(const std::string& sourcePath)
+    {
+        std::string extension = std::filesystem::path(sourcePath).extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp";
+    }
+
+    TextureUsage TextureCooker::GetUsageFromName(const std::string& sourcePath)
+    {
+        const std::string name = GetLowerFileName(sourcePath);
+        if (name.find("normal") != std::string::npos)
+        {
+            return TextureUsage::Normal;
+        }
+
+        constexpr const char* MASK_NAMES[] = { "rough", "metal", "gloss", "spec", "occlusion", "height" };
+        for (const char* mask : MASK_NAMES)
+        {
+            if (name.find(mask) != std::string::npos)
+            {
+                return TextureUsage::Mask;
+            }
+        }
+
+        // "ao" only as a word of its own, e.g. ao.png or bricks_ao.png.
+        size_t start = 0;
+        while (start < name.size())
+        {
+            size_t end = start;
+            while (end < name.size() && std::isalnum(static_cast<unsigned char>(name[end])))
+            {
+                ++end;
+            }
+            if (name.compare(start, end - start, "ao") == 0)
+            {
+                return TextureUsage::Mask;
+            }
+            start = end + 1;
+        }
+
+        return TextureUsage::Color;
+    }
+
+    std::string TextureCooker::ResolveRuntimePath(const std::string& sourcePath)
+    {
+        const std::string cookedPath = GetCookedPath(sourcePath);
+
+        std::error_code error;
+        const auto cookedTime = std::filesystem::last_write_time(cookedPath, error);
+        if (error)
+        {
+            return sourcePath;
+        }
+
+        const auto sourceTime = std::filesystem::last_write_time(sourcePath, error);
+        if (error || cookedTime >= sourceTime)
+        {
+            return cookedPath;
+        }
+
+        return sourcePath;
+    }
+
+    bool TextureCooker::Decode(const std::string& sourcePath, TextureImage& image)
+    {
+        int32 width = 0;
+        int32 height = 0;
+        int32 channels = 0;
+        stbi_uc* pixels = stbi_load(sourcePath.c_str(), &width, &height, &channels, 4);
+        if (!pixels)
+        {
+            return false;
+        }
+
+        image.width = static_cast<uint32>(width);
+        image.height = static_cast<uint32>(height);
+        image.pixels.assign(pixels, pixels + static_cast<size_t>(width) * height * 4);
+        stbi_image_free(pixels);
+        return true;
+    }
+
+    std::vector<TextureImage> TextureCooker::BuildMipChain(TextureImage image)
+    {
+        std::vector<TextureImage> mips;
+        mips.push_back(std::move(image));
+
+        while (mips.back().width > 1 || mips.back().height > 1)
+        {
+            const TextureImage& source = mips.back();
+
+            TextureImage mip;
+            mip.width = std::max(1u, source.width / 2);
+            mip.height = std::max(1u, source.height / 2);
+            mip.pixels.resize(static_cast<size_t>(mip.width) * mip.height * 4);
+
+            for (uint32 y = 0; y < mip.height; ++y)
+            {
+                const uint32 y0 = std::min(y * 2, source.height - 1);
+                const uint32 y1 = std::min(y * 2 + 1, source.height - 1);
+                const uint8* row0 = source.pixels.data() + static_cast<size_t>(y0) * source.width * 4;
+                const uint8* row1 = source.pixels.data() + static_cast<size_t>(y1) * source.width * 4;
+                uint8* out = mip.pixels.data() + static_cast<size_t>(y) * mip.width * 4;
+
+                for (uint32 x = 0; x < mip.width; ++x)
+                {
+                    const uint32 x0 = std::min(x * 2, source.width - 1) * 4;
+                    const uint32 x1 = std::min(x * 2 + 1, source.width - 1) * 4;
+                    for (uint32 c = 0; c < 4; ++c)
+                    {
+                        const uint32 sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+                        out[x * 4 + c] = static_cast<uint8>((sum + 2) / 4);
+                    }
+                }
+            }
+
+            mips.push_back(std::move(mip));
+        }
+
+        return mips;
+    }
+
+    bool TextureCooker::WriteDDS(const std::string& path, const std::vector<TextureImage>& mips, CookedTextureFormat format)
+    {
+        if (mips.empty())
+        {
+            return false;
+        }
+
+        DDSHeader header;
+        const bool isBlockCompressed = IsBlockCompressed(format);
+        header.flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | (isBlockCompressed ? DDSD_LINEARSIZE : DDSD_PITCH);
+        header.width = mips[0].width;
+        header.height = mips[0].height;
+        header.pitchOrLinearSize = isBlockCompressed ? static_cast<uint32>(GetTextureMipSize(format, mips[0].width, mips[0].height)) : GetTextureRowPitch(format, mips[0].width);
+        header.mipMapCount = static_cast<uint32>(mips.size());
+        header.pixelFormat.flags = DDPF_FOURCC;
+        header.pixelFormat.fourCC = DDS_FOURCC_DX10;
+        header.caps = DDSCAPS_TEXTURE | (mips.size() > 1 ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0);
+
+        DDSHeaderDX10 headerDX10;
+        headerDX10.dxgiFormat = static_cast<uint32>(format);
+
+        std::vector<uint8> out;
+        WriteValue(out, DDS_MAGIC);
+        WriteValue(out, header);
+        WriteValue(out, headerDX10);
+        for (const TextureImage& mip : mips)
+        {
+            out.insert(out.end(), mip.pixels.begin(), mip.pixels.end());
+        }
+
+        // Written next to the target and renamed, so the runtime never reads a half written file.
+        const std::string tempPath = path + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size())))
+            {
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+        if (error)
+        {
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool TextureCooker::ReadDDSInfo(const std::string& path, CookedTextureInfo& info)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return file && ReadHeaders(file, info);
+    }
+
+    bool TextureCooker::ReadDDSMips(const std::string& path, uint32 firstMip, std::vector<TextureImage>& mips)
+    {
+        std::ifstream file(path, std::ios::binary);
+        CookedTextureInfo info;
+        if (!file || !ReadHeaders(file, info) || firstMip >= info.mipCount)
+        {
+            return false;
+        }
+
+        uint64 offset = DDS_DATA_OFFSET;
+        for (uint32 mip = 0; mip < firstMip; ++mip)
+        {
+            offset += GetTextureMipSize(info.format, std::max(1u, info.width >> mip), std::max(1u, info.height >> mip));
+        }
+
+        if (!file.seekg(static_cast<std::streamoff>(offset)))
+        {
+            return false;
+        }
+
+        mips.clear();
+        for (uint32 mip = firstMip; mip < info.mipCount; ++mip)
+        {
+            TextureImage& image = mips.emplace_back();
+            image.width = std::max(1u, info.width >> mip);
+            image.height = std::max(1u, info.height >> mip);
+            image.pixels.resize(GetTextureMipSize(info.format, image.width, image.height));
+            if (!file.read(reinterpret_cast<char*>(image.pixels.data()), static_cast<std::streamsize>(image.pixels.size())))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool TextureCooker::Cook(const std::string& sourcePath, const std::string& cookedPath, TextureUsage usage)
+    {
+        TextureImage image;
+        if (!Decode(sourcePath, image))
+        {
+            return false;
+        }
+
+        const CookedTextureFormat format = TextureEncoder::SelectFormat(usage, image);
+        std::vector<TextureImage> mips = BuildMipChain(std::move(image));
+        for (TextureImage& mip : mips)
+        {
+            mip = TextureEncoder::Encode(mip, format);
+        }
+
+        return WriteDDS(cookedPath, mips, format);
+    }
+}
@@ -0,0 +1,767 @@
+#include "data/sge_texture_encoder.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "core/sge_job_system.h"
+
+namespace SGE
+{
+    namespace
+    {
+        constexpr uint32 BLOCK_DIMENSION = 4;
+        constexpr uint32 BLOCK_TEXELS = BLOCK_DIMENSION * BLOCK_DIMENSION;
+        constexpr uint32 REFINE_PASSES = 3;
+        constexpr uint32 POWER_ITERATIONS = 8;
+        constexpr size_t BLOCK_ROW_GRAIN = 4;
+
+        constexpr uint32 BC7_MODE = 6;
+        constexpr uint32 BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+        template<size_t N>
+        using Color = std::array<float, N>;
+
+        // Channels [firstChannel, firstChannel + N) of a block, edge texels repeat for mips smaller than a block.
+        template<size_t N>
+        void LoadBlock(const TextureImage& image, uint32 blockX, uint32 blockY, uint32 firstChannel, Color<N>* texels)
+        {
+            for (uint32 y = 0; y < BLOCK_DIMENSION; ++y)
+            {
+                const uint32 sourceY = std::min(blockY * BLOCK_DIMENSION + y, image.height - 1);
+                for (uint32 x = 0; x < BLOCK_DIMENSION; ++x)
+                {
+                    const uint32 sourceX = std::min(blockX * BLOCK_DIMENSION + x, image.width - 1);
+                    const uint8* texel = image.pixels.data() + (static_cast<size_t>(sourceY) * image.width + sourceX) * 4 + firstChannel;
+                    for (uint32 c = 0; c < N; ++c)
+                    {
+                        texels[y * BLOCK_DIMENSION + x][c] = texel[c];
+                    }
+                }
+            }
+        }
+
+        template<size_t N>
+        float GetDistance(const Color<N>& a, const Color<N>& b)
+        {
+            float distance = 0.0f;
+            for (uint32 c = 0; c < N; ++c)
+            {
+                distance += (a[c] - b[c]) * (a[c] - b[c]);
+            }
+            return distance;
+        }
+
+        // Endpoints at the extremes of the texels along their principal axis.
+        template<size_t N>
+        void FitPrincipalAxis(const Color<N>* texels, Color<N>& low, Color<N>& high)
+        {
+            Color<N> mean = {};
+            for (uint32 i = 0; i < BLOCK_TEXELS; ++i)
+            {
+                for (uint32 c = 0; c < N; ++c)
+                {
+                    mean[c] += texels[i][c] / BLOCK_TEXELS;
+                }
+            }
+
+            float covariance[N][N] = {};
+            for (uint32 i = 0; i < BLOCK_TEXELS; ++i)
+            {
+                for (uint32 a = 0; a < N; ++a)
+                {
+                    for (uint32 b = 0; b < N; ++b)
+                    {
+                        covariance[a][b] += (texels[i][a] - mean[a]) * (texels[i][b] - mean[b]);
+                    }
+                }
+            }
+
+            // Power iteration from the row of the channel that varies most.
+            uint32 widest = 0;
+            for (uint32 c = 1; c < N; ++c)
+            {
+                widest = covariance[c][c] > covariance[widest][widest] ? c : widest;
+            }
+
+            Color<N> axis;
+            for (uint32 c = 0; c < N; ++c)
+            {
+                axis[c] = covariance[widest][c];
+            }
+
+            for (uint32 iteration = 0; iteration < POWER_ITERATIONS; ++iteration)
+            {
+                Color<N> next = {};
+                float largest = 0.0f;
+                for (uint32 a = 0; a < N; ++a)
+                {
+                    for (uint32 b = 0; b < N; ++b)
+                    {
+                        next[a] += covariance[a][b] * axis[b];
+                    }
+                    largest = std::max(largest, std::abs(next[a]));
+                }
+
+                if (largest <= 0.0f)
+                {
+                    break;
+                }
+
+                for (uint32 c = 0; c < N; ++c)
+                {
+                    axis[c] = next[c] / largest;
+                }
+            }
+
+            const float length = std::sqrt(GetDistance(axis, Color<N>{}));
+            if (length <= std::numeric_limits<float>::epsilon())
+            {
+                low = mean;
+                high = mean;
+                return;
+            }
+
+            float minT = std::numeric_limits<float>::max();
+            float maxT = std::numeric_limits<float>::lowest();
+            for (uint32 i = 0; i < BLOCK_TEXELS; ++i)
+            {
+                float t = 0.0f;
+                for (uint32 c = 0; c < N; ++c)
+                {
+                    t += (texels[i][c] - mean[c]) * axis[c] / length;
+                }
+                minT = std::min(minT, t);
+                maxT = std::max(maxT, t);
+            }
+
+            for (uint32 c = 0; c < N; ++c)
+            {
+                low[c] = std::clamp(mean[c] + minT * axis[c] / length, 0.0f, 255.0f);
+                high[c] = std::clamp(mean[c] + maxT * axis[c] / length, 0.0f, 255.0f);
+            }
+        }
+
+        // Least squares endpoints for texels drawn at the given weights between low (0) and high (1).
+        // False if the weights can't tell the endpoints apart, e.g. all on one level.
+        template<size_t N>
+        bool SolveEndpoints(const Color<N>* texels, const float* weights, Color<N>& low, Color<N>& high)
+        {
+            float lowLow = 0.0f;
+            float lowHigh = 0.0f;
+            float highHigh = 0.0f;
+            Color<N> lowTexel = {};
+            Color<N> highTexel = {};
+            for (uint32 i = 0; i < BLOCK_TEXELS; ++i)
+            {
+                const float toHigh = weights[i];
+                const float toLow = 1.0f - toHigh;
+                lowLow += toLow * toLow;
+                lowHigh += toLow * toHigh;
+                highHigh += toHigh * toHigh;
+                for (uint32 c = 0; c < N; ++c)
+                {
+                    lowTexel[c] += toLow * texels[i][c];
+                    highTexel[c] += toHigh * texels[i][c];
+                }
+            }
+
+            const float determinant = lowLow * highHigh - lowHigh * lowHigh;
+            if (std::abs(determinant) < 1e-6f)
+            {
+                return false;
+            }
+
+            for (uint32 c = 0; c < N; ++c)
+            {
+                low[c] = std::clamp((highHigh * lowTexel[c] - lowHigh * highTexel[c]) / determinant, 0.0f, 255.0f);
+                high[c] = std::clamp((lowLow * highTexel[c] - lowHigh * lowTexel[c]) / determinant, 0.0f, 255.0f);
+            }
+            return true;
+        }
+
+        // Endpoints quantize to a palette of LEVELS colors from low to high; Fit keeps the best of a
+        // few rounds of quantize, pick the nearest levels and solve the endpoints for those levels.
+        template<size_t N, typename Endpoints>
+        void FitEndpoints(const Color<N>* texels, Endpoints& best, uint8* bestLevels)
+        {
+            Color<N> low;
+            Color<N> high;
+            FitPrincipalAxis(texels, low, high);
+
+            float bestError = std::numeric_limits<float>::max();
+            for (uint32 pass = 0; pass < REFINE_PASSES; ++pass)
+            {
+                const Endpoints endpoints = Endpoints::Quantize(low, high);
+                Color<N> palette[Endpoints::LEVELS];
+                endpoints.GetPalette(palette);
+
+                uint8 levels[BLOCK_TEXELS];
+                float error = 0.0f;
+                for (uint32 i = 0; i < BLOCK_TEXELS; ++i)
+                {
+                    float nearest = std::numeric_limits<float>::max();
+                    for (uint32 level = 0; level < Endpoints::LEVELS; ++level)
+                    {
+                        const float distance = GetDistance(texels[i], palette[level]);
+                        if (distance < nearest)
+                        {
+                            nearest = distance;
+                            levels[i] = static_cast<uint8>(level);
+                        }
+                    }
+                    error += nearest;
+                }
+
+                if (error < bestError)
+                {
+                    bestError = error;
+                    best = endpoints;
+                    std::copy_n(levels, BLOCK_TEXELS, bestLevels);
+                }
+
+                float weights[BLOCK_TEXELS];
+                for (uint32 i = 0; i < BLOCK_TEXELS; ++i)
+                {
+                    weights[i] = Endpoints::GetWeight(levels[i]);
+                }
+
+                if (bestError == 0.0f || !SolveEndpoints(texels, weights, low, high))
+                {
+                    break;
+                }
+            }
+        }
+
+        uint16 PackColor565(const Color<3>& color)
+        {
+            const uint32 r = static_cast<uint32>(std::lround(color[0] * 31.0f / 255.0f));
+            const uint32 g = static_cast<uint32>(std::lround(color[1] * 63.0f / 255.0f));
+            const uint32 b = static_cast<uint32>(std::lround(color[2] * 31.0f / 255.0f));
+            return static_cast<uint16>((r << 11) | (g << 5) | b);
+        }
+
+        std::array<uint32, 3> UnpackColor565(uint16 color)
+        {
+            const uint32 r = (color >> 11) & 31;
+            const uint32 g = (color >> 5) & 63;
+            const uint32 b = color & 31;
+            return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+        }
+
+        // Levels 0 and 3 are the endpoints, 1 and 2 the thirds in between, always the four color mode.
+        struct BC1Endpoints
+        {
+            static constexpr uint32 LEVELS = 4;
+            uint16 low = 0;
+            uint16 high = 0;
+
+            static BC1Endpoints Quantize(const Color<3>& low, const Color<3>& high) { return { PackColor565(low), PackColor565(high) }; }
+            static float GetWeight(uint32 level) { return level / 3.0f; }
+
+            void GetPalette(Color<3>* palette) const
+            {
+                const std::array<uint32, 3> a = UnpackColor565(low);
+                const std::array<uint32, 3> b = UnpackColor565(high);
+                for (uint32 c = 0; c < 3; ++c)
+                {
+                    palette[0][c] = static_cast<float>(a[c]);
+                    palette[1][c] = static_cast<float>((2 * a[c] + b[c] + 1) / 3);
+                    palette[2][c] = static_cast<float>((a[c] + 2 * b[c] + 1) / 3);
+                    palette[3][c] = static_cast<float>(b[c]);
+                }
+            }
+        };
+
+        // Levels 0 and 7 are the endpoints, the eight value mode.
+        struct BC4Endpoints
+        {
+            static constexpr uint32 LEVELS = 8;
+            uint8 low = 0;
+            uint8 high = 0;
+
+            static BC4Endpoints Quantize(const Color<1>& low, const Color<1>& high)
+            {
+                return { static_cast<uint8>(std::lround(low[0])), static_cast<uint8>(std::lround(high[0])) };
+            }
+            static float GetWeight(uint32 level) { return level / 7.0f; }
+
+            void GetPalette(Color<1>* palette) const
+            {
+                for (uint32 level = 0; level < LEVELS; ++level)
+                {
+                    palette[level][0] = static_cast<float>(((7 - level) * low + level * high + 3) / 7);
+                }
+            }
+        };
+
+        // Seven bits a channel and a shared lowest bit per endpoint, 16 levels.
+        struct BC7Mode6Endpoints
+        {
+            static constexpr uint32 LEVELS = 16;
+            uint8 values[2][4] = {};
+            uint8 pBits[2] = {};
+
+            static void QuantizeEndpoint(const Color<4>& color, uint8* values, uint8& pBit)
+            {
+                float bestError = std::numeric_limits<float>::max();
+                for (uint8 p = 0; p < 2; ++p)
+                {
+                    uint8 candidate[4];
+                    float error = 0.0f;
+                    for (uint32 c = 0; c < 4; ++c)
+                    {
+                        candidate[c] = static_cast<uint8>(std::clamp<long>(std::lround((color[c] - p) / 2.0f), 0, 127));
+                        const float value = static_cast<float>((candidate[c] << 1) | p);
+                        error += (value - color[c]) * (value - color[c]);
+                    }
+
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        pBit = p;
+                        std::copy_n(candidate, 4, values);
+                    }
+                }
+            }
+
+            static BC7Mode6Endpoints Quantize(const Color<4>& low, const Color<4>& high)
+            {
+                BC7Mode6Endpoints endpoints;
+                QuantizeEndpoint(low, endpoints.values[0], endpoints.pBits[0]);
+                QuantizeEndpoint(high, endpoints.values[1], endpoints.pBits[1]);
+                return endpoints;
+            }
+            static float GetWeight(uint32 level) { return BC7_WEIGHTS[level] / 64.0f; }
+
+            void GetPalette(Color<4>* palette) const
+            {
+                for (uint32 c = 0; c < 4; ++c)
+                {
+                    const uint32 a = (values[0][c] << 1) | pBits[0];
+                    const uint32 b = (values[1][c] << 1) | pBits[1];
+                    for (uint32 level = 0; level < LEVELS; ++level)
+                    {
+                        palette[level][c] = static_cast<float>(((64 - BC7_WEIGHTS[level]) * a + BC7_WEIGHTS[level] * b + 32) >> 6);
+                    }
+                }
+            }
+        };
+
+        class BitWriter
+        {
+        public:
+            explicit BitWriter(uint8* out) : m_out(out) {}
+
+            void Write(uint32 value, uint32 bitCount)
+            {
+                for (uint32 i = 0; i < bitCount; ++i, ++m_position)
+                {
+                    m_out[m_position >> 3] |= static_cast<uint8>(((value >> i) & 1) << (m_position & 7));
+                }
+            }
+
+        private:
+            uint8* m_out;
+            uint32 m_position = 0;
+        };
+
+        class BitReader
+        {
+        public:
+            explicit BitReader(const uint8* in) : m_in(in) {}
+
+            uint32 Read(uint32 bitCount)
+            {
+                uint32 value = 0;
+                for (uint32 i = 0; i < bitCount; ++i, ++m_position)
+                {
+                    value |= ((m_in[m_position >> 3] >> (m_position & 7)) & 1u) << i;
+                }
+                return value;
+            }
+
+        private:
+            const uint8* m_in;
+            uint32 m_position = 0;
+        };
+
+        void EncodeBC1Block(const Color<3>* texels, uint8* out)
+        {
+            BC1Endpoints endpoints;
+            uint8 levels[BLOCK_TEXELS];
+            FitEndpoints(texels, endpoints, levels);
+
+            // The larger color comes first for the four color mode, equal colors draw index 0 only.
+            constexpr uint32 LOW_FIRST[4] = { 0, 2, 3, 1 };
+            constexpr uint32 HIGH_FIRST[4] = { 1, 3, 2, 0 };
+            const bool isLowFirst = endpoints.low >= endpoints.high;
+            const uint16 color0 = isLowFirst ? endpoints.low : endpoints.high;
+            const uint16 color1 = isLowFirst ? endpoints.high : endpoints.low;
+
+            uint32 indices = 0;
+            for (uint32 i = 0; i < BLOCK_TEXELS && color0 != color1; ++i)
+            {
+                indices |= (isLowFirst ? LOW_FIRST[levels[i]] : HIGH_FIRST[levels[i]]) << (2 * i);
+            }
+
+            std::memcpy(out, &color0, 2);
+            std::memcpy(out + 2, &color1, 2);
+            std::memcpy(out + 4, &indices, 4);
+        }
+
+        void EncodeBC4Block(const Color<1>* texels, uint8* out)
+        {
+            BC4Endpoints endpoints;
+            uint8 levels[BLOCK_TEXELS];
+            FitEndpoints(texels, endpoints, levels);
+
+            // The larger value comes first for the eight value mode, equal values draw index 0 only.
+            const bool isLowFirst = endpoints.low >= endpoints.high;
+            uint64 indices = 0;
+            for (uint32 i = 0; i < BLOCK_TEXELS && endpoints.low != endpoints.high; ++i)
+            {
+                const uint32 level = isLowFirst ? levels[i] : 7 - levels[i];
+                const uint64 index = level == 0 ? 0 : level == 7 ? 1 : level + 1;
+                indices |= index << (3 * i);
+            }
+
+            out[0] = isLowFirst ? endpoints.low : endpoints.high;
+            out[1] = isLowFirst ? endpoints.high : endpoints.low;
+            for (uint32 i = 0; i < 6; ++i)
+            {
+                out[2 + i] = static_cast<uint8>(indices >> (8 * i));
+            }
+        }
+
+        void EncodeBC7Block(const Color<4>* texels, uint8* out)
+        {
+            BC7Mode6Endpoints endpoints;
+            uint8 levels[BLOCK_TEXELS];
+            FitEndpoints(texels, endpoints, levels);
+
+            // The first index has an implied top bit of zero, the endpoints swap if it would be set.
+            if (levels[0] >= 8)
+            {
+                std::swap(endpoints.values[0], endpoints.values[1]);
+                std::swap(endpoints.pBits[0], endpoints.pBits[1]);
+                for (uint8& level : levels)
+                {
+                    level = static_cast<uint8>(15 - level);
+                }
+            }
+
+            std::fill_n(out, 16, uint8(0));
+            BitWriter writer(out);
+            writer.Write(1u << BC7_MODE, BC7_MODE + 1);
+            for (uint32 c = 0; c < 4; ++c)
+            {
+                writer.Write(endpoints.values[0][c], 7);
+                writer.Write(endpoints.values[1][c], 7);
+            }
+            writer.Write(endpoints.pBits[0], 1);
+            writer.Write(endpoints.pBits[1], 1);
+            for (uint32 i = 0; i < BLOCK_TEXELS; ++i)
+            {
+                writer.Write(levels[i], i == 0 ? 3 : 4);
+            }
+        }
+
+        void DecodeBC1Block(const uint8* in, uint8 (*texels)[4])
+        {
+            uint16 color0 = 0;
+            uint16 color1 = 0;
+            uint32 indices = 0;
+            std::memcpy(&color0, in, 2);
+            std::memcpy(&color1, in + 2, 2);
+            std::memcpy(&indices, in + 4, 4);
+
+            const std::array<uint32, 3> a = UnpackColor565(color0);
+            const std::array<uint32, 3> b = UnpackColor565(color1);
+            uint8 palette[4][4];
+            for (uint32 c = 0; c < 3; ++c)
+            {
+                palette[0][c] = static_cast<uint8>(a[c]);
+                palette[1][c] = static_cast<uint8>(b[c]);
+                palette[2][c] = static_cast<uint8>(color0 > color1 ? (2 * a[c] + b[c] + 1) / 3 : (a[c] + b[c]) / 2);
+                palette[3][c] = static_cast<uint8>(color0 > color1 ? (a[c] + 2 * b[c] + 1) / 3 : 0);
+            }
+            palette[0][3] = palette[1][3] = palette[2][3] = 255;
+            palette[3][3] = color0 > color1 ? 255 : 0;
+
+            for (uint32 i = 0; i < BLOCK_TEXELS; ++i)
+            {
+                std::copy_n(palette[(indices >> (2 * i)) & 3], 4, texels[i]);
+            }
+        }
+
+        void DecodeBC4Block(const uint8* in, uint8 (*texels)[4], uint32 channel)
+        {
+            const uint32 a = in[0];
+            const uint32 b = in[1];
+            uint8 palette[8] = { static_cast<uint8>(a), static_cast<uint8>(b) };
+            if (a > b)
+            {
+                for (uint32 i = 2; i < 8; ++i)
+                {
+                    palette[i] = static_cast<uint8>(((8 - i) * a + (i - 1) * b + 3) / 7);
+                }
+            }
+            else
+            {
+                for (uint32 i = 2; i < 6; ++i)
+                {
+                    palette[i] = static_cast<uint8>(((6 - i) * a + (i - 1) * b + 2) / 5);
+                }
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+
+            uint64 indices = 0;
+            for (uint32 i = 0; i < 6; ++i)
+            {
+                indices |= static_cast<uint64>(in[2 + i]) << (8 * i);
+            }
+
+            for (uint32 i = 0; i < BLOCK_TEXELS; ++i)
+            {
+                texels[i][channel] = palette[(indices >> (3 * i)) & 7];
+            }
+        }
+
+        void DecodeBC7Block(const uint8* in, uint8 (*texels)[4])
+        {
+            BitReader reader(in);
+            if (reader.Read(BC7_MODE + 1) != (1u << BC7_MODE))
+            {
+                std::fill_n(&texels[0][0], BLOCK_TEXELS * 4, uint8(0));
+                return;
+            }
+
+            uint32 endpoints[2][4];
+            for (uint32 c = 0; c < 4; ++c)
+            {
+                endpoints[0][c] = reader.Read(7) << 1;
+                endpoints[1][c] = reader.Read(7) << 1;
+            }
+            const uint32 p0 = reader.Read(1);
+            const uint32 p1 = reader.Read(1);
+
+            for (uint32 i = 0; i < BLOCK_TEXELS; ++i)
+            {
+                const uint32 weight = BC7_WEIGHTS[reader.Read(i == 0 ? 3 : 4)];
+                for (uint32 c = 0; c < 4; ++c)
+                {
+                    texels[i][c] = static_cast<uint8>(((64 - weight) * (endpoints[0][c] | p0) + weight * (endpoints[1][c] | p1) + 32) >> 6);
+                }
+            }
+        }
+
+        void EncodeBlock(const TextureImage& image, CookedTextureFormat format, uint32 blockX, uint32 blockY, uint8* out)
+        {
+            Color<4> rgba[BLOCK_TEXELS];
+            Color<3> rgb[BLOCK_TEXELS];
+            Color<1> channel[BLOCK_TEXELS];
+
+            switch (format)
+            {
+            case CookedTextureFormat::BC1:
+                LoadBlock(image, blockX, blockY, 0, rgb);
+                EncodeBC1Block(rgb, out);
+                break;
+            case CookedTextureFormat::BC3:
+                LoadBlock(image, blockX, blockY, 3, channel);
+                EncodeBC4Block(channel, out);
+                LoadBlock(image, blockX, blockY, 0, rgb);
+                EncodeBC1Block(rgb, out + 8);
+                break;
+            case CookedTextureFormat::BC4:
+                LoadBlock(image, blockX, blockY, 0, channel);
+                EncodeBC4Block(channel, out);
+                break;
+            case CookedTextureFormat::BC5:
+                LoadBlock(image, blockX, blockY, 0, channel);
+                EncodeBC4Block(channel, out);
+                LoadBlock(image, blockX, blockY, 1, channel);
+                EncodeBC4Block(channel, out + 8);
+                break;
+            case CookedTextureFormat::BC7:
+                LoadBlock(image, blockX, blockY, 0, rgba);
+                EncodeBC7Block(rgba, out);
+                break;
+            default:
+                break;
+            }
+        }
+
+        void DecodeBlock(const uint8* in, CookedTextureFormat format, uint8 (*texels)[4])
+        {
+            for (uint32 i = 0; i < BLOCK_TEXELS; ++i)
+            {
+                texels[i][0] = texels[i][1] = texels[i][2] = 0;
+                texels[i][3] = 255;
+            }
+
+            switch (format)
+            {
+            case CookedTextureFormat::BC1:
+                DecodeBC1Block(in, texels);
+                break;
+            case CookedTextureFormat::BC3:
+                DecodeBC1Block(in + 8, texels);
+                DecodeBC4Block(in, texels, 3);
+                break;
+            case CookedTextureFormat::BC4:
+                DecodeBC4Block(in, texels, 0);
+                break;
+            case CookedTextureFormat::BC5:
+                DecodeBC4Block(in, texels, 0);
+                DecodeBC4Block(in + 8, texels, 1);
+                break;
+            case CookedTextureFormat::BC7:
+                DecodeBC7Block(in, texels);
+                break;
+            default:
+                break;
+            }
+        }
+
+        bool IsPowerOfTwo(uint32 value)
+        {
+            return value != 0 && (value & (value - 1)) == 0;
+        }
+    }
+
+    uint32 TextureEncoder::GetBlockSize(CookedTextureFormat format)
+    {
+        switch (format)
+        {
+        case CookedTextureFormat::BC1:
+        case CookedTextureFormat::BC4:
+            return 8;
+        case CookedTextureFormat::BC3:
+        case CookedTextureFormat::BC5:
+        case CookedTextureFormat::BC7:
+            return 16;
+        default:
+            return 0;
+        }
+    }
+
+    CookedTextureFormat TextureEncoder::SelectFormat(TextureUsage usage, const TextureImage& image)
+    {
+        if (!IsPowerOfTwo(image.width) || !IsPowerOfTwo(image.height) || std::min(image.width, image.height) < BLOCK_DIMENSION)
+        {
+            return CookedTextureFormat::RGBA8;
+        }
+
+        switch (usage)
+        {
+        case TextureUsage::CompactColor:
+        {
+            bool isOpaque = true;
+            for (size_t i = 3; i < image.pixels.size() && isOpaque; i += 4)
+            {
+                isOpaque = image.pixels[i] == 255;
+            }
+            return isOpaque ? CookedTextureFormat::BC1 : CookedTextureFormat::BC3;
+        }
+        case TextureUsage::Normal:
+            return CookedTextureFormat::BC5;
+        case TextureUsage::Mask:
+            return CookedTextureFormat::BC4;
+        default:
+            return CookedTextureFormat::BC7;
+        }
+    }
+
+    TextureImage TextureEncoder::Encode(const TextureImage& image, CookedTextureFormat format)
+    {
+        if (!IsBlockCompressed(format))
+        {
+            return image;
+        }
+
+        TextureImage encoded;
+        encoded.width = image.width;
+        encoded.height = image.height;
+        encoded.pixels.resize(GetTextureMipSize(format, image.width, image.height));
+
+        const uint32 blockSize = GetBlockSize(format);
+        const uint32 rowPitch = GetTextureRowPitch(format, image.width);
+        const uint32 blocksX = rowPitch / blockSize;
+        const uint32 blocksY = (image.height + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+
+        JobSystem::Get().ParallelFor(blocksY, [&](size_t begin, size_t end)
+        {
+            for (size_t blockY = begin; blockY < end; ++blockY)
+            {
+                uint8* row = encoded.pixels.data() + blockY * rowPitch;
+                for (uint32 blockX = 0; blockX < blocksX; ++blockX)
+                {
+                    EncodeBlock(image, format, blockX, static_cast<uint32>(blockY), row + blockX * blockSize);
+                }
+            }
+        }, BLOCK_ROW_GRAIN);
+
+        return encoded;
+    }
+
+    TextureImage TextureEncoder::Decode(const TextureImage& image, CookedTextureFormat format)
+    {
+        if (!IsBlockCompressed(format))
+        {
+            return image;
+        }
+
+        TextureImage decoded;
+        decoded.width = image.width;
+        decoded.height = image.height;
+        decoded.pixels.resize(static_cast<size_t>(image.width) * image.height * 4);
+
+        const uint32 blockSize = GetBlockSize(format);
+        const uint32 rowPitch = GetTextureRowPitch(format, image.width);
+        for (uint32 blockY = 0; blockY * BLOCK_DIMENSION < image.height; ++blockY)
+        {
+            for (uint32 blockX = 0; blockX * BLOCK_DIMENSION < image.width; ++blockX)
+            {
+                uint8 texels[BLOCK_TEXELS][4];
+                DecodeBlock(image.pixels.data() + static_cast<size_t>(blockY) * rowPitch + blockX * blockSize, format, texels);
+
+                for (uint32 y = 0; y < BLOCK_DIMENSION && blockY * BLOCK_DIMENSION + y < image.height; ++y)
+                {
+                    for (uint32 x = 0; x < BLOCK_DIMENSION && blockX * BLOCK_DIMENSION + x < image.width; ++x)
+                    {
+                        const size_t offset = (static_cast<size_t>(blockY * BLOCK_DIMENSION + y) * image.width + blockX * BLOCK_DIMENSION + x) * 4;
+                        std::copy_n(texels[y * BLOCK_DIMENSION + x], 4, decoded.pixels.data() + offset);
+                    }
+                }
+            }
+        }
+
+        return decoded;
+    }
+
+    double TextureEncoder::ComputePSNR(const TextureImage& reference, const TextureImage& image, uint32 channelCount)
+    {
+        double squaredError = 0.0;
+        const size_t texelCount = std::min(reference.pixels.size(), image.pixels.size()) / 4;
+        for (size_t i = 0; i < texelCount; ++i)
+        {
+            for (uint32 c = 0; c < channelCount; ++c)
+            {
+                const double difference = static_cast<double>(reference.pixels[i * 4 + c]) - image.pixels[i * 4 + c];
+                squaredError += difference * difference;
+            }
+        }
+
+        if (squaredError == 0.0)
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        const double meanSquaredError = squaredError / (static_cast<double>(texelCount) * channelCount);
+        return 10.0 * std::log10(255.0 * 255.0 / meanSquaredError);
+    }
+}
@@ -3,13 +3,58 @@
 #include <filesystem>
 #include "core/sge_device.h"
 #include "core/sge_descriptor_heap.h"
+#include "data/sge_texture_cooker.h"
 
 namespace SGE
 {
+    namespace
+    {
+        class DecodedTextureMips : public DecodedAsset
+        {
+        public:
+            std::vector<TextureImage> mips;
+        };
+
+        // Streamed textures are found by their descriptor index.
+        class TextureStreamingDevice : public TextureStreamingBackend
+        {
+        public:
+            std::unique_ptr<DecodedAsset> LoadMips(const StreamedTextureDesc& desc, uint32 firstMip) override
+            {
+                auto decoded = std::make_unique<DecodedTextureMips>();
+                if (!TextureCooker::ReadDDSMips(desc.path, firstMip, decoded->mips))
+                {
+                    return nullptr;
+                }
+                return decoded;
+            }
+
+            void UploadMips(const StreamedTextureDesc& desc, uint32, DecodedAsset& mips) override
+            {
+                const DecodedTextureMips& decoded = static_cast<DecodedTextureMips&>(mips);
+                textures[desc.resourceIndex]->Initialize(decoded.mips, desc.format, device, descriptorHeap, desc.resourceIndex);
+            }
+
+            void EvictMips(const StreamedTextureDesc& desc, uint32 firstMip) override
+            {
+                Texture* texture = textures[desc.resourceIndex];
+                texture->DropMips(texture->GetMipCount() - (desc.mipCount - firstMip), device, descriptorHeap);
+            }
+
+            const Device* device = nullptr;
+            const DescriptorHeap* descriptorHeap = nullptr;
+            std::unordered_map<uint32, Texture*> textures;
+        };
+
+        TextureStreamingDevice streamingDevice;
+    }
+
     std::unordered_map<std::string, TextureManager::TextureData> TextureManager::m_textureCache;
     std::unordered_map<std::string, TextureManager::CubemapData> TextureManager::m_cubemapCache;
     std::unordered_map<TextureType, std::unique_ptr<Texture>> TextureManager::m_defaultTextures;
-    uint32 TextureManager::m_currentTextureIndex = TEXTURES_START_HEAP_INDEX;
+    std::unordered_map<uint32, StreamedTextureId> TextureManager::m_streamedTextures;
+    TextureStreamer TextureManager::m_streamer;
+    DescriptorAllocator TextureManager::m_descriptorAllocator;
     bool TextureManager::hasDefaultTextures = false;
 
     uint32 TextureManager::GetTextureIndex(const std::string& texturePath, TextureType type, const Device* device, const DescriptorHeap* descriptorHeap)
@@ -20,7 +65,7 @@ namespace SGE
             return it->second.descriptorIndex;
         }
 
-        if (texturePath == "" || !std::filesystem::exists(texturePath))
+        if (texturePath == "" || !std::filesystem::exists(TextureCooker::ResolveRuntimePath(texturePath)))
         {
             if (!hasDefaultTextures)
             {
@@ -30,22 +75,116 @@ namespace SGE
             return m_defaultTextures[type]->GetDescriptorIndex();
         }
 
-        if (m_currentTextureIndex >= CBV_SRV_HEAP_CAPACITY)
+        auto texture = std::make_unique<Texture>();
+        uint32 descriptorIndex = AllocateDescriptorIndex();
+
+        if (!RegisterStreamedTexture(texturePath, texture.get(), descriptorIndex, device, descriptorHeap))
         {
-            throw std::runtime_error("TextureManager: Descriptor heap capacity exceeded!");
+            texture->Initialize(texturePath, device, descriptorHeap, descriptorIndex);
+        }
+
+        m_textureCache[texturePath] = { std::move(texture), descriptorIndex };
+
+        return descriptorIndex;
+    }
+
+    bool TextureManager::RegisterStreamedTexture(const std::string& texturePath, Texture* texture, uint32 descriptorIndex, const Device* device, const DescriptorHeap* descriptorHeap)
+    {
+        // Only the layout sge_cook writes can be read a few mips at a time.
+        const std::string runtimePath = TextureCooker::ResolveRuntimePath(texturePath);
+        CookedTextureInfo info;
+        if (!TextureCooker::ReadDDSInfo(runtimePath, info))
+        {
+            return false;
+        }
+
+        if (streamingDevice.device == nullptr)
+        {
+            m_streamer.Initialize(&streamingDevice);
+        }
+        streamingDevice.device = device;
+        streamingDevice.descriptorHeap = descriptorHeap;
+        streamingDevice.textures[descriptorIndex] = texture;
+
+        StreamedTextureDesc desc;
+        desc.path = runtimePath;
+        desc.width = info.width;
+        desc.height = info.height;
+        desc.mipCount = info.mipCount;
+        desc.format = info.format;
+        desc.resourceIndex = descriptorIndex;
+
+        const StreamedTextureId id = m_streamer.Register(desc);
+        if (id == INVALID_STREAMED_TEXTURE)
+        {
+            streamingDevice.textures.erase(descriptorIndex);
+            return false;
+        }
+
+        m_streamedTextures[descriptorIndex] = id;
+        return true;
+    }
+
+    void TextureManager::UpdateStreaming()
+    {
+        // The renderer waited for the last frame, nothing reads the replaced resources anymore.
+        for (const auto& [descriptorIndex, texture] : streamingDevice.textures)
+        {
+            texture->ReleaseRetiredResources();
+        }
+
+        m_streamer.Update();
+    }
+
+    void TextureManager::RequestScreenSize(uint32 descriptorIndex, float pixels)
+    {
+        auto it = m_streamedTextures.find(descriptorIndex);
+        if (it != m_streamedTextures.end())
+        {
+            m_streamer.RequestScreenSize(it->second, pixels);
+        }
+    }
+
+    void TextureManager::SetStreamingBudget(uint64 bytes)
+    {
+        m_streamer.SetMemoryBudget(bytes);
+    }
+
+    TextureResidencyStats TextureManager::GetStreamingStats()
+    {
+        return m_streamer.GetStats();
+    }
+
+    void TextureManager::ShutdownStreaming()
+    {
+        m_streamer.Shutdown();
+        m_streamedTextures.clear();
+        streamingDevice = {};
+    }
+
+    uint32 TextureManager::AddTexture(const std::string& texturePath, const DirectX::ScratchImage& image, const Device* device, const DescriptorHeap* descriptorHeap)
+    {
+        auto it = m_textureCache.find(texturePath);
+        if (it != m_textureCache.end())
+        {
+            return it->second.descriptorIndex;
         }
 
         auto texture = std::make_unique<Texture>();
-        uint32 descriptorIndex = m_currentTextureIndex;
+        uint32 descriptorIndex = AllocateDescriptorIndex();
 
-        texture->Initialize(texturePath, device, descriptorHeap, descriptorIndex);
+        texture->Initialize(image, device, descriptorHeap, descriptorIndex);
 
         m_textureCache[texturePath] = { std::move(texture), descriptorIndex };
-        m_currentTextureIndex++;
 
         return descriptorIndex;
     }
 
+    bool TextureManager::HasTexture(const std::string& texturePath)
+    {
+        return m_textureCache.find(texturePath) != m_textureCache.end();
+    }
+
     uint32 TextureManager::GetCubemapIndex(const CubemapAssetData& cubemapData, const Device* device, const DescriptorHeap* descriptorHeap)
     {
         std::string cubemapKey = cubemapData.right + cubemapData.left + cubemapData.top + cubemapData.bottom + cubemapData.front + cubemapData.back;
@@ -56,18 +195,12 @@ namespace SGE
             return it->second.descriptorIndex;
         }
 
-        if (m_currentTextureIndex >= CBV_SRV_HEAP_CAPACITY)
-        {
-            throw std::runtime_error("TextureManager: Descriptor heap capacity exceeded!");
-        }
-
         auto cubemap = std::make_unique<CubemapTexture>();
-        uint32 descriptorIndex = m_currentTextureIndex;
+        uint32 descriptorIndex = AllocateDescriptorIndex();
 
         cubemap->Initialize(cubemapData, device, descriptorHeap, descriptorIndex);
 
         m_cubemapCache[cubemapKey] = { std::move(cubemap), descriptorIndex };
-        m_currentTextureIndex++;
 
         return descriptorIndex;
     }
@@ -75,20 +208,36 @@ namespace SGE
     void TextureManager::CreateDefaultTextures(const Device* device, const DescriptorHeap* descriptorHeap)
     {
         m_defaultTextures[TextureType::Albedo] = std::make_unique<Texture>();
-        m_defaultTextures[TextureType::Albedo]->CreateDefaultAlbedo(device, descriptorHeap, m_currentTextureIndex++);
+        m_defaultTextures[TextureType::Albedo]->CreateDefaultAlbedo(device, descriptorHeap, AllocateDescriptorIndex());
 
         m_defaultTextures[TextureType::Metallic] = std::make_unique<Texture>();
-        m_defaultTextures[TextureType::Metallic]->CreateDefaultMetallic(device, descriptorHeap, m_currentTextureIndex++);
+        m_defaultTextures[TextureType::Metallic]->CreateDefaultMetallic(device, descriptorHeap, AllocateDescriptorIndex());
 
         m_defaultTextures[TextureType::Roughness] = std::make_unique<Texture>();
-        m_defaultTextures[TextureType::Roughness]->CreateDefaultRoughness(device, descriptorHeap, m_currentTextureIndex++);
+        m_defaultTextures[TextureType::Roughness]->CreateDefaultRoughness(device, descriptorHeap, AllocateDescriptorIndex());
 
         m_defaultTextures[TextureType::Normal] = std::make_unique<Texture>();
-        m_defaultTextures[TextureType::Normal]->CreateDefaultNormal(device, descriptorHeap, m_currentTextureIndex++);
+        m_defaultTextures[TextureType::Normal]->CreateDefaultNormal(device, descriptorHeap, AllocateDescriptorIndex());
 
         m_defaultTextures[TextureType::Default] = std::make_unique<Texture>();
-        m_defaultTextures[TextureType::Default]->CreateDefaultAlbedo(device, descriptorHeap, m_currentTextureIndex++);
+        m_defaultTextures[TextureType::Default]->CreateDefaultAlbedo(device, descriptorHeap, AllocateDescriptorIndex());
 
         hasDefaultTextures = true;
     }
+
+    uint32 TextureManager::AllocateDescriptorIndex()
+    {
+        if (m_descriptorAllocator.GetCapacity() == 0)
+        {
+            m_descriptorAllocator.Initialize(TEXTURES_START_HEAP_INDEX, BINDLESS_TEXTURE_CAPACITY);
+        }
+
+        const uint32 descriptorIndex = m_descriptorAllocator.Allocate();
+        if (descriptorIndex == INVALID_DESCRIPTOR_INDEX)
+        {
+            throw std::runtime_error("TextureManager: Descriptor heap capacity exceeded!");
+        }
+
+        return descriptorIndex;
+    }
 }
\ No newline at end of file
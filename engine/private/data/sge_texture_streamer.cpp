@@ -0,0 +1,333 @@
+#include "data/sge_texture_streamer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SGE
+{
+    uint32 StreamedTextureDesc::GetTailMip() const
+    {
+        // Block compressed resources need whole blocks in their first mip, so the tail of those
+        // starts before a side drops under four texels.
+        const uint32 minSize = IsBlockCompressed(format) ? 4 : 1;
+        uint32 mip = 0;
+        while (mip + 1 < mipCount && std::max(width >> mip, height >> mip) > TEXTURE_MIP_TAIL_SIZE &&
+               std::min(width >> (mip + 1), height >> (mip + 1)) >= minSize)
+        {
+            ++mip;
+        }
+        return mip;
+    }
+
+    uint64 StreamedTextureDesc::GetMipSize(uint32 mip) const
+    {
+        return GetTextureMipSize(format, std::max(1u, width >> mip), std::max(1u, height >> mip));
+    }
+
+    uint64 StreamedTextureDesc::GetSize(uint32 firstMip, uint32 endMip) const
+    {
+        uint64 size = 0;
+        for (uint32 mip = firstMip; mip < endMip; ++mip)
+        {
+            size += GetMipSize(mip);
+        }
+        return size;
+    }
+
+    TextureStreamer::~TextureStreamer()
+    {
+        Shutdown();
+    }
+
+    void TextureStreamer::Initialize(TextureStreamingBackend* backend, const TextureStreamingSettings& settings)
+    {
+        Shutdown();
+        m_backend = backend;
+        m_settings = settings;
+    }
+
+    void TextureStreamer::Shutdown()
+    {
+        JobSystem::Get().Wait(m_loads);
+        m_completed.clear();
+        m_textures.clear();
+        m_frame = 0;
+        m_residentBytes = 0;
+        m_pendingBytes = 0;
+        m_loadedBytes = 0;
+        m_evictedBytes = 0;
+        m_loadsInFlight = 0;
+    }
+
+    StreamedTextureId TextureStreamer::Register(const StreamedTextureDesc& desc)
+    {
+        TextureState texture;
+        texture.desc = desc;
+        texture.desc.mipCount = std::max(1u, desc.mipCount);
+        texture.tailMip = texture.desc.GetTailMip();
+
+        std::unique_ptr<DecodedAsset> mips;
+        try
+        {
+            mips = m_backend->LoadMips(texture.desc, texture.tailMip);
+        }
+        catch (const std::exception&)
+        {
+            mips.reset();
+        }
+
+        if (!mips)
+        {
+            return INVALID_STREAMED_TEXTURE;
+        }
+
+        const StreamedTextureId id = static_cast<StreamedTextureId>(m_textures.size());
+        m_backend->UploadMips(texture.desc, texture.tailMip, *mips);
+
+        texture.residentMip = texture.tailMip;
+        texture.wantedMip = texture.tailMip;
+        texture.lastUsedFrame = m_frame;
+        const uint64 size = texture.desc.GetSize(texture.tailMip, texture.desc.mipCount);
+        m_residentBytes += size;
+        m_loadedBytes += size;
+
+        m_textures.push_back(std::move(texture));
+        return id;
+    }
+
+    void TextureStreamer::RequestScreenSize(StreamedTextureId id, float pixels)
+    {
+        if (id < m_textures.size())
+        {
+            m_textures[id].demand = std::max(m_textures[id].demand, pixels);
+        }
+    }
+
+    uint32 TextureStreamer::ComputeWantedMip(const StreamedTextureDesc& desc, float pixels)
+    {
+        const uint32 tailMip = desc.GetTailMip();
+        if (!(pixels > 0.0f))
+        {
+            return tailMip;
+        }
+
+        // One texel per pixel, the sampler takes care of the rest.
+        const float ratio = static_cast<float>(std::max(desc.width, desc.height)) / pixels;
+        if (ratio <= 1.0f)
+        {
+            return 0;
+        }
+
+        return std::min(static_cast<uint32>(std::floor(std::log2(ratio))), tailMip);
+    }
+
+    void TextureStreamer::Update()
+    {
+        ++m_frame;
+        FinishLoads();
+
+        for (TextureState& texture : m_textures)
+        {
+            texture.lastDemand = texture.demand;
+            texture.demand = 0.0f;
+            if (texture.lastDemand > 0.0f)
+            {
+                texture.lastUsedFrame = m_frame;
+            }
+            texture.wantedMip = ComputeWantedMip(texture.desc, texture.lastDemand);
+        }
+
+        // A lowered budget is settled before anything new is loaded.
+        MakeRoom(0, INVALID_STREAMED_TEXTURE);
+
+        std::vector<StreamedTextureId> candidates;
+        for (StreamedTextureId id = 0; id < m_textures.size(); ++id)
+        {
+            const TextureState& texture = m_textures[id];
+            if (texture.isStreamable && !texture.isLoading && texture.wantedMip < texture.residentMip)
+            {
+                candidates.push_back(id);
+            }
+        }
+
+        // The textures missing the most levels first, larger on screen breaks ties.
+        std::sort(candidates.begin(), candidates.end(), [this](StreamedTextureId a, StreamedTextureId b)
+        {
+            const TextureState& first = m_textures[a];
+            const TextureState& second = m_textures[b];
+            const uint32 firstMissing = first.residentMip - first.wantedMip;
+            const uint32 secondMissing = second.residentMip - second.wantedMip;
+            if (firstMissing != secondMissing)
+            {
+                return firstMissing > secondMissing;
+            }
+            if (first.lastDemand != second.lastDemand)
+            {
+                return first.lastDemand > second.lastDemand;
+            }
+            return a < b;
+        });
+
+        for (StreamedTextureId id : candidates)
+        {
+            if (m_loadsInFlight >= m_settings.maxLoadsInFlight)
+            {
+                break;
+            }
+
+            // The finest level that fits, a texture that can't have everything still gets closer.
+            const TextureState& texture = m_textures[id];
+            uint32 firstMip = texture.wantedMip;
+            while (firstMip < texture.residentMip && !MakeRoom(texture.desc.GetSize(firstMip, texture.residentMip), id))
+            {
+                ++firstMip;
+            }
+
+            if (firstMip < texture.residentMip)
+            {
+                StartLoad(id, firstMip);
+            }
+        }
+    }
+
+    TextureResidencyStats TextureStreamer::GetStats() const
+    {
+        TextureResidencyStats stats;
+        stats.textureCount = static_cast<uint32>(m_textures.size());
+        stats.loadsInFlight = m_loadsInFlight;
+        stats.memoryBudget = m_settings.memoryBudget;
+        stats.residentBytes = m_residentBytes;
+        stats.pendingBytes = m_pendingBytes;
+        stats.loadedBytes = m_loadedBytes;
+        stats.evictedBytes = m_evictedBytes;
+
+        for (const TextureState& texture : m_textures)
+        {
+            stats.satisfiedCount += texture.residentMip <= texture.wantedMip;
+            stats.wantedBytes += texture.desc.GetSize(texture.wantedMip, texture.desc.mipCount);
+        }
+
+        return stats;
+    }
+
+    void TextureStreamer::FinishLoads()
+    {
+        std::vector<CompletedLoad> completed;
+        {
+            std::lock_guard<std::mutex> lock(m_completedMutex);
+            completed.swap(m_completed);
+        }
+
+        for (CompletedLoad& load : completed)
+        {
+            TextureState& texture = m_textures[load.id];
+            const uint64 size = texture.desc.GetSize(load.firstMip, texture.residentMip);
+            texture.isLoading = false;
+            m_pendingBytes -= size;
+            --m_loadsInFlight;
+
+            if (!load.mips)
+            {
+                texture.isStreamable = false;
+                continue;
+            }
+
+            m_backend->UploadMips(texture.desc, load.firstMip, *load.mips);
+            texture.residentMip = load.firstMip;
+            m_residentBytes += size;
+            m_loadedBytes += size;
+        }
+    }
+
+    void TextureStreamer::StartLoad(StreamedTextureId id, uint32 firstMip)
+    {
+        TextureState& texture = m_textures[id];
+        texture.isLoading = true;
+        m_pendingBytes += texture.desc.GetSize(firstMip, texture.residentMip);
+        ++m_loadsInFlight;
+
+        // The job gets its own copy of the description, Register may move the texture list.
+        JobSystem::Get().Run([this, id, firstMip, desc = texture.desc]()
+        {
+            std::unique_ptr<DecodedAsset> mips;
+            try
+            {
+                mips = m_backend->LoadMips(desc, firstMip);
+            }
+            catch (const std::exception&)
+            {
+                mips.reset();
+            }
+
+            std::lock_guard<std::mutex> lock(m_completedMutex);
+            m_completed.push_back({ id, firstMip, std::move(mips) });
+        }, &m_loads);
+    }
+
+    bool TextureStreamer::MakeRoom(uint64 bytes, StreamedTextureId requester)
+    {
+        const uint64 used = m_residentBytes + m_pendingBytes + bytes;
+        if (used <= m_settings.memoryBudget)
+        {
+            return true;
+        }
+        uint64 needed = used - m_settings.memoryBudget;
+
+        std::vector<StreamedTextureId> victims;
+        uint64 freeable = 0;
+        for (StreamedTextureId id = 0; id < m_textures.size(); ++id)
+        {
+            const TextureState& texture = m_textures[id];
+            if (id != requester && !texture.isLoading && texture.residentMip < texture.wantedMip)
+            {
+                victims.push_back(id);
+                freeable += texture.desc.GetSize(texture.residentMip, texture.wantedMip);
+            }
+        }
+
+        // A load that can't fit doesn't cost anyone their mips. Settling a lowered budget takes
+        // whatever there is.
+        if (bytes > 0 && freeable < needed)
+        {
+            return false;
+        }
+
+        std::sort(victims.begin(), victims.end(), [this](StreamedTextureId a, StreamedTextureId b)
+        {
+            const uint64 first = m_textures[a].lastUsedFrame;
+            const uint64 second = m_textures[b].lastUsedFrame;
+            return first != second ? first < second : a < b;
+        });
+
+        for (StreamedTextureId id : victims)
+        {
+            if (needed == 0)
+            {
+                break;
+            }
+
+            // Finest levels first, only as many as the request needs.
+            TextureState& texture = m_textures[id];
+            uint32 firstMip = texture.residentMip;
+            uint64 freed = 0;
+            while (firstMip < texture.wantedMip && freed < needed)
+            {
+                freed += texture.desc.GetMipSize(firstMip++);
+            }
+
+            Evict(texture, firstMip);
+            needed -= std::min(freed, needed);
+        }
+
+        return needed == 0;
+    }
+
+    void TextureStreamer::Evict(TextureState& texture, uint32 firstMip)
+    {
+        const uint64 size = texture.desc.GetSize(texture.residentMip, firstMip);
+        m_backend->EvictMips(texture.desc, firstMip);
+        texture.residentMip = firstMip;
+        m_residentBytes -= size;
+        m_evictedBytes += size;
+    }
+}
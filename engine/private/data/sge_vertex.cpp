@@ -0,0 +1,204 @@
+#include "data/sge_vertex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace SGE
+{
+    namespace
+    {
+        constexpr float UNIT_VECTOR_SCALE = 1023.0f;
+        constexpr float UNIT_VECTOR_W_SCALE = 3.0f;
+        constexpr float SKIN_WEIGHT_SCALE = 255.0f;
+
+        uint32 PackUnorm(float value, float scale)
+        {
+            return static_cast<uint32>(std::lround(std::clamp(value, 0.0f, 1.0f) * scale));
+        }
+
+        bool IsInfluence(const Vertex& vertex, size_t i)
+        {
+            return vertex.boneIndices[i] >= 0 && vertex.boneIndices[i] < static_cast<int32>(MAX_SKIN_BONES) && vertex.boneWeights[i] > 0.0f;
+        }
+    }
+
+    // Round to nearest even like the GPU conversion, values past the half range become infinity.
+    uint16 FloatToHalf(float value)
+    {
+        uint32 bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        const uint32 sign = (bits >> 16) & 0x8000;
+        const uint32 magnitude = bits & 0x7FFFFFFF;
+
+        if (magnitude >= 0x7F800000)
+        {
+            return static_cast<uint16>(sign | 0x7C00 | (magnitude > 0x7F800000 ? 0x200 : 0));
+        }
+
+        if (magnitude >= 0x477FF000) // 65520, the first value that rounds past 65504
+        {
+            return static_cast<uint16>(sign | 0x7C00);
+        }
+
+        if (magnitude < 0x38800000) // below 2^-14, the result is denormal
+        {
+            if (magnitude < 0x33000000) // below 2^-25, rounds to zero
+            {
+                return static_cast<uint16>(sign);
+            }
+
+            const uint32 shift = 126 - (magnitude >> 23);
+            const uint32 mantissa = (magnitude & 0x7FFFFF) | 0x800000;
+            const uint32 remainder = mantissa & ((1u << shift) - 1);
+            const uint32 halfway = 1u << (shift - 1);
+            uint32 result = mantissa >> shift;
+            if (remainder > halfway || (remainder == halfway && (result & 1)))
+            {
+                ++result;
+            }
+            return static_cast<uint16>(sign | result);
+        }
+
+        // Rebias the exponent from 127 to 15, a carry out of the mantissa moves into the exponent.
+        uint32 result = (magnitude - 0x38000000) >> 13;
+        const uint32 remainder = magnitude & 0x1FFF;
+        if (remainder > 0x1000 || (remainder == 0x1000 && (result & 1)))
+        {
+            ++result;
+        }
+        return static_cast<uint16>(sign | result);
+    }
+
+    float HalfToFloat(uint16 value)
+    {
+        const uint32 sign = static_cast<uint32>(value & 0x8000) << 16;
+        const uint32 exponent = (value >> 10) & 0x1F;
+        const uint32 mantissa = value & 0x3FF;
+
+        if (exponent == 0)
+        {
+            const float result = std::ldexp(static_cast<float>(mantissa), -24);
+            return sign ? -result : result;
+        }
+
+        const uint32 bits = exponent == 0x1F
+            ? sign | 0x7F800000 | (mantissa << 13)
+            : sign | ((exponent + 112) << 23) | (mantissa << 13);
+
+        float result = 0.0f;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    uint32 PackUnitVector(const float3& vector, float w)
+    {
+        return PackUnorm(vector.x * 0.5f + 0.5f, UNIT_VECTOR_SCALE) |
+               PackUnorm(vector.y * 0.5f + 0.5f, UNIT_VECTOR_SCALE) << 10 |
+               PackUnorm(vector.z * 0.5f + 0.5f, UNIT_VECTOR_SCALE) << 20 |
+               PackUnorm(w, UNIT_VECTOR_W_SCALE) << 30;
+    }
+
+    float3 UnpackUnitVector(uint32 packed)
+    {
+        return float3(
+            static_cast<float>(packed & 0x3FF) / UNIT_VECTOR_SCALE * 2.0f - 1.0f,
+            static_cast<float>((packed >> 10) & 0x3FF) / UNIT_VECTOR_SCALE * 2.0f - 1.0f,
+            static_cast<float>((packed >> 20) & 0x3FF) / UNIT_VECTOR_SCALE * 2.0f - 1.0f);
+    }
+
+    float UnpackUnitVectorW(uint32 packed)
+    {
+        return static_cast<float>(packed >> 30) / UNIT_VECTOR_W_SCALE;
+    }
+
+    PackedVertex PackVertex(const Vertex& vertex)
+    {
+        const bool isMirrored = dot(cross(vertex.normal, vertex.tangent), vertex.bitangent) < 0.0f;
+
+        PackedVertex packed;
+        packed.position = vertex.position;
+        packed.normal = PackUnitVector(vertex.normal, 1.0f);
+        packed.tangent = PackUnitVector(vertex.tangent, isMirrored ? 0.0f : 1.0f);
+        packed.texCoords = FloatToHalf(vertex.texCoords.x) | static_cast<uint32>(FloatToHalf(vertex.texCoords.y)) << 16;
+        return packed;
+    }
+
+    // Weights are renormalized over the influences that fit, the rounding error goes to the largest.
+    SkinVertex PackSkin(const Vertex& vertex)
+    {
+        SkinVertex skin{};
+
+        float total = 0.0f;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            total += IsInfluence(vertex, i) ? vertex.boneWeights[i] : 0.0f;
+        }
+
+        if (total <= 0.0f)
+        {
+            return skin;
+        }
+
+        int32 sum = 0;
+        size_t largest = 0;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            if (!IsInfluence(vertex, i))
+            {
+                continue;
+            }
+
+            const int32 weight = static_cast<int32>(std::lround(vertex.boneWeights[i] / total * SKIN_WEIGHT_SCALE));
+            skin.boneIndices[i] = static_cast<uint8>(vertex.boneIndices[i]);
+            skin.boneWeights[i] = static_cast<uint8>(weight);
+            sum += weight;
+
+            if (skin.boneWeights[i] > skin.boneWeights[largest])
+            {
+                largest = i;
+            }
+        }
+
+        skin.boneWeights[largest] = static_cast<uint8>(skin.boneWeights[largest] + 255 - sum);
+        return skin;
+    }
+
+    bool HasSkin(const Vertex& vertex)
+    {
+        for (size_t i = 0; i < 4; ++i)
+        {
+            if (IsInfluence(vertex, i))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Vertex UnpackVertex(const PackedVertex& packed)
+    {
+        Vertex vertex{};
+        vertex.position = packed.position;
+        vertex.normal = UnpackUnitVector(packed.normal).normalized();
+        vertex.tangent = UnpackUnitVector(packed.tangent).normalized();
+        vertex.bitangent = cross(vertex.normal, vertex.tangent) * (UnpackUnitVectorW(packed.tangent) > 0.5f ? 1.0f : -1.0f);
+        vertex.texCoords = float2(HalfToFloat(static_cast<uint16>(packed.texCoords & 0xFFFF)), HalfToFloat(static_cast<uint16>(packed.texCoords >> 16)));
+
+        for (size_t i = 0; i < 4; ++i)
+        {
+            vertex.boneIndices[i] = -1;
+        }
+        return vertex;
+    }
+
+    void UnpackSkin(const SkinVertex& skin, Vertex& vertex)
+    {
+        for (size_t i = 0; i < 4; ++i)
+        {
+            vertex.boneWeights[i] = static_cast<float>(skin.boneWeights[i]) / SKIN_WEIGHT_SCALE;
+            vertex.boneIndices[i] = skin.boneWeights[i] > 0 ? static_cast<int32>(skin.boneIndices[i]) : -1;
+        }
+    }
+}
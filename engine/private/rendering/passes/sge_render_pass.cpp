@@ -3,6 +3,7 @@
 #include "rendering/sge_render_context.h"
 #include "core/sge_helpers.h"
 #include "data/sge_scene.h"
+#include "data/sge_material_manager.h"
 
 namespace SGE
 {
@@ -136,20 +137,16 @@ namespace SGE
         commandList->DrawInstanced(6, 1, 0, 0);
     }
 
-    void RenderPass::DrawModels(Scene* scene)
+    void RenderPass::DrawModels(Scene* scene, SceneView view, bool useClusterCulling)
     {
         Verify(m_context, "RenderPass::OnDraw: Render context is null.");
         ID3D12GraphicsCommandList* commandList = m_context->GetCommandList().Get();
         commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        MaterialManager::BindTable(commandList, m_context->GetCbvSrvUavHeap());
 
-        for(auto& pair : scene->GetModels())
+        for(const ModelInstance* model : scene->GetVisibleModels(view))
         {
-            pair.second->Render(m_context->GetCommandList().Get());
-        }
-
-        for(auto& pair : scene->GetAnimModels())
-        {
-            pair.second->Render(m_context->GetCommandList().Get());
+            model->Render(commandList, useClusterCulling);
         }
     }
 }
@@ -22,7 +22,7 @@ namespace SGE
 
     void ShadowMapRenderPass::OnDraw(Scene* scene)
     {
-        DrawModels(scene);
+        DrawModels(scene, SceneView::DirectionalLight, false);
     }
     
     PipelineConfig ShadowMapRenderPass::GetPipelineConfig() const
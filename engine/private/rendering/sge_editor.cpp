@@ -196,6 +196,7 @@ namespace SGE
 
         BeginNewFrame();
         SetupDockspace();
+        PickObject();
         
         ConstructEditors();
         ConstructMenuBar();
@@ -347,7 +348,7 @@ namespace SGE
             return;
         }
 
-        constexpr ImVec2 WINDOW_SIZE(280.0f, 80.0f);
+        constexpr ImVec2 WINDOW_SIZE(280.0f, 150.0f);
         ImGui::SetNextWindowSize(WINDOW_SIZE, ImGuiCond_Once);
 
         if (ImGui::Begin("Window settings", &m_isEnableWindowSettings))
@@ -365,6 +366,18 @@ namespace SGE
                 OnResolutionChange();
             }
 
+            const TextureResidencyStats stats = TextureManager::GetStreamingStats();
+            int32 budgetMB = static_cast<int32>(stats.memoryBudget >> 20);
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted("Texture MB:");
+            ImGui::SameLine(LABEL_WIDTH);
+            if (ImGui::DragInt("##TextureBudget", &budgetMB, 1.0f, 16, 4096))
+            {
+                TextureManager::SetStreamingBudget(static_cast<uint64>(budgetMB) << 20);
+            }
+            ImGui::Text("Resident: %.1f / %.1f MB", stats.residentBytes / 1048576.0, stats.wantedBytes / 1048576.0);
+            ImGui::Text("Textures: %u of %u at full demand, %u loading", stats.satisfiedCount, stats.textureCount, stats.loadsInFlight);
+
             ImGui::End();
         }
     }
@@ -383,6 +396,7 @@ namespace SGE
             {
                 ApplyWeightToChildren(bone, skeleton, weight);
             }
+            skeleton.BuildLayerMasks();
         }
         ImGui::SameLine();
         ImGui::Text("%s", label.c_str());
@@ -425,6 +439,10 @@ namespace SGE
                             bone.weights = animatedModelData->boneLayers[boneName];
                         }
                     }
+                    if (!m_initedWeights)
+                    {
+                        skeleton.BuildLayerMasks();
+                    }
                     m_initedWeights = true;
                 }
             }
@@ -433,14 +451,14 @@ namespace SGE
             ImGui::Text("Animations:");
             ImGui::Separator();
 
-            const std::vector<Animation>& animations = m_activeAnimatedModel->GetAnimations();
+            const std::vector<AnimationClip>& animations = m_activeAnimatedModel->GetAnimationClips();
 
             if (m_animationNames.empty() && !animations.empty())
             {
                 m_animationNames.clear();
                 for (const auto& animation : animations)
                 {
-                    m_animationNames.push_back(animation.name);
+                    m_animationNames.push_back(animation.GetName());
                 }
                 m_selectedAnimationIndex = 0;
             }
@@ -518,6 +536,7 @@ namespace SGE
                             Bone& bone = skeleton.GetBone(i);
                             animatedModelData->boneLayers[bone.name] = bone.weights;
                         }
+                        animatedModelData->MarkChanged();
                     }
                 }
             }
@@ -653,26 +672,7 @@ namespace SGE
                     const auto objName = obj->name.empty() ? "empty" : obj->name.c_str();
                     if (ImGui::Selectable(objName, isSelected))
                     {
-                        m_selectedObjectIndex = index;
-                        if(m_selectedObject != obj.get())
-                        {
-                            m_selectedObject = obj.get();
-                            
-                            if(m_selectedObject->type == ObjectType::AnimatedModel && m_activeScene)
-                            {
-                                AnimatedModelData* animatedModel = dynamic_cast<AnimatedModelData*>(m_selectedObject);
-                                if (animatedModel)
-                                {
-                                    m_activeAnimatedModel = m_activeScene->GetAnimModel(animatedModel);
-                                    m_initedWeights = false;
-                                }
-                            }
-                            else
-                            {
-                                m_activeAnimatedModel = nullptr;
-                            }
-                            m_animationNames.clear();
-                        }
+                        SelectObject(obj.get(), static_cast<int32>(index));
                     }
                     
                     ImGui::SameLine();
@@ -692,12 +692,71 @@ namespace SGE
         ImGui::End();
     }
 
+    void Editor::SelectObject(ObjectDataBase* object, int32 index)
+    {
+        m_selectedObjectIndex = index;
+        if(m_selectedObject == object)
+        {
+            return;
+        }
+
+        m_selectedObject = object;
+        if(m_selectedObject->type == ObjectType::AnimatedModel && m_activeScene)
+        {
+            AnimatedModelData* animatedModel = dynamic_cast<AnimatedModelData*>(m_selectedObject);
+            if (animatedModel)
+            {
+                m_activeAnimatedModel = m_activeScene->GetAnimModel(animatedModel);
+                m_initedWeights = false;
+            }
+        }
+        else
+        {
+            m_activeAnimatedModel = nullptr;
+        }
+        m_animationNames.clear();
+    }
+
+    void Editor::PickObject()
+    {
+        // Clicks that land on the scene rather than on a window select the model under the cursor.
+        const ImGuiIO& io = ImGui::GetIO();
+        if (!m_activeScene || io.WantCaptureMouse || !ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+        {
+            return;
+        }
+
+        const float2 screenPosition(io.MousePos.x / io.DisplaySize.x, io.MousePos.y / io.DisplaySize.y);
+        const ObjectDataBase* picked = m_activeScene->PickObject(screenPosition);
+        if (!picked)
+        {
+            return;
+        }
+
+        int32 index = 0;
+        for (const auto& [type, objectList] : m_context->GetSceneData().objects)
+        {
+            for (const auto& obj : objectList)
+            {
+                if (obj.get() == picked)
+                {
+                    SelectObject(obj.get(), index);
+                    return;
+                }
+                ++index;
+            }
+        }
+    }
+
     void Editor::ConstructPropertiesEditor()
     {
         ImGui::Begin("Properties");
         if (m_selectedObject)
         {
-            m_selectedObject->DrawEditor();
+            if (m_selectedObject->DrawEditor())
+            {
+                m_selectedObject->MarkChanged();
+            }
             ConstructAnimationEditor();
         }
         else
@@ -719,7 +778,7 @@ namespace SGE
         ImGui::BeginChild("AssetScrollRegion", ImVec2(0, 0), false, ImGuiWindowFlags_AlwaysVerticalScrollbar);
     
         float availableWidth = ImGui::GetContentRegionAvail().x;
-        int itemsPerRow = max(static_cast<int>(availableWidth / (ITEM_SIZE.x + PADDING)), 1);
+        int itemsPerRow = std::max(static_cast<int>(availableWidth / (ITEM_SIZE.x + PADDING)), 1);
     
         float xOffset = 0.0f;
         float yOffset = 0.0f;
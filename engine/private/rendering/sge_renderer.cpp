@@ -4,6 +4,8 @@
 #include "rendering/passes/sge_render_pass_factory.h"
 #include "core/sge_helpers.h"
 #include "core/sge_scoped_event.h"
+#include "data/sge_material_manager.h"
+#include "data/sge_texture_manager.h"
 
 namespace SGE
 {
@@ -61,6 +63,8 @@ namespace SGE
             m_context->BindDescriptorHeaps();
             m_context->BindViewportScissors();
             m_context->ClearRenderTargets();
+            TextureManager::UpdateStreaming();
+            MaterialManager::UpdateTable(m_context->GetDevice());
         }
 
         const RenderData& data = m_context->GetRenderData();
@@ -102,6 +106,8 @@ namespace SGE
 
     void Renderer::Shutdown()
     {
+        TextureManager::ShutdownStreaming();
+        MaterialManager::Shutdown();
         for (auto& [name, pass] : m_renderPasses)
         {
             pass->Shutdown();
@@ -10,8 +10,8 @@ namespace SGE
     
     void RootSignature::CreateRootSignature(ID3D12Device *device)
     {
-        m_descriptorRanges.resize(8);
-        m_rootParameters.resize(8);
+        m_descriptorRanges.resize(9);
+        m_rootParameters.resize(11);
 
         m_descriptorRanges[0].Init(D3D12_DESCRIPTOR_RANGE_TYPE_CBV, 1, 0, 0, D3D12_DESCRIPTOR_RANGE_FLAG_NONE); // b0
         m_rootParameters[0].InitAsDescriptorTable(1, &m_descriptorRanges[0], D3D12_SHADER_VISIBILITY_ALL);
@@ -37,6 +37,13 @@ namespace SGE
         m_descriptorRanges[7].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 5, 0, D3D12_DESCRIPTOR_RANGE_FLAG_NONE); // t5
         m_rootParameters[7].InitAsDescriptorTable(1, &m_descriptorRanges[7], D3D12_SHADER_VISIBILITY_PIXEL); 
 
+        m_rootParameters[MATERIAL_INDEX_ROOT_PARAMETER].InitAsConstants(1, 2, 0, D3D12_SHADER_VISIBILITY_PIXEL); // b2
+        m_rootParameters[MATERIAL_TABLE_ROOT_PARAMETER].InitAsShaderResourceView(0, 1, D3D12_ROOT_DESCRIPTOR_FLAG_NONE, D3D12_SHADER_VISIBILITY_PIXEL); // t0, space1
+
+        // Streaming rewrites texture descriptors in place between frames.
+        m_descriptorRanges[8].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, BINDLESS_TEXTURE_CAPACITY, 0, 2, D3D12_DESCRIPTOR_RANGE_FLAG_DESCRIPTORS_VOLATILE); // t0, space2
+        m_rootParameters[BINDLESS_TEXTURES_ROOT_PARAMETER].InitAsDescriptorTable(1, &m_descriptorRanges[8], D3D12_SHADER_VISIBILITY_PIXEL);
+
         m_staticSamplers.clear();
         CreateWrapSampler();
         CreateClampSampler();
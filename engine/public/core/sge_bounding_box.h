@@ -0,0 +1,29 @@
+#ifndef _SGE_BOUNDING_BOX_H_
+#define _SGE_BOUNDING_BOX_H_
+
+#include "core/sge_math.h"
+
+namespace SGE
+{
+    struct BoundingBox
+    {
+        float3 boundsMin;
+        float3 boundsMax;
+
+        static BoundingBox Union(const BoundingBox& a, const BoundingBox& b);
+        // The axis aligned box around this one moved by matrix.
+        BoundingBox Transformed(const float4x4& matrix) const;
+
+        float GetSurfaceArea() const;
+        bool Contains(const BoundingBox& other) const;
+        bool Intersects(const BoundingBox& other) const;
+        bool IntersectsSphere(const float3& center, float radius) const;
+        // Distance along the ray to where it enters the box, false when it misses within maxDistance.
+        bool IntersectsRay(const float3& origin, const float3& inverseDirection, float maxDistance, float& distance) const;
+
+        bool operator==(const BoundingBox& other) const;
+        bool operator!=(const BoundingBox& other) const { return !(*this == other); }
+    };
+}
+
+#endif // !_SGE_BOUNDING_BOX_H_
@@ -0,0 +1,103 @@
+#ifndef _SGE_BOUNDING_VOLUME_HIERARCHY_H_
+#define _SGE_BOUNDING_VOLUME_HIERARCHY_H_
+
+#include <vector>
+#include "core/sge_bounding_box.h"
+#include "core/sge_frustum.h"
+#include "core/sge_frustum_culler.h"
+#include "core/sge_span.h"
+#include "core/sge_types.h"
+
+namespace SGE
+{
+    constexpr uint32 INVALID_BVH_NODE = ~0u;
+
+    struct RayHit
+    {
+        uint32 proxy = INVALID_BVH_NODE;
+        float distance = 0.0f;
+    };
+
+    // Binary tree of axis aligned boxes with one object per leaf. Build splits by the surface
+    // area heuristic; Insert, Remove and Update then keep it valid one object at a time, refitting
+    // the path to the root and rotating nodes on it where that shrinks a child.
+    // Objects are named by proxies that stay valid until they're removed. Queries return proxies
+    // in no particular order. They reuse scratch buffers kept in the tree, so a tree is queried
+    // from one thread at a time.
+    class BoundingVolumeHierarchy
+    {
+    public:
+        // Replaces the tree. The object boxes[i] gets proxy i.
+        void Build(Span<const BoundingBox> boxes);
+        void Clear();
+
+        uint32 Insert(const BoundingBox& box);
+        bool Remove(uint32 proxy);
+        // Moves an object. Small moves refit the path to the root, an object that leaves its parent's
+        // box is reinserted where it now fits. Returns false and leaves the tree alone when the box
+        // didn't change.
+        bool Update(uint32 proxy, const BoundingBox& box);
+
+        void QueryBox(const BoundingBox& box, std::vector<uint32>& proxies) const;
+        void QuerySphere(const float3& center, float radius, std::vector<uint32>& proxies) const;
+        // Walks the tree down to the nodes the frustum cuts through, the leaves under them are
+        // then tested together by a FrustumCuller.
+        void QueryFrustum(const Frustum& frustum, std::vector<uint32>& proxies) const;
+        // The closest object whose box the ray enters within maxDistance.
+        bool Raycast(const float3& origin, const float3& direction, float maxDistance, RayHit& hit) const;
+
+        const BoundingBox& GetBox(uint32 proxy) const { return m_nodes[proxy].box; }
+        uint32 GetCount() const { return m_leafCount; }
+        uint32 GetHeight() const;
+        // Summed surface area of the internal nodes over the root's, lower is a better tree.
+        float GetCost() const;
+
+    private:
+        struct Node
+        {
+            BoundingBox box;
+            uint32 parent = INVALID_BVH_NODE;
+            uint32 left = INVALID_BVH_NODE;
+            uint32 right = INVALID_BVH_NODE;
+
+            bool IsLeaf() const { return left == INVALID_BVH_NODE; }
+        };
+
+        // Build partitions these in place so every level reads them in order.
+        struct BuildItem
+        {
+            BoundingBox box;
+            float3 centroid;
+            uint32 leaf = 0;
+        };
+
+        bool IsProxy(uint32 index) const;
+        uint32 AllocateNode();
+        void FreeNode(uint32 index);
+        uint32 BuildRange(BuildItem* items, uint32 count, uint32 parent);
+        // Orders items into the two halves of the cheapest split and returns the first's size.
+        uint32 FindSplit(BuildItem* items, uint32 count) const;
+        uint32 FindBestSibling(const BoundingBox& box) const;
+        void InsertLeaf(uint32 leaf);
+        void RemoveLeaf(uint32 leaf);
+        void ReplaceChild(uint32 parent, uint32 oldChild, uint32 newChild);
+        // Recomputes the boxes from index up to the root, rotating each node on the way.
+        void Refit(uint32 index);
+        void Rotate(uint32 index);
+        void AppendLeaves(uint32 index, std::vector<uint32>& proxies) const;
+        uint32 GetHeight(uint32 index) const;
+
+        std::vector<Node> m_nodes;
+        std::vector<uint32> m_freeNodes;
+        uint32 m_root = INVALID_BVH_NODE;
+        uint32 m_leafCount = 0;
+
+        // Query scratch, kept so per frame queries don't allocate once they've grown.
+        mutable std::vector<uint32> m_queryStack;
+        mutable std::vector<uint32> m_queryCandidates;
+        mutable std::vector<uint32> m_queryVisible;
+        mutable FrustumCuller m_queryCuller;
+    };
+}
+
+#endif // !_SGE_BOUNDING_VOLUME_HIERARCHY_H_
@@ -22,8 +22,21 @@ namespace SGE
     constexpr uint32 TEXTURES_START_HEAP_INDEX = CBV_SRV_HEAP_CAPACITY - SRV_HEAP_CAPACITY;
     constexpr uint32 EDITOR_START_HEAP_INDEX = CBV_SRV_HEAP_CAPACITY - 100;
 
+    // Textures and cubemaps take slots of one range the shaders index as g_Textures[], see
+    // material_table.hlsl. It ends where the editor's descriptors begin.
+    constexpr uint32 BINDLESS_TEXTURE_CAPACITY = EDITOR_START_HEAP_INDEX - TEXTURES_START_HEAP_INDEX;
+
+    // Root parameters after the descriptor tables every pass shares.
+    constexpr uint32 MATERIAL_INDEX_ROOT_PARAMETER = 8;
+    constexpr uint32 MATERIAL_TABLE_ROOT_PARAMETER = 9;
+    constexpr uint32 BINDLESS_TEXTURES_ROOT_PARAMETER = 10;
+
     constexpr float CLEAR_COLOR[4] = { 0.0, 0.0, 0.0, 1.0 };
 
+    // Fixed updates run per rendered frame at most. When updates fall behind the remaining
+    // time is dropped instead of accumulating into ever longer catch-up frames.
+    constexpr uint32 MAX_FIXED_UPDATES_PER_FRAME = 4;
+
     constexpr uint32 MAX_POINT_LIGHTS = 20;
     constexpr uint32 MAX_SPOT_LIGHTS = 1;
 
@@ -0,0 +1,39 @@
+#ifndef _SGE_DESCRIPTOR_ALLOCATOR_H_
+#define _SGE_DESCRIPTOR_ALLOCATOR_H_
+
+#include <vector>
+#include "core/sge_types.h"
+
+namespace SGE
+{
+    constexpr uint32 INVALID_DESCRIPTOR_INDEX = ~0u;
+
+    // Hands out indices of a fixed range of descriptor heap slots. Freed indices are reused
+    // lowest first before the range grows, so the slots in use stay packed at its start.
+    class DescriptorAllocator
+    {
+    public:
+        void Initialize(uint32 firstIndex, uint32 capacity);
+
+        // INVALID_DESCRIPTOR_INDEX when every slot of the range is taken.
+        uint32 Allocate();
+        // Returns false if the index is outside the range or not allocated.
+        bool Free(uint32 index);
+
+        bool IsAllocated(uint32 index) const;
+        uint32 GetFirstIndex() const { return m_firstIndex; }
+        uint32 GetCapacity() const { return static_cast<uint32>(m_isAllocated.size()); }
+        uint32 GetAllocatedCount() const { return m_allocatedCount; }
+        // One past the highest slot handed out so far, relative to the first index.
+        uint32 GetUsedRange() const { return m_usedRange; }
+
+    private:
+        uint32 m_firstIndex = 0;
+        uint32 m_allocatedCount = 0;
+        uint32 m_usedRange = 0;
+        std::vector<uint32> m_freeIndices; // min-heap of freed slots below m_usedRange
+        std::vector<bool> m_isAllocated;
+    };
+}
+
+#endif // !_SGE_DESCRIPTOR_ALLOCATOR_H_
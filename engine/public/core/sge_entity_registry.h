@@ -0,0 +1,247 @@
+#ifndef _SGE_ENTITY_REGISTRY_H_
+#define _SGE_ENTITY_REGISTRY_H_
+
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "core/sge_span.h"
+#include "core/sge_types.h"
+
+namespace SGE
+{
+    constexpr uint32 INVALID_ENTITY_INDEX = ~0u;
+
+    // Handle to an entity. The generation goes up every time an index is freed, so handles to a
+    // destroyed entity stay invalid after its index is reused.
+    struct Entity
+    {
+        uint32 index = INVALID_ENTITY_INDEX;
+        uint32 generation = 0;
+
+        bool IsValid() const { return index != INVALID_ENTITY_INDEX; }
+        bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+        bool operator!=(const Entity& other) const { return !(*this == other); }
+    };
+
+    // Sparse set of the entities that have one component type. The dense arrays hold no gaps,
+    // removing swaps the last component into the hole, so iterating them reads memory in order.
+    class ComponentPoolBase
+    {
+    public:
+        virtual ~ComponentPoolBase() = default;
+        virtual bool Remove(Entity entity) = 0;
+        virtual void Clear() = 0;
+
+        bool Contains(Entity entity) const;
+        size_t GetSize() const { return m_entities.size(); }
+        // The entity of each component, in the same order as the components.
+        Span<const Entity> GetEntities() const { return m_entities; }
+
+    protected:
+        // Dense index of entity's component, INVALID_ENTITY_INDEX when it has none.
+        uint32 Find(Entity entity) const;
+        uint32 AddEntity(Entity entity);
+        // Moves the last entity into the removed one's slot and returns that slot.
+        uint32 RemoveEntity(Entity entity);
+        void ClearEntities();
+
+    private:
+        std::vector<uint32> m_sparse; // entity index to dense index
+        std::vector<Entity> m_entities;
+    };
+
+    template<typename T>
+    class ComponentPool : public ComponentPoolBase
+    {
+    public:
+        // Replaces the entity's component when it already has one.
+        T& Add(Entity entity, T component)
+        {
+            const uint32 dense = Find(entity);
+            if (dense != INVALID_ENTITY_INDEX)
+            {
+                m_components[dense] = std::move(component);
+                return m_components[dense];
+            }
+
+            AddEntity(entity);
+            m_components.push_back(std::move(component));
+            return m_components.back();
+        }
+
+        bool Remove(Entity entity) override
+        {
+            if (!Contains(entity))
+            {
+                return false;
+            }
+
+            const uint32 dense = RemoveEntity(entity);
+            if (dense != m_components.size() - 1)
+            {
+                m_components[dense] = std::move(m_components.back());
+            }
+            m_components.pop_back();
+            return true;
+        }
+
+        void Clear() override
+        {
+            ClearEntities();
+            m_components.clear();
+        }
+
+        T* TryGet(Entity entity)
+        {
+            const uint32 dense = Find(entity);
+            return dense != INVALID_ENTITY_INDEX ? &m_components[dense] : nullptr;
+        }
+
+        const T* TryGet(Entity entity) const
+        {
+            const uint32 dense = Find(entity);
+            return dense != INVALID_ENTITY_INDEX ? &m_components[dense] : nullptr;
+        }
+
+        Span<T> GetComponents() { return m_components; }
+        Span<const T> GetComponents() const { return m_components; }
+
+    private:
+        std::vector<T> m_components;
+    };
+
+    // Entities with generational handles, and one ComponentPool per component type. Components
+    // are plain structs, systems are loops over the pools.
+    class EntityRegistry
+    {
+    public:
+        Entity Create();
+        // Removes the entity's components and frees its index.
+        bool Destroy(Entity entity);
+        bool IsAlive(Entity entity) const;
+        uint32 GetCount() const { return static_cast<uint32>(m_generations.size() - m_freeIndices.size()); }
+        void Clear();
+
+        template<typename T>
+        T& Add(Entity entity, T component = {})
+        {
+            return GetPool<T>().Add(entity, std::move(component));
+        }
+
+        template<typename T>
+        bool Remove(Entity entity)
+        {
+            ComponentPool<T>* pool = FindPool<T>();
+            return pool && pool->Remove(entity);
+        }
+
+        template<typename T>
+        T* TryGet(Entity entity)
+        {
+            ComponentPool<T>* pool = FindPool<T>();
+            return pool ? pool->TryGet(entity) : nullptr;
+        }
+
+        template<typename T>
+        const T* TryGet(Entity entity) const
+        {
+            const ComponentPool<T>* pool = FindPool<T>();
+            return pool ? pool->TryGet(entity) : nullptr;
+        }
+
+        template<typename T>
+        bool Has(Entity entity) const
+        {
+            const ComponentPool<T>* pool = FindPool<T>();
+            return pool && pool->Contains(entity);
+        }
+
+        template<typename T>
+        ComponentPool<T>& GetPool()
+        {
+            const uint32 id = GetComponentId<T>();
+            if (id >= m_pools.size())
+            {
+                m_pools.resize(id + 1);
+            }
+
+            if (!m_pools[id])
+            {
+                m_pools[id] = std::make_unique<ComponentPool<T>>();
+            }
+            return static_cast<ComponentPool<T>&>(*m_pools[id]);
+        }
+
+        template<typename T>
+        ComponentPool<T>* FindPool()
+        {
+            const uint32 id = GetComponentId<T>();
+            return id < m_pools.size() ? static_cast<ComponentPool<T>*>(m_pools[id].get()) : nullptr;
+        }
+
+        template<typename T>
+        const ComponentPool<T>* FindPool() const
+        {
+            const uint32 id = GetComponentId<T>();
+            return id < m_pools.size() ? static_cast<const ComponentPool<T>*>(m_pools[id].get()) : nullptr;
+        }
+
+        // Calls function(entity, T&, Others&...) for every entity that has all the components, in
+        // the order of T's pool. Put the rarest component first. Components must not be added or
+        // removed while iterating.
+        template<typename T, typename... Others, typename Function>
+        void Each(Function&& function)
+        {
+            ComponentPool<T>* pool = FindPool<T>();
+            if (!pool)
+            {
+                return;
+            }
+
+            Span<const Entity> entities = pool->GetEntities();
+            Span<T> components = pool->GetComponents();
+            if constexpr (sizeof...(Others) == 0)
+            {
+                for (size_t i = 0; i < components.size(); ++i)
+                {
+                    function(entities[i], components[i]);
+                }
+            }
+            else
+            {
+                std::tuple<ComponentPool<Others>*...> others(FindPool<Others>()...);
+                if (((std::get<ComponentPool<Others>*>(others) == nullptr) || ...))
+                {
+                    return;
+                }
+
+                for (size_t i = 0; i < components.size(); ++i)
+                {
+                    std::tuple<Others*...> found(std::get<ComponentPool<Others>*>(others)->TryGet(entities[i])...);
+                    if (((std::get<Others*>(found) != nullptr) && ...))
+                    {
+                        function(entities[i], components[i], *std::get<Others*>(found)...);
+                    }
+                }
+            }
+        }
+
+    private:
+        static uint32 NextComponentId();
+
+        template<typename T>
+        static uint32 GetComponentId()
+        {
+            static const uint32 id = NextComponentId();
+            return id;
+        }
+
+        std::vector<uint32> m_generations;
+        std::vector<uint8> m_isAlive;
+        std::vector<uint32> m_freeIndices;
+        std::vector<std::unique_ptr<ComponentPoolBase>> m_pools;
+    };
+}
+
+#endif // !_SGE_ENTITY_REGISTRY_H_
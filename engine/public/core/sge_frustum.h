@@ -0,0 +1,85 @@
+#ifndef _SGE_FRUSTUM_H_
+#define _SGE_FRUSTUM_H_
+
+#include "core/sge_math.h"
+
+namespace SGE
+{
+    // Points with dot(normal, p) + distance >= 0 are on the inner side.
+    struct Plane
+    {
+        float3 normal;
+        float distance = 0.0f;
+
+        float GetDistance(const float3& point) const { return dot(normal, point) + distance; }
+    };
+
+    // Six inward facing planes taken from a projection (Gribb and Hartmann), for column vectors
+    // and a [0, 1] depth range. Built from viewProjection * world the planes are in model space.
+    class Frustum
+    {
+    public:
+        enum PlaneIndex { Left, Right, Bottom, Top, Near, Far, PlaneCount };
+
+        static Frustum FromMatrix(const float4x4& matrix)
+        {
+            const float4 row0(matrix.m00, matrix.m01, matrix.m02, matrix.m03);
+            const float4 row1(matrix.m10, matrix.m11, matrix.m12, matrix.m13);
+            const float4 row2(matrix.m20, matrix.m21, matrix.m22, matrix.m23);
+            const float4 row3(matrix.m30, matrix.m31, matrix.m32, matrix.m33);
+
+            Frustum frustum;
+            frustum.SetPlane(Left, row3 + row0);
+            frustum.SetPlane(Right, row3 - row0);
+            frustum.SetPlane(Bottom, row3 + row1);
+            frustum.SetPlane(Top, row3 - row1);
+            frustum.SetPlane(Near, row2);
+            frustum.SetPlane(Far, row3 - row2);
+            return frustum;
+        }
+
+        const Plane& GetPlane(PlaneIndex index) const { return m_planes[index]; }
+
+        bool IntersectsSphere(const float3& center, float radius) const
+        {
+            for (const Plane& plane : m_planes)
+            {
+                if (plane.GetDistance(center) < -radius)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool IntersectsBox(const float3& boundsMin, const float3& boundsMax) const
+        {
+            for (const Plane& plane : m_planes)
+            {
+                // The corner furthest along the normal decides.
+                const float3 corner(plane.normal.x >= 0.0f ? boundsMax.x : boundsMin.x,
+                                    plane.normal.y >= 0.0f ? boundsMax.y : boundsMin.y,
+                                    plane.normal.z >= 0.0f ? boundsMax.z : boundsMin.z);
+                if (plane.GetDistance(corner) < 0.0f)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        void SetPlane(PlaneIndex index, const float4& coefficients)
+        {
+            const float3 normal(coefficients.x, coefficients.y, coefficients.z);
+            const float length = normal.length();
+            const float scale = length > 0.0f ? 1.0f / length : 0.0f;
+            m_planes[index].normal = normal * scale;
+            m_planes[index].distance = coefficients.w * scale;
+        }
+
+        Plane m_planes[PlaneCount];
+    };
+}
+
+#endif // !_SGE_FRUSTUM_H_
@@ -0,0 +1,39 @@
+#ifndef _SGE_FRUSTUM_CULLER_H_
+#define _SGE_FRUSTUM_CULLER_H_
+
+#include <vector>
+#include "core/sge_bounding_box.h"
+#include "core/sge_frustum.h"
+#include "core/sge_math_batch.h"
+#include "core/sge_types.h"
+
+namespace SGE
+{
+    // Bounds of many objects as structure of arrays, culled BatchLanes::Width objects at a time.
+    // Every object has a box and a sphere. Each alone is conservative, an object is visible when
+    // both intersect the frustum.
+    class FrustumCuller
+    {
+    public:
+        void Resize(size_t count);
+        size_t GetCount() const { return m_radii.size(); }
+
+        void SetBounds(size_t index, const float3& boxMin, const float3& boxMax, const float3& sphereCenter, float sphereRadius);
+        // Model space bounds moved to world space. The box becomes the axis aligned box around the
+        // transformed one, see BoundingBox::Transformed, the sphere grows with the largest scale.
+        void SetBounds(size_t index, const float4x4& worldMatrix, const float3& boxMin, const float3& boxMax, const float3& sphereCenter, float sphereRadius);
+        // A box alone. Its sphere is the one around it, which never culls more than the box.
+        void SetBounds(size_t index, const BoundingBox& box);
+
+        // Replaces visible with the indices of the objects that intersect the frustum, ascending.
+        void Cull(const Frustum& frustum, std::vector<uint32>& visible) const;
+
+    private:
+        float3_soa m_boxCenters;
+        float3_soa m_boxExtents;
+        float3_soa m_sphereCenters;
+        std::vector<float> m_radii;
+    };
+}
+
+#endif // !_SGE_FRUSTUM_CULLER_H_
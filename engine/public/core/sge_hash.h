@@ -0,0 +1,24 @@
+#ifndef _SGE_HASH_H_
+#define _SGE_HASH_H_
+
+#include <cstddef>
+#include "core/sge_types.h"
+
+namespace SGE
+{
+    // 64 bit FNV-1a. Used for cache keys and content hashes, not for anything security related.
+    constexpr uint64 FNV_OFFSET_BASIS = 14695981039346656037ull;
+    constexpr uint64 FNV_PRIME = 1099511628211ull;
+
+    inline uint64 HashBytes(uint64 hash, const void* data, size_t size)
+    {
+        const uint8* bytes = static_cast<const uint8*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash = (hash ^ bytes[i]) * FNV_PRIME;
+        }
+        return hash;
+    }
+}
+
+#endif // !_SGE_HASH_H_
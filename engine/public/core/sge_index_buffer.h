@@ -2,13 +2,18 @@
 #define _SGE_INDEX_BUFFER_H_
 
 #include "pch.h"
+#include "core/sge_span.h"
 
 namespace SGE
 {
     class IndexBuffer
     {
     public:
-        void Initialize(class Device* device, const std::vector<uint32>& indices);
+        void Initialize(class Device* device, Span<const uint32> indices);
+
+        // Rewrites the start of the buffer, for index lists built on the CPU every frame. The
+        // buffer stays in the upload heap, the renderer waits for the previous frame first.
+        void Update(Span<const uint32> indices);
         void Shutdown();
 
         D3D12_INDEX_BUFFER_VIEW GetView() const { return m_view; }
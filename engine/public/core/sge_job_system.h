@@ -0,0 +1,121 @@
+#ifndef _SGE_JOB_SYSTEM_H_
+#define _SGE_JOB_SYSTEM_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "core/sge_non_copyable.h"
+#include "core/sge_singleton.h"
+#include "core/sge_types.h"
+#include "core/sge_work_stealing_queue.h"
+
+namespace SGE
+{
+    using JobFunction = std::function<void()>;
+    using RangeJobFunction = std::function<void(size_t, size_t)>;
+
+    // Number of unfinished jobs started with this counter. A job may start children on the counter
+    // of its parent before it returns, the counter then only reaches zero once the whole tree is done.
+    // The first exception one of its jobs throws is kept and rethrown by JobSystem::Wait.
+    class JobCounter : public NonCopyable
+    {
+    public:
+        JobCounter() = default;
+
+        bool IsDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+        uint32 GetPending() const { return m_pending.load(std::memory_order_acquire); }
+
+    private:
+        friend class JobSystem;
+        std::atomic<uint32> m_pending{ 0 };
+        std::mutex m_exceptionMutex;
+        std::exception_ptr m_exception;
+    };
+
+    // Work-stealing job system. Every worker thread and the main thread (the thread calling
+    // Initialize) own a lock-free deque: a thread runs its own newest job first and steals the
+    // oldest job of another thread when it runs dry. Jobs started from other threads go through a
+    // shared queue. Waiting on a counter runs other jobs instead of blocking.
+    // Without Initialize, or after Shutdown, jobs run inline on the calling thread.
+    class JobSystem : public Singleton<JobSystem>
+    {
+        friend class Singleton<JobSystem>;
+
+    public:
+        // workerCount 0 uses one thread per hardware core minus the main thread.
+        void Initialize(uint32 workerCount = 0);
+        void Shutdown();
+
+        bool IsInitialized() const { return !m_threads.empty(); }
+        uint32 GetWorkerCount() const { return static_cast<uint32>(m_workerThreads.size()); }
+        uint32 GetThreadCount() const { return static_cast<uint32>(m_threads.size()); }
+        bool IsMainThread() const;
+
+        // A job that throws still counts as done. Exceptions of jobs without a counter are logged and dropped.
+        void Run(JobFunction job, JobCounter* counter = nullptr);
+        // Helps with other jobs until the counter reaches zero, then rethrows the first exception
+        // its jobs threw, if any. The counter can be reused afterwards.
+        void Wait(JobCounter& counter);
+
+        // Jobs that must run on the main thread, e.g. anything recording GPU work. They run in
+        // ProcessMainThreadJobs and while the main thread waits on a counter.
+        void RunOnMainThread(JobFunction job, JobCounter* counter = nullptr);
+        void ProcessMainThreadJobs();
+
+        // Calls work(begin, end) over [0, count). The range is split in halves on demand, idle threads
+        // steal the upper halves, so the grain adapts to the load. Chunks never go below minGrainSize.
+        void ParallelFor(size_t count, const RangeJobFunction& work, size_t minGrainSize = 1);
+
+        // Same as ParallelFor but returns immediately, counter reaches zero once all chunks are done.
+        void ParallelForAsync(size_t count, RangeJobFunction work, JobCounter& counter, size_t minGrainSize = 1);
+
+    private:
+        struct Job
+        {
+            JobFunction function;
+            JobCounter* counter = nullptr;
+        };
+
+        struct ThreadState
+        {
+            WorkStealingQueue<Job*> queue;
+            uint32 randomState = 0;
+        };
+
+        JobSystem() = default;
+        ~JobSystem();
+
+        void Submit(Job* job);
+        void Execute(Job* job);
+        static void KeepException(JobCounter& counter, std::exception_ptr exception);
+        Job* FindJob(int32 threadIndex);
+        bool RunMainThreadJob();
+        void WorkerLoop(uint32 threadIndex);
+        size_t GetGrainSize(size_t count, size_t minGrainSize) const;
+        void SplitRange(size_t begin, size_t end, size_t grainSize, const std::shared_ptr<const RangeJobFunction>& work, JobCounter& counter);
+
+        std::vector<std::unique_ptr<ThreadState>> m_threads; // index 0 is the main thread
+        std::vector<std::thread> m_workerThreads;
+        std::thread::id m_mainThreadId;
+
+        std::mutex m_sharedMutex;
+        std::deque<Job*> m_sharedQueue;
+
+        std::mutex m_mainThreadMutex;
+        std::deque<Job*> m_mainThreadJobs;
+
+        std::mutex m_sleepMutex;
+        std::condition_variable m_sleepCondition;
+        std::atomic<uint32> m_queuedJobs{ 0 };
+        std::atomic<uint32> m_sleepingWorkers{ 0 };
+        std::atomic<bool> m_isRunning{ false };
+    };
+}
+
+#endif // !_SGE_JOB_SYSTEM_H_
@@ -1,9 +1,12 @@
 #ifndef _SGE_LOGGER_H_
 #define _SGE_LOGGER_H_
 
-#include "pch.h"
-#include "core/sge_singleton.h"
+#include <memory>
+#include <mutex>
+#include <ostream>
 #include <sstream>
+#include <string>
+#include "core/sge_singleton.h"
 
 namespace SGE
 {
@@ -0,0 +1,37 @@
+#ifndef _SGE_MAPPED_FILE_H_
+#define _SGE_MAPPED_FILE_H_
+
+#include <string>
+#include "core/sge_non_copyable.h"
+#include "core/sge_span.h"
+#include "core/sge_types.h"
+
+namespace SGE
+{
+    // Read-only view of a whole file mapped into memory. Pages are read in by the OS on first
+    // touch, so opening is cheap and data handed out from the view is never copied.
+    class MappedFile : public NonCopyable
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        bool Open(const std::string& path);
+        void Close();
+
+        bool IsOpen() const { return m_data != nullptr; }
+        const uint8* GetData() const { return m_data; }
+        size_t GetSize() const { return m_size; }
+        Span<const uint8> GetBytes() const { return Span<const uint8>(m_data, m_size); }
+
+    private:
+        const uint8* m_data = nullptr;
+        size_t m_size = 0;
+#if defined(_WIN32)
+        void* m_file = nullptr;
+        void* m_mapping = nullptr;
+#endif
+    };
+}
+
+#endif // !_SGE_MAPPED_FILE_H_
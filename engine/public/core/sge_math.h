@@ -5,6 +5,12 @@
 #include <limits>
 #include <algorithm>
 #include <iostream>
+#include "core/sge_math_kernels.h"
+
+// Vector and matrix types are header-only so that the arithmetic in the animation, camera and
+// scene code inlines without LTO. Everything that does not need <cmath> or SIMD intrinsics is
+// constexpr. Storage stays plain floats (float4x4 is 16-byte aligned) so the types remain
+// trivially copyable and memcpy straight into constant buffers.
 
 namespace SGE
 {
@@ -14,6 +20,12 @@ namespace SGE
     constexpr float ConvertToRadians(float degrees) noexcept { return degrees * (PI / 180.0f); }
     constexpr float ConvertToDegrees(float radians) noexcept { return radians * (180.0f / PI); }
 
+    // std::fabs is not constexpr before C++23, comparisons go through this instead.
+    constexpr bool NearlyEqual(float a, float b, float epsilon = EPSILON) noexcept
+    {
+        return (a > b ? a - b : b - a) < epsilon;
+    }
+
     // --------------------------------------------------------------------------
     // float1
     // --------------------------------------------------------------------------
@@ -22,9 +34,9 @@ namespace SGE
         float value;
 
         float1() = default;
-        float1(float v) : value(v) {}
+        constexpr float1(float v) : value(v) {}
 
-        operator float() const { return value; }
+        constexpr operator float() const { return value; }
     };
 
     // --------------------------------------------------------------------------
@@ -36,10 +48,10 @@ namespace SGE
     public:
         float x, y;
 
-        float2() noexcept;
-        float2(float x, float y) noexcept;
-        float* data() noexcept;
-        const float* data() const noexcept;
+        constexpr float2() noexcept : x(0), y(0) {}
+        constexpr float2(float x, float y) noexcept : x(x), y(y) {}
+        float* data() noexcept { return &x; }
+        const float* data() const noexcept { return &x; }
 
         static const float2 Zero;
 
@@ -47,26 +59,77 @@ namespace SGE
         float2 normalized() const noexcept;
         void normalize() noexcept;
 
-        float2& operator+=(const float2& other) noexcept;
-        float2& operator-=(const float2& other) noexcept;
-        float2& operator*=(float scalar) noexcept;
-        float2& operator/=(float scalar) noexcept;
-        bool operator==(const float2& other) const noexcept;
-        bool operator!=(const float2& other) const noexcept;
-        float2 operator-() const noexcept;
+        constexpr float2& operator+=(const float2& other) noexcept;
+        constexpr float2& operator-=(const float2& other) noexcept;
+        constexpr float2& operator*=(float scalar) noexcept;
+        constexpr float2& operator/=(float scalar) noexcept;
+        constexpr bool operator==(const float2& other) const noexcept;
+        constexpr bool operator!=(const float2& other) const noexcept;
+        constexpr float2 operator-() const noexcept;
     };
 
-    float dot(const float2& a, const float2& b) noexcept;
-    float2 reflect(const float2& vec, const float2& normal) noexcept;
-    float2 project(const float2& vec, const float2& onto) noexcept;
-    float distance(const float2& a, const float2& b) noexcept;
-    float angle(const float2& a, const float2& b) noexcept;
-    float2 lerp(const float2& a, const float2& b, float t) noexcept;
-    float2 operator+(const float2& lhs, const float2& rhs) noexcept;
-    float2 operator-(const float2& lhs, const float2& rhs) noexcept;
-    float2 operator*(const float2& vec, float scalar) noexcept;
-    float2 operator*(float scalar, const float2& vec) noexcept;
-    float2 operator/(const float2& vec, float scalar) noexcept;
+    inline constexpr float2 float2::Zero = float2(0.0f, 0.0f);
+
+    constexpr float2 operator+(const float2& lhs, const float2& rhs) noexcept { return float2(lhs.x + rhs.x, lhs.y + rhs.y); }
+    constexpr float2 operator-(const float2& lhs, const float2& rhs) noexcept { return float2(lhs.x - rhs.x, lhs.y - rhs.y); }
+    constexpr float2 operator*(const float2& vec, float scalar) noexcept { return float2(vec.x * scalar, vec.y * scalar); }
+    constexpr float2 operator*(float scalar, const float2& vec) noexcept { return vec * scalar; }
+    constexpr float2 operator/(const float2& vec, float scalar) noexcept { return vec * (1.0f / scalar); }
+
+    constexpr float2& float2::operator+=(const float2& other) noexcept { x += other.x; y += other.y; return *this; }
+    constexpr float2& float2::operator-=(const float2& other) noexcept { x -= other.x; y -= other.y; return *this; }
+    constexpr float2& float2::operator*=(float scalar) noexcept { x *= scalar; y *= scalar; return *this; }
+    constexpr float2& float2::operator/=(float scalar) noexcept { return *this *= (1.0f / scalar); }
+    constexpr bool float2::operator==(const float2& other) const noexcept { return NearlyEqual(x, other.x) && NearlyEqual(y, other.y); }
+    constexpr bool float2::operator!=(const float2& other) const noexcept { return !(*this == other); }
+    constexpr float2 float2::operator-() const noexcept { return float2(-x, -y); }
+
+    constexpr float dot(const float2& a, const float2& b) noexcept
+    {
+        return a.x * b.x + a.y * b.y;
+    }
+
+    constexpr float2 reflect(const float2& vec, const float2& normal) noexcept
+    {
+        return vec - 2.0f * dot(vec, normal) * normal;
+    }
+
+    constexpr float2 project(const float2& vec, const float2& onto) noexcept
+    {
+        return onto * (dot(vec, onto) / dot(onto, onto));
+    }
+
+    constexpr float2 lerp(const float2& a, const float2& b, float t) noexcept
+    {
+        return a + (b - a) * t;
+    }
+
+    inline float float2::length() const noexcept
+    {
+        return std::sqrt(x * x + y * y);
+    }
+
+    inline float2 float2::normalized() const noexcept
+    {
+        float len = length();
+        if (len < EPSILON) return Zero;
+        return *this / len;
+    }
+
+    inline void float2::normalize() noexcept
+    {
+        *this = normalized();
+    }
+
+    inline float distance(const float2& a, const float2& b) noexcept
+    {
+        return (a - b).length();
+    }
+
+    inline float angle(const float2& a, const float2& b) noexcept
+    {
+        return std::acos(dot(a, b) / (a.length() * b.length()));
+    }
 
     // --------------------------------------------------------------------------
     // float3
@@ -82,13 +145,13 @@ namespace SGE
             float components[3];
         };
 
-        float3() noexcept;
-        float3(float x, float y, float z) noexcept;
-        float* data() noexcept;
-        const float* data() const noexcept;
+        constexpr float3() noexcept : x(0), y(0), z(0) {}
+        constexpr float3(float x, float y, float z) noexcept : x(x), y(y), z(z) {}
+        float* data() noexcept { return &x; }
+        const float* data() const noexcept { return &x; }
 
-        float& operator[](size_t index) noexcept;
-        const float& operator[](size_t index) const noexcept;
+        float& operator[](size_t index) noexcept { return components[index]; }
+        const float& operator[](size_t index) const noexcept { return components[index]; }
 
         static const float3 Zero;
         static const float3 One;
@@ -97,28 +160,99 @@ namespace SGE
         float3 normalized() const noexcept;
         void normalize() noexcept;
 
-        float3& operator+=(const float3& other) noexcept;
-        float3& operator-=(const float3& other) noexcept;
-        float3& operator*=(float scalar) noexcept;
-        float3& operator/=(float scalar) noexcept;
-        bool operator==(const float3& other) const noexcept;
-        bool operator!=(const float3& other) const noexcept;
-        float3 operator-() const noexcept;
+        constexpr float3& operator+=(const float3& other) noexcept;
+        constexpr float3& operator-=(const float3& other) noexcept;
+        constexpr float3& operator*=(float scalar) noexcept;
+        constexpr float3& operator/=(float scalar) noexcept;
+        constexpr bool operator==(const float3& other) const noexcept;
+        constexpr bool operator!=(const float3& other) const noexcept;
+        constexpr float3 operator-() const noexcept;
     };
 
-    float3 cross(const float3& lhs, const float3& rhs) noexcept;
-    float3 slerp(const float3& a, const float3& b, float t) noexcept;
-    float dot(const float3& a, const float3& b) noexcept;
-    float3 reflect(const float3& vec, const float3& normal) noexcept;
-    float3 project(const float3& vec, const float3& onto) noexcept;
-    float distance(const float3& a, const float3& b) noexcept;
-    float angle(const float3& a, const float3& b) noexcept;
-    float3 lerp(const float3& a, const float3& b, float t) noexcept;
-    float3 operator+(const float3& lhs, const float3& rhs) noexcept;
-    float3 operator-(const float3& lhs, const float3& rhs) noexcept;
-    float3 operator*(const float3& vec, float scalar) noexcept;
-    float3 operator*(float scalar, const float3& vec) noexcept;
-    float3 operator/(const float3& vec, float scalar) noexcept;
+    inline constexpr float3 float3::Zero = float3(0.0f, 0.0f, 0.0f);
+    inline constexpr float3 float3::One  = float3(1.0f, 1.0f, 1.0f);
+
+    constexpr float3 operator+(const float3& lhs, const float3& rhs) noexcept { return float3(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z); }
+    constexpr float3 operator-(const float3& lhs, const float3& rhs) noexcept { return float3(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z); }
+    constexpr float3 operator*(const float3& vec, float scalar) noexcept { return float3(vec.x * scalar, vec.y * scalar, vec.z * scalar); }
+    constexpr float3 operator*(float scalar, const float3& vec) noexcept { return vec * scalar; }
+    constexpr float3 operator/(const float3& vec, float scalar) noexcept { return vec * (1.0f / scalar); }
+
+    constexpr float3& float3::operator+=(const float3& other) noexcept { x += other.x; y += other.y; z += other.z; return *this; }
+    constexpr float3& float3::operator-=(const float3& other) noexcept { x -= other.x; y -= other.y; z -= other.z; return *this; }
+    constexpr float3& float3::operator*=(float scalar) noexcept { x *= scalar; y *= scalar; z *= scalar; return *this; }
+    constexpr float3& float3::operator/=(float scalar) noexcept { return *this *= (1.0f / scalar); }
+    constexpr bool float3::operator==(const float3& other) const noexcept
+    {
+        return NearlyEqual(x, other.x) && NearlyEqual(y, other.y) && NearlyEqual(z, other.z);
+    }
+    constexpr bool float3::operator!=(const float3& other) const noexcept { return !(*this == other); }
+    constexpr float3 float3::operator-() const noexcept { return float3(-x, -y, -z); }
+
+    constexpr float dot(const float3& a, const float3& b) noexcept
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    constexpr float3 cross(const float3& lhs, const float3& rhs) noexcept
+    {
+        return float3
+        (
+            lhs.y * rhs.z - lhs.z * rhs.y,
+            lhs.z * rhs.x - lhs.x * rhs.z,
+            lhs.x * rhs.y - lhs.y * rhs.x
+        );
+    }
+
+    constexpr float3 reflect(const float3& vec, const float3& normal) noexcept
+    {
+        return vec - 2.0f * dot(normal, vec) * normal;
+    }
+
+    constexpr float3 project(const float3& vec, const float3& onto) noexcept
+    {
+        return onto * (dot(vec, onto) / dot(onto, onto));
+    }
+
+    constexpr float3 lerp(const float3& a, const float3& b, float t) noexcept
+    {
+        return a + (b - a) * t;
+    }
+
+    inline float float3::length() const noexcept
+    {
+        return std::sqrt(x * x + y * y + z * z);
+    }
+
+    inline float3 float3::normalized() const noexcept
+    {
+        float len = length();
+        if (len < EPSILON) return Zero;
+        return *this / len;
+    }
+
+    inline void float3::normalize() noexcept
+    {
+        *this = normalized();
+    }
+
+    inline float distance(const float3& a, const float3& b) noexcept
+    {
+        return (a - b).length();
+    }
+
+    inline float angle(const float3& a, const float3& b) noexcept
+    {
+        return std::acos(std::clamp(dot(a, b), -1.0f, 1.0f));
+    }
+
+    inline float3 slerp(const float3& a, const float3& b, float t) noexcept
+    {
+        float dotValue = std::clamp(dot(a, b), -1.0f, 1.0f);
+        float theta = std::acos(dotValue) * t;
+        float3 relativeVec = (b - a * dotValue).normalized();
+        return a * std::cos(theta) + relativeVec * std::sin(theta);
+    }
 
     // --------------------------------------------------------------------------
     // float4
@@ -134,35 +268,98 @@ namespace SGE
             float components[4];
         };
 
-        float4() noexcept;
-        float4(float x, float y, float z, float w) noexcept;
-        float* data() noexcept;
-        const float* data() const noexcept;
-
-        float& operator[](size_t index) noexcept;
-        const float& operator[](size_t index) const noexcept;
-
-        float4& operator+=(const float4& other) noexcept;
-        float4& operator-=(const float4& other) noexcept;
-        float4& operator*=(float scalar) noexcept;
-        float4& operator/=(float scalar) noexcept;
-        bool operator==(const float4& other) noexcept;
-        bool operator!=(const float4& other) noexcept;
-        float4 operator-() const noexcept;
+        constexpr float4() noexcept : x(0), y(0), z(0), w(0) {}
+        constexpr float4(float x, float y, float z, float w) noexcept : x(x), y(y), z(z), w(w) {}
+        float* data() noexcept { return components; }
+        const float* data() const noexcept { return components; }
+
+        float& operator[](size_t index) noexcept { return components[index]; }
+        const float& operator[](size_t index) const noexcept { return components[index]; }
+
+        constexpr float4& operator+=(const float4& other) noexcept;
+        constexpr float4& operator-=(const float4& other) noexcept;
+        constexpr float4& operator*=(float scalar) noexcept;
+        constexpr float4& operator/=(float scalar) noexcept;
+        constexpr bool operator==(const float4& other) const noexcept;
+        constexpr bool operator!=(const float4& other) const noexcept;
+        constexpr float4 operator-() const noexcept;
         float4 normalized() const noexcept;
 
         static const float4 Zero;
         static const float4 Identity;
     };
 
-    float4 operator+(const float4& lhs, const float4& rhs) noexcept;
-    float4 operator-(const float4& lhs, const float4& rhs) noexcept;
-    float4 operator*(const float4& vec, float scalar) noexcept;
-    float4 operator/(const float4& vec, float scalar) noexcept;
-    
-    float length(const float4& v) noexcept;
-    float dot(const float4& a, const float4& b) noexcept;
-    float4 slerp(const float4& a, const float4& b, float t) noexcept;
+    inline constexpr float4 float4::Zero = float4(0.0f, 0.0f, 0.0f, 0.0f);
+    inline constexpr float4 float4::Identity = float4(0.0f, 0.0f, 0.0f, 1.0f);
+
+    constexpr float4 operator+(const float4& lhs, const float4& rhs) noexcept { return float4(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w); }
+    constexpr float4 operator-(const float4& lhs, const float4& rhs) noexcept { return float4(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w); }
+    constexpr float4 operator*(const float4& vec, float scalar) noexcept { return float4(vec.x * scalar, vec.y * scalar, vec.z * scalar, vec.w * scalar); }
+    constexpr float4 operator/(const float4& vec, float scalar) noexcept { return float4(vec.x / scalar, vec.y / scalar, vec.z / scalar, vec.w / scalar); }
+
+    constexpr float4& float4::operator+=(const float4& other) noexcept { x += other.x; y += other.y; z += other.z; w += other.w; return *this; }
+    constexpr float4& float4::operator-=(const float4& other) noexcept { x -= other.x; y -= other.y; z -= other.z; w -= other.w; return *this; }
+    constexpr float4& float4::operator*=(float scalar) noexcept { x *= scalar; y *= scalar; z *= scalar; w *= scalar; return *this; }
+    constexpr float4& float4::operator/=(float scalar) noexcept { x /= scalar; y /= scalar; z /= scalar; w /= scalar; return *this; }
+    constexpr bool float4::operator==(const float4& other) const noexcept
+    {
+        return NearlyEqual(x, other.x) && NearlyEqual(y, other.y) && NearlyEqual(z, other.z) && NearlyEqual(w, other.w);
+    }
+    constexpr bool float4::operator!=(const float4& other) const noexcept { return !(*this == other); }
+    constexpr float4 float4::operator-() const noexcept { return float4(-x, -y, -z, -w); }
+
+    constexpr float dot(const float4& a, const float4& b) noexcept
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    }
+
+    inline float length(const float4& v) noexcept
+    {
+        return std::sqrt(dot(v, v));
+    }
+
+    inline float4 float4::normalized() const noexcept
+    {
+        float len = length(*this);
+        return (len > EPSILON) ? (*this / len) : Identity;
+    }
+
+    inline float4 slerp(const float4& q1, const float4& q2, float t) noexcept
+    {
+        float dotValue = dot(q1, q2);
+        float4 target = q2;
+
+        if (dotValue < 0.0f)
+        {
+            dotValue = -dotValue;
+            target = -q2;
+        }
+
+        dotValue = std::clamp(dotValue, -1.0f, 1.0f);
+        float theta = std::acos(dotValue) * t;
+        float4 relativeQuat = (target - q1 * dotValue).normalized();
+        return q1 * std::cos(theta) + relativeQuat * std::sin(theta);
+    }
+
+    // Normalized lerp along the shortest arc. Cheaper than slerp, and blending several
+    // quaternions with it gives the same result in any order.
+    inline float4 nlerp(const float4& q1, const float4& q2, float t) noexcept
+    {
+        float4 target = dot(q1, q2) < 0.0f ? -q2 : q2;
+        return (q1 + (target - q1) * t).normalized();
+    }
+
+    // Hamilton product: the result rotates by b first, then by a.
+    constexpr float4 MultiplyQuaternions(const float4& a, const float4& b) noexcept
+    {
+        return float4
+        (
+            a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+            a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+            a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+            a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z
+        );
+    }
 
     // --------------------------------------------------------------------------
     // float2x2
@@ -182,34 +379,119 @@ namespace SGE
             float m[4]; // Row-major: [m00, m01, m10, m11]
         };
 
-        float2x2() noexcept;
-        float2x2(float m00, float m01, float m10, float m11) noexcept;
-        float2x2(const float2& row0, const float2& row1) noexcept;
+        constexpr float2x2() noexcept : m00(0), m01(0), m10(0), m11(0) {}
+        constexpr float2x2(float m00, float m01, float m10, float m11) noexcept
+        : m00(m00), m01(m01), m10(m10), m11(m11) {}
+        constexpr float2x2(const float2& row0, const float2& row1) noexcept
+        : m00(row0.x), m01(row0.y), m10(row1.x), m11(row1.y) {}
 
-        float* data() noexcept;
-        const float* data() const noexcept;
+        float* data() noexcept { return m; }
+        const float* data() const noexcept { return m; }
 
         static const float2x2 Identity;
         static const float2x2 Zero;
 
-        float2x2 transposed() const noexcept;
-        float determinant() const noexcept;
-        float2x2 inverse() const noexcept;
-
-        float2 operator*(const float2& vec) const noexcept;
-        float2x2 operator*(const float2x2& other) const noexcept;
-        float2x2& operator*=(const float2x2& other) noexcept;
-        float2x2 operator*(float scalar) const noexcept;
-        float2x2& operator*=(float scalar) noexcept;
-        float2x2 operator+(const float2x2& other) const noexcept;
-        float2x2& operator+=(const float2x2& other) noexcept;
-        float2x2 operator-(const float2x2& other) const noexcept;
-        float2x2& operator-=(const float2x2& other) noexcept;
-        bool operator==(const float2x2& other) const noexcept;
-        bool operator!=(const float2x2& other) const noexcept;
+        constexpr float2x2 transposed() const noexcept;
+        constexpr float determinant() const noexcept;
+        constexpr float2x2 inverse() const noexcept;
+
+        constexpr float2 operator*(const float2& vec) const noexcept;
+        constexpr float2x2 operator*(const float2x2& other) const noexcept;
+        constexpr float2x2& operator*=(const float2x2& other) noexcept { return *this = *this * other; }
+        constexpr float2x2 operator*(float scalar) const noexcept;
+        constexpr float2x2& operator*=(float scalar) noexcept { return *this = *this * scalar; }
+        constexpr float2x2 operator+(const float2x2& other) const noexcept;
+        constexpr float2x2& operator+=(const float2x2& other) noexcept { return *this = *this + other; }
+        constexpr float2x2 operator-(const float2x2& other) const noexcept;
+        constexpr float2x2& operator-=(const float2x2& other) noexcept { return *this = *this - other; }
+        constexpr bool operator==(const float2x2& other) const noexcept;
+        constexpr bool operator!=(const float2x2& other) const noexcept { return !(*this == other); }
     };
 
-    float2x2 operator*(float scalar, const float2x2& mat) noexcept;
+    inline constexpr float2x2 float2x2::Identity = float2x2(1.0f, 0.0f, 0.0f, 1.0f);
+    inline constexpr float2x2 float2x2::Zero = float2x2(0.0f, 0.0f, 0.0f, 0.0f);
+
+    constexpr float2x2 float2x2::transposed() const noexcept
+    {
+        return float2x2(m00, m10, m01, m11);
+    }
+
+    constexpr float float2x2::determinant() const noexcept
+    {
+        return m00 * m11 - m01 * m10;
+    }
+
+    constexpr float2x2 float2x2::inverse() const noexcept
+    {
+        float det = determinant();
+        if (NearlyEqual(det, 0.0f))
+        {
+            return Zero;
+        }
+
+        float invDet = 1.0f / det;
+        return float2x2
+        (
+            m11 * invDet, -m01 * invDet,
+            -m10 * invDet, m00 * invDet
+        );
+    }
+
+    constexpr float2 float2x2::operator*(const float2& vec) const noexcept
+    {
+        return float2
+        (
+            m00 * vec.x + m01 * vec.y,
+            m10 * vec.x + m11 * vec.y
+        );
+    }
+
+    constexpr float2x2 float2x2::operator*(const float2x2& other) const noexcept
+    {
+        return float2x2
+        (
+            m00 * other.m00 + m01 * other.m10, m00 * other.m01 + m01 * other.m11,
+            m10 * other.m00 + m11 * other.m10, m10 * other.m01 + m11 * other.m11
+        );
+    }
+
+    constexpr float2x2 float2x2::operator*(float scalar) const noexcept
+    {
+        return float2x2
+        (
+            m00 * scalar, m01 * scalar,
+            m10 * scalar, m11 * scalar
+        );
+    }
+
+    constexpr float2x2 float2x2::operator+(const float2x2& other) const noexcept
+    {
+        return float2x2
+        (
+            m00 + other.m00, m01 + other.m01,
+            m10 + other.m10, m11 + other.m11
+        );
+    }
+
+    constexpr float2x2 float2x2::operator-(const float2x2& other) const noexcept
+    {
+        return float2x2
+        (
+            m00 - other.m00, m01 - other.m01,
+            m10 - other.m10, m11 - other.m11
+        );
+    }
+
+    constexpr bool float2x2::operator==(const float2x2& other) const noexcept
+    {
+        return NearlyEqual(m00, other.m00) && NearlyEqual(m01, other.m01) &&
+               NearlyEqual(m10, other.m10) && NearlyEqual(m11, other.m11);
+    }
+
+    constexpr float2x2 operator*(float scalar, const float2x2& mat) noexcept
+    {
+        return mat * scalar;
+    }
 
     // --------------------------------------------------------------------------
     // float3x3
@@ -232,36 +514,151 @@ namespace SGE
             float m[9]; // Row-major: [m00, m01, m02, m10, m11, m12, m20, m21, m22]
         };
 
-        float3x3() noexcept;
-        float3x3(float m00, float m01, float m02,
-                 float m10, float m11, float m12,
-                 float m20, float m21, float m22) noexcept;
-        float3x3(const float3& row0, const float3& row1, const float3& row2) noexcept;
-
-        float* data() noexcept;
-        const float* data() const noexcept;
+        constexpr float3x3() noexcept
+        : m00(0), m01(0), m02(0),
+          m10(0), m11(0), m12(0),
+          m20(0), m21(0), m22(0) {}
+        constexpr float3x3(float m00, float m01, float m02,
+                           float m10, float m11, float m12,
+                           float m20, float m21, float m22) noexcept
+        : m00(m00), m01(m01), m02(m02),
+          m10(m10), m11(m11), m12(m12),
+          m20(m20), m21(m21), m22(m22) {}
+        constexpr float3x3(const float3& row0, const float3& row1, const float3& row2) noexcept
+        : m00(row0.x), m01(row0.y), m02(row0.z),
+          m10(row1.x), m11(row1.y), m12(row1.z),
+          m20(row2.x), m21(row2.y), m22(row2.z) {}
+
+        float* data() noexcept { return m; }
+        const float* data() const noexcept { return m; }
 
         static const float3x3 Identity;
         static const float3x3 Zero;
 
-        float3x3 transposed() const noexcept;
-        float determinant() const noexcept;
-        float3x3 inverse() const noexcept;
-
-        float3 operator*(const float3& vec) const noexcept;
-        float3x3 operator*(const float3x3& other) const noexcept;
-        float3x3& operator*=(const float3x3& other) noexcept;
-        float3x3 operator*(float scalar) const noexcept;
-        float3x3& operator*=(float scalar) noexcept;
-        float3x3 operator+(const float3x3& other) const noexcept;
-        float3x3& operator+=(const float3x3& other) noexcept;
-        float3x3 operator-(const float3x3& other) const noexcept;
-        float3x3& operator-=(const float3x3& other) noexcept;
-        bool operator==(const float3x3& other) const noexcept;
-        bool operator!=(const float3x3& other) const noexcept;
+        constexpr float3x3 transposed() const noexcept;
+        constexpr float determinant() const noexcept;
+        constexpr float3x3 inverse() const noexcept;
+
+        constexpr float3 operator*(const float3& vec) const noexcept;
+        constexpr float3x3 operator*(const float3x3& other) const noexcept;
+        constexpr float3x3& operator*=(const float3x3& other) noexcept { return *this = *this * other; }
+        constexpr float3x3 operator*(float scalar) const noexcept;
+        constexpr float3x3& operator*=(float scalar) noexcept { return *this = *this * scalar; }
+        constexpr float3x3 operator+(const float3x3& other) const noexcept;
+        constexpr float3x3& operator+=(const float3x3& other) noexcept { return *this = *this + other; }
+        constexpr float3x3 operator-(const float3x3& other) const noexcept;
+        constexpr float3x3& operator-=(const float3x3& other) noexcept { return *this = *this - other; }
+        constexpr bool operator==(const float3x3& other) const noexcept;
+        constexpr bool operator!=(const float3x3& other) const noexcept { return !(*this == other); }
     };
 
-    float3x3 operator*(float scalar, const float3x3& mat) noexcept;
+    inline constexpr float3x3 float3x3::Identity = float3x3(1.0f, 0.0f, 0.0f,
+                                                            0.0f, 1.0f, 0.0f,
+                                                            0.0f, 0.0f, 1.0f);
+    inline constexpr float3x3 float3x3::Zero = float3x3(0.0f, 0.0f, 0.0f,
+                                                        0.0f, 0.0f, 0.0f,
+                                                        0.0f, 0.0f, 0.0f);
+
+    constexpr float3x3 float3x3::transposed() const noexcept
+    {
+        return float3x3(m00, m10, m20,
+                        m01, m11, m21,
+                        m02, m12, m22);
+    }
+
+    constexpr float float3x3::determinant() const noexcept
+    {
+        return m00 * (m11 * m22 - m12 * m21)
+             - m01 * (m10 * m22 - m12 * m20)
+             + m02 * (m10 * m21 - m11 * m20);
+    }
+
+    constexpr float3x3 float3x3::inverse() const noexcept
+    {
+        float det = determinant();
+        if (NearlyEqual(det, 0.0f))
+        {
+            return Zero;
+        }
+
+        float invDet = 1.0f / det;
+        return float3x3(
+            // Row 0
+            (m11 * m22 - m12 * m21) * invDet,
+            (m02 * m21 - m01 * m22) * invDet,
+            (m01 * m12 - m02 * m11) * invDet,
+            // Row 1
+            (m12 * m20 - m10 * m22) * invDet,
+            (m00 * m22 - m02 * m20) * invDet,
+            (m02 * m10 - m00 * m12) * invDet,
+            // Row 2
+            (m10 * m21 - m11 * m20) * invDet,
+            (m01 * m20 - m00 * m21) * invDet,
+            (m00 * m11 - m01 * m10) * invDet
+        );
+    }
+
+    constexpr float3 float3x3::operator*(const float3& vec) const noexcept
+    {
+        return float3
+        (
+            vec.x * m00 + vec.y * m01 + vec.z * m02,
+            vec.x * m10 + vec.y * m11 + vec.z * m12,
+            vec.x * m20 + vec.y * m21 + vec.z * m22
+        );
+    }
+
+    constexpr float3x3 float3x3::operator*(const float3x3& other) const noexcept
+    {
+        return float3x3
+        (
+            m00 * other.m00 + m01 * other.m10 + m02 * other.m20, m00 * other.m01 + m01 * other.m11 + m02 * other.m21, m00 * other.m02 + m01 * other.m12 + m02 * other.m22,
+            m10 * other.m00 + m11 * other.m10 + m12 * other.m20, m10 * other.m01 + m11 * other.m11 + m12 * other.m21, m10 * other.m02 + m11 * other.m12 + m12 * other.m22,
+            m20 * other.m00 + m21 * other.m10 + m22 * other.m20, m20 * other.m01 + m21 * other.m11 + m22 * other.m21, m20 * other.m02 + m21 * other.m12 + m22 * other.m22
+        );
+    }
+
+    constexpr float3x3 float3x3::operator*(float scalar) const noexcept
+    {
+        return float3x3
+        (
+            m00 * scalar, m01 * scalar, m02 * scalar,
+            m10 * scalar, m11 * scalar, m12 * scalar,
+            m20 * scalar, m21 * scalar, m22 * scalar
+        );
+    }
+
+    constexpr float3x3 float3x3::operator+(const float3x3& other) const noexcept
+    {
+        return float3x3
+        (
+            m00 + other.m00, m01 + other.m01, m02 + other.m02,
+            m10 + other.m10, m11 + other.m11, m12 + other.m12,
+            m20 + other.m20, m21 + other.m21, m22 + other.m22
+        );
+    }
+
+    constexpr float3x3 float3x3::operator-(const float3x3& other) const noexcept
+    {
+        return float3x3
+        (
+            m00 - other.m00, m01 - other.m01, m02 - other.m02,
+            m10 - other.m10, m11 - other.m11, m12 - other.m12,
+            m20 - other.m20, m21 - other.m21, m22 - other.m22
+        );
+    }
+
+    constexpr bool float3x3::operator==(const float3x3& other) const noexcept
+    {
+        return NearlyEqual(m00, other.m00) && NearlyEqual(m01, other.m01) && NearlyEqual(m02, other.m02) &&
+               NearlyEqual(m10, other.m10) && NearlyEqual(m11, other.m11) && NearlyEqual(m12, other.m12) &&
+               NearlyEqual(m20, other.m20) && NearlyEqual(m21, other.m21) && NearlyEqual(m22, other.m22);
+    }
+
+    constexpr float3x3 operator*(float scalar, const float3x3& mat) noexcept
+    {
+        return mat * scalar;
+    }
 
     // --------------------------------------------------------------------------
     // float4x4
@@ -286,37 +683,151 @@ namespace SGE
             float m[16]; // Row-major: [m00, m01, m02, m03, m10, m11, m12, m13, m20, m21, m22, m23, m30, m31, m32, m33]
         };
 
-        float4x4() noexcept;
-        float4x4(float m00, float m01, float m02, float m03, 
-                 float m10, float m11, float m12, float m13, 
-                 float m20, float m21, float m22, float m23, 
-                 float m30, float m31, float m32, float m33) noexcept;
-        float4x4(const float4& row0, const float4& row1, const float4& row2, const float4& row3) noexcept;
-
-        float* data() noexcept;
-        const float* data() const noexcept;
+        constexpr float4x4() noexcept
+        : m00(0), m01(0), m02(0), m03(0),
+          m10(0), m11(0), m12(0), m13(0),
+          m20(0), m21(0), m22(0), m23(0),
+          m30(0), m31(0), m32(0), m33(0) {}
+        constexpr float4x4(float m00, float m01, float m02, float m03,
+                           float m10, float m11, float m12, float m13,
+                           float m20, float m21, float m22, float m23,
+                           float m30, float m31, float m32, float m33) noexcept
+        : m00(m00), m01(m01), m02(m02), m03(m03),
+          m10(m10), m11(m11), m12(m12), m13(m13),
+          m20(m20), m21(m21), m22(m22), m23(m23),
+          m30(m30), m31(m31), m32(m32), m33(m33) {}
+        constexpr float4x4(const float4& row0, const float4& row1, const float4& row2, const float4& row3) noexcept
+        : m00(row0.x), m01(row0.y), m02(row0.z), m03(row0.w),
+          m10(row1.x), m11(row1.y), m12(row1.z), m13(row1.w),
+          m20(row2.x), m21(row2.y), m22(row2.z), m23(row2.w),
+          m30(row3.x), m31(row3.y), m32(row3.z), m33(row3.w) {}
+
+        float* data() noexcept { return m; }
+        const float* data() const noexcept { return m; }
 
         static const float4x4 Identity;
         static const float4x4 Zero;
 
+        // Multiplication, inversion and transposition run through the SIMD kernels and are
+        // therefore inline but not constexpr.
         float4x4 transposed() const noexcept;
-        float determinant() const noexcept;
+        constexpr float determinant() const noexcept;
         float4x4 inverse() const noexcept;
 
         float4 operator*(const float4& vec) const noexcept;
         float4x4 operator*(const float4x4& other) const noexcept;
         float4x4& operator*=(const float4x4& other) noexcept;
-        float4x4 operator*(float scalar) const noexcept;
-        float4x4& operator*=(float scalar) noexcept;
-        float4x4 operator+(const float4x4& other) const noexcept;
-        float4x4& operator+=(const float4x4& other) noexcept;
-        float4x4 operator-(const float4x4& other) const noexcept;
-        float4x4& operator-=(const float4x4& other) noexcept;
-        bool operator==(const float4x4& other) const noexcept;
-        bool operator!=(const float4x4& other) const noexcept;
+        constexpr float4x4 operator*(float scalar) const noexcept;
+        constexpr float4x4& operator*=(float scalar) noexcept { return *this = *this * scalar; }
+        constexpr float4x4 operator+(const float4x4& other) const noexcept;
+        constexpr float4x4& operator+=(const float4x4& other) noexcept { return *this = *this + other; }
+        constexpr float4x4 operator-(const float4x4& other) const noexcept;
+        constexpr float4x4& operator-=(const float4x4& other) noexcept { return *this = *this - other; }
+        constexpr bool operator==(const float4x4& other) const noexcept;
+        constexpr bool operator!=(const float4x4& other) const noexcept { return !(*this == other); }
     };
 
-    float4x4 operator*(float scalar, const float4x4& mat) noexcept;
+    inline constexpr float4x4 float4x4::Identity = float4x4(1.0f, 0.0f, 0.0f, 0.0f,
+                                                            0.0f, 1.0f, 0.0f, 0.0f,
+                                                            0.0f, 0.0f, 1.0f, 0.0f,
+                                                            0.0f, 0.0f, 0.0f, 1.0f);
+    inline constexpr float4x4 float4x4::Zero = float4x4(0.0f, 0.0f, 0.0f, 0.0f,
+                                                        0.0f, 0.0f, 0.0f, 0.0f,
+                                                        0.0f, 0.0f, 0.0f, 0.0f,
+                                                        0.0f, 0.0f, 0.0f, 0.0f);
+
+    inline float4x4 float4x4::transposed() const noexcept
+    {
+        float4x4 result;
+        MathKernels::Transpose(m, result.m);
+        return result;
+    }
+
+    constexpr float float4x4::determinant() const noexcept
+    {
+        return m00 * (m11 * (m22 * m33 - m23 * m32) - m12 * (m21 * m33 - m23 * m31) + m13 * (m21 * m32 - m22 * m31)) -
+               m01 * (m10 * (m22 * m33 - m23 * m32) - m12 * (m20 * m33 - m23 * m30) + m13 * (m20 * m32 - m22 * m30)) +
+               m02 * (m10 * (m21 * m33 - m23 * m31) - m11 * (m20 * m33 - m23 * m30) + m13 * (m20 * m31 - m21 * m30)) -
+               m03 * (m10 * (m21 * m32 - m22 * m31) - m11 * (m20 * m32 - m22 * m30) + m12 * (m20 * m31 - m21 * m30));
+    }
+
+    inline float4x4 float4x4::inverse() const noexcept
+    {
+        float4x4 result;
+        if (!MathKernels::Inverse(m, result.m))
+        {
+            return Zero;
+        }
+
+        return result;
+    }
+
+    inline float4 float4x4::operator*(const float4& vec) const noexcept
+    {
+        float4 result;
+        MathKernels::Transform(m, vec.components, result.components);
+        return result;
+    }
+
+    inline float4x4 float4x4::operator*(const float4x4& other) const noexcept
+    {
+        float4x4 result;
+        MathKernels::Multiply(m, other.m, result.m);
+        return result;
+    }
+
+    inline float4x4& float4x4::operator*=(const float4x4& other) noexcept
+    {
+        MathKernels::Multiply(m, other.m, m);
+        return *this;
+    }
+
+    constexpr float4x4 float4x4::operator*(float scalar) const noexcept
+    {
+        return float4x4
+        (
+            m00 * scalar, m01 * scalar, m02 * scalar, m03 * scalar,
+            m10 * scalar, m11 * scalar, m12 * scalar, m13 * scalar,
+            m20 * scalar, m21 * scalar, m22 * scalar, m23 * scalar,
+            m30 * scalar, m31 * scalar, m32 * scalar, m33 * scalar
+        );
+    }
+
+    constexpr float4x4 float4x4::operator+(const float4x4& other) const noexcept
+    {
+        return float4x4
+        (
+            m00 + other.m00, m01 + other.m01, m02 + other.m02, m03 + other.m03,
+            m10 + other.m10, m11 + other.m11, m12 + other.m12, m13 + other.m13,
+            m20 + other.m20, m21 + other.m21, m22 + other.m22, m23 + other.m23,
+            m30 + other.m30, m31 + other.m31, m32 + other.m32, m33 + other.m33
+        );
+    }
+
+    constexpr float4x4 float4x4::operator-(const float4x4& other) const noexcept
+    {
+        return float4x4
+        (
+            m00 - other.m00, m01 - other.m01, m02 - other.m02, m03 - other.m03,
+            m10 - other.m10, m11 - other.m11, m12 - other.m12, m13 - other.m13,
+            m20 - other.m20, m21 - other.m21, m22 - other.m22, m23 - other.m23,
+            m30 - other.m30, m31 - other.m31, m32 - other.m32, m33 - other.m33
+        );
+    }
+
+    constexpr bool float4x4::operator==(const float4x4& other) const noexcept
+    {
+        return NearlyEqual(m00, other.m00) && NearlyEqual(m01, other.m01) && NearlyEqual(m02, other.m02) && NearlyEqual(m03, other.m03) &&
+               NearlyEqual(m10, other.m10) && NearlyEqual(m11, other.m11) && NearlyEqual(m12, other.m12) && NearlyEqual(m13, other.m13) &&
+               NearlyEqual(m20, other.m20) && NearlyEqual(m21, other.m21) && NearlyEqual(m22, other.m22) && NearlyEqual(m23, other.m23) &&
+               NearlyEqual(m30, other.m30) && NearlyEqual(m31, other.m31) && NearlyEqual(m32, other.m32) && NearlyEqual(m33, other.m33);
+    }
+
+    constexpr float4x4 operator*(float scalar, const float4x4& mat) noexcept
+    {
+        return mat * scalar;
+    }
+
     std::ostream& operator<<(std::ostream& os, const float4x4& mat);
 
     // --------------------------------------------------------------------------
@@ -325,11 +836,42 @@ namespace SGE
 
     float4x4 CreateViewMatrix(const float3& eye, const float3& target, const float3& up) noexcept;
     float4x4 CreatePerspectiveProjectionMatrix(float fov, float aspectRatio, float nearZ, float farZ) noexcept;
-    float4x4 CreateTranslationMatrix(const float3& translation) noexcept;
     float4x4 CreateRotationMatrixYawPitchRoll(float yaw, float pitch, float roll) noexcept;
-    float4x4 CreateScaleMatrix(const float3& scale) noexcept;
-    float4x4 CreateRotationMatrixFromQuaternion(const float4& quaternion) noexcept;
+    float4 CreateQuaternionYawPitchRoll(float yaw, float pitch, float roll) noexcept;
+    float4 CreateQuaternionFromRotationMatrix(const float4x4& matrix) noexcept;
+
+    // Splits an affine transform without shear into translation, rotation quaternion and scale.
+    void DecomposeMatrix(const float4x4& matrix, float3& translation, float4& rotation, float3& scale) noexcept;
     float4x4 CreateOrthographicProjectionMatrix(float width, float height, float nearZ, float farZ) noexcept;
+
+    constexpr float4x4 CreateTranslationMatrix(const float3& translation) noexcept
+    {
+        return float4x4
+        (
+            1.0f, 0.0f, 0.0f, translation.x,
+            0.0f, 1.0f, 0.0f, translation.y,
+            0.0f, 0.0f, 1.0f, translation.z,
+            0.0f, 0.0f, 0.0f, 1.0f
+        );
+    }
+
+    constexpr float4x4 CreateScaleMatrix(const float3& scale) noexcept
+    {
+        return float4x4
+        (
+            scale.x, 0.0f,    0.0f,    0.0f,
+            0.0f,    scale.y, 0.0f,    0.0f,
+            0.0f,    0.0f,    scale.z, 0.0f,
+            0.0f,    0.0f,    0.0f,    1.0f
+        );
+    }
+
+    inline float4x4 CreateRotationMatrixFromQuaternion(const float4& quaternion) noexcept
+    {
+        float4x4 result;
+        MathKernels::QuaternionToMatrix(quaternion.components, result.m);
+        return result;
+    }
 }
 
 #endif // !_SGE_MATH_H_
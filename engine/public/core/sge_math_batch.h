@@ -0,0 +1,270 @@
+#ifndef _SGE_MATH_BATCH_H_
+#define _SGE_MATH_BATCH_H_
+
+#include <vector>
+#include "core/sge_math.h"
+#include "core/sge_math_kernels.h"
+#include "core/sge_span.h"
+
+// Batched structure-of-arrays math. Every kernel processes BatchLanes::Width elements per
+// instruction (8 with AVX2, 4 with SSE/NEON) and finishes the remainder with the scalar lanes.
+
+namespace SGE
+{
+    // --------------------------------------------------------------------------
+    // containers
+    // --------------------------------------------------------------------------
+
+    struct float3_soa
+    {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+
+        size_t size() const noexcept { return x.size(); }
+        bool empty() const noexcept { return x.empty(); }
+
+        void resize(size_t count) { x.resize(count); y.resize(count); z.resize(count); }
+        void reserve(size_t count) { x.reserve(count); y.reserve(count); z.reserve(count); }
+        void clear() noexcept { x.clear(); y.clear(); z.clear(); }
+
+        void push_back(const float3& value) { x.push_back(value.x); y.push_back(value.y); z.push_back(value.z); }
+        void set(size_t index, const float3& value) noexcept { x[index] = value.x; y[index] = value.y; z[index] = value.z; }
+        float3 get(size_t index) const noexcept { return float3(x[index], y[index], z[index]); }
+    };
+
+    struct float4_soa
+    {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+        std::vector<float> w;
+
+        size_t size() const noexcept { return x.size(); }
+        bool empty() const noexcept { return x.empty(); }
+
+        void resize(size_t count) { x.resize(count); y.resize(count); z.resize(count); w.resize(count); }
+        void reserve(size_t count) { x.reserve(count); y.reserve(count); z.reserve(count); w.reserve(count); }
+        void clear() noexcept { x.clear(); y.clear(); z.clear(); w.clear(); }
+
+        void push_back(const float4& value) { x.push_back(value.x); y.push_back(value.y); z.push_back(value.z); w.push_back(value.w); }
+        void set(size_t index, const float4& value) noexcept { x[index] = value.x; y[index] = value.y; z[index] = value.z; w[index] = value.w; }
+        float4 get(size_t index) const noexcept { return float4(x[index], y[index], z[index], w[index]); }
+    };
+
+    // Matrices stay array-of-structures: they are consumed as-is by constant buffers.
+    using float4x4_array = std::vector<float4x4>;
+
+    // --------------------------------------------------------------------------
+    // lanes
+    // --------------------------------------------------------------------------
+
+    namespace BatchDetail
+    {
+        struct ScalarLanes
+        {
+            using type = float;
+            static constexpr size_t Width = 1;
+
+            static type Load(const float* p) noexcept { return *p; }
+            static void Store(float* p, type v) noexcept { *p = v; }
+            static type Set(float v) noexcept { return v; }
+            static type Add(type a, type b) noexcept { return a + b; }
+            static type Sub(type a, type b) noexcept { return a - b; }
+            static type Mul(type a, type b) noexcept { return a * b; }
+            static type MulAdd(type a, type b, type c) noexcept { return a * b + c; }
+            static type Min(type a, type b) noexcept { return std::min(a, b); }
+            // Bit i is set when lane i is below zero.
+            static int NegativeMask(type v) noexcept { return v < 0.0f ? 1 : 0; }
+        };
+
+#if defined(SGE_SIMD_AVX2)
+        struct SimdLanes
+        {
+            using type = __m256;
+            static constexpr size_t Width = 8;
+
+            static SGE_FORCE_INLINE type Load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+            static SGE_FORCE_INLINE void Store(float* p, type v) noexcept { _mm256_storeu_ps(p, v); }
+            static SGE_FORCE_INLINE type Set(float v) noexcept { return _mm256_set1_ps(v); }
+            static SGE_FORCE_INLINE type Add(type a, type b) noexcept { return _mm256_add_ps(a, b); }
+            static SGE_FORCE_INLINE type Sub(type a, type b) noexcept { return _mm256_sub_ps(a, b); }
+            static SGE_FORCE_INLINE type Mul(type a, type b) noexcept { return _mm256_mul_ps(a, b); }
+            static SGE_FORCE_INLINE type MulAdd(type a, type b, type c) noexcept { return _mm256_fmadd_ps(a, b, c); }
+            static SGE_FORCE_INLINE type Min(type a, type b) noexcept { return _mm256_min_ps(a, b); }
+            static SGE_FORCE_INLINE int NegativeMask(type v) noexcept { return _mm256_movemask_ps(_mm256_cmp_ps(v, _mm256_setzero_ps(), _CMP_LT_OQ)); }
+        };
+#elif defined(SGE_SIMD_SSE)
+        struct SimdLanes
+        {
+            using type = __m128;
+            static constexpr size_t Width = 4;
+
+            static SGE_FORCE_INLINE type Load(const float* p) noexcept { return _mm_loadu_ps(p); }
+            static SGE_FORCE_INLINE void Store(float* p, type v) noexcept { _mm_storeu_ps(p, v); }
+            static SGE_FORCE_INLINE type Set(float v) noexcept { return _mm_set1_ps(v); }
+            static SGE_FORCE_INLINE type Add(type a, type b) noexcept { return _mm_add_ps(a, b); }
+            static SGE_FORCE_INLINE type Sub(type a, type b) noexcept { return _mm_sub_ps(a, b); }
+            static SGE_FORCE_INLINE type Mul(type a, type b) noexcept { return _mm_mul_ps(a, b); }
+            static SGE_FORCE_INLINE type MulAdd(type a, type b, type c) noexcept { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+            static SGE_FORCE_INLINE type Min(type a, type b) noexcept { return _mm_min_ps(a, b); }
+            static SGE_FORCE_INLINE int NegativeMask(type v) noexcept { return _mm_movemask_ps(_mm_cmplt_ps(v, _mm_setzero_ps())); }
+        };
+#elif defined(SGE_SIMD_NEON)
+        struct SimdLanes
+        {
+            using type = float32x4_t;
+            static constexpr size_t Width = 4;
+
+            static SGE_FORCE_INLINE type Load(const float* p) noexcept { return vld1q_f32(p); }
+            static SGE_FORCE_INLINE void Store(float* p, type v) noexcept { vst1q_f32(p, v); }
+            static SGE_FORCE_INLINE type Set(float v) noexcept { return vdupq_n_f32(v); }
+            static SGE_FORCE_INLINE type Add(type a, type b) noexcept { return vaddq_f32(a, b); }
+            static SGE_FORCE_INLINE type Sub(type a, type b) noexcept { return vsubq_f32(a, b); }
+            static SGE_FORCE_INLINE type Mul(type a, type b) noexcept { return vmulq_f32(a, b); }
+            static SGE_FORCE_INLINE type MulAdd(type a, type b, type c) noexcept { return vfmaq_f32(c, a, b); }
+            static SGE_FORCE_INLINE type Min(type a, type b) noexcept { return vminq_f32(a, b); }
+            static SGE_FORCE_INLINE int NegativeMask(type v) noexcept
+            {
+                static const uint32x4_t bits = { 1, 2, 4, 8 };
+                return static_cast<int>(vaddvq_u32(vandq_u32(vcltq_f32(v, vdupq_n_f32(0.0f)), bits)));
+            }
+        };
+#else
+        using SimdLanes = ScalarLanes;
+#endif
+
+        template<typename L>
+        SGE_FORCE_INLINE size_t TransformLanes(const float4x4& m, const float3_soa& in, float3_soa& out, size_t begin, float w) noexcept
+        {
+            using V = typename L::type;
+            const size_t count = in.size();
+
+            const V m00 = L::Set(m.m00), m01 = L::Set(m.m01), m02 = L::Set(m.m02), m03 = L::Set(m.m03 * w);
+            const V m10 = L::Set(m.m10), m11 = L::Set(m.m11), m12 = L::Set(m.m12), m13 = L::Set(m.m13 * w);
+            const V m20 = L::Set(m.m20), m21 = L::Set(m.m21), m22 = L::Set(m.m22), m23 = L::Set(m.m23 * w);
+
+            size_t i = begin;
+            for (; i + L::Width <= count; i += L::Width)
+            {
+                const V x = L::Load(&in.x[i]);
+                const V y = L::Load(&in.y[i]);
+                const V z = L::Load(&in.z[i]);
+
+                L::Store(&out.x[i], L::MulAdd(m00, x, L::MulAdd(m01, y, L::MulAdd(m02, z, m03))));
+                L::Store(&out.y[i], L::MulAdd(m10, x, L::MulAdd(m11, y, L::MulAdd(m12, z, m13))));
+                L::Store(&out.z[i], L::MulAdd(m20, x, L::MulAdd(m21, y, L::MulAdd(m22, z, m23))));
+            }
+            return i;
+        }
+
+        template<typename L>
+        SGE_FORCE_INLINE size_t ComposeTRSLanes(const float3_soa& positions, const float4_soa& rotations, const float3_soa& scales, Span<float4x4> out, size_t begin) noexcept
+        {
+            using V = typename L::type;
+            const size_t count = positions.size();
+            const V one = L::Set(1.0f);
+            const V two = L::Set(2.0f);
+
+            size_t i = begin;
+            for (; i + L::Width <= count; i += L::Width)
+            {
+                const V qx = L::Load(&rotations.x[i]);
+                const V qy = L::Load(&rotations.y[i]);
+                const V qz = L::Load(&rotations.z[i]);
+                const V qw = L::Load(&rotations.w[i]);
+
+                const V x2 = L::Mul(qx, two), y2 = L::Mul(qy, two), z2 = L::Mul(qz, two);
+                const V xx = L::Mul(qx, x2), yy = L::Mul(qy, y2), zz = L::Mul(qz, z2);
+                const V xy = L::Mul(qx, y2), xz = L::Mul(qx, z2), yz = L::Mul(qy, z2);
+                const V wx = L::Mul(qw, x2), wy = L::Mul(qw, y2), wz = L::Mul(qw, z2);
+
+                const V sx = L::Load(&scales.x[i]);
+                const V sy = L::Load(&scales.y[i]);
+                const V sz = L::Load(&scales.z[i]);
+
+                // Rotation columns scaled by the matching scale component, translation in the last column.
+                float elements[12][L::Width];
+                L::Store(elements[0],  L::Mul(L::Sub(one, L::Add(yy, zz)), sx));
+                L::Store(elements[1],  L::Mul(L::Sub(xy, wz), sy));
+                L::Store(elements[2],  L::Mul(L::Add(xz, wy), sz));
+                L::Store(elements[3],  L::Load(&positions.x[i]));
+                L::Store(elements[4],  L::Mul(L::Add(xy, wz), sx));
+                L::Store(elements[5],  L::Mul(L::Sub(one, L::Add(xx, zz)), sy));
+                L::Store(elements[6],  L::Mul(L::Sub(yz, wx), sz));
+                L::Store(elements[7],  L::Load(&positions.y[i]));
+                L::Store(elements[8],  L::Mul(L::Sub(xz, wy), sx));
+                L::Store(elements[9],  L::Mul(L::Add(yz, wx), sy));
+                L::Store(elements[10], L::Mul(L::Sub(one, L::Add(xx, yy)), sz));
+                L::Store(elements[11], L::Load(&positions.z[i]));
+
+                for (size_t lane = 0; lane < L::Width; ++lane)
+                {
+                    float* m = out[i + lane].m;
+                    for (size_t e = 0; e < 12; ++e)
+                    {
+                        m[e] = elements[e][lane];
+                    }
+                    m[12] = 0.0f; m[13] = 0.0f; m[14] = 0.0f; m[15] = 1.0f;
+                }
+            }
+            return i;
+        }
+    }
+
+    using BatchLanes = BatchDetail::SimdLanes;
+
+    // --------------------------------------------------------------------------
+    // kernels
+    // --------------------------------------------------------------------------
+
+    // out[i] = a[i] * b[i]. out may alias a or b.
+    inline void MultiplyMatrices(Span<const float4x4> a, Span<const float4x4> b, Span<float4x4> out) noexcept
+    {
+        const size_t count = std::min(std::min(a.size(), b.size()), out.size());
+        for (size_t i = 0; i < count; ++i)
+        {
+            MathKernels::Multiply(a[i].m, b[i].m, out[i].m);
+        }
+    }
+
+    // out[i] = lhs * b[i]. out may alias b.
+    inline void MultiplyMatrices(const float4x4& lhs, Span<const float4x4> b, Span<float4x4> out) noexcept
+    {
+        const size_t count = std::min(b.size(), out.size());
+        for (size_t i = 0; i < count; ++i)
+        {
+            MathKernels::Multiply(lhs.m, b[i].m, out[i].m);
+        }
+    }
+
+    // Transforms points (w = 1) without perspective divide. out is resized to match points and may be the same object.
+    inline void TransformPoints(const float4x4& m, const float3_soa& points, float3_soa& out)
+    {
+        out.resize(points.size());
+        size_t i = BatchDetail::TransformLanes<BatchDetail::SimdLanes>(m, points, out, 0, 1.0f);
+        BatchDetail::TransformLanes<BatchDetail::ScalarLanes>(m, points, out, i, 1.0f);
+    }
+
+    // Transforms directions (w = 0), translation is ignored.
+    inline void TransformDirections(const float4x4& m, const float3_soa& directions, float3_soa& out)
+    {
+        out.resize(directions.size());
+        size_t i = BatchDetail::TransformLanes<BatchDetail::SimdLanes>(m, directions, out, 0, 0.0f);
+        BatchDetail::TransformLanes<BatchDetail::ScalarLanes>(m, directions, out, i, 0.0f);
+    }
+
+    // out[i] = T(positions[i]) * R(rotations[i]) * S(scales[i]). All inputs must have the same size and out at least as many elements.
+    inline void ComposeTRS(const float3_soa& positions, const float4_soa& rotations, const float3_soa& scales, Span<float4x4> out) noexcept
+    {
+        if (rotations.size() < positions.size() || scales.size() < positions.size() || out.size() < positions.size())
+        {
+            return;
+        }
+
+        size_t i = BatchDetail::ComposeTRSLanes<BatchDetail::SimdLanes>(positions, rotations, scales, out, 0);
+        BatchDetail::ComposeTRSLanes<BatchDetail::ScalarLanes>(positions, rotations, scales, out, i);
+    }
+}
+
+#endif // !_SGE_MATH_BATCH_H_
@@ -0,0 +1,341 @@
+#ifndef _SGE_MATH_KERNELS_H_
+#define _SGE_MATH_KERNELS_H_
+
+#include <algorithm>
+#include "core/sge_simd.h"
+
+// Raw float4x4 kernels on row-major float[16] storage (column-vector convention, v' = M * v).
+// Matrix pointers must be 16-byte aligned, vector pointers may be unaligned.
+// Shared by the float4x4 operators and the batched API in sge_math_batch.h.
+
+namespace SGE
+{
+    namespace MathKernels
+    {
+#if defined(SGE_SIMD_SSE)
+        SGE_FORCE_INLINE __m128 Splat(__m128 v, int lane) noexcept
+        {
+            switch (lane)
+            {
+            case 0:  return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+            case 1:  return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+            case 2:  return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+            default: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+            }
+        }
+
+        SGE_FORCE_INLINE __m128 LinearCombine(__m128 a, __m128 b0, __m128 b1, __m128 b2, __m128 b3) noexcept
+        {
+            __m128 result = _mm_mul_ps(Splat(a, 0), b0);
+            result = _mm_add_ps(result, _mm_mul_ps(Splat(a, 1), b1));
+            result = _mm_add_ps(result, _mm_mul_ps(Splat(a, 2), b2));
+            result = _mm_add_ps(result, _mm_mul_ps(Splat(a, 3), b3));
+            return result;
+        }
+
+        // 2x2 row-major helpers for the block-wise inverse (A, B, C, D sub-matrices).
+        SGE_FORCE_INLINE __m128 Mat2Mul(__m128 a, __m128 b) noexcept
+        {
+            return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+                              _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+        }
+
+        SGE_FORCE_INLINE __m128 Mat2AdjMul(__m128 a, __m128 b) noexcept
+        {
+            return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+                              _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+
+        SGE_FORCE_INLINE __m128 Mat2MulAdj(__m128 a, __m128 b) noexcept
+        {
+            return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+                              _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+        }
+#endif
+
+        inline void Multiply(const float* a, const float* b, float* out) noexcept
+        {
+#if defined(SGE_SIMD_AVX2)
+            const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 0));
+            const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 4));
+            const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 8));
+            const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b + 12));
+
+            for (int rows = 0; rows < 16; rows += 8)
+            {
+                const __m256 a01 = _mm256_loadu_ps(a + rows);
+                __m256 result = _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+                result = _mm256_fmadd_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(1, 1, 1, 1)), b1, result);
+                result = _mm256_fmadd_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(2, 2, 2, 2)), b2, result);
+                result = _mm256_fmadd_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(3, 3, 3, 3)), b3, result);
+                _mm256_storeu_ps(out + rows, result);
+            }
+#elif defined(SGE_SIMD_SSE)
+            const __m128 b0 = _mm_load_ps(b + 0);
+            const __m128 b1 = _mm_load_ps(b + 4);
+            const __m128 b2 = _mm_load_ps(b + 8);
+            const __m128 b3 = _mm_load_ps(b + 12);
+
+            const __m128 r0 = LinearCombine(_mm_load_ps(a + 0), b0, b1, b2, b3);
+            const __m128 r1 = LinearCombine(_mm_load_ps(a + 4), b0, b1, b2, b3);
+            const __m128 r2 = LinearCombine(_mm_load_ps(a + 8), b0, b1, b2, b3);
+            const __m128 r3 = LinearCombine(_mm_load_ps(a + 12), b0, b1, b2, b3);
+
+            _mm_store_ps(out + 0, r0);
+            _mm_store_ps(out + 4, r1);
+            _mm_store_ps(out + 8, r2);
+            _mm_store_ps(out + 12, r3);
+#elif defined(SGE_SIMD_NEON)
+            const float32x4_t b0 = vld1q_f32(b + 0);
+            const float32x4_t b1 = vld1q_f32(b + 4);
+            const float32x4_t b2 = vld1q_f32(b + 8);
+            const float32x4_t b3 = vld1q_f32(b + 12);
+
+            float32x4_t rows[4];
+            for (int i = 0; i < 4; ++i)
+            {
+                const float32x4_t row = vld1q_f32(a + i * 4);
+                float32x4_t result = vmulq_laneq_f32(b0, row, 0);
+                result = vfmaq_laneq_f32(result, b1, row, 1);
+                result = vfmaq_laneq_f32(result, b2, row, 2);
+                result = vfmaq_laneq_f32(result, b3, row, 3);
+                rows[i] = result;
+            }
+
+            for (int i = 0; i < 4; ++i)
+            {
+                vst1q_f32(out + i * 4, rows[i]);
+            }
+#else
+            float result[16];
+            for (int row = 0; row < 4; ++row)
+            {
+                for (int col = 0; col < 4; ++col)
+                {
+                    result[row * 4 + col] = a[row * 4 + 0] * b[0 * 4 + col] +
+                                            a[row * 4 + 1] * b[1 * 4 + col] +
+                                            a[row * 4 + 2] * b[2 * 4 + col] +
+                                            a[row * 4 + 3] * b[3 * 4 + col];
+                }
+            }
+            std::copy(result, result + 16, out);
+#endif
+        }
+
+        inline void Transpose(const float* m, float* out) noexcept
+        {
+#if defined(SGE_SIMD_SSE)
+            __m128 r0 = _mm_load_ps(m + 0);
+            __m128 r1 = _mm_load_ps(m + 4);
+            __m128 r2 = _mm_load_ps(m + 8);
+            __m128 r3 = _mm_load_ps(m + 12);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_store_ps(out + 0, r0);
+            _mm_store_ps(out + 4, r1);
+            _mm_store_ps(out + 8, r2);
+            _mm_store_ps(out + 12, r3);
+#elif defined(SGE_SIMD_NEON)
+            const float32x4x4_t columns = vld4q_f32(m);
+            vst1q_f32(out + 0, columns.val[0]);
+            vst1q_f32(out + 4, columns.val[1]);
+            vst1q_f32(out + 8, columns.val[2]);
+            vst1q_f32(out + 12, columns.val[3]);
+#else
+            float result[16];
+            for (int row = 0; row < 4; ++row)
+            {
+                for (int col = 0; col < 4; ++col)
+                {
+                    result[col * 4 + row] = m[row * 4 + col];
+                }
+            }
+            std::copy(result, result + 16, out);
+#endif
+        }
+
+        inline void Transform(const float* m, const float* v, float* out) noexcept
+        {
+#if defined(SGE_SIMD_SSE)
+            const __m128 vec = _mm_loadu_ps(v);
+            __m128 p0 = _mm_mul_ps(_mm_load_ps(m + 0), vec);
+            __m128 p1 = _mm_mul_ps(_mm_load_ps(m + 4), vec);
+            __m128 p2 = _mm_mul_ps(_mm_load_ps(m + 8), vec);
+            __m128 p3 = _mm_mul_ps(_mm_load_ps(m + 12), vec);
+            _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+            _mm_storeu_ps(out, _mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3)));
+#elif defined(SGE_SIMD_NEON)
+            const float32x4x4_t columns = vld4q_f32(m);
+            const float32x4_t vec = vld1q_f32(v);
+            float32x4_t result = vmulq_laneq_f32(columns.val[0], vec, 0);
+            result = vfmaq_laneq_f32(result, columns.val[1], vec, 1);
+            result = vfmaq_laneq_f32(result, columns.val[2], vec, 2);
+            result = vfmaq_laneq_f32(result, columns.val[3], vec, 3);
+            vst1q_f32(out, result);
+#else
+            float result[4];
+            for (int row = 0; row < 4; ++row)
+            {
+                result[row] = m[row * 4 + 0] * v[0] + m[row * 4 + 1] * v[1] + m[row * 4 + 2] * v[2] + m[row * 4 + 3] * v[3];
+            }
+            std::copy(result, result + 4, out);
+#endif
+        }
+
+        // Returns false for singular matrices, out is left untouched in that case.
+        inline bool Inverse(const float* m, float* out) noexcept
+        {
+#if defined(SGE_SIMD_SSE)
+            const __m128 r0 = _mm_load_ps(m + 0);
+            const __m128 r1 = _mm_load_ps(m + 4);
+            const __m128 r2 = _mm_load_ps(m + 8);
+            const __m128 r3 = _mm_load_ps(m + 12);
+
+            // 2x2 sub-matrices: | A B |
+            //                   | C D |
+            const __m128 A = _mm_movelh_ps(r0, r1);
+            const __m128 B = _mm_movehl_ps(r1, r0);
+            const __m128 C = _mm_movelh_ps(r2, r3);
+            const __m128 D = _mm_movehl_ps(r3, r2);
+
+            // (|A|, |B|, |C|, |D|)
+            const __m128 detSub = _mm_sub_ps(
+                _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+                _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+
+            const __m128 detA = Splat(detSub, 0);
+            const __m128 detB = Splat(detSub, 1);
+            const __m128 detC = Splat(detSub, 2);
+            const __m128 detD = Splat(detSub, 3);
+
+            const __m128 D_C = Mat2AdjMul(D, C);
+            const __m128 A_B = Mat2AdjMul(A, B);
+
+            __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Mul(B, D_C));
+            __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Mul(C, A_B));
+            __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MulAdj(D, A_B));
+            __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MulAdj(A, D_C));
+
+            __m128 trace = _mm_mul_ps(A_B, _mm_shuffle_ps(D_C, D_C, _MM_SHUFFLE(3, 1, 2, 0)));
+            trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(2, 3, 0, 1)));
+            trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(1, 0, 3, 2)));
+
+            __m128 detM = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+            detM = _mm_sub_ps(detM, trace);
+
+            if (_mm_cvtss_f32(detM) == 0.0f)
+            {
+                return false;
+            }
+
+            const __m128 invDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+            X = _mm_mul_ps(X, invDetM);
+            Y = _mm_mul_ps(Y, invDetM);
+            Z = _mm_mul_ps(Z, invDetM);
+            W = _mm_mul_ps(W, invDetM);
+
+            _mm_store_ps(out + 0, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(1, 3, 1, 3)));
+            _mm_store_ps(out + 4, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(0, 2, 0, 2)));
+            _mm_store_ps(out + 8, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(1, 3, 1, 3)));
+            _mm_store_ps(out + 12, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(0, 2, 0, 2)));
+            return true;
+#else
+            const float s0 = m[0] * m[5] - m[4] * m[1];
+            const float s1 = m[0] * m[6] - m[4] * m[2];
+            const float s2 = m[0] * m[7] - m[4] * m[3];
+            const float s3 = m[1] * m[6] - m[5] * m[2];
+            const float s4 = m[1] * m[7] - m[5] * m[3];
+            const float s5 = m[2] * m[7] - m[6] * m[3];
+
+            const float c5 = m[10] * m[15] - m[14] * m[11];
+            const float c4 = m[9] * m[15] - m[13] * m[11];
+            const float c3 = m[9] * m[14] - m[13] * m[10];
+            const float c2 = m[8] * m[15] - m[12] * m[11];
+            const float c1 = m[8] * m[14] - m[12] * m[10];
+            const float c0 = m[8] * m[13] - m[12] * m[9];
+
+            const float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+            if (det == 0.0f)
+            {
+                return false;
+            }
+
+            const float invDet = 1.0f / det;
+
+            out[0]  = ( m[5] * c5 - m[6] * c4 + m[7] * c3) * invDet;
+            out[1]  = (-m[1] * c5 + m[2] * c4 - m[3] * c3) * invDet;
+            out[2]  = ( m[13] * s5 - m[14] * s4 + m[15] * s3) * invDet;
+            out[3]  = (-m[9] * s5 + m[10] * s4 - m[11] * s3) * invDet;
+
+            out[4]  = (-m[4] * c5 + m[6] * c2 - m[7] * c1) * invDet;
+            out[5]  = ( m[0] * c5 - m[2] * c2 + m[3] * c1) * invDet;
+            out[6]  = (-m[12] * s5 + m[14] * s2 - m[15] * s1) * invDet;
+            out[7]  = ( m[8] * s5 - m[10] * s2 + m[11] * s1) * invDet;
+
+            out[8]  = ( m[4] * c4 - m[5] * c2 + m[7] * c0) * invDet;
+            out[9]  = (-m[0] * c4 + m[1] * c2 - m[3] * c0) * invDet;
+            out[10] = ( m[12] * s4 - m[13] * s2 + m[15] * s0) * invDet;
+            out[11] = (-m[8] * s4 + m[9] * s2 - m[11] * s0) * invDet;
+
+            out[12] = (-m[4] * c3 + m[5] * c1 - m[6] * c0) * invDet;
+            out[13] = ( m[0] * c3 - m[1] * c1 + m[2] * c0) * invDet;
+            out[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) * invDet;
+            out[15] = ( m[8] * s3 - m[9] * s1 + m[10] * s0) * invDet;
+            return true;
+#endif
+        }
+
+        inline void QuaternionToMatrix(const float* q, float* out) noexcept
+        {
+#if defined(SGE_SIMD_SSE)
+            const __m128 quat = _mm_loadu_ps(q);
+            const __m128 mask3 = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
+            const __m128 q0 = _mm_add_ps(quat, quat);
+            const __m128 q1 = _mm_mul_ps(quat, q0);
+
+            // (1 - 2yy - 2zz, 1 - 2xx - 2zz, 1 - 2xx - 2yy, 0)
+            __m128 v0 = _mm_and_ps(_mm_shuffle_ps(q1, q1, _MM_SHUFFLE(3, 0, 0, 1)), mask3);
+            __m128 v1 = _mm_and_ps(_mm_shuffle_ps(q1, q1, _MM_SHUFFLE(3, 1, 2, 2)), mask3);
+            const __m128 diagonal = _mm_sub_ps(_mm_sub_ps(_mm_setr_ps(1.0f, 1.0f, 1.0f, 0.0f), v0), v1);
+
+            // (2xz, 2xy, 2yz) +/- (2wy, 2wz, 2wx)
+            v0 = _mm_mul_ps(_mm_shuffle_ps(quat, quat, _MM_SHUFFLE(3, 1, 0, 0)), _mm_shuffle_ps(q0, q0, _MM_SHUFFLE(3, 2, 1, 2)));
+            v1 = _mm_mul_ps(_mm_shuffle_ps(quat, quat, _MM_SHUFFLE(3, 3, 3, 3)), _mm_shuffle_ps(q0, q0, _MM_SHUFFLE(3, 0, 2, 1)));
+            const __m128 sum = _mm_add_ps(v0, v1);
+            const __m128 diff = _mm_sub_ps(v0, v1);
+
+            // (sum.y, diff.x, diff.y, sum.z) and (sum.x, diff.z, sum.x, diff.z)
+            __m128 t = _mm_shuffle_ps(sum, diff, _MM_SHUFFLE(1, 0, 2, 1));
+            const __m128 p0 = _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 3, 2, 0));
+            t = _mm_shuffle_ps(sum, diff, _MM_SHUFFLE(2, 2, 0, 0));
+            const __m128 p1 = _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 0, 2, 0));
+
+            // Rows for the row-vector convention, transposed below into our column-vector layout.
+            t = _mm_shuffle_ps(diagonal, p0, _MM_SHUFFLE(1, 0, 3, 0));
+            __m128 r0 = _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 3, 2, 0));
+            t = _mm_shuffle_ps(diagonal, p0, _MM_SHUFFLE(3, 2, 3, 1));
+            __m128 r1 = _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 3, 0, 2));
+            __m128 r2 = _mm_shuffle_ps(p1, diagonal, _MM_SHUFFLE(3, 2, 1, 0));
+            __m128 r3 = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_store_ps(out + 0, r0);
+            _mm_store_ps(out + 4, r1);
+            _mm_store_ps(out + 8, r2);
+            _mm_store_ps(out + 12, r3);
+#else
+            const float x = q[0], y = q[1], z = q[2], w = q[3];
+            const float xx = x * x, yy = y * y, zz = z * z;
+            const float xy = x * y, xz = x * z, yz = y * z;
+            const float wx = w * x, wy = w * y, wz = w * z;
+
+            out[0]  = 1.0f - 2.0f * (yy + zz); out[1]  = 2.0f * (xy - wz);        out[2]  = 2.0f * (xz + wy);        out[3]  = 0.0f;
+            out[4]  = 2.0f * (xy + wz);        out[5]  = 1.0f - 2.0f * (xx + zz); out[6]  = 2.0f * (yz - wx);        out[7]  = 0.0f;
+            out[8]  = 2.0f * (xz - wy);        out[9]  = 2.0f * (yz + wx);        out[10] = 1.0f - 2.0f * (xx + yy); out[11] = 0.0f;
+            out[12] = 0.0f;                    out[13] = 0.0f;                    out[14] = 0.0f;                    out[15] = 1.0f;
+#endif
+        }
+    }
+}
+
+#endif // !_SGE_MATH_KERNELS_H_
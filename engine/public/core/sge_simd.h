@@ -0,0 +1,50 @@
+#ifndef _SGE_SIMD_H_
+#define _SGE_SIMD_H_
+
+// Instruction set selection for the math kernels.
+// SGE_SIMD_SSE  - x86/x64, SSE2 baseline (always available on x64 targets).
+// SGE_SIMD_AVX2 - additionally enabled when the compiler targets AVX2 (/arch:AVX2, -mavx2).
+// SGE_SIMD_NEON - AArch64 NEON.
+// Define SGE_MATH_NO_SIMD to force the portable scalar path.
+
+#if !defined(SGE_MATH_NO_SIMD)
+    #if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+        #define SGE_SIMD_SSE 1
+        #include <emmintrin.h>
+        #if defined(__AVX2__)
+            #define SGE_SIMD_AVX2 1
+            #include <immintrin.h>
+        #endif
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+        #define SGE_SIMD_NEON 1
+        #include <arm_neon.h>
+    #endif
+#endif
+
+#if !defined(SGE_SIMD_SSE) && !defined(SGE_SIMD_NEON)
+    #define SGE_SIMD_SCALAR 1
+#endif
+
+#if defined(_MSC_VER)
+    #define SGE_FORCE_INLINE __forceinline
+#else
+    #define SGE_FORCE_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace SGE
+{
+    constexpr const char* GetSimdInstructionSetName() noexcept
+    {
+#if defined(SGE_SIMD_AVX2)
+        return "AVX2";
+#elif defined(SGE_SIMD_SSE)
+        return "SSE2";
+#elif defined(SGE_SIMD_NEON)
+        return "NEON";
+#else
+        return "Scalar";
+#endif
+    }
+}
+
+#endif // !_SGE_SIMD_H_
@@ -0,0 +1,52 @@
+#ifndef _SGE_SPAN_H_
+#define _SGE_SPAN_H_
+
+#include <cstddef>
+#include <vector>
+#include <type_traits>
+
+namespace SGE
+{
+    // Non-owning view over a contiguous range, a C++17 stand-in for std::span.
+    template<typename T>
+    class Span
+    {
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+
+        constexpr Span() noexcept = default;
+        constexpr Span(T* data, size_t size) noexcept : m_data(data), m_size(size) {}
+
+        template<typename U, typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+        constexpr Span(const Span<U>& other) noexcept : m_data(other.data()), m_size(other.size()) {}
+
+        template<typename U, typename Alloc, typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+        Span(std::vector<U, Alloc>& vec) noexcept : m_data(vec.data()), m_size(vec.size()) {}
+
+        template<typename U, typename Alloc, typename = std::enable_if_t<std::is_convertible_v<const U(*)[], T(*)[]>>>
+        Span(const std::vector<U, Alloc>& vec) noexcept : m_data(vec.data()), m_size(vec.size()) {}
+
+        template<size_t N>
+        constexpr Span(T (&array)[N]) noexcept : m_data(array), m_size(N) {}
+
+        constexpr T* data() const noexcept { return m_data; }
+        constexpr size_t size() const noexcept { return m_size; }
+        constexpr size_t size_bytes() const noexcept { return m_size * sizeof(T); }
+        constexpr bool empty() const noexcept { return m_size == 0; }
+
+        constexpr T* begin() const noexcept { return m_data; }
+        constexpr T* end() const noexcept { return m_data + m_size; }
+
+        constexpr T& operator[](size_t index) const noexcept { return m_data[index]; }
+
+        constexpr Span subspan(size_t offset, size_t count) const noexcept { return Span(m_data + offset, count); }
+        constexpr Span first(size_t count) const noexcept { return Span(m_data, count); }
+
+    private:
+        T* m_data = nullptr;
+        size_t m_size = 0;
+    };
+}
+
+#endif // !_SGE_SPAN_H_
@@ -0,0 +1,81 @@
+#ifndef _SGE_TRANSFORM_HIERARCHY_H_
+#define _SGE_TRANSFORM_HIERARCHY_H_
+
+#include <vector>
+#include "core/sge_math_batch.h"
+#include "core/sge_span.h"
+#include "core/sge_types.h"
+
+namespace SGE
+{
+    constexpr uint32 INVALID_TRANSFORM = ~0u;
+
+    // Local position, rotation and scale of many transforms with parents, and their local and world
+    // matrices cached in contiguous arrays. Setters mark a transform dirty. Update composes the dirty
+    // locals in one batch and then walks only the subtrees under them, parents before children, so a
+    // frame in which nothing moved costs next to nothing.
+    class TransformHierarchy
+    {
+    public:
+        uint32 Create(uint32 parent = INVALID_TRANSFORM);
+        // Frees the transform for reuse. Its children become roots and keep their local values.
+        bool Destroy(uint32 transform);
+        void Clear();
+
+        // Makes transform a child of parent, or a root with INVALID_TRANSFORM. Fails when parent
+        // is the transform itself or one of its descendants.
+        bool SetParent(uint32 transform, uint32 parent);
+        uint32 GetParent(uint32 transform) const { return m_parents[transform]; }
+
+        // Rotations are unit quaternions. Values equal to the current ones don't mark anything dirty.
+        void SetLocal(uint32 transform, const float3& position, const float4& rotation, const float3& scale);
+        void SetPosition(uint32 transform, const float3& position);
+        void SetRotation(uint32 transform, const float4& rotation);
+        void SetScale(uint32 transform, const float3& scale);
+
+        float3 GetPosition(uint32 transform) const { return m_positions.get(transform); }
+        float4 GetRotation(uint32 transform) const { return m_rotations.get(transform); }
+        float3 GetScale(uint32 transform) const { return m_scales.get(transform); }
+
+        void Update();
+        // The transforms whose world matrix the last Update recomputed, parents before children.
+        const std::vector<uint32>& GetChangedTransforms() const { return m_changedTransforms; }
+
+        const float4x4& GetLocalMatrix(uint32 transform) const { return m_localMatrices[transform]; }
+        const float4x4& GetWorldMatrix(uint32 transform) const { return m_worldMatrices[transform]; }
+        // Indexed by transform, freed slots included.
+        Span<const float4x4> GetWorldMatrices() const { return m_worldMatrices; }
+        uint32 GetCount() const { return static_cast<uint32>(m_parents.size() - m_freeTransforms.size()); }
+
+    private:
+        bool IsAlive(uint32 transform) const;
+        void MarkDirty(uint32 transform, bool isLocalChanged);
+        void Detach(uint32 transform);
+        void ComposeDirtyLocals();
+        void UpdateSubtree(uint32 root);
+
+        float3_soa m_positions;
+        float4_soa m_rotations;
+        float3_soa m_scales;
+        float4x4_array m_localMatrices;
+        float4x4_array m_worldMatrices;
+
+        std::vector<uint32> m_parents;
+        std::vector<uint32> m_firstChildren;
+        std::vector<uint32> m_nextSiblings;
+        std::vector<uint8> m_flags;
+
+        std::vector<uint32> m_dirtyTransforms;
+        std::vector<uint32> m_changedTransforms;
+        std::vector<uint32> m_freeTransforms;
+        std::vector<uint32> m_stack;
+
+        // Dirty locals gathered for ComposeTRS.
+        float3_soa m_composePositions;
+        float4_soa m_composeRotations;
+        float3_soa m_composeScales;
+        float4x4_array m_composed;
+    };
+}
+
+#endif // !_SGE_TRANSFORM_HIERARCHY_H_
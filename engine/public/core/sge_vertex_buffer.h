@@ -2,13 +2,21 @@
 #define _SGE_VERTEX_BUFFER_H_
 
 #include "pch.h"
+#include "core/sge_span.h"
 
 namespace SGE
 {
     class VertexBuffer
     {
     public:
-        void Initialize(class Device* device, const std::vector<struct Vertex>& vertices);
+        void Initialize(class Device* device, const void* data, uint32 vertexCount, uint32 stride);
+
+        template<typename T>
+        void Initialize(class Device* device, Span<const T> vertices)
+        {
+            Initialize(device, vertices.data(), static_cast<uint32>(vertices.size()), static_cast<uint32>(sizeof(T)));
+        }
+
         void Shutdown();
 
         D3D12_VERTEX_BUFFER_VIEW GetView() const { return m_view; }
@@ -0,0 +1,114 @@
+#ifndef _SGE_WORK_STEALING_QUEUE_H_
+#define _SGE_WORK_STEALING_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace SGE
+{
+    // Fixed-capacity Chase-Lev deque (Le, Pop, Cohen, Zappa Nardelli, "Correct and Efficient
+    // Work-Stealing for Weak Memory Models", PPoPP 2013). The owning thread pushes and pops at the
+    // bottom in LIFO order, any other thread steals from the top in FIFO order without locks.
+    // Capacity must be a power of two; Push reports a full queue instead of growing.
+    template<typename T>
+    class WorkStealingQueue
+    {
+        static_assert(std::is_pointer_v<T>, "WorkStealingQueue stores pointers, nullptr means empty.");
+
+    public:
+        explicit WorkStealingQueue(size_t capacity = 4096)
+            : m_capacity(static_cast<int64_t>(capacity)), m_mask(static_cast<int64_t>(capacity) - 1), m_buffer(new std::atomic<T>[capacity])
+        {
+        }
+
+        WorkStealingQueue(const WorkStealingQueue&) = delete;
+        WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+        // Owner thread only.
+        bool Push(T item) noexcept
+        {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            int64_t top = m_top.load(std::memory_order_acquire);
+            if (bottom - top >= m_capacity)
+            {
+                return false;
+            }
+
+            // Release on the slot as well as the fence, so the item's payload is published to a
+            // thief even under tools that do not model fences.
+            m_buffer[bottom & m_mask].store(item, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // Owner thread only.
+        T Pop() noexcept
+        {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T item = m_buffer[bottom & m_mask].load(std::memory_order_relaxed);
+            if (top == bottom)
+            {
+                // Last item, race the thieves for it.
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    item = nullptr;
+                }
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return item;
+        }
+
+        // Any thread.
+        T Steal() noexcept
+        {
+            int64_t top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+            {
+                return nullptr;
+            }
+
+            T item = m_buffer[top & m_mask].load(std::memory_order_acquire);
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+            return item;
+        }
+
+        size_t GetSize() const noexcept
+        {
+            int64_t size = m_bottom.load(std::memory_order_relaxed) - m_top.load(std::memory_order_relaxed);
+            return size > 0 ? static_cast<size_t>(size) : 0;
+        }
+
+        bool IsEmpty() const noexcept { return GetSize() == 0; }
+        size_t GetCapacity() const noexcept { return static_cast<size_t>(m_capacity); }
+
+    private:
+        // Owner and thieves write different ends, keep them on separate cache lines.
+        alignas(64) std::atomic<int64_t> m_top{ 0 };
+        alignas(64) std::atomic<int64_t> m_bottom{ 0 };
+        const int64_t m_capacity;
+        const int64_t m_mask;
+        std::unique_ptr<std::atomic<T>[]> m_buffer;
+    };
+}
+
+#endif // !_SGE_WORK_STEALING_QUEUE_H_
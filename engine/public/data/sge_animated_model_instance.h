@@ -1,12 +1,17 @@
 #ifndef _SGE_ANIMATED_MODEL_INSTANCE_H_
 #define _SGE_ANIMATED_MODEL_INSTANCE_H_
 
+#include <map>
 #include "data/sge_model_instance.h"
 #include "data/sge_animation.h"
+#include "data/sge_animation_blender.h"
 #include "core/sge_math.h"
 
 namespace SGE
 {
+    // Fraction of the model's largest extent its bounds grow by on every side.
+    constexpr float ANIMATED_BOUNDS_PADDING = 0.5f;
+
     class AnimatedModelInstance : public ModelInstance
     {
     public:
@@ -21,25 +26,31 @@ namespace SGE
         float GetCurrentAnimationDurationForLayer(int layer) const;
         float GetTicksPerSecondForLayer(int layer) const;
         std::string GetCurrentAnimationNameForLayer(int layer) const;
+        void SetWeightForLayer(int layer, float weight);
+        void SetBlendModeForLayer(int layer, AnimationBlendMode blendMode);
         void ResetToTPose();
 
         void FixedUpdate(float deltaTime, bool forceUpdate = false) override;
 
-        const std::vector<Animation>& GetAnimations() const;
+        const std::vector<AnimationClip>& GetAnimationClips() const;
         Skeleton& GetSkeleton() const;
 
+        // The bind pose bounds grown by ANIMATED_BOUNDS_PADDING, poses reach past them.
+        ModelBounds GetLocalBounds() const override;
+
     protected:
-        const std::vector<Mesh>& GetMeshes() const override;
-        void OnUpdateTransform(const float4x4& viewMatrix, const float4x4& projectionMatrix) override;
+        Span<const MeshResourceInfo> GetMeshInfos() const override;
+        void OnUpdateTransform(const float4x4& worldMatrix, const float4x4& viewMatrix, const float4x4& projectionMatrix) override;
 
     private:
-        void UpdateBoneTransformsForLayer(int32 boneIndex, const float4x4& parentTransform, const Animation& currentAnimation, float animationTime, int layer);
-        void BlendBoneTransforms();
+        void EvaluatePose();
 
         AnimatedModelAsset* m_animatedAsset = nullptr;
-        std::unordered_map<int, LayerAnimation> m_layerAnimations;
-        std::vector<float4x4> m_finalBoneTransforms;
-        std::unordered_map<int, std::vector<float4x4>> m_layerBoneTransforms; 
+        std::map<int, LayerAnimation> m_layerAnimations; // ordered, layers blend bottom to top
+        std::vector<AnimationBlendLayer> m_blendLayers;
+        AnimationBlender m_blender;
+        AnimationPose m_pose;
+        bool m_isInBindPose = false;
     };
 }
 
@@ -1,7 +1,12 @@
 #ifndef _SGE_ANIMATION_H_
 #define _SGE_ANIMATION_H_
 
-#include "pch.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <limits>
+#include "core/sge_types.h"
+#include "core/sge_math.h"
 
 namespace SGE
 {
@@ -40,12 +45,92 @@ namespace SGE
         std::unordered_map<std::string, BoneKeyframes> boneKeyframes;
     };
 
+    // Runtime clip format, baked from an imported Animation when the asset is created.
+    using AnimationClipHandle = uint32;
+    constexpr AnimationClipHandle INVALID_ANIMATION_CLIP = std::numeric_limits<AnimationClipHandle>::max();
+
+    // Local transform of one bone.
+    struct BonePose
+    {
+        float3 position = float3::Zero;
+        float4 rotation = float4::Identity;
+        float3 scale = float3::One;
+    };
+
+    // Last sampled key segment per channel of one bone, see sge_keyframe_sampler.h.
+    struct KeyframeCursor
+    {
+        uint32 position = 0;
+        uint32 rotation = 0;
+        uint32 scale = 0;
+    };
+
+    // Key ranges of one bone inside the key arrays of its clip. A count of zero means the
+    // channel is not animated and samples to the identity value.
+    struct AnimationChannel
+    {
+        uint32 positionOffset = 0;
+        uint32 positionCount = 0;
+        uint32 rotationOffset = 0;
+        uint32 rotationCount = 0;
+        uint32 scaleOffset = 0;
+        uint32 scaleCount = 0;
+
+        bool IsAnimated() const { return positionCount > 0 || rotationCount > 0 || scaleCount > 0; }
+    };
+
+    // Channels are indexed by skeleton bone index and every key of the clip lives in one set of
+    // contiguous SoA arrays, so sampling a bone is an array lookup rather than a string hash.
+    class AnimationClip
+    {
+    public:
+        void Initialize(const Animation& animation, const std::unordered_map<std::string, int32>& boneNameToIndex, int32 boneCount);
+
+        const std::string& GetName() const { return m_name; }
+        float GetDuration() const { return m_duration; }
+        float GetTicksPerSecond() const { return m_ticksPerSecond; }
+        int32 GetChannelCount() const { return static_cast<int32>(m_channels.size()); }
+        const AnimationChannel& GetChannel(int32 boneIndex) const { return m_channels[boneIndex]; }
+        size_t GetKeyCount() const { return m_positionTimes.size() + m_rotationTimes.size() + m_scaleTimes.size(); }
+        size_t GetMemorySize() const;
+
+        BonePose SampleBone(int32 boneIndex, float time, KeyframeCursor& cursor) const;
+        BonePose SampleBone(int32 boneIndex, float time) const;
+
+    private:
+        friend class MeshCache; // reads and writes the key arrays of cooked models
+
+        std::string m_name;
+        float m_duration = 0.0f;
+        float m_ticksPerSecond = 25.0f;
+        std::vector<AnimationChannel> m_channels;
+
+        std::vector<float> m_positionTimes;
+        std::vector<float3> m_positions;
+        std::vector<float> m_rotationTimes;
+        std::vector<float4> m_rotations;
+        std::vector<float> m_scaleTimes;
+        std::vector<float3> m_scales;
+    };
+
+    // Override layers blend towards their pose, additive layers apply their pose on top as a delta
+    // from the identity transform.
+    enum class AnimationBlendMode
+    {
+        Override,
+        Additive
+    };
+
     struct LayerAnimation
     {
         std::string animationName;
         float currentTime = 0.0f;
         bool isPlaying = false;
         float ticksPerSecond = 25.0f;
+        AnimationClipHandle clip = INVALID_ANIMATION_CLIP;
+        std::vector<KeyframeCursor> cursors;
+        float weight = 1.0f;
+        AnimationBlendMode blendMode = AnimationBlendMode::Override;
     };
 }
 
@@ -0,0 +1,57 @@
+#ifndef _SGE_ANIMATION_BLENDER_H_
+#define _SGE_ANIMATION_BLENDER_H_
+
+#include <vector>
+#include "core/sge_span.h"
+#include "data/sge_animation_pose.h"
+
+namespace SGE
+{
+    // Sparse per-bone weights of one layer. Bones with zero weight are not stored, so the
+    // layer neither samples nor blends them.
+    struct BoneMask
+    {
+        std::vector<int32> boneIndices;
+        std::vector<float> weights;
+
+        void Initialize(const std::vector<float>& boneWeights);
+        size_t GetSize() const { return boneIndices.size(); }
+    };
+
+    struct AnimationBlendLayer
+    {
+        const AnimationClip* clip = nullptr;
+        std::vector<KeyframeCursor>* cursors = nullptr;
+        float time = 0.0f;
+        float weight = 1.0f;
+        AnimationBlendMode mode = AnimationBlendMode::Override;
+        const BoneMask* mask = nullptr; // nullptr blends every bone with the layer weight
+    };
+
+    enum class RotationBlend
+    {
+        Nlerp,
+        Slerp
+    };
+
+    // Blends layers in local space, bottom to top, starting from the bind pose:
+    // override - lerp translation and scale, nlerp/slerp rotation towards the sampled pose,
+    // additive - add translation, post-multiply rotation and multiply scale by the weighted delta.
+    // Bones without keys in a layer's clip keep the pose of the layers below.
+    class AnimationBlender
+    {
+    public:
+        void SetRotationBlend(RotationBlend rotationBlend) { m_rotationBlend = rotationBlend; }
+        RotationBlend GetRotationBlend() const { return m_rotationBlend; }
+
+        // Writes the blended local pose only, the caller runs ComputeModelPose afterwards.
+        void Evaluate(const BoneHierarchy& hierarchy, Span<const AnimationBlendLayer> layers, AnimationPose& pose) const;
+
+    private:
+        void BlendBone(AnimationPose& pose, const AnimationBlendLayer& layer, int32 boneIndex, float weight) const;
+
+        RotationBlend m_rotationBlend = RotationBlend::Nlerp;
+    };
+}
+
+#endif // !_SGE_ANIMATION_BLENDER_H_
@@ -0,0 +1,63 @@
+#ifndef _SGE_ANIMATION_POSE_H_
+#define _SGE_ANIMATION_POSE_H_
+
+#include <vector>
+#include "core/sge_math_batch.h"
+#include "data/sge_animation.h"
+
+namespace SGE
+{
+    // Flattened skeleton topology used for pose evaluation. Every bone appears after its parent
+    // in evaluationOrder, so the model pose is one forward pass without recursion.
+    // bindPose is the local pose recovered from the offset matrices, it renders the mesh undeformed.
+    struct BoneHierarchy
+    {
+        std::vector<int32> parentIndices;
+        std::vector<int32> evaluationOrder;
+        float4x4_array offsetMatrices;
+        std::vector<BonePose> bindPose;
+
+        void Initialize(const std::vector<int32>& parents, const float4x4_array& offsets);
+        int32 GetBoneCount() const { return static_cast<int32>(parentIndices.size()); }
+    };
+
+    // Pose buffers of one skeleton, all indexed by bone index:
+    // local pose  - per-bone translation/rotation/scale relative to the parent (SoA),
+    // model pose  - bone to model space transforms,
+    // palette     - model pose times the bone offset, uploaded for skinning.
+    class AnimationPose
+    {
+    public:
+        void Initialize(int32 boneCount);
+        int32 GetBoneCount() const { return static_cast<int32>(m_modelPose.size()); }
+
+        // Identity local pose and identity palette, which renders the mesh in its bind pose.
+        void SetIdentity();
+        void SetBindPose(const BoneHierarchy& hierarchy);
+
+        void SetBonePose(int32 boneIndex, const BonePose& pose);
+        BonePose GetBonePose(int32 boneIndex) const;
+
+        // Bones without a channel in the clip get the identity local transform.
+        void SampleClip(const AnimationClip& clip, float time, std::vector<KeyframeCursor>& cursors);
+
+        void ComputeModelPose(const BoneHierarchy& hierarchy);
+        void ComputeSkinningPalette(const BoneHierarchy& hierarchy);
+
+        const float3_soa& GetLocalPositions() const { return m_localPositions; }
+        const float4_soa& GetLocalRotations() const { return m_localRotations; }
+        const float3_soa& GetLocalScales() const { return m_localScales; }
+        const float4x4_array& GetModelPose() const { return m_modelPose; }
+        const float4x4_array& GetSkinningPalette() const { return m_skinningPalette; }
+
+    private:
+        float3_soa m_localPositions;
+        float4_soa m_localRotations;
+        float3_soa m_localScales;
+        float4x4_array m_localMatrices;
+        float4x4_array m_modelPose;
+        float4x4_array m_skinningPalette;
+    };
+}
+
+#endif // !_SGE_ANIMATION_POSE_H_
@@ -0,0 +1,106 @@
+#ifndef _SGE_ASSET_COOKER_H_
+#define _SGE_ASSET_COOKER_H_
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "core/sge_non_copyable.h"
+#include "core/sge_types.h"
+#include "data/sge_asset_loader.h"
+#include "data/sge_mesh_optimizer.h"
+#include "data/sge_texture_cooker.h"
+
+namespace SGE
+{
+    // Bump to recook everything, e.g. when a cooked format or an import step changes.
+    constexpr uint32 ASSET_COOKER_VERSION = 6;
+    constexpr const char* ASSET_COOKER_MANIFEST_NAME = "sge_cook_manifest.json";
+
+    enum class CookStatus : uint8
+    {
+        Pending,
+        Cooked,
+        UpToDate,
+        Missing, // the source is not there, the runtime falls back the same way it does without a cooker
+        Failed
+    };
+
+    struct CookEntry
+    {
+        AssetKind kind = AssetKind::Model;
+        std::string sourcePath;
+        std::string cookedPath;
+        TextureUsage textureUsage = TextureUsage::Color; // picks the block format of textures
+        uint64 contentHash = 0;
+        CookStatus status = CookStatus::Pending;
+        MeshOptimizationReport optimization; // models cooked in this run
+    };
+
+    struct CookReport
+    {
+        uint32 cooked = 0;
+        uint32 upToDate = 0;
+        uint32 missing = 0;
+        uint32 failed = 0;
+        MeshOptimizationReport optimization; // summed over the models cooked in this run
+    };
+
+    // Cooks source files into the files the runtime loads: .sgemesh next to models (see MeshCache)
+    // and .dds next to textures (see TextureCooker). A manifest keeps the content hash of every
+    // input, an entry whose hash is unchanged and whose cooked file exists is not cooked again.
+    // Entries are cooked in parallel on the job system; needs neither a device nor a window.
+    class AssetCooker : public NonCopyable
+    {
+    public:
+        // Reads the manifest of an earlier run if there is one, otherwise everything is cooked.
+        void Initialize(const std::string& manifestPath);
+
+        // Color textures added after this use BC1/BC3 instead of BC7, half the size at lower quality.
+        void SetCompactColor(bool isCompact) { m_isCompactColor = isCompact; }
+
+        // Returns false if the entry was added already or the file is not something the cooker handles.
+        // usage only matters for textures.
+        bool Add(AssetKind kind, const std::string& sourcePath, TextureUsage usage = TextureUsage::Color);
+
+        // Adds the models, material textures and cubemap faces of "assets_data" in application settings.
+        // Paths stay as written in the file, relative to the working directory like at runtime. Material
+        // textures are cooked for the slot they are in.
+        bool AddSettings(const std::string& settingsPath);
+
+        // Adds every model and texture below the directory. Models with bones or animations are cooked
+        // as animated models, textures get the usage their file name suggests.
+        void AddDirectory(const std::string& directory);
+
+        // Cooks the pending entries. force ignores the manifest and cooks every entry.
+        CookReport Cook(bool force = false);
+
+        bool SaveManifest() const;
+
+        const std::vector<CookEntry>& GetEntries() const { return m_entries; }
+
+        // Hash of the source content and everything else that goes into the cooked file. For .gltf
+        // models the external buffers are part of the hash, for textures the usage. Returns 0 if the
+        // source can't be read.
+        static uint64 ComputeContentHash(AssetKind kind, const std::string& sourcePath, TextureUsage usage = TextureUsage::Color);
+
+    private:
+        struct ManifestRecord
+        {
+            AssetKind kind = AssetKind::Model;
+            std::string sourcePath;
+            uint64 contentHash = 0;
+        };
+
+        static std::string GetEntryKey(AssetKind kind, const std::string& sourcePath);
+        void Process(CookEntry& entry, bool force) const;
+
+        std::string m_manifestPath;
+        std::vector<CookEntry> m_entries;
+        std::unordered_map<std::string, size_t> m_lookup;
+        std::map<std::string, ManifestRecord> m_manifest; // ordered, keeps the written manifest stable
+        bool m_isCompactColor = false;
+    };
+}
+
+#endif // !_SGE_ASSET_COOKER_H_
@@ -0,0 +1,127 @@
+#ifndef _SGE_ASSET_LOADER_H_
+#define _SGE_ASSET_LOADER_H_
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "core/sge_job_system.h"
+#include "core/sge_non_copyable.h"
+#include "core/sge_types.h"
+
+namespace SGE
+{
+    enum class AssetKind : uint8
+    {
+        Model,
+        AnimatedModel,
+        Texture,
+        Count
+    };
+
+    enum class AssetLoadState : uint8
+    {
+        Unknown,
+        Decoding,
+        Uploading,
+        Loaded,
+        Failed
+    };
+
+    // CPU side result of a decode (parsed meshes, decoded pixels). Lives until its upload is done.
+    class DecodedAsset
+    {
+    public:
+        virtual ~DecodedAsset() = default;
+    };
+
+    // Reads and parses files. Runs on worker threads, several decodes at once, so it must not touch
+    // the device or any cache shared with the main thread. Returns nullptr if the file can't be used.
+    class AssetDecoder
+    {
+    public:
+        virtual ~AssetDecoder() = default;
+        virtual std::unique_ptr<DecodedAsset> Decode(AssetKind kind, const std::string& path) = 0;
+    };
+
+    // Creates the GPU resources for a decoded asset. Always called on the main thread. Throwing
+    // marks the asset as failed.
+    class AssetUploadSink
+    {
+    public:
+        virtual ~AssetUploadSink() = default;
+        virtual void Upload(AssetKind kind, const std::string& path, DecodedAsset& asset) = 0;
+    };
+
+    // Drops every asset. Lets the decode stages run without a device, in tests and benchmarks.
+    class NullAssetUploadSink : public AssetUploadSink
+    {
+    public:
+        void Upload(AssetKind, const std::string&, DecodedAsset&) override {}
+    };
+
+    struct AssetLoadProgress
+    {
+        uint32 requested = 0;
+        uint32 decoded = 0;   // decodes finished, failed ones included
+        uint32 completed = 0; // uploaded or failed
+        uint32 failed = 0;
+
+        bool IsComplete() const { return completed == requested; }
+        float GetFraction() const { return requested == 0 ? 1.0f : static_cast<float>(completed) / static_cast<float>(requested); }
+    };
+
+    // Loads a batch of assets in two stages: decodes run as jobs on any thread, each finished decode
+    // queues its upload as a main thread job. Requests for a path that is already loading or loaded
+    // are dropped, so every file is read once however many objects reference it.
+    // Request, Wait and Reset belong to the main thread; progress can be read from anywhere.
+    class AssetLoader : public NonCopyable
+    {
+    public:
+        AssetLoader() = default;
+        ~AssetLoader();
+
+        void Initialize(AssetDecoder* decoder, AssetUploadSink* sink);
+
+        // Returns false if the path was already requested for this kind.
+        bool Request(AssetKind kind, const std::string& path);
+
+        // Helps with decodes and runs the uploads until every request is done.
+        void Wait();
+
+        // Forgets all requests once loading is done, so the same paths can be loaded again.
+        void Reset();
+
+        AssetLoadProgress GetProgress() const;
+        bool IsComplete() const;
+        AssetLoadState GetState(AssetKind kind, const std::string& path) const;
+
+    private:
+        struct LoadRequest
+        {
+            AssetKind kind;
+            std::string path;
+            std::atomic<AssetLoadState> state{ AssetLoadState::Decoding };
+            std::unique_ptr<DecodedAsset> decoded;
+        };
+
+        void Decode(LoadRequest* request);
+        void Upload(LoadRequest* request);
+
+        AssetDecoder* m_decoder = nullptr;
+        AssetUploadSink* m_sink = nullptr;
+
+        std::deque<LoadRequest> m_requests; // deque keeps the addresses handed to jobs stable
+        std::array<std::unordered_map<std::string, LoadRequest*>, static_cast<size_t>(AssetKind::Count)> m_lookup;
+
+        JobCounter m_jobs;
+        std::atomic<uint32> m_requestedCount{ 0 };
+        std::atomic<uint32> m_decodedCount{ 0 };
+        std::atomic<uint32> m_completedCount{ 0 };
+        std::atomic<uint32> m_failedCount{ 0 };
+    };
+}
+
+#endif // !_SGE_ASSET_LOADER_H_
@@ -2,6 +2,7 @@
 #define _SGE_DATA_ADAPTERS_H_
 
 #include "pch.h"
+#include "data/sge_data_structures.h"
 
 namespace SGE
 {
@@ -9,6 +10,21 @@ namespace SGE
     void SyncData(const class DirectionalLightData* data, struct DirectionalLight* light);
     void SyncData(const class ModelData* data, class ModelInstance* model);
     void SyncData(const class PointLightData* data, struct PointLight* pointLight);
+
+    // Calls SyncData when data changed since the version in syncedVersion, which then holds the
+    // current one. Returns true when it copied.
+    template<typename Data, typename Target>
+    bool SyncChangedData(const Data* data, Target* target, uint32& syncedVersion)
+    {
+        if (data != nullptr && data->GetVersion() == syncedVersion)
+        {
+            return false;
+        }
+
+        SyncData(data, target);
+        syncedVersion = data != nullptr ? data->GetVersion() : INVALID_DATA_VERSION;
+        return true;
+    }
 }
 
 #endif // !_SGE_DATA_ADAPTERS_H_
\ No newline at end of file
@@ -2,23 +2,12 @@
 #define _SGE_DATA_STRUCTURES_H_
 
 #include "pch.h"
+#include "data/sge_vertex.h"
 #include <unordered_set>
 #include <optional>
 
 namespace SGE
 {
-    struct alignas(16) Vertex
-    {
-        float3 position;
-        float3 normal;
-        float2 texCoords;
-        float3 tangent;
-        float3 bitangent;
-        float  boneWeights[4];
-        int32  boneIndices[4]; 
-    };
-    static_assert(alignof(Vertex) == 16, "Vertex structure alignment mismatch");
-
     struct alignas(16) TransformBuffer
     {
         float4x4 model;
@@ -27,6 +16,7 @@ namespace SGE
         float4x4 boneTransforms[100];
         bool isAnimated;
         float2 tilingUV = { 1.0f, 1.0f };
+        uint32 pointLightMask = ~0u; // bit i set when point light i reaches the model
     };
     static_assert(alignof(TransformBuffer) == 16, "TransformBuffer structure alignment mismatch");
     static_assert(sizeof(TransformBuffer) == (64 * 103) + 16, "TransformBuffer size mismatch");
@@ -100,6 +90,14 @@ namespace SGE
         Forward   = 0,
         Deferred  = 1
     };
+
+    // Views the scene culls its models for every frame.
+    enum class SceneView
+    {
+        Camera           = 0,
+        DirectionalLight = 1,
+        Count
+    };
     
     enum class ObjectType
     {
@@ -111,18 +109,38 @@ namespace SGE
         PointLight       = 5
     };
 
+    // Synced version of a runtime object that has no data yet. MarkChanged never hands it out,
+    // otherwise data whose version wrapped onto it would look synced forever.
+    constexpr uint32 INVALID_DATA_VERSION = ~0u;
+
     class ObjectDataBase
     {
     public:
         virtual ~ObjectDataBase() = default;
-        virtual void DrawEditor();
+        // Returns true when a value was edited.
+        virtual bool DrawEditor();
         virtual void ToJson(njson& data);
         virtual void FromJson(const njson& data);
 
+        // Whoever writes the values at runtime, the editor, the camera controller or a script,
+        // calls MarkChanged afterwards. Runtime objects copy the data again only when its version
+        // differs from the one they last copied, see SyncChangedData.
+        void MarkChanged()
+        {
+            if (++m_version == INVALID_DATA_VERSION)
+            {
+                m_version = 0;
+            }
+        }
+        uint32 GetVersion() const { return m_version; }
+
     public:
         std::string name;
         ObjectType  type;
         bool enabled = true;
+
+    private:
+        uint32 m_version = 0;
     };
 
     struct Transform
@@ -135,7 +153,7 @@ namespace SGE
     class TransformData : public ObjectDataBase
     {
     public:
-        void DrawEditor() override;
+        bool DrawEditor() override;
         void ToJson(njson& data) override;
         void FromJson(const njson& data) override;
 
@@ -146,7 +164,7 @@ namespace SGE
     class CameraData : public TransformData
     {
     public:
-        void DrawEditor() override;
+        bool DrawEditor() override;
         void ToJson(njson& data) override;
         void FromJson(const njson& data) override;
 
@@ -161,20 +179,21 @@ namespace SGE
     class ModelData : public TransformData
     {
     public:
-        void DrawEditor() override;
+        bool DrawEditor() override;
         void ToJson(njson& data) override;
         void FromJson(const njson& data) override;
     
     public:
         std::string assetId;
         std::string materialId;
+        std::string parent; // name of the model this one moves with, empty for none
         float2 tilingUV;
     };
 
     class AnimatedModelData : public ModelData 
     {
     public:
-        void DrawEditor() override;
+        bool DrawEditor() override;
         void ToJson(njson& data) override;
         void FromJson(const njson& data) override;
 
@@ -184,7 +203,7 @@ namespace SGE
     class PointLightData : public ObjectDataBase
     {
     public:
-        void DrawEditor() override;
+        bool DrawEditor() override;
         void ToJson(njson& data) override;
         void FromJson(const njson& data) override;
 
@@ -198,7 +217,7 @@ namespace SGE
     class DirectionalLightData : public ObjectDataBase
     {
     public:
-        void DrawEditor() override;
+        bool DrawEditor() override;
         void ToJson(njson& data) override;
         void FromJson(const njson& data) override;
     
@@ -211,7 +230,7 @@ namespace SGE
     class SkyboxData : public ObjectDataBase
     {
     public:
-        void DrawEditor() override;
+        bool DrawEditor() override;
         void ToJson(njson& data) override;
         void FromJson(const njson& data) override;
     
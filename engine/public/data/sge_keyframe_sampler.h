@@ -0,0 +1,95 @@
+#ifndef _SGE_KEYFRAME_SAMPLER_H_
+#define _SGE_KEYFRAME_SAMPLER_H_
+
+#include <algorithm>
+#include <vector>
+#include "data/sge_animation.h"
+
+namespace SGE
+{
+    // How far a cursor may walk forward before the sampler treats the jump as a seek and
+    // falls back to binary search. Normal playback advances zero or one key per tick.
+    constexpr uint32 KEYFRAME_CURSOR_MAX_STEPS = 4;
+
+    // The searches work on keyframe structs (PositionKeyframe, ...) as well as on the plain
+    // time arrays of a baked AnimationClip.
+    inline float GetKeyTime(float time) noexcept { return time; }
+
+    template<typename Keyframe>
+    float GetKeyTime(const Keyframe& key) noexcept { return key.time; }
+
+    // Binary search for the segment [i, i + 1] containing time. Requires at least two keys.
+    template<typename Key>
+    uint32 FindKeyframeSegment(const Key* keys, uint32 count, float time) noexcept
+    {
+        const Key* it = std::upper_bound(keys + 1, keys + count - 1, time,
+            [](float value, const Key& key) { return value < GetKeyTime(key); });
+        return static_cast<uint32>(it - keys) - 1;
+    }
+
+    // Cursor-cached lookup: during playback time only moves forward, so the segment found on the
+    // previous tick is almost always still valid or one key behind. Backward jumps (loop wrap,
+    // scrubbing) and long forward jumps use the binary search. Requires at least two keys.
+    template<typename Key>
+    uint32 FindKeyframeSegment(const Key* keys, uint32 count, float time, uint32& cursor) noexcept
+    {
+        const uint32 lastSegment = count - 2;
+        uint32 index = std::min(cursor, lastSegment);
+
+        if (time < GetKeyTime(keys[index]))
+        {
+            index = FindKeyframeSegment(keys, count, time);
+        }
+        else
+        {
+            for (uint32 step = 0; step < KEYFRAME_CURSOR_MAX_STEPS && index < lastSegment && time >= GetKeyTime(keys[index + 1]); ++step)
+            {
+                ++index;
+            }
+
+            if (index < lastSegment && time >= GetKeyTime(keys[index + 1]))
+            {
+                index = FindKeyframeSegment(keys, count, time);
+            }
+        }
+
+        cursor = index;
+        return index;
+    }
+
+    template<typename Keyframe>
+    uint32 FindKeyframeSegment(const std::vector<Keyframe>& keys, float time) noexcept
+    {
+        return FindKeyframeSegment(keys.data(), static_cast<uint32>(keys.size()), time);
+    }
+
+    template<typename Keyframe>
+    uint32 FindKeyframeSegment(const std::vector<Keyframe>& keys, float time, uint32& cursor) noexcept
+    {
+        return FindKeyframeSegment(keys.data(), static_cast<uint32>(keys.size()), time, cursor);
+    }
+
+    // Normalized position of time inside segment [index, index + 1], clamped to [0, 1].
+    template<typename Key>
+    float GetSegmentFactor(const Key* keys, uint32 index, float time) noexcept
+    {
+        float start = GetKeyTime(keys[index]);
+        float span = GetKeyTime(keys[index + 1]) - start;
+        if (span <= 0.0f)
+        {
+            return 0.0f;
+        }
+
+        return std::clamp((time - start) / span, 0.0f, 1.0f);
+    }
+
+    float3 SamplePosition(const std::vector<PositionKeyframe>& keys, float time) noexcept;
+    float4 SampleRotation(const std::vector<RotationKeyframe>& keys, float time) noexcept;
+    float3 SampleScale(const std::vector<ScaleKeyframe>& keys, float time) noexcept;
+
+    float3 SamplePosition(const std::vector<PositionKeyframe>& keys, float time, uint32& cursor) noexcept;
+    float4 SampleRotation(const std::vector<RotationKeyframe>& keys, float time, uint32& cursor) noexcept;
+    float3 SampleScale(const std::vector<ScaleKeyframe>& keys, float time, uint32& cursor) noexcept;
+}
+
+#endif // !_SGE_KEYFRAME_SAMPLER_H_
@@ -2,6 +2,7 @@
 #define _SGE_MATERIAL_H_
 
 #include "data/sge_data_structures.h"
+#include "data/sge_material_table.h"
 #include "rendering/sge_render_context.h"
 
 namespace SGE
@@ -10,13 +11,21 @@ namespace SGE
     {
     public:
         void Initialize(const MaterialAssetData& materialAsset, RenderContext* context);
-        void Bind(ID3D12GraphicsCommandList* commandList, DescriptorHeap* heap);
+        // Sets the material index root constant, the shaders look the textures up in the material table.
+        void Bind(ID3D12GraphicsCommandList* commandList) const;
+        // Tells the texture streamer how large the material's textures are drawn this frame.
+        void RequestScreenSize(float pixels) const;
+
+        MaterialTextures GetTextures() const;
+        void SetTableIndex(uint32 tableIndex) { m_tableIndex = tableIndex; }
+        uint32 GetTableIndex() const { return m_tableIndex; }
 
     private:
         uint32 m_albedoTextureIndex;
         uint32 m_metallicTextureIndex;
         uint32 m_normalTextureIndex;
         uint32 m_roughnessTextureIndex;
+        uint32 m_tableIndex = 0;
     };
 }
 
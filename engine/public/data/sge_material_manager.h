@@ -4,6 +4,7 @@
 #include "pch.h"
 #include "data/sge_data_structures.h"
 #include "data/sge_material.h"
+#include "data/sge_material_table.h"
 
 namespace SGE
 {
@@ -12,11 +13,20 @@ namespace SGE
     public:
         static Material* LoadMaterial(const MaterialAssetData& materialAssetData, RenderContext* context);
 
+        // Uploads the materials added since the last call. Once per frame, before the passes.
+        static void UpdateTable(const class Device* device);
+        // Binds the material buffer and the bindless texture range for the model draws that follow.
+        static void BindTable(ID3D12GraphicsCommandList* commandList, const class DescriptorHeap* descriptorHeap);
+        static void Shutdown();
+
     private:
         static bool HasMaterial(const std::string& materialName);
 
     private:
         static std::unordered_map<std::string, std::unique_ptr<Material>> m_materials;
+        static MaterialTable m_table;
+        static ComPtr<ID3D12Resource> m_tableBuffer; // upload heap, the renderer waits for each frame
+        static uint32 m_tableBufferCapacity;
     };
 }
 
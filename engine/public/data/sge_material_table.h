@@ -0,0 +1,65 @@
+#ifndef _SGE_MATERIAL_TABLE_H_
+#define _SGE_MATERIAL_TABLE_H_
+
+#include <vector>
+#include "core/sge_span.h"
+#include "core/sge_types.h"
+
+namespace SGE
+{
+    constexpr uint32 INVALID_MATERIAL_INDEX = ~0u;
+
+    // Descriptor heap indices of a material's textures.
+    struct MaterialTextures
+    {
+        uint32 albedo = 0;
+        uint32 normal = 0;
+        uint32 metallic = 0;
+        uint32 roughness = 0;
+    };
+
+    // One material as the shaders read it from the material buffer, see material_table.hlsl.
+    // Texture indices count from the start of the bindless texture range.
+    struct MaterialGpuData
+    {
+        uint32 albedoTexture = 0;
+        uint32 normalTexture = 0;
+        uint32 metallicTexture = 0;
+        uint32 roughnessTexture = 0;
+    };
+    static_assert(sizeof(MaterialGpuData) % 16 == 0, "MaterialGpuData must keep the 16 byte stride of the shader struct.");
+
+    // CPU copy of the material buffer. A material keeps the index Add gives it, draws pass it as
+    // a root constant. The entries changed since the last upload form one dirty range.
+    class MaterialTable
+    {
+    public:
+        // The textures of every material have to lie in [textureRangeStart, textureRangeStart + textureRangeSize).
+        void Initialize(uint32 textureRangeStart, uint32 textureRangeSize);
+
+        // INVALID_MATERIAL_INDEX if a texture is outside the texture range.
+        uint32 Add(const MaterialTextures& textures);
+        bool Set(uint32 materialIndex, const MaterialTextures& textures);
+        bool Pack(const MaterialTextures& textures, MaterialGpuData& data) const;
+
+        Span<const MaterialGpuData> GetEntries() const { return m_entries; }
+        uint32 GetCount() const { return static_cast<uint32>(m_entries.size()); }
+
+        // Entries [dirtyBegin, dirtyEnd) changed since the last ClearChanges.
+        bool HasChanges() const { return m_dirtyBegin < m_dirtyEnd; }
+        uint32 GetDirtyBegin() const { return m_dirtyBegin; }
+        uint32 GetDirtyEnd() const { return m_dirtyEnd; }
+        void ClearChanges();
+
+    private:
+        void MarkDirty(uint32 materialIndex);
+
+        uint32 m_textureRangeStart = 0;
+        uint32 m_textureRangeSize = 0;
+        uint32 m_dirtyBegin = 0;
+        uint32 m_dirtyEnd = 0;
+        std::vector<MaterialGpuData> m_entries;
+    };
+}
+
+#endif // !_SGE_MATERIAL_TABLE_H_
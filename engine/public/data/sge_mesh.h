@@ -3,15 +3,44 @@
 
 #include <vector>
 #include "core/sge_types.h"
-#include "data/sge_data_structures.h"
+#include "data/sge_meshlet.h"
+#include "data/sge_vertex.h"
 
 namespace SGE
 {
+    // Simplified levels a mesh can have on top of the full detail one.
+    constexpr uint32 MAX_MESH_LODS = 4;
+
+    // Range of a simplified level in the shared index array. error is the largest distance the
+    // level moved the surface, in model units.
+    struct MeshLodRange
+    {
+        uint32 indexCount = 0;
+        uint32 indexOffset = 0;
+        float error = 0.0f;
+    };
+
+    // The full detail level uses meshIndexCount and indexCountOffset. lods[0, lodCount) are
+    // progressively coarser levels that index the same vertices. The full level is also split
+    // into meshletCount meshlets starting at meshletOffset of the model's meshlet array.
+    // boundsMin and boundsMax enclose the mesh's vertices in model space.
     struct MeshResourceInfo
     {
         uint32 meshIndexCount;
         uint32 vertexCountOffset;
         uint32 indexCountOffset;
+        uint32 lodCount;
+        MeshLodRange lods[MAX_MESH_LODS];
+        uint32 meshletOffset;
+        uint32 meshletCount;
+        float3 boundsMin;
+        float3 boundsMax;
+    };
+
+    struct MeshLod
+    {
+        std::vector<uint32> indices;
+        float error = 0.0f;
     };
 
     class Mesh
@@ -22,15 +51,21 @@ namespace SGE
             , m_indices(indices) {}
 
         void UpdateInfo(const MeshResourceInfo& info) { m_info = info; }
+        void SetLods(std::vector<MeshLod> lods) { m_lods = std::move(lods); }
+        void SetMeshlets(MeshletData meshlets) { m_meshlets = std::move(meshlets); }
 
         const std::vector<Vertex>& GetVertices() const { return m_vertices; }
         const std::vector<uint32>& GetIndices() const { return m_indices; }
+        const std::vector<MeshLod>& GetLods() const { return m_lods; }
+        const MeshletData& GetMeshlets() const { return m_meshlets; }
         const MeshResourceInfo& GetInfo() const { return m_info; }
 
     private:
         std::vector<Vertex> m_vertices;
         std::vector<uint32> m_indices;
-        MeshResourceInfo m_info;
+        std::vector<MeshLod> m_lods;
+        MeshletData m_meshlets;
+        MeshResourceInfo m_info{};
     };
 }
 
@@ -0,0 +1,83 @@
+#ifndef _SGE_MESH_CACHE_H_
+#define _SGE_MESH_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "core/sge_types.h"
+#include "data/sge_model_asset.h"
+
+namespace SGE
+{
+    class MeshCacheReader;
+
+    constexpr uint32 MESH_CACHE_MAGIC = 0x4D454753; // "SGEM"
+    constexpr uint32 MESH_CACHE_VERSION = 5;
+    constexpr const char* MESH_CACHE_EXTENSION = ".sgemesh";
+
+    // Accepts a cooked file whatever source it was built from, for builds shipped without sources.
+    constexpr uint64 MESH_CACHE_ANY_SOURCE = 0;
+
+    enum class MeshCacheSection : uint32
+    {
+        MeshInfos,
+        Vertices,
+        Indices,
+        Skeleton,
+        AnimationClips,
+        SkinVertices, // empty for models without bone weights
+        Meshlets,
+        MeshletVertices,
+        MeshletTriangles,
+        Count
+    };
+
+    struct MeshCacheSectionRange
+    {
+        uint64 offset = 0;
+        uint64 size = 0;
+    };
+
+    // Cooked files are written in the native layout of little-endian x64, sections are 16 byte
+    // aligned so the vertex and index arrays can be used in place from the mapped file.
+    struct MeshCacheHeader
+    {
+        uint32 magic = MESH_CACHE_MAGIC;
+        uint32 version = MESH_CACHE_VERSION;
+        uint64 sourceKey = 0;
+        uint32 vertexSize = sizeof(PackedVertex);
+        uint32 isAnimated = 0;
+        MeshCacheSectionRange sections[static_cast<size_t>(MeshCacheSection::Count)];
+    };
+
+    // Post-processed models stored as .sgemesh files. Loading maps the file: mesh infos, vertices
+    // and indices are handed to ModelAsset as views into the mapping, only the skeleton and the
+    // animation clips are copied out.
+    class MeshCache
+    {
+    public:
+        static std::string GetCachePath(const std::string& sourcePath);
+
+        // Hash of the source path, its modification time and the import flags. A cooked file
+        // with a different key is stale. Returns MESH_CACHE_ANY_SOURCE if the source is missing.
+        static uint64 ComputeSourceKey(const std::string& sourcePath, uint32 importFlags);
+
+        static bool Write(const std::string& cachePath, uint64 sourceKey, const ModelAsset& asset);
+        static bool Write(const std::string& cachePath, uint64 sourceKey, const AnimatedModelAsset& asset);
+
+        // Restamps a valid cooked file with a new key, for a source whose time changed but whose
+        // content did not. False if the file is missing or not a cooked file of this version.
+        static bool UpdateSourceKey(const std::string& cachePath, uint64 sourceKey);
+
+        // nullptr if the file is missing, stale, from another format version or damaged.
+        static std::unique_ptr<ModelAsset> LoadModel(const std::string& cachePath, uint64 sourceKey);
+        static std::unique_ptr<AnimatedModelAsset> LoadAnimatedModel(const std::string& cachePath, uint64 sourceKey);
+
+    private:
+        static bool Write(const std::string& cachePath, uint64 sourceKey, const ModelAsset& asset, const AnimatedModelAsset* animatedAsset);
+        static void WriteAnimationClip(std::vector<uint8>& out, const AnimationClip& clip);
+        static bool ReadAnimationClip(MeshCacheReader& reader, AnimationClip& clip, int32 boneCount);
+    };
+}
+
+#endif // !_SGE_MESH_CACHE_H_
@@ -0,0 +1,31 @@
+#ifndef _SGE_MESH_LOD_SELECTOR_H_
+#define _SGE_MESH_LOD_SELECTOR_H_
+
+#include "core/sge_math.h"
+#include "core/sge_types.h"
+#include "data/sge_mesh.h"
+
+namespace SGE
+{
+    // How far a level may move the surface on screen before a finer one is used, in pixels.
+    constexpr float DEFAULT_LOD_PIXEL_ERROR = 1.0f;
+
+    // Picks a simplified level by the screen space size of its error. Level 0 is full detail,
+    // level i uses MeshResourceInfo::lods[i - 1].
+    class MeshLodSelector
+    {
+    public:
+        // Pixels a unit long segment covers at distance one, from the y scale of the projection.
+        static float ComputeProjectionScale(const float4x4& projectionMatrix, float viewportHeight);
+
+        // Pixels per model unit for a model seen from cameraPosition. Uses the distance to the
+        // nearest point of the bounding sphere, a camera inside the sphere gets full detail.
+        static float ComputeLodScale(const float4x4& worldMatrix, const float3& boundsCenter, float boundsRadius,
+                                     const float3& cameraPosition, float projectionScale, float nearPlane);
+
+        static uint32 Select(const MeshResourceInfo& info, float lodScale, float maxPixelError = DEFAULT_LOD_PIXEL_ERROR);
+        static void GetIndexRange(const MeshResourceInfo& info, uint32 lod, uint32& indexCount, uint32& indexOffset);
+    };
+}
+
+#endif // !_SGE_MESH_LOD_SELECTOR_H_
@@ -0,0 +1,61 @@
+#ifndef _SGE_MESH_OPTIMIZER_H_
+#define _SGE_MESH_OPTIMIZER_H_
+
+#include <vector>
+#include "core/sge_types.h"
+#include "data/sge_vertex.h"
+
+namespace SGE
+{
+    // Size of the FIFO the statistics simulate, close to the post-transform cache of current GPUs.
+    constexpr uint32 VERTEX_CACHE_ANALYSIS_SIZE = 16;
+
+    // Post-transform cache behaviour of an index buffer. ACMR is the number of vertex shader runs
+    // per triangle (0.5 at best for a regular grid, 3 at worst), ATVR the number per referenced
+    // vertex (1 at best).
+    struct VertexCacheStats
+    {
+        uint32 triangleCount = 0;
+        uint32 vertexCount = 0; // distinct vertices the indices reference
+        uint32 cacheMisses = 0;
+
+        float GetACMR() const { return triangleCount > 0 ? static_cast<float>(cacheMisses) / triangleCount : 0.0f; }
+        float GetATVR() const { return vertexCount > 0 ? static_cast<float>(cacheMisses) / vertexCount : 0.0f; }
+
+        VertexCacheStats& operator+=(const VertexCacheStats& other);
+    };
+
+    struct MeshOptimizationReport
+    {
+        uint32 vertexCountBefore = 0;
+        uint32 vertexCountAfter = 0;
+        VertexCacheStats before;
+        VertexCacheStats after;
+
+        MeshOptimizationReport& operator+=(const MeshOptimizationReport& other);
+    };
+
+    // Import-time index and vertex buffer optimization, pure CPU. Optimize runs the steps in the
+    // order they depend on each other: welding first so the cache sees shared vertices, then the
+    // triangle order, then the vertex order that follows from it.
+    class MeshOptimizer
+    {
+    public:
+        static MeshOptimizationReport Optimize(std::vector<Vertex>& vertices, std::vector<uint32>& indices);
+
+        // Merges vertices whose attributes are bit for bit equal and rewrites the indices.
+        static void WeldVertices(std::vector<Vertex>& vertices, std::vector<uint32>& indices);
+
+        // Reorders triangles for post-transform cache hits, after Forsyth's linear-speed vertex
+        // cache optimisation. Winding and the set of triangles stay the same.
+        static void OptimizeVertexCache(std::vector<uint32>& indices, size_t vertexCount);
+
+        // Sorts vertices by first use in the index buffer so fetches walk memory forward. Vertices
+        // no triangle references are dropped.
+        static void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32>& indices);
+
+        static VertexCacheStats AnalyzeVertexCache(const std::vector<uint32>& indices, size_t vertexCount, uint32 cacheSize = VERTEX_CACHE_ANALYSIS_SIZE);
+    };
+}
+
+#endif // !_SGE_MESH_OPTIMIZER_H_
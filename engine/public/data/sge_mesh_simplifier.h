@@ -0,0 +1,39 @@
+#ifndef _SGE_MESH_SIMPLIFIER_H_
+#define _SGE_MESH_SIMPLIFIER_H_
+
+#include <vector>
+#include "core/sge_types.h"
+#include "data/sge_mesh.h"
+
+namespace SGE
+{
+    struct MeshLodSettings
+    {
+        uint32 maxLodCount = MAX_MESH_LODS;
+        float reduction = 0.5f;        // index count of a level relative to the one before
+        float maxRelativeError = 0.1f; // no level moves the surface by more than this part of the mesh radius
+        uint32 minTriangleCount = 32;  // meshes this small are not simplified further
+    };
+
+    // Edge collapse simplification driven by quadric error metrics (Garland and Heckbert).
+    // Vertices are never moved or created, a collapse replaces a vertex by a neighbour, so every
+    // level indexes the original vertex array. Open borders and UV seams are kept in shape by
+    // extra constraint planes. A vertex that exists several times with different attributes only
+    // collapses along the seam, so no triangle ends up with attributes of two UV charts.
+    class MeshSimplifier
+    {
+    public:
+        // Collapses edges until at most targetIndexCount indices are left or the next collapse
+        // would cost more than maxError, a distance in model units. error receives the largest
+        // error of the collapses that were made.
+        static std::vector<uint32> Simplify(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices,
+                                            size_t targetIndexCount, float maxError, float* error = nullptr);
+
+        // Simplified levels for a mesh, each reordered for the vertex cache. Stops early when a
+        // level would not be much smaller than the one before.
+        static std::vector<MeshLod> BuildLods(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices,
+                                              const MeshLodSettings& settings = {});
+    };
+}
+
+#endif // !_SGE_MESH_SIMPLIFIER_H_
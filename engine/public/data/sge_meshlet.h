@@ -0,0 +1,72 @@
+#ifndef _SGE_MESHLET_H_
+#define _SGE_MESHLET_H_
+
+#include <vector>
+#include "core/sge_frustum.h"
+#include "core/sge_span.h"
+#include "core/sge_types.h"
+#include "data/sge_vertex.h"
+
+namespace SGE
+{
+    // Limits that fit the mesh shader tier of current hardware, triangles are kept one short of
+    // 128 so a meshlet's local indices fill whole 4 byte words.
+    constexpr uint32 MAX_MESHLET_VERTICES = 64;
+    constexpr uint32 MAX_MESHLET_TRIANGLES = 124;
+
+    struct MeshletTriangle
+    {
+        uint8 indices[3];
+    };
+
+    // A small cluster of a mesh. Its vertices are vertexCount entries of the meshlet vertex array
+    // at vertexOffset, each an index into the vertex array. Its triangles index those entries.
+    // The cluster is facing away from every camera position for which
+    // dot(normalize(coneApex - camera), coneAxis) >= coneCutoff, a cutoff above 1 never culls.
+    struct Meshlet
+    {
+        uint32 vertexOffset = 0;
+        uint32 triangleOffset = 0;
+        uint32 vertexCount = 0;
+        uint32 triangleCount = 0;
+
+        float3 center;
+        float radius = 0.0f;
+        float3 boundsMin;
+        float3 boundsMax;
+
+        float3 coneApex;
+        float3 coneAxis;
+        float coneCutoff = 2.0f;
+    };
+
+    struct MeshletData
+    {
+        std::vector<Meshlet> meshlets;
+        std::vector<uint32> vertices;
+        std::vector<MeshletTriangle> triangles;
+    };
+
+    class MeshletBuilder
+    {
+    public:
+        // Greedy clustering that grows each meshlet through triangles sharing its vertices, in
+        // the order of the index list, so it keeps the locality of a cache optimized mesh.
+        static MeshletData Build(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices);
+    };
+
+    class MeshletCuller
+    {
+    public:
+        // Frustum and camera position in the space of the meshlet bounds, usually model space.
+        // The cone test assumes the model is not mirrored or scaled unevenly.
+        static bool IsVisible(const Meshlet& meshlet, const Frustum& frustum, const float3& cameraPosition, bool isBackfaceCulled = true);
+
+        // Appends the triangles of all visible meshlets to indices as a plain index list over
+        // the vertex array, ready for an indexed draw. Returns the number of visible meshlets.
+        static uint32 Cull(Span<const Meshlet> meshlets, Span<const uint32> meshletVertices, Span<const MeshletTriangle> meshletTriangles,
+                           const Frustum& frustum, const float3& cameraPosition, bool isBackfaceCulled, std::vector<uint32>& indices);
+    };
+}
+
+#endif // !_SGE_MESHLET_H_
@@ -1,24 +1,75 @@
 #ifndef _SGE_MODEL_ASSET_H_
 #define _SGE_MODEL_ASSET_H_
 
-#include "pch.h"
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "core/sge_non_copyable.h"
+#include "core/sge_span.h"
 #include "data/sge_mesh.h"
 #include "data/sge_animation.h"
+#include "data/sge_animation_blender.h"
 
 namespace SGE
 {
-    class ModelAsset
+    class MappedFile;
+
+    // All meshes of a model share one vertex and one index array. The arrays are either owned,
+    // after an import, or point straight into a mapped cooked file that the asset keeps open.
+    // Vertices are stored packed, the skin stream only exists if some vertex has bone weights,
+    // so static models carry no bone data at all. Simplified levels of each mesh are stored as
+    // extra ranges of the index array, see MeshResourceInfo.
+    class ModelAsset : public NonCopyable
     {
     public:
         void Initialize(std::vector<Mesh>& meshes);
-        const std::vector<Mesh>& GetMeshes() const { return m_meshes; }
-        const std::vector<Vertex>& GetVertices() const { return m_vertices; }
-        const std::vector<uint32>& GetIndices() const { return m_indices; }
-    
+        void Initialize(Span<const MeshResourceInfo> meshInfos, Span<const PackedVertex> vertices, Span<const SkinVertex> skinVertices,
+                        Span<const uint32> indices, std::shared_ptr<const MappedFile> file);
+        void InitializeMeshlets(Span<const Meshlet> meshlets, Span<const uint32> meshletVertices, Span<const MeshletTriangle> meshletTriangles);
+
+        Span<const MeshResourceInfo> GetMeshInfos() const { return m_meshInfos; }
+        Span<const PackedVertex> GetVertices() const { return m_vertices; }
+        Span<const SkinVertex> GetSkinVertices() const { return m_skinVertices; }
+        Span<const uint32> GetIndices() const { return m_indices; }
+
+        // Meshlet vertices index the model's vertex array, see MeshResourceInfo for each mesh's range.
+        Span<const Meshlet> GetMeshlets() const { return m_meshlets; }
+        Span<const uint32> GetMeshletVertices() const { return m_meshletVertices; }
+        Span<const MeshletTriangle> GetMeshletTriangles() const { return m_meshletTriangles; }
+        bool HasSkin() const { return !m_skinVertices.empty(); }
+        bool IsMapped() const { return m_file != nullptr; }
+
+        // Box and sphere around all vertices in model space, see MeshResourceInfo for each mesh's box.
+        const float3& GetBoundsMin() const { return m_boundsMin; }
+        const float3& GetBoundsMax() const { return m_boundsMax; }
+        const float3& GetBoundsCenter() const { return m_boundsCenter; }
+        float GetBoundsRadius() const { return m_boundsRadius; }
+
     private:
-        std::vector<Mesh> m_meshes;
-        std::vector<Vertex> m_vertices;
-        std::vector<uint32> m_indices;
+        void ComputeBounds();
+
+        Span<const MeshResourceInfo> m_meshInfos;
+        Span<const PackedVertex> m_vertices;
+        Span<const SkinVertex> m_skinVertices;
+        Span<const uint32> m_indices;
+        Span<const Meshlet> m_meshlets;
+        Span<const uint32> m_meshletVertices;
+        Span<const MeshletTriangle> m_meshletTriangles;
+
+        std::vector<MeshResourceInfo> m_ownedMeshInfos;
+        std::vector<PackedVertex> m_ownedVertices;
+        std::vector<SkinVertex> m_ownedSkinVertices;
+        std::vector<uint32> m_ownedIndices;
+        std::vector<Meshlet> m_ownedMeshlets;
+        std::vector<uint32> m_ownedMeshletVertices;
+        std::vector<MeshletTriangle> m_ownedMeshletTriangles;
+        std::shared_ptr<const MappedFile> m_file;
+        float3 m_boundsMin;
+        float3 m_boundsMax;
+        float3 m_boundsCenter;
+        float m_boundsRadius = 0.0f;
     };
 
     struct Bone
@@ -43,7 +94,16 @@ namespace SGE
         const float4x4& GetBoneOffset(int32 index) const;
         const std::unordered_map<std::string, int32>& GetBoneNameToIndexMap() const { return m_boneNameToIndex; }
         void PrintBoneHierarchy() const;
-        std::vector<Bone>& Skeleton::GetBones() { return m_bones; }
+
+        // Flattens parent links and offsets for pose evaluation, call after the hierarchy is built.
+        void BuildHierarchy();
+        const BoneHierarchy& GetHierarchy() const { return m_hierarchy; }
+
+        // Sparse masks built from Bone::weights, one per weight layer. Rebuild after editing the weights.
+        void BuildLayerMasks();
+        const BoneMask* GetLayerMask(int layer) const;
+        std::vector<Bone>& GetBones() { return m_bones; }
+        const std::vector<Bone>& GetBones() const { return m_bones; }
     
     private:
         void PrintBoneHierarchyRecursive(const Bone& bone, int32 level) const;
@@ -51,20 +111,28 @@ namespace SGE
     private:
         std::vector<Bone> m_bones;
         std::unordered_map<std::string, int32> m_boneNameToIndex;
+        BoneHierarchy m_hierarchy;
+        std::vector<BoneMask> m_layerMasks;
     };
 
     class AnimatedModelAsset : public ModelAsset
     {
     public:
+        using ModelAsset::Initialize;
         void Initialize(std::vector<Mesh>& meshes, const Skeleton& skeleton, const std::vector<Animation>& animations);
 
+        // Takes a skeleton and clips that are already baked, as stored in a cooked model.
+        void InitializeAnimation(const Skeleton& skeleton, std::vector<AnimationClip> clips);
+
         const Skeleton& GetSkeleton() const { return m_skeleton; }
         Skeleton& GetSkeleton() { return m_skeleton; }
-        const std::vector<Animation>& GetAnimations() const { return m_animations; }
+        const std::vector<AnimationClip>& GetAnimationClips() const { return m_animationClips; }
+        const AnimationClip& GetAnimationClip(AnimationClipHandle handle) const { return m_animationClips[handle]; }
+        AnimationClipHandle FindAnimationClip(const std::string& name) const;
 
     private:
         Skeleton m_skeleton;
-        std::vector<Animation> m_animations;
+        std::vector<AnimationClip> m_animationClips;
     };
 }
 
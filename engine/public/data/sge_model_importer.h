@@ -0,0 +1,45 @@
+#ifndef _SGE_MODEL_IMPORTER_H_
+#define _SGE_MODEL_IMPORTER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "core/sge_types.h"
+#include "data/sge_mesh_optimizer.h"
+#include "data/sge_model_asset.h"
+
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include <assimp/matrix4x4.h>
+
+namespace SGE
+{
+    // Reads source models through Assimp. Needs no device, used by ModelLoader at runtime and by
+    // the offline cooker. Each call owns its importer, so imports may run on several threads.
+    class ModelImporter
+    {
+    public:
+        // Post-processing applied on import, part of the key of cooked files. Triangle and vertex
+        // order are left to MeshOptimizer, which runs on every imported mesh.
+        static constexpr uint32 IMPORT_FLAGS = aiProcess_Triangulate | aiProcess_CalcTangentSpace | aiProcess_MakeLeftHanded |
+            aiProcess_JoinIdenticalVertices;
+
+        // nullptr if the file can't be read. The report, if given, sums up the optimization of all meshes.
+        static std::unique_ptr<ModelAsset> ImportModel(const std::string& path, MeshOptimizationReport* report = nullptr);
+        static std::unique_ptr<AnimatedModelAsset> ImportAnimatedModel(const std::string& path, MeshOptimizationReport* report = nullptr);
+
+        // True if the file has bones or animations, for callers that don't know the asset type.
+        static bool IsAnimated(const std::string& path);
+
+    private:
+        static void ProcessNode(aiNode* node, const aiScene* scene, std::vector<Mesh>& meshes, const std::string& modelPath, MeshOptimizationReport& report);
+        static Mesh ProcessMesh(aiMesh* mesh, const aiScene* scene, const std::string& modelPath, MeshOptimizationReport& report);
+
+        static Skeleton ProcessSkeleton(const aiScene* scene);
+        static std::vector<Animation> ProcessAnimations(const aiScene* scene, const Skeleton& skeleton);
+    };
+
+    float4x4 AssimpToFloat4x4(const aiMatrix4x4& assimpMatrix);
+}
+
+#endif // !_SGE_MODEL_IMPORTER_H_
@@ -1,8 +1,11 @@
 #ifndef _SGE_MODEL_INSTANCE_H_
 #define _SGE_MODEL_INSTANCE_H_
 
+#include <cfloat>
 #include <vector>
 #include "data/sge_mesh.h"
+#include "data/sge_mesh_lod_selector.h"
+#include "data/sge_meshlet.h"
 #include "core/sge_index_buffer.h"
 #include "core/sge_vertex_buffer.h"
 #include "core/sge_constant_buffer.h"
@@ -11,31 +14,61 @@
 
 namespace SGE
 {
+    // Model space bounds an instance is culled with, see Scene::UpdateBoundingVolumes.
+    struct ModelBounds
+    {
+        float3 boxMin;
+        float3 boxMax;
+        float3 sphereCenter;
+        float sphereRadius = 0.0f;
+    };
+
     class ModelInstance
     {
     public:
         void Initialize(ModelAsset* asset, class Device* device, class DescriptorHeap* descriptorHeap, uint32 instanceIndex);
         void SetMaterial(Material* material);
-        void UpdateTransform(const float4x4& viewMatrix, const float4x4& projectionMatrix);
-        void Render(ID3D12GraphicsCommandList* commandList) const;
+        void UpdateTransform(const float4x4& worldMatrix, const float4x4& viewMatrix, const float4x4& projectionMatrix);
+
+        // Chooses the simplified level each mesh is drawn with, see MeshLodSelector.
+        void UpdateLod(const float4x4& worldMatrix, const float3& cameraPosition, float projectionScale, float nearPlane);
+        void SetLodPixelError(float pixelError) { m_lodPixelError = pixelError; m_areClustersDirty = true; }
+        // Asks for the texture mips the model needs at its screen size. Call after UpdateLod.
+        void UpdateTextureDemand() const;
+
+        virtual ModelBounds GetLocalBounds() const;
+
+        // Culls the meshes and meshlets of static models against the camera and uploads the
+        // visible triangles, see MeshletCuller. Call after UpdateLod. Keeps the last result while
+        // the matrices and the LOD stay the same.
+        void UpdateClusters(const float4x4& worldMatrix, const float4x4& viewProjectionMatrix, const float3& cameraPosition);
+        void SetClusterCulling(bool isEnabled) { m_isClusterCullingEnabled = isEnabled; m_areClustersDirty = true; }
+        void SetClusterBackfaceCulling(bool isEnabled) { m_isClusterBackfaceCulled = isEnabled; m_areClustersDirty = true; }
+        // With useClusterCulling, meshes drawn at full detail use the meshlets UpdateClusters
+        // left visible. Passes that don't look through the main camera draw everything.
+        void Render(ID3D12GraphicsCommandList* commandList, bool useClusterCulling = false) const;
         virtual void FixedUpdate(float deltaTime, bool forceUpdate = false);
 
         void SetName(const std::string& name);
         void SetActive(bool isEnabled);
 
-        void SetPosition(const float3& position) { m_position = position; }
-        void SetRotation(const float3& rotation) { m_rotation = rotation; }
-        void SetScale(const float3& scale) { m_scale = scale; }
+        void SetPosition(const float3& position);
+        void SetRotation(const float3& rotation);
+        void SetScale(const float3& scale);
         void SetTiling(const float2& tilingUV) { m_tilingUV = tilingUV; }
+        // Point lights the forward pass shades the model with, uploaded by the next UpdateTransform.
+        void SetPointLightMask(uint32 mask) { m_transformData.pointLightMask = mask; }
 
         const float3& GetPosition() const { return m_position; }
         const float3& GetRotation() const { return m_rotation; }
         const float3& GetScale() const { return m_scale; }
+        // Set by the transform setters until the scene has copied the new values into its hierarchy.
+        bool IsTransformChanged() const { return m_isTransformChanged; }
+        void ClearTransformChanged() { m_isTransformChanged = false; }
 
     protected:
-        virtual const std::vector<Mesh>& GetMeshes() const;
-        virtual void OnUpdateTransform(const float4x4& viewMatrix, const float4x4& projectionMatrix);
-        float4x4 GetWorldMatrix() const;
+        virtual Span<const MeshResourceInfo> GetMeshInfos() const;
+        virtual void OnUpdateTransform(const float4x4& worldMatrix, const float4x4& viewMatrix, const float4x4& projectionMatrix);
         ConstantBuffer  m_transformBuffer;
         TransformBuffer m_transformData;
 
@@ -44,13 +77,35 @@ namespace SGE
         Material*       m_material = nullptr;
         DescriptorHeap* m_descriptorHeap = nullptr;
         VertexBuffer    m_vertexBuffer;
+        VertexBuffer    m_skinBuffer; // left empty for models without bone weights
         IndexBuffer     m_indexBuffer;
+        IndexBuffer     m_clusterIndexBuffer; // visible meshlet triangles, rewritten when the cull inputs change
        
 
         float3 m_position = { 0.0f, 0.0f, 0.0f };
         float3 m_rotation = { 0.0f, 0.0f, 0.0f };
         float3 m_scale    = { 1.0f, 1.0f, 1.0f };
         float2 m_tilingUV = { 1.0f, 1.0f };
+        bool m_isTransformChanged = true;
+
+        float m_lodScale = FLT_MAX; // full detail until the first UpdateLod
+        float m_lodPixelError = DEFAULT_LOD_PIXEL_ERROR;
+
+        struct ClusterDraw
+        {
+            uint32 indexCount = 0;
+            uint32 indexOffset = 0;
+            bool isCulled = false; // false draws the mesh's own range
+        };
+        std::vector<ClusterDraw> m_clusterDraws;
+        std::vector<uint32> m_clusterIndices;
+        bool m_isClusterCullingEnabled = true;
+        bool m_isClusterBackfaceCulled = false; // the default pipeline state draws back faces too
+        // Inputs of the last cull, UpdateClusters skips the cull and upload while they match.
+        float4x4 m_clusterWorldMatrix;
+        float4x4 m_clusterViewProjectionMatrix;
+        float m_clusterLodScale = 0.0f;
+        bool m_areClustersDirty = true;
 
         uint32 m_instanceIndex = 0;
         bool m_enabled = true;
@@ -8,11 +8,6 @@
 #include "data/sge_animated_model_instance.h"
 #include "data/sge_data_structures.h"
 
-#include <assimp/Importer.hpp>
-#include <assimp/scene.h>
-#include <assimp/postprocess.h>
-#include <assimp/matrix4x4.h>
-
 namespace SGE
 {
     class ModelLoader
@@ -21,20 +16,24 @@ namespace SGE
         static bool LoadModel(const ModelAssetData& assetData);
         static bool LoadAnimatedModel(const AnimatedModelAssetData& assetData);
 
-        static ModelInstance* Instantiate(const ModelAssetData& assetSettings, RenderContext* context);
-        static AnimatedModelInstance* InstantiateAnimated(const AnimatedModelAssetData& assetSettings, RenderContext* context);
+        // CPU half of loading: map the cooked .sgemesh next to the source or, when it is missing or
+        // stale, import the source and cook it. Touches no shared state, so several decodes may
+        // run on worker threads at once. Returns nullptr if neither file can be read.
+        static std::unique_ptr<ModelAsset> DecodeModel(const std::string& path);
+        static std::unique_ptr<AnimatedModelAsset> DecodeAnimatedModel(const std::string& path);
 
-    private:
-        static void ProcessNode(aiNode* node, const aiScene* scene, std::vector<Mesh>& meshes, const std::string& modelPath);
-        static Mesh ProcessMesh(aiMesh* mesh, const aiScene* scene, const std::string& modelPath);
+        // Publishes a decoded asset under its file path, main thread only.
+        static void AddModel(const std::string& path, std::unique_ptr<ModelAsset> asset);
+        static void AddAnimatedModel(const std::string& path, std::unique_ptr<AnimatedModelAsset> asset);
 
-        static Skeleton ProcessSkeleton(const aiScene* scene);
-        static std::vector<Animation> ProcessAnimations(const aiScene* scene, const Skeleton& skeleton);
+        static bool HasAsset(const std::string& path);
+        static bool HasAnimatedAsset(const std::string& path);
 
-        static bool HasAsset(const std::string& assetName);
-        static bool HasAnimatedAsset(const std::string& assetName);
+        static ModelInstance* Instantiate(const ModelAssetData& assetSettings, RenderContext* context);
+        static AnimatedModelInstance* InstantiateAnimated(const AnimatedModelAssetData& assetSettings, RenderContext* context);
 
     private:
+        // Keyed by file path, asset entries that share a file share the asset.
         static std::unordered_map<std::string, std::unique_ptr<ModelAsset>> m_modelAssets;
         static std::unordered_map<std::string, std::unique_ptr<AnimatedModelAsset>> m_animatedModelAssets;
 
@@ -42,8 +41,6 @@ namespace SGE
         static std::unordered_map<uint32, std::unique_ptr<AnimatedModelInstance>> m_animatedModelInstances;
         static uint32 m_currentModelInstanceIndex;
     };
-
-    float4x4 AssimpToFloat4x4(const aiMatrix4x4& assimpMatrix);
 }
 
 #endif // !_SGE_MODEL_LOADER_H_
\ No newline at end of file
@@ -8,9 +8,40 @@
 #include "core/sge_constant_buffer.h"
 #include "data/sge_model_instance.h"
 #include "data/sge_animated_model_instance.h"
+#include "core/sge_bounding_volume_hierarchy.h"
+#include "core/sge_transform_hierarchy.h"
+#include "core/sge_entity_registry.h"
+#include "core/sge_job_system.h"
 
 namespace SGE
 {
+    // Components of the scene's entities, each pointing at the scene object it was made from.
+    struct RenderableComponent
+    {
+        const ModelData* data = nullptr;
+        ModelInstance* instance = nullptr;
+        bool isAnimated = false; // drawn like the others, updated after its AnimatorComponent
+        uint32 syncedVersion = INVALID_DATA_VERSION;
+    };
+
+    // Index into the scene's TransformHierarchy, also the model's proxy in its bounding volume hierarchy.
+    struct TransformComponent
+    {
+        uint32 transform = INVALID_TRANSFORM;
+    };
+
+    struct AnimatorComponent
+    {
+        const AnimatedModelData* data = nullptr;
+        AnimatedModelInstance* instance = nullptr;
+    };
+
+    struct PointLightComponent
+    {
+        const PointLightData* data = nullptr;
+        uint32 syncedVersion = INVALID_DATA_VERSION;
+    };
+
     class Scene
     {
     public:
@@ -18,32 +49,58 @@ namespace SGE
         void Update(double deltaTime);
         void Shutdown();
 
-        const std::map<const ModelData*, ModelInstance*>& GetModels() const { return m_modelInstances; }
-        const std::map<const AnimatedModelData*, AnimatedModelInstance*>& GetAnimModels() const { return m_animatedModelInstances; }
+        EntityRegistry& GetRegistry() { return m_registry; }
         AnimatedModelInstance* GetAnimModel(const AnimatedModelData* data) const;
+        // Models whose bounds intersect the view this frame, static models first.
+        const std::vector<ModelInstance*>& GetVisibleModels(SceneView view) const { return m_visibleModels[static_cast<size_t>(view)]; }
+        // The model under a point of the screen, with 0 to 1 from the top left corner.
+        const ObjectDataBase* PickObject(const float2& screenPosition) const;
 
         CubemapAssetData GetSkyboxCubeMap() const { return m_skyboxCubemap; }
 
     private:
         void InitializeCamera();
         void InitializeFrameData();
+        void LoadAssets();
         void InstantiateModels();
         void InstantiateAnimatedModels();
+        void InstantiatePointLights();
+        Entity CreateRenderable(const ModelData* data, ModelInstance* instance, bool isAnimated);
 
         void UpdateCamera(double deltaTime);
         void UpdateModels(double deltaTime);
+        void DispatchAnimationUpdate(float deltaTime);
+        void UpdateTransforms();
+        uint32 FindTransform(const std::string& name) const;
+        void UpdateBoundingVolumes();
+        void AssignPointLights();
         void SyncFrameData();
+        void CullModels();
 
     private:
         class RenderContext* m_context = nullptr;
         
         Camera m_mainCamera;
+        uint32 m_cameraVersion = INVALID_DATA_VERSION;
+        uint32 m_directionalLightVersion = INVALID_DATA_VERSION;
         CameraController m_cameraController;
-        std::map<const ModelData*, ModelInstance*> m_modelInstances;
-        std::map<const AnimatedModelData*, AnimatedModelInstance*> m_animatedModelInstances;
+        EntityRegistry m_registry;
 
         CubemapAssetData m_skyboxCubemap;
 
+        // Renderable instances and their scene objects indexed by transform.
+        std::vector<ModelInstance*> m_cullInstances;
+        std::vector<const ModelData*> m_cullObjects;
+        TransformHierarchy m_transforms;
+        std::vector<std::string> m_parentNames; // the parent each transform was last attached to
+        std::vector<BoundingBox> m_worldBoxes;
+        BoundingVolumeHierarchy m_bvh;
+        std::vector<uint32> m_queryProxies;
+        std::vector<uint32> m_pointLightMasks;
+        std::array<std::vector<ModelInstance*>, static_cast<size_t>(SceneView::Count)> m_visibleModels;
+
+        JobCounter m_animationJobs;
+
         std::unique_ptr<ConstantBuffer> m_frameDataBuffer;
         FrameData m_frameData;
     };
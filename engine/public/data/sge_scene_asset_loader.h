@@ -0,0 +1,38 @@
+#ifndef _SGE_SCENE_ASSET_LOADER_H_
+#define _SGE_SCENE_ASSET_LOADER_H_
+
+#include "pch.h"
+#include "data/sge_asset_loader.h"
+#include "data/sge_data_structures.h"
+
+namespace SGE
+{
+    // Loads everything the scene objects reference before they are instantiated. Models are parsed
+    // with Assimp and textures decoded with DirectXTex on the job system, the uploads then go through
+    // ModelLoader and TextureManager on the main thread, which Instantiate and LoadMaterial hit later.
+    class SceneAssetLoader : public AssetDecoder, public AssetUploadSink
+    {
+    public:
+        void Initialize(class RenderContext* context);
+
+        // Walks the scene objects and requests their models and material textures.
+        void RequestSceneAssets(const SceneData& sceneData, const AssetsData& assetsData);
+        void Wait() { m_loader.Wait(); }
+
+        AssetLoadProgress GetProgress() const { return m_loader.GetProgress(); }
+        bool IsComplete() const { return m_loader.IsComplete(); }
+
+        std::unique_ptr<DecodedAsset> Decode(AssetKind kind, const std::string& path) override;
+        void Upload(AssetKind kind, const std::string& path, DecodedAsset& asset) override;
+
+    private:
+        void RequestMaterialTextures(const MaterialAssetData& materialAsset);
+        void RequestTexture(const std::string& path);
+
+    private:
+        class RenderContext* m_context = nullptr;
+        AssetLoader m_loader;
+    };
+}
+
+#endif // !_SGE_SCENE_ASSET_LOADER_H_
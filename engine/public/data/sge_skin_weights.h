@@ -0,0 +1,37 @@
+#ifndef _SGE_SKIN_WEIGHTS_H_
+#define _SGE_SKIN_WEIGHTS_H_
+
+#include <vector>
+#include "core/sge_types.h"
+
+#include <assimp/mesh.h>
+
+namespace SGE
+{
+    // Influences kept per vertex. The vertex format holds 4, up to 8 can be gathered for rigs
+    // that are processed further on the CPU before they are reduced.
+    constexpr uint32 DEFAULT_SKIN_INFLUENCES = 4;
+    constexpr uint32 MAX_SKIN_INFLUENCES = 8;
+
+    // influenceCount entries per vertex, strongest first and normalized to add up to 1. Unused
+    // entries have bone index -1 and weight 0.
+    struct SkinInfluences
+    {
+        uint32 influenceCount = DEFAULT_SKIN_INFLUENCES;
+        std::vector<int32> boneIndices;
+        std::vector<float> boneWeights;
+    };
+
+    class SkinWeightGatherer
+    {
+    public:
+        // Turns the per bone weight lists of an imported mesh into per vertex influences, the bone
+        // index is the position in bones. Weights are scattered into one flat array grouped by
+        // vertex, then every vertex keeps its strongest ones with a fixed size insertion, in
+        // parallel over vertex ranges. Ties keep the lower bone index, weights of 0 are ignored.
+        static SkinInfluences Gather(const aiBone* const* bones, uint32 boneCount, uint32 vertexCount,
+                                     uint32 influenceCount = DEFAULT_SKIN_INFLUENCES);
+    };
+}
+
+#endif // !_SGE_SKIN_WEIGHTS_H_
@@ -2,6 +2,13 @@
 #define _SGE_TEXTURE_H_
 
 #include "pch.h"
+#include "core/sge_span.h"
+#include "data/sge_texture_cooker.h"
+
+namespace DirectX
+{
+    class ScratchImage;
+}
 
 namespace SGE
 {
@@ -18,8 +25,21 @@ namespace SGE
     {
     public:
         void Initialize(const std::string& texturePath, const class Device* device, const class DescriptorHeap* descriptorHeap, uint32 descriptorIndex);
+        void Initialize(const DirectX::ScratchImage& image, const class Device* device, const class DescriptorHeap* descriptorHeap, uint32 descriptorIndex);
         uint32 GetDescriptorIndex() const { return m_descriptorIndex; }
 
+        // Streaming: replaces the resource with the given chain, finest first, and points the
+        // descriptor at it. The replaced resources stay alive until ReleaseRetiredResources.
+        void Initialize(Span<const TextureImage> mips, CookedTextureFormat format, const class Device* device, const class DescriptorHeap* descriptorHeap, uint32 descriptorIndex);
+        // Copies all but the count finest mips into a smaller resource on the GPU.
+        void DropMips(uint32 count, const class Device* device, const class DescriptorHeap* descriptorHeap);
+        // Only once the GPU is done with the frames that used them.
+        void ReleaseRetiredResources() { m_retiredResources.clear(); }
+        uint32 GetMipCount() const { return m_mipCount; }
+
+        // Reads and decodes the file without touching the device, safe to call from worker threads.
+        static std::unique_ptr<DirectX::ScratchImage> Decode(const std::string& texturePath);
+
         void CreateDefaultAlbedo(const class Device* device, const class DescriptorHeap* descriptorHeap, uint32 descriptorIndex);
         void CreateDefaultMetallic(const class Device* device, const class DescriptorHeap* descriptorHeap, uint32 descriptorIndex);
         void CreateDefaultRoughness(const class Device* device, const class DescriptorHeap* descriptorHeap, uint32 descriptorIndex);
@@ -27,11 +47,14 @@ namespace SGE
 
     private:
         void CreateSinglePixelTexture(uint32 color, const class Device* device, const class DescriptorHeap* descriptorHeap, uint32 descriptorIndex);
+        void CreateShaderResourceView(DXGI_FORMAT format, const class Device* device, const class DescriptorHeap* descriptorHeap, uint32 descriptorIndex);
 
     private:
         ComPtr<ID3D12Resource> m_resource = nullptr;
         ComPtr<ID3D12Resource> m_resourceUpload = nullptr;
+        std::vector<ComPtr<ID3D12Resource>> m_retiredResources;
         uint32 m_descriptorIndex = 0;
+        uint32 m_mipCount = 1;
     };
 }
 
@@ -0,0 +1,89 @@
+#ifndef _SGE_TEXTURE_COOKER_H_
+#define _SGE_TEXTURE_COOKER_H_
+
+#include <string>
+#include <vector>
+#include "core/sge_types.h"
+
+namespace SGE
+{
+    constexpr const char* COOKED_TEXTURE_EXTENSION = ".dds";
+
+    // Pixel formats of cooked textures, values match DXGI_FORMAT so they go to the DDS header as is.
+    // The BC formats store 4x4 texel blocks, see TextureEncoder.
+    enum class CookedTextureFormat : uint32
+    {
+        RGBA8 = 28, // DXGI_FORMAT_R8G8B8A8_UNORM
+        BC1 = 71,   // DXGI_FORMAT_BC1_UNORM, opaque RGB in 8 bytes a block
+        BC3 = 77,   // DXGI_FORMAT_BC3_UNORM, BC1 color and BC4 alpha
+        BC4 = 80,   // DXGI_FORMAT_BC4_UNORM, one channel in 8 bytes a block
+        BC5 = 83,   // DXGI_FORMAT_BC5_UNORM, two BC4 channels
+        BC7 = 98    // DXGI_FORMAT_BC7_UNORM, RGBA in 16 bytes a block
+    };
+
+    // What a texture holds decides its cooked format, see TextureEncoder::SelectFormat.
+    enum class TextureUsage : uint8
+    {
+        Color,        // albedo, cubemap faces
+        CompactColor, // albedo at half the size of Color with lower quality
+        Normal,       // tangent space normals, the shaders rebuild z from x and y
+        Mask          // roughness, metallic, occlusion: only the red channel is read
+    };
+
+    // One mip level, tightly packed rows in the texture's format. Sources and mip chains are RGBA8.
+    struct TextureImage
+    {
+        uint32 width = 0;
+        uint32 height = 0;
+        std::vector<uint8> pixels;
+    };
+
+    // Size of a cooked .dds as read from its headers, enough to plan streaming before any pixels are read.
+    struct CookedTextureInfo
+    {
+        uint32 width = 0;
+        uint32 height = 0;
+        uint32 mipCount = 0;
+        CookedTextureFormat format = CookedTextureFormat::RGBA8;
+    };
+
+    bool IsBlockCompressed(CookedTextureFormat format);
+    // For block formats a row is a row of 4x4 blocks, partial blocks count as whole ones.
+    uint32 GetTextureRowPitch(CookedTextureFormat format, uint32 width);
+    uint64 GetTextureMipSize(CookedTextureFormat format, uint32 width, uint32 height);
+
+    // Turns source images (png, jpg, tga, bmp) into .dds files with a full mip chain, block compressed
+    // for the texture's usage, that Texture loads without any conversion. Needs no device, runs
+    // wherever the cooker runs.
+    class TextureCooker
+    {
+    public:
+        static std::string GetCookedPath(const std::string& sourcePath);
+
+        // True for source formats the cooker can read. Files that are .dds already are used as is.
+        static bool IsCookable(const std::string& sourcePath);
+
+        // Guesses the usage from the file name, for textures found without a material.
+        static TextureUsage GetUsageFromName(const std::string& sourcePath);
+
+        // The cooked file if it exists and is not older than the source, otherwise the source.
+        static std::string ResolveRuntimePath(const std::string& sourcePath);
+
+        static bool Decode(const std::string& sourcePath, TextureImage& image);
+
+        // Box filtered chain down to 1x1, level 0 is the source image.
+        static std::vector<TextureImage> BuildMipChain(TextureImage image);
+
+        static bool WriteDDS(const std::string& path, const std::vector<TextureImage>& mips, CookedTextureFormat format);
+
+        // Only files with the layout WriteDDS produces are accepted, anything else is left to the
+        // full decoder. ReadDDSMips reads mips [firstMip, mipCount) and seeks past the finer ones.
+        static bool ReadDDSInfo(const std::string& path, CookedTextureInfo& info);
+        static bool ReadDDSMips(const std::string& path, uint32 firstMip, std::vector<TextureImage>& mips);
+
+        // Decode, mips, encoding and DDS in one call. False if the source can't be read or the file written.
+        static bool Cook(const std::string& sourcePath, const std::string& cookedPath, TextureUsage usage = TextureUsage::Color);
+    };
+}
+
+#endif // !_SGE_TEXTURE_COOKER_H_
@@ -0,0 +1,36 @@
+#ifndef _SGE_TEXTURE_ENCODER_H_
+#define _SGE_TEXTURE_ENCODER_H_
+
+#include "core/sge_types.h"
+#include "data/sge_texture_cooker.h"
+
+namespace SGE
+{
+    // CPU encoder for the block compressed formats of cooked textures. Each 4x4 block gets its
+    // endpoints from the principal axis of its texels, refined by least squares against the
+    // indices they produce. BC7 uses mode 6 only, a single RGBA line with 16 levels.
+    // Rows of blocks are encoded in parallel on the job system.
+    class TextureEncoder
+    {
+    public:
+        static uint32 GetBlockSize(CookedTextureFormat format);
+
+        // BC7 for color, BC1 or BC3 (with alpha) for compact color, BC5 for normals, BC4 for masks.
+        // Sizes that aren't powers of two stay RGBA8: each streamed mip of a BC texture has to
+        // be whole blocks.
+        static CookedTextureFormat SelectFormat(TextureUsage usage, const TextureImage& image);
+
+        // image is RGBA8, the result holds the blocks of the given format.
+        static TextureImage Encode(const TextureImage& image, CookedTextureFormat format);
+
+        // Back to RGBA8, for tests and tools. Reads what Encode writes: BC7 blocks in other modes
+        // than 6 decode as black.
+        static TextureImage Decode(const TextureImage& image, CookedTextureFormat format);
+
+        // Peak signal to noise ratio in dB over the first channelCount channels of two RGBA8
+        // images of the same size. Identical images give infinity.
+        static double ComputePSNR(const TextureImage& reference, const TextureImage& image, uint32 channelCount = 3);
+    };
+}
+
+#endif // !_SGE_TEXTURE_ENCODER_H_
@@ -2,9 +2,11 @@
 #define _SGE_TEXTURE_MANAGER_H_
 
 #include "pch.h"
+#include "core/sge_descriptor_allocator.h"
 #include "data/sge_texture.h"
 #include "data/sge_cubemap_texture.h"
 #include "data/sge_data_structures.h"
+#include "data/sge_texture_streamer.h"
 
 namespace SGE
 {
@@ -14,8 +16,22 @@ namespace SGE
         static uint32 GetTextureIndex(const std::string& texturePath, TextureType type, const class Device* device, const class DescriptorHeap* descriptorHeap);
         static uint32 GetCubemapIndex(const CubemapAssetData& cubemapData, const class Device* device, const class DescriptorHeap* descriptorHeap);
 
+        // Uploads an image decoded with Texture::Decode and caches it under texturePath.
+        static uint32 AddTexture(const std::string& texturePath, const DirectX::ScratchImage& image, const class Device* device, const class DescriptorHeap* descriptorHeap);
+        static bool HasTexture(const std::string& texturePath);
+
+        // Cooked textures are streamed: GetTextureIndex uploads only their mip tail and the rest
+        // follows as RequestScreenSize asks for it. Once per frame, with the command list open.
+        static void UpdateStreaming();
+        static void RequestScreenSize(uint32 descriptorIndex, float pixels);
+        static void SetStreamingBudget(uint64 bytes);
+        static TextureResidencyStats GetStreamingStats();
+        static void ShutdownStreaming();
+
     private:
         static void CreateDefaultTextures(const class Device* device, const class DescriptorHeap* descriptorHeap);
+        static bool RegisterStreamedTexture(const std::string& texturePath, Texture* texture, uint32 descriptorIndex, const class Device* device, const class DescriptorHeap* descriptorHeap);
+        static uint32 AllocateDescriptorIndex();
 
     private:
         struct TextureData
@@ -33,7 +49,9 @@ namespace SGE
         static std::unordered_map<std::string, TextureData> m_textureCache;
         static std::unordered_map<std::string, CubemapData> m_cubemapCache;
         static std::unordered_map<TextureType, std::unique_ptr<Texture>> m_defaultTextures;
-        static uint32 m_currentTextureIndex;
+        static std::unordered_map<uint32, StreamedTextureId> m_streamedTextures;
+        static TextureStreamer m_streamer;
+        static DescriptorAllocator m_descriptorAllocator; // the bindless texture range
         static bool hasDefaultTextures;
     };
 }
@@ -0,0 +1,157 @@
+#ifndef _SGE_TEXTURE_STREAMER_H_
+#define _SGE_TEXTURE_STREAMER_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "core/sge_job_system.h"
+#include "core/sge_non_copyable.h"
+#include "core/sge_types.h"
+#include "data/sge_asset_loader.h"
+#include "data/sge_texture_cooker.h"
+
+namespace SGE
+{
+    using StreamedTextureId = uint32;
+    constexpr StreamedTextureId INVALID_STREAMED_TEXTURE = ~0u;
+
+    // Mips no larger than this on either side form the tail, block compressed textures of extreme
+    // aspect ratios keep some larger ones. It is loaded when the texture is registered and stays
+    // resident until the streamer goes away.
+    constexpr uint32 TEXTURE_MIP_TAIL_SIZE = 64;
+
+    struct StreamedTextureDesc
+    {
+        std::string path;
+        uint32 width = 0;
+        uint32 height = 0;
+        uint32 mipCount = 1;
+        CookedTextureFormat format = CookedTextureFormat::RGBA8;
+        uint32 resourceIndex = 0; // lets the backend find its resource, e.g. the descriptor index
+
+        uint32 GetTailMip() const;
+        uint64 GetMipSize(uint32 mip) const;
+        // Bytes of mips [firstMip, endMip).
+        uint64 GetSize(uint32 firstMip, uint32 endMip) const;
+    };
+
+    struct TextureStreamingSettings
+    {
+        uint64 memoryBudget = 256ull << 20;
+        uint32 maxLoadsInFlight = 4;
+    };
+
+    struct TextureResidencyStats
+    {
+        uint32 textureCount = 0;
+        uint32 satisfiedCount = 0; // textures with every mip they are asked for
+        uint32 loadsInFlight = 0;
+        uint64 memoryBudget = 0;
+        uint64 residentBytes = 0;
+        uint64 pendingBytes = 0;   // reserved by loads in flight
+        uint64 wantedBytes = 0;    // what the current demand would take without a budget
+        uint64 loadedBytes = 0;    // totals since Initialize
+        uint64 evictedBytes = 0;
+    };
+
+    // Device side of the streamer. LoadMips runs on worker threads, everything else on the main
+    // thread, between frames or while the frame's command list is open.
+    class TextureStreamingBackend
+    {
+    public:
+        virtual ~TextureStreamingBackend() = default;
+
+        // Reads mips [firstMip, mipCount). nullptr if the file can't be read.
+        virtual std::unique_ptr<DecodedAsset> LoadMips(const StreamedTextureDesc& desc, uint32 firstMip) = 0;
+
+        // Makes [firstMip, mipCount) the resident mips, using what LoadMips returned.
+        virtual void UploadMips(const StreamedTextureDesc& desc, uint32 firstMip, DecodedAsset& mips) = 0;
+
+        // Drops the mips finer than firstMip, the coarser ones stay as they are.
+        virtual void EvictMips(const StreamedTextureDesc& desc, uint32 firstMip) = 0;
+    };
+
+    // Decides which mips of which textures are resident. Every texture starts with its mip tail.
+    // Each frame the renderer reports how many pixels a texture covers on screen, Update turns that
+    // into the finest mip worth having, loads the missing ones in the background, most missing
+    // levels first, and keeps the total under the memory budget by dropping fine mips of the least
+    // recently used textures. Mips a texture was asked for in the last frame are never dropped.
+    // Everything but the loads runs on the main thread.
+    class TextureStreamer : public NonCopyable
+    {
+    public:
+        TextureStreamer() = default;
+        ~TextureStreamer();
+
+        void Initialize(TextureStreamingBackend* backend, const TextureStreamingSettings& settings = {});
+        // Waits for the loads in flight and forgets every texture, without evicting anything.
+        void Shutdown();
+
+        // Loads and uploads the mip tail on the calling thread, so the texture can be drawn right
+        // away. INVALID_STREAMED_TEXTURE if the tail can't be read.
+        StreamedTextureId Register(const StreamedTextureDesc& desc);
+
+        // Screen space size of something drawn with the texture, in pixels along its longer side.
+        // The largest request of a frame wins.
+        void RequestScreenSize(StreamedTextureId id, float pixels);
+
+        // Once per frame: uploads finished loads, settles the budget and starts new loads.
+        void Update();
+
+        void SetMemoryBudget(uint64 bytes) { m_settings.memoryBudget = bytes; }
+
+        // The finest mip worth having for a texture covering the given number of pixels.
+        static uint32 ComputeWantedMip(const StreamedTextureDesc& desc, float pixels);
+
+        uint32 GetResidentMip(StreamedTextureId id) const { return m_textures[id].residentMip; }
+        uint32 GetWantedMip(StreamedTextureId id) const { return m_textures[id].wantedMip; }
+        bool IsLoading(StreamedTextureId id) const { return m_textures[id].isLoading; }
+        TextureResidencyStats GetStats() const;
+
+    private:
+        struct TextureState
+        {
+            StreamedTextureDesc desc;
+            uint32 tailMip = 0;
+            uint32 residentMip = 0;
+            uint32 wantedMip = 0;
+            float demand = 0.0f;       // pixels requested since the last Update
+            float lastDemand = 0.0f;   // what the last Update worked with
+            uint64 lastUsedFrame = 0;
+            bool isLoading = false;
+            bool isStreamable = true;  // false once a load failed, the texture keeps what it has
+        };
+
+        struct CompletedLoad
+        {
+            StreamedTextureId id;
+            uint32 firstMip;
+            std::unique_ptr<DecodedAsset> mips;
+        };
+
+        void FinishLoads();
+        void StartLoad(StreamedTextureId id, uint32 firstMip);
+        // Drops fine mips in LRU order until bytes fit under the budget next to what is resident
+        // and pending. Skips the texture that asks for the room.
+        bool MakeRoom(uint64 bytes, StreamedTextureId requester);
+        void Evict(TextureState& texture, uint32 firstMip);
+
+        TextureStreamingBackend* m_backend = nullptr;
+        TextureStreamingSettings m_settings;
+        std::vector<TextureState> m_textures;
+        uint64 m_frame = 0;
+
+        uint64 m_residentBytes = 0;
+        uint64 m_pendingBytes = 0;
+        uint64 m_loadedBytes = 0;
+        uint64 m_evictedBytes = 0;
+        uint32 m_loadsInFlight = 0;
+
+        JobCounter m_loads;
+        std::mutex m_completedMutex;
+        std::vector<CompletedLoad> m_completed;
+    };
+}
+
+#endif // !_SGE_TEXTURE_STREAMER_H_
@@ -0,0 +1,66 @@
+#ifndef _SGE_VERTEX_H_
+#define _SGE_VERTEX_H_
+
+#include "core/sge_types.h"
+#include "core/sge_math.h"
+
+namespace SGE
+{
+    // Full precision vertex as it comes out of the importer. Processing works on this format,
+    // ModelAsset packs it into the streams below for the GPU and the cooked files.
+    struct alignas(16) Vertex
+    {
+        float3 position;
+        float3 normal;
+        float2 texCoords;
+        float3 tangent;
+        float3 bitangent;
+        float  boneWeights[4];
+        int32  boneIndices[4];
+    };
+    static_assert(alignof(Vertex) == 16, "Vertex structure alignment mismatch");
+
+    // Vertex stream 0, used by every mesh.
+    // normal:    R10G10B10A2_UNORM, xyz mapped from [-1, 1].
+    // tangent:   R10G10B10A2_UNORM, xyz mapped from [-1, 1], w is 1 if the bitangent is
+    //            cross(normal, tangent) and 0 if it is the opposite.
+    // texCoords: R16G16_FLOAT.
+    struct PackedVertex
+    {
+        float3 position;
+        uint32 normal;
+        uint32 tangent;
+        uint32 texCoords;
+    };
+    static_assert(sizeof(PackedVertex) == 24, "PackedVertex must match the input layout");
+
+    // Vertex stream 1, only present for meshes with bone weights. Unused influences have
+    // index 0 and weight 0, the weights of a skinned vertex add up to exactly 255.
+    struct SkinVertex
+    {
+        uint8 boneIndices[4];
+        uint8 boneWeights[4];
+    };
+    static_assert(sizeof(SkinVertex) == 8, "SkinVertex must match the input layout");
+
+    // Bone indices are stored in 8 bits, influences on bones past this are dropped.
+    constexpr uint32 MAX_SKIN_BONES = 256;
+
+    uint16 FloatToHalf(float value);
+    float HalfToFloat(uint16 value);
+
+    // xyz in [-1, 1] to 10 bits each, w in [0, 1] to 2 bits.
+    uint32 PackUnitVector(const float3& vector, float w);
+    float3 UnpackUnitVector(uint32 packed);
+    float UnpackUnitVectorW(uint32 packed);
+
+    PackedVertex PackVertex(const Vertex& vertex);
+    SkinVertex PackSkin(const Vertex& vertex);
+    bool HasSkin(const Vertex& vertex);
+
+    // Fills everything but the bone data, the bitangent is rebuilt from the sign.
+    Vertex UnpackVertex(const PackedVertex& packed);
+    void UnpackSkin(const SkinVertex& skin, Vertex& vertex);
+}
+
+#endif // !_SGE_VERTEX_H_
@@ -5,6 +5,10 @@
 #define WIN32_LEAN_AND_MEAN // Exclude rarely-used stuff from Windows headers.
 #endif
 
+#ifndef NOMINMAX
+#define NOMINMAX // Keep std::min and std::max usable, the shared headers call them.
+#endif
+
 #include <windows.h>
 #include <dxgi.h>
 #include <dxgi1_6.h>
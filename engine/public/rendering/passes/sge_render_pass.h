@@ -37,7 +37,9 @@ namespace SGE
         void BindRenderTargetSRV(const std::string& name, uint32 descIndex);
 
         void DrawQuad();
-        void DrawModels(class Scene* scene);
+        // Draws the models the scene found visible from the view. Passes that render from the
+        // main camera can use the meshlets it left visible.
+        void DrawModels(class Scene* scene, SceneView view = SceneView::Camera, bool useClusterCulling = true);
 
     protected:
         class RenderContext* m_context = nullptr;
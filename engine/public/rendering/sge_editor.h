@@ -45,6 +45,9 @@ namespace SGE
 
         void ConstructAnimationEditor();
 
+        void SelectObject(ObjectDataBase* object, int32 index);
+        void PickObject();
+
         void SetGrayStyle();
     
         uint32 GetTextureIndex(const std::string& name) const;
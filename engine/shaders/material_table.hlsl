@@ -0,0 +1,22 @@
+// Bindless materials, the draw only sets the material index. Layout matches MaterialGpuData,
+// texture indices count from the start of the bindless texture range.
+struct MaterialData
+{
+    uint albedoTexture;
+    uint normalTexture;
+    uint metallicTexture;
+    uint roughnessTexture;
+};
+
+cbuffer MaterialIndex : register(b2)
+{
+    uint materialIndex;
+};
+
+StructuredBuffer<MaterialData> g_Materials : register(t0, space1);
+Texture2D<float4> g_Textures[] : register(t0, space2);
+
+MaterialData GetMaterial()
+{
+    return g_Materials[materialIndex];
+}
\ No newline at end of file
@@ -1,13 +1,10 @@
 #include "transform_buffer.hlsl"
 #include "pixel_input.hlsl"
 #include "scene_data.hlsl"
+#include "material_table.hlsl"
 #include "brdf.hlsl"
 #include "shadows.hlsl"
 
-Texture2D<float4> diffuseMap : register(t0);
-Texture2D<float4> normalMap : register(t1);
-Texture2D<float4> metallicMap : register(t2);
-Texture2D<float4> roughnessMap : register(t3);
 Texture2D<float> g_ShadowMap : register(t4);
 Texture2D<float4> g_SSAO : register(t5);
 
@@ -29,10 +26,11 @@ float4 main(PixelInput input) : SV_TARGET
 {
     float2 uv = float2(input.texCoords.x, 1.0f - input.texCoords.y) * tilingUV;
 
-    float3 albedo = diffuseMap.Sample(sampleWrap, uv).rgb;
-    float  metallic = metallicMap.Sample(sampleWrap, uv).r;
-    float3 normalMapValue = normalMap.Sample(sampleWrap, uv).xyz * 2.0f - 1.0f;
-    float  roughness = roughnessMap.Sample(sampleWrap, uv).r;
+    MaterialData material = GetMaterial();
+    float3 albedo = g_Textures[material.albedoTexture].Sample(sampleWrap, uv).rgb;
+    float  metallic = g_Textures[material.metallicTexture].Sample(sampleWrap, uv).r;
+    float3 normalMapValue = g_Textures[material.normalTexture].Sample(sampleWrap, uv).xyz * 2.0f - 1.0f;
+    float  roughness = g_Textures[material.roughnessTexture].Sample(sampleWrap, uv).r;
 
     float2 tangentBitangent = normalMapValue.xy;
     float  normalLength = sqrt(saturate(1.0f - dot(tangentBitangent, tangentBitangent)));
@@ -50,7 +48,10 @@ float4 main(PixelInput input) : SV_TARGET
     float3 finalColor = CalculateDirectionalLight(worldNormal, albedo, metallic, roughness, viewDir, directionalLight) * shadowFactor;
     for (uint i = 0; i < activePointLightsCount; ++i)
     {
-        finalColor += CalculatePointLight(input.worldPosition, worldNormal, albedo, metallic, roughness, viewDir, pointLights[i]);
+        if (pointLightMask & (1u << i))
+        {
+            finalColor += CalculatePointLight(input.worldPosition, worldNormal, albedo, metallic, roughness, viewDir, pointLights[i]);
+        }
     }
     for (uint i = 0; i < activeSpotLightsCount; ++i)
     {
@@ -6,4 +6,5 @@ cbuffer TransformBuffer : register(b1)
     matrix boneTransforms[100];
     bool isAnimated;
     float2 tilingUV;
+    uint pointLightMask;
 }
\ No newline at end of file
@@ -1,17 +1,22 @@
 #include "transform_buffer.hlsl"
 #include "pixel_input.hlsl"
 
+// Matches PackedVertex and SkinVertex, see PipelineState::CreateDefaultConfig.
 struct VertexInput
 {
     float3 position      : POSITION;
-    float3 normal        : NORMAL;
+    float4 normal        : NORMAL;   // xyz in [0, 1]
+    float4 tangent       : TANGENT;  // xyz in [0, 1], w is the bitangent sign
     float2 texCoords     : TEXCOORD;
-    float3 tangent       : TANGENT;
-    float3 bitangent     : BITANGENT;
     float4 boneWeights   : BONE_WEIGHTS;
-    int4   boneIndices   : BONE_INDICES;
+    uint4  boneIndices   : BONE_INDICES;
 };
 
+float3 DecodeUnitVector(float4 packed)
+{
+    return packed.xyz * 2.0f - 1.0f;
+}
+
 PixelInput TransformVertex(VertexInput input)
 {
     PixelInput output;
@@ -37,9 +42,13 @@ PixelInput TransformVertex(VertexInput input)
     float4 viewPos = mul(worldPosition, view);
     output.position = mul(viewPos, projection);
 
-    output.normal    = normalize(mul(input.normal, normalMatrix));
-    output.tangent   = normalize(mul(input.tangent, normalMatrix));
-    output.bitangent = normalize(mul(input.bitangent, normalMatrix));
+    float3 normal    = DecodeUnitVector(input.normal);
+    float3 tangent   = DecodeUnitVector(input.tangent);
+    float3 bitangent = cross(normal, tangent) * (input.tangent.w > 0.5f ? 1.0f : -1.0f);
+
+    output.normal    = normalize(mul(normal, normalMatrix));
+    output.tangent   = normalize(mul(tangent, normalMatrix));
+    output.bitangent = normalize(mul(bitangent, normalMatrix));
 
     output.texCoords = input.texCoords;
 
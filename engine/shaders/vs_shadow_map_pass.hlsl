@@ -4,12 +4,8 @@
 struct VertexInput
 {
     float3 position      : POSITION;
-    float3 normal        : NORMAL;
-    float2 texCoords     : TEXCOORD;
-    float3 tangent       : TANGENT;
-    float3 bitangent     : BITANGENT;
     float4 boneWeights   : BONE_WEIGHTS;
-    int4   boneIndices   : BONE_INDICES;
+    uint4  boneIndices   : BONE_INDICES;
 };
 
 struct VSOutput
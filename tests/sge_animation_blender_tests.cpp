@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include "data/sge_animation_blender.h"
+using namespace SGE;
+
+namespace
+{
+    // Three bones in a chain, "Walk" animates all of them, "Wave" only the last two.
+    const std::unordered_map<std::string, int32> BONE_NAME_TO_INDEX = { { "Hips", 0 }, { "Spine", 1 }, { "Hand", 2 } };
+
+    AnimationClip MakeClip(const std::string& name, float yaw, float offset, bool animateHips)
+    {
+        Animation animation;
+        animation.name = name;
+        animation.duration = 4.0f;
+        animation.ticksPerSecond = 25.0f;
+
+        for (const auto& [boneName, boneIndex] : BONE_NAME_TO_INDEX)
+        {
+            if (boneIndex == 0 && !animateHips)
+            {
+                continue;
+            }
+
+            BoneKeyframes& keyframes = animation.boneKeyframes[boneName];
+            for (int key = 0; key <= 4; ++key)
+            {
+                float time = static_cast<float>(key);
+                keyframes.positionKeys.push_back({ time, float3(offset + time, 0.0f, 0.0f) });
+                keyframes.rotationKeys.push_back({ time, CreateQuaternionYawPitchRoll(yaw * time, 0.0f, 0.0f) });
+                keyframes.scaleKeys.push_back({ time, float3::One });
+            }
+        }
+
+        AnimationClip clip;
+        clip.Initialize(animation, BONE_NAME_TO_INDEX, 3);
+        return clip;
+    }
+
+    BoneHierarchy MakeHierarchy()
+    {
+        BoneHierarchy hierarchy;
+        hierarchy.Initialize({ -1, 0, 1 }, { float4x4::Identity, CreateTranslationMatrix(float3(0.0f, -1.0f, 0.0f)), CreateTranslationMatrix(float3(0.0f, -2.0f, 0.0f)) });
+        return hierarchy;
+    }
+
+    void ExpectBonePoseNear(const BonePose& actual, const BonePose& expected)
+    {
+        EXPECT_EQ(actual.position, expected.position);
+        EXPECT_NEAR(std::abs(dot(actual.rotation, expected.rotation)), 1.0f, 1e-5f);
+        EXPECT_EQ(actual.scale, expected.scale);
+    }
+}
+
+TEST(sge_animation_blender, BindPoseFromOffsets)
+{
+    BoneHierarchy hierarchy = MakeHierarchy();
+    ExpectBonePoseNear(hierarchy.bindPose[1], { float3(0.0f, 1.0f, 0.0f), float4::Identity, float3::One });
+    ExpectBonePoseNear(hierarchy.bindPose[2], { float3(0.0f, 1.0f, 0.0f), float4::Identity, float3::One });
+
+    AnimationPose pose;
+    pose.Initialize(hierarchy.GetBoneCount());
+    AnimationBlender().Evaluate(hierarchy, Span<const AnimationBlendLayer>(), pose);
+    pose.ComputeModelPose(hierarchy);
+    pose.ComputeSkinningPalette(hierarchy);
+
+    for (const float4x4& matrix : pose.GetSkinningPalette())
+    {
+        EXPECT_EQ(matrix, float4x4::Identity);
+    }
+}
+
+TEST(sge_animation_blender, SingleOverrideLayerMatchesClip)
+{
+    BoneHierarchy hierarchy = MakeHierarchy();
+    AnimationClip walk = MakeClip("Walk", 0.3f, 0.0f, true);
+
+    AnimationBlendLayer layer;
+    layer.clip = &walk;
+    layer.time = 2.5f;
+
+    AnimationPose pose;
+    pose.Initialize(hierarchy.GetBoneCount());
+    AnimationBlender().Evaluate(hierarchy, Span<const AnimationBlendLayer>(&layer, 1), pose);
+
+    for (int32 bone = 0; bone < 3; ++bone)
+    {
+        ExpectBonePoseNear(pose.GetBonePose(bone), walk.SampleBone(bone, 2.5f));
+    }
+}
+
+TEST(sge_animation_blender, MaskedLayersSkipZeroWeightBones)
+{
+    BoneHierarchy hierarchy = MakeHierarchy();
+    AnimationClip walk = MakeClip("Walk", 0.3f, 0.0f, true);
+    AnimationClip wave = MakeClip("Wave", -0.5f, 10.0f, true);
+
+    BoneMask lowerBody, upperBody;
+    lowerBody.Initialize({ 1.0f, 0.0f, 0.0f });
+    upperBody.Initialize({ 0.0f, 1.0f, 1.0f });
+    EXPECT_EQ(lowerBody.GetSize(), 1u);
+    EXPECT_EQ(upperBody.GetSize(), 2u);
+
+    std::vector<KeyframeCursor> walkCursors, waveCursors;
+    AnimationBlendLayer layers[2];
+    layers[0] = { &walk, &walkCursors, 3.5f, 1.0f, AnimationBlendMode::Override, &lowerBody };
+    layers[1] = { &wave, &waveCursors, 3.5f, 1.0f, AnimationBlendMode::Override, &upperBody };
+
+    AnimationPose pose;
+    pose.Initialize(hierarchy.GetBoneCount());
+    AnimationBlender().Evaluate(hierarchy, layers, pose);
+
+    ExpectBonePoseNear(pose.GetBonePose(0), walk.SampleBone(0, 3.5f));
+    ExpectBonePoseNear(pose.GetBonePose(1), wave.SampleBone(1, 3.5f));
+    ExpectBonePoseNear(pose.GetBonePose(2), wave.SampleBone(2, 3.5f));
+
+    // Masked out bones were never sampled, so their cursors never moved.
+    EXPECT_EQ(walkCursors[0].position, 3u);
+    EXPECT_EQ(walkCursors[1].position, 0u);
+    EXPECT_EQ(walkCursors[2].position, 0u);
+    EXPECT_EQ(waveCursors[0].position, 0u);
+    EXPECT_EQ(waveCursors[2].position, 3u);
+}
+
+TEST(sge_animation_blender, PartialOverrideBlendsInLocalSpace)
+{
+    BoneHierarchy hierarchy = MakeHierarchy();
+    AnimationClip walk = MakeClip("Walk", 0.3f, 0.0f, true);
+    AnimationClip wave = MakeClip("Wave", -0.5f, 10.0f, false);
+
+    AnimationBlendLayer layers[2];
+    layers[0] = { &walk, nullptr, 2.0f, 1.0f, AnimationBlendMode::Override, nullptr };
+    layers[1] = { &wave, nullptr, 2.0f, 0.25f, AnimationBlendMode::Override, nullptr };
+
+    AnimationBlender blender;
+    AnimationPose pose;
+    pose.Initialize(hierarchy.GetBoneCount());
+
+    for (RotationBlend rotationBlend : { RotationBlend::Nlerp, RotationBlend::Slerp })
+    {
+        blender.SetRotationBlend(rotationBlend);
+        blender.Evaluate(hierarchy, layers, pose);
+
+        // Hips have no keys in the top layer and keep the pose of the layer below.
+        ExpectBonePoseNear(pose.GetBonePose(0), walk.SampleBone(0, 2.0f));
+
+        BonePose base = walk.SampleBone(1, 2.0f);
+        BonePose top = wave.SampleBone(1, 2.0f);
+        BonePose blended = pose.GetBonePose(1);
+        float4 expectedRotation = rotationBlend == RotationBlend::Slerp ? slerp(base.rotation, top.rotation, 0.25f) : nlerp(base.rotation, top.rotation, 0.25f);
+
+        EXPECT_EQ(blended.position, lerp(base.position, top.position, 0.25f));
+        EXPECT_NEAR(length(blended.rotation), 1.0f, 1e-5f);
+        EXPECT_NEAR(std::abs(dot(blended.rotation, expectedRotation)), 1.0f, 1e-5f);
+    }
+}
+
+TEST(sge_animation_blender, AdditiveLayerAppliesDelta)
+{
+    BoneHierarchy hierarchy = MakeHierarchy();
+    AnimationClip walk = MakeClip("Walk", 0.3f, 0.0f, true);
+    AnimationClip lean = MakeClip("Lean", 0.2f, 1.0f, true);
+
+    AnimationBlendLayer layers[2];
+    layers[0] = { &walk, nullptr, 1.0f, 1.0f, AnimationBlendMode::Override, nullptr };
+    layers[1] = { &lean, nullptr, 1.0f, 1.0f, AnimationBlendMode::Additive, nullptr };
+
+    AnimationPose pose;
+    pose.Initialize(hierarchy.GetBoneCount());
+    AnimationBlender blender;
+    blender.Evaluate(hierarchy, layers, pose);
+
+    BonePose base = walk.SampleBone(2, 1.0f);
+    BonePose delta = lean.SampleBone(2, 1.0f);
+    ExpectBonePoseNear(pose.GetBonePose(2), { base.position + delta.position, MultiplyQuaternions(base.rotation, delta.rotation), base.scale });
+
+    // Zero weight leaves the pose untouched.
+    layers[1].weight = 0.0f;
+    blender.Evaluate(hierarchy, layers, pose);
+    ExpectBonePoseNear(pose.GetBonePose(2), base);
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "data/sge_animation.h"
+#include "data/sge_keyframe_sampler.h"
+using namespace SGE;
+
+namespace
+{
+    Animation MakeAnimation()
+    {
+        Animation animation;
+        animation.name = "Walk";
+        animation.duration = 10.0f;
+        animation.ticksPerSecond = 30.0f;
+
+        BoneKeyframes& hips = animation.boneKeyframes["Hips"];
+        for (int i = 0; i <= 10; ++i)
+        {
+            float time = static_cast<float>(i);
+            hips.positionKeys.push_back({ time, float3(time, 0.0f, 0.0f) });
+            hips.rotationKeys.push_back({ time, CreateQuaternionYawPitchRoll(time * 0.1f, 0.0f, 0.0f) });
+            hips.scaleKeys.push_back({ time, float3(1.0f + time, 1.0f, 1.0f) });
+        }
+
+        BoneKeyframes& hand = animation.boneKeyframes["Hand"];
+        hand.rotationKeys.push_back({ 0.0f, CreateQuaternionYawPitchRoll(0.0f, 1.0f, 0.0f) });
+        hand.rotationKeys.push_back({ 5.0f, CreateQuaternionYawPitchRoll(0.0f, 2.0f, 0.0f) });
+
+        animation.boneKeyframes["NotInSkeleton"].positionKeys.push_back({ 0.0f, float3::One });
+        return animation;
+    }
+
+    const std::unordered_map<std::string, int32> BONE_NAME_TO_INDEX = { { "Hips", 0 }, { "Spine", 1 }, { "Hand", 2 } };
+}
+
+TEST(sge_animation_clip, ChannelsAreIndexedByBone)
+{
+    AnimationClip clip;
+    clip.Initialize(MakeAnimation(), BONE_NAME_TO_INDEX, 3);
+
+    EXPECT_EQ(clip.GetName(), "Walk");
+    EXPECT_FLOAT_EQ(clip.GetDuration(), 10.0f);
+    EXPECT_FLOAT_EQ(clip.GetTicksPerSecond(), 30.0f);
+    ASSERT_EQ(clip.GetChannelCount(), 3);
+
+    EXPECT_TRUE(clip.GetChannel(0).IsAnimated());
+    EXPECT_FALSE(clip.GetChannel(1).IsAnimated());
+    EXPECT_TRUE(clip.GetChannel(2).IsAnimated());
+
+    EXPECT_EQ(clip.GetChannel(0).positionCount, 11u);
+    EXPECT_EQ(clip.GetChannel(2).positionCount, 0u);
+    EXPECT_EQ(clip.GetChannel(2).rotationCount, 2u);
+    EXPECT_EQ(clip.GetChannel(2).rotationOffset, 11u);
+
+    // Keys of bones that are not part of the skeleton are dropped while baking.
+    EXPECT_EQ(clip.GetKeyCount(), 11u * 3u + 2u);
+}
+
+TEST(sge_animation_clip, SampleMatchesImportedKeyframes)
+{
+    Animation animation = MakeAnimation();
+    AnimationClip clip;
+    clip.Initialize(animation, BONE_NAME_TO_INDEX, 3);
+
+    const BoneKeyframes& hips = animation.boneKeyframes["Hips"];
+    KeyframeCursor cursor;
+
+    for (float time = 0.0f; time <= 10.0f; time += 0.3f)
+    {
+        BonePose pose = clip.SampleBone(0, time, cursor);
+        EXPECT_EQ(pose.position, SamplePosition(hips.positionKeys, time));
+        EXPECT_EQ(pose.rotation, SampleRotation(hips.rotationKeys, time));
+        EXPECT_EQ(pose.scale, SampleScale(hips.scaleKeys, time));
+
+        BonePose seekPose = clip.SampleBone(0, time);
+        EXPECT_EQ(seekPose.position, pose.position);
+        EXPECT_EQ(seekPose.rotation, pose.rotation);
+    }
+}
+
+TEST(sge_animation_clip, MissingChannelsSampleToIdentity)
+{
+    AnimationClip clip;
+    clip.Initialize(MakeAnimation(), BONE_NAME_TO_INDEX, 3);
+
+    BonePose spine = clip.SampleBone(1, 2.0f);
+    EXPECT_EQ(spine.position, float3::Zero);
+    EXPECT_EQ(spine.rotation, float4::Identity);
+    EXPECT_EQ(spine.scale, float3::One);
+
+    BonePose hand = clip.SampleBone(2, 2.5f);
+    EXPECT_EQ(hand.position, float3::Zero);
+    EXPECT_EQ(hand.scale, float3::One);
+    EXPECT_NE(hand.rotation, float4::Identity);
+}
@@ -0,0 +1,251 @@
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "core/sge_job_system.h"
+#include "data/sge_animation_blender.h"
+using namespace SGE;
+
+// 65-bone humanoid-shaped hierarchy (spine chain with limbs and fingers), as in
+// samples/resources/anim/human.gltf, evaluated the recursive way and with AnimationPose.
+namespace
+{
+    struct SkeletonFixture
+    {
+        std::vector<int32> parents;
+        std::vector<std::vector<int32>> children;
+        float4x4_array offsets;
+        AnimationClip clip;
+        BoneHierarchy hierarchy;
+
+        SkeletonFixture()
+        {
+            auto addBone = [&](int32 parent)
+            {
+                parents.push_back(parent);
+                return static_cast<int32>(parents.size()) - 1;
+            };
+
+            int32 spine = addBone(-1);
+            for (int i = 0; i < 4; ++i) spine = addBone(spine);
+            int32 head = addBone(addBone(spine));
+            addBone(head);
+
+            for (int side = 0; side < 2; ++side)
+            {
+                int32 arm = addBone(addBone(addBone(spine)));
+                int32 hand = addBone(arm);
+                for (int finger = 0; finger < 5; ++finger)
+                {
+                    addBone(addBone(addBone(hand)));
+                }
+
+                int32 leg = addBone(addBone(0));
+                addBone(addBone(leg));
+            }
+
+            while (parents.size() < 65)
+            {
+                addBone(head);
+            }
+
+            children.resize(parents.size());
+            for (size_t bone = 0; bone < parents.size(); ++bone)
+            {
+                if (parents[bone] != -1)
+                {
+                    children[parents[bone]].push_back(static_cast<int32>(bone));
+                }
+            }
+
+            std::mt19937 generator(9);
+            std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+            Animation animation;
+            animation.name = "Crowd";
+            animation.duration = 100.0f;
+            animation.ticksPerSecond = 30.0f;
+
+            std::unordered_map<std::string, int32> boneNameToIndex;
+            for (size_t bone = 0; bone < parents.size(); ++bone)
+            {
+                std::string boneName = "Bone" + std::to_string(bone);
+                boneNameToIndex[boneName] = static_cast<int32>(bone);
+                offsets.push_back(CreateTranslationMatrix(float3(distribution(generator), distribution(generator), distribution(generator))));
+
+                BoneKeyframes& keyframes = animation.boneKeyframes[boneName];
+                for (int key = 0; key <= 100; ++key)
+                {
+                    float time = static_cast<float>(key);
+                    keyframes.positionKeys.push_back({ time, float3(distribution(generator), distribution(generator), distribution(generator)) });
+                    keyframes.rotationKeys.push_back({ time, float4(distribution(generator), distribution(generator), distribution(generator), distribution(generator)).normalized() });
+                    keyframes.scaleKeys.push_back({ time, float3::One });
+                }
+            }
+
+            clip.Initialize(animation, boneNameToIndex, static_cast<int32>(parents.size()));
+            hierarchy.Initialize(parents, offsets);
+        }
+
+        void EvaluateRecursive(int32 bone, const float4x4& parentTransform, float time, std::vector<KeyframeCursor>& cursors, float4x4_array& palette) const
+        {
+            BonePose pose = clip.SampleBone(bone, time, cursors[bone]);
+            float4x4 local = CreateTranslationMatrix(pose.position) * CreateRotationMatrixFromQuaternion(pose.rotation) * CreateScaleMatrix(pose.scale);
+            float4x4 global = parentTransform * local;
+            palette[bone] = global * offsets[bone];
+
+            for (int32 child : children[bone])
+            {
+                EvaluateRecursive(child, global, time, cursors, palette);
+            }
+        }
+    };
+
+    float AdvanceTime(float time)
+    {
+        time += 0.5f;
+        return time > 100.0f ? time - 100.0f : time;
+    }
+}
+
+static void BM_EvaluatePose_Recursive(benchmark::State& state)
+{
+    SkeletonFixture fixture;
+    std::vector<KeyframeCursor> cursors(fixture.parents.size());
+    float4x4_array palette(fixture.parents.size());
+    float time = 0.0f;
+
+    for (auto _ : state)
+    {
+        fixture.EvaluateRecursive(0, float4x4::Identity, time, cursors, palette);
+        benchmark::DoNotOptimize(palette.data());
+        benchmark::ClobberMemory();
+        time = AdvanceTime(time);
+    }
+    state.SetItemsProcessed(state.iterations() * fixture.parents.size());
+}
+BENCHMARK(BM_EvaluatePose_Recursive)->Unit(benchmark::kMicrosecond);
+
+static void BM_EvaluatePose_Flattened(benchmark::State& state)
+{
+    SkeletonFixture fixture;
+    std::vector<KeyframeCursor> cursors;
+    AnimationPose pose;
+    pose.Initialize(fixture.hierarchy.GetBoneCount());
+    float time = 0.0f;
+
+    for (auto _ : state)
+    {
+        pose.SampleClip(fixture.clip, time, cursors);
+        pose.ComputeModelPose(fixture.hierarchy);
+        pose.ComputeSkinningPalette(fixture.hierarchy);
+        benchmark::DoNotOptimize(pose.GetSkinningPalette().data());
+        benchmark::ClobberMemory();
+        time = AdvanceTime(time);
+    }
+    state.SetItemsProcessed(state.iterations() * fixture.parents.size());
+    state.SetLabel(GetSimdInstructionSetName());
+}
+BENCHMARK(BM_EvaluatePose_Flattened)->Unit(benchmark::kMicrosecond);
+
+// Two full-body override layers against the same layers split into lower/upper body masks,
+// where every bone is sampled by exactly one layer.
+static void BM_BlendLayers(benchmark::State& state)
+{
+    const bool masked = state.range(0) != 0;
+    SkeletonFixture fixture;
+
+    std::vector<float> lowerWeights(fixture.parents.size(), 0.0f);
+    std::vector<float> upperWeights(fixture.parents.size(), 1.0f);
+    for (size_t bone = 0; bone < fixture.parents.size() / 2; ++bone)
+    {
+        lowerWeights[bone] = 1.0f;
+        upperWeights[bone] = 0.0f;
+    }
+
+    BoneMask lowerBody, upperBody;
+    lowerBody.Initialize(lowerWeights);
+    upperBody.Initialize(upperWeights);
+
+    std::vector<KeyframeCursor> lowerCursors, upperCursors;
+    AnimationBlendLayer layers[2];
+    layers[0] = { &fixture.clip, &lowerCursors, 0.0f, 1.0f, AnimationBlendMode::Override, masked ? &lowerBody : nullptr };
+    layers[1] = { &fixture.clip, &upperCursors, 0.0f, 1.0f, AnimationBlendMode::Override, masked ? &upperBody : nullptr };
+
+    AnimationBlender blender;
+    AnimationPose pose;
+    pose.Initialize(fixture.hierarchy.GetBoneCount());
+    float time = 0.0f;
+
+    for (auto _ : state)
+    {
+        layers[0].time = time;
+        layers[1].time = AdvanceTime(time);
+        blender.Evaluate(fixture.hierarchy, layers, pose);
+        pose.ComputeModelPose(fixture.hierarchy);
+        pose.ComputeSkinningPalette(fixture.hierarchy);
+        benchmark::DoNotOptimize(pose.GetSkinningPalette().data());
+        benchmark::ClobberMemory();
+        time = AdvanceTime(time);
+    }
+    state.SetItemsProcessed(state.iterations() * fixture.parents.size());
+    state.SetLabel(masked ? "masked" : "full");
+}
+BENCHMARK(BM_BlendLayers)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// A crowd of instances sharing one skeleton and clip, each with its own cursors and pose, as
+// Scene::UpdateModels evaluates them. Argument: worker threads, 0 runs the serial loop.
+static void BM_AnimateInstances(benchmark::State& state)
+{
+    constexpr size_t INSTANCE_COUNT = 64;
+    const uint32 workerCount = static_cast<uint32>(state.range(0));
+    SkeletonFixture fixture;
+
+    struct Instance
+    {
+        std::vector<KeyframeCursor> cursors;
+        AnimationPose pose;
+        float time = 0.0f;
+    };
+
+    std::vector<Instance> instances(INSTANCE_COUNT);
+    for (size_t i = 0; i < INSTANCE_COUNT; ++i)
+    {
+        instances[i].pose.Initialize(fixture.hierarchy.GetBoneCount());
+        instances[i].time = static_cast<float>(i);
+    }
+
+    auto animate = [&](size_t begin, size_t end)
+    {
+        AnimationBlender blender;
+        for (size_t i = begin; i < end; ++i)
+        {
+            Instance& instance = instances[i];
+            AnimationBlendLayer layer = { &fixture.clip, &instance.cursors, instance.time, 1.0f, AnimationBlendMode::Override, nullptr };
+            blender.Evaluate(fixture.hierarchy, Span<const AnimationBlendLayer>(&layer, 1), instance.pose);
+            instance.pose.ComputeModelPose(fixture.hierarchy);
+            instance.pose.ComputeSkinningPalette(fixture.hierarchy);
+            instance.time = AdvanceTime(instance.time);
+        }
+    };
+
+    if (workerCount > 0)
+    {
+        JobSystem::Get().Initialize(workerCount);
+    }
+
+    for (auto _ : state)
+    {
+        if (workerCount == 0)
+        {
+            animate(0, INSTANCE_COUNT);
+        }
+        else
+        {
+            JobSystem::Get().ParallelFor(INSTANCE_COUNT, animate);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * INSTANCE_COUNT);
+    JobSystem::Get().Shutdown();
+}
+BENCHMARK(BM_AnimateInstances)->Arg(0)->Arg(1)->Arg(3)->Arg(7)->Unit(benchmark::kMicrosecond)->UseRealTime();
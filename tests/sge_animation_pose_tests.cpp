@@ -0,0 +1,156 @@
+#include <random>
+#include <gtest/gtest.h>
+#include "data/sge_animation_pose.h"
+using namespace SGE;
+
+namespace
+{
+    struct PoseFixture
+    {
+        std::vector<int32> parents;
+        float4x4_array offsets;
+        AnimationClip clip;
+        Animation animation;
+
+        explicit PoseFixture(std::vector<int32> boneParents) : parents(std::move(boneParents))
+        {
+            std::mt19937 generator(3);
+            std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+            auto randomFloat3 = [&]() { return float3(distribution(generator), distribution(generator), distribution(generator)); };
+
+            animation.name = "Test";
+            animation.duration = 4.0f;
+            animation.ticksPerSecond = 25.0f;
+
+            std::unordered_map<std::string, int32> boneNameToIndex;
+            for (size_t bone = 0; bone < parents.size(); ++bone)
+            {
+                std::string boneName = "Bone" + std::to_string(bone);
+                boneNameToIndex[boneName] = static_cast<int32>(bone);
+                offsets.push_back(CreateTranslationMatrix(randomFloat3()));
+
+                BoneKeyframes& keyframes = animation.boneKeyframes[boneName];
+                for (int key = 0; key <= 4; ++key)
+                {
+                    float time = static_cast<float>(key);
+                    keyframes.positionKeys.push_back({ time, randomFloat3() });
+                    keyframes.rotationKeys.push_back({ time, float4(distribution(generator), distribution(generator), distribution(generator), distribution(generator)).normalized() });
+                    keyframes.scaleKeys.push_back({ time, float3::One + randomFloat3() * 0.25f });
+                }
+            }
+
+            clip.Initialize(animation, boneNameToIndex, static_cast<int32>(parents.size()));
+        }
+
+        // The recursive evaluation AnimatedModelInstance used before the flattened hierarchy.
+        void EvaluateRecursive(int32 bone, const float4x4& parentTransform, float time, float4x4_array& palette) const
+        {
+            BonePose pose = clip.SampleBone(bone, time);
+            float4x4 local = CreateTranslationMatrix(pose.position) * CreateRotationMatrixFromQuaternion(pose.rotation) * CreateScaleMatrix(pose.scale);
+            float4x4 global = parentTransform * local;
+            palette[bone] = global * offsets[bone];
+
+            for (int32 child = 0; child < static_cast<int32>(parents.size()); ++child)
+            {
+                if (parents[child] == bone)
+                {
+                    EvaluateRecursive(child, global, time, palette);
+                }
+            }
+        }
+    };
+
+    void ExpectMatrixNear(const float4x4& actual, const float4x4& expected)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            EXPECT_NEAR(actual.m[i], expected.m[i], 1e-4f) << "Element at index " << i << " is incorrect!";
+        }
+    }
+}
+
+TEST(sge_animation_pose, EvaluationOrderVisitsParentsFirst)
+{
+    // Children deliberately use lower indices than their parents.
+    BoneHierarchy hierarchy;
+    hierarchy.Initialize({ 2, 0, -1, 2, 3, -1 }, {});
+
+    ASSERT_EQ(hierarchy.evaluationOrder.size(), 6u);
+    EXPECT_EQ(hierarchy.offsetMatrices.size(), 6u);
+
+    std::vector<int32> position(6);
+    for (size_t i = 0; i < hierarchy.evaluationOrder.size(); ++i)
+    {
+        position[hierarchy.evaluationOrder[i]] = static_cast<int32>(i);
+    }
+
+    for (int32 bone = 0; bone < 6; ++bone)
+    {
+        int32 parent = hierarchy.parentIndices[bone];
+        if (parent != -1)
+        {
+            EXPECT_LT(position[parent], position[bone]) << "bone " << bone;
+        }
+    }
+
+    // Pre-order keeps subtrees contiguous: 2, 0, 1, 3, 4 then the second root.
+    EXPECT_EQ(hierarchy.evaluationOrder, (std::vector<int32>{ 2, 0, 1, 3, 4, 5 }));
+}
+
+TEST(sge_animation_pose, InvalidParentsBecomeRoots)
+{
+    BoneHierarchy hierarchy;
+    hierarchy.Initialize({ 1, 0, 7 }, {});
+
+    EXPECT_EQ(hierarchy.parentIndices[2], -1);
+    EXPECT_EQ(hierarchy.evaluationOrder.size(), 3u);
+}
+
+TEST(sge_animation_pose, MatchesRecursiveEvaluation)
+{
+    PoseFixture fixture({ 3, 0, 1, -1, 3, 4, 4, 1 });
+
+    BoneHierarchy hierarchy;
+    hierarchy.Initialize(fixture.parents, fixture.offsets);
+
+    AnimationPose pose;
+    pose.Initialize(hierarchy.GetBoneCount());
+    std::vector<KeyframeCursor> cursors;
+
+    for (float time = 0.0f; time <= 4.0f; time += 0.35f)
+    {
+        pose.SampleClip(fixture.clip, time, cursors);
+        pose.ComputeModelPose(hierarchy);
+        pose.ComputeSkinningPalette(hierarchy);
+
+        float4x4_array expected(fixture.parents.size());
+        fixture.EvaluateRecursive(3, float4x4::Identity, time, expected);
+
+        for (size_t bone = 0; bone < expected.size(); ++bone)
+        {
+            ExpectMatrixNear(pose.GetSkinningPalette()[bone], expected[bone]);
+        }
+    }
+}
+
+TEST(sge_animation_pose, SetIdentityResetsPalette)
+{
+    PoseFixture fixture({ -1, 0, 1 });
+
+    BoneHierarchy hierarchy;
+    hierarchy.Initialize(fixture.parents, fixture.offsets);
+
+    AnimationPose pose;
+    pose.Initialize(hierarchy.GetBoneCount());
+    std::vector<KeyframeCursor> cursors;
+    pose.SampleClip(fixture.clip, 1.5f, cursors);
+    pose.ComputeModelPose(hierarchy);
+    pose.ComputeSkinningPalette(hierarchy);
+
+    pose.SetIdentity();
+    for (int32 bone = 0; bone < pose.GetBoneCount(); ++bone)
+    {
+        EXPECT_EQ(pose.GetSkinningPalette()[bone], float4x4::Identity);
+        EXPECT_EQ(pose.GetBonePose(bone).rotation, float4::Identity);
+    }
+}
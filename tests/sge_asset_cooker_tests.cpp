@@ -0,0 +1,304 @@
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include "data/sge_asset_cooker.h"
+#include "data/sge_mesh_cache.h"
+#include "data/sge_model_importer.h"
+#include "data/sge_texture_cooker.h"
+using namespace SGE;
+
+namespace
+{
+    class ScopedDirectory
+    {
+    public:
+        explicit ScopedDirectory(const std::string& name)
+            : path((std::filesystem::temp_directory_path() / ("sge_asset_cooker_" + name)).string())
+        {
+            std::error_code error;
+            std::filesystem::remove_all(path, error);
+            std::filesystem::create_directories(path);
+        }
+        ~ScopedDirectory() { std::error_code error; std::filesystem::remove_all(path, error); }
+
+        std::string GetPath(const std::string& file) const { return (std::filesystem::path(path) / file).generic_string(); }
+
+        std::string path;
+    };
+
+    // Uncompressed 32 bit TGA, top-left origin, pixels given as RGBA.
+    void WriteTga(const std::string& path, uint32 width, uint32 height, const std::vector<uint8>& rgba)
+    {
+        uint8 header[18] = {};
+        header[2] = 2;
+        header[12] = static_cast<uint8>(width & 0xFF);
+        header[13] = static_cast<uint8>(width >> 8);
+        header[14] = static_cast<uint8>(height & 0xFF);
+        header[15] = static_cast<uint8>(height >> 8);
+        header[16] = 32;
+        header[17] = 0x28;
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+        for (size_t i = 0; i < rgba.size(); i += 4)
+        {
+            const uint8 bgra[4] = { rgba[i + 2], rgba[i + 1], rgba[i], rgba[i + 3] };
+            file.write(reinterpret_cast<const char*>(bgra), sizeof(bgra));
+        }
+    }
+
+    void WriteTriangleObj(const std::string& path)
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << "v 0 0 0\nv 1 0 0\nv 0 1 0\nvt 0 0\nvt 1 0\nvt 0 1\nvn 0 0 1\nf 1/1/1 2/2/1 3/3/1\n";
+    }
+
+    TextureImage MakeImage(uint32 width, uint32 height, uint8 value)
+    {
+        TextureImage image;
+        image.width = width;
+        image.height = height;
+        image.pixels.assign(static_cast<size_t>(width) * height * 4, value);
+        return image;
+    }
+
+    const CookEntry& GetOnlyEntry(const AssetCooker& cooker)
+    {
+        EXPECT_EQ(cooker.GetEntries().size(), 1u);
+        return cooker.GetEntries().front();
+    }
+}
+
+TEST(sge_texture_cooker, BuildsBoxFilteredMipChain)
+{
+    // 4x2 with the left half black and the right half white.
+    TextureImage image = MakeImage(4, 2, 0);
+    for (uint32 y = 0; y < 2; ++y)
+    {
+        for (uint32 x = 2; x < 4; ++x)
+        {
+            std::memset(&image.pixels[(y * 4 + x) * 4], 255, 4);
+        }
+    }
+
+    const std::vector<TextureImage> mips = TextureCooker::BuildMipChain(image);
+    ASSERT_EQ(mips.size(), 3u);
+    EXPECT_EQ(mips[1].width, 2u);
+    EXPECT_EQ(mips[1].height, 1u);
+    EXPECT_EQ(mips[2].width, 1u);
+    EXPECT_EQ(mips[2].height, 1u);
+
+    EXPECT_EQ(mips[1].pixels[0], 0);
+    EXPECT_EQ(mips[1].pixels[4], 255);
+    EXPECT_EQ(mips[2].pixels[0], 128);
+}
+
+TEST(sge_texture_cooker, MipChainOfNonPowerOfTwoEndsAtOnePixel)
+{
+    const std::vector<TextureImage> mips = TextureCooker::BuildMipChain(MakeImage(5, 3, 77));
+    ASSERT_EQ(mips.size(), 3u); // 5x3, 2x1, 1x1
+    for (const TextureImage& mip : mips)
+    {
+        ASSERT_EQ(mip.pixels.size(), static_cast<size_t>(mip.width) * mip.height * 4);
+        EXPECT_EQ(mip.pixels.front(), 77);
+    }
+}
+
+TEST(sge_texture_cooker, WritesDdsWithEveryMip)
+{
+    ScopedDirectory directory("dds");
+    const std::string path = directory.GetPath("image.dds");
+    const std::vector<TextureImage> mips = TextureCooker::BuildMipChain(MakeImage(8, 4, 10));
+    ASSERT_TRUE(TextureCooker::WriteDDS(path, mips, CookedTextureFormat::RGBA8));
+
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    // Magic, 124 byte header, 20 byte DX10 header, then 8x4 + 4x2 + 2x1 + 1x1 texels.
+    ASSERT_EQ(bytes.size(), 4u + 124u + 20u + (32u + 8u + 2u + 1u) * 4u);
+
+    uint32 values[5] = {};
+    std::memcpy(&values[0], &bytes[0], 4);   // magic
+    std::memcpy(&values[1], &bytes[12], 4);  // height
+    std::memcpy(&values[2], &bytes[16], 4);  // width
+    std::memcpy(&values[3], &bytes[28], 4);  // mip count
+    std::memcpy(&values[4], &bytes[128], 4); // DXGI format
+    EXPECT_EQ(values[0], 0x20534444u);
+    EXPECT_EQ(values[1], 4u);
+    EXPECT_EQ(values[2], 8u);
+    EXPECT_EQ(values[3], 4u);
+    EXPECT_EQ(values[4], static_cast<uint32>(CookedTextureFormat::RGBA8));
+}
+
+TEST(sge_texture_cooker, ReadsMipRangeOfCookedDds)
+{
+    ScopedDirectory directory("dds_mips");
+    const std::string path = directory.GetPath("image.dds");
+    std::vector<TextureImage> mips = TextureCooker::BuildMipChain(MakeImage(16, 8, 0));
+    for (size_t i = 0; i < mips.size(); ++i)
+    {
+        std::fill(mips[i].pixels.begin(), mips[i].pixels.end(), static_cast<uint8>(i * 10));
+    }
+    ASSERT_TRUE(TextureCooker::WriteDDS(path, mips, CookedTextureFormat::RGBA8));
+
+    CookedTextureInfo info;
+    ASSERT_TRUE(TextureCooker::ReadDDSInfo(path, info));
+    EXPECT_EQ(info.width, 16u);
+    EXPECT_EQ(info.height, 8u);
+    EXPECT_EQ(info.mipCount, 5u);
+    EXPECT_EQ(GetTextureMipSize(info.format, 4, 2), 32u);
+
+    std::vector<TextureImage> tail;
+    ASSERT_TRUE(TextureCooker::ReadDDSMips(path, 2, tail));
+    ASSERT_EQ(tail.size(), 3u);
+    EXPECT_EQ(tail[0].width, 4u);
+    EXPECT_EQ(tail[0].height, 2u);
+    EXPECT_EQ(tail[0].pixels, mips[2].pixels);
+    EXPECT_EQ(tail[2].pixels, mips[4].pixels);
+    EXPECT_FALSE(TextureCooker::ReadDDSMips(path, 5, tail));
+
+    // Cut short, or not written by the cooker at all.
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_FALSE(TextureCooker::ReadDDSMips(path, 0, tail));
+    WriteTga(directory.GetPath("image.tga"), 1, 1, { 1, 2, 3, 4 });
+    EXPECT_FALSE(TextureCooker::ReadDDSInfo(directory.GetPath("image.tga"), info));
+}
+
+TEST(sge_texture_cooker, CooksEachUsageToItsBlockFormat)
+{
+    ScopedDirectory directory("usage");
+    const std::string source = directory.GetPath("normal.tga");
+    WriteTga(source, 16, 8, std::vector<uint8>(16 * 8 * 4, 128));
+
+    const std::string path = TextureCooker::GetCookedPath(source);
+    ASSERT_TRUE(TextureCooker::Cook(source, path, TextureUsage::Normal));
+
+    CookedTextureInfo info;
+    ASSERT_TRUE(TextureCooker::ReadDDSInfo(path, info));
+    EXPECT_EQ(info.format, CookedTextureFormat::BC5);
+    EXPECT_EQ(info.mipCount, 5u);
+    EXPECT_EQ(std::filesystem::file_size(path), 148u + 128u + 32u + 16u + 16u + 16u);
+
+    // Mips below a block still take a whole one.
+    std::vector<TextureImage> mips;
+    ASSERT_TRUE(TextureCooker::ReadDDSMips(path, 3, mips));
+    ASSERT_EQ(mips.size(), 2u);
+    EXPECT_EQ(mips[0].width, 2u);
+    EXPECT_EQ(mips[0].pixels.size(), 16u);
+
+    ASSERT_TRUE(TextureCooker::Cook(source, path, TextureUsage::Mask));
+    ASSERT_TRUE(TextureCooker::ReadDDSInfo(path, info));
+    EXPECT_EQ(info.format, CookedTextureFormat::BC4);
+
+    // Sizes that aren't powers of two stay uncompressed.
+    WriteTga(source, 12, 8, std::vector<uint8>(12 * 8 * 4, 128));
+    ASSERT_TRUE(TextureCooker::Cook(source, path, TextureUsage::Color));
+    ASSERT_TRUE(TextureCooker::ReadDDSInfo(path, info));
+    EXPECT_EQ(info.format, CookedTextureFormat::RGBA8);
+
+    EXPECT_EQ(TextureCooker::GetUsageFromName("bricks/Normal.png"), TextureUsage::Normal);
+    EXPECT_EQ(TextureCooker::GetUsageFromName("bricks/roughness.png"), TextureUsage::Mask);
+    EXPECT_EQ(TextureCooker::GetUsageFromName("bricks/ao.png"), TextureUsage::Mask);
+    EXPECT_EQ(TextureCooker::GetUsageFromName("chaos/albedo.png"), TextureUsage::Color);
+    EXPECT_EQ(TextureCooker::GetUsageFromName("bricks/tao_diffuse.png"), TextureUsage::Color);
+}
+
+TEST(sge_asset_cooker, SkipsUnchangedTexturesAndRecooksChangedOnes)
+{
+    ScopedDirectory directory("texture");
+    const std::string source = directory.GetPath("albedo.tga");
+    const std::string manifest = directory.GetPath("manifest.json");
+    WriteTga(source, 2, 2, std::vector<uint8>(16, 200));
+
+    {
+        AssetCooker cooker;
+        cooker.Initialize(manifest);
+        ASSERT_TRUE(cooker.Add(AssetKind::Texture, source));
+        EXPECT_FALSE(cooker.Add(AssetKind::Texture, source));
+
+        const CookReport report = cooker.Cook();
+        EXPECT_EQ(report.cooked, 1u);
+        EXPECT_TRUE(std::filesystem::exists(TextureCooker::GetCookedPath(source)));
+        EXPECT_EQ(TextureCooker::ResolveRuntimePath(source), TextureCooker::GetCookedPath(source));
+        ASSERT_TRUE(cooker.SaveManifest());
+    }
+
+    {
+        AssetCooker cooker;
+        cooker.Initialize(manifest);
+        cooker.Add(AssetKind::Texture, source);
+        EXPECT_EQ(cooker.Cook().upToDate, 1u);
+        EXPECT_EQ(GetOnlyEntry(cooker).status, CookStatus::UpToDate);
+    }
+
+    // The same source in another slot is cooked to another format.
+    {
+        AssetCooker cooker;
+        cooker.Initialize(manifest);
+        cooker.Add(AssetKind::Texture, source, TextureUsage::Mask);
+        EXPECT_EQ(cooker.Cook().cooked, 1u);
+        ASSERT_TRUE(cooker.SaveManifest());
+    }
+
+    WriteTga(source, 2, 2, std::vector<uint8>(16, 100));
+    {
+        AssetCooker cooker;
+        cooker.Initialize(manifest);
+        cooker.Add(AssetKind::Texture, source, TextureUsage::Mask);
+        EXPECT_EQ(cooker.Cook().cooked, 1u);
+    }
+}
+
+TEST(sge_asset_cooker, ReportsMissingAndUnreadableSources)
+{
+    ScopedDirectory directory("missing");
+    const std::string broken = directory.GetPath("broken.png");
+    std::ofstream(broken) << "not a png";
+
+    AssetCooker cooker;
+    cooker.Initialize(directory.GetPath("manifest.json"));
+    EXPECT_FALSE(cooker.Add(AssetKind::Texture, directory.GetPath("already_cooked.dds")));
+    EXPECT_FALSE(cooker.Add(AssetKind::Texture, ""));
+    cooker.Add(AssetKind::Texture, directory.GetPath("missing.png"));
+    cooker.Add(AssetKind::Texture, broken);
+
+    const CookReport report = cooker.Cook();
+    EXPECT_EQ(report.missing, 1u);
+    EXPECT_EQ(report.failed, 1u);
+    EXPECT_EQ(report.cooked, 0u);
+}
+
+TEST(sge_asset_cooker, CookedModelLoadsWithRuntimeKeyAfterSourceIsTouched)
+{
+    ScopedDirectory directory("model");
+    const std::string source = directory.GetPath("triangle.obj");
+    const std::string manifest = directory.GetPath("manifest.json");
+    WriteTriangleObj(source);
+
+    {
+        AssetCooker cooker;
+        cooker.Initialize(manifest);
+        cooker.Add(AssetKind::Model, source);
+        ASSERT_EQ(cooker.Cook().cooked, 1u);
+        ASSERT_TRUE(cooker.SaveManifest());
+    }
+
+    const std::string cachePath = MeshCache::GetCachePath(source);
+    std::unique_ptr<ModelAsset> asset = MeshCache::LoadModel(cachePath, MeshCache::ComputeSourceKey(source, ModelImporter::IMPORT_FLAGS));
+    ASSERT_NE(asset, nullptr);
+    EXPECT_EQ(asset->GetIndices().size(), 3u);
+    asset.reset();
+
+    // A new time with the same content is restamped, not reimported.
+    std::filesystem::last_write_time(source, std::filesystem::last_write_time(source) + std::chrono::hours(1));
+    {
+        AssetCooker cooker;
+        cooker.Initialize(manifest);
+        cooker.Add(AssetKind::Model, source);
+        EXPECT_EQ(cooker.Cook().upToDate, 1u);
+    }
+
+    EXPECT_NE(MeshCache::LoadModel(cachePath, MeshCache::ComputeSourceKey(source, ModelImporter::IMPORT_FLAGS)), nullptr);
+}
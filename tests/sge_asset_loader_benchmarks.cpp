@@ -0,0 +1,161 @@
+#include <cmath>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "data/sge_asset_loader.h"
+#include "core/sge_math.h"
+using namespace SGE;
+
+// Decode stage of the scene loader without a device: the uploads go to NullAssetUploadSink.
+// The decoder stands in for Assimp and DirectXTex with comparable CPU work per asset, a grid
+// mesh with normals for models and a box filtered mip chain for textures.
+namespace
+{
+    constexpr uint32 ASSET_COUNT = 64;
+    constexpr uint32 GRID_SIZE = 96;
+    constexpr uint32 TEXTURE_SIZE = 256;
+
+    class SyntheticMesh : public DecodedAsset
+    {
+    public:
+        std::vector<float3> positions;
+        std::vector<float3> normals;
+        std::vector<uint32> indices;
+    };
+
+    class SyntheticImage : public DecodedAsset
+    {
+    public:
+        std::vector<std::vector<uint32>> mips;
+    };
+
+    std::unique_ptr<DecodedAsset> DecodeMesh(uint32 seed)
+    {
+        auto mesh = std::make_unique<SyntheticMesh>();
+        mesh->positions.reserve(GRID_SIZE * GRID_SIZE);
+        for (uint32 y = 0; y < GRID_SIZE; ++y)
+        {
+            for (uint32 x = 0; x < GRID_SIZE; ++x)
+            {
+                float height = std::sin(static_cast<float>(x + seed) * 0.1f) * std::cos(static_cast<float>(y) * 0.1f);
+                mesh->positions.emplace_back(static_cast<float>(x), height, static_cast<float>(y));
+            }
+        }
+
+        for (uint32 y = 0; y + 1 < GRID_SIZE; ++y)
+        {
+            for (uint32 x = 0; x + 1 < GRID_SIZE; ++x)
+            {
+                uint32 i = y * GRID_SIZE + x;
+                mesh->indices.insert(mesh->indices.end(), { i, i + GRID_SIZE, i + 1, i + 1, i + GRID_SIZE, i + GRID_SIZE + 1 });
+            }
+        }
+
+        mesh->normals.assign(mesh->positions.size(), float3(0.0f, 0.0f, 0.0f));
+        for (size_t i = 0; i < mesh->indices.size(); i += 3)
+        {
+            const float3& a = mesh->positions[mesh->indices[i]];
+            const float3& b = mesh->positions[mesh->indices[i + 1]];
+            const float3& c = mesh->positions[mesh->indices[i + 2]];
+            float3 normal = cross(b - a, c - a);
+            for (size_t k = 0; k < 3; ++k)
+            {
+                mesh->normals[mesh->indices[i + k]] += normal;
+            }
+        }
+        for (float3& normal : mesh->normals)
+        {
+            normal = normal.normalized();
+        }
+        return mesh;
+    }
+
+    std::unique_ptr<DecodedAsset> DecodeImage(uint32 seed)
+    {
+        auto image = std::make_unique<SyntheticImage>();
+        std::vector<uint32> level(TEXTURE_SIZE * TEXTURE_SIZE);
+        uint32 state = seed * 747796405u + 1u;
+        for (uint32& texel : level)
+        {
+            state = state * 1664525u + 1013904223u;
+            texel = state;
+        }
+
+        uint32 size = TEXTURE_SIZE;
+        image->mips.push_back(std::move(level));
+        while (size > 1)
+        {
+            const std::vector<uint32>& source = image->mips.back();
+            uint32 half = size / 2;
+            std::vector<uint32> next(half * half);
+            for (uint32 y = 0; y < half; ++y)
+            {
+                for (uint32 x = 0; x < half; ++x)
+                {
+                    uint32 result = 0;
+                    for (uint32 channel = 0; channel < 32; channel += 8)
+                    {
+                        uint32 sum = ((source[(2 * y) * size + 2 * x] >> channel) & 0xFF) +
+                                     ((source[(2 * y) * size + 2 * x + 1] >> channel) & 0xFF) +
+                                     ((source[(2 * y + 1) * size + 2 * x] >> channel) & 0xFF) +
+                                     ((source[(2 * y + 1) * size + 2 * x + 1] >> channel) & 0xFF);
+                        result |= ((sum + 2) / 4) << channel;
+                    }
+                    next[y * half + x] = result;
+                }
+            }
+            image->mips.push_back(std::move(next));
+            size = half;
+        }
+        return image;
+    }
+
+    class SyntheticDecoder : public AssetDecoder
+    {
+    public:
+        std::unique_ptr<DecodedAsset> Decode(AssetKind kind, const std::string& path) override
+        {
+            uint32 seed = static_cast<uint32>(std::hash<std::string>()(path));
+            return kind == AssetKind::Texture ? DecodeImage(seed) : DecodeMesh(seed);
+        }
+    };
+
+    std::vector<std::string> MakePaths(const char* prefix)
+    {
+        std::vector<std::string> paths;
+        for (uint32 i = 0; i < ASSET_COUNT; ++i)
+        {
+            paths.push_back(prefix + std::to_string(i));
+        }
+        return paths;
+    }
+}
+
+// Argument is the thread count, main thread included. 1 decodes every asset on the main thread,
+// which is how the scene loaded before.
+static void BM_AssetLoader_DecodeScene(benchmark::State& state)
+{
+    JobSystem::Get().Initialize(static_cast<uint32>(state.range(0)) - 1);
+
+    SyntheticDecoder decoder;
+    NullAssetUploadSink sink;
+    const std::vector<std::string> modelPaths = MakePaths("model_");
+    const std::vector<std::string> texturePaths = MakePaths("texture_");
+
+    for (auto _ : state)
+    {
+        AssetLoader loader;
+        loader.Initialize(&decoder, &sink);
+        for (uint32 i = 0; i < ASSET_COUNT; ++i)
+        {
+            // Every texture referenced twice, as materials share maps.
+            loader.Request(AssetKind::Model, modelPaths[i]);
+            loader.Request(AssetKind::Texture, texturePaths[i]);
+            loader.Request(AssetKind::Texture, texturePaths[(i * 7) % ASSET_COUNT]);
+        }
+        loader.Wait();
+    }
+    state.SetItemsProcessed(state.iterations() * ASSET_COUNT * 2);
+    JobSystem::Get().Shutdown();
+}
+BENCHMARK(BM_AssetLoader_DecodeScene)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
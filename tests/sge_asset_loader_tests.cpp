@@ -0,0 +1,218 @@
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <gtest/gtest.h>
+#include "data/sge_asset_loader.h"
+#include "sge_test_job_system.h"
+using namespace SGE;
+
+namespace
+{
+    class TestAsset : public DecodedAsset
+    {
+    public:
+        explicit TestAsset(const std::string& path) : path(path) {}
+        std::string path;
+    };
+
+    // Paths starting with "missing" decode to nothing, "broken" throws like a corrupt file would.
+    class TestDecoder : public AssetDecoder
+    {
+    public:
+        std::unique_ptr<DecodedAsset> Decode(AssetKind kind, const std::string& path) override
+        {
+            decodeCount.fetch_add(1);
+            if (path.rfind("missing", 0) == 0)
+            {
+                return nullptr;
+            }
+            if (path.rfind("broken", 0) == 0)
+            {
+                throw std::runtime_error("corrupt file");
+            }
+            return std::make_unique<TestAsset>(path);
+        }
+
+        std::atomic<int32> decodeCount{ 0 };
+    };
+
+    class RecordingSink : public AssetUploadSink
+    {
+    public:
+        void Upload(AssetKind kind, const std::string& path, DecodedAsset& asset) override
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            uploads.emplace(kind, path);
+            EXPECT_EQ(static_cast<TestAsset&>(asset).path, path);
+            if (!JobSystem::Get().IsMainThread())
+            {
+                ++uploadsOffMainThread;
+            }
+        }
+
+        std::mutex mutex;
+        std::set<std::pair<AssetKind, std::string>> uploads;
+        int32 uploadsOffMainThread = 0;
+    };
+
+    // Textures starting with "huge" throw like a full descriptor heap would.
+    class ThrowingSink : public RecordingSink
+    {
+    public:
+        void Upload(AssetKind kind, const std::string& path, DecodedAsset& asset) override
+        {
+            if (kind == AssetKind::Texture && path.rfind("huge", 0) == 0)
+            {
+                throw std::runtime_error("Descriptor heap capacity exceeded!");
+            }
+            RecordingSink::Upload(kind, path, asset);
+        }
+    };
+}
+
+TEST(sge_asset_loader, DeduplicatesRequestsPerKindAndPath)
+{
+    ScopedJobSystem jobs(3);
+    TestDecoder decoder;
+    RecordingSink sink;
+    AssetLoader loader;
+    loader.Initialize(&decoder, &sink);
+
+    EXPECT_TRUE(loader.Request(AssetKind::Texture, "albedo.png"));
+    EXPECT_FALSE(loader.Request(AssetKind::Texture, "albedo.png"));
+    EXPECT_TRUE(loader.Request(AssetKind::Model, "albedo.png"));
+    EXPECT_TRUE(loader.Request(AssetKind::Model, "robot.fbx"));
+    loader.Wait();
+
+    // A request for a path that finished loading is dropped too.
+    EXPECT_FALSE(loader.Request(AssetKind::Model, "robot.fbx"));
+    loader.Wait();
+
+    EXPECT_EQ(decoder.decodeCount.load(), 3);
+    EXPECT_EQ(sink.uploads.size(), 3u);
+    EXPECT_EQ(loader.GetState(AssetKind::Texture, "albedo.png"), AssetLoadState::Loaded);
+    EXPECT_EQ(loader.GetState(AssetKind::Texture, "robot.fbx"), AssetLoadState::Unknown);
+}
+
+TEST(sge_asset_loader, DecodesInParallelAndUploadsOnMainThread)
+{
+    ScopedJobSystem jobs(3);
+    TestDecoder decoder;
+    RecordingSink sink;
+    AssetLoader loader;
+    loader.Initialize(&decoder, &sink);
+
+    constexpr int32 COUNT = 200;
+    for (int32 i = 0; i < COUNT; ++i)
+    {
+        loader.Request(AssetKind::Texture, "texture_" + std::to_string(i % (COUNT / 2)));
+        loader.Request(AssetKind::Model, "model_" + std::to_string(i));
+    }
+    loader.Wait();
+
+    EXPECT_TRUE(loader.IsComplete());
+    EXPECT_EQ(decoder.decodeCount.load(), COUNT + COUNT / 2);
+    EXPECT_EQ(sink.uploads.size(), static_cast<size_t>(COUNT + COUNT / 2));
+    EXPECT_EQ(sink.uploadsOffMainThread, 0);
+}
+
+TEST(sge_asset_loader, ReportsProgressAndFailures)
+{
+    ScopedJobSystem jobs(2);
+    TestDecoder decoder;
+    RecordingSink sink;
+    AssetLoader loader;
+    loader.Initialize(&decoder, &sink);
+
+    EXPECT_TRUE(loader.IsComplete());
+    EXPECT_FLOAT_EQ(loader.GetProgress().GetFraction(), 1.0f);
+
+    loader.Request(AssetKind::Model, "robot.fbx");
+    loader.Request(AssetKind::Model, "missing.fbx");
+    loader.Request(AssetKind::Texture, "broken.png");
+    loader.Request(AssetKind::Texture, "albedo.png");
+
+    AssetLoadProgress progress = loader.GetProgress();
+    EXPECT_EQ(progress.requested, 4u);
+    EXPECT_LE(progress.failed, progress.completed);
+    EXPECT_LE(progress.completed, progress.decoded);
+
+    loader.Wait();
+    progress = loader.GetProgress();
+    EXPECT_TRUE(progress.IsComplete());
+    EXPECT_EQ(progress.decoded, 4u);
+    EXPECT_EQ(progress.completed, 4u);
+    EXPECT_EQ(progress.failed, 2u);
+    EXPECT_FLOAT_EQ(progress.GetFraction(), 1.0f);
+
+    EXPECT_EQ(loader.GetState(AssetKind::Model, "robot.fbx"), AssetLoadState::Loaded);
+    EXPECT_EQ(loader.GetState(AssetKind::Model, "missing.fbx"), AssetLoadState::Failed);
+    EXPECT_EQ(loader.GetState(AssetKind::Texture, "broken.png"), AssetLoadState::Failed);
+    EXPECT_EQ(sink.uploads.size(), 2u);
+}
+
+TEST(sge_asset_loader, FailsAssetsTheSinkThrowsOn)
+{
+    ScopedJobSystem jobs(2);
+    TestDecoder decoder;
+    ThrowingSink sink;
+    AssetLoader loader;
+    loader.Initialize(&decoder, &sink);
+
+    loader.Request(AssetKind::Texture, "huge_a.png");
+    loader.Request(AssetKind::Texture, "albedo.png");
+    loader.Request(AssetKind::Texture, "huge_b.png");
+    loader.Request(AssetKind::Model, "robot.fbx");
+
+    EXPECT_NO_THROW(loader.Wait());
+    const AssetLoadProgress progress = loader.GetProgress();
+    EXPECT_TRUE(progress.IsComplete());
+    EXPECT_EQ(progress.completed, 4u);
+    EXPECT_EQ(progress.failed, 2u);
+
+    EXPECT_EQ(loader.GetState(AssetKind::Texture, "huge_a.png"), AssetLoadState::Failed);
+    EXPECT_EQ(loader.GetState(AssetKind::Texture, "huge_b.png"), AssetLoadState::Failed);
+    EXPECT_EQ(loader.GetState(AssetKind::Texture, "albedo.png"), AssetLoadState::Loaded);
+    EXPECT_EQ(loader.GetState(AssetKind::Model, "robot.fbx"), AssetLoadState::Loaded);
+    EXPECT_EQ(sink.uploads.size(), 2u);
+}
+
+TEST(sge_asset_loader, UploadsArriveThroughMainThreadJobs)
+{
+    ScopedJobSystem jobs(2);
+    TestDecoder decoder;
+    RecordingSink sink;
+    AssetLoader loader;
+    loader.Initialize(&decoder, &sink);
+
+    loader.Request(AssetKind::Texture, "albedo.png");
+
+    // Without Wait the uploads are picked up by the per-frame main thread pump.
+    while (!loader.IsComplete())
+    {
+        JobSystem::Get().ProcessMainThreadJobs();
+        std::this_thread::yield();
+    }
+
+    EXPECT_EQ(loader.GetState(AssetKind::Texture, "albedo.png"), AssetLoadState::Loaded);
+    EXPECT_EQ(sink.uploads.size(), 1u);
+}
+
+TEST(sge_asset_loader, LoadsInlineWithoutJobSystem)
+{
+    TestDecoder decoder;
+    RecordingSink sink;
+    AssetLoader loader;
+    loader.Initialize(&decoder, &sink);
+
+    loader.Request(AssetKind::Model, "robot.fbx");
+    EXPECT_EQ(loader.GetState(AssetKind::Model, "robot.fbx"), AssetLoadState::Loaded);
+    EXPECT_TRUE(loader.IsComplete());
+
+    loader.Reset();
+    EXPECT_EQ(loader.GetState(AssetKind::Model, "robot.fbx"), AssetLoadState::Unknown);
+    EXPECT_EQ(loader.GetProgress().requested, 0u);
+    EXPECT_TRUE(loader.Request(AssetKind::Model, "robot.fbx"));
+    EXPECT_EQ(decoder.decodeCount.load(), 2);
+}
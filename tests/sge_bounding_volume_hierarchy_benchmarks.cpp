@@ -0,0 +1,136 @@
+#include <random>
+#include <benchmark/benchmark.h>
+#include "core/sge_bounding_volume_hierarchy.h"
+using namespace SGE;
+
+namespace
+{
+    // A level of instances spread over a wide, flat area.
+    std::vector<BoundingBox> MakeLevel(size_t count)
+    {
+        std::mt19937 generator(13);
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> size(0.5f, 3.0f);
+
+        std::vector<BoundingBox> boxes;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float3 center(distribution(generator) * 1000.0f, distribution(generator) * 20.0f, distribution(generator) * 1000.0f);
+            const float3 extent(size(generator), size(generator), size(generator));
+            boxes.push_back({ center - extent, center + extent });
+        }
+        return boxes;
+    }
+
+    Frustum MakeCameraFrustum()
+    {
+        const float4x4 view = CreateViewMatrix(float3(0.0f, 10.0f, 0.0f), float3(100.0f, 0.0f, 100.0f), float3(0.0f, 1.0f, 0.0f));
+        const float4x4 projection = CreatePerspectiveProjectionMatrix(ConvertToRadians(60.0f), 16.0f / 9.0f, 0.1f, 300.0f);
+        return Frustum::FromMatrix(projection * view);
+    }
+}
+
+static void BM_Bvh_Build(benchmark::State& state)
+{
+    const std::vector<BoundingBox> boxes = MakeLevel(static_cast<size_t>(state.range(0)));
+    BoundingVolumeHierarchy bvh;
+
+    for (auto _ : state)
+    {
+        bvh.Build(boxes);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+BENCHMARK(BM_Bvh_Build)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void BM_FrustumCull_Flat(benchmark::State& state)
+{
+    const std::vector<BoundingBox> boxes = MakeLevel(static_cast<size_t>(state.range(0)));
+    const Frustum frustum = MakeCameraFrustum();
+    std::vector<uint32> visible;
+
+    for (auto _ : state)
+    {
+        visible.clear();
+        for (size_t i = 0; i < boxes.size(); ++i)
+        {
+            if (frustum.IntersectsBox(boxes[i].boundsMin, boxes[i].boundsMax))
+            {
+                visible.push_back(static_cast<uint32>(i));
+            }
+        }
+        benchmark::DoNotOptimize(visible.data());
+    }
+    state.counters["visible"] = static_cast<double>(visible.size());
+}
+BENCHMARK(BM_FrustumCull_Flat)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_Bvh_QueryFrustum(benchmark::State& state)
+{
+    const std::vector<BoundingBox> boxes = MakeLevel(static_cast<size_t>(state.range(0)));
+    const Frustum frustum = MakeCameraFrustum();
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(boxes);
+    std::vector<uint32> visible;
+
+    for (auto _ : state)
+    {
+        bvh.QueryFrustum(frustum, visible);
+        benchmark::DoNotOptimize(visible.data());
+    }
+    state.counters["visible"] = static_cast<double>(visible.size());
+}
+BENCHMARK(BM_Bvh_QueryFrustum)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_Bvh_QuerySphere(benchmark::State& state)
+{
+    const std::vector<BoundingBox> boxes = MakeLevel(static_cast<size_t>(state.range(0)));
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(boxes);
+    std::vector<uint32> lit;
+
+    for (auto _ : state)
+    {
+        bvh.QuerySphere(float3(50.0f, 0.0f, 50.0f), 25.0f, lit);
+        benchmark::DoNotOptimize(lit.data());
+    }
+}
+BENCHMARK(BM_Bvh_QuerySphere)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_Bvh_Raycast(benchmark::State& state)
+{
+    const std::vector<BoundingBox> boxes = MakeLevel(static_cast<size_t>(state.range(0)));
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(boxes);
+    RayHit hit;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(bvh.Raycast(float3(-1000.0f, 5.0f, -900.0f), float3(1.0f, 0.0f, 0.9f).normalized(), 5000.0f, hit));
+    }
+}
+BENCHMARK(BM_Bvh_Raycast)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+// A thousand of the instances walk a little every frame, the rest stand still.
+static void BM_Bvh_UpdateMoving(benchmark::State& state)
+{
+    std::vector<BoundingBox> boxes = MakeLevel(static_cast<size_t>(state.range(0)));
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(boxes);
+    const size_t stride = boxes.size() / 1000;
+
+    float step = 0.05f;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < boxes.size(); i += stride)
+        {
+            boxes[i].boundsMin.x += step;
+            boxes[i].boundsMax.x += step;
+            bvh.Update(static_cast<uint32>(i), boxes[i]);
+        }
+        step = -step;
+    }
+    state.SetItemsProcessed(state.iterations() * (boxes.size() / stride));
+}
+BENCHMARK(BM_Bvh_UpdateMoving)->Arg(100000)->Unit(benchmark::kMicrosecond);
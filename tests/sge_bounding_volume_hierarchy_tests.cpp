@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+#include "core/sge_bounding_volume_hierarchy.h"
+using namespace SGE;
+
+namespace
+{
+    float RandomFloat(std::mt19937& generator, float minValue, float maxValue)
+    {
+        return std::uniform_real_distribution<float>(minValue, maxValue)(generator);
+    }
+
+    BoundingBox RandomBox(std::mt19937& generator, float range)
+    {
+        const float3 center(RandomFloat(generator, -range, range), RandomFloat(generator, -range * 0.2f, range * 0.2f), RandomFloat(generator, -range, range));
+        const float3 extent(RandomFloat(generator, 0.1f, 2.0f), RandomFloat(generator, 0.1f, 2.0f), RandomFloat(generator, 0.1f, 2.0f));
+        return { center - extent, center + extent };
+    }
+
+    Frustum MakeFrustum()
+    {
+        const float4x4 view = CreateViewMatrix(float3(0.0f, 5.0f, -60.0f), float3(10.0f, 0.0f, 0.0f), float3(0.0f, 1.0f, 0.0f));
+        const float4x4 projection = CreatePerspectiveProjectionMatrix(ConvertToRadians(50.0f), 16.0f / 9.0f, 0.1f, 90.0f);
+        return Frustum::FromMatrix(projection * view);
+    }
+
+    std::vector<uint32> Sorted(std::vector<uint32> proxies)
+    {
+        std::sort(proxies.begin(), proxies.end());
+        return proxies;
+    }
+
+    // Every query answered by the tree against a loop over the live objects.
+    void ExpectMatchesBruteForce(const BoundingVolumeHierarchy& bvh, const std::vector<uint32>& live, const std::vector<BoundingBox>& boxes, std::mt19937& generator)
+    {
+        std::vector<uint32> result;
+        std::vector<uint32> expected;
+        for (int query = 0; query < 20; ++query)
+        {
+            const BoundingBox box = RandomBox(generator, 80.0f);
+            const BoundingBox queryBox = { box.boundsMin - float3(8.0f, 8.0f, 8.0f), box.boundsMax + float3(8.0f, 8.0f, 8.0f) };
+            const float3 center = (box.boundsMin + box.boundsMax) * 0.5f;
+            const float radius = RandomFloat(generator, 1.0f, 20.0f);
+
+            expected.clear();
+            std::copy_if(live.begin(), live.end(), std::back_inserter(expected), [&](uint32 i) { return boxes[i].Intersects(queryBox); });
+            bvh.QueryBox(queryBox, result);
+            EXPECT_EQ(Sorted(result), expected);
+
+            expected.clear();
+            std::copy_if(live.begin(), live.end(), std::back_inserter(expected), [&](uint32 i) { return boxes[i].IntersectsSphere(center, radius); });
+            bvh.QuerySphere(center, radius, result);
+            EXPECT_EQ(Sorted(result), expected);
+
+            const float3 origin(RandomFloat(generator, -100.0f, 100.0f), 30.0f, -100.0f);
+            const float3 direction = (center - origin).normalized();
+            const float3 inverseDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+            float closest = 500.0f;
+            uint32 closestProxy = INVALID_BVH_NODE;
+            for (uint32 i : live)
+            {
+                float distance = 0.0f;
+                if (boxes[i].IntersectsRay(origin, inverseDirection, closest, distance) && (distance < closest || closestProxy == INVALID_BVH_NODE))
+                {
+                    closest = distance;
+                    closestProxy = i;
+                }
+            }
+
+            RayHit hit;
+            EXPECT_EQ(bvh.Raycast(origin, direction, 500.0f, hit), closestProxy != INVALID_BVH_NODE);
+            if (closestProxy != INVALID_BVH_NODE)
+            {
+                EXPECT_NEAR(hit.distance, closest, 1e-4f);
+            }
+        }
+
+        const Frustum frustum = MakeFrustum();
+        expected.clear();
+        std::copy_if(live.begin(), live.end(), std::back_inserter(expected), [&](uint32 i) { return frustum.IntersectsBox(boxes[i].boundsMin, boxes[i].boundsMax); });
+        bvh.QueryFrustum(frustum, result);
+        EXPECT_EQ(Sorted(result), expected);
+        EXPECT_GT(expected.size(), 50u);
+    }
+}
+
+TEST(sge_bounding_volume_hierarchy, BuiltTreeMatchesBruteForce)
+{
+    std::mt19937 generator(5);
+    std::vector<BoundingBox> boxes;
+    std::vector<uint32> live;
+    for (uint32 i = 0; i < 2000; ++i)
+    {
+        boxes.push_back(RandomBox(generator, 100.0f));
+        live.push_back(i);
+    }
+
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(boxes);
+    EXPECT_EQ(bvh.GetCount(), 2000u);
+    EXPECT_LT(bvh.GetHeight(), 40u);
+    for (uint32 i = 0; i < 2000; ++i)
+    {
+        EXPECT_EQ(bvh.GetBox(i), boxes[i]);
+    }
+
+    ExpectMatchesBruteForce(bvh, live, boxes, generator);
+}
+
+TEST(sge_bounding_volume_hierarchy, StaysCorrectWhileObjectsMove)
+{
+    std::mt19937 generator(9);
+    std::vector<BoundingBox> boxes;
+    std::vector<uint32> live;
+    for (uint32 i = 0; i < 1500; ++i)
+    {
+        boxes.push_back(RandomBox(generator, 100.0f));
+        live.push_back(i);
+    }
+
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(boxes);
+
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        // Most objects drift a little, a few jump across the level.
+        for (uint32 i = 0; i < 1500; i += 5)
+        {
+            const float distance = (i % 50 == 0) ? 80.0f : 0.5f;
+            const float3 offset(RandomFloat(generator, -distance, distance), 0.0f, RandomFloat(generator, -distance, distance));
+            boxes[i] = { boxes[i].boundsMin + offset, boxes[i].boundsMax + offset };
+            EXPECT_TRUE(bvh.Update(i, boxes[i]));
+        }
+    }
+
+    for (uint32 i = 0; i < 100; ++i)
+    {
+        EXPECT_TRUE(bvh.Remove(live[i * 7]));
+        const uint32 proxy = bvh.Insert(RandomBox(generator, 100.0f));
+        boxes.resize(std::max<size_t>(boxes.size(), proxy + 1));
+        boxes[proxy] = bvh.GetBox(proxy);
+        live[i * 7] = proxy;
+    }
+    std::sort(live.begin(), live.end());
+    EXPECT_EQ(bvh.GetCount(), 1500u);
+
+    ExpectMatchesBruteForce(bvh, live, boxes, generator);
+
+    // Refitting with rotations and reinserting keeps the tree close to a fresh build.
+    std::vector<BoundingBox> liveBoxes;
+    for (uint32 i : live)
+    {
+        liveBoxes.push_back(boxes[i]);
+    }
+    BoundingVolumeHierarchy rebuilt;
+    rebuilt.Build(liveBoxes);
+    EXPECT_LT(bvh.GetCost(), rebuilt.GetCost() * 1.5f);
+}
+
+TEST(sge_bounding_volume_hierarchy, IgnoresUnchangedBoxesAndStaleProxies)
+{
+    const std::vector<BoundingBox> boxes =
+    {
+        { float3(0.0f, 0.0f, 0.0f), float3(1.0f, 1.0f, 1.0f) },
+        { float3(4.0f, 0.0f, 0.0f), float3(5.0f, 1.0f, 1.0f) },
+        { float3(8.0f, 0.0f, 0.0f), float3(9.0f, 1.0f, 1.0f) }
+    };
+
+    BoundingVolumeHierarchy bvh;
+    bvh.Build(boxes);
+    EXPECT_FALSE(bvh.Update(1, boxes[1]));
+    EXPECT_TRUE(bvh.Remove(1));
+    EXPECT_FALSE(bvh.Remove(1));
+    EXPECT_FALSE(bvh.Update(1, boxes[0]));
+    EXPECT_FALSE(bvh.Remove(100));
+    EXPECT_EQ(bvh.GetCount(), 2u);
+
+    std::vector<uint32> proxies;
+    bvh.QueryBox({ float3(-1.0f, -1.0f, -1.0f), float3(10.0f, 2.0f, 2.0f) }, proxies);
+    EXPECT_EQ(Sorted(proxies), (std::vector<uint32>{ 0, 2 }));
+
+    RayHit hit;
+    EXPECT_TRUE(bvh.Raycast(float3(20.0f, 0.5f, 0.5f), float3(-1.0f, 0.0f, 0.0f), 100.0f, hit));
+    EXPECT_EQ(hit.proxy, 2u);
+    EXPECT_NEAR(hit.distance, 11.0f, 1e-5f);
+    EXPECT_FALSE(bvh.Raycast(float3(20.0f, 0.5f, 0.5f), float3(-1.0f, 0.0f, 0.0f), 10.0f, hit));
+
+    // A quarter turn about y swaps the box's x and z extents.
+    const BoundingBox moved = BoundingBox{ float3(-2.0f, -1.0f, -0.5f), float3(2.0f, 1.0f, 0.5f) }.Transformed(
+        CreateTranslationMatrix(float3(10.0f, 0.0f, 0.0f)) * CreateRotationMatrixFromQuaternion(CreateQuaternionYawPitchRoll(ConvertToRadians(90.0f), 0.0f, 0.0f)));
+    EXPECT_NEAR(moved.boundsMin.x, 9.5f, 1e-4f);
+    EXPECT_NEAR(moved.boundsMax.z, 2.0f, 1e-4f);
+
+    bvh.Clear();
+    bvh.QueryFrustum(MakeFrustum(), proxies);
+    EXPECT_TRUE(proxies.empty());
+    EXPECT_FALSE(bvh.Raycast(float3(0.0f, 0.0f, 0.0f), float3(1.0f, 0.0f, 0.0f), 10.0f, hit));
+}
@@ -0,0 +1,123 @@
+#include <map>
+#include <memory>
+#include <benchmark/benchmark.h>
+#include "core/sge_entity_registry.h"
+#include "core/sge_math.h"
+using namespace SGE;
+
+namespace
+{
+    struct Motion
+    {
+        float3 position;
+        float3 velocity;
+    };
+
+    struct Light
+    {
+        float radius = 1.0f;
+    };
+
+    // Stand-ins for the scene objects and runtime instances the scene used to pair in a map.
+    struct ObjectData
+    {
+        float3 velocity;
+    };
+
+    struct Instance
+    {
+        float3 position;
+    };
+}
+
+// Every entity moves: one dense pool read in order.
+static void BM_EntityRegistry_EachOne(benchmark::State& state)
+{
+    EntityRegistry registry;
+    for (int64 i = 0; i < state.range(0); ++i)
+    {
+        registry.Add<Motion>(registry.Create(), { float3::Zero, float3(1.0f, 0.0f, 0.0f) });
+    }
+
+    for (auto _ : state)
+    {
+        registry.Each<Motion>([](Entity, Motion& motion)
+        {
+            motion.position += motion.velocity * 0.016f;
+        });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EntityRegistry_EachOne)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+// A tenth of the entities are lights: the rare pool leads, the common one is looked up.
+static void BM_EntityRegistry_EachTwo(benchmark::State& state)
+{
+    EntityRegistry registry;
+    for (int64 i = 0; i < state.range(0); ++i)
+    {
+        const Entity entity = registry.Create();
+        registry.Add<Motion>(entity, { float3::Zero, float3(1.0f, 0.0f, 0.0f) });
+        if (i % 10 == 0)
+        {
+            registry.Add<Light>(entity);
+        }
+    }
+
+    for (auto _ : state)
+    {
+        registry.Each<Light, Motion>([](Entity, Light& light, Motion& motion)
+        {
+            motion.position.y = light.radius;
+        });
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_EntityRegistry_EachTwo)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+// The same update through a map keyed by object pointer, with each side allocated on its own.
+static void BM_EntityRegistry_PointerMap(benchmark::State& state)
+{
+    std::vector<std::unique_ptr<ObjectData>> objects;
+    std::vector<std::unique_ptr<Instance>> instances;
+    std::map<const ObjectData*, Instance*> pairs;
+    for (int64 i = 0; i < state.range(0); ++i)
+    {
+        objects.push_back(std::make_unique<ObjectData>(ObjectData{ float3(1.0f, 0.0f, 0.0f) }));
+        instances.push_back(std::make_unique<Instance>(Instance{ float3::Zero }));
+        pairs[objects.back().get()] = instances.back().get();
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto& pair : pairs)
+        {
+            pair.second->position += pair.first->velocity * 0.016f;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EntityRegistry_PointerMap)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_EntityRegistry_CreateDestroy(benchmark::State& state)
+{
+    EntityRegistry registry;
+    std::vector<Entity> entities(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        for (Entity& entity : entities)
+        {
+            entity = registry.Create();
+            registry.Add<Motion>(entity);
+        }
+        for (Entity entity : entities)
+        {
+            registry.Destroy(entity);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EntityRegistry_CreateDestroy)->Arg(100000)->Unit(benchmark::kMicrosecond);
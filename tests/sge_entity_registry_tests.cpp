@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+#include "core/sge_entity_registry.h"
+using namespace SGE;
+
+namespace
+{
+    struct Position
+    {
+        float x = 0.0f;
+    };
+
+    struct Velocity
+    {
+        float x = 0.0f;
+    };
+
+    struct Tag {};
+}
+
+TEST(sge_entity_registry, HandlesOfDestroyedEntitiesStayInvalid)
+{
+    EntityRegistry registry;
+    const Entity a = registry.Create();
+    const Entity b = registry.Create();
+    EXPECT_TRUE(registry.IsAlive(a));
+    EXPECT_TRUE(registry.IsAlive(b));
+    EXPECT_FALSE(registry.IsAlive(Entity{}));
+    EXPECT_EQ(registry.GetCount(), 2u);
+
+    registry.Add<Position>(a, { 1.0f });
+    EXPECT_TRUE(registry.Destroy(a));
+    EXPECT_FALSE(registry.Destroy(a));
+    EXPECT_FALSE(registry.IsAlive(a));
+    EXPECT_EQ(registry.GetCount(), 1u);
+
+    // The index comes back with a new generation, the old handle reaches nothing.
+    const Entity c = registry.Create();
+    EXPECT_EQ(c.index, a.index);
+    EXPECT_NE(c, a);
+    EXPECT_TRUE(registry.IsAlive(c));
+    EXPECT_FALSE(registry.IsAlive(a));
+    EXPECT_FALSE(registry.Has<Position>(c));
+    registry.Add<Position>(c, { 2.0f });
+    EXPECT_EQ(registry.TryGet<Position>(a), nullptr);
+    EXPECT_FALSE(registry.Remove<Position>(a));
+    EXPECT_EQ(registry.TryGet<Position>(c)->x, 2.0f);
+
+    // A handle with the current generation of a free index isn't alive either.
+    const Entity d = registry.Create();
+    EXPECT_TRUE(registry.Destroy(d));
+    EXPECT_FALSE(registry.IsAlive(Entity{ d.index, d.generation + 1 }));
+
+    registry.Clear();
+    EXPECT_EQ(registry.GetCount(), 0u);
+    EXPECT_FALSE(registry.IsAlive(c));
+    EXPECT_FALSE(registry.Has<Position>(c));
+}
+
+TEST(sge_entity_registry, HandlesStayInvalidAfterClear)
+{
+    EntityRegistry registry;
+    std::vector<Entity> before;
+    for (int32 i = 0; i < 4; ++i)
+    {
+        before.push_back(registry.Create());
+        registry.Add<Position>(before.back(), { static_cast<float>(i) });
+    }
+    EXPECT_TRUE(registry.Destroy(before[2]));
+
+    registry.Clear();
+    EXPECT_EQ(registry.GetCount(), 0u);
+
+    // The indices are reused, with generations none of the old handles has.
+    for (int32 i = 0; i < 4; ++i)
+    {
+        const Entity entity = registry.Create();
+        EXPECT_EQ(entity.index, static_cast<uint32>(i));
+        EXPECT_NE(entity, before[i]);
+        EXPECT_TRUE(registry.IsAlive(entity));
+    }
+    EXPECT_EQ(registry.GetCount(), 4u);
+
+    for (const Entity& entity : before)
+    {
+        EXPECT_FALSE(registry.IsAlive(entity));
+        EXPECT_FALSE(registry.Has<Position>(entity));
+        EXPECT_FALSE(registry.Destroy(entity));
+    }
+    EXPECT_EQ(registry.GetCount(), 4u);
+}
+
+TEST(sge_entity_registry, PoolsStayDenseAndMatchBruteForce)
+{
+    std::mt19937 generator(3);
+    EntityRegistry registry;
+    std::vector<Entity> entities;
+    std::vector<bool> hasPosition;
+    std::vector<bool> hasVelocity;
+    for (uint32 i = 0; i < 1000; ++i)
+    {
+        entities.push_back(registry.Create());
+        hasPosition.push_back(generator() % 3 != 0);
+        hasVelocity.push_back(generator() % 2 == 0);
+        if (hasPosition.back())
+        {
+            registry.Add<Position>(entities.back(), { static_cast<float>(i) });
+        }
+        if (hasVelocity.back())
+        {
+            registry.Add<Velocity>(entities.back(), { 1.0f });
+        }
+    }
+
+    // Remove components and whole entities in random order.
+    for (uint32 i = 0; i < 300; ++i)
+    {
+        const uint32 victim = generator() % 1000;
+        if (i % 3 == 0)
+        {
+            EXPECT_EQ(registry.Destroy(entities[victim]), registry.IsAlive(entities[victim]));
+            hasPosition[victim] = false;
+            hasVelocity[victim] = false;
+        }
+        else
+        {
+            EXPECT_EQ(registry.Remove<Position>(entities[victim]), static_cast<bool>(hasPosition[victim]));
+            hasPosition[victim] = false;
+        }
+    }
+
+    const ComponentPool<Position>* positions = registry.FindPool<Position>();
+    ASSERT_NE(positions, nullptr);
+    EXPECT_EQ(positions->GetSize(), static_cast<size_t>(std::count(hasPosition.begin(), hasPosition.end(), true)));
+    EXPECT_EQ(positions->GetEntities().size(), positions->GetComponents().size());
+    for (size_t i = 0; i < positions->GetSize(); ++i)
+    {
+        // Swapped components still belong to their entities.
+        EXPECT_EQ(positions->GetComponents()[i].x, static_cast<float>(positions->GetEntities()[i].index));
+    }
+
+    std::vector<uint32> visited;
+    registry.Each<Velocity, Position>([&](Entity entity, Velocity& velocity, Position& position)
+    {
+        position.x += velocity.x;
+        visited.push_back(entity.index);
+    });
+    std::sort(visited.begin(), visited.end());
+
+    std::vector<uint32> expected;
+    for (uint32 i = 0; i < 1000; ++i)
+    {
+        if (hasPosition[i] && hasVelocity[i])
+        {
+            expected.push_back(i);
+            EXPECT_EQ(registry.TryGet<Position>(entities[i])->x, static_cast<float>(i) + 1.0f);
+        }
+        else if (hasPosition[i])
+        {
+            EXPECT_EQ(registry.TryGet<Position>(entities[i])->x, static_cast<float>(i));
+        }
+        EXPECT_EQ(registry.Has<Velocity>(entities[i]), static_cast<bool>(hasVelocity[i]));
+    }
+    EXPECT_EQ(visited, expected);
+
+    // Adding again replaces, a type nobody added has no pool and no iterations.
+    registry.Add<Velocity>(entities[expected[0]], { 5.0f });
+    EXPECT_EQ(registry.TryGet<Velocity>(entities[expected[0]])->x, 5.0f);
+    size_t tagged = 0;
+    registry.Each<Tag>([&](Entity, Tag&) { ++tagged; });
+    registry.Each<Position, Tag>([&](Entity, Position&, Tag&) { ++tagged; });
+    EXPECT_EQ(tagged, 0u);
+    EXPECT_EQ(registry.FindPool<Tag>(), nullptr);
+}
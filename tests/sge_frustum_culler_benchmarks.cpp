@@ -0,0 +1,85 @@
+#include <random>
+#include <benchmark/benchmark.h>
+#include "core/sge_frustum_culler.h"
+using namespace SGE;
+
+namespace
+{
+    struct CullBatch
+    {
+        std::vector<float3> boxMins;
+        std::vector<float3> boxMaxs;
+        std::vector<float3> centers;
+        std::vector<float> radii;
+        FrustumCuller culler;
+    };
+
+    CullBatch MakeCullBatch(size_t count)
+    {
+        std::mt19937 generator(11);
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+        CullBatch batch;
+        batch.culler.Resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float3 position = float3(distribution(generator), distribution(generator), distribution(generator)) * 100.0f;
+            const float3 extent(1.0f, 2.0f, 1.0f);
+            batch.boxMins.push_back(position - extent);
+            batch.boxMaxs.push_back(position + extent);
+            batch.centers.push_back(position);
+            batch.radii.push_back(extent.length());
+            batch.culler.SetBounds(i, batch.boxMins[i], batch.boxMaxs[i], batch.centers[i], batch.radii[i]);
+        }
+        return batch;
+    }
+
+    Frustum MakeCameraFrustum()
+    {
+        const float4x4 view = CreateViewMatrix(float3(0.0f, 5.0f, -60.0f), float3(0.0f, 0.0f, 0.0f), float3(0.0f, 1.0f, 0.0f));
+        const float4x4 projection = CreatePerspectiveProjectionMatrix(ConvertToRadians(60.0f), 16.0f / 9.0f, 0.1f, 150.0f);
+        return Frustum::FromMatrix(projection * view);
+    }
+}
+
+static void BM_FrustumCull_PerObject(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    CullBatch batch = MakeCullBatch(count);
+    const Frustum frustum = MakeCameraFrustum();
+    std::vector<uint32> visible;
+
+    for (auto _ : state)
+    {
+        visible.clear();
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (frustum.IntersectsBox(batch.boxMins[i], batch.boxMaxs[i]) && frustum.IntersectsSphere(batch.centers[i], batch.radii[i]))
+            {
+                visible.push_back(static_cast<uint32>(i));
+            }
+        }
+        benchmark::DoNotOptimize(visible.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_FrustumCull_PerObject)->Arg(1024)->Arg(16384);
+
+static void BM_FrustumCull_Batch(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    CullBatch batch = MakeCullBatch(count);
+    const Frustum frustum = MakeCameraFrustum();
+    std::vector<uint32> visible;
+
+    for (auto _ : state)
+    {
+        batch.culler.Cull(frustum, visible);
+        benchmark::DoNotOptimize(visible.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetLabel(GetSimdInstructionSetName());
+}
+BENCHMARK(BM_FrustumCull_Batch)->Arg(1024)->Arg(16384);
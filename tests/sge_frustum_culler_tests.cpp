@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+#include "core/sge_frustum_culler.h"
+using namespace SGE;
+
+namespace
+{
+    float RandomFloat(std::mt19937& generator, float minValue, float maxValue)
+    {
+        return std::uniform_real_distribution<float>(minValue, maxValue)(generator);
+    }
+
+    Frustum MakePerspectiveFrustum()
+    {
+        const float4x4 view = CreateViewMatrix(float3(0.0f, 2.0f, -30.0f), float3(5.0f, 0.0f, 0.0f), float3(0.0f, 1.0f, 0.0f));
+        const float4x4 projection = CreatePerspectiveProjectionMatrix(ConvertToRadians(60.0f), 16.0f / 9.0f, 0.1f, 60.0f);
+        return Frustum::FromMatrix(projection * view);
+    }
+
+    // The directional light view of the scene: an orthographic box looking down.
+    Frustum MakeOrthographicFrustum()
+    {
+        const float4x4 view = CreateViewMatrix(float3(0.0f, 10.0f, 0.0f), float3(0.0f, 0.0f, 0.0f), float3(0.0f, 0.0f, 1.0f));
+        const float4x4 projection = CreateOrthographicProjectionMatrix(20.0f, 20.0f, 0.01f, 20.0f);
+        return Frustum::FromMatrix(projection * view);
+    }
+
+    // Smallest signed distance of box and sphere to the planes, the brute force answer is
+    // visible when it's not negative.
+    float GetMargin(const Frustum& frustum, const float3& boxMin, const float3& boxMax, const float3& center, float radius)
+    {
+        float margin = FLT_MAX;
+        for (int p = 0; p < Frustum::PlaneCount; ++p)
+        {
+            const Plane& plane = frustum.GetPlane(static_cast<Frustum::PlaneIndex>(p));
+            const float3 corner(plane.normal.x >= 0.0f ? boxMax.x : boxMin.x,
+                                plane.normal.y >= 0.0f ? boxMax.y : boxMin.y,
+                                plane.normal.z >= 0.0f ? boxMax.z : boxMin.z);
+            margin = std::min(margin, std::min(plane.GetDistance(corner), plane.GetDistance(center) + radius));
+        }
+        return margin;
+    }
+
+    void ExpectMatchesBruteForce(const Frustum& frustum, uint32 seed)
+    {
+        std::mt19937 generator(seed);
+        const size_t count = 1003; // not a multiple of any lane width
+
+        FrustumCuller culler;
+        culler.Resize(count);
+        std::vector<float3> boxMins(count), boxMaxs(count), centers(count);
+        std::vector<float> radii(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float3 position(RandomFloat(generator, -40.0f, 40.0f), RandomFloat(generator, -20.0f, 20.0f), RandomFloat(generator, -40.0f, 70.0f));
+            const float3 extent(RandomFloat(generator, 0.1f, 3.0f), RandomFloat(generator, 0.1f, 3.0f), RandomFloat(generator, 0.1f, 3.0f));
+            boxMins[i] = position - extent;
+            boxMaxs[i] = position + extent;
+            centers[i] = position + float3(RandomFloat(generator, -0.5f, 0.5f), 0.0f, 0.0f);
+            radii[i] = RandomFloat(generator, 0.5f, 1.2f) * extent.length();
+            culler.SetBounds(i, boxMins[i], boxMaxs[i], centers[i], radii[i]);
+        }
+
+        std::vector<uint32> visible = { 7 };
+        culler.Cull(frustum, visible);
+        EXPECT_TRUE(std::is_sorted(visible.begin(), visible.end()));
+
+        size_t checked = 0;
+        size_t visibleCount = 0;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            const float margin = GetMargin(frustum, boxMins[i], boxMaxs[i], centers[i], radii[i]);
+            if (std::abs(margin) < 1e-3f)
+            {
+                continue; // on a plane, rounding decides
+            }
+
+            const bool isVisible = std::binary_search(visible.begin(), visible.end(), i);
+            EXPECT_EQ(isVisible, margin >= 0.0f) << "object " << i;
+            EXPECT_EQ(margin >= 0.0f, frustum.IntersectsBox(boxMins[i], boxMaxs[i]) && frustum.IntersectsSphere(centers[i], radii[i]));
+            visibleCount += isVisible ? 1 : 0;
+            ++checked;
+        }
+
+        // Enough of both answers to mean something.
+        EXPECT_GT(checked, count - 10);
+        EXPECT_GT(visibleCount, 20u);
+        EXPECT_LT(visibleCount, checked - 20);
+    }
+}
+
+TEST(sge_frustum_culler, MatchesBruteForceInPerspective)
+{
+    ExpectMatchesBruteForce(MakePerspectiveFrustum(), 17);
+}
+
+TEST(sge_frustum_culler, MatchesBruteForceInOrthographic)
+{
+    ExpectMatchesBruteForce(MakeOrthographicFrustum(), 23);
+}
+
+TEST(sge_frustum_culler, MovesModelBoundsToWorldSpace)
+{
+    const Frustum frustum = MakeOrthographicFrustum();
+    const float3 boxMin(-1.0f, -0.5f, -0.5f);
+    const float3 boxMax(1.0f, 0.5f, 0.5f);
+
+    FrustumCuller culler;
+    culler.Resize(3);
+    // Moved out of the light's box on x.
+    culler.SetBounds(0, CreateTranslationMatrix(float3(13.0f, 0.0f, 0.0f)), boxMin, boxMax, float3(0.0f, 0.0f, 0.0f), 1.2f);
+    // Stretched along x, the same translation leaves it reaching back in.
+    culler.SetBounds(1, CreateTranslationMatrix(float3(13.0f, 0.0f, 0.0f)) * CreateScaleMatrix(float3(4.0f, 1.0f, 1.0f)),
+                     boxMin, boxMax, float3(0.0f, 0.0f, 0.0f), 1.2f);
+    // Rotated a quarter turn about y, now long along z and still out of reach on x.
+    culler.SetBounds(2, CreateTranslationMatrix(float3(11.2f, 0.0f, 0.0f)) * CreateRotationMatrixFromQuaternion(CreateQuaternionYawPitchRoll(ConvertToRadians(90.0f), 0.0f, 0.0f)) *
+                     CreateScaleMatrix(float3(4.0f, 1.0f, 1.0f)), boxMin, boxMax, float3(0.0f, 0.0f, 0.0f), 1.2f);
+
+    std::vector<uint32> visible;
+    culler.Cull(frustum, visible);
+    EXPECT_EQ(visible, std::vector<uint32>{ 1 });
+
+    culler.Resize(0);
+    culler.Cull(frustum, visible);
+    EXPECT_TRUE(visible.empty());
+}
@@ -0,0 +1,77 @@
+#include <cmath>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "core/sge_job_system.h"
+#include "core/sge_math.h"
+using namespace SGE;
+
+// Scaling of the job system over thread counts (main thread included). Argument 1 runs every
+// job on the main thread and is the baseline the other counts are compared against.
+namespace
+{
+    constexpr size_t ELEMENT_COUNT = 1 << 16;
+
+    void Transform(const std::vector<float4x4>& matrices, std::vector<float4>& out, size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            float4 value(static_cast<float>(i), 1.0f, 2.0f, 1.0f);
+            for (int step = 0; step < 8; ++step)
+            {
+                value = matrices[i & 63] * value;
+            }
+            out[i] = value;
+        }
+    }
+
+    void InitializeThreads(const benchmark::State& state)
+    {
+        JobSystem::Get().Initialize(static_cast<uint32>(state.range(0)) - 1);
+    }
+
+    void SpawnTree(JobCounter& counter, int32 depth)
+    {
+        if (depth == 0)
+        {
+            return;
+        }
+
+        JobSystem::Get().Run([&counter, depth]() { SpawnTree(counter, depth - 1); }, &counter);
+        JobSystem::Get().Run([&counter, depth]() { SpawnTree(counter, depth - 1); }, &counter);
+    }
+}
+
+static void BM_JobSystem_ParallelFor(benchmark::State& state)
+{
+    InitializeThreads(state);
+
+    std::vector<float4x4> matrices(64, CreateRotationMatrixYawPitchRoll(0.1f, 0.2f, 0.3f));
+    std::vector<float4> out(ELEMENT_COUNT);
+
+    for (auto _ : state)
+    {
+        JobSystem::Get().ParallelFor(ELEMENT_COUNT, [&](size_t begin, size_t end) { Transform(matrices, out, begin, end); }, 256);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * ELEMENT_COUNT);
+    JobSystem::Get().Shutdown();
+}
+BENCHMARK(BM_JobSystem_ParallelFor)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// Many tiny jobs: measures queue, steal and counter overhead rather than useful work.
+static void BM_JobSystem_SpawnTree(benchmark::State& state)
+{
+    InitializeThreads(state);
+    constexpr int32 DEPTH = 12;
+
+    for (auto _ : state)
+    {
+        JobCounter counter;
+        SpawnTree(counter, DEPTH);
+        JobSystem::Get().Wait(counter);
+    }
+    state.SetItemsProcessed(state.iterations() * ((int64_t(1) << (DEPTH + 1)) - 2));
+    JobSystem::Get().Shutdown();
+}
+BENCHMARK(BM_JobSystem_SpawnTree)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMicrosecond)->UseRealTime();
@@ -0,0 +1,428 @@
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include "core/sge_job_system.h"
+#include "sge_test_job_system.h"
+using namespace SGE;
+
+namespace
+{
+    void SpawnTree(JobCounter& counter, std::atomic<int32>& visited, int32 depth)
+    {
+        visited.fetch_add(1);
+        if (depth == 0)
+        {
+            return;
+        }
+
+        // Children join the counter of their parent.
+        for (int32 i = 0; i < 2; ++i)
+        {
+            JobSystem::Get().Run([&counter, &visited, depth]() { SpawnTree(counter, visited, depth - 1); }, &counter);
+        }
+    }
+}
+
+TEST(sge_work_stealing_queue, OwnerPopsNewestThiefStealsOldest)
+{
+    WorkStealingQueue<int*> queue(4);
+    int values[5] = {};
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(queue.Push(&values[i]));
+    }
+    EXPECT_FALSE(queue.Push(&values[4]));
+    EXPECT_EQ(queue.GetSize(), 4u);
+
+    EXPECT_EQ(queue.Pop(), &values[3]);
+    EXPECT_EQ(queue.Steal(), &values[0]);
+    EXPECT_EQ(queue.Steal(), &values[1]);
+    EXPECT_EQ(queue.Pop(), &values[2]);
+    EXPECT_EQ(queue.Pop(), nullptr);
+    EXPECT_EQ(queue.Steal(), nullptr);
+    EXPECT_TRUE(queue.IsEmpty());
+
+    // Indices wrap around the ring buffer.
+    for (int round = 0; round < 3; ++round)
+    {
+        EXPECT_TRUE(queue.Push(&values[round]));
+        EXPECT_EQ(queue.Steal(), &values[round]);
+    }
+}
+
+TEST(sge_work_stealing_queue, ConcurrentStealTakesEveryItemOnce)
+{
+    constexpr int32 ITEM_COUNT = 200000;
+    constexpr int32 THIEF_COUNT = 3;
+
+    WorkStealingQueue<int32*> queue(256);
+    std::vector<int32> items(ITEM_COUNT, 0);
+    std::vector<std::atomic<int32>> taken(ITEM_COUNT);
+    std::atomic<bool> done{ false };
+
+    auto take = [&](int32* item) { taken[item - items.data()].fetch_add(1); };
+
+    std::vector<std::thread> thieves;
+    for (int32 i = 0; i < THIEF_COUNT; ++i)
+    {
+        thieves.emplace_back([&]()
+        {
+            while (!done.load())
+            {
+                if (int32* item = queue.Steal())
+                {
+                    take(item);
+                }
+            }
+        });
+    }
+
+    for (int32 i = 0; i < ITEM_COUNT; ++i)
+    {
+        while (!queue.Push(&items[i]))
+        {
+            if (int32* item = queue.Pop())
+            {
+                take(item);
+            }
+        }
+
+        if (i % 3 == 0)
+        {
+            if (int32* item = queue.Pop())
+            {
+                take(item);
+            }
+        }
+    }
+
+    while (int32* item = queue.Pop())
+    {
+        take(item);
+    }
+
+    done = true;
+    for (std::thread& thief : thieves)
+    {
+        thief.join();
+    }
+
+    while (int32* item = queue.Steal())
+    {
+        take(item);
+    }
+
+    for (int32 i = 0; i < ITEM_COUNT; ++i)
+    {
+        ASSERT_EQ(taken[i].load(), 1) << "item " << i;
+    }
+}
+
+TEST(sge_job_system, RunsInlineWithoutInitialize)
+{
+    JobSystem& jobSystem = JobSystem::Get();
+    ASSERT_FALSE(jobSystem.IsInitialized());
+
+    JobCounter counter;
+    int32 value = 0;
+    jobSystem.Run([&]() { value = 1; }, &counter);
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(counter.IsDone());
+
+    size_t total = 0;
+    jobSystem.ParallelFor(100, [&](size_t begin, size_t end) { total += end - begin; });
+    EXPECT_EQ(total, 100u);
+}
+
+TEST(sge_job_system, WaitRunsAllJobs)
+{
+    ScopedJobSystem scope(3);
+    JobSystem& jobSystem = JobSystem::Get();
+    EXPECT_EQ(jobSystem.GetThreadCount(), 4u);
+    EXPECT_TRUE(jobSystem.IsMainThread());
+
+    JobCounter counter;
+    std::vector<std::atomic<int32>> runs(1000);
+    for (size_t i = 0; i < runs.size(); ++i)
+    {
+        jobSystem.Run([&runs, i]() { runs[i].fetch_add(1); }, &counter);
+    }
+
+    jobSystem.Wait(counter);
+    EXPECT_TRUE(counter.IsDone());
+    for (const std::atomic<int32>& count : runs)
+    {
+        ASSERT_EQ(count.load(), 1);
+    }
+}
+
+TEST(sge_job_system, ChildrenExtendParentCounter)
+{
+    ScopedJobSystem scope(3);
+
+    JobCounter counter;
+    std::atomic<int32> visited{ 0 };
+    JobSystem::Get().Run([&]() { SpawnTree(counter, visited, 10); }, &counter);
+    JobSystem::Get().Wait(counter);
+
+    EXPECT_EQ(visited.load(), (1 << 11) - 1);
+}
+
+TEST(sge_job_system, ParallelForVisitsEveryIndexOnce)
+{
+    ScopedJobSystem scope(3);
+
+    for (size_t count : { 1, 2, 17, 1000, 100000 })
+    {
+        for (size_t minGrainSize : { 1, 64 })
+        {
+            std::vector<std::atomic<int32>> visits(count);
+            std::atomic<size_t> largestChunk{ 0 };
+
+            JobSystem::Get().ParallelFor(count, [&](size_t begin, size_t end)
+            {
+                size_t chunk = end - begin;
+                size_t largest = largestChunk.load();
+                while (chunk > largest && !largestChunk.compare_exchange_weak(largest, chunk)) {}
+
+                for (size_t i = begin; i < end; ++i)
+                {
+                    visits[i].fetch_add(1);
+                }
+            }, minGrainSize);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                ASSERT_EQ(visits[i].load(), 1) << "count " << count << " index " << i;
+            }
+            EXPECT_LE(largestChunk.load(), std::max<size_t>(minGrainSize, count / 16)) << "count " << count;
+        }
+    }
+}
+
+TEST(sge_job_system, ParallelForMatchesSerial)
+{
+    ScopedJobSystem scope(4);
+
+    auto work = [](std::vector<float>& out, size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            float value = static_cast<float>(i);
+            for (int step = 0; step < 16; ++step)
+            {
+                value = value * 0.5f + 1.0f / (value + 1.0f);
+            }
+            out[i] = value;
+        }
+    };
+
+    std::vector<float> serial(4096), parallel(4096);
+    work(serial, 0, serial.size());
+    JobSystem::Get().ParallelFor(parallel.size(), [&](size_t begin, size_t end) { work(parallel, begin, end); });
+
+    EXPECT_EQ(serial, parallel);
+}
+
+TEST(sge_job_system, ParallelForAsyncOverlapsCaller)
+{
+    ScopedJobSystem scope(2);
+
+    JobCounter counter;
+    std::vector<int32> values(256, 0);
+    JobSystem::Get().ParallelForAsync(values.size(), [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            values[i] = static_cast<int32>(i);
+        }
+    }, counter, 8);
+
+    int32 sum = 0;
+    for (int32 i = 0; i < 100; ++i)
+    {
+        sum += i;
+    }
+
+    JobSystem::Get().Wait(counter);
+    EXPECT_EQ(sum, 4950);
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 255 * 256 / 2);
+}
+
+TEST(sge_job_system, MainThreadJobsRunOnMainThread)
+{
+    ScopedJobSystem scope(3);
+    JobSystem& jobSystem = JobSystem::Get();
+    const std::thread::id mainThread = std::this_thread::get_id();
+
+    std::vector<std::thread::id> threads;
+    jobSystem.RunOnMainThread([&]() { threads.push_back(std::this_thread::get_id()); });
+    EXPECT_TRUE(threads.empty());
+    jobSystem.ProcessMainThreadJobs();
+    ASSERT_EQ(threads.size(), 1u);
+
+    // Worker jobs hand results back to the main thread, Wait runs them while helping.
+    JobCounter counter;
+    for (int32 i = 0; i < 32; ++i)
+    {
+        jobSystem.Run([&]()
+        {
+            EXPECT_FALSE(jobSystem.IsMainThread() && std::this_thread::get_id() != mainThread);
+            jobSystem.RunOnMainThread([&]() { threads.push_back(std::this_thread::get_id()); }, &counter);
+        }, &counter);
+    }
+    jobSystem.Wait(counter);
+
+    ASSERT_EQ(threads.size(), 33u);
+    for (const std::thread::id& thread : threads)
+    {
+        EXPECT_EQ(thread, mainThread);
+    }
+}
+
+TEST(sge_job_system, StressRepeatedInitializeAndNestedWaits)
+{
+    for (uint32 workerCount : { 0u, 1u, 3u, 7u })
+    {
+        ScopedJobSystem scope(workerCount);
+        JobSystem& jobSystem = JobSystem::Get();
+
+        for (int32 round = 0; round < 20; ++round)
+        {
+            std::atomic<int64> total{ 0 };
+            JobCounter outer;
+            for (int32 i = 0; i < 64; ++i)
+            {
+                jobSystem.Run([&]()
+                {
+                    // Waiting inside a job helps with other jobs instead of blocking the worker.
+                    std::atomic<int64> inner{ 0 };
+                    jobSystem.ParallelFor(512, [&](size_t begin, size_t end) { inner += static_cast<int64>(end - begin); });
+                    total += inner.load();
+                }, &outer);
+            }
+            jobSystem.Wait(outer);
+            ASSERT_EQ(total.load(), 64 * 512) << "workers " << workerCount;
+        }
+    }
+}
+
+TEST(sge_job_system, WaitRethrowsJobException)
+{
+    ScopedJobSystem scope(3);
+    JobSystem& jobSystem = JobSystem::Get();
+
+    JobCounter counter;
+    std::atomic<int32> finished{ 0 };
+    for (int32 i = 0; i < 64; ++i)
+    {
+        jobSystem.Run([&finished, i]()
+        {
+            if (i % 16 == 3)
+            {
+                throw std::runtime_error("job failed");
+            }
+            finished.fetch_add(1);
+        }, &counter);
+    }
+
+    // Every job still runs and counts as done, the first exception comes out of Wait once.
+    EXPECT_THROW(jobSystem.Wait(counter), std::runtime_error);
+    EXPECT_TRUE(counter.IsDone());
+    EXPECT_EQ(finished.load(), 60);
+
+    jobSystem.Run([&]() { finished.fetch_add(1); }, &counter);
+    EXPECT_NO_THROW(jobSystem.Wait(counter));
+    EXPECT_EQ(finished.load(), 61);
+}
+
+TEST(sge_job_system, MainThreadJobExceptionReachesWait)
+{
+    ScopedJobSystem scope(2);
+    JobSystem& jobSystem = JobSystem::Get();
+
+    JobCounter counter;
+    jobSystem.Run([&]()
+    {
+        jobSystem.RunOnMainThread([]() { throw std::logic_error("main thread job failed"); }, &counter);
+    }, &counter);
+    EXPECT_THROW(jobSystem.Wait(counter), std::logic_error);
+    EXPECT_TRUE(counter.IsDone());
+}
+
+TEST(sge_job_system, InlineJobExceptionReachesWait)
+{
+    JobSystem& jobSystem = JobSystem::Get();
+    ASSERT_FALSE(jobSystem.IsInitialized());
+
+    JobCounter counter;
+    jobSystem.Run([]() { throw std::runtime_error("inline job failed"); }, &counter);
+    EXPECT_TRUE(counter.IsDone());
+    EXPECT_THROW(jobSystem.Wait(counter), std::runtime_error);
+
+    // Jobs without a counter have nobody to report to, their exception is dropped.
+    EXPECT_NO_THROW(jobSystem.Run([]() { throw std::runtime_error("dropped"); }));
+}
+
+TEST(sge_job_system, ParallelForAsyncRethrowsOnWait)
+{
+    ScopedJobSystem scope(3);
+    JobSystem& jobSystem = JobSystem::Get();
+
+    JobCounter counter;
+    std::atomic<size_t> total{ 0 };
+    std::atomic<size_t> failed{ 0 };
+    jobSystem.ParallelForAsync(1000, [&](size_t begin, size_t end)
+    {
+        if (begin <= 500 && 500 < end)
+        {
+            failed = end - begin;
+            throw std::runtime_error("chunk failed");
+        }
+        total += end - begin;
+    }, counter, 10);
+
+    // The other chunks still run.
+    EXPECT_THROW(jobSystem.Wait(counter), std::runtime_error);
+    EXPECT_GT(failed.load(), 0u);
+    EXPECT_EQ(total.load() + failed.load(), 1000u);
+}
+
+TEST(sge_job_system, CallerRunsEverythingAfterShutdown)
+{
+    JobSystem& jobSystem = JobSystem::Get();
+    jobSystem.Initialize(1);
+    jobSystem.Shutdown();
+    EXPECT_FALSE(jobSystem.IsInitialized());
+
+    size_t total = 0;
+    jobSystem.ParallelFor(10, [&](size_t begin, size_t end) { total += end - begin; }, 3);
+    EXPECT_EQ(total, 10u);
+
+    jobSystem.ParallelFor(0, [&](size_t, size_t) { total = 0; });
+    EXPECT_EQ(total, 10u);
+}
+
+TEST(sge_job_system, ParallelForRethrowsOnWait)
+{
+    for (uint32 workerCount : { 0u, 2u })
+    {
+        ScopedJobSystem scope(workerCount);
+        JobSystem& jobSystem = JobSystem::Get();
+
+        EXPECT_THROW(jobSystem.ParallelFor(64, [](size_t begin, size_t end)
+        {
+            if (begin <= 17 && 17 < end)
+            {
+                throw std::runtime_error("failed");
+            }
+        }), std::runtime_error) << "workers " << workerCount;
+
+        // The job system stays usable after a failed dispatch.
+        std::atomic<size_t> total{ 0 };
+        jobSystem.ParallelFor(64, [&](size_t begin, size_t end) { total += end - begin; });
+        EXPECT_EQ(total.load(), 64u) << "workers " << workerCount;
+    }
+}
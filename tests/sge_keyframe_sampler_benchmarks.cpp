@@ -0,0 +1,161 @@
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "data/sge_keyframe_sampler.h"
+using namespace SGE;
+
+// Sized after samples/resources/anim/human.gltf (65 bones), with long mocap-style channels.
+namespace
+{
+    constexpr size_t BONE_COUNT = 65;
+    constexpr size_t KEY_COUNT = 10000;
+    constexpr float TICKS_PER_SECOND = 30.0f;
+    constexpr float FRAME_DELTA = TICKS_PER_SECOND / 60.0f;
+
+    struct ClipFixture
+    {
+        std::vector<BoneKeyframes> channels;
+        AnimationClip clip;
+        float duration = static_cast<float>(KEY_COUNT - 1);
+
+        ClipFixture()
+        {
+            std::mt19937 generator(5);
+            std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+            channels.resize(BONE_COUNT);
+            for (BoneKeyframes& channel : channels)
+            {
+                for (size_t i = 0; i < KEY_COUNT; ++i)
+                {
+                    float time = static_cast<float>(i);
+                    channel.positionKeys.push_back({ time, float3(distribution(generator), distribution(generator), distribution(generator)) });
+                    channel.rotationKeys.push_back({ time, float4(distribution(generator), distribution(generator), distribution(generator), distribution(generator)).normalized() });
+                    channel.scaleKeys.push_back({ time, float3::One });
+                }
+            }
+
+            Animation animation;
+            animation.name = "Mocap";
+            animation.duration = duration;
+            animation.ticksPerSecond = TICKS_PER_SECOND;
+
+            std::unordered_map<std::string, int32> boneNameToIndex;
+            for (size_t i = 0; i < BONE_COUNT; ++i)
+            {
+                std::string boneName = "Bone" + std::to_string(i);
+                boneNameToIndex[boneName] = static_cast<int32>(i);
+                animation.boneKeyframes[boneName] = channels[i];
+            }
+            clip.Initialize(animation, boneNameToIndex, static_cast<int32>(BONE_COUNT));
+        }
+    };
+
+    // The pre-sampler implementation: scan from the first key on every call.
+    template<typename Keyframe>
+    size_t LinearFindSegment(const std::vector<Keyframe>& keys, float time)
+    {
+        for (size_t i = 0; i < keys.size() - 1; ++i)
+        {
+            if (time >= keys[i].time && time <= keys[i + 1].time)
+            {
+                return i;
+            }
+        }
+        return keys.size() - 2;
+    }
+
+    float AdvanceTime(float time, float duration)
+    {
+        time += FRAME_DELTA;
+        return time > duration ? std::fmod(time, duration) : time;
+    }
+}
+
+static void BM_SampleClip_LinearScan(benchmark::State& state)
+{
+    ClipFixture clip;
+    float time = 0.0f;
+
+    for (auto _ : state)
+    {
+        float3 accumulated = float3::Zero;
+        for (const BoneKeyframes& channel : clip.channels)
+        {
+            size_t p = LinearFindSegment(channel.positionKeys, time);
+            size_t r = LinearFindSegment(channel.rotationKeys, time);
+            size_t s = LinearFindSegment(channel.scaleKeys, time);
+            accumulated += channel.positionKeys[p].position + channel.scaleKeys[s].scale;
+            accumulated.x += channel.rotationKeys[r].rotation.w;
+        }
+        benchmark::DoNotOptimize(accumulated);
+        time = AdvanceTime(time, clip.duration);
+    }
+    state.SetItemsProcessed(state.iterations() * BONE_COUNT);
+}
+BENCHMARK(BM_SampleClip_LinearScan)->Unit(benchmark::kMicrosecond);
+
+static void BM_SampleClip_BinarySearch(benchmark::State& state)
+{
+    ClipFixture clip;
+    float time = 0.0f;
+
+    for (auto _ : state)
+    {
+        float3 accumulated = float3::Zero;
+        for (const BoneKeyframes& channel : clip.channels)
+        {
+            accumulated += SamplePosition(channel.positionKeys, time) + SampleScale(channel.scaleKeys, time);
+            accumulated.x += SampleRotation(channel.rotationKeys, time).w;
+        }
+        benchmark::DoNotOptimize(accumulated);
+        time = AdvanceTime(time, clip.duration);
+    }
+    state.SetItemsProcessed(state.iterations() * BONE_COUNT);
+}
+BENCHMARK(BM_SampleClip_BinarySearch)->Unit(benchmark::kMicrosecond);
+
+static void BM_SampleClip_Cursor(benchmark::State& state)
+{
+    ClipFixture clip;
+    std::vector<KeyframeCursor> cursors(BONE_COUNT);
+    float time = 0.0f;
+
+    for (auto _ : state)
+    {
+        float3 accumulated = float3::Zero;
+        for (size_t bone = 0; bone < BONE_COUNT; ++bone)
+        {
+            const BoneKeyframes& channel = clip.channels[bone];
+            KeyframeCursor& cursor = cursors[bone];
+            accumulated += SamplePosition(channel.positionKeys, time, cursor.position) + SampleScale(channel.scaleKeys, time, cursor.scale);
+            accumulated.x += SampleRotation(channel.rotationKeys, time, cursor.rotation).w;
+        }
+        benchmark::DoNotOptimize(accumulated);
+        time = AdvanceTime(time, clip.duration);
+    }
+    state.SetItemsProcessed(state.iterations() * BONE_COUNT);
+}
+BENCHMARK(BM_SampleClip_Cursor)->Unit(benchmark::kMicrosecond);
+
+static void BM_SampleClip_BakedCursor(benchmark::State& state)
+{
+    ClipFixture fixture;
+    std::vector<KeyframeCursor> cursors(BONE_COUNT);
+    float time = 0.0f;
+
+    for (auto _ : state)
+    {
+        float3 accumulated = float3::Zero;
+        for (int32 bone = 0; bone < static_cast<int32>(BONE_COUNT); ++bone)
+        {
+            BonePose pose = fixture.clip.SampleBone(bone, time, cursors[bone]);
+            accumulated += pose.position + pose.scale;
+            accumulated.x += pose.rotation.w;
+        }
+        benchmark::DoNotOptimize(accumulated);
+        time = AdvanceTime(time, fixture.duration);
+    }
+    state.SetItemsProcessed(state.iterations() * BONE_COUNT);
+}
+BENCHMARK(BM_SampleClip_BakedCursor)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,124 @@
+#include <random>
+#include <gtest/gtest.h>
+#include "data/sge_keyframe_sampler.h"
+using namespace SGE;
+
+namespace
+{
+    std::vector<PositionKeyframe> MakePositionKeys(size_t count, float step = 1.0f)
+    {
+        std::vector<PositionKeyframe> keys(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            float time = static_cast<float>(i) * step;
+            keys[i] = { time, float3(time, 2.0f * time, -time) };
+        }
+        return keys;
+    }
+
+    // Straight scan over every segment, the behaviour the sampler replaces.
+    uint32 LinearFindSegment(const std::vector<PositionKeyframe>& keys, float time)
+    {
+        for (uint32 i = 0; i + 2 < keys.size(); ++i)
+        {
+            if (time < keys[i + 1].time)
+            {
+                return i;
+            }
+        }
+        return static_cast<uint32>(keys.size()) - 2;
+    }
+}
+
+TEST(sge_keyframe_sampler, BinarySearchMatchesLinearScan)
+{
+    std::vector<PositionKeyframe> keys = MakePositionKeys(257, 0.5f);
+    for (float time = -1.0f; time < 130.0f; time += 0.37f)
+    {
+        EXPECT_EQ(FindKeyframeSegment(keys, time), LinearFindSegment(keys, time)) << "time " << time;
+    }
+}
+
+TEST(sge_keyframe_sampler, CursorFollowsPlayback)
+{
+    std::vector<PositionKeyframe> keys = MakePositionKeys(100);
+    uint32 cursor = 0;
+
+    for (float time = 0.0f; time < 99.0f; time += 0.25f)
+    {
+        EXPECT_EQ(FindKeyframeSegment(keys, time, cursor), LinearFindSegment(keys, time));
+        EXPECT_EQ(cursor, LinearFindSegment(keys, time));
+    }
+}
+
+TEST(sge_keyframe_sampler, CursorHandlesSeeksAndLoopWrap)
+{
+    std::vector<PositionKeyframe> keys = MakePositionKeys(1000);
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<float> distribution(-5.0f, 1005.0f);
+    uint32 cursor = 0;
+
+    // Loop wrap: from the end of the clip straight back to the start.
+    FindKeyframeSegment(keys, 998.5f, cursor);
+    EXPECT_EQ(cursor, 998u);
+    EXPECT_EQ(FindKeyframeSegment(keys, 0.5f, cursor), 0u);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        float time = distribution(generator);
+        EXPECT_EQ(FindKeyframeSegment(keys, time, cursor), LinearFindSegment(keys, time)) << "time " << time;
+    }
+}
+
+TEST(sge_keyframe_sampler, SampleInterpolatesAndClamps)
+{
+    std::vector<PositionKeyframe> keys = MakePositionKeys(4);
+    uint32 cursor = 0;
+
+    EXPECT_EQ(SamplePosition(keys, 1.5f, cursor), float3(1.5f, 3.0f, -1.5f));
+    EXPECT_EQ(SamplePosition(keys, 1.5f), float3(1.5f, 3.0f, -1.5f));
+    EXPECT_EQ(SamplePosition(keys, -2.0f, cursor), keys.front().position);
+    EXPECT_EQ(SamplePosition(keys, 10.0f, cursor), keys.back().position);
+}
+
+TEST(sge_keyframe_sampler, SampleEmptyAndSingleKeyChannels)
+{
+    uint32 cursor = 0;
+
+    EXPECT_EQ(SamplePosition({}, 1.0f, cursor), float3::Zero);
+    EXPECT_EQ(SampleScale({}, 1.0f, cursor), float3::One);
+    EXPECT_EQ(SampleRotation({}, 1.0f, cursor), float4::Identity);
+
+    std::vector<RotationKeyframe> rotation = { { 0.0f, float4(0.0f, 1.0f, 0.0f, 0.0f) } };
+    EXPECT_EQ(SampleRotation(rotation, 5.0f, cursor), rotation[0].rotation);
+}
+
+TEST(sge_keyframe_sampler, SampleRotationSlerps)
+{
+    const float halfAngle = ConvertToRadians(45.0f);
+    std::vector<RotationKeyframe> keys =
+    {
+        { 0.0f, float4::Identity },
+        { 1.0f, float4(0.0f, std::sin(halfAngle), 0.0f, std::cos(halfAngle)) }
+    };
+
+    float4 halfway = SampleRotation(keys, 0.5f);
+    const float quarterAngle = ConvertToRadians(22.5f);
+    EXPECT_NEAR(halfway.y, std::sin(quarterAngle), 1e-5f);
+    EXPECT_NEAR(halfway.w, std::cos(quarterAngle), 1e-5f);
+}
+
+TEST(sge_keyframe_sampler, DuplicateKeyTimes)
+{
+    std::vector<ScaleKeyframe> keys =
+    {
+        { 0.0f, float3(1.0f, 1.0f, 1.0f) },
+        { 1.0f, float3(2.0f, 2.0f, 2.0f) },
+        { 1.0f, float3(3.0f, 3.0f, 3.0f) },
+        { 2.0f, float3(4.0f, 4.0f, 4.0f) }
+    };
+    uint32 cursor = 0;
+
+    EXPECT_EQ(SampleScale(keys, 0.5f, cursor), float3(1.5f, 1.5f, 1.5f));
+    EXPECT_EQ(SampleScale(keys, 1.5f, cursor), float3(3.5f, 3.5f, 3.5f));
+}
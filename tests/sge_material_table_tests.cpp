@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "core/sge_descriptor_allocator.h"
+#include "data/sge_material_table.h"
+using namespace SGE;
+
+TEST(sge_descriptor_allocator, AllocatesTheRangeInOrder)
+{
+    DescriptorAllocator allocator;
+    allocator.Initialize(100, 3);
+
+    EXPECT_EQ(allocator.Allocate(), 100u);
+    EXPECT_EQ(allocator.Allocate(), 101u);
+    EXPECT_EQ(allocator.Allocate(), 102u);
+    EXPECT_EQ(allocator.Allocate(), INVALID_DESCRIPTOR_INDEX);
+    EXPECT_EQ(allocator.GetAllocatedCount(), 3u);
+    EXPECT_EQ(allocator.GetUsedRange(), 3u);
+}
+
+TEST(sge_descriptor_allocator, ReusesFreedIndicesLowestFirst)
+{
+    DescriptorAllocator allocator;
+    allocator.Initialize(10, 8);
+    for (uint32 i = 0; i < 5; ++i)
+    {
+        allocator.Allocate();
+    }
+
+    EXPECT_TRUE(allocator.Free(13));
+    EXPECT_TRUE(allocator.Free(11));
+    EXPECT_FALSE(allocator.Free(11));
+    EXPECT_FALSE(allocator.Free(9));
+    EXPECT_FALSE(allocator.Free(17));
+    EXPECT_FALSE(allocator.IsAllocated(11));
+    EXPECT_EQ(allocator.GetAllocatedCount(), 3u);
+
+    EXPECT_EQ(allocator.Allocate(), 11u);
+    EXPECT_EQ(allocator.Allocate(), 13u);
+    EXPECT_EQ(allocator.Allocate(), 15u);
+    EXPECT_EQ(allocator.GetUsedRange(), 6u);
+    EXPECT_TRUE(allocator.IsAllocated(15));
+}
+
+TEST(sge_material_table, PacksTexturesRelativeToTheRange)
+{
+    MaterialTable table;
+    table.Initialize(512, 64);
+
+    const uint32 first = table.Add({ 512, 513, 514, 515 });
+    const uint32 second = table.Add({ 520, 575, 512, 530 });
+    ASSERT_EQ(first, 0u);
+    ASSERT_EQ(second, 1u);
+
+    const MaterialGpuData& data = table.GetEntries()[second];
+    EXPECT_EQ(data.albedoTexture, 8u);
+    EXPECT_EQ(data.normalTexture, 63u);
+    EXPECT_EQ(data.metallicTexture, 0u);
+    EXPECT_EQ(data.roughnessTexture, 18u);
+
+    EXPECT_EQ(table.Add({ 511, 513, 514, 515 }), INVALID_MATERIAL_INDEX);
+    EXPECT_EQ(table.Add({ 512, 513, 576, 515 }), INVALID_MATERIAL_INDEX);
+    EXPECT_EQ(table.GetCount(), 2u);
+}
+
+TEST(sge_material_table, TracksTheChangedRange)
+{
+    MaterialTable table;
+    table.Initialize(0, 16);
+    EXPECT_FALSE(table.HasChanges());
+
+    for (uint32 i = 0; i < 4; ++i)
+    {
+        table.Add({ i, i, i, i });
+    }
+    EXPECT_TRUE(table.HasChanges());
+    EXPECT_EQ(table.GetDirtyBegin(), 0u);
+    EXPECT_EQ(table.GetDirtyEnd(), 4u);
+
+    table.ClearChanges();
+    EXPECT_TRUE(table.Set(2, { 9, 9, 9, 9 }));
+    EXPECT_TRUE(table.Set(1, { 8, 8, 8, 8 }));
+    EXPECT_FALSE(table.Set(4, { 8, 8, 8, 8 }));
+    EXPECT_FALSE(table.Set(3, { 16, 8, 8, 8 }));
+    EXPECT_EQ(table.GetDirtyBegin(), 1u);
+    EXPECT_EQ(table.GetDirtyEnd(), 3u);
+    EXPECT_EQ(table.GetEntries()[2].roughnessTexture, 9u);
+    EXPECT_EQ(table.GetEntries()[3].albedoTexture, 3u);
+}
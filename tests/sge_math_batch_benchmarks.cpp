@@ -0,0 +1,125 @@
+#include <random>
+#include <benchmark/benchmark.h>
+#include "core/sge_math_batch.h"
+using namespace SGE;
+
+namespace
+{
+    struct TRSBatch
+    {
+        float3_soa positions;
+        float4_soa rotations;
+        float3_soa scales;
+    };
+
+    TRSBatch MakeTRSBatch(size_t count)
+    {
+        std::mt19937 generator(7);
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+        TRSBatch batch;
+        for (size_t i = 0; i < count; ++i)
+        {
+            batch.positions.push_back(float3(distribution(generator), distribution(generator), distribution(generator)) * 100.0f);
+            batch.rotations.push_back(float4(distribution(generator), distribution(generator), distribution(generator), distribution(generator)).normalized());
+            batch.scales.push_back(float3(1.0f, 1.0f, 1.0f));
+        }
+        return batch;
+    }
+}
+
+static void BM_ComposeTRS_PerInstance(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    TRSBatch batch = MakeTRSBatch(count);
+    float4x4_array out(count);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = CreateTranslationMatrix(batch.positions.get(i)) *
+                     CreateRotationMatrixFromQuaternion(batch.rotations.get(i)) *
+                     CreateScaleMatrix(batch.scales.get(i));
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ComposeTRS_PerInstance)->Arg(256)->Arg(4096);
+
+static void BM_ComposeTRS_Batch(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    TRSBatch batch = MakeTRSBatch(count);
+    float4x4_array out(count);
+
+    for (auto _ : state)
+    {
+        ComposeTRS(batch.positions, batch.rotations, batch.scales, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetLabel(GetSimdInstructionSetName());
+}
+BENCHMARK(BM_ComposeTRS_Batch)->Arg(256)->Arg(4096);
+
+static void BM_TransformPoints_PerPoint(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    TRSBatch batch = MakeTRSBatch(count);
+    float4x4 m = CreateTranslationMatrix(float3(1.0f, 2.0f, 3.0f)) * CreateRotationMatrixFromQuaternion(batch.rotations.get(0));
+    std::vector<float4> out(count);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            float3 p = batch.positions.get(i);
+            out[i] = m * float4(p.x, p.y, p.z, 1.0f);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_TransformPoints_PerPoint)->Arg(4096);
+
+static void BM_TransformPoints_Batch(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    TRSBatch batch = MakeTRSBatch(count);
+    float4x4 m = CreateTranslationMatrix(float3(1.0f, 2.0f, 3.0f)) * CreateRotationMatrixFromQuaternion(batch.rotations.get(0));
+    float3_soa out;
+
+    for (auto _ : state)
+    {
+        TransformPoints(m, batch.positions, out);
+        benchmark::DoNotOptimize(out.x.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetLabel(GetSimdInstructionSetName());
+}
+BENCHMARK(BM_TransformPoints_Batch)->Arg(4096);
+
+static void BM_MultiplyMatrices_Batch(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    TRSBatch batch = MakeTRSBatch(count);
+    float4x4_array local(count), world(count);
+    ComposeTRS(batch.positions, batch.rotations, batch.scales, local);
+    float4x4 parent = CreateTranslationMatrix(float3(0.0f, 1.0f, 0.0f));
+
+    for (auto _ : state)
+    {
+        MultiplyMatrices(parent, local, world);
+        benchmark::DoNotOptimize(world.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetLabel(GetSimdInstructionSetName());
+}
+BENCHMARK(BM_MultiplyMatrices_Batch)->Arg(4096);
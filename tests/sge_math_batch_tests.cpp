@@ -0,0 +1,159 @@
+#include <random>
+#include <gtest/gtest.h>
+#include "core/sge_math_batch.h"
+using namespace SGE;
+
+namespace
+{
+    // 37 is deliberately not a multiple of any lane width, so the scalar tail runs too.
+    constexpr size_t BATCH_SIZE = 37;
+
+    float RandomFloat(std::mt19937& generator, float minValue = -2.0f, float maxValue = 2.0f)
+    {
+        return std::uniform_real_distribution<float>(minValue, maxValue)(generator);
+    }
+
+    float3 RandomFloat3(std::mt19937& generator)
+    {
+        return float3(RandomFloat(generator), RandomFloat(generator), RandomFloat(generator));
+    }
+
+    float4 RandomQuaternion(std::mt19937& generator)
+    {
+        return float4(RandomFloat(generator), RandomFloat(generator), RandomFloat(generator), RandomFloat(generator)).normalized();
+    }
+
+    void ExpectMatrixNear(const float4x4& actual, const float4x4& expected, float tolerance = 1e-5f)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            EXPECT_NEAR(actual.m[i], expected.m[i], tolerance) << "Element at index " << i << " is incorrect!";
+        }
+    }
+}
+
+TEST(sge_math_batch, Float3SoaAccessors)
+{
+    float3_soa soa;
+    soa.push_back(float3(1.0f, 2.0f, 3.0f));
+    soa.push_back(float3(4.0f, 5.0f, 6.0f));
+
+    EXPECT_EQ(soa.size(), 2u);
+    EXPECT_EQ(soa.get(1), float3(4.0f, 5.0f, 6.0f));
+
+    soa.set(0, float3(7.0f, 8.0f, 9.0f));
+    EXPECT_EQ(soa.x[0], 7.0f);
+    EXPECT_EQ(soa.y[0], 8.0f);
+    EXPECT_EQ(soa.z[0], 9.0f);
+}
+
+TEST(sge_math_batch, MultiplyMatricesMatchesScalar)
+{
+    std::mt19937 generator(1);
+    float4x4_array a(BATCH_SIZE), b(BATCH_SIZE), out(BATCH_SIZE);
+    for (size_t i = 0; i < BATCH_SIZE; ++i)
+    {
+        for (int e = 0; e < 16; ++e)
+        {
+            a[i].m[e] = RandomFloat(generator);
+            b[i].m[e] = RandomFloat(generator);
+        }
+    }
+
+    MultiplyMatrices(a, b, out);
+
+    for (size_t i = 0; i < BATCH_SIZE; ++i)
+    {
+        ExpectMatrixNear(out[i], a[i] * b[i]);
+    }
+}
+
+TEST(sge_math_batch, MultiplyMatricesByCommonMatrixInPlace)
+{
+    std::mt19937 generator(2);
+    float4x4 lhs = CreateTranslationMatrix(RandomFloat3(generator)) * CreateRotationMatrixFromQuaternion(RandomQuaternion(generator));
+
+    float4x4_array matrices(BATCH_SIZE);
+    float4x4_array expected(BATCH_SIZE);
+    for (size_t i = 0; i < BATCH_SIZE; ++i)
+    {
+        matrices[i] = CreateScaleMatrix(RandomFloat3(generator));
+        expected[i] = lhs * matrices[i];
+    }
+
+    MultiplyMatrices(lhs, matrices, matrices);
+
+    for (size_t i = 0; i < BATCH_SIZE; ++i)
+    {
+        ExpectMatrixNear(matrices[i], expected[i]);
+    }
+}
+
+TEST(sge_math_batch, TransformPointsAndDirections)
+{
+    std::mt19937 generator(3);
+    float4x4 m = CreateTranslationMatrix(float3(1.0f, -2.0f, 3.0f)) * CreateRotationMatrixFromQuaternion(RandomQuaternion(generator));
+
+    float3_soa points;
+    for (size_t i = 0; i < BATCH_SIZE; ++i)
+    {
+        points.push_back(RandomFloat3(generator));
+    }
+
+    float3_soa transformedPoints;
+    float3_soa transformedDirections;
+    TransformPoints(m, points, transformedPoints);
+    TransformDirections(m, points, transformedDirections);
+
+    ASSERT_EQ(transformedPoints.size(), BATCH_SIZE);
+    ASSERT_EQ(transformedDirections.size(), BATCH_SIZE);
+
+    for (size_t i = 0; i < BATCH_SIZE; ++i)
+    {
+        float3 p = points.get(i);
+        float4 point = m * float4(p.x, p.y, p.z, 1.0f);
+        float4 direction = m * float4(p.x, p.y, p.z, 0.0f);
+
+        EXPECT_NEAR(transformedPoints.x[i], point.x, 1e-5f);
+        EXPECT_NEAR(transformedPoints.y[i], point.y, 1e-5f);
+        EXPECT_NEAR(transformedPoints.z[i], point.z, 1e-5f);
+        EXPECT_NEAR(transformedDirections.x[i], direction.x, 1e-5f);
+        EXPECT_NEAR(transformedDirections.y[i], direction.y, 1e-5f);
+        EXPECT_NEAR(transformedDirections.z[i], direction.z, 1e-5f);
+    }
+}
+
+TEST(sge_math_batch, ComposeTRSMatchesMatrixProduct)
+{
+    std::mt19937 generator(4);
+    float3_soa positions, scales;
+    float4_soa rotations;
+
+    for (size_t i = 0; i < BATCH_SIZE; ++i)
+    {
+        positions.push_back(RandomFloat3(generator));
+        rotations.push_back(RandomQuaternion(generator));
+        scales.push_back(RandomFloat3(generator));
+    }
+
+    float4x4_array out(BATCH_SIZE);
+    ComposeTRS(positions, rotations, scales, out);
+
+    for (size_t i = 0; i < BATCH_SIZE; ++i)
+    {
+        float4x4 expected = CreateTranslationMatrix(positions.get(i)) *
+                            CreateRotationMatrixFromQuaternion(rotations.get(i)) *
+                            CreateScaleMatrix(scales.get(i));
+        ExpectMatrixNear(out[i], expected);
+    }
+}
+
+TEST(sge_math_batch, QuaternionYawPitchRollMatchesEulerMatrix)
+{
+    float yaw = ConvertToRadians(30.0f);
+    float pitch = ConvertToRadians(-45.0f);
+    float roll = ConvertToRadians(60.0f);
+
+    ExpectMatrixNear(CreateRotationMatrixFromQuaternion(CreateQuaternionYawPitchRoll(yaw, pitch, roll)),
+                     CreateRotationMatrixYawPitchRoll(yaw, pitch, roll));
+}
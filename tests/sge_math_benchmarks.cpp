@@ -0,0 +1,216 @@
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "core/sge_math.h"
+#include "core/sge_simd.h"
+using namespace SGE;
+
+namespace
+{
+    constexpr size_t MATRIX_COUNT = 1024;
+
+    std::vector<float4x4> MakeMatrices(size_t count, uint32_t seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+
+        std::vector<float4x4> matrices(count);
+        for (float4x4& matrix : matrices)
+        {
+            for (float& value : matrix.m)
+            {
+                value = distribution(generator);
+            }
+            matrix.m30 = 0.0f; matrix.m31 = 0.0f; matrix.m32 = 0.0f; matrix.m33 = 1.0f;
+        }
+        return matrices;
+    }
+
+    // Plain scalar versions of the kernels, kept here as the baseline the SIMD path is measured against.
+    float4x4 ReferenceMultiply(const float4x4& a, const float4x4& b)
+    {
+        float4x4 result;
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int col = 0; col < 4; ++col)
+            {
+                float sum = 0.0f;
+                for (int k = 0; k < 4; ++k)
+                {
+                    sum += a.m[row * 4 + k] * b.m[k * 4 + col];
+                }
+                result.m[row * 4 + col] = sum;
+            }
+        }
+        return result;
+    }
+
+    float4 ReferenceTransform(const float4x4& m, const float4& v)
+    {
+        float4 result;
+        for (int row = 0; row < 4; ++row)
+        {
+            result[row] = m.m[row * 4 + 0] * v.x + m.m[row * 4 + 1] * v.y + m.m[row * 4 + 2] * v.z + m.m[row * 4 + 3] * v.w;
+        }
+        return result;
+    }
+}
+
+static void BM_Float4x4Multiply_Reference(benchmark::State& state)
+{
+    std::vector<float4x4> a = MakeMatrices(MATRIX_COUNT, 1);
+    std::vector<float4x4> b = MakeMatrices(MATRIX_COUNT, 2);
+    std::vector<float4x4> out(MATRIX_COUNT);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < MATRIX_COUNT; ++i)
+        {
+            out[i] = ReferenceMultiply(a[i], b[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MATRIX_COUNT);
+}
+BENCHMARK(BM_Float4x4Multiply_Reference);
+
+static void BM_Float4x4Multiply(benchmark::State& state)
+{
+    std::vector<float4x4> a = MakeMatrices(MATRIX_COUNT, 1);
+    std::vector<float4x4> b = MakeMatrices(MATRIX_COUNT, 2);
+    std::vector<float4x4> out(MATRIX_COUNT);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < MATRIX_COUNT; ++i)
+        {
+            out[i] = a[i] * b[i];
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MATRIX_COUNT);
+    state.SetLabel(GetSimdInstructionSetName());
+}
+BENCHMARK(BM_Float4x4Multiply);
+
+static void BM_Float4x4Inverse(benchmark::State& state)
+{
+    std::vector<float4x4> a = MakeMatrices(MATRIX_COUNT, 3);
+    std::vector<float4x4> out(MATRIX_COUNT);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < MATRIX_COUNT; ++i)
+        {
+            out[i] = a[i].inverse();
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MATRIX_COUNT);
+    state.SetLabel(GetSimdInstructionSetName());
+}
+BENCHMARK(BM_Float4x4Inverse);
+
+static void BM_Float4x4Transpose(benchmark::State& state)
+{
+    std::vector<float4x4> a = MakeMatrices(MATRIX_COUNT, 4);
+    std::vector<float4x4> out(MATRIX_COUNT);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < MATRIX_COUNT; ++i)
+        {
+            out[i] = a[i].transposed();
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MATRIX_COUNT);
+    state.SetLabel(GetSimdInstructionSetName());
+}
+BENCHMARK(BM_Float4x4Transpose);
+
+static void BM_Float4x4TransformVector_Reference(benchmark::State& state)
+{
+    std::vector<float4x4> a = MakeMatrices(MATRIX_COUNT, 5);
+    std::vector<float4> out(MATRIX_COUNT);
+    const float4 vec(1.0f, 2.0f, 3.0f, 1.0f);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < MATRIX_COUNT; ++i)
+        {
+            out[i] = ReferenceTransform(a[i], vec);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MATRIX_COUNT);
+}
+BENCHMARK(BM_Float4x4TransformVector_Reference);
+
+static void BM_Float4x4TransformVector(benchmark::State& state)
+{
+    std::vector<float4x4> a = MakeMatrices(MATRIX_COUNT, 5);
+    std::vector<float4> out(MATRIX_COUNT);
+    const float4 vec(1.0f, 2.0f, 3.0f, 1.0f);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < MATRIX_COUNT; ++i)
+        {
+            out[i] = a[i] * vec;
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MATRIX_COUNT);
+    state.SetLabel(GetSimdInstructionSetName());
+}
+BENCHMARK(BM_Float4x4TransformVector);
+
+static void BM_QuaternionToMatrix(benchmark::State& state)
+{
+    std::mt19937 generator(6);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    std::vector<float4> quaternions(MATRIX_COUNT);
+    for (float4& q : quaternions)
+    {
+        q = float4(distribution(generator), distribution(generator), distribution(generator), distribution(generator)).normalized();
+    }
+    std::vector<float4x4> out(MATRIX_COUNT);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < MATRIX_COUNT; ++i)
+        {
+            out[i] = CreateRotationMatrixFromQuaternion(quaternions[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * MATRIX_COUNT);
+    state.SetLabel(GetSimdInstructionSetName());
+}
+BENCHMARK(BM_QuaternionToMatrix);
+
+static void BM_ComposeWorldMatrix(benchmark::State& state)
+{
+    const float3 position(1.0f, 2.0f, 3.0f);
+    const float3 rotation(15.0f, 30.0f, 45.0f);
+    const float3 scale(1.0f, 2.0f, 1.0f);
+
+    for (auto _ : state)
+    {
+        float4x4 world = CreateTranslationMatrix(position) *
+                         CreateRotationMatrixYawPitchRoll(ConvertToRadians(rotation.x), ConvertToRadians(rotation.y), ConvertToRadians(rotation.z)) *
+                         CreateScaleMatrix(scale);
+        benchmark::DoNotOptimize(world);
+    }
+    state.SetLabel(GetSimdInstructionSetName());
+}
+BENCHMARK(BM_ComposeWorldMatrix);
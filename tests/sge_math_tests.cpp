@@ -1,5 +1,6 @@
 #include <iostream>
 #include <iomanip>
+#include <type_traits>
 #include <gtest/gtest.h>
 #include "core/sge_math.h"
 using namespace SGE;
@@ -1327,6 +1328,44 @@ TEST(sge_math_float4x4, InequalityOperator)
     EXPECT_TRUE(mat1 != mat2);
 }
 
+TEST(sge_math_float4x4, InverseGeneral)
+{
+    float4x4 mat(2.0f, 1.0f, 0.0f, 3.0f,
+                 0.0f, 1.0f, 4.0f, -1.0f,
+                 1.0f, 0.0f, 2.0f, 0.5f,
+                 0.0f, 2.0f, 1.0f, 1.0f);
+
+    float4x4 product = mat * mat.inverse();
+
+    for (int i = 0; i < 16; ++i)
+    {
+        EXPECT_NEAR(product.m[i], float4x4::Identity.m[i], 1e-4f) << "Element at index " << i << " is incorrect!";
+    }
+}
+
+TEST(sge_math_float4x4, InverseSingular)
+{
+    float4x4 mat(1.0f, 2.0f, 3.0f, 4.0f,
+                 2.0f, 4.0f, 6.0f, 8.0f,
+                 0.0f, 1.0f, 0.0f, 1.0f,
+                 1.0f, 0.0f, 1.0f, 0.0f);
+
+    EXPECT_TRUE(mat.inverse() == float4x4::Zero);
+}
+
+TEST(sge_math_float4x4, MultiplicationAssignmentAliasing)
+{
+    float4x4 mat(1.0f, 2.0f, 3.0f, 4.0f,
+                 5.0f, 6.0f, 7.0f, 8.0f,
+                 9.0f, 10.0f, 11.0f, 12.0f,
+                 13.0f, 14.0f, 15.0f, 16.0f);
+
+    float4x4 expected = mat * mat;
+    mat *= mat;
+
+    EXPECT_TRUE(mat == expected);
+}
+
 // --------------------------------------------------------------------------
 // Camera and Transformations
 // --------------------------------------------------------------------------
@@ -1476,4 +1515,141 @@ TEST(sge_math_float4x4, CreateOrthographicProjectionMatrix)
         EXPECT_NEAR(resultMatrix.m[i], expectedMatrix.m[i], EPSILON)
             << "Element at index " << i << " is incorrect!";
     }
-}
\ No newline at end of file
+}
+
+TEST(sge_math_float4x4, CreateRotationMatrixFromQuaternion)
+{
+    float4 quaternion = float4(0.1f, 0.7f, -0.3f, 0.5f).normalized();
+    float4x4 rotMatrix = CreateRotationMatrixFromQuaternion(quaternion);
+
+    float x = quaternion.x, y = quaternion.y, z = quaternion.z, w = quaternion.w;
+    float4x4 expectedMatrix =
+    {
+        1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y - w * z),        2.0f * (x * z + w * y),        0.0f,
+        2.0f * (x * y + w * z),        1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z - w * x),        0.0f,
+        2.0f * (x * z - w * y),        2.0f * (y * z + w * x),        1.0f - 2.0f * (x * x + y * y), 0.0f,
+        0.0f,                          0.0f,                          0.0f,                          1.0f
+    };
+
+    for (int i = 0; i < 16; ++i)
+    {
+        EXPECT_NEAR(rotMatrix.m[i], expectedMatrix.m[i], EPSILON) << "Element at index " << i << " is incorrect!";
+    }
+}
+
+TEST(sge_math_float4x4, QuaternionMatchesYawRotation)
+{
+    float angle = PI / 3.0f;
+    float4 quaternion(0.0f, std::sin(angle * 0.5f), 0.0f, std::cos(angle * 0.5f));
+
+    float4x4 fromQuaternion = CreateRotationMatrixFromQuaternion(quaternion);
+    float4x4 fromEuler = CreateRotationMatrixYawPitchRoll(angle, 0.0f, 0.0f);
+
+    EXPECT_TRUE(fromQuaternion == fromEuler);
+}
+
+// --------------------------------------------------------------------------
+// compile-time
+// --------------------------------------------------------------------------
+
+// Layout guarantees the constant buffer structures rely on when they are memcpy'd to the GPU.
+static_assert(std::is_trivially_copyable_v<float2>, "float2 must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<float3>, "float3 must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<float4>, "float4 must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<float3x3>, "float3x3 must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<float4x4>, "float4x4 must be trivially copyable");
+static_assert(std::is_nothrow_default_constructible_v<float4x4>, "float4x4 must be default constructible");
+static_assert(sizeof(float2) == 8 && sizeof(float3) == 12 && sizeof(float4) == 16, "Vector storage size changed");
+static_assert(sizeof(float4x4) == 64 && alignof(float4x4) == 16, "float4x4 storage layout changed");
+
+TEST(sge_math_constexpr, VectorArithmetic)
+{
+    constexpr float3 a(1.0f, 2.0f, 3.0f);
+    constexpr float3 b(4.0f, 5.0f, 6.0f);
+
+    static_assert(dot(a, b) == 32.0f, "dot");
+    static_assert(cross(float3(1.0f, 0.0f, 0.0f), float3(0.0f, 1.0f, 0.0f)) == float3(0.0f, 0.0f, 1.0f), "cross");
+    static_assert(lerp(a, b, 0.5f) == float3(2.5f, 3.5f, 4.5f), "lerp");
+    static_assert(a + b == float3(5.0f, 7.0f, 9.0f), "addition");
+    static_assert(b - a == float3(3.0f, 3.0f, 3.0f), "subtraction");
+    static_assert(-a * 2.0f == float3(-2.0f, -4.0f, -6.0f), "negation and scaling");
+    static_assert(float3::Zero + float3::One == float3::One, "constants");
+    static_assert(float2(1.0f, 2.0f) + float2::Zero == float2(1.0f, 2.0f), "float2");
+    static_assert(dot(float4::Identity, float4(1.0f, 2.0f, 3.0f, 4.0f)) == 4.0f, "float4 dot");
+
+    constexpr float3 accumulated = []()
+    {
+        float3 value = float3::Zero;
+        value += float3(1.0f, 1.0f, 1.0f);
+        value *= 3.0f;
+        value -= float3(1.0f, 0.0f, 0.0f);
+        return value;
+    }();
+    static_assert(accumulated == float3(2.0f, 3.0f, 3.0f), "compound assignment");
+
+    EXPECT_EQ(accumulated, float3(2.0f, 3.0f, 3.0f));
+}
+
+TEST(sge_math_constexpr, MatrixConstruction)
+{
+    constexpr float4x4 translation = CreateTranslationMatrix(float3(1.0f, 2.0f, 3.0f));
+    constexpr float4x4 scale = CreateScaleMatrix(float3(2.0f, 2.0f, 2.0f));
+
+    static_assert(translation.m03 == 1.0f && translation.m13 == 2.0f && translation.m23 == 3.0f, "translation column");
+    static_assert(scale.determinant() == 8.0f, "scale determinant");
+    static_assert(float4x4::Identity.determinant() == 1.0f, "identity determinant");
+    static_assert(float4x4::Identity * 2.0f == float4x4::Identity + float4x4::Identity, "scalar arithmetic");
+    static_assert(float3x3::Identity * float3(1.0f, 2.0f, 3.0f) == float3(1.0f, 2.0f, 3.0f), "float3x3 transform");
+    static_assert(float3x3(2.0f, 0.0f, 0.0f, 0.0f, 4.0f, 0.0f, 0.0f, 0.0f, 8.0f).inverse() == float3x3(0.5f, 0.0f, 0.0f, 0.0f, 0.25f, 0.0f, 0.0f, 0.0f, 0.125f), "float3x3 inverse");
+    static_assert(float2x2(1.0f, 2.0f, 3.0f, 4.0f).transposed() == float2x2(1.0f, 3.0f, 2.0f, 4.0f), "float2x2 transpose");
+
+    EXPECT_EQ(translation * scale, CreateTranslationMatrix(float3(1.0f, 2.0f, 3.0f)) * CreateScaleMatrix(float3(2.0f, 2.0f, 2.0f)));
+}
+
+TEST(sge_math_quaternion, MatrixRoundTrip)
+{
+    const float4 rotations[] =
+    {
+        float4::Identity,
+        CreateQuaternionYawPitchRoll(0.3f, -1.2f, 2.5f),
+        CreateQuaternionYawPitchRoll(3.1f, 0.0f, 0.0f),
+        CreateQuaternionYawPitchRoll(0.0f, 3.1f, 0.0f),
+        CreateQuaternionYawPitchRoll(0.0f, 0.0f, 3.1f)
+    };
+
+    for (const float4& rotation : rotations)
+    {
+        float4 result = CreateQuaternionFromRotationMatrix(CreateRotationMatrixFromQuaternion(rotation));
+        EXPECT_NEAR(std::abs(dot(result, rotation)), 1.0f, 1e-5f);
+    }
+}
+
+TEST(sge_math_quaternion, DecomposeMatrix)
+{
+    const float3 translation(1.0f, -2.0f, 3.0f);
+    const float4 rotation = CreateQuaternionYawPitchRoll(0.5f, 0.25f, -0.75f);
+    const float3 scale(2.0f, 0.5f, 1.5f);
+
+    float3 outTranslation, outScale;
+    float4 outRotation;
+    DecomposeMatrix(CreateTranslationMatrix(translation) * CreateRotationMatrixFromQuaternion(rotation) * CreateScaleMatrix(scale), outTranslation, outRotation, outScale);
+
+    EXPECT_EQ(outTranslation, translation);
+    EXPECT_EQ(outScale, scale);
+    EXPECT_NEAR(std::abs(dot(outRotation, rotation)), 1.0f, 1e-5f);
+}
+
+TEST(sge_math_quaternion, MultiplyAndNlerp)
+{
+    const float4 yaw = CreateQuaternionYawPitchRoll(0.4f, 0.0f, 0.0f);
+    const float4 pitch = CreateQuaternionYawPitchRoll(0.0f, 0.7f, 0.0f);
+
+    EXPECT_EQ(CreateRotationMatrixFromQuaternion(MultiplyQuaternions(yaw, pitch)), CreateRotationMatrixFromQuaternion(yaw) * CreateRotationMatrixFromQuaternion(pitch));
+    EXPECT_EQ(MultiplyQuaternions(float4::Identity, yaw), yaw);
+
+    // Takes the short arc even when the target is in the opposite hemisphere.
+    float4 halfway = nlerp(yaw, -pitch, 0.5f);
+    EXPECT_NEAR(length(halfway), 1.0f, 1e-5f);
+    EXPECT_GT(dot(halfway, yaw), 0.0f);
+    EXPECT_NEAR(std::abs(dot(halfway, slerp(yaw, pitch, 0.5f))), 1.0f, 1e-4f);
+}
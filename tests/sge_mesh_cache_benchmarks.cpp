@@ -0,0 +1,92 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <benchmark/benchmark.h>
+#include "data/sge_mesh_cache.h"
+using namespace SGE;
+
+// Loading a cooked model of 256k vertices. The mapped load hands the vertex and index arrays to
+// the asset in place; the stream baseline reads the same file into owned arrays, which is what
+// loading cost on top of the parse before the cache.
+namespace
+{
+    constexpr uint32 GRID_SIZE = 512;
+
+    std::string GetBenchmarkCachePath()
+    {
+        static const std::string path = []()
+        {
+            std::vector<Vertex> vertices(GRID_SIZE * GRID_SIZE, Vertex{});
+            for (uint32 i = 0; i < vertices.size(); ++i)
+            {
+                vertices[i].position = float3(static_cast<float>(i % GRID_SIZE), 0.0f, static_cast<float>(i / GRID_SIZE));
+                vertices[i].normal = float3(0.0f, 1.0f, 0.0f);
+            }
+
+            std::vector<uint32> indices;
+            for (uint32 y = 0; y + 1 < GRID_SIZE; ++y)
+            {
+                for (uint32 x = 0; x + 1 < GRID_SIZE; ++x)
+                {
+                    uint32 i = y * GRID_SIZE + x;
+                    indices.insert(indices.end(), { i, i + GRID_SIZE, i + 1, i + 1, i + GRID_SIZE, i + GRID_SIZE + 1 });
+                }
+            }
+
+            std::vector<Mesh> meshes = { Mesh(vertices, indices) };
+            ModelAsset asset;
+            asset.Initialize(meshes);
+
+            std::string cachePath = (std::filesystem::temp_directory_path() / "sge_mesh_cache_benchmark.sgemesh").string();
+            MeshCache::Write(cachePath, 1, asset);
+            return cachePath;
+        }();
+        return path;
+    }
+
+    // Touches one value per page, so both variants pay for bringing the data in.
+    float TouchVertices(Span<const PackedVertex> vertices)
+    {
+        float sum = 0.0f;
+        for (size_t i = 0; i < vertices.size(); i += 4096 / sizeof(PackedVertex))
+        {
+            sum += vertices[i].position.x;
+        }
+        return sum;
+    }
+}
+
+static void BM_MeshCache_LoadMapped(benchmark::State& state)
+{
+    const std::string path = GetBenchmarkCachePath();
+
+    for (auto _ : state)
+    {
+        std::unique_ptr<ModelAsset> asset = MeshCache::LoadModel(path, 1);
+        benchmark::DoNotOptimize(TouchVertices(asset->GetVertices()));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(std::filesystem::file_size(path)));
+}
+BENCHMARK(BM_MeshCache_LoadMapped)->Unit(benchmark::kMicrosecond);
+
+static void BM_MeshCache_LoadStreamCopy(benchmark::State& state)
+{
+    const std::string path = GetBenchmarkCachePath();
+    const size_t fileSize = static_cast<size_t>(std::filesystem::file_size(path));
+
+    for (auto _ : state)
+    {
+        std::vector<uint8> bytes(fileSize);
+        std::ifstream file(path, std::ios::binary);
+        file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(fileSize));
+
+        MeshCacheHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        const MeshCacheSectionRange& vertexRange = header.sections[static_cast<size_t>(MeshCacheSection::Vertices)];
+        std::vector<PackedVertex> vertices(vertexRange.size / sizeof(PackedVertex));
+        std::memcpy(vertices.data(), bytes.data() + vertexRange.offset, vertexRange.size);
+        benchmark::DoNotOptimize(TouchVertices(vertices));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(fileSize));
+}
+BENCHMARK(BM_MeshCache_LoadStreamCopy)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,295 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include "data/sge_mesh_cache.h"
+using namespace SGE;
+
+namespace
+{
+    constexpr uint64 SOURCE_KEY = 0x1234;
+
+    std::string GetTempPath(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / ("sge_mesh_cache_" + name)).string();
+    }
+
+    Mesh MakeQuad(float z)
+    {
+        std::vector<Vertex> vertices(4, Vertex{});
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            vertices[i].position = float3(static_cast<float>(i & 1), static_cast<float>(i >> 1), z);
+            vertices[i].normal = float3(0.0f, 0.0f, -1.0f);
+            vertices[i].boneIndices[0] = static_cast<int32>(i % 3);
+            vertices[i].boneWeights[0] = 1.0f;
+        }
+        return Mesh(vertices, { 0, 2, 1, 1, 2, 3 });
+    }
+
+    std::vector<Mesh> MakeMeshes()
+    {
+        return { MakeQuad(0.0f), MakeQuad(1.0f) };
+    }
+
+    Skeleton MakeSkeleton()
+    {
+        Skeleton skeleton;
+        for (int32 i = 0; i < 3; ++i)
+        {
+            skeleton.AddBone("Bone" + std::to_string(i), i, CreateTranslationMatrix(float3(0.0f, static_cast<float>(i), 0.0f)));
+            skeleton.GetBone(i).parentIndex = i - 1;
+            skeleton.GetBone(i).transform = float4x4::Identity;
+        }
+        skeleton.GetBone(0).children = { 1 };
+        skeleton.GetBone(1).children = { 2 };
+        skeleton.GetBone(2).weights = { 0.0f, 1.0f, 0.5f };
+        return skeleton;
+    }
+
+    Animation MakeAnimation()
+    {
+        Animation animation;
+        animation.name = "Wave";
+        animation.duration = 2.0f;
+        animation.ticksPerSecond = 30.0f;
+
+        BoneKeyframes& keys = animation.boneKeyframes["Bone1"];
+        keys.positionKeys = { { 0.0f, float3(0.0f, 1.0f, 0.0f) }, { 2.0f, float3(1.0f, 1.0f, 0.0f) } };
+        keys.rotationKeys = { { 0.0f, float4::Identity }, { 1.0f, float4(0.0f, 0.70710677f, 0.0f, 0.70710677f) } };
+        return animation;
+    }
+
+    class ScopedFile
+    {
+    public:
+        explicit ScopedFile(std::string path) : path(std::move(path)) {}
+        ~ScopedFile() { std::error_code error; std::filesystem::remove(path, error); }
+        std::string path;
+    };
+}
+
+TEST(sge_mesh_cache, RoundTripsStaticModel)
+{
+    ScopedFile file(GetTempPath("static.sgemesh"));
+    std::vector<Mesh> meshes = MakeMeshes();
+    ModelAsset source;
+    source.Initialize(meshes);
+
+    // Every mesh starts at its own range of the shared index array.
+    ASSERT_EQ(source.GetMeshInfos().size(), 2u);
+    EXPECT_EQ(source.GetMeshInfos()[1].indexCountOffset, 6u);
+    EXPECT_EQ(source.GetMeshInfos()[1].vertexCountOffset, 4u);
+    EXPECT_EQ(source.GetIndices()[6], 4u);
+
+    ASSERT_TRUE(MeshCache::Write(file.path, SOURCE_KEY, source));
+    std::unique_ptr<ModelAsset> loaded = MeshCache::LoadModel(file.path, SOURCE_KEY);
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_TRUE(loaded->IsMapped());
+    EXPECT_FALSE(source.IsMapped());
+
+    ASSERT_EQ(loaded->GetVertices().size(), source.GetVertices().size());
+    ASSERT_EQ(loaded->GetIndices().size(), source.GetIndices().size());
+    EXPECT_EQ(std::memcmp(loaded->GetVertices().data(), source.GetVertices().data(), source.GetVertices().size_bytes()), 0);
+    EXPECT_EQ(std::memcmp(loaded->GetIndices().data(), source.GetIndices().data(), source.GetIndices().size_bytes()), 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(loaded->GetVertices().data()) % alignof(PackedVertex), 0u);
+
+    ASSERT_EQ(loaded->GetMeshInfos().size(), 2u);
+    EXPECT_EQ(loaded->GetMeshInfos()[1].indexCountOffset, 6u);
+    EXPECT_EQ(loaded->GetMeshInfos()[1].meshIndexCount, 6u);
+}
+
+TEST(sge_mesh_cache, RoundTripsLodRanges)
+{
+    ScopedFile file(GetTempPath("lods.sgemesh"));
+    std::vector<Mesh> meshes = MakeMeshes();
+    meshes[1].SetLods({ MeshLod{ { 0, 2, 3 }, 0.25f } });
+    ModelAsset source;
+    source.Initialize(meshes);
+
+    // Simplified levels go after the full mesh and index the same vertices.
+    const MeshResourceInfo& info = source.GetMeshInfos()[1];
+    ASSERT_EQ(info.lodCount, 1u);
+    EXPECT_EQ(info.lods[0].indexOffset, 12u);
+    EXPECT_EQ(info.lods[0].indexCount, 3u);
+    EXPECT_EQ(source.GetIndices()[13], 6u);
+    EXPECT_EQ(source.GetMeshInfos()[0].lodCount, 0u);
+
+    ASSERT_TRUE(MeshCache::Write(file.path, SOURCE_KEY, source));
+    std::unique_ptr<ModelAsset> loaded = MeshCache::LoadModel(file.path, SOURCE_KEY);
+    ASSERT_NE(loaded, nullptr);
+    ASSERT_EQ(loaded->GetMeshInfos()[1].lodCount, 1u);
+    EXPECT_EQ(loaded->GetMeshInfos()[1].lods[0].indexOffset, 12u);
+    EXPECT_FLOAT_EQ(loaded->GetMeshInfos()[1].lods[0].error, 0.25f);
+    EXPECT_FLOAT_EQ(loaded->GetBoundsRadius(), source.GetBoundsRadius());
+    EXPECT_FLOAT_EQ(loaded->GetBoundsCenter().z, 0.5f);
+
+    // A range that points past the index array is rejected like any other damage.
+    {
+        std::fstream stream(file.path, std::ios::binary | std::ios::in | std::ios::out);
+        MeshCacheHeader header;
+        stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+        const uint32 count = 100;
+        stream.seekp(header.sections[static_cast<size_t>(MeshCacheSection::MeshInfos)].offset + sizeof(MeshResourceInfo) +
+                     offsetof(MeshResourceInfo, lods) + offsetof(MeshLodRange, indexCount));
+        stream.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+    EXPECT_EQ(MeshCache::LoadModel(file.path, SOURCE_KEY), nullptr);
+}
+
+TEST(sge_mesh_cache, RoundTripsMeshBounds)
+{
+    ScopedFile file(GetTempPath("bounds.sgemesh"));
+    std::vector<Mesh> meshes = MakeMeshes();
+    ModelAsset source;
+    source.Initialize(meshes);
+
+    // Each mesh gets its own box on import, the model's box encloses them all.
+    const MeshResourceInfo& info = source.GetMeshInfos()[1];
+    EXPECT_FLOAT_EQ(info.boundsMin.z, 1.0f);
+    EXPECT_FLOAT_EQ(info.boundsMax.x, 1.0f);
+    EXPECT_FLOAT_EQ(source.GetMeshInfos()[0].boundsMax.z, 0.0f);
+    EXPECT_FLOAT_EQ(source.GetBoundsMin().z, 0.0f);
+    EXPECT_FLOAT_EQ(source.GetBoundsMax().z, 1.0f);
+
+    ASSERT_TRUE(MeshCache::Write(file.path, SOURCE_KEY, source));
+    std::unique_ptr<ModelAsset> loaded = MeshCache::LoadModel(file.path, SOURCE_KEY);
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_FLOAT_EQ(loaded->GetMeshInfos()[1].boundsMin.z, 1.0f);
+    EXPECT_FLOAT_EQ(loaded->GetMeshInfos()[1].boundsMax.y, 1.0f);
+    EXPECT_FLOAT_EQ(loaded->GetBoundsMax().y, 1.0f);
+}
+
+TEST(sge_mesh_cache, RoundTripsMeshlets)
+{
+    ScopedFile file(GetTempPath("meshlets.sgemesh"));
+    std::vector<Mesh> meshes = MakeMeshes();
+    for (Mesh& mesh : meshes)
+    {
+        mesh.SetMeshlets(MeshletBuilder::Build(mesh.GetVertices(), mesh.GetIndices()));
+    }
+    ModelAsset source;
+    source.Initialize(meshes);
+
+    // Meshlet vertices of later meshes point at their own part of the vertex array.
+    const MeshResourceInfo& info = source.GetMeshInfos()[1];
+    ASSERT_EQ(info.meshletCount, 1u);
+    EXPECT_EQ(info.meshletOffset, 1u);
+    const Meshlet& meshlet = source.GetMeshlets()[1];
+    EXPECT_EQ(meshlet.triangleCount, 2u);
+    EXPECT_EQ(meshlet.triangleOffset, 2u);
+    EXPECT_GE(source.GetMeshletVertices()[meshlet.vertexOffset], 4u);
+
+    ASSERT_TRUE(MeshCache::Write(file.path, SOURCE_KEY, source));
+    std::unique_ptr<ModelAsset> loaded = MeshCache::LoadModel(file.path, SOURCE_KEY);
+    ASSERT_NE(loaded, nullptr);
+    ASSERT_EQ(loaded->GetMeshlets().size(), 2u);
+    ASSERT_EQ(loaded->GetMeshletVertices().size(), source.GetMeshletVertices().size());
+    EXPECT_EQ(loaded->GetMeshInfos()[1].meshletOffset, 1u);
+    EXPECT_EQ(loaded->GetMeshletTriangles().size(), 4u);
+    EXPECT_FLOAT_EQ(loaded->GetMeshlets()[1].center.z, 1.0f);
+    EXPECT_FLOAT_EQ(loaded->GetMeshlets()[1].coneCutoff, source.GetMeshlets()[1].coneCutoff);
+    for (size_t i = 0; i < source.GetMeshletVertices().size(); ++i)
+    {
+        EXPECT_EQ(loaded->GetMeshletVertices()[i], source.GetMeshletVertices()[i]);
+    }
+
+    // A meshlet vertex past the vertex array is rejected like any other damage.
+    {
+        std::fstream stream(file.path, std::ios::binary | std::ios::in | std::ios::out);
+        MeshCacheHeader header;
+        stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+        const uint32 vertex = 100;
+        stream.seekp(header.sections[static_cast<size_t>(MeshCacheSection::MeshletVertices)].offset);
+        stream.write(reinterpret_cast<const char*>(&vertex), sizeof(vertex));
+    }
+    EXPECT_EQ(MeshCache::LoadModel(file.path, SOURCE_KEY), nullptr);
+}
+
+TEST(sge_mesh_cache, RoundTripsSkeletonAndClips)
+{
+    ScopedFile file(GetTempPath("animated.sgemesh"));
+    std::vector<Mesh> meshes = MakeMeshes();
+    AnimatedModelAsset source;
+    source.Initialize(meshes, MakeSkeleton(), { MakeAnimation() });
+
+    ASSERT_TRUE(MeshCache::Write(file.path, SOURCE_KEY, source));
+    std::unique_ptr<AnimatedModelAsset> loaded = MeshCache::LoadAnimatedModel(file.path, SOURCE_KEY);
+    ASSERT_NE(loaded, nullptr);
+
+    ASSERT_TRUE(loaded->HasSkin());
+    ASSERT_EQ(loaded->GetSkinVertices().size(), loaded->GetVertices().size());
+    EXPECT_EQ(loaded->GetSkinVertices()[5].boneIndices[0], 1);
+    EXPECT_EQ(loaded->GetSkinVertices()[5].boneWeights[0], 255);
+
+    const Skeleton& skeleton = loaded->GetSkeleton();
+    ASSERT_EQ(skeleton.GetBoneCount(), 3);
+    EXPECT_EQ(skeleton.GetBoneIndex("Bone2"), 2);
+    EXPECT_EQ(skeleton.GetBone(2).parentIndex, 1);
+    EXPECT_EQ(skeleton.GetBone(1).children, std::vector<int32>{ 2 });
+    EXPECT_FLOAT_EQ(skeleton.GetBone(2).weights[2], 0.5f);
+    EXPECT_FLOAT_EQ(skeleton.GetBoneOffset(2).m13, 2.0f);
+    EXPECT_EQ(skeleton.GetHierarchy().GetBoneCount(), 3);
+    ASSERT_NE(skeleton.GetLayerMask(1), nullptr);
+    EXPECT_EQ(skeleton.GetLayerMask(1)->GetSize(), 1u);
+
+    ASSERT_EQ(loaded->GetAnimationClips().size(), 1u);
+    AnimationClipHandle handle = loaded->FindAnimationClip("Wave");
+    ASSERT_NE(handle, INVALID_ANIMATION_CLIP);
+    const AnimationClip& clip = loaded->GetAnimationClip(handle);
+    const AnimationClip& expected = source.GetAnimationClip(0);
+    EXPECT_FLOAT_EQ(clip.GetTicksPerSecond(), 30.0f);
+    EXPECT_EQ(clip.GetKeyCount(), expected.GetKeyCount());
+
+    for (float time : { 0.0f, 0.4f, 1.0f, 1.7f })
+    {
+        BonePose a = clip.SampleBone(1, time);
+        BonePose b = expected.SampleBone(1, time);
+        EXPECT_FLOAT_EQ(a.position.x, b.position.x);
+        EXPECT_FLOAT_EQ(a.rotation.y, b.rotation.y);
+        EXPECT_FLOAT_EQ(a.rotation.w, b.rotation.w);
+    }
+}
+
+TEST(sge_mesh_cache, RejectsStaleAndDamagedFiles)
+{
+    ScopedFile file(GetTempPath("damaged.sgemesh"));
+    std::vector<Mesh> meshes = MakeMeshes();
+    ModelAsset source;
+    source.Initialize(meshes);
+    ASSERT_TRUE(MeshCache::Write(file.path, SOURCE_KEY, source));
+
+    EXPECT_EQ(MeshCache::LoadModel(file.path, SOURCE_KEY + 1), nullptr);
+    EXPECT_NE(MeshCache::LoadModel(file.path, MESH_CACHE_ANY_SOURCE), nullptr);
+    EXPECT_EQ(MeshCache::LoadAnimatedModel(file.path, SOURCE_KEY), nullptr);
+    EXPECT_EQ(MeshCache::LoadModel(GetTempPath("missing.sgemesh"), SOURCE_KEY), nullptr);
+
+    const uintmax_t size = std::filesystem::file_size(file.path);
+    std::filesystem::resize_file(file.path, size - 8);
+    EXPECT_EQ(MeshCache::LoadModel(file.path, SOURCE_KEY), nullptr);
+
+    ASSERT_TRUE(MeshCache::Write(file.path, SOURCE_KEY, source));
+    {
+        std::fstream stream(file.path, std::ios::binary | std::ios::in | std::ios::out);
+        uint32 version = MESH_CACHE_VERSION + 1;
+        stream.seekp(offsetof(MeshCacheHeader, version));
+        stream.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+    EXPECT_EQ(MeshCache::LoadModel(file.path, SOURCE_KEY), nullptr);
+}
+
+TEST(sge_mesh_cache, SourceKeyTracksPathTimeAndFlags)
+{
+    ScopedFile source(GetTempPath("source.obj"));
+    EXPECT_EQ(MeshCache::ComputeSourceKey(source.path, 1), MESH_CACHE_ANY_SOURCE);
+
+    std::ofstream(source.path) << "v 0 0 0\n";
+    const uint64 key = MeshCache::ComputeSourceKey(source.path, 1);
+    EXPECT_NE(key, MESH_CACHE_ANY_SOURCE);
+    EXPECT_EQ(MeshCache::ComputeSourceKey(source.path, 1), key);
+    EXPECT_NE(MeshCache::ComputeSourceKey(source.path, 2), key);
+
+    std::filesystem::last_write_time(source.path, std::filesystem::last_write_time(source.path) + std::chrono::seconds(5));
+    EXPECT_NE(MeshCache::ComputeSourceKey(source.path, 1), key);
+    EXPECT_EQ(MeshCache::GetCachePath(source.path), source.path + ".sgemesh");
+}
@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <array>
+#include <random>
+#include <gtest/gtest.h>
+#include "data/sge_mesh_optimizer.h"
+#include "data/sge_model_importer.h"
+using namespace SGE;
+
+namespace
+{
+    using Triangle = std::array<float, 9>;
+
+    // Unshared vertices for a size x size grid, triangles in a shuffled order.
+    void MakeShuffledGrid(uint32 size, std::vector<Vertex>& vertices, std::vector<uint32>& indices)
+    {
+        std::vector<std::array<uint32, 3>> triangles;
+        for (uint32 y = 0; y < size; ++y)
+        {
+            for (uint32 x = 0; x < size; ++x)
+            {
+                const uint32 i = y * (size + 1) + x;
+                triangles.push_back({ i, i + size + 1, i + 1 });
+                triangles.push_back({ i + 1, i + size + 1, i + size + 2 });
+            }
+        }
+        std::shuffle(triangles.begin(), triangles.end(), std::mt19937(5));
+
+        vertices.clear();
+        indices.clear();
+        for (const auto& triangle : triangles)
+        {
+            for (uint32 corner : triangle)
+            {
+                Vertex vertex{};
+                vertex.position = float3(static_cast<float>(corner % (size + 1)), 0.0f, static_cast<float>(corner / (size + 1)));
+                vertex.normal = float3(0.0f, 1.0f, 0.0f);
+                vertex.boneIndices[0] = -1;
+                indices.push_back(static_cast<uint32>(vertices.size()));
+                vertices.push_back(vertex);
+            }
+        }
+    }
+
+    // Triangles by corner positions, rotated to start at the smallest corner so winding counts
+    // but the starting corner doesn't.
+    std::vector<Triangle> GetTriangles(const std::vector<Vertex>& vertices, const std::vector<uint32>& indices)
+    {
+        std::vector<Triangle> triangles;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            std::array<std::array<float, 3>, 3> corners;
+            for (size_t k = 0; k < 3; ++k)
+            {
+                const float3& position = vertices[indices[i + k]].position;
+                corners[k] = { position.x, position.y, position.z };
+            }
+            std::rotate(corners.begin(), std::min_element(corners.begin(), corners.end()), corners.end());
+
+            Triangle triangle;
+            for (size_t k = 0; k < 9; ++k)
+            {
+                triangle[k] = corners[k / 3][k % 3];
+            }
+            triangles.push_back(triangle);
+        }
+
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+}
+
+TEST(sge_mesh_optimizer, AnalyzesFifoCache)
+{
+    const VertexCacheStats single = MeshOptimizer::AnalyzeVertexCache({ 0, 1, 2 }, 3);
+    EXPECT_FLOAT_EQ(single.GetACMR(), 3.0f);
+    EXPECT_FLOAT_EQ(single.GetATVR(), 1.0f);
+
+    // The quad shares an edge, with a cache of three vertex 0 is gone by the time it's used again.
+    const std::vector<uint32> quad = { 0, 1, 2, 2, 1, 3, 0, 2, 3 };
+    EXPECT_EQ(MeshOptimizer::AnalyzeVertexCache(quad, 4).cacheMisses, 4u);
+    EXPECT_EQ(MeshOptimizer::AnalyzeVertexCache(quad, 4, 3).cacheMisses, 5u);
+    EXPECT_EQ(MeshOptimizer::AnalyzeVertexCache(quad, 4, 3).vertexCount, 4u);
+}
+
+TEST(sge_mesh_optimizer, WeldsOnlyIdenticalVertices)
+{
+    std::vector<Vertex> vertices(6, Vertex{});
+    const float2 corners[] = { { 0, 0 }, { 0, 1 }, { 1, 0 }, { 1, 0 }, { 0, 1 }, { 1, 1 } };
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        vertices[i].position = float3(corners[i].x, corners[i].y, 0.0f);
+        vertices[i].texCoords = corners[i];
+    }
+    vertices[4].texCoords = float2(0.0f, 0.5f); // a seam, same position but not the same vertex
+    std::vector<uint32> indices = { 0, 1, 2, 3, 4, 5 };
+
+    MeshOptimizer::WeldVertices(vertices, indices);
+    ASSERT_EQ(vertices.size(), 5u);
+    EXPECT_EQ(indices[3], indices[2]);
+    EXPECT_NE(indices[4], indices[1]);
+}
+
+TEST(sge_mesh_optimizer, VertexCacheOrderKeepsTrianglesAndWinding)
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32> indices;
+    MakeShuffledGrid(32, vertices, indices);
+    const std::vector<Triangle> expected = GetTriangles(vertices, indices);
+
+    const MeshOptimizationReport report = MeshOptimizer::Optimize(vertices, indices);
+    EXPECT_EQ(GetTriangles(vertices, indices), expected);
+
+    EXPECT_EQ(report.vertexCountBefore, 32u * 32u * 6u);
+    EXPECT_EQ(report.vertexCountAfter, 33u * 33u);
+    EXPECT_EQ(vertices.size(), 33u * 33u);
+    EXPECT_FLOAT_EQ(report.before.GetACMR(), 3.0f);
+
+    // A regular grid can't go below 0.5, an order that ignores the cache stays near 2.
+    EXPECT_LT(report.after.GetACMR(), 0.8f);
+    EXPECT_LT(report.after.GetATVR(), 1.5f);
+}
+
+TEST(sge_mesh_optimizer, VertexCacheOrderBeatsShuffledSharedIndices)
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32> indices;
+    MakeShuffledGrid(32, vertices, indices);
+    MeshOptimizer::WeldVertices(vertices, indices);
+
+    const VertexCacheStats shuffled = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+    MeshOptimizer::OptimizeVertexCache(indices, vertices.size());
+    const VertexCacheStats optimized = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+
+    EXPECT_GT(shuffled.GetACMR(), 1.5f);
+    EXPECT_LT(optimized.GetACMR(), shuffled.GetACMR() * 0.5f);
+    EXPECT_EQ(optimized.triangleCount, shuffled.triangleCount);
+}
+
+TEST(sge_mesh_optimizer, VertexFetchFollowsFirstUseAndDropsUnused)
+{
+    std::vector<Vertex> vertices(5, Vertex{});
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        vertices[i].position = float3(static_cast<float>(i), 0.0f, 0.0f);
+    }
+    std::vector<uint32> indices = { 3, 1, 4, 4, 1, 0 };
+
+    MeshOptimizer::OptimizeVertexFetch(vertices, indices);
+    ASSERT_EQ(vertices.size(), 4u);
+    EXPECT_EQ(indices, (std::vector<uint32>{ 0, 1, 2, 2, 1, 3 }));
+    EXPECT_EQ(vertices[0].position.x, 3.0f);
+    EXPECT_EQ(vertices[2].position.x, 4.0f);
+    EXPECT_EQ(vertices[3].position.x, 0.0f);
+}
+
+TEST(sge_mesh_optimizer, HandlesEmptyAndDegenerateInput)
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32> indices;
+    const MeshOptimizationReport empty = MeshOptimizer::Optimize(vertices, indices);
+    EXPECT_EQ(empty.after.triangleCount, 0u);
+    EXPECT_EQ(empty.after.GetACMR(), 0.0f);
+
+    vertices.assign(2, Vertex{});
+    vertices[1].position = float3(1.0f, 0.0f, 0.0f);
+    indices = { 0, 0, 1, 1, 1, 0 };
+    MeshOptimizer::Optimize(vertices, indices);
+    EXPECT_EQ(indices.size(), 6u);
+    EXPECT_EQ(vertices.size(), 2u);
+}
+
+TEST(sge_mesh_optimizer, ImportedSampleModelsDontGetWorse)
+{
+    for (const char* model : { "models/cube.obj", "models/sphere.obj", "models/cube_and_plane.gltf", "backpack/backpack.gltf" })
+    {
+        SCOPED_TRACE(model);
+        MeshOptimizationReport report;
+        std::unique_ptr<ModelAsset> asset = ModelImporter::ImportModel(std::string(SGE_SAMPLE_RESOURCES_PATH) + model, &report);
+        ASSERT_NE(asset, nullptr);
+
+        // Simplified levels are stored after the full meshes, only the full ones are optimized here.
+        uint32 fullIndexCount = 0;
+        for (const MeshResourceInfo& info : asset->GetMeshInfos())
+        {
+            fullIndexCount += info.meshIndexCount;
+        }
+        EXPECT_EQ(fullIndexCount, report.after.triangleCount * 3u);
+        EXPECT_EQ(asset->GetVertices().size(), report.vertexCountAfter);
+        EXPECT_LE(report.vertexCountAfter, report.vertexCountBefore);
+        EXPECT_EQ(report.after.triangleCount, report.before.triangleCount);
+        EXPECT_LE(report.after.GetACMR(), report.before.GetACMR());
+        EXPECT_GE(report.after.GetATVR(), 1.0f);
+    }
+}
@@ -0,0 +1,246 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include "data/sge_mesh_lod_selector.h"
+#include "data/sge_mesh_simplifier.h"
+#include "data/sge_model_importer.h"
+using namespace SGE;
+
+namespace
+{
+    // Shared vertices for a flat size x size grid. With a seam, the column in the middle exists
+    // twice and texCoords.y tells the two UV charts apart.
+    void MakeGrid(uint32 size, bool hasSeam, std::vector<Vertex>& vertices, std::vector<uint32>& indices)
+    {
+        const uint32 seamColumn = size / 2;
+        std::vector<uint32> left((size + 1) * (size + 1));
+        std::vector<uint32> right((size + 1) * (size + 1));
+        for (uint32 y = 0; y <= size; ++y)
+        {
+            for (uint32 x = 0; x <= size; ++x)
+            {
+                Vertex vertex{};
+                vertex.position = float3(static_cast<float>(x), 0.0f, static_cast<float>(y));
+                vertex.normal = float3(0.0f, 1.0f, 0.0f);
+                vertex.texCoords = float2(static_cast<float>(x) / size, hasSeam && x > seamColumn ? 1.0f : 0.0f);
+                vertex.boneIndices[0] = -1;
+
+                const uint32 i = y * (size + 1) + x;
+                left[i] = right[i] = static_cast<uint32>(vertices.size());
+                vertices.push_back(vertex);
+                if (hasSeam && x == seamColumn)
+                {
+                    vertex.texCoords.y = 1.0f;
+                    right[i] = static_cast<uint32>(vertices.size());
+                    vertices.push_back(vertex);
+                }
+            }
+        }
+
+        for (uint32 y = 0; y < size; ++y)
+        {
+            for (uint32 x = 0; x < size; ++x)
+            {
+                const std::vector<uint32>& map = x < seamColumn ? left : right;
+                const uint32 i = y * (size + 1) + x;
+                indices.insert(indices.end(), { map[i], map[i + size + 1], map[i + 1] });
+                indices.insert(indices.end(), { map[i + 1], map[i + size + 1], map[i + size + 2] });
+            }
+        }
+    }
+
+    // A subdivided cube pushed onto the unit sphere, every face its own UV chart.
+    void MakeCubeSphere(int32 size, std::vector<Vertex>& vertices, std::vector<uint32>& indices)
+    {
+        const float3 axes[6][3] = {
+            { float3(1, 0, 0), float3(0, 0, -1), float3(0, 1, 0) }, { float3(-1, 0, 0), float3(0, 0, 1), float3(0, 1, 0) },
+            { float3(0, 1, 0), float3(1, 0, 0), float3(0, 0, -1) }, { float3(0, -1, 0), float3(1, 0, 0), float3(0, 0, 1) },
+            { float3(0, 0, 1), float3(1, 0, 0), float3(0, 1, 0) },  { float3(0, 0, -1), float3(-1, 0, 0), float3(0, 1, 0) },
+        };
+
+        for (const auto& axis : axes)
+        {
+            const uint32 base = static_cast<uint32>(vertices.size());
+            for (int32 v = 0; v <= size; ++v)
+            {
+                for (int32 u = 0; u <= size; ++u)
+                {
+                    // Integer lattice first, so corners shared by faces come out bit identical.
+                    const float3 lattice = axis[0] * static_cast<float>(size) + axis[1] * static_cast<float>(2 * u - size) + axis[2] * static_cast<float>(2 * v - size);
+                    Vertex vertex{};
+                    vertex.position = lattice.normalized();
+                    vertex.normal = vertex.position;
+                    vertex.texCoords = float2(static_cast<float>(u) / size, static_cast<float>(v) / size);
+                    vertex.boneIndices[0] = -1;
+                    vertices.push_back(vertex);
+                }
+            }
+
+            for (int32 v = 0; v < size; ++v)
+            {
+                for (int32 u = 0; u < size; ++u)
+                {
+                    const uint32 i = base + v * (size + 1) + u;
+                    indices.insert(indices.end(), { i, i + 1, i + size + 1 });
+                    indices.insert(indices.end(), { i + 1, i + size + 2, i + size + 1 });
+                }
+            }
+        }
+    }
+
+    float3 GetNormal(const std::vector<Vertex>& vertices, const uint32* triangle)
+    {
+        const float3& a = vertices[triangle[0]].position;
+        return cross(vertices[triangle[1]].position - a, vertices[triangle[2]].position - a);
+    }
+}
+
+TEST(sge_mesh_simplifier, FlatGridCollapsesWithoutError)
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32> indices;
+    MakeGrid(16, false, vertices, indices);
+
+    float error = -1.0f;
+    const std::vector<uint32> simplified = MeshSimplifier::Simplify(vertices, indices, 0, 0.001f, &error);
+    EXPECT_LT(simplified.size(), indices.size() / 16);
+    EXPECT_LT(error, 0.001f);
+
+    // Corners are held by the border planes, so the grid still covers the same square.
+    float area = 0.0f;
+    for (size_t i = 0; i < simplified.size(); i += 3)
+    {
+        const float3 normal = GetNormal(vertices, &simplified[i]);
+        EXPECT_GT(normal.y, 0.0f) << "triangle " << i / 3 << " flipped";
+        area += normal.length() * 0.5f;
+    }
+    EXPECT_NEAR(area, 256.0f, 0.01f);
+}
+
+TEST(sge_mesh_simplifier, StopsAtTargetAndErrorLimit)
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32> indices;
+    MakeCubeSphere(8, vertices, indices);
+
+    const std::vector<uint32> half = MeshSimplifier::Simplify(vertices, indices, indices.size() / 2, 1.0f);
+    EXPECT_LE(half.size(), indices.size() / 2);
+    EXPECT_GT(half.size(), indices.size() / 4);
+
+    float error = 0.0f;
+    const std::vector<uint32> limited = MeshSimplifier::Simplify(vertices, indices, 0, 0.02f, &error);
+    EXPECT_LE(error, 0.02f);
+    EXPECT_LT(limited.size(), indices.size());
+    EXPECT_GT(limited.size(), half.size() / 4);
+
+    EXPECT_EQ(MeshSimplifier::Simplify(vertices, indices, 0, 0.0f).size(), indices.size());
+}
+
+TEST(sge_mesh_simplifier, KeepsUvChartsApart)
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32> indices;
+    MakeGrid(16, true, vertices, indices);
+
+    const std::vector<uint32> simplified = MeshSimplifier::Simplify(vertices, indices, 0, 0.001f);
+    EXPECT_LT(simplified.size(), indices.size() / 8);
+
+    bool isSeamUsed = false;
+    for (size_t i = 0; i < simplified.size(); i += 3)
+    {
+        const float chart = vertices[simplified[i]].texCoords.y;
+        EXPECT_EQ(vertices[simplified[i + 1]].texCoords.y, chart);
+        EXPECT_EQ(vertices[simplified[i + 2]].texCoords.y, chart);
+        for (size_t k = 0; k < 3; ++k)
+        {
+            const float3& position = vertices[simplified[i + k]].position;
+            EXPECT_TRUE(chart == 0.0f ? position.x <= 8.0f : position.x >= 8.0f);
+            isSeamUsed |= position.x == 8.0f;
+        }
+    }
+    EXPECT_TRUE(isSeamUsed);
+}
+
+TEST(sge_mesh_simplifier, BuildsShrinkingLodChain)
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32> indices;
+    MakeCubeSphere(16, vertices, indices);
+
+    MeshLodSettings settings;
+    settings.maxRelativeError = 0.5f;
+    const std::vector<MeshLod> lods = MeshSimplifier::BuildLods(vertices, indices, settings);
+    ASSERT_GE(lods.size(), 2u);
+    ASSERT_LE(lods.size(), static_cast<size_t>(MAX_MESH_LODS));
+
+    size_t previousCount = indices.size();
+    float previousError = 0.0f;
+    for (const MeshLod& lod : lods)
+    {
+        EXPECT_LT(lod.indices.size(), previousCount);
+        EXPECT_GE(lod.error, previousError);
+        EXPECT_LE(lod.error, 0.5f);
+        for (uint32 index : lod.indices)
+        {
+            ASSERT_LT(index, vertices.size());
+        }
+        previousCount = lod.indices.size();
+        previousError = lod.error;
+    }
+
+    EXPECT_TRUE(MeshSimplifier::BuildLods(vertices, {}).empty());
+}
+
+TEST(sge_mesh_simplifier, ImportedModelsCarryLods)
+{
+    std::unique_ptr<ModelAsset> asset = ModelImporter::ImportModel(std::string(SGE_SAMPLE_RESOURCES_PATH) + "backpack/backpack.gltf");
+    ASSERT_NE(asset, nullptr);
+    EXPECT_GT(asset->GetBoundsRadius(), 0.0f);
+
+    uint32 lodCount = 0;
+    for (const MeshResourceInfo& info : asset->GetMeshInfos())
+    {
+        lodCount += info.lodCount;
+        for (uint32 i = 0; i < info.lodCount; ++i)
+        {
+            EXPECT_LE(info.lods[i].indexOffset + info.lods[i].indexCount, asset->GetIndices().size());
+            EXPECT_LT(info.lods[i].indexCount, i == 0 ? info.meshIndexCount : info.lods[i - 1].indexCount);
+        }
+    }
+    EXPECT_GT(lodCount, 0u);
+}
+
+TEST(sge_mesh_lod_selector, PicksCoarsestLevelUnderPixelError)
+{
+    const float4x4 projection = CreatePerspectiveProjectionMatrix(ConvertToRadians(90.0f), 1.0f, 0.1f, 100.0f);
+    const float projectionScale = MeshLodSelector::ComputeProjectionScale(projection, 1000.0f);
+    EXPECT_NEAR(projectionScale, 500.0f, 0.01f);
+
+    // A unit sphere 11 units away is 10 units from its nearest point, twice the size doubles the scale.
+    const float3 camera(0.0f, 0.0f, -11.0f);
+    const float lodScale = MeshLodSelector::ComputeLodScale(float4x4::Identity, float3(), 1.0f, camera, projectionScale, 0.1f);
+    EXPECT_NEAR(lodScale, 50.0f, 0.01f);
+    const float scaledLodScale = MeshLodSelector::ComputeLodScale(CreateScaleMatrix(float3(2.0f, 2.0f, 2.0f)), float3(), 1.0f,
+                                                                  float3(0.0f, 0.0f, -12.0f), projectionScale, 0.1f);
+    EXPECT_NEAR(scaledLodScale, 100.0f, 0.01f);
+    EXPECT_GT(MeshLodSelector::ComputeLodScale(float4x4::Identity, float3(), 1.0f, float3(), projectionScale, 0.1f), 1e30f);
+
+    MeshResourceInfo info{};
+    info.meshIndexCount = 300;
+    info.lodCount = 3;
+    info.lods[0] = { 150, 300, 0.01f };
+    info.lods[1] = { 75, 450, 0.02f };
+    info.lods[2] = { 36, 525, 0.1f };
+
+    EXPECT_EQ(MeshLodSelector::Select(info, lodScale), 2u);
+    EXPECT_EQ(MeshLodSelector::Select(info, lodScale, 5.0f), 3u);
+    EXPECT_EQ(MeshLodSelector::Select(info, 1e30f), 0u);
+
+    uint32 indexCount = 0;
+    uint32 indexOffset = 0;
+    MeshLodSelector::GetIndexRange(info, 2, indexCount, indexOffset);
+    EXPECT_EQ(indexCount, 75u);
+    EXPECT_EQ(indexOffset, 450u);
+    MeshLodSelector::GetIndexRange(info, 0, indexCount, indexOffset);
+    EXPECT_EQ(indexCount, 300u);
+    EXPECT_EQ(indexOffset, 0u);
+}
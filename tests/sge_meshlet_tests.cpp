@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <array>
+#include <gtest/gtest.h>
+#include "data/sge_meshlet.h"
+#include "data/sge_model_importer.h"
+using namespace SGE;
+
+namespace
+{
+    // Shared vertices for a size x size grid in the xz plane, facing up.
+    void MakeGrid(uint32 size, std::vector<Vertex>& vertices, std::vector<uint32>& indices)
+    {
+        for (uint32 y = 0; y <= size; ++y)
+        {
+            for (uint32 x = 0; x <= size; ++x)
+            {
+                Vertex vertex{};
+                vertex.position = float3(static_cast<float>(x), 0.0f, static_cast<float>(y));
+                vertex.normal = float3(0.0f, 1.0f, 0.0f);
+                vertex.boneIndices[0] = -1;
+                vertices.push_back(vertex);
+            }
+        }
+
+        for (uint32 y = 0; y < size; ++y)
+        {
+            for (uint32 x = 0; x < size; ++x)
+            {
+                const uint32 i = y * (size + 1) + x;
+                indices.insert(indices.end(), { i, i + size + 1, i + 1 });
+                indices.insert(indices.end(), { i + 1, i + size + 1, i + size + 2 });
+            }
+        }
+    }
+
+    std::vector<std::array<uint32, 3>> GetSortedTriangles(const std::vector<uint32>& indices)
+    {
+        std::vector<std::array<uint32, 3>> triangles;
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            triangles.push_back({ indices[i], indices[i + 1], indices[i + 2] });
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    // A 90 degree view from position towards target.
+    Frustum MakeFrustum(const float3& position, const float3& target)
+    {
+        const float4x4 view = CreateViewMatrix(position, target, float3(0.0f, 1.0f, 0.0f));
+        const float4x4 projection = CreatePerspectiveProjectionMatrix(ConvertToRadians(90.0f), 1.0f, 0.1f, 1000.0f);
+        return Frustum::FromMatrix(projection * view);
+    }
+}
+
+TEST(sge_meshlet, RespectsLimitsAndCoversEveryTriangle)
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32> indices;
+    MakeGrid(40, vertices, indices);
+
+    const MeshletData data = MeshletBuilder::Build(vertices, indices);
+    ASSERT_FALSE(data.meshlets.empty());
+
+    std::vector<uint32> rebuilt;
+    for (const Meshlet& meshlet : data.meshlets)
+    {
+        EXPECT_LE(meshlet.vertexCount, MAX_MESHLET_VERTICES);
+        EXPECT_LE(meshlet.triangleCount, MAX_MESHLET_TRIANGLES);
+        EXPECT_GT(meshlet.triangleCount, 0u);
+
+        for (uint32 t = 0; t < meshlet.triangleCount; ++t)
+        {
+            for (uint8 local : data.triangles[meshlet.triangleOffset + t].indices)
+            {
+                ASSERT_LT(local, meshlet.vertexCount);
+                rebuilt.push_back(data.vertices[meshlet.vertexOffset + local]);
+            }
+        }
+
+        // Every vertex is inside both bounds.
+        for (uint32 i = 0; i < meshlet.vertexCount; ++i)
+        {
+            const float3& position = vertices[data.vertices[meshlet.vertexOffset + i]].position;
+            EXPECT_LE((position - meshlet.center).length(), meshlet.radius + 1e-4f);
+            EXPECT_GE(position.x, meshlet.boundsMin.x);
+            EXPECT_LE(position.z, meshlet.boundsMax.z);
+        }
+    }
+
+    // Same triangles with the same winding, just grouped.
+    EXPECT_EQ(GetSortedTriangles(rebuilt), GetSortedTriangles(indices));
+
+    // A grid this regular should fill meshlets well, not leave a trail of small ones.
+    EXPECT_LT(data.meshlets.size(), (indices.size() / 3) / (MAX_MESHLET_TRIANGLES / 2));
+}
+
+TEST(sge_meshlet, FlatClustersHaveTightNormalCones)
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32> indices;
+    MakeGrid(8, vertices, indices);
+
+    const MeshletData data = MeshletBuilder::Build(vertices, indices);
+    ASSERT_EQ(data.meshlets.size(), 2u);
+    const Meshlet& meshlet = data.meshlets[0];
+    EXPECT_NEAR(meshlet.coneAxis.y, 1.0f, 1e-5f);
+    EXPECT_NEAR(meshlet.coneCutoff, 0.0f, 1e-3f);
+
+    // Seen from below the grid only shows back faces, from above it's visible.
+    const float3 center = meshlet.center;
+    const Frustum fromBelow = MakeFrustum(center + float3(0.0f, -10.0f, 0.1f), center);
+    const Frustum fromAbove = MakeFrustum(center + float3(0.0f, 10.0f, 0.1f), center);
+    EXPECT_FALSE(MeshletCuller::IsVisible(meshlet, fromBelow, center + float3(0.0f, -10.0f, 0.1f)));
+    EXPECT_TRUE(MeshletCuller::IsVisible(meshlet, fromAbove, center + float3(0.0f, 10.0f, 0.1f)));
+    EXPECT_TRUE(MeshletCuller::IsVisible(meshlet, fromBelow, center + float3(0.0f, -10.0f, 0.1f), false));
+}
+
+TEST(sge_meshlet, CullsAgainstFrustumAndCompactsIndices)
+{
+    std::vector<Vertex> vertices;
+    std::vector<uint32> indices;
+    MakeGrid(64, vertices, indices);
+    const MeshletData data = MeshletBuilder::Build(vertices, indices);
+
+    // Everything in view from high above the middle of the grid.
+    std::vector<uint32> visible;
+    const float3 above(32.0f, 100.0f, 32.1f);
+    uint32 count = MeshletCuller::Cull(data.meshlets, data.vertices, data.triangles, MakeFrustum(above, float3(32.0f, 0.0f, 32.0f)), above, true, visible);
+    EXPECT_EQ(count, data.meshlets.size());
+    EXPECT_EQ(GetSortedTriangles(visible), GetSortedTriangles(indices));
+
+    // Low over one corner looking away from the grid, nothing is left.
+    visible.clear();
+    const float3 corner(-1.0f, 1.0f, -1.0f);
+    count = MeshletCuller::Cull(data.meshlets, data.vertices, data.triangles, MakeFrustum(corner, float3(-10.0f, 1.0f, -10.0f)), corner, true, visible);
+    EXPECT_EQ(count, 0u);
+    EXPECT_TRUE(visible.empty());
+
+    // Close above one corner, only part of the grid is in view.
+    visible.clear();
+    const float3 low(4.0f, 4.0f, 4.1f);
+    count = MeshletCuller::Cull(data.meshlets, data.vertices, data.triangles, MakeFrustum(low, float3(4.0f, 0.0f, 4.0f)), low, true, visible);
+    EXPECT_GT(count, 0u);
+    EXPECT_LT(count, data.meshlets.size() / 4);
+    EXPECT_EQ(visible.size() % 3, 0u);
+}
+
+TEST(sge_meshlet, ImportedModelsCarryMeshlets)
+{
+    std::unique_ptr<ModelAsset> asset = ModelImporter::ImportModel(std::string(SGE_SAMPLE_RESOURCES_PATH) + "backpack/backpack.gltf");
+    ASSERT_NE(asset, nullptr);
+
+    for (const MeshResourceInfo& info : asset->GetMeshInfos())
+    {
+        ASSERT_GT(info.meshletCount, 0u);
+        uint32 triangleCount = 0;
+        for (uint32 i = 0; i < info.meshletCount; ++i)
+        {
+            const Meshlet& meshlet = asset->GetMeshlets()[info.meshletOffset + i];
+            triangleCount += meshlet.triangleCount;
+
+            // Meshlet vertices are model wide, like the index array.
+            for (uint32 v = 0; v < meshlet.vertexCount; ++v)
+            {
+                const uint32 vertex = asset->GetMeshletVertices()[meshlet.vertexOffset + v];
+                ASSERT_GE(vertex, info.vertexCountOffset);
+                ASSERT_LT(vertex, asset->GetVertices().size());
+            }
+        }
+        EXPECT_EQ(triangleCount * 3, info.meshIndexCount);
+    }
+}
@@ -0,0 +1,148 @@
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "core/sge_math.h"
+using namespace SGE;
+
+// Mirrors the per-frame work of Scene::UpdateModels on the CPU side: compose every instance's
+// world matrix, sample and concatenate a bone hierarchy for the animated ones and fill the
+// constant buffer payload. Rendering data is left out so the numbers only reflect sge_math.
+namespace
+{
+    constexpr size_t INSTANCE_COUNT = 256;
+    constexpr size_t BONE_COUNT = 64;
+    constexpr size_t MAX_BONES = 100;
+
+    struct alignas(16) TransformPayload
+    {
+        float4x4 model;
+        float4x4 view;
+        float4x4 projection;
+        float4x4 boneTransforms[MAX_BONES];
+        bool isAnimated;
+        float2 tilingUV = { 1.0f, 1.0f };
+    };
+
+    struct BoneTrack
+    {
+        int32_t parentIndex;
+        float3 positions[2];
+        float4 rotations[2];
+        float3 scales[2];
+        float4x4 offsetMatrix;
+    };
+
+    struct SceneFixture
+    {
+        std::vector<float3> positions;
+        std::vector<float3> rotations;
+        std::vector<float3> scales;
+        std::vector<BoneTrack> bones;
+        std::vector<float4x4> globalTransforms;
+        std::vector<TransformPayload> payloads;
+
+        SceneFixture()
+        {
+            std::mt19937 generator(42);
+            std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+            auto randomFloat3 = [&]() { return float3(distribution(generator), distribution(generator), distribution(generator)); };
+            auto randomQuaternion = [&]() { return float4(distribution(generator), distribution(generator), distribution(generator), distribution(generator)).normalized(); };
+
+            for (size_t i = 0; i < INSTANCE_COUNT; ++i)
+            {
+                positions.push_back(randomFloat3() * 100.0f);
+                rotations.push_back(randomFloat3() * 180.0f);
+                scales.push_back(float3::One);
+            }
+
+            for (size_t i = 0; i < BONE_COUNT; ++i)
+            {
+                BoneTrack bone{};
+                bone.parentIndex = static_cast<int32_t>(i) - 1;
+                bone.positions[0] = randomFloat3();
+                bone.positions[1] = randomFloat3();
+                bone.rotations[0] = randomQuaternion();
+                bone.rotations[1] = randomQuaternion();
+                bone.scales[0] = float3::One;
+                bone.scales[1] = float3::One;
+                bone.offsetMatrix = CreateTranslationMatrix(randomFloat3());
+                bones.push_back(bone);
+            }
+
+            globalTransforms.resize(BONE_COUNT);
+            payloads.resize(INSTANCE_COUNT);
+        }
+    };
+
+    void UpdateScene(SceneFixture& scene, float time, const float4x4& view, const float4x4& projection)
+    {
+        for (size_t instance = 0; instance < INSTANCE_COUNT; ++instance)
+        {
+            const float3& rotation = scene.rotations[instance];
+            TransformPayload& payload = scene.payloads[instance];
+
+            payload.model = CreateTranslationMatrix(scene.positions[instance]) *
+                            CreateRotationMatrixYawPitchRoll(ConvertToRadians(rotation.x), ConvertToRadians(rotation.y), ConvertToRadians(rotation.z)) *
+                            CreateScaleMatrix(scene.scales[instance]);
+            payload.view = view;
+            payload.projection = projection;
+            payload.isAnimated = true;
+
+            for (size_t i = 0; i < BONE_COUNT; ++i)
+            {
+                const BoneTrack& bone = scene.bones[i];
+                float3 position = lerp(bone.positions[0], bone.positions[1], time);
+                float4 boneRotation = slerp(bone.rotations[0], bone.rotations[1], time);
+                float3 scale = lerp(bone.scales[0], bone.scales[1], time);
+
+                float4x4 local = CreateTranslationMatrix(position) * CreateRotationMatrixFromQuaternion(boneRotation) * CreateScaleMatrix(scale);
+                float4x4 global = bone.parentIndex < 0 ? local : scene.globalTransforms[bone.parentIndex] * local;
+                scene.globalTransforms[i] = global;
+                payload.boneTransforms[i] = global * bone.offsetMatrix;
+            }
+
+            for (size_t i = BONE_COUNT; i < MAX_BONES; ++i)
+            {
+                payload.boneTransforms[i] = float4x4::Identity;
+            }
+        }
+    }
+}
+
+static void BM_SceneUpdate(benchmark::State& state)
+{
+    SceneFixture scene;
+    const float4x4 view = CreateViewMatrix(float3(0.0f, 10.0f, -50.0f), float3::Zero, float3(0.0f, 1.0f, 0.0f));
+    const float4x4 projection = CreatePerspectiveProjectionMatrix(ConvertToRadians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+
+    float time = 0.0f;
+    for (auto _ : state)
+    {
+        UpdateScene(scene, time, view, projection);
+        benchmark::DoNotOptimize(scene.payloads.data());
+        benchmark::ClobberMemory();
+        time = time < 1.0f ? time + 0.01f : 0.0f;
+    }
+    state.SetItemsProcessed(state.iterations() * INSTANCE_COUNT);
+}
+BENCHMARK(BM_SceneUpdate)->Unit(benchmark::kMicrosecond);
+
+static void BM_VectorInterpolation(benchmark::State& state)
+{
+    SceneFixture scene;
+
+    float time = 0.0f;
+    for (auto _ : state)
+    {
+        float3 accumulated = float3::Zero;
+        for (const BoneTrack& bone : scene.bones)
+        {
+            float3 position = lerp(bone.positions[0], bone.positions[1], time);
+            accumulated += cross(position, bone.positions[1]) * dot(position, bone.positions[0]);
+        }
+        benchmark::DoNotOptimize(accumulated);
+        time = time < 1.0f ? time + 0.01f : 0.0f;
+    }
+    state.SetItemsProcessed(state.iterations() * BONE_COUNT);
+}
+BENCHMARK(BM_VectorInterpolation);
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <assimp/Importer.hpp>
+#include "core/sge_job_system.h"
+#include "data/sge_model_importer.h"
+#include "data/sge_skin_weights.h"
+using namespace SGE;
+
+// Skin weight gathering on the meshes of samples/resources/anim/human.gltf. The reference is the
+// import path before SkinWeightGatherer: nested vectors per mesh, and a vector that is sorted
+// and normalized per vertex.
+namespace
+{
+    const aiScene* GetHumanScene()
+    {
+        static Assimp::Importer importer;
+        static const aiScene* scene = importer.ReadFile(std::string(SGE_SAMPLE_RESOURCES_PATH) + "anim/human.gltf", ModelImporter::IMPORT_FLAGS);
+        return scene;
+    }
+
+    void GatherPerVertexSort(const aiMesh* mesh, std::vector<Vertex>& vertices)
+    {
+        std::vector<std::vector<float>> vertexWeights(mesh->mNumVertices);
+        std::vector<std::vector<int32>> vertexIndices(mesh->mNumVertices);
+        for (uint32 i = 0; i < mesh->mNumBones; i++)
+        {
+            aiBone* bone = mesh->mBones[i];
+            for (uint32 j = 0; j < bone->mNumWeights; j++)
+            {
+                vertexWeights[bone->mWeights[j].mVertexId].push_back(bone->mWeights[j].mWeight);
+                vertexIndices[bone->mWeights[j].mVertexId].push_back(i);
+            }
+        }
+
+        for (uint32 i = 0; i < mesh->mNumVertices; i++)
+        {
+            Vertex& vertex = vertices[i];
+            std::fill_n(vertex.boneWeights, 4, 0.0f);
+            std::fill_n(vertex.boneIndices, 4, -1);
+
+            std::vector<std::pair<int32, float>> bonesAndWeights;
+            for (size_t j = 0; j < vertexWeights[i].size(); j++)
+            {
+                bonesAndWeights.emplace_back(vertexIndices[i][j], vertexWeights[i][j]);
+            }
+
+            std::sort(bonesAndWeights.begin(), bonesAndWeights.end(), [](const std::pair<int32, float>& a, const std::pair<int32, float>& b)
+            {
+                return a.second > b.second;
+            });
+
+            float weightSum = 0.0f;
+            for (size_t j = 0; j < bonesAndWeights.size() && j < 4; j++)
+            {
+                vertex.boneIndices[j] = bonesAndWeights[j].first;
+                vertex.boneWeights[j] = bonesAndWeights[j].second;
+                weightSum += bonesAndWeights[j].second;
+            }
+
+            if (weightSum > 0.0f)
+            {
+                for (size_t j = 0; j < 4; j++)
+                {
+                    vertex.boneWeights[j] /= weightSum;
+                }
+            }
+        }
+    }
+
+    void SetVertexCounter(benchmark::State& state, const aiScene* scene)
+    {
+        size_t vertexCount = 0;
+        for (uint32 m = 0; m < scene->mNumMeshes; ++m)
+        {
+            vertexCount += scene->mMeshes[m]->mNumVertices;
+        }
+        state.SetItemsProcessed(state.iterations() * vertexCount);
+    }
+}
+
+static void BM_SkinWeights_PerVertexSort(benchmark::State& state)
+{
+    const aiScene* scene = GetHumanScene();
+    if (!scene)
+    {
+        state.SkipWithError("human.gltf not found");
+        return;
+    }
+
+    std::vector<Vertex> vertices;
+    for (auto _ : state)
+    {
+        for (uint32 m = 0; m < scene->mNumMeshes; ++m)
+        {
+            vertices.resize(scene->mMeshes[m]->mNumVertices);
+            GatherPerVertexSort(scene->mMeshes[m], vertices);
+            benchmark::DoNotOptimize(vertices.data());
+        }
+    }
+    SetVertexCounter(state, scene);
+}
+BENCHMARK(BM_SkinWeights_PerVertexSort)->Unit(benchmark::kMicrosecond);
+
+// Arguments are the influence count and the thread count, 1 runs without the job system.
+static void BM_SkinWeights_Gather(benchmark::State& state)
+{
+    const aiScene* scene = GetHumanScene();
+    if (!scene)
+    {
+        state.SkipWithError("human.gltf not found");
+        return;
+    }
+
+    const uint32 influenceCount = static_cast<uint32>(state.range(0));
+    const uint32 threadCount = static_cast<uint32>(state.range(1));
+    if (threadCount > 1)
+    {
+        JobSystem::Get().Initialize(threadCount - 1);
+    }
+
+    for (auto _ : state)
+    {
+        for (uint32 m = 0; m < scene->mNumMeshes; ++m)
+        {
+            const aiMesh* mesh = scene->mMeshes[m];
+            SkinInfluences skin = SkinWeightGatherer::Gather(mesh->mBones, mesh->mNumBones, mesh->mNumVertices, influenceCount);
+            benchmark::DoNotOptimize(skin.boneWeights.data());
+        }
+    }
+    SetVertexCounter(state, scene);
+    JobSystem::Get().Shutdown();
+}
+BENCHMARK(BM_SkinWeights_Gather)->Args({ 4, 1 })->Args({ 8, 1 })->Args({ 4, 4 })->Args({ 8, 4 })->Unit(benchmark::kMicrosecond)->UseRealTime();
@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <assimp/Importer.hpp>
+#include "core/sge_job_system.h"
+#include "data/sge_model_importer.h"
+#include "data/sge_skin_weights.h"
+#include "sge_test_job_system.h"
+using namespace SGE;
+
+namespace
+{
+    // One bone per entry, each with the given (vertex, weight) pairs.
+    std::vector<std::unique_ptr<aiBone>> MakeBones(const std::vector<std::vector<std::pair<uint32, float>>>& weights)
+    {
+        std::vector<std::unique_ptr<aiBone>> bones;
+        for (const auto& boneWeights : weights)
+        {
+            std::unique_ptr<aiBone>& bone = bones.emplace_back(std::make_unique<aiBone>());
+            bone->mNumWeights = static_cast<uint32>(boneWeights.size());
+            bone->mWeights = new aiVertexWeight[boneWeights.size()];
+            for (size_t i = 0; i < boneWeights.size(); ++i)
+            {
+                bone->mWeights[i] = aiVertexWeight(boneWeights[i].first, boneWeights[i].second);
+            }
+        }
+        return bones;
+    }
+
+    std::vector<const aiBone*> GetPointers(const std::vector<std::unique_ptr<aiBone>>& bones)
+    {
+        std::vector<const aiBone*> pointers;
+        for (const std::unique_ptr<aiBone>& bone : bones)
+        {
+            pointers.push_back(bone.get());
+        }
+        return pointers;
+    }
+}
+
+TEST(sge_skin_weights, KeepsStrongestInfluencesNormalized)
+{
+    // Vertex 0 has six influences, vertex 1 none and vertex 2 one.
+    const auto bones = MakeBones({ { { 0, 0.1f } }, { { 0, 0.5f }, { 2, 0.4f } }, { { 0, 0.2f } }, { { 0, 0.05f } }, { { 0, 0.3f } }, { { 0, 0.15f } } });
+    const std::vector<const aiBone*> pointers = GetPointers(bones);
+
+    const SkinInfluences skin = SkinWeightGatherer::Gather(pointers.data(), static_cast<uint32>(pointers.size()), 3);
+    ASSERT_EQ(skin.influenceCount, 4u);
+    ASSERT_EQ(skin.boneIndices.size(), 12u);
+
+    const int32 expectedBones[4] = { 1, 4, 2, 5 };
+    const float expectedWeights[4] = { 0.5f, 0.3f, 0.2f, 0.15f };
+    for (size_t i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(skin.boneIndices[i], expectedBones[i]);
+        EXPECT_NEAR(skin.boneWeights[i], expectedWeights[i] / 1.15f, 1e-6f);
+    }
+
+    for (size_t i = 4; i < 8; ++i)
+    {
+        EXPECT_EQ(skin.boneIndices[i], -1);
+        EXPECT_EQ(skin.boneWeights[i], 0.0f);
+    }
+
+    EXPECT_EQ(skin.boneIndices[8], 1);
+    EXPECT_FLOAT_EQ(skin.boneWeights[8], 1.0f);
+    EXPECT_EQ(skin.boneIndices[9], -1);
+}
+
+TEST(sge_skin_weights, EightInfluencesAndTies)
+{
+    // Equal weights keep the lower bone, zero weights never take a slot.
+    const auto bones = MakeBones({ { { 0, 0.25f } }, { { 0, 0.0f } }, { { 0, 0.25f } }, { { 0, 0.5f } }, { { 0, 0.25f } }, { { 0, 0.25f } }, { { 7, 1.0f } } });
+    const std::vector<const aiBone*> pointers = GetPointers(bones);
+
+    SkinInfluences skin = SkinWeightGatherer::Gather(pointers.data(), static_cast<uint32>(pointers.size()), 2);
+    EXPECT_EQ(skin.boneIndices[0], 3);
+    EXPECT_EQ(skin.boneIndices[1], 0);
+    EXPECT_EQ(skin.boneIndices[2], 2);
+    EXPECT_EQ(skin.boneIndices[3], 4);
+
+    skin = SkinWeightGatherer::Gather(pointers.data(), static_cast<uint32>(pointers.size()), 2, 8);
+    ASSERT_EQ(skin.influenceCount, 8u);
+    const int32 expectedBones[8] = { 3, 0, 2, 4, 5, -1, -1, -1 };
+    float weightSum = 0.0f;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        EXPECT_EQ(skin.boneIndices[i], expectedBones[i]);
+        weightSum += skin.boneWeights[i];
+    }
+    EXPECT_FLOAT_EQ(weightSum, 1.0f);
+
+    // The vertex id past the mesh is dropped instead of written out of bounds.
+    EXPECT_EQ(skin.boneIndices[8], -1);
+}
+
+TEST(sge_skin_weights, ParallelGatherMatchesSortedReference)
+{
+    Assimp::Importer importer;
+    const aiScene* scene = importer.ReadFile(std::string(SGE_SAMPLE_RESOURCES_PATH) + "anim/human.gltf", ModelImporter::IMPORT_FLAGS);
+    ASSERT_NE(scene, nullptr);
+
+    ScopedJobSystem jobs(3);
+    uint32 skinnedMeshCount = 0;
+    for (uint32 m = 0; m < scene->mNumMeshes; ++m)
+    {
+        const aiMesh* mesh = scene->mMeshes[m];
+        if (!mesh->HasBones())
+        {
+            continue;
+        }
+        ++skinnedMeshCount;
+
+        std::vector<std::vector<std::pair<int32, float>>> reference(mesh->mNumVertices);
+        for (uint32 b = 0; b < mesh->mNumBones; ++b)
+        {
+            for (uint32 i = 0; i < mesh->mBones[b]->mNumWeights; ++i)
+            {
+                const aiVertexWeight& weight = mesh->mBones[b]->mWeights[i];
+                if (weight.mWeight > 0.0f)
+                {
+                    reference[weight.mVertexId].emplace_back(static_cast<int32>(b), weight.mWeight);
+                }
+            }
+        }
+
+        const SkinInfluences skin = SkinWeightGatherer::Gather(mesh->mBones, mesh->mNumBones, mesh->mNumVertices);
+        for (uint32 v = 0; v < mesh->mNumVertices; ++v)
+        {
+            std::vector<std::pair<int32, float>>& influences = reference[v];
+            std::stable_sort(influences.begin(), influences.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+            influences.resize(std::min<size_t>(influences.size(), DEFAULT_SKIN_INFLUENCES));
+
+            float weightSum = 0.0f;
+            for (const auto& influence : influences)
+            {
+                weightSum += influence.second;
+            }
+
+            for (size_t i = 0; i < influences.size(); ++i)
+            {
+                ASSERT_EQ(skin.boneIndices[v * 4 + i], influences[i].first) << "vertex " << v;
+                ASSERT_NEAR(skin.boneWeights[v * 4 + i], influences[i].second / weightSum, 1e-6f) << "vertex " << v;
+            }
+        }
+    }
+    EXPECT_GT(skinnedMeshCount, 0u);
+}
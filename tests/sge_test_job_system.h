@@ -0,0 +1,17 @@
+#ifndef _SGE_TEST_JOB_SYSTEM_H_
+#define _SGE_TEST_JOB_SYSTEM_H_
+
+#include "core/sge_job_system.h"
+
+namespace SGE
+{
+    // Initializes the job system for one test and shuts it down again, so every test starts clean.
+    class ScopedJobSystem
+    {
+    public:
+        explicit ScopedJobSystem(uint32 workerCount) { JobSystem::Get().Initialize(workerCount); }
+        ~ScopedJobSystem() { JobSystem::Get().Shutdown(); }
+    };
+}
+
+#endif // !_SGE_TEST_JOB_SYSTEM_H_
@@ -0,0 +1,135 @@
+#include <cmath>
+#include <string>
+#include <gtest/gtest.h>
+#include "core/sge_job_system.h"
+#include "data/sge_texture_encoder.h"
+#include "sge_test_job_system.h"
+using namespace SGE;
+
+namespace
+{
+    TextureImage LoadSample(const std::string& name)
+    {
+        TextureImage image;
+        EXPECT_TRUE(TextureCooker::Decode(std::string(SGE_SAMPLE_RESOURCES_PATH) + name, image));
+        return image;
+    }
+
+    double RoundTripPSNR(const TextureImage& image, CookedTextureFormat format, uint32 channelCount)
+    {
+        const TextureImage encoded = TextureEncoder::Encode(image, format);
+        EXPECT_EQ(encoded.pixels.size(), GetTextureMipSize(format, image.width, image.height));
+        return TextureEncoder::ComputePSNR(image, TextureEncoder::Decode(encoded, format), channelCount);
+    }
+
+    // Smooth gradient in every channel, alpha included.
+    TextureImage MakeGradient(uint32 width, uint32 height)
+    {
+        TextureImage image;
+        image.width = width;
+        image.height = height;
+        image.pixels.resize(static_cast<size_t>(width) * height * 4);
+        for (uint32 y = 0; y < height; ++y)
+        {
+            for (uint32 x = 0; x < width; ++x)
+            {
+                uint8* texel = image.pixels.data() + (static_cast<size_t>(y) * width + x) * 4;
+                texel[0] = static_cast<uint8>(x * 255 / std::max(1u, width - 1));
+                texel[1] = static_cast<uint8>(y * 255 / std::max(1u, height - 1));
+                texel[2] = static_cast<uint8>((x + y) * 127 / std::max(1u, width + height - 2));
+                texel[3] = static_cast<uint8>(255 - x * 64 / std::max(1u, width - 1));
+            }
+        }
+        return image;
+    }
+}
+
+TEST(sge_texture_encoder, BlockSizesAndPitches)
+{
+    EXPECT_EQ(TextureEncoder::GetBlockSize(CookedTextureFormat::RGBA8), 0u);
+    EXPECT_EQ(TextureEncoder::GetBlockSize(CookedTextureFormat::BC1), 8u);
+    EXPECT_EQ(TextureEncoder::GetBlockSize(CookedTextureFormat::BC7), 16u);
+    EXPECT_EQ(GetTextureRowPitch(CookedTextureFormat::BC4, 16), 32u);
+    EXPECT_EQ(GetTextureMipSize(CookedTextureFormat::BC1, 1024, 512), 1024u * 512u / 2u);
+    EXPECT_EQ(GetTextureMipSize(CookedTextureFormat::BC7, 1024, 512), 1024u * 512u);
+    EXPECT_EQ(GetTextureMipSize(CookedTextureFormat::BC5, 2, 1), 16u);
+    EXPECT_EQ(GetTextureMipSize(CookedTextureFormat::BC5, 6, 6), 64u);
+}
+
+TEST(sge_texture_encoder, SelectsFormatByUsage)
+{
+    TextureImage image = MakeGradient(8, 4);
+    EXPECT_EQ(TextureEncoder::SelectFormat(TextureUsage::Color, image), CookedTextureFormat::BC7);
+    EXPECT_EQ(TextureEncoder::SelectFormat(TextureUsage::CompactColor, image), CookedTextureFormat::BC3);
+    EXPECT_EQ(TextureEncoder::SelectFormat(TextureUsage::Normal, image), CookedTextureFormat::BC5);
+    EXPECT_EQ(TextureEncoder::SelectFormat(TextureUsage::Mask, image), CookedTextureFormat::BC4);
+
+    for (size_t i = 3; i < image.pixels.size(); i += 4)
+    {
+        image.pixels[i] = 255;
+    }
+    EXPECT_EQ(TextureEncoder::SelectFormat(TextureUsage::CompactColor, image), CookedTextureFormat::BC1);
+
+    EXPECT_EQ(TextureEncoder::SelectFormat(TextureUsage::Color, MakeGradient(12, 4)), CookedTextureFormat::RGBA8);
+    EXPECT_EQ(TextureEncoder::SelectFormat(TextureUsage::Color, MakeGradient(8, 2)), CookedTextureFormat::RGBA8);
+}
+
+TEST(sge_texture_encoder, SolidBlocksRoundTrip)
+{
+    TextureImage image;
+    image.width = 4;
+    image.height = 4;
+    for (uint32 i = 0; i < 16; ++i)
+    {
+        image.pixels.insert(image.pixels.end(), { 37, 201, 90, 128 });
+    }
+
+    // BC4 hits every 8 bit value exactly, BC7 is off by one where the channels disagree on the
+    // shared lowest bit, BC1 is as close as 5:6:5 gets.
+    EXPECT_TRUE(std::isinf(RoundTripPSNR(image, CookedTextureFormat::BC4, 1)));
+    EXPECT_TRUE(std::isinf(RoundTripPSNR(image, CookedTextureFormat::BC5, 2)));
+    EXPECT_GT(RoundTripPSNR(image, CookedTextureFormat::BC7, 4), 48.0);
+    EXPECT_GT(RoundTripPSNR(image, CookedTextureFormat::BC1, 3), 38.0);
+
+    const TextureImage decoded = TextureEncoder::Decode(TextureEncoder::Encode(image, CookedTextureFormat::BC3), CookedTextureFormat::BC3);
+    EXPECT_EQ(decoded.pixels[3], 128);
+}
+
+TEST(sge_texture_encoder, GradientsKeepTheirQuality)
+{
+    const TextureImage image = MakeGradient(64, 32);
+    EXPECT_GT(RoundTripPSNR(image, CookedTextureFormat::BC1, 3), 36.0);
+    EXPECT_GT(RoundTripPSNR(image, CookedTextureFormat::BC3, 4), 36.0);
+    EXPECT_GT(RoundTripPSNR(image, CookedTextureFormat::BC4, 1), 45.0);
+    EXPECT_GT(RoundTripPSNR(image, CookedTextureFormat::BC5, 2), 45.0);
+    EXPECT_GT(RoundTripPSNR(image, CookedTextureFormat::BC7, 4), 40.0);
+
+    // Mips smaller than a block repeat their edge texels.
+    const TextureImage small = MakeGradient(2, 1);
+    EXPECT_GT(RoundTripPSNR(small, CookedTextureFormat::BC7, 4), 40.0);
+}
+
+TEST(sge_texture_encoder, SampleTexturesKeepTheirQuality)
+{
+    const TextureImage albedo = LoadSample("bricks/albedo.png");
+    const TextureImage normal = LoadSample("bricks/normal.png");
+    const TextureImage roughness = LoadSample("bricks/roughness.png");
+    ASSERT_EQ(albedo.width, 1024u);
+
+    const double bc1 = RoundTripPSNR(albedo, CookedTextureFormat::BC1, 3);
+    const double bc7 = RoundTripPSNR(albedo, CookedTextureFormat::BC7, 3);
+    EXPECT_GT(bc1, 32.0);
+    EXPECT_GT(bc7, bc1);
+    EXPECT_GT(RoundTripPSNR(normal, CookedTextureFormat::BC5, 2), 38.0);
+    EXPECT_GT(RoundTripPSNR(roughness, CookedTextureFormat::BC4, 1), 40.0);
+}
+
+TEST(sge_texture_encoder, ParallelEncodeMatchesSerial)
+{
+    const TextureImage image = LoadSample("stones/albedo.png");
+    const TextureImage serial = TextureEncoder::Encode(image, CookedTextureFormat::BC7);
+
+    ScopedJobSystem jobs(3);
+    const TextureImage parallel = TextureEncoder::Encode(image, CookedTextureFormat::BC7);
+    EXPECT_EQ(parallel.pixels, serial.pixels);
+}
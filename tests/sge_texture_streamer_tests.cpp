@@ -0,0 +1,276 @@
+#include <chrono>
+#include <map>
+#include <set>
+#include <thread>
+#include <gtest/gtest.h>
+#include "data/sge_texture_streamer.h"
+#include "sge_test_job_system.h"
+using namespace SGE;
+
+namespace
+{
+    class FakeMips : public DecodedAsset
+    {
+    public:
+        explicit FakeMips(uint32 firstMip) : firstMip(firstMip) {}
+        uint32 firstMip;
+    };
+
+    // Keeps the first resident mip of every resource, like the GPU texture would.
+    class FakeBackend : public TextureStreamingBackend
+    {
+    public:
+        std::unique_ptr<DecodedAsset> LoadMips(const StreamedTextureDesc& desc, uint32 firstMip) override
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++loadCount;
+            if (missingPaths.count(desc.path) || (brokenPaths.count(desc.path) && firstMip < desc.GetTailMip()))
+            {
+                return nullptr;
+            }
+            return std::make_unique<FakeMips>(firstMip);
+        }
+
+        void UploadMips(const StreamedTextureDesc& desc, uint32 firstMip, DecodedAsset& mips) override
+        {
+            EXPECT_EQ(static_cast<FakeMips&>(mips).firstMip, firstMip);
+            residentMips[desc.resourceIndex] = firstMip;
+        }
+
+        void EvictMips(const StreamedTextureDesc& desc, uint32 firstMip) override
+        {
+            EXPECT_GT(firstMip, residentMips[desc.resourceIndex]);
+            residentMips[desc.resourceIndex] = firstMip;
+            ++evictionCount;
+        }
+
+        std::mutex mutex;
+        std::set<std::string> missingPaths;
+        std::set<std::string> brokenPaths; // only the tail can be read
+        std::map<uint32, uint32> residentMips;
+        uint32 loadCount = 0;
+        uint32 evictionCount = 0;
+    };
+
+    StreamedTextureDesc MakeDesc(const std::string& path, uint32 size, uint32 resourceIndex)
+    {
+        StreamedTextureDesc desc;
+        desc.path = path;
+        desc.width = size;
+        desc.height = size;
+        desc.mipCount = 1;
+        while ((size >> desc.mipCount) > 0)
+        {
+            ++desc.mipCount;
+        }
+        desc.resourceIndex = resourceIndex;
+        return desc;
+    }
+
+    // Two updates, the first starts the loads and the second uploads them.
+    void RunFrames(TextureStreamer& streamer, const std::vector<std::pair<StreamedTextureId, float>>& demand, uint32 frameCount = 2)
+    {
+        for (uint32 frame = 0; frame < frameCount; ++frame)
+        {
+            for (const auto& [id, pixels] : demand)
+            {
+                streamer.RequestScreenSize(id, pixels);
+            }
+            streamer.Update();
+        }
+    }
+}
+
+TEST(sge_texture_streamer, RegisterLoadsOnlyTheMipTail)
+{
+    FakeBackend backend;
+    TextureStreamer streamer;
+    streamer.Initialize(&backend);
+
+    const StreamedTextureDesc desc = MakeDesc("a", 1024, 7);
+    ASSERT_EQ(desc.mipCount, 11u);
+    EXPECT_EQ(desc.GetTailMip(), 4u);
+    EXPECT_EQ(desc.GetMipSize(4), 64u * 64u * 4u);
+
+    const StreamedTextureId id = streamer.Register(desc);
+    ASSERT_NE(id, INVALID_STREAMED_TEXTURE);
+    EXPECT_EQ(streamer.GetResidentMip(id), 4u);
+    EXPECT_EQ(backend.residentMips[7], 4u);
+
+    const TextureResidencyStats stats = streamer.GetStats();
+    EXPECT_EQ(stats.textureCount, 1u);
+    EXPECT_EQ(stats.residentBytes, desc.GetSize(4, 11));
+    EXPECT_EQ(stats.satisfiedCount, 1u);
+
+    // Small textures are all tail.
+    EXPECT_EQ(MakeDesc("small", 32, 0).GetTailMip(), 0u);
+
+    // Block compressed mips stay whole blocks, a wide texture keeps a larger tail.
+    StreamedTextureDesc wide = MakeDesc("wide", 1024, 0);
+    wide.height = 8;
+    wide.format = CookedTextureFormat::BC7;
+    EXPECT_EQ(wide.GetTailMip(), 1u);
+    EXPECT_EQ(wide.GetMipSize(1), 128u * 16u);
+}
+
+TEST(sge_texture_streamer, WantedMipFollowsScreenSize)
+{
+    const StreamedTextureDesc desc = MakeDesc("a", 1024, 0);
+    EXPECT_EQ(TextureStreamer::ComputeWantedMip(desc, 2048.0f), 0u);
+    EXPECT_EQ(TextureStreamer::ComputeWantedMip(desc, 1024.0f), 0u);
+    EXPECT_EQ(TextureStreamer::ComputeWantedMip(desc, 600.0f), 0u);
+    EXPECT_EQ(TextureStreamer::ComputeWantedMip(desc, 512.0f), 1u);
+    EXPECT_EQ(TextureStreamer::ComputeWantedMip(desc, 100.0f), 3u);
+    EXPECT_EQ(TextureStreamer::ComputeWantedMip(desc, 1.0f), 4u);
+    EXPECT_EQ(TextureStreamer::ComputeWantedMip(desc, 0.0f), 4u);
+}
+
+TEST(sge_texture_streamer, StreamsFinerMipsInTheBackground)
+{
+    FakeBackend backend;
+    TextureStreamer streamer;
+    streamer.Initialize(&backend);
+    const StreamedTextureDesc desc = MakeDesc("a", 1024, 0);
+    const StreamedTextureId id = streamer.Register(desc);
+
+    // The load starts in one update and lands in the next.
+    streamer.RequestScreenSize(id, 512.0f);
+    streamer.Update();
+    EXPECT_TRUE(streamer.IsLoading(id));
+    EXPECT_EQ(streamer.GetResidentMip(id), 4u);
+    EXPECT_EQ(streamer.GetStats().pendingBytes, desc.GetSize(1, 4));
+    EXPECT_EQ(streamer.GetStats().satisfiedCount, 0u);
+
+    streamer.RequestScreenSize(id, 512.0f);
+    streamer.Update();
+    EXPECT_FALSE(streamer.IsLoading(id));
+    EXPECT_EQ(streamer.GetResidentMip(id), 1u);
+    EXPECT_EQ(backend.residentMips[0], 1u);
+
+    const TextureResidencyStats stats = streamer.GetStats();
+    EXPECT_EQ(stats.residentBytes, desc.GetSize(1, 11));
+    EXPECT_EQ(stats.wantedBytes, desc.GetSize(1, 11));
+    EXPECT_EQ(stats.pendingBytes, 0u);
+    EXPECT_EQ(stats.satisfiedCount, 1u);
+
+    // Without demand the mips stay while the budget allows it.
+    RunFrames(streamer, {}, 3);
+    EXPECT_EQ(streamer.GetResidentMip(id), 1u);
+    EXPECT_EQ(backend.evictionCount, 0u);
+}
+
+TEST(sge_texture_streamer, EvictsLeastRecentlyUsedUnderBudget)
+{
+    FakeBackend backend;
+    TextureStreamer streamer;
+    streamer.Initialize(&backend);
+    const StreamedTextureDesc desc = MakeDesc("a", 256, 0);
+    const uint64 tail = desc.GetSize(desc.GetTailMip(), desc.mipCount);
+    const uint64 full = desc.GetSize(0, desc.mipCount);
+
+    const StreamedTextureId a = streamer.Register(desc);
+    const StreamedTextureId b = streamer.Register(MakeDesc("b", 256, 1));
+    const StreamedTextureId c = streamer.Register(MakeDesc("c", 256, 2));
+
+    // Room for two full textures next to a tail.
+    streamer.SetMemoryBudget(2 * full + tail);
+    RunFrames(streamer, { { a, 256.0f } });
+    RunFrames(streamer, { { b, 256.0f } });
+    EXPECT_EQ(streamer.GetResidentMip(a), 0u);
+    EXPECT_EQ(streamer.GetResidentMip(b), 0u);
+
+    // a was used more recently than b, so b makes room for c.
+    RunFrames(streamer, { { a, 256.0f } }, 1);
+    RunFrames(streamer, { { c, 256.0f } });
+    EXPECT_EQ(streamer.GetResidentMip(c), 0u);
+    EXPECT_EQ(streamer.GetResidentMip(a), 0u);
+    EXPECT_EQ(streamer.GetResidentMip(b), desc.GetTailMip());
+    EXPECT_EQ(backend.residentMips[1], desc.GetTailMip());
+    EXPECT_EQ(streamer.GetStats().residentBytes, streamer.GetStats().memoryBudget);
+    EXPECT_EQ(streamer.GetStats().evictedBytes, full - tail);
+
+    // Textures in use never give up mips they are asked for, b has to wait.
+    RunFrames(streamer, { { a, 256.0f }, { b, 256.0f }, { c, 256.0f } });
+    EXPECT_EQ(streamer.GetResidentMip(a), 0u);
+    EXPECT_EQ(streamer.GetResidentMip(b), desc.GetTailMip());
+    EXPECT_EQ(streamer.GetResidentMip(c), 0u);
+    EXPECT_EQ(streamer.GetStats().satisfiedCount, 2u);
+
+    // A lower budget is settled on the next update, the tails always stay.
+    streamer.SetMemoryBudget(0);
+    RunFrames(streamer, {}, 1);
+    EXPECT_EQ(streamer.GetStats().residentBytes, 3 * tail);
+}
+
+TEST(sge_texture_streamer, MostMissingLevelsLoadFirst)
+{
+    FakeBackend backend;
+    TextureStreamer streamer;
+    TextureStreamingSettings settings;
+    settings.maxLoadsInFlight = 1;
+    streamer.Initialize(&backend, settings);
+
+    const StreamedTextureId near = streamer.Register(MakeDesc("near", 1024, 0));
+    const StreamedTextureId far = streamer.Register(MakeDesc("far", 1024, 1));
+
+    streamer.RequestScreenSize(far, 200.0f);
+    streamer.RequestScreenSize(near, 1024.0f);
+    streamer.Update();
+    EXPECT_TRUE(streamer.IsLoading(near));
+    EXPECT_FALSE(streamer.IsLoading(far));
+    EXPECT_EQ(streamer.GetStats().loadsInFlight, 1u);
+
+    RunFrames(streamer, { { far, 200.0f }, { near, 1024.0f } }, 3);
+    EXPECT_EQ(streamer.GetResidentMip(near), 0u);
+    EXPECT_EQ(streamer.GetResidentMip(far), 2u);
+}
+
+TEST(sge_texture_streamer, FailedLoadKeepsTheTail)
+{
+    FakeBackend backend;
+    backend.brokenPaths = { "broken" };
+    TextureStreamer streamer;
+    streamer.Initialize(&backend);
+
+    const StreamedTextureId id = streamer.Register(MakeDesc("broken", 512, 0));
+    ASSERT_NE(id, INVALID_STREAMED_TEXTURE);
+    RunFrames(streamer, { { id, 512.0f } }, 4);
+    EXPECT_EQ(streamer.GetResidentMip(id), 3u);
+    EXPECT_EQ(backend.loadCount, 2u); // the tail and one try
+    EXPECT_EQ(streamer.GetStats().pendingBytes, 0u);
+
+    backend.missingPaths = { "missing" };
+    EXPECT_EQ(streamer.Register(MakeDesc("missing", 16, 1)), INVALID_STREAMED_TEXTURE);
+    EXPECT_EQ(streamer.GetStats().textureCount, 1u);
+}
+
+TEST(sge_texture_streamer, LoadsOnWorkerThreads)
+{
+    ScopedJobSystem jobs(3);
+    FakeBackend backend;
+    TextureStreamer streamer;
+    streamer.Initialize(&backend);
+
+    std::vector<std::pair<StreamedTextureId, float>> demand;
+    for (uint32 i = 0; i < 16; ++i)
+    {
+        demand.emplace_back(streamer.Register(MakeDesc(std::to_string(i), 512, i)), static_cast<float>(32 * (i + 1)));
+    }
+
+    // Frames keep coming while the workers load, like they would in the renderer.
+    RunFrames(streamer, demand, 1);
+    EXPECT_LT(streamer.GetStats().satisfiedCount, demand.size());
+    for (uint32 frame = 0; frame < 5000 && streamer.GetStats().satisfiedCount < demand.size(); ++frame)
+    {
+        RunFrames(streamer, demand, 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_EQ(streamer.GetStats().satisfiedCount, demand.size());
+    for (const auto& [id, pixels] : demand)
+    {
+        EXPECT_EQ(backend.residentMips[id], streamer.GetResidentMip(id));
+        EXPECT_EQ(streamer.GetResidentMip(id), TextureStreamer::ComputeWantedMip(MakeDesc("", 512, 0), pixels));
+    }
+    streamer.Shutdown();
+}
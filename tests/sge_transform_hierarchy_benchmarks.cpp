@@ -0,0 +1,95 @@
+#include <random>
+#include <benchmark/benchmark.h>
+#include "core/sge_transform_hierarchy.h"
+using namespace SGE;
+
+namespace
+{
+    // A level of small objects: every fourth transform is a root with three children.
+    void MakeForest(TransformHierarchy& transforms, size_t count)
+    {
+        std::mt19937 generator(21);
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+        uint32 root = INVALID_TRANSFORM;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint32 transform = transforms.Create(i % 4 == 0 ? INVALID_TRANSFORM : root);
+            root = i % 4 == 0 ? transform : root;
+            const float3 position(distribution(generator) * 1000.0f, distribution(generator) * 20.0f, distribution(generator) * 1000.0f);
+            transforms.SetLocal(transform, position, CreateQuaternionYawPitchRoll(distribution(generator) * 3.0f, 0.0f, 0.0f), float3::One);
+        }
+        transforms.Update();
+    }
+
+    // Moves every stride-th transform back and forth and updates.
+    void RunFrames(benchmark::State& state, size_t stride)
+    {
+        TransformHierarchy transforms;
+        const size_t count = static_cast<size_t>(state.range(0));
+        MakeForest(transforms, count);
+
+        float step = 0.05f;
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < count; i += stride)
+            {
+                const uint32 transform = static_cast<uint32>(i);
+                transforms.SetPosition(transform, transforms.GetPosition(transform) + float3(step, 0.0f, 0.0f));
+            }
+            transforms.Update();
+            benchmark::DoNotOptimize(transforms.GetWorldMatrices().data());
+            step = -step;
+        }
+        state.counters["changed"] = static_cast<double>(transforms.GetChangedTransforms().size());
+    }
+}
+
+// The per frame cost before the hierarchy: every instance composes its world matrix.
+static void BM_TransformHierarchy_ComposeAll(benchmark::State& state)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    float3_soa positions;
+    float4_soa rotations;
+    float3_soa scales;
+    for (size_t i = 0; i < count; ++i)
+    {
+        positions.push_back(float3(static_cast<float>(i), 0.0f, 0.0f));
+        rotations.push_back(float4::Identity);
+        scales.push_back(float3::One);
+    }
+    float4x4_array worldMatrices(count);
+
+    for (auto _ : state)
+    {
+        ComposeTRS(positions, rotations, scales, worldMatrices);
+        benchmark::DoNotOptimize(worldMatrices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_TransformHierarchy_ComposeAll)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_TransformHierarchy_Static(benchmark::State& state)
+{
+    TransformHierarchy transforms;
+    MakeForest(transforms, static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        transforms.Update();
+        benchmark::DoNotOptimize(transforms.GetWorldMatrices().data());
+    }
+}
+BENCHMARK(BM_TransformHierarchy_Static)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_TransformHierarchy_OnePercentMoving(benchmark::State& state)
+{
+    RunFrames(state, 100);
+}
+BENCHMARK(BM_TransformHierarchy_OnePercentMoving)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void BM_TransformHierarchy_AllMoving(benchmark::State& state)
+{
+    RunFrames(state, 1);
+}
+BENCHMARK(BM_TransformHierarchy_AllMoving)->Arg(100000)->Unit(benchmark::kMicrosecond);
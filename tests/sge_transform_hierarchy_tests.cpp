@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include "core/sge_transform_hierarchy.h"
+using namespace SGE;
+
+namespace
+{
+    float4x4 MakeMatrix(const float3& position, const float4& rotation, const float3& scale)
+    {
+        return CreateTranslationMatrix(position) * CreateRotationMatrixFromQuaternion(rotation) * CreateScaleMatrix(scale);
+    }
+
+    std::vector<uint32> Sorted(std::vector<uint32> transforms)
+    {
+        std::sort(transforms.begin(), transforms.end());
+        return transforms;
+    }
+}
+
+TEST(sge_transform_hierarchy, WorldMatricesConcatenateParents)
+{
+    const float3 rootPosition(10.0f, 0.0f, -4.0f);
+    const float4 rootRotation = CreateQuaternionYawPitchRoll(ConvertToRadians(90.0f), 0.0f, 0.0f);
+    const float3 rootScale(2.0f, 2.0f, 2.0f);
+    const float3 childPosition(1.0f, 2.0f, 3.0f);
+    const float4 childRotation = CreateQuaternionYawPitchRoll(0.0f, ConvertToRadians(30.0f), ConvertToRadians(15.0f));
+    const float3 childScale(1.0f, 0.5f, 1.0f);
+
+    TransformHierarchy transforms;
+    const uint32 root = transforms.Create();
+    const uint32 child = transforms.Create(root);
+    const uint32 grandchild = transforms.Create(child);
+    transforms.SetLocal(root, rootPosition, rootRotation, rootScale);
+    transforms.SetLocal(child, childPosition, childRotation, childScale);
+    transforms.SetPosition(grandchild, float3(0.0f, 0.0f, 5.0f));
+    transforms.Update();
+
+    const float4x4 rootWorld = MakeMatrix(rootPosition, rootRotation, rootScale);
+    const float4x4 childWorld = rootWorld * MakeMatrix(childPosition, childRotation, childScale);
+    const float4x4 grandchildWorld = childWorld * CreateTranslationMatrix(float3(0.0f, 0.0f, 5.0f));
+    EXPECT_EQ(transforms.GetWorldMatrix(root), rootWorld);
+    EXPECT_EQ(transforms.GetWorldMatrix(child), childWorld);
+    EXPECT_EQ(transforms.GetWorldMatrix(grandchild), grandchildWorld);
+    EXPECT_EQ(transforms.GetLocalMatrix(child), MakeMatrix(childPosition, childRotation, childScale));
+
+    // Parents come before their children.
+    const std::vector<uint32>& changed = transforms.GetChangedTransforms();
+    ASSERT_EQ(changed.size(), 3u);
+    EXPECT_LT(std::find(changed.begin(), changed.end(), root), std::find(changed.begin(), changed.end(), child));
+    EXPECT_LT(std::find(changed.begin(), changed.end(), child), std::find(changed.begin(), changed.end(), grandchild));
+
+    const float4 origin = transforms.GetWorldMatrix(grandchild) * float4(0.0f, 0.0f, 0.0f, 1.0f);
+    const float4 expected = grandchildWorld * float4(0.0f, 0.0f, 0.0f, 1.0f);
+    EXPECT_EQ(origin, expected);
+}
+
+TEST(sge_transform_hierarchy, UpdatesOnlyChangedSubtrees)
+{
+    TransformHierarchy transforms;
+    std::vector<uint32> roots;
+    std::vector<uint32> children;
+    for (uint32 i = 0; i < 50; ++i)
+    {
+        roots.push_back(transforms.Create());
+        transforms.SetPosition(roots.back(), float3(static_cast<float>(i), 0.0f, 0.0f));
+        children.push_back(transforms.Create(roots.back()));
+        transforms.SetPosition(children.back(), float3(0.0f, 1.0f, 0.0f));
+    }
+    transforms.Update();
+    EXPECT_EQ(transforms.GetChangedTransforms().size(), 100u);
+
+    // Nothing moved, nothing recomputed. Setting the same values doesn't count as a change.
+    transforms.SetPosition(roots[3], float3(3.0f, 0.0f, 0.0f));
+    transforms.SetScale(children[4], float3::One);
+    transforms.Update();
+    EXPECT_TRUE(transforms.GetChangedTransforms().empty());
+
+    // A moved root recomputes its child, a moved child only itself. Marking both the parent and
+    // the child dirty walks the child once.
+    transforms.SetPosition(roots[7], float3(7.0f, 5.0f, 0.0f));
+    transforms.SetPosition(children[12], float3(0.0f, 2.0f, 0.0f));
+    transforms.SetRotation(children[20], CreateQuaternionYawPitchRoll(1.0f, 0.0f, 0.0f));
+    transforms.SetPosition(roots[20], float3(20.0f, 0.0f, 1.0f));
+    transforms.Update();
+    EXPECT_EQ(Sorted(transforms.GetChangedTransforms()), Sorted({ roots[7], children[7], children[12], roots[20], children[20] }));
+    EXPECT_EQ(transforms.GetWorldMatrix(children[7]), CreateTranslationMatrix(float3(7.0f, 6.0f, 0.0f)));
+    EXPECT_EQ(transforms.GetWorldMatrix(children[12]), CreateTranslationMatrix(float3(12.0f, 2.0f, 0.0f)));
+    EXPECT_EQ(transforms.GetWorldMatrix(children[20]), CreateTranslationMatrix(float3(20.0f, 1.0f, 1.0f)) * CreateRotationMatrixFromQuaternion(CreateQuaternionYawPitchRoll(1.0f, 0.0f, 0.0f)));
+
+    transforms.Update();
+    EXPECT_TRUE(transforms.GetChangedTransforms().empty());
+}
+
+TEST(sge_transform_hierarchy, ReparentsAndReusesDestroyedTransforms)
+{
+    TransformHierarchy transforms;
+    const uint32 a = transforms.Create();
+    const uint32 b = transforms.Create(a);
+    const uint32 c = transforms.Create(b);
+    transforms.SetPosition(a, float3(1.0f, 0.0f, 0.0f));
+    transforms.SetPosition(b, float3(0.0f, 1.0f, 0.0f));
+    transforms.SetPosition(c, float3(0.0f, 0.0f, 1.0f));
+    transforms.Update();
+    EXPECT_EQ(transforms.GetWorldMatrix(c), CreateTranslationMatrix(float3(1.0f, 1.0f, 1.0f)));
+
+    // No cycles, no parenting to itself.
+    EXPECT_FALSE(transforms.SetParent(a, c));
+    EXPECT_FALSE(transforms.SetParent(b, b));
+    EXPECT_EQ(transforms.GetParent(a), INVALID_TRANSFORM);
+
+    // Moving c under a keeps its local offset and drops b's.
+    EXPECT_TRUE(transforms.SetParent(c, a));
+    transforms.Update();
+    EXPECT_EQ(transforms.GetChangedTransforms(), std::vector<uint32>{ c });
+    EXPECT_EQ(transforms.GetWorldMatrix(c), CreateTranslationMatrix(float3(1.0f, 0.0f, 1.0f)));
+
+    // Destroying a leaves b and c as roots with their local values.
+    EXPECT_TRUE(transforms.Destroy(a));
+    EXPECT_FALSE(transforms.Destroy(a));
+    EXPECT_EQ(transforms.GetParent(b), INVALID_TRANSFORM);
+    EXPECT_EQ(transforms.GetParent(c), INVALID_TRANSFORM);
+    EXPECT_EQ(transforms.GetCount(), 2u);
+    transforms.Update();
+    EXPECT_EQ(Sorted(transforms.GetChangedTransforms()), Sorted({ b, c }));
+    EXPECT_EQ(transforms.GetWorldMatrix(c), CreateTranslationMatrix(float3(0.0f, 0.0f, 1.0f)));
+
+    // The freed slot comes back with identity values.
+    const uint32 d = transforms.Create(b);
+    EXPECT_EQ(d, a);
+    EXPECT_EQ(transforms.GetPosition(d), float3::Zero);
+    EXPECT_EQ(transforms.GetCount(), 3u);
+    transforms.Update();
+    EXPECT_EQ(transforms.GetWorldMatrix(d), CreateTranslationMatrix(float3(0.0f, 1.0f, 0.0f)));
+
+    transforms.Clear();
+    EXPECT_EQ(transforms.GetCount(), 0u);
+    transforms.Update();
+    EXPECT_TRUE(transforms.GetChangedTransforms().empty());
+}
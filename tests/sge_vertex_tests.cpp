@@ -0,0 +1,210 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <gtest/gtest.h>
+#include "data/sge_model_asset.h"
+#include "data/sge_vertex.h"
+using namespace SGE;
+
+namespace
+{
+    // Worst case of 10 bit components on a unit vector is about 0.1 degrees.
+    constexpr float MAX_UNIT_VECTOR_ERROR_DEGREES = 0.12f;
+    constexpr float MAX_SKIN_WEIGHT_ERROR = 2.5f / 255.0f;
+
+    float3 RandomUnitVector(std::mt19937& random)
+    {
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+        for (;;)
+        {
+            float3 vector(distribution(random), distribution(random), distribution(random));
+            if (vector.length() > 0.1f && vector.length() <= 1.0f)
+            {
+                return vector.normalized();
+            }
+        }
+    }
+
+    float AngleDegrees(const float3& a, const float3& b)
+    {
+        return ConvertToDegrees(angle(a.normalized(), b.normalized()));
+    }
+
+    Vertex MakeVertex(const float3& normal, const float3& tangent, bool isMirrored)
+    {
+        Vertex vertex{};
+        vertex.normal = normal;
+        vertex.tangent = tangent;
+        vertex.bitangent = cross(normal, tangent) * (isMirrored ? -1.0f : 1.0f);
+        for (int32& index : vertex.boneIndices)
+        {
+            index = -1;
+        }
+        return vertex;
+    }
+}
+
+TEST(sge_vertex, PackedStreamsAreAThirdOfTheImportVertex)
+{
+    EXPECT_LE(sizeof(PackedVertex) * 3, sizeof(Vertex));
+    EXPECT_LE((sizeof(PackedVertex) + sizeof(SkinVertex)) * 3, sizeof(Vertex));
+}
+
+TEST(sge_vertex, HalfFloatRoundsToNearestEven)
+{
+    for (float value : { 0.0f, 1.0f, -2.0f, 0.5f, 0.25f, 1024.0f, 65504.0f })
+    {
+        EXPECT_EQ(HalfToFloat(FloatToHalf(value)), value);
+    }
+
+    EXPECT_EQ(FloatToHalf(1.0f), 0x3C00);
+    EXPECT_EQ(FloatToHalf(-0.0f), 0x8000);
+    EXPECT_EQ(FloatToHalf(1.0f + std::ldexp(1.0f, -11)), 0x3C00);     // halfway, stays on the even value
+    EXPECT_EQ(FloatToHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)), 0x3C02); // halfway, rounds up to the even value
+    EXPECT_EQ(FloatToHalf(65520.0f), 0x7C00);
+    EXPECT_EQ(FloatToHalf(std::numeric_limits<float>::infinity()), 0x7C00);
+    EXPECT_TRUE(std::isnan(HalfToFloat(FloatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+
+    // Denormals down to 2^-24, half of that rounds to zero.
+    EXPECT_EQ(HalfToFloat(FloatToHalf(std::ldexp(1.0f, -24))), std::ldexp(1.0f, -24));
+    EXPECT_EQ(HalfToFloat(FloatToHalf(std::ldexp(3.0f, -20))), std::ldexp(3.0f, -20));
+    EXPECT_EQ(FloatToHalf(std::ldexp(1.0f, -25)), 0);
+}
+
+TEST(sge_vertex, HalfFloatTexCoordsStayWithinRelativeBound)
+{
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> distribution(-8.0f, 8.0f);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const float value = distribution(random);
+        const float error = std::abs(HalfToFloat(FloatToHalf(value)) - value);
+        EXPECT_LE(error, std::max(std::abs(value) * std::ldexp(1.0f, -11), std::ldexp(1.0f, -25)));
+    }
+}
+
+TEST(sge_vertex, NormalAndTangentStayWithinAngleBound)
+{
+    std::mt19937 random(11);
+    float worstError = 0.0f;
+    for (int i = 0; i < 10000; ++i)
+    {
+        const float3 normal = RandomUnitVector(random);
+        const float3 tangent = cross(normal, RandomUnitVector(random)).normalized();
+        const Vertex vertex = MakeVertex(normal, tangent, (i & 1) != 0);
+        const Vertex unpacked = UnpackVertex(PackVertex(vertex));
+
+        worstError = std::max(worstError, AngleDegrees(unpacked.normal, normal));
+        worstError = std::max(worstError, AngleDegrees(unpacked.tangent, tangent));
+        EXPECT_GT(dot(unpacked.bitangent, vertex.bitangent), 0.99f);
+    }
+    EXPECT_LE(worstError, MAX_UNIT_VECTOR_ERROR_DEGREES);
+}
+
+TEST(sge_vertex, BitangentSignSurvivesPacking)
+{
+    const float3 normal(0.0f, 0.0f, -1.0f);
+    const float3 tangent(1.0f, 0.0f, 0.0f);
+
+    const PackedVertex rightHanded = PackVertex(MakeVertex(normal, tangent, false));
+    const PackedVertex mirrored = PackVertex(MakeVertex(normal, tangent, true));
+    EXPECT_EQ(UnpackUnitVectorW(rightHanded.tangent), 1.0f);
+    EXPECT_EQ(UnpackUnitVectorW(mirrored.tangent), 0.0f);
+
+    EXPECT_NEAR(UnpackVertex(rightHanded).bitangent.y, cross(normal, tangent).y, 0.01f);
+    EXPECT_NEAR(UnpackVertex(mirrored).bitangent.y, -cross(normal, tangent).y, 0.01f);
+}
+
+TEST(sge_vertex, SkinWeightsSumToOneAndStayWithinBound)
+{
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    for (int i = 0; i < 10000; ++i)
+    {
+        Vertex vertex = MakeVertex(float3(0.0f, 1.0f, 0.0f), float3(1.0f, 0.0f, 0.0f), false);
+        float total = 0.0f;
+        for (int32 j = 0; j < 4; ++j)
+        {
+            vertex.boneIndices[j] = (i + j * 37) % 100;
+            vertex.boneWeights[j] = distribution(random);
+            total += vertex.boneWeights[j];
+        }
+
+        const SkinVertex skin = PackSkin(vertex);
+        Vertex unpacked{};
+        UnpackSkin(skin, unpacked);
+
+        uint32 sum = 0;
+        for (int32 j = 0; j < 4; ++j)
+        {
+            sum += skin.boneWeights[j];
+            EXPECT_NEAR(unpacked.boneWeights[j], vertex.boneWeights[j] / total, MAX_SKIN_WEIGHT_ERROR);
+            if (skin.boneWeights[j] > 0)
+            {
+                EXPECT_EQ(unpacked.boneIndices[j], vertex.boneIndices[j]);
+            }
+        }
+        EXPECT_EQ(sum, 255u);
+    }
+}
+
+TEST(sge_vertex, UnusedInfluencesAreDropped)
+{
+    Vertex vertex = MakeVertex(float3(0.0f, 1.0f, 0.0f), float3(1.0f, 0.0f, 0.0f), false);
+    EXPECT_FALSE(HasSkin(vertex));
+    const SkinVertex empty = PackSkin(vertex);
+    for (int32 j = 0; j < 4; ++j)
+    {
+        EXPECT_EQ(empty.boneIndices[j], 0);
+        EXPECT_EQ(empty.boneWeights[j], 0);
+    }
+
+    // Partial weights are renormalized, a bone the 8 bit index can't hold is dropped.
+    vertex.boneIndices[0] = 7;
+    vertex.boneWeights[0] = 0.25f;
+    vertex.boneIndices[1] = 300;
+    vertex.boneWeights[1] = 0.5f;
+    vertex.boneIndices[2] = 9;
+    vertex.boneWeights[2] = 0.25f;
+    EXPECT_TRUE(HasSkin(vertex));
+
+    const SkinVertex skin = PackSkin(vertex);
+    EXPECT_EQ(skin.boneIndices[0], 7);
+    EXPECT_EQ(skin.boneIndices[2], 9);
+    EXPECT_EQ(skin.boneWeights[1], 0);
+    EXPECT_EQ(skin.boneWeights[3], 0);
+    EXPECT_EQ(skin.boneWeights[0] + skin.boneWeights[2], 255);
+    EXPECT_NEAR(skin.boneWeights[0], 127.5f, 1.0f);
+
+    Vertex unpacked{};
+    UnpackSkin(skin, unpacked);
+    EXPECT_EQ(unpacked.boneIndices[1], -1);
+    EXPECT_EQ(unpacked.boneIndices[3], -1);
+}
+
+TEST(sge_vertex, ModelAssetOnlyKeepsSkinStreamForWeightedMeshes)
+{
+    std::vector<Vertex> vertices(3, MakeVertex(float3(0.0f, 1.0f, 0.0f), float3(1.0f, 0.0f, 0.0f), false));
+    vertices[1].texCoords = float2(0.5f, 2.0f);
+
+    std::vector<Mesh> staticMeshes = { Mesh(vertices, { 0, 1, 2 }) };
+    ModelAsset staticAsset;
+    staticAsset.Initialize(staticMeshes);
+    EXPECT_FALSE(staticAsset.HasSkin());
+    EXPECT_TRUE(staticAsset.GetSkinVertices().empty());
+    ASSERT_EQ(staticAsset.GetVertices().size(), 3u);
+    EXPECT_EQ(UnpackVertex(staticAsset.GetVertices()[1]).texCoords.y, 2.0f);
+
+    // One weighted vertex in any mesh gives the whole model a skin stream.
+    std::vector<Vertex> skinned = vertices;
+    skinned[2].boneIndices[0] = 4;
+    skinned[2].boneWeights[0] = 1.0f;
+    std::vector<Mesh> skinnedMeshes = { Mesh(vertices, { 0, 1, 2 }), Mesh(skinned, { 0, 1, 2 }) };
+    ModelAsset skinnedAsset;
+    skinnedAsset.Initialize(skinnedMeshes);
+    ASSERT_TRUE(skinnedAsset.HasSkin());
+    ASSERT_EQ(skinnedAsset.GetSkinVertices().size(), 6u);
+    EXPECT_EQ(skinnedAsset.GetSkinVertices()[5].boneIndices[0], 4);
+    EXPECT_EQ(skinnedAsset.GetSkinVertices()[5].boneWeights[0], 255);
+    EXPECT_EQ(skinnedAsset.GetSkinVertices()[0].boneWeights[0], 0);
+}
@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "core/sge_job_system.h"
+#include "data/sge_asset_cooker.h"
+
+using namespace SGE;
+
+// Offline asset cooker. Writes the .sgemesh and .dds files the engine loads instead of the sources,
+// so a build machine without a GPU can prepare content ahead of deployment.
+namespace
+{
+    void PrintUsage()
+    {
+        std::cout <<
+            "usage: sge_cook [options] <application_settings.json | directory>...\n"
+            "  --root <dir>      directory the asset paths are relative to, the working directory by default\n"
+            "  --manifest <file> manifest of content hashes, <root>/" << ASSET_COOKER_MANIFEST_NAME << " by default\n"
+            "  --jobs <count>    number of threads, one per core by default\n"
+            "  --force           cook everything, unchanged inputs included\n"
+            "  --compact-color   BC1/BC3 for color textures instead of BC7, half the size at lower quality\n";
+    }
+
+    const char* GetKindName(AssetKind kind)
+    {
+        switch (kind)
+        {
+        case AssetKind::Model: return "model";
+        case AssetKind::AnimatedModel: return "animated model";
+        case AssetKind::Texture: return "texture";
+        default: return "asset";
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::filesystem::path root = std::filesystem::current_path();
+    std::filesystem::path manifestPath;
+    std::vector<std::filesystem::path> inputs;
+    uint32 threadCount = 0;
+    bool force = false;
+    bool isCompactColor = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (argument == "--root" && hasValue)
+        {
+            root = std::filesystem::absolute(argv[++i]);
+        }
+        else if (argument == "--manifest" && hasValue)
+        {
+            manifestPath = std::filesystem::absolute(argv[++i]);
+        }
+        else if (argument == "--jobs" && hasValue)
+        {
+            threadCount = static_cast<uint32>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--force")
+        {
+            force = true;
+        }
+        else if (argument == "--compact-color")
+        {
+            isCompactColor = true;
+        }
+        else if (argument == "--help" || argument == "-h")
+        {
+            PrintUsage();
+            return 0;
+        }
+        else if (argument.rfind("--", 0) == 0)
+        {
+            std::cerr << "sge_cook: unknown option " << argument << "\n";
+            PrintUsage();
+            return 1;
+        }
+        else
+        {
+            inputs.push_back(std::filesystem::absolute(argument));
+        }
+    }
+
+    if (inputs.empty())
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // Asset paths are keys at runtime, they have to be spelled the way the engine spells them.
+    std::error_code error;
+    std::filesystem::current_path(root, error);
+    if (error)
+    {
+        std::cerr << "sge_cook: can't enter " << root.string() << ": " << error.message() << "\n";
+        return 1;
+    }
+
+    AssetCooker cooker;
+    cooker.Initialize((manifestPath.empty() ? root / ASSET_COOKER_MANIFEST_NAME : manifestPath).string());
+    cooker.SetCompactColor(isCompactColor);
+
+    for (const std::filesystem::path& input : inputs)
+    {
+        if (std::filesystem::is_directory(input))
+        {
+            cooker.AddDirectory(std::filesystem::relative(input, root).generic_string());
+        }
+        else if (!cooker.AddSettings(input.string()))
+        {
+            std::cerr << "sge_cook: can't read settings " << input.string() << "\n";
+            return 1;
+        }
+    }
+
+    // Without a job system the entries are cooked inline, which is what a single thread asks for.
+    if (threadCount != 1)
+    {
+        JobSystem::Get().Initialize(threadCount > 1 ? threadCount - 1 : 0);
+    }
+    threadCount = std::max(1u, JobSystem::Get().GetThreadCount());
+
+    const auto start = std::chrono::steady_clock::now();
+    const CookReport report = cooker.Cook(force);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    JobSystem::Get().Shutdown();
+
+    for (const CookEntry& entry : cooker.GetEntries())
+    {
+        if (entry.status == CookStatus::Missing)
+        {
+            std::cerr << "sge_cook: missing " << GetKindName(entry.kind) << " " << entry.sourcePath << "\n";
+        }
+        else if (entry.status == CookStatus::Failed)
+        {
+            std::cerr << "sge_cook: failed to cook " << GetKindName(entry.kind) << " " << entry.sourcePath << "\n";
+        }
+    }
+
+    std::cout << "sge_cook: " << report.cooked << " cooked, " << report.upToDate << " up to date, " << report.missing << " missing, " << report.failed << " failed in "
+        << elapsed.count() << " s on " << threadCount << " threads\n";
+
+    const MeshOptimizationReport& optimization = report.optimization;
+    if (optimization.before.triangleCount > 0)
+    {
+        std::cout << "sge_cook: cooked meshes " << optimization.vertexCountBefore << " -> " << optimization.vertexCountAfter << " vertices, ACMR "
+            << optimization.before.GetACMR() << " -> " << optimization.after.GetACMR() << ", ATVR "
+            << optimization.before.GetATVR() << " -> " << optimization.after.GetATVR() << "\n";
+    }
+
+    if (!cooker.SaveManifest())
+    {
+        std::cerr << "sge_cook: can't write the manifest\n";
+        return 1;
+    }
+
+    return report.failed > 0 ? 1 : 0;
+}